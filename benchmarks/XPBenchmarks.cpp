@@ -15,13 +15,24 @@
 #include <DataPipeline/XPStore.h>
 #include <Engine/XPEngine.h>
 #include <Engine/XPRegistry.h>
+#if defined(XP_PHYSICS_JOLT)
+    #include <Physics/Jolt/XPJoltPhysics.h>
+#endif
+#if defined(XP_RENDERER_SW)
+    #include <Renderer/SW/XPSWLightGrid.h>
+#endif
 #include <SceneDescriptor/XPLayer.h>
 #include <SceneDescriptor/XPNode.h>
 #include <SceneDescriptor/XPScene.h>
 #include <SceneDescriptor/XPStore.h>
 #include <Utilities/XPMemoryPool.h>
+#include <Utilities/XPThreadPool.h>
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <cmath>
+#include <random>
+
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wall"
@@ -137,10 +148,253 @@ SCENE_DESCRIPTION_NODE_DESTRUCTION(benchmark::State& state)
     // --------------------------------------------------------------------------------------------
 }
 
+#define PARALLEL_FOR_ELEMENTS (1 << 22)
+#define SMALL_JOBS_COUNT      100000
+
+// the argument is the number of threads taking part, the benchmarking thread plus the workers
+static void
+THREAD_POOL_PARALLEL_FOR(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    XPThreadPool       pool(static_cast<uint32_t>(state.range(0)) - 1);
+    std::vector<float> values(PARALLEL_FOR_ELEMENTS);
+    for (size_t i = 0; i < values.size(); ++i) { values[i] = static_cast<float>(i); }
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        pool.parallelFor(0, values.size(), 4096, [&values](size_t first, size_t last, uint32_t) {
+            for (size_t i = first; i < last; ++i) { values[i] = std::sqrt(values[i] * values[i] + 1.0f); }
+        });
+        benchmark::DoNotOptimize(values.data());
+        // ----------------------------------------------------------------------------------------
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * PARALLEL_FOR_ELEMENTS);
+}
+
+static void
+THREAD_POOL_SMALL_JOBS(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    XPThreadPool          pool(static_cast<uint32_t>(state.range(0)) - 1);
+    std::atomic<uint64_t> counter = 0;
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        // one job per element, the scheduling overhead dominates
+        pool.parallelFor(0, SMALL_JOBS_COUNT, 1, [&counter](size_t first, size_t last, uint32_t) {
+            counter.fetch_add(last - first, std::memory_order_relaxed);
+        });
+        // ----------------------------------------------------------------------------------------
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * SMALL_JOBS_COUNT);
+}
+
+#if defined(XP_RENDERER_SW)
+    #define SW_LIGHTS_WIDTH  640
+    #define SW_LIGHTS_HEIGHT 360
+
+// point lights scattered around the origin and one fragment per pixel on surfaces at random depths, the shading only
+// adds up a cheap falloff so that walking the light lists is what gets measured
+static void
+createLightsScene(size_t                         numLights,
+                  XPSWCamera<float>&             camera,
+                  std::vector<XPSWLight<float>>& lights,
+                  std::vector<XPVec3<float>>&    fragments)
+{
+    camera.resolution = { SW_LIGHTS_WIDTH, SW_LIGHTS_HEIGHT };
+    camera.fov        = 60.0f;
+    camera.zNearPlane = 0.1f;
+    camera.zFarPlane  = 200.0f;
+    camera.location   = { 0.0f, 5.0f, 40.0f };
+    camera.target     = { 0.0f, 0.0f, 0.0f };
+    camera.up         = { 0.0f, 1.0f, 0.0f };
+    camera.updateMatrices();
+
+    std::mt19937                          rng(42);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    lights.resize(numLights);
+    for (XPSWLight<float>& light : lights) {
+        light.type      = XPSWELightType_Point;
+        light.location  = { position(rng), position(rng), position(rng) };
+        light.ambient   = { 0.0f, 0.0f, 0.0f };
+        light.diffuse   = { unit(rng), unit(rng), unit(rng) };
+        light.specular  = { 0.1f, 0.1f, 0.1f };
+        light.intensity = 0.1f + 0.4f * unit(rng);
+    }
+
+    fragments.resize(SW_LIGHTS_WIDTH * SW_LIGHTS_HEIGHT);
+    for (uint32_t y = 0; y < SW_LIGHTS_HEIGHT; ++y) {
+        for (uint32_t x = 0; x < SW_LIGHTS_WIDTH; ++x) {
+            const float     depth = 10.0f + 60.0f * unit(rng);
+            const glm::vec4 p     = camera.inverseProjectionMatrix.glm *
+                                glm::vec4((2.0f * x + 1.0f) / SW_LIGHTS_WIDTH - 1.0f,
+                                          1.0f - (2.0f * y + 1.0f) / SW_LIGHTS_HEIGHT,
+                                          -1.0f,
+                                          1.0f);
+            // view space direction through the pixel scaled to the depth, w cancels out
+            const glm::vec3 view = glm::vec3(p) / -p.z * depth;
+            fragments[y * SW_LIGHTS_WIDTH + x] = glm::vec3(camera.inverseViewMatrix.glm * glm::vec4(view, 1.0f));
+        }
+    }
+}
+
+static float
+shadePointLight(const XPSWLight<float>& light, const XPVec3<float>& fragment)
+{
+    const glm::vec3 delta = light.location.glm - fragment.glm;
+    return light.intensity / (1.0f + glm::dot(delta, delta));
+}
+
+// the argument is the number of point lights
+static void
+SW_LIGHTS_ALL_PER_FRAGMENT(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    XPSWCamera<float>             camera;
+    std::vector<XPSWLight<float>> lights;
+    std::vector<XPVec3<float>>    fragments;
+    createLightsScene(static_cast<size_t>(state.range(0)), camera, lights, fragments);
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        float sum = 0.0f;
+        for (const XPVec3<float>& fragment : fragments) {
+            for (const XPSWLight<float>& light : lights) { sum += shadePointLight(light, fragment); }
+        }
+        benchmark::DoNotOptimize(sum);
+        // ----------------------------------------------------------------------------------------
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * fragments.size());
+}
+
+// the argument is the number of point lights, building the grid is part of every frame
+static void
+SW_LIGHTS_CLUSTERED(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    XPSWCamera<float>             camera;
+    std::vector<XPSWLight<float>> lights;
+    std::vector<XPVec3<float>>    fragments;
+    createLightsScene(static_cast<size_t>(state.range(0)), camera, lights, fragments);
+    XPSWLightGrid<float> lightGrid;
+    size_t               numShadedLights = 0;
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        lightGrid.prepare(lights, camera);
+        for (uint32_t slice = 0; slice < XPSWLightGrid<float>::NumSlices; ++slice) { lightGrid.buildSlice(slice); }
+        float sum       = 0.0f;
+        numShadedLights = 0;
+        for (uint32_t y = 0; y < SW_LIGHTS_HEIGHT; ++y) {
+            for (uint32_t x = 0; x < SW_LIGHTS_WIDTH; ++x) {
+                const XPVec3<float>&         fragment      = fragments[y * SW_LIGHTS_WIDTH + x];
+                const std::vector<uint32_t>& clusterLights = lightGrid.getClusterLights(x, y, fragment);
+                for (uint32_t li : clusterLights) { sum += shadePointLight(lights[li], fragment); }
+                numShadedLights += clusterLights.size();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        // ----------------------------------------------------------------------------------------
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * fragments.size());
+    state.counters["lights_per_fragment"] = static_cast<double>(numShadedLights) / fragments.size();
+}
+#endif
+
+#if defined(XP_PHYSICS_JOLT)
+    #define PHYSICS_BODIES_COUNT 20000
+
+// dynamic boxes on a grid, attaching the rigidbody queues the node in the physics change list. Flushing the list after
+// every node reproduces the old path where each body was created and added to the broadphase on its own
+static void
+spawnPhysicsBodies(XPJoltPhysics* physics, XPScene* scene, XPLayer* layer, std::vector<XPNode*>& nodes, bool flushEach)
+{
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        XPNode* node = layer->createNode(fmt::format("body {}", i)).value();
+        node->attachTransform();
+        Transform* tr = node->getTransform();
+        tr->location  = { (i % 100) * 2.0f, (i / 10000) * 2.0f, ((i / 100) % 100) * 2.0f };
+
+        node->attachCollider();
+        Collider* cl = node->getCollider();
+        cl->info.resize(1);
+        cl->info[0].shape                = XPEColliderShapeBox;
+        cl->info[0].parameters.boxWidth  = 0.5f;
+        cl->info[0].parameters.boxHeight = 0.5f;
+        cl->info[0].parameters.boxDepth  = 0.5f;
+
+        node->attachRigidbody();
+        node->getRigidbody()->isStatic = false;
+        if (flushEach) { physics->createPendingColliders(scene); }
+        nodes[i] = node;
+    }
+    physics->createPendingColliders(scene);
+}
+
+// the argument selects the path, 0 creates the bodies one by one and 1 creates them as a single batch
+static void
+PHYSICS_JOLT_SPAWN_BODIES(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    auto           engine   = XP_NEW XPEngine();
+    auto           registry = XP_NEW XPRegistry(engine);
+    XPJoltPhysics* physics  = XP_NEW XPJoltPhysics(registry);
+    registry->setPhysicsBuffered(physics);
+    registry->triggerPhysicsChangesIfAny();
+    physics->initialize();
+    XPSDStore* store = new XPSDStore(registry);
+    XPScene*   scene = store->createScene("scene").value();
+    XPLayer*   layer = scene->createLayer("layer").value();
+
+    std::vector<XPNode*> nodes(PHYSICS_BODIES_COUNT);
+    const bool           flushEach = state.range(0) == 0;
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        spawnPhysicsBodies(physics, scene, layer, nodes, flushEach);
+        // ----------------------------------------------------------------------------------------
+
+        state.PauseTiming();
+        for (XPNode* node : nodes) {
+            physics->destroyColliders(node);
+            layer->destroyNode(node);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * PHYSICS_BODIES_COUNT);
+
+    // Cleanup ------------------------------------------------------------------------------------
+    nodes.clear();
+    scene->destroyLayer(layer);
+    store->destroyScene(scene);
+    delete store;
+    physics->finalize();
+    XP_DELETE physics;
+    delete registry;
+    delete engine;
+    // --------------------------------------------------------------------------------------------
+}
+#endif
+
 // Register the function as a benchmark
 BENCHMARK(SCENE_DESCRIPTION_NODE_CREATION);
 BENCHMARK(SCENE_DESCRIPTION_NODE_FETCHING);
 BENCHMARK(SCENE_DESCRIPTION_NODE_DESTRUCTION);
+BENCHMARK(THREAD_POOL_PARALLEL_FOR)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK(THREAD_POOL_SMALL_JOBS)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+#if defined(XP_RENDERER_SW)
+BENCHMARK(SW_LIGHTS_ALL_PER_FRAGMENT)->RangeMultiplier(4)->Range(1, 1024);
+BENCHMARK(SW_LIGHTS_CLUSTERED)->RangeMultiplier(4)->Range(1, 1024);
+#endif
+#if defined(XP_PHYSICS_JOLT)
+BENCHMARK(PHYSICS_JOLT_SPAWN_BODIES)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+#endif
 
 // Run the benchmark
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,543 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+// Emulator conformance and throughput suite, links the emulator only.
+// Every benchmark reports MIPS, retired instructions per iteration and, on x86 hosts, instructions per host cycle
+// measured with the time stamp counter. Run with --benchmark_format=json (or --benchmark_out=<file>) to get a
+// machine readable report that can be diffed between builds.
+
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorElfLoader.h>
+#include <Emulator/XPEmulatorProcessor.h>
+#include <benchmark/benchmark.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define XP_EMULATOR_BENCHMARK_HAS_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define XP_EMULATOR_BENCHMARK_HAS_TSC
+#endif
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef XP_EMULATOR_BENCHMARK_PROGRAMS_DIR
+    #define XP_EMULATOR_BENCHMARK_PROGRAMS_DIR "src/Emulator/test/build/Debug"
+#endif
+
+namespace {
+
+static uint64_t
+hostCycles()
+{
+#if defined(XP_EMULATOR_BENCHMARK_HAS_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct XPEmulatorRunStats
+{
+    uint64_t instructions = 0;
+    uint64_t cycles       = 0;
+};
+
+static void
+reportStats(benchmark::State& state, const XPEmulatorRunStats& stats)
+{
+    state.counters["MIPS"] = benchmark::Counter(static_cast<double>(stats.instructions) * 1e-6,
+                                                benchmark::Counter::kIsRate);
+    state.counters["instructions"] =
+      benchmark::Counter(static_cast<double>(stats.instructions), benchmark::Counter::kAvgIterations);
+    if (stats.cycles > 0) {
+        state.counters["IPC_host"] = static_cast<double>(stats.instructions) / static_cast<double>(stats.cycles);
+    }
+}
+
+static std::unique_ptr<XPEmulatorProcessor>
+createProcessor(const uint32_t* program, size_t numWords)
+{
+    auto processor = std::make_unique<XPEmulatorProcessor>();
+    xp_emulator_processor_initialize(processor.get());
+    memcpy(processor->bus.memory.flash, program, numWords * sizeof(uint32_t));
+    return processor;
+}
+
+// runs from the start of flash until the kernel hits its ebreak, returns false for any other stop
+static bool
+runKernel(XPEmulatorProcessor* processor, XPEmulatorRunStats& stats)
+{
+    processor->pc        = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+    uint32_t retired     = 0;
+    uint64_t cyclesStart = hostCycles();
+    int      result      = xp_emulator_processor_run_budget(processor, std::numeric_limits<uint32_t>::max(), &retired);
+    stats.cycles += hostCycles() - cyclesStart;
+    stats.instructions += retired;
+    return result == XP_EMULATOR_PROGRAM_EXIT_CODE_EBREAK;
+}
+
+// -----------------------------------------------------------------------------------------------
+// RV32IM conformance
+// -----------------------------------------------------------------------------------------------
+struct XPEmulatorROp
+{
+    const char* name;
+    uint32_t    funct7;
+    uint32_t    funct3;
+    uint32_t (*reference)(uint32_t a, uint32_t b);
+};
+
+static uint32_t
+encodeR(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd)
+{
+    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | 0b0110011;
+}
+
+static uint32_t
+encodeI(int32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode)
+{
+    return (static_cast<uint32_t>(imm & 0xFFF) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+
+static uint32_t
+encodeS(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3)
+{
+    uint32_t bits = static_cast<uint32_t>(imm & 0xFFF);
+    return ((bits >> 5) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | ((bits & 0x1F) << 7) | 0b0100011;
+}
+
+// lui + addi pair, the upper part is rounded so the sign extended lower 12 bits land on value
+static void
+emitLoadImmediate(std::vector<uint32_t>& program, uint32_t rd, uint32_t value)
+{
+    uint32_t upper = (value + 0x800) & 0xFFFFF000;
+    program.push_back(upper | (rd << 7) | 0b0110111);
+    program.push_back(encodeI(static_cast<int32_t>(value - upper), rd, 0b000, rd, 0b0010011));
+}
+
+static const XPEmulatorROp kROps[] = {
+    { "add", 0b0000000, 0b000, [](uint32_t a, uint32_t b) { return a + b; } },
+    { "sub", 0b0100000, 0b000, [](uint32_t a, uint32_t b) { return a - b; } },
+    { "sll", 0b0000000, 0b001, [](uint32_t a, uint32_t b) { return a << (b & 31); } },
+    { "slt", 0b0000000, 0b010, [](uint32_t a, uint32_t b) { return uint32_t(int32_t(a) < int32_t(b)); } },
+    { "sltu", 0b0000000, 0b011, [](uint32_t a, uint32_t b) { return uint32_t(a < b); } },
+    { "xor", 0b0000000, 0b100, [](uint32_t a, uint32_t b) { return a ^ b; } },
+    { "srl", 0b0000000, 0b101, [](uint32_t a, uint32_t b) { return a >> (b & 31); } },
+    { "sra", 0b0100000, 0b101, [](uint32_t a, uint32_t b) { return uint32_t(int32_t(a) >> (b & 31)); } },
+    { "or", 0b0000000, 0b110, [](uint32_t a, uint32_t b) { return a | b; } },
+    { "and", 0b0000000, 0b111, [](uint32_t a, uint32_t b) { return a & b; } },
+    { "mul", 0b0000001, 0b000, [](uint32_t a, uint32_t b) { return a * b; } },
+    { "mulh",
+      0b0000001,
+      0b001,
+      [](uint32_t a, uint32_t b) { return uint32_t((int64_t(int32_t(a)) * int64_t(int32_t(b))) >> 32); } },
+    { "mulhsu",
+      0b0000001,
+      0b010,
+      [](uint32_t a, uint32_t b) { return uint32_t((int64_t(int32_t(a)) * int64_t(uint64_t(b))) >> 32); } },
+    { "mulhu", 0b0000001, 0b011, [](uint32_t a, uint32_t b) { return uint32_t((uint64_t(a) * uint64_t(b)) >> 32); } },
+    { "div",
+      0b0000001,
+      0b100,
+      [](uint32_t a, uint32_t b) {
+          if (b == 0) { return 0xFFFFFFFFu; }
+          if (a == 0x80000000u && b == 0xFFFFFFFFu) { return a; }
+          return uint32_t(int32_t(a) / int32_t(b));
+      } },
+    { "divu", 0b0000001, 0b101, [](uint32_t a, uint32_t b) { return b == 0 ? 0xFFFFFFFFu : a / b; } },
+    { "rem",
+      0b0000001,
+      0b110,
+      [](uint32_t a, uint32_t b) {
+          if (b == 0) { return a; }
+          if (a == 0x80000000u && b == 0xFFFFFFFFu) { return 0u; }
+          return uint32_t(int32_t(a) % int32_t(b));
+      } },
+    { "remu", 0b0000001, 0b111, [](uint32_t a, uint32_t b) { return b == 0 ? a : a % b; } },
+};
+
+// edge operands in the spirit of riscv-tests: zero, unit, sign boundaries, shift amount wrap, mixed bit patterns
+static const uint32_t kOperands[] = { 0x00000000, 0x00000001, 0xFFFFFFFF, 0x80000000, 0x7FFFFFFF,
+                                      0x0000001F, 0x00000020, 0x12345678, 0xFFFFFFF9 };
+
+} // namespace
+
+static void
+EMULATOR_CONFORMANCE_RV32IM(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    // every case loads its operands, runs the op and stores the result through s0, ebreak ends the run
+    constexpr uint32_t    a0 = XPEmulatorEReg10, a1 = XPEmulatorEReg11, a2 = XPEmulatorEReg12, s0 = XPEmulatorEReg8;
+    std::vector<uint32_t> program;
+    std::vector<uint32_t> expected;
+    for (const XPEmulatorROp& op : kROps) {
+        for (uint32_t lhs : kOperands) {
+            for (uint32_t rhs : kOperands) {
+                emitLoadImmediate(program, a1, lhs);
+                emitLoadImmediate(program, a2, rhs);
+                program.push_back(encodeR(op.funct7, a2, a1, op.funct3, a0));
+                program.push_back(encodeS(0, a0, s0, 0b010));
+                program.push_back(encodeI(4, s0, 0b000, s0, 0b0010011));
+                expected.push_back(op.reference(lhs, rhs));
+            }
+        }
+    }
+    program.push_back(0x00100073); // ebreak
+    auto               processor = createProcessor(program.data(), program.size());
+    XPEmulatorRunStats stats;
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        processor->regs[s0] = XP_EMULATOR_CONFIG_MEMORY_RAM_BASE;
+        if (!runKernel(processor.get(), stats)) {
+            state.SkipWithError("conformance program did not reach its ebreak");
+            break;
+        }
+        // ----------------------------------------------------------------------------------------
+    }
+
+    // Cleanup ------------------------------------------------------------------------------------
+    for (size_t i = 0; i < expected.size() && !state.skipped(); ++i) {
+        uint32_t actual = 0;
+        memcpy(&actual, processor->bus.memory.ram + i * sizeof(uint32_t), sizeof(actual));
+        if (actual != expected[i]) {
+            const size_t  numOperands = sizeof(kOperands) / sizeof(kOperands[0]);
+            const size_t  perOp       = numOperands * numOperands;
+            const std::string message = std::string("mismatch in ") + kROps[i / perOp].name + " lhs=" +
+                                        std::to_string(kOperands[(i % perOp) / numOperands]) +
+                                        " rhs=" + std::to_string(kOperands[i % numOperands]);
+            state.SkipWithError(message.c_str());
+            break;
+        }
+    }
+    reportStats(state, stats);
+    xp_emulator_processor_finalize(processor.get());
+    // --------------------------------------------------------------------------------------------
+}
+
+// -----------------------------------------------------------------------------------------------
+// Kernels, each encoding below was produced by assembling the commented instruction for rv32im
+// -----------------------------------------------------------------------------------------------
+namespace {
+
+// a0 = dst, a1 = src, a2 = bytes (multiple of 4)
+static const uint32_t kMemcpyKernel[] = {
+    0x0005a283, // lw    t0, 0(a1)
+    0x00552023, // sw    t0, 0(a0)
+    0x00450513, // addi  a0, a0, 4
+    0x00458593, // addi  a1, a1, 4
+    0xffc60613, // addi  a2, a2, -4
+    0xfe0616e3, // bnez  a2, -20
+    0x00100073, // ebreak
+};
+
+// a0 = dst, a1 = value, a2 = bytes (multiple of 4)
+static const uint32_t kMemsetKernel[] = {
+    0x00b52023, // sw    a1, 0(a0)
+    0x00450513, // addi  a0, a0, 4
+    0xffc60613, // addi  a2, a2, -4
+    0xfe061ae3, // bnez  a2, -12
+    0x00100073, // ebreak
+};
+
+// a0 = A, a1 = B, a2 = C, a3 = N, C = A * B for row major NxN int32 matrices
+static const uint32_t kMatmulKernel[] = {
+    0x00000293, // li    t0, 0
+    0x00269f93, // slli  t6, a3, 2
+    0x00000313, // li    t1, 0           row:
+    0x00000393, // li    t2, 0           col:
+    0x00000e13, // li    t3, 0
+    0x03f28eb3, // mul   t4, t0, t6
+    0x00ae8eb3, // add   t4, t4, a0
+    0x00231f13, // slli  t5, t1, 2
+    0x00bf0f33, // add   t5, t5, a1
+    0x000ea403, // lw    s0, 0(t4)       inner:
+    0x000f2483, // lw    s1, 0(t5)
+    0x02940433, // mul   s0, s0, s1
+    0x008e0e33, // add   t3, t3, s0
+    0x004e8e93, // addi  t4, t4, 4
+    0x01ff0f33, // add   t5, t5, t6
+    0x00138393, // addi  t2, t2, 1
+    0xfed3c2e3, // blt   t2, a3, inner
+    0x01c62023, // sw    t3, 0(a2)
+    0x00460613, // addi  a2, a2, 4
+    0x00130313, // addi  t1, t1, 1
+    0xfad34ee3, // blt   t1, a3, col
+    0x00128293, // addi  t0, t0, 1
+    0xfad2c8e3, // blt   t0, a3, row
+    0x00100073, // ebreak
+};
+
+// a0 = buffer, a1 = bytes, returns the reflected crc32 in a0
+// the bit serial loop is the CoreMark style mix of byte loads, shifts and data dependent branches
+static const uint32_t kCrc32Kernel[] = {
+    0xfff00613, // li    a2, -1
+    0xedb887b7, // lui   a5, 0xedb88
+    0x32078793, // addi  a5, a5, 0x320
+    0x00054283, // lbu   t0, 0(a0)       byte:
+    0x00564633, // xor   a2, a2, t0
+    0x00800313, // li    t1, 8
+    0x00167393, // andi  t2, a2, 1       bit:
+    0x00165613, // srli  a2, a2, 1
+    0x00038463, // beqz  t2, skip
+    0x00f64633, // xor   a2, a2, a5
+    0xfff30313, // addi  t1, t1, -1      skip:
+    0xfe0316e3, // bnez  t1, bit
+    0x00150513, // addi  a0, a0, 1
+    0xfff58593, // addi  a1, a1, -1
+    0xfc059ae3, // bnez  a1, byte
+    0xfff64513, // not   a0, a2
+    0x00100073, // ebreak
+};
+
+static constexpr uint32_t kSourceAddress      = XP_EMULATOR_CONFIG_MEMORY_RAM_BASE;
+static constexpr uint32_t kDestinationAddress = XP_EMULATOR_CONFIG_MEMORY_RAM_BASE + 2 * 1024 * 1024;
+
+static uint8_t*
+ramAt(XPEmulatorProcessor* processor, uint32_t address)
+{
+    return processor->bus.memory.ram + (address - XP_EMULATOR_CONFIG_MEMORY_RAM_BASE);
+}
+
+} // namespace
+
+static void
+EMULATOR_KERNEL_MEMCPY(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    const uint32_t numBytes  = static_cast<uint32_t>(state.range(0));
+    auto           processor = createProcessor(kMemcpyKernel, sizeof(kMemcpyKernel) / sizeof(uint32_t));
+    for (uint32_t i = 0; i < numBytes; ++i) { ramAt(processor.get(), kSourceAddress)[i] = static_cast<uint8_t>(i * 7); }
+    XPEmulatorRunStats stats;
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        processor->regs[XPEmulatorEReg10] = kDestinationAddress;
+        processor->regs[XPEmulatorEReg11] = kSourceAddress;
+        processor->regs[XPEmulatorEReg12] = numBytes;
+        if (!runKernel(processor.get(), stats)) {
+            state.SkipWithError("memcpy kernel did not reach its ebreak");
+            break;
+        }
+        // ----------------------------------------------------------------------------------------
+    }
+
+    // Cleanup ------------------------------------------------------------------------------------
+    if (!state.skipped() &&
+        memcmp(ramAt(processor.get(), kSourceAddress), ramAt(processor.get(), kDestinationAddress), numBytes) != 0) {
+        state.SkipWithError("memcpy kernel produced a different buffer");
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * numBytes);
+    reportStats(state, stats);
+    xp_emulator_processor_finalize(processor.get());
+    // --------------------------------------------------------------------------------------------
+}
+
+static void
+EMULATOR_KERNEL_MEMSET(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    const uint32_t     numBytes  = static_cast<uint32_t>(state.range(0));
+    auto               processor = createProcessor(kMemsetKernel, sizeof(kMemsetKernel) / sizeof(uint32_t));
+    XPEmulatorRunStats stats;
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        processor->regs[XPEmulatorEReg10] = kDestinationAddress;
+        processor->regs[XPEmulatorEReg11] = 0xA5A5A5A5;
+        processor->regs[XPEmulatorEReg12] = numBytes;
+        if (!runKernel(processor.get(), stats)) {
+            state.SkipWithError("memset kernel did not reach its ebreak");
+            break;
+        }
+        // ----------------------------------------------------------------------------------------
+    }
+
+    // Cleanup ------------------------------------------------------------------------------------
+    const uint8_t* destination = ramAt(processor.get(), kDestinationAddress);
+    for (uint32_t i = 0; i < numBytes && !state.skipped(); ++i) {
+        if (destination[i] != 0xA5) { state.SkipWithError("memset kernel left a byte untouched"); }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * numBytes);
+    reportStats(state, stats);
+    xp_emulator_processor_finalize(processor.get());
+    // --------------------------------------------------------------------------------------------
+}
+
+static void
+EMULATOR_KERNEL_MATMUL(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    const uint32_t n         = static_cast<uint32_t>(state.range(0));
+    const uint32_t matrixA   = kSourceAddress;
+    const uint32_t matrixB   = kSourceAddress + n * n * sizeof(int32_t);
+    const uint32_t matrixC   = kDestinationAddress;
+    auto           processor = createProcessor(kMatmulKernel, sizeof(kMatmulKernel) / sizeof(uint32_t));
+    std::vector<int32_t> a(n * n), b(n * n), c(n * n, 0);
+    for (uint32_t i = 0; i < n * n; ++i) {
+        a[i] = static_cast<int32_t>(i % 13) - 6;
+        b[i] = static_cast<int32_t>((i * 5) % 11) - 5;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        for (uint32_t j = 0; j < n; ++j) {
+            for (uint32_t k = 0; k < n; ++k) { c[i * n + j] += a[i * n + k] * b[k * n + j]; }
+        }
+    }
+    memcpy(ramAt(processor.get(), matrixA), a.data(), a.size() * sizeof(int32_t));
+    memcpy(ramAt(processor.get(), matrixB), b.data(), b.size() * sizeof(int32_t));
+    XPEmulatorRunStats stats;
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        processor->regs[XPEmulatorEReg10] = matrixA;
+        processor->regs[XPEmulatorEReg11] = matrixB;
+        processor->regs[XPEmulatorEReg12] = matrixC;
+        processor->regs[XPEmulatorEReg13] = n;
+        if (!runKernel(processor.get(), stats)) {
+            state.SkipWithError("matmul kernel did not reach its ebreak");
+            break;
+        }
+        // ----------------------------------------------------------------------------------------
+    }
+
+    // Cleanup ------------------------------------------------------------------------------------
+    if (!state.skipped() && memcmp(ramAt(processor.get(), matrixC), c.data(), c.size() * sizeof(int32_t)) != 0) {
+        state.SkipWithError("matmul kernel produced a different product");
+    }
+    reportStats(state, stats);
+    xp_emulator_processor_finalize(processor.get());
+    // --------------------------------------------------------------------------------------------
+}
+
+static void
+EMULATOR_KERNEL_CRC32(benchmark::State& state)
+{
+    // Setup --------------------------------------------------------------------------------------
+    const uint32_t numBytes  = static_cast<uint32_t>(state.range(0));
+    auto           processor = createProcessor(kCrc32Kernel, sizeof(kCrc32Kernel) / sizeof(uint32_t));
+    uint8_t*       buffer    = ramAt(processor.get(), kSourceAddress);
+    uint32_t       expected  = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < numBytes; ++i) {
+        buffer[i] = static_cast<uint8_t>((i * 131) ^ (i >> 3));
+        expected ^= buffer[i];
+        for (int bit = 0; bit < 8; ++bit) { expected = (expected >> 1) ^ ((expected & 1) ? 0xEDB88320 : 0); }
+    }
+    expected = ~expected;
+    XPEmulatorRunStats stats;
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        // Benchmarked code -----------------------------------------------------------------------
+        processor->regs[XPEmulatorEReg10] = kSourceAddress;
+        processor->regs[XPEmulatorEReg11] = numBytes;
+        if (!runKernel(processor.get(), stats)) {
+            state.SkipWithError("crc32 kernel did not reach its ebreak");
+            break;
+        }
+        // ----------------------------------------------------------------------------------------
+    }
+
+    // Cleanup ------------------------------------------------------------------------------------
+    if (!state.skipped() && processor->regs[XPEmulatorEReg10] != expected) {
+        state.SkipWithError("crc32 kernel produced a different checksum");
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * numBytes);
+    reportStats(state, stats);
+    xp_emulator_processor_finalize(processor.get());
+    // --------------------------------------------------------------------------------------------
+}
+
+// -----------------------------------------------------------------------------------------------
+// Programs built by src/Emulator/test, each iteration boots the program and runs it for up to budget instructions
+// -----------------------------------------------------------------------------------------------
+static void
+EMULATOR_PROGRAM(benchmark::State& state, const char* name)
+{
+    // Setup --------------------------------------------------------------------------------------
+    const uint32_t    budget = static_cast<uint32_t>(state.range(0));
+    const std::string path   = std::string(XP_EMULATOR_BENCHMARK_PROGRAMS_DIR) + "/" + name;
+    RiscvElfLoader*   loader = xp_emulator_elf_loader_load(path.c_str());
+    if (loader == nullptr) {
+        state.SkipWithError(("could not load " + path).c_str());
+        return;
+    }
+    // programs linked before the flash/ram/heap split carry a single segment the processor can't boot
+    if (loader->num_segments != MAX_SEGMENTS || loader->segments[0].vaddr != XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE ||
+        loader->segments[1].vaddr != XP_EMULATOR_CONFIG_MEMORY_RAM_BASE ||
+        loader->segments[2].vaddr != XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE) {
+        state.SkipWithError(("memory layout of " + path + " does not match the emulator config, rebuild it").c_str());
+        xp_emulator_elf_loader_unload(loader);
+        return;
+    }
+    auto               processor = std::make_unique<XPEmulatorProcessor>();
+    XPEmulatorRunStats stats;
+    // --------------------------------------------------------------------------------------------
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        xp_emulator_processor_initialize(processor.get());
+        xp_emulator_processor_load_program(processor.get(), loader);
+        state.ResumeTiming();
+
+        // Benchmarked code -----------------------------------------------------------------------
+        uint64_t cyclesStart = hostCycles();
+        uint32_t remaining   = budget;
+        int      result      = XP_EMULATOR_PROGRAM_EXIT_CODE_SUCCESS;
+        while (remaining > 0 && result >= XP_EMULATOR_PROGRAM_EXIT_CODE_SUCCESS) {
+            uint32_t retired = 0;
+            result           = xp_emulator_processor_run_budget(processor.get(), remaining, &retired);
+            remaining -= retired;
+            stats.instructions += retired;
+        }
+        stats.cycles += hostCycles() - cyclesStart;
+        // ----------------------------------------------------------------------------------------
+
+        state.PauseTiming();
+        xp_emulator_processor_finalize(processor.get());
+        state.ResumeTiming();
+        if (result < XP_EMULATOR_PROGRAM_EXIT_CODE_SUCCESS && result != XP_EMULATOR_PROGRAM_EXIT_CODE_EBREAK) {
+            state.SkipWithError(("program stopped with exit code " + std::to_string(result)).c_str());
+            break;
+        }
+    }
+
+    // Cleanup ------------------------------------------------------------------------------------
+    reportStats(state, stats);
+    xp_emulator_elf_loader_unload(loader);
+    // --------------------------------------------------------------------------------------------
+}
+
+// Register the function as a benchmark
+BENCHMARK(EMULATOR_CONFORMANCE_RV32IM)->UseRealTime();
+BENCHMARK(EMULATOR_KERNEL_MEMCPY)->Arg(64 * 1024)->Arg(1024 * 1024)->UseRealTime();
+BENCHMARK(EMULATOR_KERNEL_MEMSET)->Arg(64 * 1024)->Arg(1024 * 1024)->UseRealTime();
+BENCHMARK(EMULATOR_KERNEL_MATMUL)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK(EMULATOR_KERNEL_CRC32)->Arg(4 * 1024)->Arg(64 * 1024)->UseRealTime();
+BENCHMARK_CAPTURE(EMULATOR_PROGRAM, capp32, "capp32")->Arg(10000000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(EMULATOR_PROGRAM, rasterizer32_frame, "rasterizer32")
+  ->Arg(50000000)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -118,12 +118,14 @@ set(XPENGINE_SOURCES_DATA_PIPELINE
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPStbTextureLoader.cpp
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPDataPipelineStore.cpp
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureBuffer.cpp
+    ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureCooker.cpp
 )
 set(XPENGINE_SOURCES_ENGINE
     ${CMAKE_SOURCE_DIR}/src/Engine/XPAllocators.cpp
     ${CMAKE_SOURCE_DIR}/src/Engine/XPConsole.cpp
     ${CMAKE_SOURCE_DIR}/src/Engine/XPEngine.cpp
     ${CMAKE_SOURCE_DIR}/src/Engine/XPRegistry.cpp
+    ${CMAKE_SOURCE_DIR}/src/Engine/XPScriptScheduler.cpp
     ${CMAKE_SOURCE_DIR}/src/Engine/XPViewport.cpp
 )
 set(XPENGINE_SOURCES_GAME
@@ -137,31 +139,34 @@ set(XPENGINE_SOURCES_MCP
 set(XPENGINE_SOURCES_PAINTING
     ${CMAKE_SOURCE_DIR}/src/Painting/XPPainting.cpp
 )
+# headless runs always use the empty physics, whatever backend is selected
+set(XPENGINE_SOURCES_PHYSICS
+    ${CMAKE_SOURCE_DIR}/src/Physics/Empty/XPEmptyPhysics.cpp
+)
 if(XP_PHYSICS_BULLET)
-    set(XPENGINE_SOURCES_PHYSICS
+    set(XPENGINE_SOURCES_PHYSICS ${XPENGINE_SOURCES_PHYSICS}
         ${CMAKE_SOURCE_DIR}/src/Physics/Bullet/XPBulletPhysics.cpp
     )
 elseif(XP_PHYSICS_JOLT)
-    set(XPENGINE_SOURCES_PHYSICS
+    set(XPENGINE_SOURCES_PHYSICS ${XPENGINE_SOURCES_PHYSICS}
+        ${CMAKE_SOURCE_DIR}/src/Physics/Jolt/XPJoltJobSystem.cpp
         ${CMAKE_SOURCE_DIR}/src/Physics/Jolt/XPJoltPhysics.cpp
+        ${CMAKE_SOURCE_DIR}/src/Physics/Jolt/XPJoltTempAllocator.cpp
     )
 elseif(XP_PHYSICS_PHYSX4)
-    set(XPENGINE_SOURCES_PHYSICS
+    set(XPENGINE_SOURCES_PHYSICS ${XPENGINE_SOURCES_PHYSICS}
         ${CMAKE_SOURCE_DIR}/src/Physics/PhysX4/XPPhysX4Physics.cpp
     )
 elseif(XP_PHYSICS_PHYSX5)
-    set(XPENGINE_SOURCES_PHYSICS
+    set(XPENGINE_SOURCES_PHYSICS ${XPENGINE_SOURCES_PHYSICS}
         ${CMAKE_SOURCE_DIR}/src/Physics/PhysX5/XPPhysX5Physics.cpp
     )
-else()
-    set(XPENGINE_SOURCES_PHYSICS
-        ${CMAKE_SOURCE_DIR}/src/Physics/Empty/XPEmptyPhysics.cpp
-    )
 endif()
 set(XPENGINE_SOURCES_PROFILER
     ${CMAKE_SOURCE_DIR}/src/Profiler/src/XPProfiler.cpp
 )
 set(XPENGINE_SOURCES_RENDERER
+    ${CMAKE_SOURCE_DIR}/src/Renderer/Empty/XPEmptyRenderer.cpp
     ${CMAKE_SOURCE_DIR}/src/Renderer/Interface/XPRendererGraph.cpp
 )
 if(XP_RENDERER_DX12)
@@ -242,6 +247,7 @@ elseif(XP_RENDERER_WGPU)
 endif()
 if (XP_RENDERER_SW)
     set(XPENGINE_SOURCES_RENDERER ${XPENGINE_SOURCES_RENDERER}
+        ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWFrameOutput.cpp
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWRenderer.cpp
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWThirdParty.cpp
     )
@@ -251,10 +257,12 @@ set(XPENGINE_SOURCES_SCENE_DESCRIPTOR
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/Attachments/XPRigidbody.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/Attachments/XPScript.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/Attachments/XPTransform.cpp
+    ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPAttachmentJson.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPFilter.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPLayer.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPNode.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPScene.cpp
+    ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneSnapshot.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneStore.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneDescriptorStore.cpp
 )
@@ -294,7 +302,10 @@ set(XPENGINE_SOURCES_UTILITIES
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPFreeCameraSystem.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPFS.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPLocker.cpp
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPLogger.cpp
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPMappedFile.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMemory.cpp
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPNameIndex.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPProfiler.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPRecorder.cpp
 )
@@ -325,12 +336,14 @@ set(XPENGINE_HEADERS_DATA_PIPELINE
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPDataPipelineStore.h
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureAsset.h
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureBuffer.h
+    ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureCooker.h
 )
 set(XPENGINE_HEADERS_ENGINE
     ${CMAKE_SOURCE_DIR}/src/Engine/XPAllocators.h
     ${CMAKE_SOURCE_DIR}/src/Engine/XPConsole.h
     ${CMAKE_SOURCE_DIR}/src/Engine/XPEngine.h
     ${CMAKE_SOURCE_DIR}/src/Engine/XPRegistry.h
+    ${CMAKE_SOURCE_DIR}/src/Engine/XPScriptScheduler.h
     ${CMAKE_SOURCE_DIR}/src/Engine/XPViewport.h
 )
 set(XPENGINE_HEADERS_GAME
@@ -355,6 +368,7 @@ set(XPENGINE_HEADERS_PAINTING
 )
 set(XPENGINE_HEADERS_PHYSICS
     ${CMAKE_SOURCE_DIR}/src/Physics/Interface/XPIPhysics.h
+    ${CMAKE_SOURCE_DIR}/src/Physics/Empty/XPEmptyPhysics.h
 )
 if(XP_PHYSICS_BULLET)
     set(XPENGINE_HEADERS_PHYSICS ${XPENGINE_HEADERS_PHYSICS}
@@ -362,7 +376,9 @@ if(XP_PHYSICS_BULLET)
     )
 elseif(XP_PHYSICS_JOLT)
     set(XPENGINE_HEADERS_PHYSICS ${XPENGINE_HEADERS_PHYSICS}
+        ${CMAKE_SOURCE_DIR}/src/Physics/Jolt/XPJoltJobSystem.h
         ${CMAKE_SOURCE_DIR}/src/Physics/Jolt/XPJoltPhysics.h
+        ${CMAKE_SOURCE_DIR}/src/Physics/Jolt/XPJoltTempAllocator.h
     )
 elseif(XP_PHYSICS_PHYSX4)
     set(XPENGINE_HEADERS_PHYSICS ${XPENGINE_HEADERS_PHYSICS}
@@ -372,15 +388,12 @@ elseif(XP_PHYSICS_PHYSX5)
     set(XPENGINE_HEADERS_PHYSICS ${XPENGINE_HEADERS_PHYSICS}
         ${CMAKE_SOURCE_DIR}/src/Physics/PhysX5/XPPhysX5Physics.h
     )
-else()
-    set(XPENGINE_HEADERS_PHYSICS ${XPENGINE_HEADERS_PHYSICS}
-        ${CMAKE_SOURCE_DIR}/src/Physics/Empty/XPEmptyPhysics.h
-    )
 endif()
 set(XPENGINE_HEADERS_PROFILER
     ${CMAKE_SOURCE_DIR}/src/Profiler/include/Profiler/XPProfiler.h
 )
 set(XPENGINE_HEADERS_RENDERER
+    ${CMAKE_SOURCE_DIR}/src/Renderer/Empty/XPEmptyRenderer.h
     ${CMAKE_SOURCE_DIR}/src/Renderer/Interface/XPIRenderer.h
     ${CMAKE_SOURCE_DIR}/src/Renderer/Interface/XPIRendererBuffer.h
     ${CMAKE_SOURCE_DIR}/src/Renderer/Interface/XPIRendererCommandBuffer.h
@@ -487,7 +500,9 @@ endif()
 if (XP_RENDERER_SW)
     set(XPENGINE_HEADERS_RENDERER ${XPENGINE_HEADERS_RENDERER}
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWBVH.h
+        ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWFrameOutput.h
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWImporter.h
+        ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWLightGrid.h
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWLogger.h
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWMaths.h
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWMemoryPool.h
@@ -495,6 +510,8 @@ if (XP_RENDERER_SW)
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWRenderer.h
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWRendererCommon.h
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWSceneDescriptor.h
+        ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWShadowMaps.h
+        ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWSimd.h
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWTests.h
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWTexture.h
         ${CMAKE_SOURCE_DIR}/src/Renderer/SW/XPSWThirdParty.h
@@ -509,12 +526,14 @@ set(XPENGINE_HEADERS_SCENE_DESCRIPTOR
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/Attachments/XPRigidbody.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/Attachments/XPScript.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/Attachments/XPTransform.h
+    ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPAttachmentJson.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPAttachments.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPEnums.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPFilter.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPLayer.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPNode.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPScene.h
+    ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneSnapshot.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneStore.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneDescriptorStore.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPTypes.h
@@ -558,12 +577,15 @@ set(XPENGINE_HEADERS_UTILITIES
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPDiscarder.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPFreeCameraSystem.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPFS.h
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPHash.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPLocker.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPLogger.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMacros.h
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPMappedFile.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMaths.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMemory.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMemoryPool.h
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPNameIndex.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPPlatforms.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPProfiler.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPRecorder.h
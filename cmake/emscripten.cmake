@@ -18,6 +18,7 @@ set(XPENGINE_SOURCES_DATA_PIPELINE
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPStbTextureLoader.cpp
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPStore.cpp
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureBuffer.cpp
+    ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureCooker.cpp
 )
 set(XPENGINE_SOURCES_ENGINE
     ${CMAKE_SOURCE_DIR}/src/Engine/XPConsole.cpp
@@ -50,10 +51,12 @@ set(XPENGINE_SOURCES_RENDERER
     ${CMAKE_SOURCE_DIR}/src/Renderer/WebGPU/XPWGPUWindow.cpp
 )
 set(XPENGINE_SOURCES_SCENE_DESCRIPTOR
+    ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPAttachmentJson.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPFilter.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPLayer.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPNode.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPScene.cpp
+    ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneSnapshot.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneStore.cpp
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPStore.cpp
 )
@@ -81,7 +84,10 @@ set(XPENGINE_SOURCES_UTILITIES
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPDiscarder.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPFreeCameraSystem.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPLocker.cpp
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPLogger.cpp
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPMappedFile.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMemory.cpp
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPNameIndex.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPProfiler.cpp
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPRecorder.cpp
 )
@@ -110,6 +116,7 @@ set(XPENGINE_HEADERS_DATA_PIPELINE
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPStore.h
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureAsset.h
     ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureBuffer.h
+    ${CMAKE_SOURCE_DIR}/src/DataPipeline/XPTextureCooker.h
 )
 set(XPENGINE_HEADERS_ENGINE
     ${CMAKE_SOURCE_DIR}/src/Engine/XPConsole.h
@@ -173,12 +180,14 @@ set(XPENGINE_HEADERS_SCENE_DESCRIPTOR
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/Attachments/XPOrbitCamera.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/Attachments/XPRigidbody.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/Attachments/XPTransform.h
+    ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPAttachmentJson.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPAttachments.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPEnums.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPFilter.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPLayer.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPNode.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPScene.h
+    ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneSnapshot.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPSceneStore.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPStore.h
     ${CMAKE_SOURCE_DIR}/src/SceneDescriptor/XPTypes.h
@@ -211,12 +220,15 @@ set(XPENGINE_HEADERS_UTILITIES
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPDiscarder.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPFreeCameraSystem.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPFS.h
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPHash.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPLocker.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPLogger.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMacros.h
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPMappedFile.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMaths.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMemory.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPMemoryPool.h
+    ${CMAKE_SOURCE_DIR}/src/Utilities/XPNameIndex.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPPlatforms.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPProfiler.h
     ${CMAKE_SOURCE_DIR}/src/Utilities/XPRecorder.h
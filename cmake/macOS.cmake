@@ -174,6 +174,9 @@ if(XP_BUILD_BENCHMARKS)
     target_include_directories(XPBenchmarks PRIVATE ${XPTHIRDPARTY_INCLUDE_DIRECTORIES})
     target_link_directories(XPBenchmarks PRIVATE ${XPTHIRDPARTY_LINK_DIRECTORIES})
     target_link_libraries(XPBenchmarks PRIVATE benchmark::benchmark ${XPTHIRDPARTY_LINK_LIBRARIES})
+    add_executable(XPEmulatorBenchmarks ${CMAKE_SOURCE_DIR}/benchmarks/XPEmulatorBenchmarks.cpp)
+    target_compile_definitions(XPEmulatorBenchmarks PRIVATE XP_EMULATOR_BENCHMARK_PROGRAMS_DIR="${CMAKE_SOURCE_DIR}/src/Emulator/test/build/Debug")
+    target_link_libraries(XPEmulatorBenchmarks PRIVATE benchmark::benchmark XPEmulator)
 endif(XP_BUILD_BENCHMARKS)
 # ---------------------------------------------------------------------------------------------------------------------------------------------------
 
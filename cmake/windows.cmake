@@ -189,6 +189,12 @@ if(XP_BUILD_BENCHMARKS)
     set_property(TARGET XPBenchmarks
         PROPERTY MSVC_RUNTIME_LIBRARY "MultiThreaded$<$<CONFIG:Debug>:Debug>"
     )
+    add_executable(XPEmulatorBenchmarks ${CMAKE_SOURCE_DIR}/benchmarks/XPEmulatorBenchmarks.cpp)
+    target_compile_definitions(XPEmulatorBenchmarks PRIVATE XP_EMULATOR_BENCHMARK_PROGRAMS_DIR="${CMAKE_SOURCE_DIR}/src/Emulator/test/build/Debug")
+    target_link_libraries(XPEmulatorBenchmarks PRIVATE benchmark::benchmark XPEmulator)
+    set_property(TARGET XPEmulatorBenchmarks
+        PROPERTY MSVC_RUNTIME_LIBRARY "MultiThreaded$<$<CONFIG:Debug>:Debug>"
+    )
 endif(XP_BUILD_BENCHMARKS)
 # ---------------------------------------------------------------------------------------------------------------------------------------------------
 
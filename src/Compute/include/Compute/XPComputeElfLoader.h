@@ -22,19 +22,22 @@
 
 #define MAX_SEGMENTS 3
 
+// data is a view into the mapped file and is never copied
 typedef struct
 {
-    uint64_t vaddr;
-    uint64_t size;
-    uint32_t flags;
-    uint8_t* data;
+    uint64_t       vaddr;
+    uint64_t       size;      // bytes in guest memory, everything past file_size is zero filled by the consumer
+    uint64_t       file_size; // bytes backed by the file
+    uint32_t       flags;
+    const uint8_t* data;
 } MemorySegment;
 
+// the file stays mapped read only until the loader is unloaded
 typedef struct
 {
-    char*    filename;
-    uint8_t* file_data;
-    size_t   file_size;
+    char*          filename;
+    const uint8_t* file_data;
+    size_t         file_size;
 
     MemorySegment segments[MAX_SEGMENTS];
     int           num_segments;
@@ -138,9 +138,10 @@ load_and_run_cuda(const char* riscvCoreProgram)
     h_processors[0].regs[int(XPXPUEReg::R2)] = XP_XPU_CONFIG_HMM_TOP_STACK_PTR;
     h_processors[0].pc                       = 0;
 
-    memcpy(h_processors[0].bus.memory.flash, loader->segments[0].data, loader->segments[0].size);
-    memcpy(h_processors[0].bus.memory.ram, loader->segments[1].data, loader->segments[1].size);
-    memcpy(h_processors[0].bus.memory.heap, loader->segments[2].data, loader->segments[2].size);
+    // the regions were cleared above, only the file backed bytes are copied, device memory can't map the file
+    memcpy(h_processors[0].bus.memory.flash, loader->segments[0].data, loader->segments[0].file_size);
+    memcpy(h_processors[0].bus.memory.ram, loader->segments[1].data, loader->segments[1].file_size);
+    memcpy(h_processors[0].bus.memory.heap, loader->segments[2].data, loader->segments[2].file_size);
 
     h_processors[0].pc = loader->entry_point;
 
@@ -9,6 +9,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#if defined(_WIN32) || defined(_WIN64)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
 
 // ELF constants
 #define EI_MAG0    0
@@ -172,56 +180,91 @@ elf_loader_create(const char* filename)
     return loader;
 }
 
+// Unmap the file, every segment view and the symbol names die with it
+static void
+unmap_file(RiscvElfLoader* loader)
+{
+    if (!loader->file_data) { return; }
+#if defined(_WIN32) || defined(_WIN64)
+    UnmapViewOfFile((LPCVOID)loader->file_data);
+#else
+    munmap((void*)loader->file_data, loader->file_size);
+#endif
+    loader->file_data = NULL;
+    loader->file_size = 0;
+}
+
 // Free the ELF loader
 static void
 elf_loader_destroy(RiscvElfLoader* loader)
 {
     if (!loader) return;
 
-    // Free segments
-    for (int i = 0; i < loader->num_segments; i++) {
-        if (loader->segments[i].data) { free(loader->segments[i].data); }
-    }
-
-    if (loader->file_data) { free(loader->file_data); }
+    unmap_file(loader);
 
     if (loader->filename) { free(loader->filename); }
 
     free(loader);
 }
 
-// Load file into memory
+// Map the whole file read only, the pages are shared with every other mapping of the same binary
 static bool
-load_file(RiscvElfLoader* loader)
+map_file(RiscvElfLoader* loader)
 {
-    FILE* file = fopen(loader->filename, "rb");
-    if (!file) {
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE file = CreateFileA(
+      loader->filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
         fprintf(stderr, "Failed to open file: %s\n", loader->filename);
         return false;
     }
 
-    // Get file size
-    fseek(file, 0, SEEK_END);
-    loader->file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < EI_NIDENT) {
+        fprintf(stderr, "File too small to be valid ELF\n");
+        CloseHandle(file);
+        return false;
+    }
 
-    // Allocate memory
-    loader->file_data = malloc(loader->file_size);
-    if (!loader->file_data) {
-        fprintf(stderr, "Failed to allocate memory for file\n");
-        fclose(file);
+    // the view keeps the section and the file alive
+    HANDLE section = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!section) {
+        fprintf(stderr, "Failed to map file: %s\n", loader->filename);
+        return false;
+    }
+    void* view = MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(section);
+    if (!view) {
+        fprintf(stderr, "Failed to map file: %s\n", loader->filename);
+        return false;
+    }
+    loader->file_size = (size_t)size.QuadPart;
+#else
+    int file = open(loader->filename, O_RDONLY);
+    if (file < 0) {
+        fprintf(stderr, "Failed to open file: %s\n", loader->filename);
         return false;
     }
 
-    // Read file
-    size_t bytes_read = fread(loader->file_data, 1, loader->file_size, file);
-    fclose(file);
+    struct stat st;
+    if (fstat(file, &st) != 0 || st.st_size < EI_NIDENT) {
+        fprintf(stderr, "File too small to be valid ELF\n");
+        close(file);
+        return false;
+    }
 
-    if (bytes_read != loader->file_size) {
-        fprintf(stderr, "Failed to read complete file\n");
+    // the mapping holds its own reference to the file
+    void* view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED) {
+        fprintf(stderr, "Failed to map file: %s\n", loader->filename);
         return false;
     }
+    loader->file_size = (size_t)st.st_size;
+#endif
 
+    loader->file_data = (const uint8_t*)view;
     return true;
 }
 
@@ -234,7 +277,7 @@ validate_elf_header(RiscvElfLoader* loader)
         return false;
     }
 
-    uint8_t* ident = loader->file_data;
+    const uint8_t* ident = loader->file_data;
 
     // Check ELF magic
     if (ident[EI_MAG0] != ELFMAG0 || ident[EI_MAG1] != ELFMAG1 || ident[EI_MAG2] != ELFMAG2 ||
@@ -263,19 +306,19 @@ validate_elf_header(RiscvElfLoader* loader)
 
 // Parse 32-bit program headers
 static bool
-parse_program_headers_32(RiscvElfLoader* loader, Elf32_Ehdr* header)
+parse_program_headers_32(RiscvElfLoader* loader, const Elf32_Ehdr* header)
 {
     uint32_t phoff     = fix_endian32(loader, header->e_phoff);
     uint16_t phnum     = fix_endian16(loader, header->e_phnum);
     uint16_t phentsize = fix_endian16(loader, header->e_phentsize);
 
-    if (phoff + phnum * phentsize > loader->file_size) {
+    if ((uint64_t)phoff + (uint64_t)phnum * phentsize > loader->file_size) {
         fprintf(stderr, "Program headers extend beyond file size\n");
         return false;
     }
 
     for (int i = 0; i < phnum && loader->num_segments < MAX_SEGMENTS; i++) {
-        Elf32_Phdr* phdr = (Elf32_Phdr*)(loader->file_data + phoff + i * phentsize);
+        const Elf32_Phdr* phdr = (const Elf32_Phdr*)(loader->file_data + phoff + i * phentsize);
 
         uint32_t type = fix_endian32(loader, phdr->p_type);
         if (type == PT_LOAD) {
@@ -285,7 +328,7 @@ parse_program_headers_32(RiscvElfLoader* loader, Elf32_Ehdr* header)
             uint32_t offset = fix_endian32(loader, phdr->p_offset);
             uint32_t flags  = fix_endian32(loader, phdr->p_flags);
 
-            if (offset + filesz > loader->file_size) {
+            if (offset > loader->file_size || filesz > loader->file_size - offset || filesz > memsz) {
                 fprintf(stderr, "Segment extends beyond file size\n");
                 return false;
             }
@@ -293,19 +336,9 @@ parse_program_headers_32(RiscvElfLoader* loader, Elf32_Ehdr* header)
             MemorySegment* segment = &loader->segments[loader->num_segments];
             segment->vaddr         = vaddr;
             segment->size          = memsz;
+            segment->file_size     = filesz;
             segment->flags         = flags;
-            segment->data          = malloc(memsz);
-
-            if (!segment->data) {
-                fprintf(stderr, "Failed to allocate segment memory\n");
-                return false;
-            }
-
-            // Initialize with zeros
-            memset(segment->data, 0, memsz);
-
-            // Copy file data
-            if (filesz > 0) { memcpy(segment->data, loader->file_data + offset, filesz); }
+            segment->data          = loader->file_data + offset;
 
             loader->num_segments++;
 
@@ -318,19 +351,19 @@ parse_program_headers_32(RiscvElfLoader* loader, Elf32_Ehdr* header)
 
 // Parse 64-bit program headers
 static bool
-parse_program_headers_64(RiscvElfLoader* loader, Elf64_Ehdr* header)
+parse_program_headers_64(RiscvElfLoader* loader, const Elf64_Ehdr* header)
 {
     uint64_t phoff     = fix_endian64(loader, header->e_phoff);
     uint16_t phnum     = fix_endian16(loader, header->e_phnum);
     uint16_t phentsize = fix_endian16(loader, header->e_phentsize);
 
-    if (phoff + phnum * phentsize > loader->file_size) {
+    if ((uint64_t)phoff + (uint64_t)phnum * phentsize > loader->file_size) {
         fprintf(stderr, "Program headers extend beyond file size\n");
         return false;
     }
 
     for (int i = 0; i < phnum && loader->num_segments < MAX_SEGMENTS; i++) {
-        Elf64_Phdr* phdr = (Elf64_Phdr*)(loader->file_data + phoff + i * phentsize);
+        const Elf64_Phdr* phdr = (const Elf64_Phdr*)(loader->file_data + phoff + i * phentsize);
 
         uint32_t type = fix_endian32(loader, phdr->p_type);
         if (type == PT_LOAD) {
@@ -340,7 +373,7 @@ parse_program_headers_64(RiscvElfLoader* loader, Elf64_Ehdr* header)
             uint64_t offset = fix_endian64(loader, phdr->p_offset);
             uint32_t flags  = fix_endian32(loader, phdr->p_flags);
 
-            if (offset + filesz > loader->file_size) {
+            if (offset > loader->file_size || filesz > loader->file_size - offset || filesz > memsz) {
                 fprintf(stderr, "Segment extends beyond file size\n");
                 return false;
             }
@@ -348,19 +381,9 @@ parse_program_headers_64(RiscvElfLoader* loader, Elf64_Ehdr* header)
             MemorySegment* segment = &loader->segments[loader->num_segments];
             segment->vaddr         = vaddr;
             segment->size          = memsz;
+            segment->file_size     = filesz;
             segment->flags         = flags;
-            segment->data          = malloc(memsz);
-
-            if (!segment->data) {
-                fprintf(stderr, "Failed to allocate segment memory\n");
-                return false;
-            }
-
-            // Initialize with zeros
-            memset(segment->data, 0, memsz);
-
-            // Copy file data
-            if (filesz > 0) { memcpy(segment->data, loader->file_data + offset, filesz); }
+            segment->data          = loader->file_data + offset;
 
             loader->num_segments++;
 
@@ -381,7 +404,7 @@ parse_elf_header(RiscvElfLoader* loader)
             return false;
         }
 
-        Elf64_Ehdr* header = (Elf64_Ehdr*)loader->file_data;
+        const Elf64_Ehdr* header = (const Elf64_Ehdr*)loader->file_data;
 
         if (fix_endian16(loader, header->e_machine) != EM_RISCV) {
             fprintf(stderr, "Not a RISC-V binary (machine type: %d)\n", fix_endian16(loader, header->e_machine));
@@ -396,7 +419,7 @@ parse_elf_header(RiscvElfLoader* loader)
             return false;
         }
 
-        Elf32_Ehdr* header = (Elf32_Ehdr*)loader->file_data;
+        const Elf32_Ehdr* header = (const Elf32_Ehdr*)loader->file_data;
 
         if (fix_endian16(loader, header->e_machine) != EM_RISCV) {
             fprintf(stderr, "Not a RISC-V binary (machine type: %d)\n", fix_endian16(loader, header->e_machine));
@@ -412,7 +435,7 @@ parse_elf_header(RiscvElfLoader* loader)
 static bool
 elf_loader_load(RiscvElfLoader* loader)
 {
-    if (!load_file(loader)) { return false; }
+    if (!map_file(loader)) { return false; }
 
     if (!validate_elf_header(loader)) { return false; }
 
@@ -435,8 +458,12 @@ elf_loader_read_memory(const RiscvElfLoader* loader, uint64_t address, void* buf
     for (int i = 0; i < loader->num_segments; i++) {
         const MemorySegment* segment = &loader->segments[i];
         if (address >= segment->vaddr && address + size <= segment->vaddr + segment->size) {
-            size_t offset = address - segment->vaddr;
-            memcpy(buffer, segment->data + offset, size);
+            // bytes past the file backed part are zero
+            uint64_t offset = address - segment->vaddr;
+            uint64_t backed = offset < segment->file_size ? segment->file_size - offset : 0;
+            if (backed > size) { backed = size; }
+            memcpy(buffer, segment->data + offset, (size_t)backed);
+            memset((uint8_t*)buffer + backed, 0, size - (size_t)backed);
             return true;
         }
     }
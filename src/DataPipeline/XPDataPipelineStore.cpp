@@ -33,6 +33,7 @@
 XPDataPipelineStore::XPDataPipelineStore(XPRegistry* const registry)
   : _registry(registry)
   , _hasFilesNeedsReload(false)
+  , _filesVersion(0)
 {
     _filesPool              = XP_NEW              XPMemoryPool<XPFile>(32, 64);
     _meshAssetsPool         = XP_NEW         XPMemoryPool<XPMeshAsset>(32, 64);
@@ -76,6 +77,7 @@ XPDataPipelineStore::~XPDataPipelineStore()
     _materialBuffers.clear();
     delete _meshBuffersPool;
     _meshBuffers.clear();
+    _meshBuffersById.clear();
     delete _shaderBuffersPool;
     _shaderBuffers.clear();
     delete _textureBuffersPool;
@@ -90,6 +92,7 @@ XPDataPipelineStore::createFile(const std::string path, XPEFileResourceType type
     if (_files[type].find(path) != _files[type].end()) { return std::nullopt; }
     XPFile* file       = _filesPool->create(this, path, ++_nextFileId, type);
     _files[type][path] = file;
+    ++_filesVersion;
     return file;
 }
 
@@ -142,8 +145,9 @@ std::optional<XPMeshBuffer*>
 XPDataPipelineStore::createMeshBuffer(XPMeshAsset* meshAssset)
 {
     if (_meshBuffers.find(meshAssset) != _meshBuffers.end()) { return std::nullopt; }
-    XPMeshBuffer* meshBuffer = _meshBuffersPool->create(meshAssset, ++_nextMeshBufferId);
-    _meshBuffers[meshAssset] = meshBuffer;
+    XPMeshBuffer* meshBuffer              = _meshBuffersPool->create(meshAssset, ++_nextMeshBufferId);
+    _meshBuffers[meshAssset]              = meshBuffer;
+    _meshBuffersById[meshBuffer->getId()] = meshBuffer;
     return meshBuffer;
 }
 
@@ -239,6 +243,14 @@ XPDataPipelineStore::getRiscvBinaryAsset(XPFile* file) const
     return std::nullopt;
 }
 
+std::optional<XPMeshBuffer*>
+XPDataPipelineStore::getMeshBuffer(uint32_t meshBufferId) const
+{
+    auto it = _meshBuffersById.find(meshBufferId);
+    if (it != _meshBuffersById.end()) { return { it->second }; }
+    return std::nullopt;
+}
+
 const std::unordered_map<XPEFileResourceType, std::unordered_map<std::string, XPFile*>>&
 XPDataPipelineStore::getFiles() const
 {
@@ -311,8 +323,10 @@ XPDataPipelineStore::destroyFile(const std::string path, XPEFileResourceType typ
     auto& typedFiles = _files[type];
     auto  it         = typedFiles.find(path);
     if (it != typedFiles.end()) {
+        XPFile* file = it->second;
         typedFiles.erase(it);
-        _filesPool->destroy(it->second);
+        _filesPool->destroy(file);
+        ++_filesVersion;
     }
 }
 
@@ -323,7 +337,8 @@ XPDataPipelineStore::destroyFile(XPFile* file)
     auto  it         = typedFiles.find(file->getPath());
     if (it != typedFiles.end()) {
         typedFiles.erase(it);
-        _filesPool->destroy(it->second);
+        _filesPool->destroy(file);
+        ++_filesVersion;
     }
 }
 
@@ -383,6 +398,7 @@ XPDataPipelineStore::destroyMeshBuffer(XPMeshBuffer* meshBuffer)
     auto it = _meshBuffers.find(meshBuffer->getMeshAsset());
     if (it != _meshBuffers.end()) {
         _meshBuffers.erase(it);
+        _meshBuffersById.erase(meshBuffer->getId());
         _meshBuffersPool->destroy(meshBuffer);
     }
 }
@@ -444,3 +460,9 @@ XPDataPipelineStore::clearFilesNeedReload()
 {
     _hasFilesNeedsReload = false;
 }
+
+uint64_t
+XPDataPipelineStore::getFilesVersion() const
+{
+    return _filesVersion;
+}
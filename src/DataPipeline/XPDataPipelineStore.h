@@ -63,6 +63,7 @@ class XPDataPipelineStore
     [[nodiscard]] std::optional<XPTextureAsset*>     getTextureAsset(XPFile* file) const;
     [[nodiscard]] std::optional<XPMaterialAsset*>    getMaterialAsset(const std::string name) const;
     [[nodiscard]] std::optional<XPRiscvBinaryAsset*> getRiscvBinaryAsset(XPFile* file) const;
+    [[nodiscard]] std::optional<XPMeshBuffer*>       getMeshBuffer(uint32_t meshBufferId) const;
 
     [[nodiscard]] const std::unordered_map<XPEFileResourceType, std::unordered_map<std::string, XPFile*>>& getFiles()
       const;
@@ -94,6 +95,9 @@ class XPDataPipelineStore
     void setFilesNeedReload();
     void clearFilesNeedReload();
 
+    // bumped whenever a file is created or destroyed, views caching the file list compare it against their copy
+    [[nodiscard]] uint64_t getFilesVersion() const;
+
   private:
     XPRegistry* const _registry = nullptr;
 
@@ -111,6 +115,7 @@ class XPDataPipelineStore
 
     std::unordered_map<XPEFileResourceType, std::unordered_map<std::string, XPFile*>> _files;
     std::unordered_map<XPMeshAsset*, XPMeshBuffer*>                                   _meshBuffers;
+    std::unordered_map<uint32_t, XPMeshBuffer*>                                       _meshBuffersById;
     std::unordered_map<XPShaderAsset*, XPShaderBuffer*>                               _shaderBuffers;
     std::unordered_map<XPTextureAsset*, XPTextureBuffer*>                             _textureBuffers;
     std::unordered_map<XPMaterialAsset*, XPMaterialBuffer*>                           _materialBuffers;
@@ -134,4 +139,6 @@ class XPDataPipelineStore
     XPMemoryPool<XPRiscvBinaryAsset>*  _riscvBinaryAssetsPool;
 
     bool _hasFilesNeedsReload;
+
+    uint64_t _filesVersion;
 };
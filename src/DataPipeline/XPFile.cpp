@@ -23,6 +23,9 @@
 #include <DataPipeline/XPTextureAsset.h>
 #include <Physics/Interface/XPIPhysics.h>
 #include <Renderer/Interface/XPIRenderer.h>
+#if defined(XP_RENDERER_SW)
+    #include <Renderer/SW/XPSWRenderer.h>
+#endif
 #include <SceneDescriptor/XPScene.h>
 #include <SceneDescriptor/XPSceneDescriptorStore.h>
 #include <Utilities/XPFS.h>
@@ -559,6 +562,9 @@ XPFile::loadMeshFromMemory()
         _dataPipelineStore->getRegistry()->getPhysics()->beginUploadMeshAssets();
         for (auto& meshAsset : _meshAssets) {
             _dataPipelineStore->getRegistry()->getRenderer()->uploadMeshAsset(meshAsset);
+#if defined(XP_RENDERER_SW)
+            _dataPipelineStore->getRegistry()->getSWRenderer()->uploadMeshAsset(meshAsset);
+#endif
             _dataPipelineStore->getRegistry()->getPhysics()->uploadMeshAsset(meshAsset);
         }
         _dataPipelineStore->getRegistry()->getRenderer()->endUploadMeshAssets();
@@ -580,6 +586,9 @@ XPFile::loadMeshFromDisk()
                 _dataPipelineStore->getRegistry()->getPhysics()->beginUploadMeshAssets();
                 for (auto& meshAsset : _meshAssets) {
                     _dataPipelineStore->getRegistry()->getRenderer()->uploadMeshAsset(meshAsset);
+#if defined(XP_RENDERER_SW)
+                    _dataPipelineStore->getRegistry()->getSWRenderer()->uploadMeshAsset(meshAsset);
+#endif
                     _dataPipelineStore->getRegistry()->getPhysics()->uploadMeshAsset(meshAsset);
                 }
                 _dataPipelineStore->getRegistry()->getRenderer()->endUploadMeshAssets();
@@ -645,6 +654,9 @@ XPFile::loadSceneFromDisk()
                     _dataPipelineStore->getRegistry()->getPhysics()->beginUploadMeshAssets();
 
                     _dataPipelineStore->getRegistry()->getRenderer()->uploadMeshAsset(meshAsset);
+#if defined(XP_RENDERER_SW)
+                    _dataPipelineStore->getRegistry()->getSWRenderer()->uploadMeshAsset(meshAsset);
+#endif
                     _dataPipelineStore->getRegistry()->getPhysics()->uploadMeshAsset(meshAsset);
 
                     _dataPipelineStore->getRegistry()->getRenderer()->endUploadMeshAssets();
@@ -712,6 +724,9 @@ XPFile::reloadMeshFromMemory()
         _dataPipelineStore->getRegistry()->getRenderer()->beginReUploadMeshAssets();
         for (auto& meshAsset : _meshAssets) {
             _dataPipelineStore->getRegistry()->getRenderer()->reUploadMeshAsset(meshAsset);
+#if defined(XP_RENDERER_SW)
+            _dataPipelineStore->getRegistry()->getSWRenderer()->reUploadMeshAsset(meshAsset);
+#endif
         }
         _dataPipelineStore->getRegistry()->getRenderer()->endReUploadMeshAssets();
     }
@@ -726,6 +741,9 @@ XPFile::reloadMeshFromDisk()
         _dataPipelineStore->getRegistry()->getPhysics()->beginReUploadMeshAssets();
         for (auto& meshAsset : _meshAssets) {
             _dataPipelineStore->getRegistry()->getRenderer()->reUploadMeshAsset(meshAsset);
+#if defined(XP_RENDERER_SW)
+            _dataPipelineStore->getRegistry()->getSWRenderer()->reUploadMeshAsset(meshAsset);
+#endif
             _dataPipelineStore->getRegistry()->getPhysics()->reUploadMeshAsset(meshAsset);
         }
         _dataPipelineStore->getRegistry()->getRenderer()->endReUploadMeshAssets();
@@ -768,6 +786,9 @@ XPFile::reloadSceneFromDisk()
         XPAssimpModelLoader::loadScene(*_meshAssets.begin(), *_scene, *_dataPipelineStore);
         for (auto& meshAsset : _meshAssets) {
             _dataPipelineStore->getRegistry()->getRenderer()->reUploadMeshAsset(meshAsset);
+#if defined(XP_RENDERER_SW)
+            _dataPipelineStore->getRegistry()->getSWRenderer()->reUploadMeshAsset(meshAsset);
+#endif
             _dataPipelineStore->getRegistry()->getPhysics()->reUploadMeshAsset(meshAsset);
         }
     }
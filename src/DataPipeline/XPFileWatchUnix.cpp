@@ -26,13 +26,25 @@
 #include <DataPipeline/XPTextureAsset.h>
 #include <DataPipeline/XPTextureBuffer.h>
 
+#include <Engine/XPConsole.h>
+#include <Engine/XPEngine.h>
 #include <Utilities/XPFS.h>
+#include <Utilities/XPHash.h>
 #include <Utilities/XPLogger.h>
+#include <Utilities/XPMappedFile.h>
 
 #include <chrono>
 #include <sstream>
 #include <thread>
 
+#if defined(XP_PLATFORM_LINUX)
+    #include <errno.h>
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
 #ifdef __clang__
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wall"
@@ -44,13 +56,42 @@
     #pragma clang diagnostic pop
 #endif
 
+// used until the "fw.debounceMs" console variable is reachable
+static constexpr int XPFileWatchDefaultDebounceMs = 50;
+
+static bool
+computeContentHash(const std::string& path, uint64_t& hash)
+{
+    XPMappedFile mapping;
+    if (mapping.open(path)) {
+        hash = XPHash::xxh64(mapping.getData(), mapping.getSize());
+        return true;
+    }
+    // empty files cannot be mapped but are still valid content
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(path, ec) && std::filesystem::file_size(path, ec) == 0 && !ec) {
+        hash = XPHash::xxh64(nullptr, 0);
+        return true;
+    }
+    return false;
+}
+
 XPFileWatchUnix::XPFileWatchUnix(XPRegistry* const registry)
   : XPIFileWatch(registry)
   , _registry(registry)
+  , _dataPipelineStore(nullptr)
+#if defined(XP_PLATFORM_MACOS)
+  , _fswatch_handle(nullptr)
+#elif defined(XP_PLATFORM_LINUX)
+  , _inotifyFd(-1)
+  , _wakeFd(-1)
+#endif
+  , _isRunning(false)
+  , _stopRequested(false)
 {
 }
 
-XPFileWatchUnix::~XPFileWatchUnix() {}
+XPFileWatchUnix::~XPFileWatchUnix() { stop(); }
 
 void
 XPFileWatchUnix::start(XPDataPipelineStore* dataPipelineStore,
@@ -130,25 +171,23 @@ XPFileWatchUnix::start(XPDataPipelineStore* dataPipelineStore,
         if (XPFile::isTextureFile(fullPath)) { _dataPipelineStore->createFile(fullPath, XPEFileResourceType::Texture); }
     }
 
+#if defined(XP_PLATFORM_MACOS)
     if (FSW_OK != fsw_init_library()) {
         fsw_last_error();
         XP_LOG(XPLoggerSeverityFatal, "Failed to initialize file watcher !");
         return;
     }
+#endif
 
     auto t2 = std::chrono::high_resolution_clock::now();
 
     /* Getting number of milliseconds as an integer. */
     auto ms_int = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1);
 
-    XP_LOGV(XPLoggerSeverityInfo, "Assets loading time is %u", ms_int);
+    XP_LOGV(XPLoggerSeverityInfo, "Assets loading time is %lld us", static_cast<long long>(ms_int.count()));
 
 #if defined(XP_PLATFORM_MACOS)
     _fswatch_handle = fsw_init_session(fsevents_monitor_type);
-#elif defined(XP_PLATFORM_LINUX)
-    _fswatch_handle = fsw_init_session(windows_monitor_type);
-#endif
-
     if (!_fswatch_handle) {
         fsw_last_error();
         XP_LOG(XPLoggerSeverityFatal, "Invalid fswatch handle");
@@ -158,6 +197,8 @@ XPFileWatchUnix::start(XPDataPipelineStore* dataPipelineStore,
     if (FSW_OK != fsw_add_path(_fswatch_handle, _rootPath.c_str())) { fsw_last_error(); }
     // register callback function
     if (FSW_OK != fsw_set_callback(_fswatch_handle, &XPFileWatchUnix::fswatch_callback, this)) { fsw_last_error(); }
+    // events are debounced by the reload thread, let the monitor deliver them as soon as possible
+    if (FSW_OK != fsw_set_latency(_fswatch_handle, 0.01)) { fsw_last_error(); }
     // set overflow
     fsw_set_allow_overflow(_fswatch_handle, false);
     // start monitor
@@ -165,15 +206,65 @@ XPFileWatchUnix::start(XPDataPipelineStore* dataPipelineStore,
         XP_LOG(XPLoggerSeverityFatal, "Error creating thread");
         return;
     }
+#elif defined(XP_PLATFORM_LINUX)
+    _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    _wakeFd    = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_inotifyFd < 0 || _wakeFd < 0) {
+        XP_LOG(XPLoggerSeverityFatal, "Failed to initialize inotify !");
+        // the watcher never runs so stop() won't close whichever of the two was created
+        if (_inotifyFd >= 0) { close(_inotifyFd); }
+        if (_wakeFd >= 0) { close(_wakeFd); }
+        _inotifyFd = -1;
+        _wakeFd    = -1;
+        return;
+    }
+    // inotify is not recursive, only the directories handled by refreshDirectories are watched. this also keeps
+    // writes into the cache directory from waking up the watcher
+    for (const std::string* directory :
+         { &_meshesPath, &_scenesPath, &_shadersPath, &_texturesPath, &_riscvBinariesPath }) {
+        if (std::filesystem::is_directory(*directory)) { addInotifyWatchRecursively(*directory); }
+    }
+    _inotifyThread = std::thread(&XPFileWatchUnix::inotifyLoop, this);
+#endif
+
+    _stopRequested = false;
+    _reloadThread  = std::thread(&XPFileWatchUnix::reloadLoop, this);
+    _isRunning     = true;
 }
 
 void
 XPFileWatchUnix::stop()
 {
+    if (!_isRunning) { return; }
+    _isRunning = false;
+
+    // the monitor goes first so that nothing gets enqueued anymore, then the reload thread is drained. both threads
+    // are joined, shutdown never waits on a fixed amount of time
+#if defined(XP_PLATFORM_MACOS)
     if (FSW_OK != fsw_stop_monitor(_fswatch_handle)) { XP_LOG(XPLoggerSeverityError, "Error stopping monitor"); }
-    sleep(3);
-    if (FSW_OK != fsw_destroy_session(_fswatch_handle)) { XP_LOG(XPLoggerSeverityError, "Error destroying session"); }
     if (pthread_join(_fswatch_thread, nullptr)) { XP_LOG(XPLoggerSeverityError, "Error joining monitor thread"); }
+    if (FSW_OK != fsw_destroy_session(_fswatch_handle)) { XP_LOG(XPLoggerSeverityError, "Error destroying session"); }
+    _fswatch_handle = nullptr;
+#elif defined(XP_PLATFORM_LINUX)
+    const uint64_t wake = 1;
+    if (write(_wakeFd, &wake, sizeof(wake)) != sizeof(wake)) {
+        XP_LOG(XPLoggerSeverityError, "Error waking up the inotify thread");
+    }
+    if (_inotifyThread.joinable()) { _inotifyThread.join(); }
+    close(_inotifyFd);
+    close(_wakeFd);
+    _inotifyFd = -1;
+    _wakeFd    = -1;
+    _inotifyWatches.clear();
+#endif
+
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _stopRequested = true;
+        _pendingPaths.clear();
+    }
+    _pendingCondition.notify_all();
+    if (_reloadThread.joinable()) { _reloadThread.join(); }
 }
 
 XPDataPipelineStore&
@@ -237,8 +328,6 @@ XPFileWatchUnix::refreshDirectories(std::vector<std::string> directories)
 
     std::filesystem::path executableParentDirectory = XPFS::getExecutableDirectoryPath();
 
-    std::this_thread::sleep_for(std::chrono::seconds(1));
-
     XP_LOG(XPLoggerSeverityInfo, std::string(60, '=').c_str());
     XP_LOG(XPLoggerSeverityInfo, "CHANGED DIRECTORIES");
     XP_LOG(XPLoggerSeverityInfo, std::string(60, '=').c_str());
@@ -255,6 +344,8 @@ XPFileWatchUnix::refreshDirectories(std::vector<std::string> directories)
         XP_LOG(XPLoggerSeverityInfo, fmt::format("Directory ({}) changed.", directory).c_str());
         std::filesystem::path directory_path = std::filesystem::path(directory).make_preferred();
         if (!XPFS::isRelativeParentDirectory(directory_path, const_assets_dir)) { continue; }
+        // editors often rewrite files without changing them, those saves must not trigger a reload
+        if (!hasContentChanged(directory_path.string())) { continue; }
         if (XPFS::isRelativeParentDirectory(directory_path, const_mesh_dir) && XPFile::isMeshFile(directory_path)) {
             std::string meshFilename = directory_path.string().substr(const_mesh_dir.string().size());
             XP_LOG(XPLoggerSeverityInfo, fmt::format("MeshAsset <{}>", meshFilename).c_str());
@@ -263,9 +354,7 @@ XPFileWatchUnix::refreshDirectories(std::vector<std::string> directories)
                 auto optMeshAsset = _dataPipelineStore->getMeshAsset(optFile.value());
                 if (optMeshAsset.has_value()) {
                     auto meshAsset = optMeshAsset.value();
-                    if (XPFS::getTimestamp(meshAsset->getFile()->getPath()) != meshAsset->getFile()->getTimestamp()) {
-                        XPFile::onFileModified(meshAsset->getFile());
-                    }
+                    XPFile::onFileModified(meshAsset->getFile());
                 }
             } else {
                 _dataPipelineStore->createFile(directory_path, XPEFileResourceType::Scene);
@@ -279,9 +368,7 @@ XPFileWatchUnix::refreshDirectories(std::vector<std::string> directories)
                 auto optSceneAsset = _dataPipelineStore->getMeshAsset(optFile.value());
                 if (optSceneAsset.has_value()) {
                     auto sceneAsset = optSceneAsset.value();
-                    if (XPFS::getTimestamp(sceneAsset->getFile()->getPath()) != sceneAsset->getFile()->getTimestamp()) {
-                        XPFile::onFileModified(sceneAsset->getFile());
-                    }
+                    XPFile::onFileModified(sceneAsset->getFile());
                 }
             } else {
                 _dataPipelineStore->createFile(directory_path, XPEFileResourceType::Scene);
@@ -295,10 +382,7 @@ XPFileWatchUnix::refreshDirectories(std::vector<std::string> directories)
                 auto optShaderAsset = _dataPipelineStore->getShaderAsset(optFile.value());
                 if (optShaderAsset.has_value()) {
                     auto shaderAsset = optShaderAsset.value();
-                    if (XPFS::getTimestamp(shaderAsset->getFile()->getPath()) !=
-                        shaderAsset->getFile()->getTimestamp()) {
-                        XPFile::onFileModified(shaderAsset->getFile());
-                    }
+                    XPFile::onFileModified(shaderAsset->getFile());
                 }
             } else {
                 _dataPipelineStore->createFile(directory_path, XPEFileResourceType::Shader);
@@ -312,10 +396,7 @@ XPFileWatchUnix::refreshDirectories(std::vector<std::string> directories)
                 auto optTextureAsset = _dataPipelineStore->getTextureAsset(optFile.value());
                 if (optTextureAsset.has_value()) {
                     auto textureAsset = optTextureAsset.value();
-                    if (XPFS::getTimestamp(textureAsset->getFile()->getPath()) !=
-                        textureAsset->getFile()->getTimestamp()) {
-                        XPFile::onFileModified(textureAsset->getFile());
-                    }
+                    XPFile::onFileModified(textureAsset->getFile());
                 }
             } else {
                 _dataPipelineStore->createFile(directory_path, XPEFileResourceType::Texture);
@@ -329,10 +410,7 @@ XPFileWatchUnix::refreshDirectories(std::vector<std::string> directories)
                 auto optRiscvBinaryAsset = _dataPipelineStore->getRiscvBinaryAsset(optFile.value());
                 if (optRiscvBinaryAsset.has_value()) {
                     auto riscvBinaryAsset = optRiscvBinaryAsset.value();
-                    if (XPFS::getTimestamp(riscvBinaryAsset->getFile()->getPath()) !=
-                        riscvBinaryAsset->getFile()->getTimestamp()) {
-                        XPFile::onFileModified(riscvBinaryAsset->getFile());
-                    }
+                    XPFile::onFileModified(riscvBinaryAsset->getFile());
                 }
             } else {
                 _dataPipelineStore->createFile(directory_path.string(), XPEFileResourceType::RiscvBinary);
@@ -341,6 +419,148 @@ XPFileWatchUnix::refreshDirectories(std::vector<std::string> directories)
     }
 }
 
+void
+XPFileWatchUnix::enqueueChanges(const std::vector<std::string>& paths)
+{
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _pendingPaths.insert(paths.begin(), paths.end());
+        _lastEventTime = std::chrono::steady_clock::now();
+    }
+    _pendingCondition.notify_one();
+}
+
+void
+XPFileWatchUnix::reloadLoop()
+{
+    seedContentHashes();
+
+    std::unique_lock<std::mutex> lock(_pendingMutex);
+    while (true) {
+        _pendingCondition.wait(lock, [this]() { return _stopRequested || !_pendingPaths.empty(); });
+        if (_stopRequested) { break; }
+
+        int debounceMs = XPFileWatchDefaultDebounceMs;
+        if (XPEngine* engine = _registry->getEngine(); engine && engine->getConsole()) {
+            auto optVariable = engine->getConsole()->getVariable("fw.debounceMs");
+            if (optVariable.has_value()) {
+                if (auto variable = std::dynamic_pointer_cast<XPConsoleVar<int>>(optVariable.value())) {
+                    debounceMs = std::max(0, variable->getValue());
+                }
+            }
+        }
+
+        // every new event restarts the window, a save that goes through several writes and renames becomes one batch
+        while (!_stopRequested) {
+            const auto deadline = _lastEventTime + std::chrono::milliseconds(debounceMs);
+            if (std::chrono::steady_clock::now() >= deadline) { break; }
+            _pendingCondition.wait_until(lock, deadline);
+        }
+        if (_stopRequested) { break; }
+
+        std::vector<std::string> batch(_pendingPaths.begin(), _pendingPaths.end());
+        _pendingPaths.clear();
+        lock.unlock();
+        refreshDirectories(std::move(batch));
+        lock.lock();
+    }
+}
+
+void
+XPFileWatchUnix::seedContentHashes()
+{
+    // baseline for the content comparison, without it the first save of every file would count as a change
+    for (const std::string* directory :
+         { &_meshesPath, &_scenesPath, &_shadersPath, &_texturesPath, &_riscvBinariesPath }) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(*directory, ec)) { continue; }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(*directory, ec)) {
+            if (!entry.is_regular_file(ec)) { continue; }
+            const std::string path = entry.path().string();
+            uint64_t          hash = 0;
+            if (computeContentHash(path, hash)) { _contentHashes[path] = hash; }
+        }
+    }
+}
+
+bool
+XPFileWatchUnix::hasContentChanged(const std::string& path)
+{
+    uint64_t hash = 0;
+    if (!computeContentHash(path, hash)) {
+        // removed or unreadable, let the asset handling decide what to do with it
+        _contentHashes.erase(path);
+        return true;
+    }
+    auto it = _contentHashes.find(path);
+    if (it != _contentHashes.end() && it->second == hash) { return false; }
+    _contentHashes[path] = hash;
+    return true;
+}
+
+#if defined(XP_PLATFORM_LINUX)
+void
+XPFileWatchUnix::addInotifyWatchRecursively(const std::string& directory)
+{
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_ONLYDIR;
+    const int      wd   = inotify_add_watch(_inotifyFd, directory.c_str(), mask);
+    if (wd < 0) {
+        XP_LOGV(XPLoggerSeverityWarning, "Failed to watch directory %s", directory.c_str());
+        return;
+    }
+    _inotifyWatches[wd] = directory;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_directory(ec) && !entry.is_symlink(ec)) { addInotifyWatchRecursively(entry.path().string()); }
+    }
+}
+
+void
+XPFileWatchUnix::inotifyLoop()
+{
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    pollfd                             fds[2] = { { _inotifyFd, POLLIN, 0 }, { _wakeFd, POLLIN, 0 } };
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) { continue; }
+            XP_LOG(XPLoggerSeverityError, "Failed to poll inotify events");
+            return;
+        }
+        // stop() signals the event fd
+        if (fds[1].revents & POLLIN) { return; }
+        if ((fds[0].revents & POLLIN) == 0) { continue; }
+
+        std::vector<std::string> paths;
+        ssize_t                  length = 0;
+        while ((length = read(_inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                const auto* event = reinterpret_cast<const struct inotify_event*>(ptr);
+                ptr += sizeof(struct inotify_event) + event->len;
+                if (event->mask & IN_Q_OVERFLOW) {
+                    XP_LOG(XPLoggerSeverityWarning, "inotify queue overflowed, some changes were dropped");
+                    continue;
+                }
+                if (event->mask & IN_IGNORED) {
+                    _inotifyWatches.erase(event->wd);
+                    continue;
+                }
+                auto it = _inotifyWatches.find(event->wd);
+                if (it == _inotifyWatches.end() || event->len == 0) { continue; }
+                std::string path = (std::filesystem::path(it->second) / event->name).string();
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) { addInotifyWatchRecursively(path); }
+                    continue;
+                }
+                paths.push_back(std::move(path));
+            }
+        }
+        if (!paths.empty()) { enqueueChanges(paths); }
+    }
+}
+#endif
+
+#if defined(XP_PLATFORM_MACOS)
 void*
 XPFileWatchUnix::fswatch_start_monitoring(void* param)
 {
@@ -356,80 +576,16 @@ XPFileWatchUnix::fswatch_start_monitoring(void* param)
 void
 XPFileWatchUnix::fswatch_callback(fsw_cevent const* const events, const unsigned int event_num, void* data)
 {
-    // let's lock the next scope to prevent crashes when files are continuously being changed for any reason
-    static std::mutex WATCH_LOCK_MUTEX;
-    {
-        // lock scope and do your processing safely
-        std::lock_guard<std::mutex> SCOPED_LOCK(WATCH_LOCK_MUTEX);
-
-        auto fileWatchUnix = static_cast<XPFileWatchUnix*>(data);
-        for (unsigned int i = 0; i < event_num; ++i) {
-            auto path = std::string(events[i].path);
-            fileWatchUnix->_directories.insert(path);
-            std::stringstream ss;
-            for (unsigned int iflag = 0; iflag < events[i].flags_num; ++iflag) {
-                ss << events[i].flags[iflag] << " ";
-                switch (events[i].flags[iflag]) {
-                    case NoOp: {
-                        // puts(fmt::format("{} No event has occurred : {}", events[i].evt_time, path).c_str());
-                    } break;
-                    case PlatformSpecific: {
-                        // puts(fmt::format("{} Platform-specific placeholder for event type that cannot currently be
-                        // mapped : {}", events[i].evt_time, path).c_str());
-                    } break;
-                    case Created: {
-                        // puts(fmt::format("{} An object was created : {}", events[i].evt_time, path).c_str());
-                    } break;
-                    case Updated: {
-                        // puts(fmt::format("{} An object was updated : {}", events[i].evt_time, path).c_str());
-                    } break;
-                    case Removed: {
-                        // puts(fmt::format("{} An object was removed : {}", events[i].evt_time, path).c_str());
-                    } break;
-                    case Renamed: {
-                        // auto toPath = events[++i].path;
-                        // puts(fmt::format("{} An object was renamed : from {} to {}", events[i].evt_time, path,
-                        // toPath).c_str());
-                    } break;
-                    case OwnerModified: {
-                        // puts(fmt::format("{} The owner of an object was modified : {}", events[i].evt_time,
-                        // path).c_str());
-                    } break;
-                    case AttributeModified: {
-                        // puts(fmt::format("{} The attributes of an object were modified : {}", events[i].evt_time,
-                        // path).c_str());
-                    } break;
-                    case MovedFrom: {
-                        // puts(fmt::format("{} An object was moved from this location : {}", events[i].evt_time,
-                        // path).c_str());
-                    } break;
-                    case MovedTo: {
-                        // puts(fmt::format("{} An object was moved to this location : {}", events[i].evt_time,
-                        // path).c_str());
-                    } break;
-                    case IsFile: {
-                        // puts(fmt::format("{} The object is a file : {}", events[i].evt_time, path).c_str());
-                    } break;
-                    case IsDir: {
-                        // puts(fmt::format("{} The object is a directory : {}", events[i].evt_time, path).c_str());
-                    } break;
-                    case IsSymLink: {
-                        // puts(fmt::format("{} The object is a symbolic link : {}", events[i].evt_time, path).c_str());
-                    } break;
-                    case Link: {
-                        // puts(fmt::format("{} The link count of an object has changed : {}", events[i].evt_time,
-                        // path).c_str());
-                    } break;
-                    case Overflow: {
-                        // puts(fmt::format("{} The event queue has overflowed : {}", events[i].evt_time,
-                        // path).c_str());
-                    } break;
-                }
-            }
-            puts(fmt::format("fswatch_callback: [{}] <{}>\n\n", ss.str().c_str(), events[i].path).c_str());
-        }
-        fileWatchUnix->refreshDirectories(
-          std::vector<std::string>(fileWatchUnix->_directories.begin(), fileWatchUnix->_directories.end()));
-        fileWatchUnix->_directories.clear();
+    auto                     fileWatchUnix = static_cast<XPFileWatchUnix*>(data);
+    std::vector<std::string> paths;
+    paths.reserve(event_num);
+    for (unsigned int i = 0; i < event_num; ++i) {
+        auto path = std::string(events[i].path);
+        paths.push_back(path);
+        std::stringstream ss;
+        for (unsigned int iflag = 0; iflag < events[i].flags_num; ++iflag) { ss << events[i].flags[iflag] << " "; }
+        puts(fmt::format("fswatch_callback: [{}] <{}>\n\n", ss.str().c_str(), events[i].path).c_str());
     }
+    fileWatchUnix->enqueueChanges(paths);
 }
+#endif
@@ -16,16 +16,25 @@
 
 #include <DataPipeline/XPIFileWatch.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
-#ifdef __clang__
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wall"
-    #pragma clang diagnostic ignored "-Weverything"
-#endif
-#include <libfswatch/c/libfswatch.h>
-#ifdef __clang__
-    #pragma clang diagnostic pop
+#if defined(XP_PLATFORM_MACOS)
+    #ifdef __clang__
+        #pragma clang diagnostic push
+        #pragma clang diagnostic ignored "-Wall"
+        #pragma clang diagnostic ignored "-Weverything"
+    #endif
+    #include <libfswatch/c/libfswatch.h>
+    #ifdef __clang__
+        #pragma clang diagnostic pop
+    #endif
 #endif
 
 class XPFileWatchUnix final : public XPIFileWatch
@@ -54,9 +63,20 @@ class XPFileWatchUnix final : public XPIFileWatch
     const std::string&   getRiscvBinariesPath() const final;
 
   private:
+#if defined(XP_PLATFORM_MACOS)
     static void* fswatch_start_monitoring(void* param);
     static void  fswatch_callback(fsw_cevent const* const events, const unsigned int event_num, void* data);
-    void         refreshDirectories(std::vector<std::string> directories);
+#elif defined(XP_PLATFORM_LINUX)
+    void addInotifyWatchRecursively(const std::string& directory);
+    void inotifyLoop();
+#endif
+    // collects raw events from the platform monitor, they are coalesced and handled later by the reload thread
+    void enqueueChanges(const std::vector<std::string>& paths);
+    // waits until no event arrived for a whole debounce window then hands the collected paths over as one batch
+    void reloadLoop();
+    void seedContentHashes();
+    bool hasContentChanged(const std::string& path);
+    void refreshDirectories(std::vector<std::string> directories);
 
     XPRegistry*                     _registry;
     XPDataPipelineStore*            _dataPipelineStore;
@@ -68,7 +88,21 @@ class XPFileWatchUnix final : public XPIFileWatch
     std::string                     _prototypesPath;
     std::string                     _pluginsPath;
     std::string                     _riscvBinariesPath;
-    FSW_HANDLE                      _fswatch_handle;
-    pthread_t                       _fswatch_thread;
-    std::unordered_set<std::string> _directories;
+#if defined(XP_PLATFORM_MACOS)
+    FSW_HANDLE _fswatch_handle;
+    pthread_t  _fswatch_thread;
+#elif defined(XP_PLATFORM_LINUX)
+    int                                  _inotifyFd;
+    int                                  _wakeFd;
+    std::unordered_map<int, std::string> _inotifyWatches;
+    std::thread                          _inotifyThread;
+#endif
+    bool                                      _isRunning;
+    std::thread                               _reloadThread;
+    std::mutex                                _pendingMutex;
+    std::condition_variable                   _pendingCondition;
+    std::unordered_set<std::string>           _pendingPaths;
+    std::chrono::steady_clock::time_point     _lastEventTime;
+    bool                                      _stopRequested;
+    std::unordered_map<std::string, uint64_t> _contentHashes;
 };
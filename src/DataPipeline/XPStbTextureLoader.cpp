@@ -17,6 +17,7 @@
 #include <DataPipeline/XPStbTextureLoader.h>
 #include <DataPipeline/XPTextureAsset.h>
 #include <DataPipeline/XPTextureBuffer.h>
+#include <DataPipeline/XPTextureCooker.h>
 #include <Utilities/XPLogger.h>
 
 #ifdef __clang__
@@ -34,30 +35,25 @@
 void
 XPStbTextureLoader::load(XPTextureAsset* textureAsset, XPDataPipelineStore& dataPipelineStore)
 {
-    int            width, height, channels;
-    unsigned char* textureData = stbi_load(textureAsset->getFile()->getPath().c_str(), &width, &height, &channels, 0);
-    if (!textureData) {
-        XP_LOGV(XPLoggerSeverityWarning, "Texture file not found %s", textureAsset->getFile()->getPath().c_str());
+    const XPTextureCookSettings cookSettings = {};
+    if (XPTextureCooker::loadCached(textureAsset, cookSettings)) { return; }
+
+    const std::string& path = textureAsset->getFile()->getPath();
+
+    // only parse the header first, rgb images are expanded to rgba by the decoder so that they are decoded once
+    int width, height, channels;
+    if (!stbi_info(path.c_str(), &width, &height, &channels)) {
+        XP_LOGV(XPLoggerSeverityWarning, "Texture file not found %s", path.c_str());
         return;
     }
-
-    if (channels == 3) {
-        stbi_image_free(textureData);
-        textureData = stbi_load(textureAsset->getFile()->getPath().c_str(), &width, &height, &channels, STBI_rgb_alpha);
-        if (!textureData) {
-            XP_LOGV(XPLoggerSeverityWarning,
-                    "Failed to load rgb texture as rgba %s",
-                    textureAsset->getFile()->getPath().c_str());
-            return;
-        }
-        channels = 4;
+    const int      desiredChannels = channels == 3 ? STBI_rgb_alpha : 0;
+    unsigned char* textureData     = stbi_load(path.c_str(), &width, &height, &channels, desiredChannels);
+    if (!textureData) {
+        XP_LOGV(XPLoggerSeverityWarning, "Failed to decode texture %s", path.c_str());
+        return;
     }
+    if (desiredChannels != 0) { channels = desiredChannels; }
 
-    XPTextureBuffer* textureBuffer = textureAsset->getTextureBuffer();
-    textureBuffer->setFormat(
-      (channels == 1 ? XPETextureBufferFormat::R8
-                     : (channels == 2 ? XPETextureBufferFormat::R8_G8 : XPETextureBufferFormat::R8_G8_B8_A8)));
-    textureBuffer->setDimensions(XPVec2<uint32_t>(width, height));
-    textureBuffer->setPixels(std::vector<uint8_t>(textureData, textureData + (width * height * channels)));
+    XPTextureCooker::cook(textureAsset, textureData, width, height, channels, cookSettings);
     stbi_image_free(textureData);
 }
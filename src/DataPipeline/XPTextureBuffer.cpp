@@ -14,6 +14,7 @@
 
 #include <DataPipeline/XPFile.h>
 #include <DataPipeline/XPTextureBuffer.h>
+#include <Utilities/XPMappedFile.h>
 
 XPTextureBuffer::XPTextureBuffer(XPTextureAsset* const textureAsset, uint32_t id)
   : _textureAsset(textureAsset)
@@ -35,10 +36,11 @@ XPTextureBuffer::getId() const
     return _id;
 }
 
-const std::vector<unsigned char>&
+std::span<const uint8_t>
 XPTextureBuffer::getPixels() const
 {
-    return _pixels;
+    if (_mapping) { return _mappedPixels; }
+    return std::span<const uint8_t>(_pixels.data(), _pixels.size());
 }
 
 const XPVec2<uint32_t>&
@@ -53,10 +55,63 @@ XPTextureBuffer::getFormat() const
     return _format;
 }
 
+uint32_t
+XPTextureBuffer::getMipLevelCount() const
+{
+    return static_cast<uint32_t>(_mipLevels.size());
+}
+
+const std::vector<XPTextureBufferMipLevel>&
+XPTextureBuffer::getMipLevels() const
+{
+    return _mipLevels;
+}
+
+std::span<const uint8_t>
+XPTextureBuffer::getMipPixels(uint32_t level) const
+{
+    if (level >= _mipLevels.size()) { return {}; }
+    const XPTextureBufferMipLevel& mip = _mipLevels[level];
+    return getPixels().subspan(mip.offset, mip.size);
+}
+
+bool
+XPTextureBuffer::isBlockCompressed() const
+{
+    return isBlockCompressedFormat(_format);
+}
+
 void
 XPTextureBuffer::setPixels(std::vector<unsigned char>&& pixels)
 {
-    _pixels = pixels;
+    _mapping.reset();
+    _mappedPixels = {};
+    _pixels       = std::move(pixels);
+    _mipLevels.clear();
+    _mipLevels.push_back({ _dimensions, 0, _pixels.size() });
+}
+
+void
+XPTextureBuffer::setMipChain(std::vector<unsigned char>&& pixels, std::vector<XPTextureBufferMipLevel>&& levels)
+{
+    _mapping.reset();
+    _mappedPixels = {};
+    _pixels       = std::move(pixels);
+    _mipLevels    = std::move(levels);
+    if (!_mipLevels.empty()) { _dimensions = _mipLevels[0].dimensions; }
+}
+
+void
+XPTextureBuffer::setMappedMipChain(std::shared_ptr<const XPMappedFile> mapping,
+                                   std::span<const uint8_t>            pixels,
+                                   std::vector<XPTextureBufferMipLevel>&& levels)
+{
+    _pixels.clear();
+    _pixels.shrink_to_fit();
+    _mapping      = std::move(mapping);
+    _mappedPixels = pixels;
+    _mipLevels    = std::move(levels);
+    if (!_mipLevels.empty()) { _dimensions = _mipLevels[0].dimensions; }
 }
 
 void
@@ -70,3 +125,57 @@ XPTextureBuffer::setFormat(XPETextureBufferFormat format)
 {
     _format = format;
 }
+
+bool
+XPTextureBuffer::isBlockCompressedFormat(XPETextureBufferFormat format)
+{
+    switch (format) {
+        case XPETextureBufferFormat::BC1_RGBA:
+        case XPETextureBufferFormat::BC3_RGBA:
+        case XPETextureBufferFormat::BC5_RG:
+        case XPETextureBufferFormat::BC7_RGBA: return true;
+        default: return false;
+    }
+}
+
+uint32_t
+XPTextureBuffer::getFormatElementSize(XPETextureBufferFormat format)
+{
+    switch (format) {
+        case XPETextureBufferFormat::R8: return 1;
+        case XPETextureBufferFormat::R8_G8: return 2;
+        case XPETextureBufferFormat::R8_G8_B8: return 3;
+        case XPETextureBufferFormat::R8_G8_B8_A8: return 4;
+        case XPETextureBufferFormat::R16: return 2;
+        case XPETextureBufferFormat::R16_G16: return 4;
+        case XPETextureBufferFormat::R16_G16_B16: return 6;
+        case XPETextureBufferFormat::R16_G16_B16_A16: return 8;
+        case XPETextureBufferFormat::R32: return 4;
+        case XPETextureBufferFormat::R32_G32: return 8;
+        case XPETextureBufferFormat::R32_G32_B32: return 12;
+        case XPETextureBufferFormat::R32_G32_B32_A32: return 16;
+        case XPETextureBufferFormat::BC1_RGBA: return 8;
+        case XPETextureBufferFormat::BC3_RGBA: return 16;
+        case XPETextureBufferFormat::BC5_RG: return 16;
+        case XPETextureBufferFormat::BC7_RGBA: return 16;
+    }
+    return 0;
+}
+
+size_t
+XPTextureBuffer::getMipLevelByteSize(XPETextureBufferFormat format, XPVec2<uint32_t> dimensions)
+{
+    if (isBlockCompressedFormat(format)) {
+        return getMipLevelRowPitch(format, dimensions.x) * static_cast<size_t>((dimensions.y + 3) / 4);
+    }
+    return getMipLevelRowPitch(format, dimensions.x) * static_cast<size_t>(dimensions.y);
+}
+
+size_t
+XPTextureBuffer::getMipLevelRowPitch(XPETextureBufferFormat format, uint32_t width)
+{
+    if (isBlockCompressedFormat(format)) {
+        return static_cast<size_t>((width + 3) / 4) * getFormatElementSize(format);
+    }
+    return static_cast<size_t>(width) * getFormatElementSize(format);
+}
@@ -19,11 +19,14 @@
 #include <Utilities/XPMaths.h>
 #include <Utilities/XPMemoryPool.h>
 
+#include <memory>
+#include <span>
 #include <stdint.h>
 #include <string>
 #include <vector>
 
 class XPTextureAsset;
+class XPMappedFile;
 
 enum class XPETextureBufferFormat
 {
@@ -41,6 +44,20 @@ enum class XPETextureBufferFormat
     R32_G32,
     R32_G32_B32,
     R32_G32_B32_A32,
+
+    // 4x4 block compressed formats
+    BC1_RGBA,
+    BC3_RGBA,
+    BC5_RG,
+    BC7_RGBA,
+};
+
+/// @brief Location of a single mip level inside the texture buffer pixels, level 0 always starts at offset 0
+struct XPTextureBufferMipLevel
+{
+    XPVec2<uint32_t> dimensions;
+    size_t           offset;
+    size_t           size;
 };
 
 class XPTextureBuffer
@@ -51,19 +68,41 @@ class XPTextureBuffer
     explicit XPTextureBuffer(XPTextureAsset* const textureAsset, uint32_t id);
     ~XPTextureBuffer();
 
-    [[nodiscard]] XPTextureAsset*                   getTextureAsset() const;
-    [[nodiscard]] uint32_t                          getId() const;
-    [[nodiscard]] const std::vector<unsigned char>& getPixels() const;
-    [[nodiscard]] const XPVec2<uint32_t>&           getDimensions() const;
-    [[nodiscard]] XPETextureBufferFormat            getFormat() const;
-    void                                            setPixels(std::vector<unsigned char>&& pixels);
-    void                                            setDimensions(XPVec2<uint32_t> dimensions);
-    void                                            setFormat(XPETextureBufferFormat format);
+    [[nodiscard]] XPTextureAsset*                             getTextureAsset() const;
+    [[nodiscard]] uint32_t                                    getId() const;
+    [[nodiscard]] std::span<const uint8_t>                    getPixels() const;
+    [[nodiscard]] const XPVec2<uint32_t>&                     getDimensions() const;
+    [[nodiscard]] XPETextureBufferFormat                      getFormat() const;
+    [[nodiscard]] uint32_t                                    getMipLevelCount() const;
+    [[nodiscard]] const std::vector<XPTextureBufferMipLevel>& getMipLevels() const;
+    [[nodiscard]] std::span<const uint8_t>                    getMipPixels(uint32_t level) const;
+    [[nodiscard]] bool                                        isBlockCompressed() const;
+    /// @brief replaces the pixels with a single mip level, dimensions and format must be set beforehand
+    void                                                      setPixels(std::vector<unsigned char>&& pixels);
+    /// @brief replaces the pixels with a full mip chain laid out back to back as described by levels
+    void setMipChain(std::vector<unsigned char>&& pixels, std::vector<XPTextureBufferMipLevel>&& levels);
+    /// @brief points the pixels at a mapped cooked container instead of owning a copy, the mapping is kept alive
+    /// for as long as the buffer references it
+    void setMappedMipChain(std::shared_ptr<const XPMappedFile> mapping,
+                           std::span<const uint8_t>            pixels,
+                           std::vector<XPTextureBufferMipLevel>&& levels);
+    void setDimensions(XPVec2<uint32_t> dimensions);
+    void setFormat(XPETextureBufferFormat format);
+
+    [[nodiscard]] static bool     isBlockCompressedFormat(XPETextureBufferFormat format);
+    /// @brief bytes per pixel for linear formats, bytes per 4x4 block for block compressed formats
+    [[nodiscard]] static uint32_t getFormatElementSize(XPETextureBufferFormat format);
+    [[nodiscard]] static size_t   getMipLevelByteSize(XPETextureBufferFormat format, XPVec2<uint32_t> dimensions);
+    /// @brief bytes between two rows of pixels, or two rows of blocks for block compressed formats
+    [[nodiscard]] static size_t   getMipLevelRowPitch(XPETextureBufferFormat format, uint32_t width);
 
   private:
-    XPTextureAsset* const      _textureAsset;
-    const uint32_t             _id;
-    std::vector<unsigned char> _pixels;
-    XPVec2<uint32_t>           _dimensions;
-    XPETextureBufferFormat     _format;
+    XPTextureAsset* const                _textureAsset;
+    const uint32_t                       _id;
+    std::vector<unsigned char>           _pixels;
+    std::shared_ptr<const XPMappedFile>  _mapping;
+    std::span<const uint8_t>             _mappedPixels;
+    std::vector<XPTextureBufferMipLevel> _mipLevels;
+    XPVec2<uint32_t>                     _dimensions;
+    XPETextureBufferFormat               _format;
 };
@@ -0,0 +1,726 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <DataPipeline/XPFile.h>
+#include <DataPipeline/XPTextureAsset.h>
+#include <DataPipeline/XPTextureBuffer.h>
+#include <DataPipeline/XPTextureCooker.h>
+#include <Utilities/XPFS.h>
+#include <Utilities/XPHash.h>
+#include <Utilities/XPLogger.h>
+#include <Utilities/XPMappedFile.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wall"
+    #pragma clang diagnostic ignored "-Weverything"
+#endif
+#define FMT_HEADER_ONLY
+#include <fmt/format.h>
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
+
+// bump whenever the container layout or the cooking output changes so that stale caches get rebuilt
+static constexpr uint32_t XPTextureCookedVersion = 1;
+static constexpr char     XPTextureCookedMagic[4] = { 'X', 'P', 'T', 'X' };
+static constexpr size_t   XPTextureCookedAlignment = 16;
+
+struct XPTextureCookedHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint64_t sourceKey;
+    uint32_t format;
+    uint32_t mipLevelCount;
+    uint64_t payloadOffset;
+    uint64_t payloadSize;
+};
+
+struct XPTextureCookedMipLevel
+{
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;
+    uint64_t size;
+};
+
+static size_t
+alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static uint64_t
+computeSourceKey(XPTextureAsset* textureAsset, const XPTextureCookSettings& settings)
+{
+    const std::string& path = textureAsset->getFile()->getPath();
+    std::error_code    ec;
+    const uint64_t     fileSize  = static_cast<uint64_t>(std::filesystem::file_size(path, ec));
+    const int64_t      timestamp = static_cast<int64_t>(XPFS::getTimestamp(path));
+
+    uint64_t key = XPHash::xxh64(path);
+    key          = XPHash::combine(key, ec ? 0ULL : fileSize);
+    key          = XPHash::combine(key, timestamp);
+    key          = XPHash::combine(key, XPTextureCookedVersion);
+    key          = XPHash::combine(key, static_cast<uint32_t>(settings.generateMips));
+    key          = XPHash::combine(key, static_cast<uint32_t>(settings.mipFilter));
+    key          = XPHash::combine(key, static_cast<uint32_t>(settings.compression));
+    return key;
+}
+
+static std::string
+buildContainerPath(uint64_t sourceKey)
+{
+    return XPFS::buildCachePath(fmt::format("textures/{:016x}.xptex", sourceKey));
+}
+
+static void
+parallelRange(uint32_t                                        count,
+              uint32_t                                        minPerThread,
+              uint32_t                                        maxThreads,
+              const std::function<void(uint32_t, uint32_t)>& fn)
+{
+    const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const uint32_t allowedThreads  = maxThreads == 0 ? hardwareThreads : std::min(maxThreads, hardwareThreads);
+    const uint32_t numThreads      = std::min(allowedThreads, std::max(1u, count / std::max(1u, minPerThread)));
+    if (numThreads <= 1) {
+        fn(0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    const uint32_t chunk = (count + numThreads - 1) / numThreads;
+    for (uint32_t t = 1; t < numThreads; ++t) {
+        const uint32_t begin = std::min(count, t * chunk);
+        const uint32_t end   = std::min(count, begin + chunk);
+        if (begin < end) { threads.emplace_back(fn, begin, end); }
+    }
+    // the calling thread takes the first chunk instead of idling
+    fn(0, std::min(count, chunk));
+    for (auto& thread : threads) { thread.join(); }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// MIP CHAIN
+// ---------------------------------------------------------------------------------------------------------------------
+static void
+downsampleBox(const uint8_t* src,
+              uint32_t       srcWidth,
+              uint32_t       srcHeight,
+              uint8_t*       dst,
+              uint32_t       dstWidth,
+              uint32_t       dstHeight,
+              uint32_t       channels,
+              uint32_t       maxThreads)
+{
+    parallelRange(dstHeight, 16, maxThreads, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+            const uint32_t y0 = std::min(y * 2, srcHeight - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, srcHeight - 1);
+            for (uint32_t x = 0; x < dstWidth; ++x) {
+                const uint32_t x0 = std::min(x * 2, srcWidth - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+                const uint8_t* p00 = src + (static_cast<size_t>(y0) * srcWidth + x0) * channels;
+                const uint8_t* p01 = src + (static_cast<size_t>(y0) * srcWidth + x1) * channels;
+                const uint8_t* p10 = src + (static_cast<size_t>(y1) * srcWidth + x0) * channels;
+                const uint8_t* p11 = src + (static_cast<size_t>(y1) * srcWidth + x1) * channels;
+                uint8_t*       out = dst + (static_cast<size_t>(y) * dstWidth + x) * channels;
+                for (uint32_t c = 0; c < channels; ++c) {
+                    out[c] = static_cast<uint8_t>((p00[c] + p01[c] + p10[c] + p11[c] + 2) >> 2);
+                }
+            }
+        }
+    });
+}
+
+static double
+besselI0(double x)
+{
+    double sum  = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) { break; }
+    }
+    return sum;
+}
+
+struct XPKaiserTap
+{
+    uint32_t index;
+    float    weight;
+};
+
+// kaiser windowed sinc sampled in source space, one tap list per destination texel
+static std::vector<std::vector<XPKaiserTap>>
+buildKaiserTaps(uint32_t srcSize, uint32_t dstSize)
+{
+    constexpr double radius = 3.0;
+    constexpr double alpha  = 4.0;
+    constexpr double pi     = 3.14159265358979323846;
+    const double     scale  = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+    const double     norm   = besselI0(alpha);
+
+    std::vector<std::vector<XPKaiserTap>> taps(dstSize);
+    for (uint32_t i = 0; i < dstSize; ++i) {
+        const double center = (i + 0.5) * scale;
+        const int    first  = static_cast<int>(std::floor(center - radius * scale));
+        const int    last   = static_cast<int>(std::ceil(center + radius * scale));
+        double       total  = 0.0;
+        for (int s = first; s <= last; ++s) {
+            const double d = ((s + 0.5) - center) / scale;
+            if (std::abs(d) > radius) { continue; }
+            const double sinc   = d == 0.0 ? 1.0 : std::sin(pi * d) / (pi * d);
+            const double r      = d / radius;
+            const double window = besselI0(alpha * std::sqrt(std::max(0.0, 1.0 - r * r))) / norm;
+            const double weight = sinc * window;
+            const int    index  = std::clamp(s, 0, static_cast<int>(srcSize) - 1);
+            taps[i].push_back({ static_cast<uint32_t>(index), static_cast<float>(weight) });
+            total += weight;
+        }
+        for (auto& tap : taps[i]) { tap.weight = static_cast<float>(tap.weight / total); }
+    }
+    return taps;
+}
+
+static void
+downsampleKaiser(const uint8_t* src,
+                 uint32_t       srcWidth,
+                 uint32_t       srcHeight,
+                 uint8_t*       dst,
+                 uint32_t       dstWidth,
+                 uint32_t       dstHeight,
+                 uint32_t       channels,
+                 uint32_t       maxThreads)
+{
+    const auto horizontalTaps = buildKaiserTaps(srcWidth, dstWidth);
+    const auto verticalTaps   = buildKaiserTaps(srcHeight, dstHeight);
+
+    // horizontal pass into a float intermediate of srcHeight rows x dstWidth texels
+    std::vector<float> intermediate(static_cast<size_t>(srcHeight) * dstWidth * channels);
+    parallelRange(srcHeight, 16, maxThreads, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+            const uint8_t* srcRow = src + static_cast<size_t>(y) * srcWidth * channels;
+            float*         outRow = intermediate.data() + static_cast<size_t>(y) * dstWidth * channels;
+            for (uint32_t x = 0; x < dstWidth; ++x) {
+                for (uint32_t c = 0; c < channels; ++c) {
+                    float acc = 0.0f;
+                    for (const auto& tap : horizontalTaps[x]) { acc += tap.weight * srcRow[tap.index * channels + c]; }
+                    outRow[x * channels + c] = acc;
+                }
+            }
+        }
+    });
+
+    parallelRange(dstHeight, 16, maxThreads, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+            uint8_t* outRow = dst + static_cast<size_t>(y) * dstWidth * channels;
+            for (uint32_t x = 0; x < dstWidth; ++x) {
+                for (uint32_t c = 0; c < channels; ++c) {
+                    float acc = 0.0f;
+                    for (const auto& tap : verticalTaps[y]) {
+                        const size_t index = (static_cast<size_t>(tap.index) * dstWidth + x) * channels + c;
+                        acc += tap.weight * intermediate[index];
+                    }
+                    outRow[x * channels + c] = static_cast<uint8_t>(std::clamp(acc + 0.5f, 0.0f, 255.0f));
+                }
+            }
+        }
+    });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// BLOCK COMPRESSION
+// ---------------------------------------------------------------------------------------------------------------------
+static void
+fetchBlock(const uint8_t* pixels,
+           uint32_t       width,
+           uint32_t       height,
+           uint32_t       channels,
+           uint32_t       bx,
+           uint32_t       by,
+           uint8_t        block[16][4])
+{
+    for (uint32_t j = 0; j < 4; ++j) {
+        const uint32_t y = std::min(by * 4 + j, height - 1);
+        for (uint32_t i = 0; i < 4; ++i) {
+            const uint32_t x  = std::min(bx * 4 + i, width - 1);
+            const uint8_t* p  = pixels + (static_cast<size_t>(y) * width + x) * channels;
+            uint8_t*       to = block[j * 4 + i];
+            to[0]             = p[0];
+            to[1]             = channels > 1 ? p[1] : 0;
+            to[2]             = channels > 2 ? p[2] : 0;
+            to[3]             = channels > 3 ? p[3] : 255;
+        }
+    }
+}
+
+static uint16_t
+packRGB565(const int color[3])
+{
+    const int r = (color[0] * 31 + 127) / 255;
+    const int g = (color[1] * 63 + 127) / 255;
+    const int b = (color[2] * 31 + 127) / 255;
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void
+unpackRGB565(uint16_t packed, int color[3])
+{
+    const int r = (packed >> 11) & 31;
+    const int g = (packed >> 5) & 63;
+    const int b = packed & 31;
+    color[0]    = (r << 3) | (r >> 2);
+    color[1]    = (g << 2) | (g >> 4);
+    color[2]    = (b << 3) | (b >> 2);
+}
+
+static void
+encodeColorBlock(const uint8_t block[16][4], uint8_t* out)
+{
+    int minColor[3] = { 255, 255, 255 };
+    int maxColor[3] = { 0, 0, 0 };
+    int mean[3]     = { 0, 0, 0 };
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            minColor[c] = std::min(minColor[c], static_cast<int>(block[i][c]));
+            maxColor[c] = std::max(maxColor[c], static_cast<int>(block[i][c]));
+            mean[c] += block[i][c];
+        }
+    }
+    for (int c = 0; c < 3; ++c) { mean[c] = (mean[c] + 8) / 16; }
+
+    // pick the bounding box diagonal that follows the color distribution, using green as the reference axis
+    int covarianceRG = 0, covarianceBG = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int dg = block[i][1] - mean[1];
+        covarianceRG += (block[i][0] - mean[0]) * dg;
+        covarianceBG += (block[i][2] - mean[2]) * dg;
+    }
+    if (covarianceRG < 0) { std::swap(minColor[0], maxColor[0]); }
+    if (covarianceBG < 0) { std::swap(minColor[2], maxColor[2]); }
+
+    // inset the endpoints to reduce the error of the extreme colors
+    for (int c = 0; c < 3; ++c) {
+        const int inset = (maxColor[c] - minColor[c]) / 16;
+        maxColor[c]     = std::clamp(maxColor[c] - inset, 0, 255);
+        minColor[c]     = std::clamp(minColor[c] + inset, 0, 255);
+    }
+
+    uint16_t c0 = packRGB565(maxColor);
+    uint16_t c1 = packRGB565(minColor);
+    if (c0 < c1) { std::swap(c0, c1); }
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        int palette[4][3];
+        unpackRGB565(c0, palette[0]);
+        unpackRGB565(c1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int bestIndex = 0, bestError = INT32_MAX;
+            for (int p = 0; p < 4; ++p) {
+                int error = 0;
+                for (int c = 0; c < 3; ++c) {
+                    const int d = block[i][c] - palette[p][c];
+                    error += d * d;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(bestIndex) << (i * 2);
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(c0 & 0xff);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1 & 0xff);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    memcpy(out + 4, &indices, sizeof(indices));
+}
+
+static void
+encodeSingleChannelBlock(const uint8_t block[16][4], uint32_t channel, uint8_t* out)
+{
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max(a0, static_cast<int>(block[i][channel]));
+        a1 = std::min(a1, static_cast<int>(block[i][channel]));
+    }
+
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        int palette[8] = { a0, a1 };
+        for (int p = 2; p < 8; ++p) { palette[p] = ((8 - p) * a0 + (p - 1) * a1) / 7; }
+        for (int i = 0; i < 16; ++i) {
+            int bestIndex = 0, bestError = INT32_MAX;
+            for (int p = 0; p < 8; ++p) {
+                const int error = std::abs(block[i][channel] - palette[p]);
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = p;
+                }
+            }
+            indices |= static_cast<uint64_t>(bestIndex) << (i * 3);
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(a0);
+    out[1] = static_cast<uint8_t>(a1);
+    for (int b = 0; b < 6; ++b) { out[2 + b] = static_cast<uint8_t>(indices >> (b * 8)); }
+}
+
+// bc7 mode 6: a single subset with rgba 7.7.7.7 endpoints, a p-bit per endpoint and 4-bit indices
+static void
+encodeBC7Block(const uint8_t block[16][4], uint8_t* out)
+{
+    static constexpr int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    int lo[4] = { 255, 255, 255, 255 };
+    int hi[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            lo[c] = std::min(lo[c], static_cast<int>(block[i][c]));
+            hi[c] = std::max(hi[c], static_cast<int>(block[i][c]));
+        }
+    }
+
+    auto quantize = [](const int endpoint[4], int quantized[4], int& pbit) {
+        int bestError = INT32_MAX;
+        for (int p = 0; p < 2; ++p) {
+            int candidate[4];
+            int error = 0;
+            for (int c = 0; c < 4; ++c) {
+                candidate[c]    = std::clamp((endpoint[c] - p + 1) >> 1, 0, 127);
+                const int value = (candidate[c] << 1) | p;
+                error += (value - endpoint[c]) * (value - endpoint[c]);
+            }
+            if (error < bestError) {
+                bestError = error;
+                pbit      = p;
+                memcpy(quantized, candidate, sizeof(candidate));
+            }
+        }
+    };
+
+    int q0[4], q1[4], p0 = 0, p1 = 0;
+    quantize(lo, q0, p0);
+    quantize(hi, q1, p1);
+
+    int e0[4], e1[4];
+    for (int c = 0; c < 4; ++c) {
+        e0[c] = (q0[c] << 1) | p0;
+        e1[c] = (q1[c] << 1) | p1;
+    }
+
+    int palette[16][4];
+    for (int w = 0; w < 16; ++w) {
+        for (int c = 0; c < 4; ++c) { palette[w][c] = ((64 - weights[w]) * e0[c] + weights[w] * e1[c] + 32) >> 6; }
+    }
+
+    int indices[16];
+    for (int i = 0; i < 16; ++i) {
+        int bestIndex = 0, bestError = INT32_MAX;
+        for (int w = 0; w < 16; ++w) {
+            int error = 0;
+            for (int c = 0; c < 4; ++c) {
+                const int d = block[i][c] - palette[w][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                bestIndex = w;
+            }
+        }
+        indices[i] = bestIndex;
+    }
+
+    // the anchor index is stored with its top bit implied to be zero
+    if (indices[0] & 8) {
+        std::swap(q0, q1);
+        std::swap(p0, p1);
+        for (int i = 0; i < 16; ++i) { indices[i] = 15 - indices[i]; }
+    }
+
+    uint64_t bits[2] = { 0, 0 };
+    uint32_t cursor  = 0;
+    auto     write   = [&](uint64_t value, uint32_t count) {
+        for (uint32_t b = 0; b < count; ++b, ++cursor) {
+            if ((value >> b) & 1) { bits[cursor >> 6] |= 1ULL << (cursor & 63); }
+        }
+    };
+
+    write(1ULL << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        write(static_cast<uint64_t>(q0[c]), 7);
+        write(static_cast<uint64_t>(q1[c]), 7);
+    }
+    write(static_cast<uint64_t>(p0), 1);
+    write(static_cast<uint64_t>(p1), 1);
+    write(static_cast<uint64_t>(indices[0]), 3);
+    for (int i = 1; i < 16; ++i) { write(static_cast<uint64_t>(indices[i]), 4); }
+
+    memcpy(out, bits, sizeof(bits));
+}
+
+static void
+encodeLevel(const uint8_t*         pixels,
+            uint32_t               width,
+            uint32_t               height,
+            uint32_t               channels,
+            XPETextureBufferFormat format,
+            uint8_t*               out,
+            uint32_t               maxThreads)
+{
+    const uint32_t blocksX    = (width + 3) / 4;
+    const uint32_t blocksY    = (height + 3) / 4;
+    const uint32_t blockBytes = XPTextureBuffer::getFormatElementSize(format);
+
+    parallelRange(blocksY, 4, maxThreads, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        uint8_t block[16][4];
+        for (uint32_t by = rowBegin; by < rowEnd; ++by) {
+            for (uint32_t bx = 0; bx < blocksX; ++bx) {
+                fetchBlock(pixels, width, height, channels, bx, by, block);
+                uint8_t* dst = out + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+                switch (format) {
+                    case XPETextureBufferFormat::BC1_RGBA: encodeColorBlock(block, dst); break;
+                    case XPETextureBufferFormat::BC3_RGBA: {
+                        encodeSingleChannelBlock(block, 3, dst);
+                        encodeColorBlock(block, dst + 8);
+                    } break;
+                    case XPETextureBufferFormat::BC5_RG: {
+                        encodeSingleChannelBlock(block, 0, dst);
+                        encodeSingleChannelBlock(block, 1, dst + 8);
+                    } break;
+                    case XPETextureBufferFormat::BC7_RGBA: encodeBC7Block(block, dst); break;
+                    default: break;
+                }
+            }
+        }
+    });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// CONTAINER
+// ---------------------------------------------------------------------------------------------------------------------
+static void
+writeContainer(const std::string&                          path,
+               uint64_t                                    sourceKey,
+               XPETextureBufferFormat                      format,
+               const std::vector<XPTextureBufferMipLevel>& levels,
+               const std::vector<uint8_t>&                 payload)
+{
+    XPTextureCookedHeader header = {};
+    memcpy(header.magic, XPTextureCookedMagic, sizeof(header.magic));
+    header.version       = XPTextureCookedVersion;
+    header.sourceKey     = sourceKey;
+    header.format        = static_cast<uint32_t>(format);
+    header.mipLevelCount = static_cast<uint32_t>(levels.size());
+    const size_t tableSize = levels.size() * sizeof(XPTextureCookedMipLevel);
+    header.payloadOffset   = alignUp(sizeof(XPTextureCookedHeader) + tableSize, XPTextureCookedAlignment);
+    header.payloadSize     = payload.size();
+
+    std::vector<XPTextureCookedMipLevel> table;
+    table.reserve(levels.size());
+    for (const auto& level : levels) {
+        table.push_back({ level.dimensions.x, level.dimensions.y, level.offset, level.size });
+    }
+
+    // write next to the final path then rename, readers never observe a partially written container
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open()) {
+            XP_LOGV(XPLoggerSeverityWarning, "Failed to write cooked texture %s", tmpPath.c_str());
+            return;
+        }
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(table.data()), tableSize);
+        const size_t      padding                         = header.payloadOffset - sizeof(header) - tableSize;
+        static const char zeros[XPTextureCookedAlignment] = {};
+        stream.write(zeros, padding);
+        stream.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+        if (!stream.good()) {
+            XP_LOGV(XPLoggerSeverityWarning, "Failed to write cooked texture %s", tmpPath.c_str());
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) { XP_LOGV(XPLoggerSeverityWarning, "Failed to store cooked texture %s", path.c_str()); }
+}
+
+std::string
+XPTextureCooker::getCachePath(XPTextureAsset* textureAsset, const XPTextureCookSettings& settings)
+{
+    return buildContainerPath(computeSourceKey(textureAsset, settings));
+}
+
+bool
+XPTextureCooker::loadCached(XPTextureAsset* textureAsset, const XPTextureCookSettings& settings)
+{
+    if (!settings.useCache) { return false; }
+
+    const uint64_t    sourceKey = computeSourceKey(textureAsset, settings);
+    const std::string path      = buildContainerPath(sourceKey);
+    if (!XPFS::isFile(path.c_str())) { return false; }
+
+    auto mapping = std::make_shared<XPMappedFile>();
+    if (!mapping->open(path) || mapping->getSize() < sizeof(XPTextureCookedHeader)) { return false; }
+
+    XPTextureCookedHeader header = {};
+    memcpy(&header, mapping->getData(), sizeof(header));
+    const size_t tableEnd =
+      sizeof(header) + static_cast<size_t>(header.mipLevelCount) * sizeof(XPTextureCookedMipLevel);
+    if (memcmp(header.magic, XPTextureCookedMagic, sizeof(header.magic)) != 0 ||
+        header.version != XPTextureCookedVersion || header.sourceKey != sourceKey || header.mipLevelCount == 0 ||
+        tableEnd > header.payloadOffset || header.payloadOffset + header.payloadSize > mapping->getSize()) {
+        XP_LOGV(XPLoggerSeverityWarning, "Ignoring invalid cooked texture %s", path.c_str());
+        return false;
+    }
+
+    std::vector<XPTextureBufferMipLevel> levels(header.mipLevelCount);
+    for (uint32_t i = 0; i < header.mipLevelCount; ++i) {
+        XPTextureCookedMipLevel entry = {};
+        memcpy(&entry, mapping->getData() + sizeof(header) + i * sizeof(XPTextureCookedMipLevel), sizeof(entry));
+        if (entry.offset + entry.size > header.payloadSize) { return false; }
+        levels[i] = { XPVec2<uint32_t>(entry.width, entry.height),
+                      static_cast<size_t>(entry.offset),
+                      static_cast<size_t>(entry.size) };
+    }
+
+    XPTextureBuffer*               textureBuffer = textureAsset->getTextureBuffer();
+    const std::span<const uint8_t> payload = mapping->getBytes().subspan(header.payloadOffset, header.payloadSize);
+    textureBuffer->setFormat(static_cast<XPETextureBufferFormat>(header.format));
+    textureBuffer->setMappedMipChain(std::move(mapping), payload, std::move(levels));
+    return true;
+}
+
+bool
+XPTextureCooker::cook(XPTextureAsset*              textureAsset,
+                      const uint8_t*               pixels,
+                      uint32_t                     width,
+                      uint32_t                     height,
+                      uint32_t                     channels,
+                      const XPTextureCookSettings& settings)
+{
+    if (channels != 1 && channels != 2 && channels != 4) {
+        XP_LOGV(XPLoggerSeverityWarning,
+                "Cannot cook texture with %u channels %s",
+                channels,
+                textureAsset->getFile()->getPath().c_str());
+        return false;
+    }
+
+    // mips are always filtered on the decoded pixels, compression happens on every finished level
+    std::vector<XPVec2<uint32_t>> dimensions = { XPVec2<uint32_t>(width, height) };
+    if (settings.generateMips) {
+        while (dimensions.back().x > 1 || dimensions.back().y > 1) {
+            dimensions.push_back(
+              XPVec2<uint32_t>(std::max(1u, dimensions.back().x >> 1), std::max(1u, dimensions.back().y >> 1)));
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> decodedLevels(dimensions.size());
+    decodedLevels[0].assign(pixels, pixels + static_cast<size_t>(width) * height * channels);
+    for (size_t level = 1; level < dimensions.size(); ++level) {
+        const auto& src = dimensions[level - 1];
+        const auto& dst = dimensions[level];
+        decodedLevels[level].resize(static_cast<size_t>(dst.x) * dst.y * channels);
+        if (settings.mipFilter == XPETextureMipFilter::Kaiser) {
+            downsampleKaiser(decodedLevels[level - 1].data(),
+                             src.x,
+                             src.y,
+                             decodedLevels[level].data(),
+                             dst.x,
+                             dst.y,
+                             channels,
+                             settings.maxThreads);
+        } else {
+            downsampleBox(decodedLevels[level - 1].data(),
+                          src.x,
+                          src.y,
+                          decodedLevels[level].data(),
+                          dst.x,
+                          dst.y,
+                          channels,
+                          settings.maxThreads);
+        }
+    }
+
+    XPETextureBufferFormat format = channels == 1   ? XPETextureBufferFormat::R8
+                                    : channels == 2 ? XPETextureBufferFormat::R8_G8
+                                                    : XPETextureBufferFormat::R8_G8_B8_A8;
+    switch (settings.compression) {
+        case XPETextureCompression::None: break;
+        case XPETextureCompression::BC1: format = XPETextureBufferFormat::BC1_RGBA; break;
+        case XPETextureCompression::BC3: format = XPETextureBufferFormat::BC3_RGBA; break;
+        case XPETextureCompression::BC5: format = XPETextureBufferFormat::BC5_RG; break;
+        case XPETextureCompression::BC7: format = XPETextureBufferFormat::BC7_RGBA; break;
+    }
+
+    std::vector<XPTextureBufferMipLevel> levels(dimensions.size());
+    size_t                               payloadSize = 0;
+    for (size_t level = 0; level < dimensions.size(); ++level) {
+        levels[level].dimensions = dimensions[level];
+        levels[level].offset     = payloadSize;
+        levels[level].size       = XPTextureBuffer::getMipLevelByteSize(format, dimensions[level]);
+        payloadSize              = alignUp(payloadSize + levels[level].size, XPTextureCookedAlignment);
+    }
+
+    std::vector<uint8_t> payload(payloadSize, 0);
+    for (size_t level = 0; level < dimensions.size(); ++level) {
+        uint8_t* dst = payload.data() + levels[level].offset;
+        if (XPTextureBuffer::isBlockCompressedFormat(format)) {
+            encodeLevel(decodedLevels[level].data(),
+                        dimensions[level].x,
+                        dimensions[level].y,
+                        channels,
+                        format,
+                        dst,
+                        settings.maxThreads);
+        } else {
+            memcpy(dst, decodedLevels[level].data(), levels[level].size);
+        }
+    }
+
+    if (settings.useCache) {
+        XPFS::createDirectory(XPFS::buildCachePath("textures").c_str());
+        const uint64_t sourceKey = computeSourceKey(textureAsset, settings);
+        writeContainer(buildContainerPath(sourceKey), sourceKey, format, levels, payload);
+    }
+
+    XPTextureBuffer* textureBuffer = textureAsset->getTextureBuffer();
+    textureBuffer->setFormat(format);
+    textureBuffer->setMipChain(std::move(payload), std::move(levels));
+    return true;
+}
@@ -0,0 +1,67 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#include <stdint.h>
+#include <string>
+
+class XPTextureAsset;
+
+enum class XPETextureMipFilter
+{
+    Box,
+    Kaiser,
+};
+
+enum class XPETextureCompression
+{
+    None,
+    BC1,
+    BC3,
+    BC5,
+    BC7,
+};
+
+struct XPTextureCookSettings
+{
+    bool                  generateMips = true;
+    XPETextureMipFilter   mipFilter    = XPETextureMipFilter::Box;
+    XPETextureCompression compression  = XPETextureCompression::None;
+    bool                  useCache     = true;
+    /// @brief 0 uses all the hardware threads
+    uint32_t              maxThreads   = 0;
+};
+
+/// @brief Turns decoded images into GPU ready texture buffers (mip chain + optional BCn encoding) and keeps the
+/// result in an on-disk container that is mapped directly on the next load
+class XPTextureCooker
+{
+  public:
+    XPTextureCooker()  = delete;
+    ~XPTextureCooker() = delete;
+
+    /// @brief maps a previously cooked container into the texture buffer if the source file did not change since
+    [[nodiscard]] static bool loadCached(XPTextureAsset* textureAsset, const XPTextureCookSettings& settings);
+    /// @brief builds the texture buffer from decoded 1, 2 or 4 channel 8-bit pixels and writes the cooked container
+    static bool               cook(XPTextureAsset*              textureAsset,
+                                   const uint8_t*               pixels,
+                                   uint32_t                     width,
+                                   uint32_t                     height,
+                                   uint32_t                     channels,
+                                   const XPTextureCookSettings& settings);
+    [[nodiscard]] static std::string getCachePath(XPTextureAsset* textureAsset, const XPTextureCookSettings& settings);
+};
@@ -19,7 +19,7 @@
 #include <DataPipeline/XPFile.h>
 #if defined(XP_PLATFORM_EMSCRIPTEN)
     #include <DataPipeline/XPFileWatchEmscripten.h>
-#elif defined(XP_PLATFORM_MACOS)
+#elif defined(XP_PLATFORM_MACOS) || defined(XP_PLATFORM_LINUX)
     #include <DataPipeline/XPFileWatchUnix.h>
 #elif defined(XP_PLATFORM_WINDOWS)
     #include <DataPipeline/XPFileWatchWindows.h>
@@ -39,9 +39,8 @@
     #include <Physics/PhysX4/XPPhysX4Physics.h>
 #elif defined(XP_PHYSICS_PHYSX5)
     #include <Physics/PhysX5/XPPhysX5Physics.h>
-#else
-    #include <Physics/Empty/XPEmptyPhysics.h>
 #endif
+#include <Physics/Empty/XPEmptyPhysics.h>
 #include <SceneDescriptor/XPScene.h>
 #include <SceneDescriptor/XPSceneDescriptorStore.h>
 #if defined(XP_EDITOR_MODE)
@@ -50,6 +49,7 @@
 #include <Utilities/XPAnnotations.h>
 #include <Utilities/XPFS.h>
 
+#include <Renderer/Empty/XPEmptyRenderer.h>
 #include <Renderer/Interface/XPRendererGraph.h>
 #if defined(XP_PLATFORM_EMSCRIPTEN)
     #include <Renderer/WebGPU/WGSL/XPWGSLLang.h>
@@ -80,8 +80,70 @@
     #include <Compute/XPCompute.h>
 #endif
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <string>
+
+// --headless [--frames N] [--scene path] steps the scene without a window, ui or physics and renders every camera in
+// software to ./output, the process exit code tells whether every camera was rendered
+// --output exr,png,raw|memory [--compression N] picks what the software renderer encodes its frames to
+struct XPLaunchOptions
+{
+    bool        headless         = false;
+    uint32_t    numFrames        = 1;
+    std::string outputFormats    = "exr";
+    int         compressionLevel = 0;
+    std::string scenePath;
+};
+
+static XPLaunchOptions
+parseLaunchOptions(int argc, char** argv)
+{
+    XPLaunchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            options.numFrames = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            options.scenePath = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            options.outputFormats = argv[++i];
+        } else if (strcmp(argv[i], "--compression") == 0 && i + 1 < argc) {
+            options.compressionLevel = static_cast<int>(strtol(argv[++i], nullptr, 10));
+        }
+    }
+    return options;
+}
+
+#if defined(XP_RENDERER_SW)
+static XPSWFrameOutputSettings
+frameOutputSettings(const XPLaunchOptions& options)
+{
+    XPSWFrameOutputSettings settings;
+    settings.formats          = XPSWEFrameOutputFormat_None;
+    settings.compressionLevel = options.compressionLevel;
+    std::stringstream ss(options.outputFormats);
+    std::string       format;
+    while (std::getline(ss, format, ',')) {
+        if (format == "exr") {
+            settings.formats |= XPSWEFrameOutputFormat_EXR;
+        } else if (format == "png") {
+            settings.formats |= XPSWEFrameOutputFormat_PNG;
+        } else if (format == "raw") {
+            settings.formats |= XPSWEFrameOutputFormat_Raw;
+        } else if (format == "memory") {
+            settings.sink = XPSWEFrameOutputSink_Memory;
+        } else {
+            XP_LOGV(XPLoggerSeverityWarning, "Unknown output format %s", format.c_str());
+        }
+    }
+    return settings;
+}
+#endif
 
 static void
 onFileCreatedCallback(XPFile* file)
@@ -230,7 +292,7 @@ c_on_copy()
 #endif
 
 XPProfilable int
-start()
+start(XPLaunchOptions options)
 {
     puts("\n\n----- XPENGINE [" XP_PLATFORM_NAME "][" XP_CONFIG_NAME "] -----");
 
@@ -256,51 +318,65 @@ start()
     auto dataPipelineStore    = XP_NEW XPDataPipelineStore(registry.get());
 #if defined(XP_PLATFORM_EMSCRIPTEN)
     auto fileWatch = XP_NEW XPFileWatchEmscripten(registry.get());
-#elif defined(XP_PLATFORM_MACOS)
+#elif defined(XP_PLATFORM_MACOS) || defined(XP_PLATFORM_LINUX)
     auto fileWatch = XP_NEW XPFileWatchUnix(registry.get());
 #elif defined(XP_PLATFORM_WINDOWS)
     auto fileWatch = XP_NEW XPFileWatchWindows(registry.get());
 #endif
-#if defined(XP_EDITOR_MODE)
-    auto ui = XP_NEW XPImGuiUIImpl(registry.get());
-#else
     XPIUI* ui = nullptr;
+#if defined(XP_EDITOR_MODE)
+    if (!options.headless) { ui = XP_NEW XPImGuiUIImpl(registry.get()); }
 #endif
 
+    XPIRenderer* renderer = nullptr;
+    if (!options.headless) {
 #if defined(XP_PLATFORM_EMSCRIPTEN)
-    auto renderer        = XP_NEW XPWGPURenderer(registry.get(), ui);
-    auto shaderBlockLang = XP_NEW XPWGSLLang(registry.get());
+        renderer             = XP_NEW XPWGPURenderer(registry.get(), ui);
+        auto shaderBlockLang = XP_NEW XPWGSLLang(registry.get());
 #elif defined(XP_PLATFORM_MACOS)
     #if defined(XP_RENDERER_METAL)
-    auto renderer = XP_NEW XPMetalRenderer(registry.get());
+        renderer = XP_NEW XPMetalRenderer(registry.get());
     #elif defined(XP_RENDERER_VULKAN)
-    auto renderer = XP_NEW XPVulkanRenderer(registry.get());
+        renderer = XP_NEW XPVulkanRenderer(registry.get());
     #elif defined(XP_RENDERER_WGPU)
-    auto renderer = XP_NEW XPWGPURenderer(registry.get(), ui);
+        renderer = XP_NEW XPWGPURenderer(registry.get(), ui);
     #endif
 #elif defined(XP_PLATFORM_WINDOWS)
     #if defined(XP_RENDERER_DX12)
-    auto renderer = XP_NEW XPDX12Renderer(registry.get());
+        renderer = XP_NEW XPDX12Renderer(registry.get());
     #elif defined(XP_RENDERER_VULKAN)
-    auto renderer = XP_NEW XPVulkanRenderer(registry.get());
+        renderer = XP_NEW XPVulkanRenderer(registry.get());
     #elif defined(XP_RENDERER_WGPU)
-    auto renderer = XP_NEW XPWGPURenderer(registry.get(), ui);
+        renderer = XP_NEW XPWGPURenderer(registry.get(), ui);
     #endif
 #endif
+    }
+    if (renderer == nullptr) {
+        // linux has no gpu renderer, it only ever runs headless
+        if (!options.headless) { XP_LOG(XPLoggerSeverityInfo, "No gpu renderer on this platform, running headless"); }
+        options.headless = true;
+        renderer         = XP_NEW XPEmptyRenderer(registry.get());
+    }
 #if defined(XP_RENDERER_SW)
     auto swRenderer = XP_NEW XPSWRenderer(registry.get());
+    swRenderer->setFrameOutputSettings(frameOutputSettings(options));
 #endif
+    XPIPhysics* physics = nullptr;
+    if (options.headless) {
+        physics = XP_NEW XPEmptyPhysics(registry.get());
+    } else {
 #if defined(XP_PHYSICS_BULLET)
-    auto physics = XP_NEW XPBulletPhysics(registry.get());
+        physics = XP_NEW XPBulletPhysics(registry.get());
 #elif defined(XP_PHYSICS_JOLT)
-    auto physics = XP_NEW XPJoltPhysics(registry.get());
+        physics = XP_NEW XPJoltPhysics(registry.get());
 #elif defined(XP_PHYSICS_PHYSX4)
-    auto physics = XP_NEW XPPhysX4Physics(registry.get());
+        physics = XP_NEW XPPhysX4Physics(registry.get());
 #elif defined(XP_PHYSICS_PHYSX5)
-    auto physics = XP_NEW XPPhysX5Physics(registry.get());
+        physics = XP_NEW XPPhysX5Physics(registry.get());
 #else
-    auto physics = XP_NEW XPEmptyPhysics(registry.get());
+        physics = XP_NEW XPEmptyPhysics(registry.get());
 #endif
+    }
 
     auto scene = sceneDescriptorStore->createScene("empty").value();
 
@@ -330,46 +406,60 @@ start()
 
     engine->initialize();
 
-    fileWatch->start(dataPipelineStore,
-                     XPFS::getExecutableDirectoryPath(),
-                     XPFS::getMeshAssetsDirectory(),
-                     XPFS::getSceneAssetsDirectory(),
-                     XPFS::getShaderAssetsDirectory(),
-                     XPFS::getTextureAssetsDirectory(),
-                     XPFS::getPrototypeAssetsDirectory(),
-                     XPFS::getPluginAssetsDirectory(),
-                     XPFS::getRiscvBinaryAssetsDirectory());
-
-    // {
-    //     auto path = std::filesystem::path(XPFS::getExecutableDirectoryPath()) / "meshes" / "stalingrad.glb";
-    //     XPAssimpModelLoader::loadScene(
-    //       dataPipelineStore->getFile(path.string()).value()->getPath(), *dataPipelineStore, *sceneDescriptorStore);
-    // }
-
-    // for (auto& meshBuferPair : dataPipelineStore->getMeshBuffers()) {
-    //     renderer->uploadMeshBuffer(*meshBuferPair.second);
-    // }
-
-    auto gbufferPositionU                               = std::make_unique<XPRendererGraphTarget>();
-    auto gbufferNormalV                                 = std::make_unique<XPRendererGraphTarget>();
-    auto gbufferAlbedo                                  = std::make_unique<XPRendererGraphTarget>();
-    auto gbufferMetallicRoughnessAmbientObjectIdTexture = std::make_unique<XPRendererGraphTarget>();
-
-    rendererGraph->resources.push_back(std::move(gbufferPositionU));
-    rendererGraph->resources.push_back(std::move(gbufferNormalV));
-    rendererGraph->resources.push_back(std::move(gbufferAlbedo));
-    rendererGraph->resources.push_back(std::move(gbufferMetallicRoughnessAmbientObjectIdTexture));
-
-    auto gBufferPass = std::make_unique<XPRendererGraphPass>();
-    auto lightPass   = std::make_unique<XPRendererGraphPass>();
-
-    rendererGraph->passes.push_back(std::move(gBufferPass));
-    rendererGraph->passes.push_back(std::move(lightPass));
-
-    engine->run();
+    int exitCode = 0;
+    if (options.headless) {
+        // no watcher threads in headless runs, the scene is loaded once on this thread before stepping it
+        if (!options.scenePath.empty() &&
+            !dataPipelineStore->createFile(options.scenePath, XPEFileResourceType::Scene).has_value()) {
+            XP_LOGV(XPLoggerSeverityError, "Failed to load scene <%s>", options.scenePath.c_str());
+            exitCode = 1;
+        }
+        if (exitCode == 0) { exitCode = engine->runHeadless(options.numFrames); }
+    } else {
+        fileWatch->start(dataPipelineStore,
+                         XPFS::getExecutableDirectoryPath(),
+                         XPFS::getMeshAssetsDirectory(),
+                         XPFS::getSceneAssetsDirectory(),
+                         XPFS::getShaderAssetsDirectory(),
+                         XPFS::getTextureAssetsDirectory(),
+                         XPFS::getPrototypeAssetsDirectory(),
+                         XPFS::getPluginAssetsDirectory(),
+                         XPFS::getRiscvBinaryAssetsDirectory());
+
+        // {
+        //     auto path = std::filesystem::path(XPFS::getExecutableDirectoryPath()) / "meshes" / "stalingrad.glb";
+        //     XPAssimpModelLoader::loadScene(dataPipelineStore->getFile(path.string()).value()->getPath(),
+        //                                    *dataPipelineStore,
+        //                                    *sceneDescriptorStore);
+        // }
+
+        // for (auto& meshBuferPair : dataPipelineStore->getMeshBuffers()) {
+        //     renderer->uploadMeshBuffer(*meshBuferPair.second);
+        // }
+
+        auto gbufferPositionU                               = std::make_unique<XPRendererGraphTarget>();
+        auto gbufferNormalV                                 = std::make_unique<XPRendererGraphTarget>();
+        auto gbufferAlbedo                                  = std::make_unique<XPRendererGraphTarget>();
+        auto gbufferMetallicRoughnessAmbientObjectIdTexture = std::make_unique<XPRendererGraphTarget>();
+
+        rendererGraph->resources.push_back(std::move(gbufferPositionU));
+        rendererGraph->resources.push_back(std::move(gbufferNormalV));
+        rendererGraph->resources.push_back(std::move(gbufferAlbedo));
+        rendererGraph->resources.push_back(std::move(gbufferMetallicRoughnessAmbientObjectIdTexture));
+
+        auto gBufferPass = std::make_unique<XPRendererGraphPass>();
+        auto lightPass   = std::make_unique<XPRendererGraphPass>();
+
+        rendererGraph->passes.push_back(std::move(gBufferPass));
+        rendererGraph->passes.push_back(std::move(lightPass));
+
+        engine->run();
+    }
 
 #if defined(XP_PLATFORM_EMSCRIPTEN)
 #else
+    // no reload may run while the engine tears down the assets
+    if (!options.headless) { fileWatch->stop(); }
     engine->finalize();
 
     #if defined(XP_MCP_SERVER)
@@ -387,14 +477,14 @@ start()
     std::cout << "CLOSING SAFELY\n";
 #endif
 
-    return 0;
+    return exitCode;
 }
 
 int
-main(int, char**)
+main(int argc, char** argv)
 {
     XPProfilerInitialize();
-    int res = start();
+    int res = start(parseLaunchOptions(argc, argv));
     XPProfilerFinalize();
 
     return res;
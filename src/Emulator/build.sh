@@ -1,5 +1,8 @@
 #!/bin/bash
 
+# riscv32i (soft float, default), riscv32imc (compressed) or riscv32imfd (hardware float)
+XP_RISCV_PRESET=${1:-riscv32i}
+
 # rm -rf build
 # cmake -S . -Bbuild -G "Ninja Multi-Config"
 # cmake --build ./build/ --config Debug
@@ -8,7 +11,7 @@
 
 cd test
 rm -rf build
-cmake -S . -Bbuild -DCMAKE_TOOLCHAIN_FILE=./cmake/riscv32i.toolchain.cmake -G "Ninja Multi-Config"
+cmake -S . -Bbuild -DCMAKE_TOOLCHAIN_FILE=./cmake/${XP_RISCV_PRESET}.toolchain.cmake -G "Ninja Multi-Config"
 cmake --build ./build/ --config Debug
 cmake --build ./build/ --config Release
 cmake --build ./build/ --config RelWithDebInfo
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Emulator/XPEmulatorConfig.h>
+#include <Emulator/XPEmulatorFileMapping.h>
 #include <Emulator/XPEmulatorHostMappedMemory.h>
 #include <Emulator/XPEmulatorMemory.h>
 #include <Emulator/XPEmulatorUART.h>
@@ -26,6 +27,7 @@ typedef struct XPEmulatorBus
     struct XPEmulatorMemory           memory;
     struct XPEmulatorUART             uart;
     struct XPEmulatorHostMappedMemory hostMappedMemory;
+    struct XPEmulatorFileMapping      fileMapping;
 } XPEmulatorBus;
 
 XP_EMULATOR_EXTERN void
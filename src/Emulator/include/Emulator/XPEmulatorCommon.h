@@ -33,6 +33,7 @@ enum XP_EMULATOR_PROGRAM_EXIT_CODE
     XP_EMULATOR_PROGRAM_EXIT_CODE_UNHANDLED_SYSCALL        = -4,
     XP_EMULATOR_PROGRAM_EXIT_CODE_FENCE_UNIMPLEMENTED      = -5,
     XP_EMULATOR_PROGRAM_EXIT_CODE_FLOATING_POINT_EXCEPTION = -6,
+    XP_EMULATOR_PROGRAM_EXIT_CODE_YIELD                    = 1, // not an exit, a budgeted run stopped after an ecall
 };
 
 #define XP_EMULATOR_DBG_ASSERT(A, MSG)                                                                                 \
@@ -119,6 +119,35 @@
 #define XP_EMULATOR_CONFIG_HMM_WRITE_END_TRIANGLE_STREAM_PTR    (XP_EMULATOR_CONFIG_HMM_MESH_COMM_BASE_PTR)     // WRITE STATE END (0x8)
 #define XP_EMULATOR_CONFIG_HMM_WRITE_END_SUBMESH_STREAM_PTR     (XP_EMULATOR_CONFIG_HMM_MESH_COMM_BASE_PTR)     // WRITE STATE SUBMESH BEGIN (0x9)
 
+// DMA: descriptors are { src, dst, length, kind } uint32_t quads in guest memory, the guest points the engine at a run of
+// them and rings the doorbell, the host copies every range with a single memcpy and the guest polls status/completed
+#define XP_EMULATOR_CONFIG_HMM_DMA_BASE             (XP_EMULATOR_CONFIG_HMM_BASE + 0x100U)
+#define XP_EMULATOR_CONFIG_HMM_DMA_DESCRIPTORS_PTR  (XP_EMULATOR_CONFIG_HMM_DMA_BASE + 0x00U)  // WRITE GUEST ADDRESS OF THE FIRST DESCRIPTOR
+#define XP_EMULATOR_CONFIG_HMM_DMA_COUNT_PTR        (XP_EMULATOR_CONFIG_HMM_DMA_BASE + 0x04U)  // WRITE NUMBER OF DESCRIPTORS
+#define XP_EMULATOR_CONFIG_HMM_DMA_DOORBELL_PTR     (XP_EMULATOR_CONFIG_HMM_DMA_BASE + 0x08U)  // WRITE ANYTHING TO SUBMIT
+#define XP_EMULATOR_CONFIG_HMM_DMA_STATUS_PTR       (XP_EMULATOR_CONFIG_HMM_DMA_BASE + 0x0CU)  // READ STATUS
+#define XP_EMULATOR_CONFIG_HMM_DMA_COMPLETED_PTR    (XP_EMULATOR_CONFIG_HMM_DMA_BASE + 0x10U)  // READ DESCRIPTORS COMPLETED SINCE BOOT
+#define XP_EMULATOR_CONFIG_HMM_DMA_ERROR_INDEX_PTR  (XP_EMULATOR_CONFIG_HMM_DMA_BASE + 0x14U)  // READ INDEX OF THE FAILING DESCRIPTOR
+
+#define XP_EMULATOR_CONFIG_HMM_DMA_STATUS_IDLE  0U
+#define XP_EMULATOR_CONFIG_HMM_DMA_STATUS_BUSY  1U
+#define XP_EMULATOR_CONFIG_HMM_DMA_STATUS_DONE  2U
+#define XP_EMULATOR_CONFIG_HMM_DMA_STATUS_ERROR 3U
+
+// kind[7:0] selects the transfer, kind[15:8] the host buffer slot for the host transfers
+#define XP_EMULATOR_CONFIG_HMM_DMA_KIND_COPY       0U // guest src to guest dst, ranges may overlap
+#define XP_EMULATOR_CONFIG_HMM_DMA_KIND_FILL       1U // guest dst filled with the low byte of src
+#define XP_EMULATOR_CONFIG_HMM_DMA_KIND_HOST_READ  2U // host buffer at offset src to guest dst
+#define XP_EMULATOR_CONFIG_HMM_DMA_KIND_HOST_WRITE 3U // guest src to host buffer at offset dst
+#define XP_EMULATOR_CONFIG_HMM_DMA_KIND(KIND, SLOT) ((KIND) | ((SLOT) << 8))
+
+#define XP_EMULATOR_CONFIG_HMM_DMA_MAX_HOST_BUFFERS 16U
+#define XP_EMULATOR_CONFIG_HMM_DMA_SLOT_VERTICES    0U
+#define XP_EMULATOR_CONFIG_HMM_DMA_SLOT_NORMALS     1U
+#define XP_EMULATOR_CONFIG_HMM_DMA_SLOT_TEXCOORDS   2U
+#define XP_EMULATOR_CONFIG_HMM_DMA_SLOT_INDICES     3U
+#define XP_EMULATOR_CONFIG_HMM_DMA_SLOT_TEXTURE     4U
+
 // clang-format on
 
 // SMD
@@ -140,9 +169,50 @@
 #define XP_EMULATOR_CONFIG_MAIN_MEMORY_RANGE_END                                                                       \
     (XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE + XP_EMULATOR_CONFIG_MEMORY_HEAP_SIZE)
 
+// read only window host files are mapped into by the mmap syscall, every mapping owns one fixed size slot
+#define XP_EMULATOR_CONFIG_FILE_MAPPING_BASE      (0xA0000000U)
+#define XP_EMULATOR_CONFIG_FILE_MAPPING_SLOT_SIZE (64 * 1024U * 1024U) // 64 MB
+#define XP_EMULATOR_CONFIG_FILE_MAPPING_MAX_SLOTS (16U)
+#define XP_EMULATOR_CONFIG_FILE_MAPPING_END       (0xE0000000U)        // BASE + SLOT_SIZE * MAX_SLOTS
+
+// guest file descriptors per processor, 0-2 are the standard streams
+#define XP_EMULATOR_CONFIG_MAX_OPEN_FILES (32U)
+
 // define it for using riscv M extension
 #define XP_EMULATOR_USE_M_EXTENSION
 
+// define it for using riscv F (single precision) extension, pulls in the fflags/frm/fcsr subset of Zicsr
+#define XP_EMULATOR_USE_F_EXTENSION
+
+// define it for using riscv D (double precision) extension, requires F
+#define XP_EMULATOR_USE_D_EXTENSION
+
+// define it for using riscv C (16 bit compressed) extension, expanded to the 32 bit forms at decode time
+#define XP_EMULATOR_USE_C_EXTENSION
+
+// define it for using riscv Zicntr (cycle, time, instret) counters, read only through the Zicsr instructions
+#define XP_EMULATOR_USE_ZICNTR_EXTENSION
+
+// define it for building the host side PC sampling profiler into the processor step
+#define XP_EMULATOR_USE_PROFILER
+
+#if defined(XP_EMULATOR_USE_D_EXTENSION) && !defined(XP_EMULATOR_USE_F_EXTENSION)
+    #error "XP_EMULATOR_USE_D_EXTENSION requires XP_EMULATOR_USE_F_EXTENSION"
+#endif
+
+// Zicsr is pulled in by anything that owns a CSR
+#if defined(XP_EMULATOR_USE_F_EXTENSION) || defined(XP_EMULATOR_USE_ZICNTR_EXTENSION)
+    #define XP_EMULATOR_USE_ZICSR_EXTENSION
+#endif
+
+// every instruction retires in a single cycle, time ticks at a fixed rate derived from cycles so guests
+// timing themselves get the same answer on every run regardless of the host
+#define XP_EMULATOR_CONFIG_CLOCK_FREQUENCY_HZ (100000000ULL) // 100 MHz
+#define XP_EMULATOR_CONFIG_TIMER_FREQUENCY_HZ (1000000ULL)   // 1 MHz
+
+#define XP_EMULATOR_CONFIG_PROFILER_MAX_CALL_DEPTH   (128U)
+#define XP_EMULATOR_CONFIG_PROFILER_DEFAULT_INTERVAL (1000U) // retired instructions between samples
+
 // define it for riscv64
 #if defined(__riscv)
     #if __riscv_xlen == 64
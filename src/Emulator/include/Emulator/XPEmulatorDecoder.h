@@ -23,6 +23,15 @@
 XP_EMULATOR_EXTERN struct XPEmulatorEncodedInstruction
 xp_emulator_decoder_decode_instruction(uint32_t encodedInstruction);
 
+#if defined(XP_EMULATOR_USE_C_EXTENSION)
+// returns the equivalent 32 bit encoding, 0 (an illegal instruction) when the encoding is reserved or unsupported
+XP_EMULATOR_EXTERN uint32_t
+xp_emulator_decoder_expand_compressed_instruction(uint16_t encodedInstruction);
+
+XP_EMULATOR_EXTERN struct XPEmulatorEncodedInstruction
+xp_emulator_decoder_decode_compressed_instruction(uint16_t encodedInstruction);
+#endif
+
 //XP_EMULATOR_EXTERN uint32_t
 //imm_I(struct XPEmulatorEncodedInstruction instr);
 
@@ -23,21 +23,30 @@
 // SEGMENT0: FLASH, SEGMENT1: RAM, SEGMENT2: HEAP
 #define MAX_SEGMENTS 3
 
-// Memory segment structure
+// Memory segment structure, data is a view into the mapped file and is never copied
 typedef struct
 {
-    uint64_t vaddr;
-    uint64_t size;
-    uint32_t flags;
-    uint8_t* data;
+    uint64_t       vaddr;
+    uint64_t       size;      // bytes in guest memory, everything past file_size is zero filled by the consumer
+    uint64_t       file_size; // bytes backed by the file
+    uint32_t       flags;
+    const uint8_t* data;
 } MemorySegment;
 
-// ELF loader structure
+// Function symbol from .symtab, symbols are sorted by address
 typedef struct
 {
-    char*    filename;
-    uint8_t* file_data;
-    size_t   file_size;
+    uint64_t    address;
+    uint64_t    size;
+    const char* name; // points into RiscvElfLoader::symbol_names
+} ElfSymbol;
+
+// ELF loader structure, the file stays mapped read only until the loader is unloaded
+typedef struct
+{
+    char*          filename;
+    const uint8_t* file_data;
+    size_t         file_size;
 
     MemorySegment segments[MAX_SEGMENTS];
     int           num_segments;
@@ -45,6 +54,11 @@ typedef struct
     bool     is_64bit;
     bool     is_little_endian;
     uint64_t entry_point;
+
+    // empty for stripped binaries
+    ElfSymbol*  symbols;
+    int         num_symbols;
+    const char* symbol_names; // the string table inside the mapped file
 } RiscvElfLoader;
 
 XP_EMULATOR_EXTERN
@@ -52,4 +66,8 @@ RiscvElfLoader*
 xp_emulator_elf_loader_load(const char* program_binary);
 
 XP_EMULATOR_EXTERN void
-xp_emulator_elf_loader_unload(RiscvElfLoader* loader);
\ No newline at end of file
+xp_emulator_elf_loader_unload(RiscvElfLoader* loader);
+
+// returns the function symbol covering address, NULL when it falls outside every known function
+XP_EMULATOR_EXTERN const ElfSymbol*
+xp_emulator_elf_loader_find_symbol(const RiscvElfLoader* loader, uint64_t address);
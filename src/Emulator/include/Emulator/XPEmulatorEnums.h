@@ -140,6 +140,70 @@ enum XPEmulatorEInstructionType
     XPEmulatorEInstructionType_REMW,  // R-TYPE
     XPEmulatorEInstructionType_REMUW, // R-TYPE
     #endif
+#endif
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+    XPEmulatorEInstructionType_FLW,       // I-Type
+    XPEmulatorEInstructionType_FSW,       // S-Type
+    XPEmulatorEInstructionType_FMADD_S,   // R4-Type
+    XPEmulatorEInstructionType_FMSUB_S,   // R4-Type
+    XPEmulatorEInstructionType_FNMSUB_S,  // R4-Type
+    XPEmulatorEInstructionType_FNMADD_S,  // R4-Type
+    XPEmulatorEInstructionType_FADD_S,    // R-Type
+    XPEmulatorEInstructionType_FSUB_S,    // R-Type
+    XPEmulatorEInstructionType_FMUL_S,    // R-Type
+    XPEmulatorEInstructionType_FDIV_S,    // R-Type
+    XPEmulatorEInstructionType_FSQRT_S,   // R-Type
+    XPEmulatorEInstructionType_FSGNJ_S,   // R-Type
+    XPEmulatorEInstructionType_FSGNJN_S,  // R-Type
+    XPEmulatorEInstructionType_FSGNJX_S,  // R-Type
+    XPEmulatorEInstructionType_FMIN_S,    // R-Type
+    XPEmulatorEInstructionType_FMAX_S,    // R-Type
+    XPEmulatorEInstructionType_FCVT_W_S,  // R-Type
+    XPEmulatorEInstructionType_FCVT_WU_S, // R-Type
+    XPEmulatorEInstructionType_FMV_X_W,   // R-Type
+    XPEmulatorEInstructionType_FEQ_S,     // R-Type
+    XPEmulatorEInstructionType_FLT_S,     // R-Type
+    XPEmulatorEInstructionType_FLE_S,     // R-Type
+    XPEmulatorEInstructionType_FCLASS_S,  // R-Type
+    XPEmulatorEInstructionType_FCVT_S_W,  // R-Type
+    XPEmulatorEInstructionType_FCVT_S_WU, // R-Type
+    XPEmulatorEInstructionType_FMV_W_X,   // R-Type
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+    XPEmulatorEInstructionType_FLD,       // I-Type
+    XPEmulatorEInstructionType_FSD,       // S-Type
+    XPEmulatorEInstructionType_FMADD_D,   // R4-Type
+    XPEmulatorEInstructionType_FMSUB_D,   // R4-Type
+    XPEmulatorEInstructionType_FNMSUB_D,  // R4-Type
+    XPEmulatorEInstructionType_FNMADD_D,  // R4-Type
+    XPEmulatorEInstructionType_FADD_D,    // R-Type
+    XPEmulatorEInstructionType_FSUB_D,    // R-Type
+    XPEmulatorEInstructionType_FMUL_D,    // R-Type
+    XPEmulatorEInstructionType_FDIV_D,    // R-Type
+    XPEmulatorEInstructionType_FSQRT_D,   // R-Type
+    XPEmulatorEInstructionType_FSGNJ_D,   // R-Type
+    XPEmulatorEInstructionType_FSGNJN_D,  // R-Type
+    XPEmulatorEInstructionType_FSGNJX_D,  // R-Type
+    XPEmulatorEInstructionType_FMIN_D,    // R-Type
+    XPEmulatorEInstructionType_FMAX_D,    // R-Type
+    XPEmulatorEInstructionType_FCVT_S_D,  // R-Type
+    XPEmulatorEInstructionType_FCVT_D_S,  // R-Type
+    XPEmulatorEInstructionType_FEQ_D,     // R-Type
+    XPEmulatorEInstructionType_FLT_D,     // R-Type
+    XPEmulatorEInstructionType_FLE_D,     // R-Type
+    XPEmulatorEInstructionType_FCLASS_D,  // R-Type
+    XPEmulatorEInstructionType_FCVT_W_D,  // R-Type
+    XPEmulatorEInstructionType_FCVT_WU_D, // R-Type
+    XPEmulatorEInstructionType_FCVT_D_W,  // R-Type
+    XPEmulatorEInstructionType_FCVT_D_WU, // R-Type
+    #endif
+#endif
+#if defined(XP_EMULATOR_USE_ZICSR_EXTENSION)
+    XPEmulatorEInstructionType_CSRRW,  // I-Type
+    XPEmulatorEInstructionType_CSRRS,  // I-Type
+    XPEmulatorEInstructionType_CSRRC,  // I-Type
+    XPEmulatorEInstructionType_CSRRWI, // I-Type
+    XPEmulatorEInstructionType_CSRRSI, // I-Type
+    XPEmulatorEInstructionType_CSRRCI, // I-Type
 #endif
     XPEmulatorEInstructionType_FENCE, // I-Type
     XPEmulatorEInstructionType_ECALL, // I-Type
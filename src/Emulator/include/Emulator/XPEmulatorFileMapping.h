@@ -0,0 +1,56 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorConfig.h>
+
+#include <stdint.h>
+#include <stdio.h>
+
+// a host file region mapped read only into the guest address space, guest loads read the host pages directly
+typedef struct XPEmulatorFileMappingSlot
+{
+    void*    view;       // what the host mapping call returned, page aligned
+    uint64_t viewLength; // bytes mapped on the host, includes the page alignment padding
+    uint8_t* data;       // first byte the guest sees
+    uint32_t length;     // bytes the guest sees, loads past it read zero
+} XPEmulatorFileMappingSlot;
+
+typedef struct XPEmulatorFileMapping
+{
+    XPEmulatorFileMappingSlot slots[XP_EMULATOR_CONFIG_FILE_MAPPING_MAX_SLOTS];
+} XPEmulatorFileMapping;
+
+XP_EMULATOR_EXTERN void
+xp_emulator_file_mapping_initialize(XPEmulatorFileMapping* mapping);
+
+// maps [offset, offset + length) of an open host file, returns the guest address of the first byte or 0
+XP_EMULATOR_EXTERN uint32_t
+xp_emulator_file_mapping_map(XPEmulatorFileMapping* mapping, FILE* file, uint64_t offset, uint32_t length);
+
+// returns 0 when address is the start of a live mapping, -1 otherwise
+XP_EMULATOR_EXTERN int
+xp_emulator_file_mapping_unmap(XPEmulatorFileMapping* mapping, uint32_t address);
+
+XP_EMULATOR_EXTERN uint32_t
+xp_emulator_file_mapping_load(XPEmulatorFileMapping* mapping, uint32_t address, uint32_t size);
+
+// host pointer to [address, address + length) when it sits inside one live mapping, NULL otherwise
+XP_EMULATOR_EXTERN const uint8_t*
+xp_emulator_file_mapping_translate(XPEmulatorFileMapping* mapping, uint32_t address, uint32_t length);
+
+XP_EMULATOR_EXTERN void
+xp_emulator_file_mapping_finalize(XPEmulatorFileMapping* mapping);
@@ -19,6 +19,16 @@
 
 #include <stdint.h>
 
+struct XPEmulatorMemory;
+
+// host side range a DMA descriptor can address through its slot
+typedef struct XPEmulatorDMAHostBuffer
+{
+    uint8_t* data;
+    uint32_t size;
+    uint32_t writable;
+} XPEmulatorDMAHostBuffer;
+
 typedef struct XPEmulatorHostMappedMemory
 {
     uint8_t  data[XP_EMULATOR_CONFIG_HMM_SIZE];
@@ -28,6 +38,9 @@ typedef struct XPEmulatorHostMappedMemory
     uint32_t deviceEndHeap;
     uint32_t deviceFramebuffer;
     uint32_t deviceFrameMemoryPool;
+
+    struct XPEmulatorMemory* guestMemory; // DMA target, set up by the bus
+    XPEmulatorDMAHostBuffer  dmaHostBuffers[XP_EMULATOR_CONFIG_HMM_DMA_MAX_HOST_BUFFERS];
 } XPEmulatorHostMappedMemory;
 
 XP_EMULATOR_EXTERN void
@@ -45,6 +58,15 @@ xp_emulator_host_mapped_memory_store(XPEmulatorHostMappedMemory* memory,
 XP_EMULATOR_EXTERN void
 xp_emulator_host_mapped_memory_finalize(XPEmulatorHostMappedMemory* memory);
 
+// exposes a host range to guest DMA descriptors through slot, a NULL data unbinds the slot
+// the range must outlive the binding, the guest never sees the host pointer
+XP_EMULATOR_EXTERN void
+xp_emulator_host_mapped_memory_bind_dma_buffer(XPEmulatorHostMappedMemory* memory,
+                                               uint32_t                    slot,
+                                               void*                       data,
+                                               uint32_t                    size,
+                                               uint32_t                    writable);
+
 // uint32_t numVertices
 // uint32_t offsetVertices
 // uint32_t offsetNormals
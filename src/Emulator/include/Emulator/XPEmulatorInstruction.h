@@ -22,13 +22,14 @@
 struct XPEmulatorEncodedInstruction
 {
     enum XPEmulatorEInstructionType type;
+    uint32_t                        size; // in bytes, 2 when expanded from a compressed encoding
     union
     {
-        struct instruction
+        struct
         {
             uint32_t value;
         } instruction;
-        struct TYPE_R
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -37,7 +38,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } TYPE_R;
-        struct TYPE_I
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -45,7 +46,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } TYPE_I;
-        struct TYPE_S
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -54,7 +55,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } TYPE_S;
-        struct TYPE_B
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -63,37 +64,47 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } TYPE_B;
-        struct TYPE_U
+        struct
+        {
+            uint32_t opcode : 7;
+            uint32_t rd : 5;
+            uint32_t funct3 : 3;
+            uint32_t rs1 : 5;
+            uint32_t rs2 : 5;
+            uint32_t funct2 : 2;
+            uint32_t rs3 : 5;
+        } TYPE_R4;
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
             uint32_t imm : 20;
         } TYPE_U;
-        struct TYPE_J
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
             uint32_t imm : 20;
         } TYPE_J;
-        struct LUI
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
             uint32_t imm : 20;
         } LUI;
-        struct AUIPC
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
             uint32_t imm : 20;
         } AUIPC;
-        struct JAL
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
             uint32_t imm : 20;
         } JAL;
-        struct JALR
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -101,7 +112,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } JALR;
-        struct BEQ
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -110,7 +121,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } BEQ;
-        struct BNE
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -119,7 +130,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } BNE;
-        struct BLT
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -128,7 +139,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } BLT;
-        struct BGE
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -137,7 +148,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } BGE;
-        struct BLTU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -146,7 +157,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } BLTU;
-        struct BGEU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -155,7 +166,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } BGEU;
-        struct LB
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -163,7 +174,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } LB;
-        struct LH
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -171,7 +182,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } LH;
-        struct LW
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -179,7 +190,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } LW;
-        struct LBU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -187,7 +198,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } LBU;
-        struct LHU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -195,7 +206,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } LHU;
-        struct SB
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -204,7 +215,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } SB;
-        struct SH
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -213,7 +224,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } SH;
-        struct SW
+        struct
         {
             uint32_t opcode : 7;
             uint32_t imm_rd : 5;
@@ -222,7 +233,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t imm_funct7 : 7;
         } SW;
-        struct ADDI
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -230,7 +241,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } ADDI;
-        struct SLTI
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -238,7 +249,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } SLTI;
-        struct SLTIU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -246,7 +257,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } SLTIU;
-        struct XORI
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -254,7 +265,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } XORI;
-        struct ORI
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -262,7 +273,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } ORI;
-        struct ANDI
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -270,7 +281,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } ANDI;
-        struct SLLI
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -278,7 +289,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } SLLI;
-        struct SRLI
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -286,7 +297,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } SRLI;
-        struct SRAI
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -294,7 +305,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } SRAI;
-        struct ADD
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -303,7 +314,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } ADD;
-        struct SUB
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -312,7 +323,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } SUB;
-        struct SLL
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -321,7 +332,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } SLL;
-        struct SLT
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -330,7 +341,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } SLT;
-        struct SLTU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -339,7 +350,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } SLTU;
-        struct XOR
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -348,7 +359,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } XOR;
-        struct SRL
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -357,7 +368,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } SRL;
-        struct SRA
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -366,7 +377,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } SRA;
-        struct OR
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -375,7 +386,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } OR;
-        struct AND
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -385,7 +396,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t funct7 : 7;
         } AND;
 #ifdef XP_EMULATOR_USE_M_EXTENSION
-        struct MUL
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -394,7 +405,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } MUL;
-        struct MULH
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -403,7 +414,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } MULH;
-        struct MULHSU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -412,7 +423,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } MULHSU;
-        struct MULHU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -421,7 +432,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } MULHU;
-        struct DIV
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -430,7 +441,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } DIV;
-        struct DIVU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -439,7 +450,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } DIVU;
-        struct REM
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -448,7 +459,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } REM;
-        struct REMU
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -458,7 +469,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t funct7 : 7;
         } REMU;
     #if defined(XP_EMULATOR_USE_XLEN_64)
-        struct MULW
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -467,7 +478,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } MULW;
-        struct DIVW
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -476,7 +487,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } DIVW;
-        struct DIVUW
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -485,7 +496,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } DIVUW;
-        struct REMW
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -494,7 +505,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs2 : 5;
             uint32_t funct7 : 7;
         } REMW;
-        struct REMUW
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -505,7 +516,60 @@ struct XPEmulatorEncodedInstruction
         } REMUW;
     #endif
 #endif
-        struct FENCE
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+        // FLW / FLD
+        struct
+        {
+            uint32_t opcode : 7;
+            uint32_t rd : 5;
+            uint32_t width : 3;
+            uint32_t rs1 : 5;
+            uint32_t imm : 12;
+        } FLOAD;
+        // FSW / FSD
+        struct
+        {
+            uint32_t opcode : 7;
+            uint32_t imm_rd : 5;
+            uint32_t width : 3;
+            uint32_t rs1 : 5;
+            uint32_t rs2 : 5;
+            uint32_t imm_funct7 : 7;
+        } FSTORE;
+        // FMADD / FMSUB / FNMSUB / FNMADD
+        struct
+        {
+            uint32_t opcode : 7;
+            uint32_t rd : 5;
+            uint32_t rm : 3;
+            uint32_t rs1 : 5;
+            uint32_t rs2 : 5;
+            uint32_t fmt : 2;
+            uint32_t rs3 : 5;
+        } FMA;
+        // OP-FP, rm doubles as funct3 for sign injection, min/max, compares, moves and classify
+        struct
+        {
+            uint32_t opcode : 7;
+            uint32_t rd : 5;
+            uint32_t rm : 3;
+            uint32_t rs1 : 5;
+            uint32_t rs2 : 5;
+            uint32_t funct7 : 7;
+        } FOP;
+#endif
+#if defined(XP_EMULATOR_USE_ZICSR_EXTENSION)
+        // CSRRW / CSRRS / CSRRC and their immediate forms, rs1 holds uimm[4:0] for the latter
+        struct
+        {
+            uint32_t opcode : 7;
+            uint32_t rd : 5;
+            uint32_t funct3 : 3;
+            uint32_t rs1 : 5;
+            uint32_t csr : 12;
+        } CSR;
+#endif
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -515,7 +579,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t pred : 4;
             uint32_t fm : 4;
         } FENCE;
-        struct ECALL
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -523,7 +587,7 @@ struct XPEmulatorEncodedInstruction
             uint32_t rs1 : 5;
             uint32_t imm : 12;
         } ECALL;
-        struct EBREAK
+        struct
         {
             uint32_t opcode : 7;
             uint32_t rd : 5;
@@ -16,26 +16,37 @@
 
 #include <Emulator/XPEmulatorConfig.h>
 
+// receives one formatted log line (without the trailing new line)
+typedef void (*XPEmulatorLogSink)(const char* text);
+
+// routes emulator logs to sink instead of stdout, the host engine hands them to its asynchronous logger this way.
+// passing NULL restores the default stdout writer
+XP_EMULATOR_EXTERN void
+xp_emulator_logger_set_sink(XPEmulatorLogSink sink);
+
+XP_EMULATOR_EXTERN void
+xp_emulator_logger_write(const char* format, ...);
+
 #ifdef XP_EMULATOR_CONFIG_ENABLE_LOGS
-    #define XP_EMULATOR_LOG(MSG)       printf(MSG "\n");
-    #define XP_EMULATOR_LOGV(FMT, ...) printf(FMT "\n", __VA_ARGS__);
+    #define XP_EMULATOR_LOG(MSG)       xp_emulator_logger_write("%s", MSG);
+    #define XP_EMULATOR_LOGV(FMT, ...) xp_emulator_logger_write(FMT, __VA_ARGS__);
 #else
     #define XP_EMULATOR_LOG(MSG)
     #define XP_EMULATOR_LOGV(FMT, ...)
 #endif
 
 #ifdef XP_EMULATOR_CONFIG_ENABLE_SYSCALL_LOGS
-    #define XP_EMULATOR_LOG_SYSCALL(MSG)       printf(MSG "\n");
-    #define XP_EMULATOR_LOGV_SYSCALL(FMT, ...) printf(FMT "\n", __VA_ARGS__);
+    #define XP_EMULATOR_LOG_SYSCALL(MSG)       xp_emulator_logger_write("%s", MSG);
+    #define XP_EMULATOR_LOGV_SYSCALL(FMT, ...) xp_emulator_logger_write(FMT, __VA_ARGS__);
 #else
     #define XP_EMULATOR_LOG_SYSCALL(MSG)
     #define XP_EMULATOR_LOGV_SYSCALL(FMT, ...)
 #endif
 
 #ifdef XP_EMULATOR_CONFIG_ENABLE_BUS_LOGS
-    #define XP_EMULATOR_LOG_BUS(MSG)       printf(MSG "\n");
-    #define XP_EMULATOR_LOGV_BUS(FMT, ...) printf(FMT "\n", __VA_ARGS__);
+    #define XP_EMULATOR_LOG_BUS(MSG)       xp_emulator_logger_write("%s", MSG);
+    #define XP_EMULATOR_LOGV_BUS(FMT, ...) xp_emulator_logger_write(FMT, __VA_ARGS__);
 #else
     #define XP_EMULATOR_LOG_BUS(MSG)
     #define XP_EMULATOR_LOGV_BUS(FMT, ...)
-#endif
\ No newline at end of file
+#endif
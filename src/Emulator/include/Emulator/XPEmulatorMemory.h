@@ -24,6 +24,10 @@ typedef struct XPEmulatorMemory
     uint8_t flash[XP_EMULATOR_CONFIG_MEMORY_FLASH_SIZE];
     uint8_t ram[XP_EMULATOR_CONFIG_MEMORY_RAM_SIZE];
     uint8_t heap[XP_EMULATOR_CONFIG_MEMORY_HEAP_SIZE];
+    // optional read only view over the start of flash, not owned, usually the text segment of a mapped program
+    // loads below textSize read it instead of flash and stores there are dropped
+    const uint8_t* text;
+    uint32_t       textSize;
 } XPEmulatorMemory;
 
 XP_EMULATOR_EXTERN void
@@ -37,3 +41,8 @@ xp_emulator_memory_store(XPEmulatorMemory* memory, uint32_t address, uint32_t si
 
 XP_EMULATOR_EXTERN void
 xp_emulator_memory_finalize(XPEmulatorMemory* memory);
+
+// host pointer to [address, address + length) when the whole range sits in one region, NULL otherwise
+// flash is only handed out for reading
+XP_EMULATOR_EXTERN uint8_t*
+xp_emulator_memory_translate(XPEmulatorMemory* memory, uint32_t address, uint32_t length, int writable);
@@ -18,19 +18,36 @@
 #include <Emulator/XPEmulatorConfig.h>
 #include <Emulator/XPEmulatorEnums.h>
 #include <Emulator/XPEmulatorElfLoader.h>
+#include <Emulator/XPEmulatorSyscalls.h>
 
 #include <stdint.h>
 
+struct XPEmulatorProfiler;
+
 typedef struct XPEmulatorProcessor
 {
     struct XPEmulatorBus bus;
     uint32_t             regs[XPEmulatorEReg_Count];
     uint32_t             pc;
+    XPEmulatorSyscalls   syscalls;
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+    uint64_t fregs[XPEmulatorEReg_Count]; // f0-f31, singles are NaN-boxed in the low 32 bits when D is enabled
+    uint32_t fcsr;                        // fflags [4:0] | frm [7:5]
+#endif
+#if defined(XP_EMULATOR_USE_ZICNTR_EXTENSION)
+    uint64_t cycle;
+    uint64_t instret;
+#endif
+#if defined(XP_EMULATOR_USE_PROFILER)
+    struct XPEmulatorProfiler* profiler; // optional, not owned, sampled on every step when set
+#endif
 } XPEmulatorProcessor;
 
 XP_EMULATOR_EXTERN void
 xp_emulator_processor_initialize(XPEmulatorProcessor* processor);
 
+// text runs from the loader mapping without a copy, the loader has to outlive the processor
+// returns 0 on success, -1 when a segment doesn't fit its memory region
 XP_EMULATOR_EXTERN int
 xp_emulator_processor_load_program(XPEmulatorProcessor* processor, RiscvElfLoader* loader);
 
@@ -40,5 +57,16 @@ xp_emulator_processor_step(XPEmulatorProcessor* processor);
 XP_EMULATOR_EXTERN void
 xp_emulator_processor_run(XPEmulatorProcessor* processor);
 
+// steps until budget instructions retired or an ecall retired (YIELD) or the program stopped (negative exit code)
+// retired receives the number of instructions that retired, it may be NULL
+XP_EMULATOR_EXTERN int
+xp_emulator_processor_run_budget(XPEmulatorProcessor* processor, uint32_t budget, uint32_t* retired);
+
 XP_EMULATOR_EXTERN void
 xp_emulator_processor_finalize(XPEmulatorProcessor* processor);
+
+#if defined(XP_EMULATOR_USE_ZICNTR_EXTENSION)
+// value of the time csr, ticks at XP_EMULATOR_CONFIG_TIMER_FREQUENCY_HZ
+XP_EMULATOR_EXTERN uint64_t
+xp_emulator_processor_time(const XPEmulatorProcessor* processor);
+#endif
@@ -0,0 +1,111 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorConfig.h>
+#include <Emulator/XPEmulatorElfLoader.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Host side sampling profiler, the processor calls into it from step (sample) and from JAL/JALR (call/return) when
+// XPEmulatorProcessor::profiler is set. Samples are taken every `interval` retired instructions and bucketed by PC and
+// by the shadow call stack built from the ABI linkage convention, symbolization happens on export only.
+
+typedef struct XPEmulatorProfilerFrame
+{
+    uint32_t entry;         // callee address
+    uint32_t returnAddress; // where the matching return lands
+} XPEmulatorProfilerFrame;
+
+typedef struct XPEmulatorProfilerPcHits
+{
+    uint32_t pc;
+    uint32_t hits;
+} XPEmulatorProfilerPcHits;
+
+typedef struct XPEmulatorProfilerStackHits
+{
+    uint64_t hash;
+    uint32_t hits;
+    uint32_t depth;       // outermost caller, callee entries, then the sampled pc as the leaf
+    size_t   framesIndex; // into XPEmulatorProfiler::framePool, root first
+} XPEmulatorProfilerStackHits;
+
+typedef struct XPEmulatorProfilerFunctionHits
+{
+    const char* name; // NULL for samples outside every known function
+    uint64_t    address;
+    uint64_t    hits;
+} XPEmulatorProfilerFunctionHits;
+
+typedef struct XPEmulatorProfiler
+{
+    uint32_t interval;
+    uint32_t countdown;
+    uint64_t totalSamples;
+
+    XPEmulatorProfilerFrame callStack[XP_EMULATOR_CONFIG_PROFILER_MAX_CALL_DEPTH];
+    uint32_t                callDepth;
+    uint32_t                droppedCalls; // calls past max depth, unwound by the returns that match nothing
+
+    // open addressed, capacity is a power of two, hits == 0 marks a free slot
+    XPEmulatorProfilerPcHits* pcBuckets;
+    uint32_t                  pcCapacity;
+    uint32_t                  pcCount;
+
+    XPEmulatorProfilerStackHits* stackBuckets;
+    uint32_t                     stackCapacity;
+    uint32_t                     stackCount;
+
+    uint32_t* framePool;
+    size_t    framePoolSize;
+    size_t    framePoolCapacity;
+} XPEmulatorProfiler;
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_initialize(XPEmulatorProfiler* profiler, uint32_t interval);
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_reset(XPEmulatorProfiler* profiler);
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_sample(XPEmulatorProfiler* profiler, uint32_t pc);
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_on_call(XPEmulatorProfiler* profiler, uint32_t entry, uint32_t returnAddress);
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_on_return(XPEmulatorProfiler* profiler, uint32_t target);
+
+// copies the hottest PCs, returns how many were written
+XP_EMULATOR_EXTERN size_t
+xp_emulator_profiler_pc_histogram(const XPEmulatorProfiler* profiler, XPEmulatorProfilerPcHits* out, size_t capacity);
+
+// self samples per function symbolized through the loader symbol table, hottest first, returns how many were written
+XP_EMULATOR_EXTERN size_t
+xp_emulator_profiler_function_histogram(const XPEmulatorProfiler*       profiler,
+                                        const RiscvElfLoader*           loader,
+                                        XPEmulatorProfilerFunctionHits* out,
+                                        size_t                          capacity);
+
+// writes one "root;caller;leaf hits" line per distinct stack, the folded format flamegraph tools consume
+XP_EMULATOR_EXTERN int
+xp_emulator_profiler_write_folded(const XPEmulatorProfiler* profiler, const RiscvElfLoader* loader, FILE* file);
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_finalize(XPEmulatorProfiler* profiler);
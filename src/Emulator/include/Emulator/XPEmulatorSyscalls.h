@@ -16,12 +16,18 @@
 
 #include <Emulator/XPEmulatorConfig.h>
 
+#include <stdint.h>
+#include <stdio.h>
+
 #define XP_EMULATOR_SYSCALL_OPEN         1024
 #define XP_EMULATOR_SYSCALL_CLOCKGETTIME 403
+#define XP_EMULATOR_SYSCALL_MMAP         222
+#define XP_EMULATOR_SYSCALL_MUNMAP       215
 #define XP_EMULATOR_SYSCALL_BRK          214
 #define XP_EMULATOR_SYSCALL_GETTIMEOFDAY 169
 #define XP_EMULATOR_SYSCALL_EXIT         93
 #define XP_EMULATOR_SYSCALL_FSTAT        80
+#define XP_EMULATOR_SYSCALL_PREAD        67
 #define XP_EMULATOR_SYSCALL_WRITE        64
 #define XP_EMULATOR_SYSCALL_READ         63
 #define XP_EMULATOR_SYSCALL_LSEEK        62
@@ -29,4 +35,48 @@
 
 #define XP_EMULATOR_STDIN_FILENO  0
 #define XP_EMULATOR_STDOUT_FILENO 1
-#define XP_EMULATOR_STDERR_FILENO 2
\ No newline at end of file
+#define XP_EMULATOR_STDERR_FILENO 2
+// failures are returned in a0 as the negated linux errno, like the kernel does
+#define XP_EMULATOR_ENOENT 2
+#define XP_EMULATOR_EIO    5
+#define XP_EMULATOR_EBADF  9
+#define XP_EMULATOR_ENOMEM 12
+#define XP_EMULATOR_EACCES 13
+#define XP_EMULATOR_EFAULT 14
+#define XP_EMULATOR_EINVAL 22
+#define XP_EMULATOR_EMFILE 24
+#define XP_EMULATOR_ENOSYS 38
+
+// newlib open flags as the guest passes them
+#define XP_EMULATOR_O_ACCMODE 0x0003
+#define XP_EMULATOR_O_RDONLY  0x0000
+#define XP_EMULATOR_O_WRONLY  0x0001
+#define XP_EMULATOR_O_RDWR    0x0002
+#define XP_EMULATOR_O_APPEND  0x0008
+#define XP_EMULATOR_O_CREAT   0x0200
+#define XP_EMULATOR_O_TRUNC   0x0400
+
+#define XP_EMULATOR_PROT_WRITE 0x2
+
+// mmap offsets are in 4096 byte units like mmap2 on rv32 linux
+#define XP_EMULATOR_MMAP_OFFSET_UNIT 4096ULL
+
+struct XPEmulatorProcessor;
+
+// everything a guest can change through syscalls, owned by one processor so harts never share it
+typedef struct XPEmulatorSyscalls
+{
+    FILE*    files[XP_EMULATOR_CONFIG_MAX_OPEN_FILES]; // indexed by guest fd, NULL when free
+    uint32_t programBreak;
+    uint64_t count; // ecalls serviced, budgeted runs yield when it moves
+} XPEmulatorSyscalls;
+
+XP_EMULATOR_EXTERN void
+xp_emulator_syscalls_initialize(XPEmulatorSyscalls* syscalls);
+
+// services the ecall in a7 with the arguments in a0-a5, returns 0 or a program exit code
+XP_EMULATOR_EXTERN int
+xp_emulator_syscalls_handle(struct XPEmulatorProcessor* processor);
+
+XP_EMULATOR_EXTERN void
+xp_emulator_syscalls_finalize(XPEmulatorSyscalls* syscalls);
@@ -159,6 +159,7 @@ processTextureLoading(Scene<T>&         scene,
             } else {
                 ASSERT_ERROR(false, "We do not handle such cases yet.");
             }
+            buildTextureMips(texture);
             hasTexture = true;
         } else {
             // Handle external texture file
@@ -179,6 +180,9 @@ processTextureLoading(Scene<T>&         scene,
                     texture.channels = 0;
                 } else {
                     LOGV_NOTICE("Done loading texture <{}>", path.string());
+                    // stb reports the channel count of the file, the buffer itself was expanded to rgba
+                    texture.channels = 4;
+                    buildTextureMips(texture);
                     hasTexture = true;
                 }
             }
@@ -14,18 +14,21 @@
 
 #pragma once
 
+#include "../../Utilities/XPThreadPool.h"
 #include "R5RLogger.h"
 #include "R5RMaths.h"
+#include "R5RMemoryPool.h"
 #include "R5RRaytracer.h"
 #include "R5RRenderer.h"
 #include "R5RRendererCommon.h"
 #include "R5RSceneDescriptor.h"
-#include "R5RThreadPool.h"
 
 #include <array>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 struct R5RRenderer;
 
@@ -49,7 +52,8 @@ struct R5RRasterizer
         // frameMemoryStart = 0;
 
 #if defined(R5R_USE_THREADS)
-        threadPool = new R5RThreadPool(std::thread::hardware_concurrency());
+        threadPool = new XPThreadPool();
+        threadMemoryPools.resize(threadPool->getMaxContexts());
 #endif
     }
     ~R5RRasterizer()
@@ -60,7 +64,6 @@ struct R5RRasterizer
         // frameMemoryEnd = 0;
 
 #if defined(R5R_USE_THREADS)
-        threadPool->waitForWork();
         delete threadPool;
 #endif
     }
@@ -1039,6 +1042,43 @@ struct R5RRasterizer
         // projectedVertices
         tpm.popFrameMemory(sizeof(Triangle<T>));
     }
+    void shadeTriangle(R5RThreadPoolMemory&                    tpm,
+                       RasterizerEventListener&                listener,
+                       const Mesh<T>&                          mesh,
+                       size_t                                  ii,
+                       const glm::mat<3, 3, T, glm::defaultp>& normalMatrix,
+                       const Mat4<T>&                          viewProjectionMatrix,
+                       const Camera<T>&                        camera)
+    {
+        uint32_t i0 = mesh.indices[ii];
+        uint32_t i1 = mesh.indices[ii + 1];
+        uint32_t i2 = mesh.indices[ii + 2];
+
+        Triangle<T> tr  = {};
+        tr.v0.location  = mesh.vertices[i0];
+        tr.v0.normal    = mesh.normals[i0];
+        tr.v0.coord     = mesh.texCoords[i0];
+        tr.v0.color     = Vec4<T>{ mesh.colors[i0].x, mesh.colors[i0].y, mesh.colors[i0].z, 1.0f };
+        tr.v0.tangent   = mesh.tangents[i0];
+        tr.v0.biTangent = mesh.biTangents[i0];
+
+        tr.v1.location  = mesh.vertices[i1];
+        tr.v1.normal    = mesh.normals[i1];
+        tr.v1.coord     = mesh.texCoords[i1];
+        tr.v1.color     = Vec4<T>{ mesh.colors[i1].x, mesh.colors[i1].y, mesh.colors[i1].z, 1.0f };
+        tr.v1.tangent   = mesh.tangents[i1];
+        tr.v1.biTangent = mesh.biTangents[i1];
+
+        tr.v2.location  = mesh.vertices[i2];
+        tr.v2.normal    = mesh.normals[i2];
+        tr.v2.coord     = mesh.texCoords[i2];
+        tr.v2.color     = Vec4<T>{ mesh.colors[i2].x, mesh.colors[i2].y, mesh.colors[i2].z, 1.0f };
+        tr.v2.tangent   = mesh.tangents[i2];
+        tr.v2.biTangent = mesh.biTangents[i2];
+
+        vertexShader(
+          tpm, listener, tr, mesh.transform, normalMatrix, viewProjectionMatrix, camera, mesh.materialIndex);
+    }
     void renderFrame(RasterizerEventListener& listener, Camera<T>& camera)
     {
 #ifndef R5R_USE_THREADS
@@ -1059,55 +1099,26 @@ struct R5RRasterizer
                 continue;
             }
             normalMatrix = glm::transpose(glm::inverse(glm::mat3(mesh.transform.glm)));
-            for (size_t ii = 0; ii < mesh.indices.size() - 2; ii += 3) {
-                uint32_t i0 = mesh.indices[ii];
-                uint32_t i1 = mesh.indices[ii + 1];
-                uint32_t i2 = mesh.indices[ii + 2];
-
-                Triangle<T> tr  = {};
-                tr.v0.location  = mesh.vertices[i0];
-                tr.v0.normal    = mesh.normals[i0];
-                tr.v0.coord     = mesh.texCoords[i0];
-                tr.v0.color     = Vec4<T>{ mesh.colors[i0].x, mesh.colors[i0].y, mesh.colors[i0].z, 1.0f };
-                tr.v0.tangent   = mesh.tangents[i0];
-                tr.v0.biTangent = mesh.biTangents[i0];
-
-                tr.v1.location  = mesh.vertices[i1];
-                tr.v1.normal    = mesh.normals[i1];
-                tr.v1.coord     = mesh.texCoords[i1];
-                tr.v1.color     = Vec4<T>{ mesh.colors[i1].x, mesh.colors[i1].y, mesh.colors[i1].z, 1.0f };
-                tr.v1.tangent   = mesh.tangents[i1];
-                tr.v1.biTangent = mesh.biTangents[i1];
-
-                tr.v2.location  = mesh.vertices[i2];
-                tr.v2.normal    = mesh.normals[i2];
-                tr.v2.coord     = mesh.texCoords[i2];
-                tr.v2.color     = Vec4<T>{ mesh.colors[i2].x, mesh.colors[i2].y, mesh.colors[i2].z, 1.0f };
-                tr.v2.tangent   = mesh.tangents[i2];
-                tr.v2.biTangent = mesh.biTangents[i2];
 #if defined(R5R_USE_THREADS)
-                threadPool->submit(
-                  [&listener, tr, normalMatrix, viewProjectionMatrix, &camera, &mesh, this](R5RThreadPoolMemory& tpm) {
-#endif
-                      vertexShader(tpm,
-                                   listener,
-                                   tr,
-                                   mesh.transform,
-                                   normalMatrix,
-                                   viewProjectionMatrix,
-                                   camera,
-                                   mesh.materialIndex);
-#if defined(R5R_USE_THREADS)
-                  });
+            // chunks of triangles are split across the workers, each one shades into its own scratch memory
+            threadPool->parallelFor(
+              0, mesh.indices.size() / 3, TrianglesPerJob, [&](size_t first, size_t last, uint32_t contextIndex) {
+                  std::unique_ptr<R5RThreadPoolMemory>& threadTpm = threadMemoryPools[contextIndex];
+                  if (!threadTpm) { threadTpm = std::make_unique<R5RThreadPoolMemory>(10 * 1024 * sizeof(uint8_t)); }
+                  for (size_t ti = first; ti < last; ++ti) {
+                      shadeTriangle(*threadTpm, listener, mesh, ti * 3, normalMatrix, viewProjectionMatrix, camera);
+                      threadTpm->checkClear();
+                      threadTpm->popAllFrameMemory();
+                  }
+              });
 #else
+            for (size_t ii = 0; ii + 2 < mesh.indices.size(); ii += 3) {
+                shadeTriangle(tpm, listener, mesh, ii, normalMatrix, viewProjectionMatrix, camera);
                 tpm.checkClear();
                 tpm.popAllFrameMemory();
-#endif
             }
-        }
-#if defined(R5R_USE_THREADS)
-        threadPool->waitForWork();
 #endif
+        }
 
 #ifndef __EMSCRIPTEN__
         std::stringstream ss;
@@ -1448,7 +1459,10 @@ struct R5RRasterizer
         }
     }
 #if defined(R5R_USE_THREADS)
-    R5RThreadPool* threadPool;
+    static constexpr size_t TrianglesPerJob = 64;
+    XPThreadPool*           threadPool;
+    // scratch memory per context of threadPool, allocated the first time a context rasterizes
+    std::vector<std::unique_ptr<R5RThreadPoolMemory>> threadMemoryPools;
 #endif
     R5RRenderer* renderer;
     Scene<T>*    scene;
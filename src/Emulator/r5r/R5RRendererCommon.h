@@ -151,15 +151,15 @@ getPBRMaterial(const Material<T>& material,
         : Vec4<T>{ 1.0f, 1.0f, 1.0f, 1.0f };
     Vec4<T> emissionTexture =
       material.hasEmissionColorTexture
-        ? sampleTextureLinear<T>(material.emissionColorTexture, texCoord.x, texCoord.y, repeatUVCoords, false)
+        ? sampleTextureLinear<T>(material.emissionColorTexture, texCoord.x, texCoord.y, repeatUVCoords, true)
         : Vec4<T>{ 1.0f, 1.0f, 1.0f, 1.0f };
     Vec4<T> metallicTexture =
       material.hasMetallicTexture
-        ? sampleTextureLinear<T>(material.metallicTexture, texCoord.x, texCoord.y, repeatUVCoords, true)
+        ? sampleTextureLinear<T>(material.metallicTexture, texCoord.x, texCoord.y, repeatUVCoords, false)
         : Vec4<T>{ 1.0f, 1.0f, 1.0f, 1.0f };
     Vec4<T> roughnessTexture =
       material.hasRoughnessTexture
-        ? sampleTextureLinear<T>(material.roughnessTexture, texCoord.x, texCoord.y, repeatUVCoords, true)
+        ? sampleTextureLinear<T>(material.roughnessTexture, texCoord.x, texCoord.y, repeatUVCoords, false)
         : Vec4<T>{ 1.0f, 1.0f, 1.0f, 1.0f };
     Vec4<T> aoTexture = material.hasAOTexture
                           ? sampleTextureLinear<T>(material.aoTexture, texCoord.x, texCoord.y, repeatUVCoords, false)
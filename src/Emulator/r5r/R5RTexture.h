@@ -17,9 +17,31 @@
 #include "R5RMaths.h"
 #include "R5RThirdParty.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <filesystem>
 #include <vector>
 
+/// @brief One level of a texture stored as 4x4 tiles of rgba8 texels, a tile is exactly one 64 byte cache line so
+/// that the 2x2 footprint of a bilinear fetch touches a single line most of the time
+struct Texture2DMip
+{
+    int                   width  = 0;
+    int                   height = 0;
+    int                   tilesX = 0;
+    std::vector<uint32_t> texels;
+
+    [[nodiscard]] inline uint32_t fetch(int x, int y) const
+    {
+        return texels[((static_cast<size_t>(y >> 2) * tilesX + (x >> 2)) << 4) + ((y & 3) << 2) + (x & 3)];
+    }
+    inline void write(int x, int y, uint32_t texel)
+    {
+        texels[((static_cast<size_t>(y >> 2) * tilesX + (x >> 2)) << 4) + ((y & 3) << 2) + (x & 3)] = texel;
+    }
+};
+
 struct Texture2D
 {
     Texture2D()
@@ -76,86 +98,168 @@ struct Texture2D
             fvec4* f32rgbapixels;
         };
     };
-    std::string path;
-    int         width;
-    int         height;
-    int         channels;
-    bool        isHDR;
+    std::string               path;
+    int                       width;
+    int                       height;
+    int                       channels;
+    bool                      isHDR;
+    std::vector<Texture2DMip> mips;
 };
 
-template<typename T>
-inline fvec4
-sampleTextureLinear(const Texture2D& texture, float u, float v, bool repeat, bool applyGammeCorrect)
+// 8-bit to float conversion tables, the srgb one replaces the per sample pow of the gamma curve
+inline const float*
+getUnormToFloatTable()
 {
-    // Handle UV wrapping (can be changed to CLAMP or other modes)
-    if (repeat) {
-        u = u - floor(u);
-        v = v - floor(v);
-    }
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> t = {};
+        for (int i = 0; i < 256; ++i) { t[i] = static_cast<float>(i) / 255.0f; }
+        return t;
+    }();
+    return table.data();
+}
 
-    u = glm::fclamp(u, 0.0f, 1.0f);
-    v = glm::fclamp(v, 0.0f, 1.0f);
+inline const float*
+getSRGBToLinearTable()
+{
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> t = {};
+        for (int i = 0; i < 256; ++i) {
+            const float c = static_cast<float>(i) / 255.0f;
+            t[i]          = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return t;
+    }();
+    return table.data();
+}
 
-    // Convert UV to texture coordinates
-    float x = u * static_cast<float>(texture.width) - 0.5f; // Adjust for pixel centers
-    float y = v * static_cast<float>(texture.height) - 0.5f;
+/// @brief converts the loaded rgba8 pixels into a tiled mip chain, required before sampling the texture
+inline void
+buildTextureMips(Texture2D& texture)
+{
+    texture.mips.clear();
+    if (texture.u8data == nullptr || texture.isHDR || texture.channels != 4 || texture.width <= 0 ||
+        texture.height <= 0) {
+        return;
+    }
 
-    x = glm::fclamp(x, 0.0f, static_cast<float>(texture.width));
-    y = glm::fclamp(y, 0.0f, static_cast<float>(texture.height));
+    auto allocateMip = [](int width, int height) {
+        Texture2DMip mip;
+        mip.width  = width;
+        mip.height = height;
+        mip.tilesX = (width + 3) / 4;
+        mip.texels.resize(static_cast<size_t>(mip.tilesX) * ((height + 3) / 4) * 16, 0);
+        return mip;
+    };
 
-    // Get integer coordinates of surrounding pixels
-    int x0 = (int)floorf(x);
-    int y0 = (int)floorf(y);
-    int x1 = x0 + 1;
-    int y1 = y0 + 1;
+    Texture2DMip base = allocateMip(texture.width, texture.height);
+    for (int y = 0; y < texture.height; ++y) {
+        for (int x = 0; x < texture.width; ++x) {
+            uint32_t texel;
+            memcpy(&texel, &texture.u8rgbapixels[static_cast<size_t>(y) * texture.width + x], sizeof(texel));
+            base.write(x, y, texel);
+        }
+    }
+    texture.mips.push_back(std::move(base));
 
-    // Clamp coordinates to texture boundaries
-    x0 = glm::clamp(x0, 0, texture.width - 1);
-    x1 = glm::clamp(x1, 0, texture.width - 1);
-    y0 = glm::clamp(y0, 0, texture.height - 1);
-    y1 = glm::clamp(y1, 0, texture.height - 1);
+    while (texture.mips.back().width > 1 || texture.mips.back().height > 1) {
+        const Texture2DMip& src = texture.mips.back();
+        Texture2DMip        dst = allocateMip(std::max(1, src.width >> 1), std::max(1, src.height >> 1));
+        for (int y = 0; y < dst.height; ++y) {
+            const int y0 = std::min(y * 2, src.height - 1);
+            const int y1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; ++x) {
+                const int      x0       = std::min(x * 2, src.width - 1);
+                const int      x1       = std::min(x * 2 + 1, src.width - 1);
+                const uint32_t texels[] = {
+                    src.fetch(x0, y0), src.fetch(x1, y0), src.fetch(x0, y1), src.fetch(x1, y1)
+                };
+                uint32_t result = 0;
+                for (int c = 0; c < 4; ++c) {
+                    uint32_t sum = 2;
+                    for (uint32_t texel : texels) { sum += (texel >> (c * 8)) & 0xff; }
+                    result |= (sum >> 2) << (c * 8);
+                }
+                dst.write(x, y, result);
+            }
+        }
+        texture.mips.push_back(std::move(dst));
+    }
+}
 
-    // Calculate fractional parts
-    float x_frac = x - static_cast<float>(x0);
-    float y_frac = y - static_cast<float>(y0);
+/// @brief mip level from the uv footprint of one pixel, derivatives are in uv units per pixel
+inline float
+computeTextureLod(const Texture2D& texture, float dudx, float dvdx, float dudy, float dvdy)
+{
+    if (texture.mips.size() <= 1) { return 0.0f; }
+    const float w    = static_cast<float>(texture.width);
+    const float h    = static_cast<float>(texture.height);
+    const float dx   = (dudx * w) * (dudx * w) + (dvdx * h) * (dvdx * h);
+    const float dy   = (dudy * w) * (dudy * w) + (dvdy * h) * (dvdy * h);
+    const float rho2 = std::max(dx, dy);
+    if (rho2 <= 1.0f) { return 0.0f; }
+    return std::min(0.5f * std::log2(rho2), static_cast<float>(texture.mips.size() - 1));
+}
 
-    // Sample four texels
-    const u8vec4* row0 = texture.u8rgbapixels + y0 * texture.width;
-    const u8vec4* row1 = texture.u8rgbapixels + y1 * texture.width;
+inline fvec4
+sampleTextureMipBilinear(const Texture2DMip& mip, float u, float v, bool repeat, const float* table)
+{
+    if (repeat) {
+        u = u - std::floor(u);
+        v = v - std::floor(v);
+    }
+    u = std::clamp(u, 0.0f, 1.0f);
+    v = std::clamp(v, 0.0f, 1.0f);
 
-    auto c00 = fvec4{ static_cast<float>(row0[x0].x) / 255.0f,
-                      static_cast<float>(row0[x0].y) / 255.0f,
-                      static_cast<float>(row0[x0].z) / 255.0f,
-                      static_cast<float>(row0[x0].w) / 255.0f };
-    auto c10 = fvec4{ static_cast<float>(row0[x1].x) / 255.0f,
-                      static_cast<float>(row0[x1].y) / 255.0f,
-                      static_cast<float>(row0[x1].z) / 255.0f,
-                      static_cast<float>(row0[x1].w) / 255.0f };
-    auto c01 = fvec4{ static_cast<float>(row1[x0].x) / 255.0f,
-                      static_cast<float>(row1[x0].y) / 255.0f,
-                      static_cast<float>(row1[x0].z) / 255.0f,
-                      static_cast<float>(row1[x0].w) / 255.0f };
-    auto c11 = fvec4{ static_cast<float>(row1[x1].x) / 255.0f,
-                      static_cast<float>(row1[x1].y) / 255.0f,
-                      static_cast<float>(row1[x1].z) / 255.0f,
-                      static_cast<float>(row1[x1].w) / 255.0f };
+    // texel space, adjusted for pixel centers
+    const float x  = std::clamp(u * static_cast<float>(mip.width) - 0.5f, 0.0f, static_cast<float>(mip.width - 1));
+    const float y  = std::clamp(v * static_cast<float>(mip.height) - 0.5f, 0.0f, static_cast<float>(mip.height - 1));
+    const int   x0 = static_cast<int>(x);
+    const int   y0 = static_cast<int>(y);
+    const int   x1 = x0 + 1 < mip.width ? x0 + 1 : (repeat ? 0 : x0);
+    const int   y1 = y0 + 1 < mip.height ? y0 + 1 : (repeat ? 0 : y0);
+    const float fx = x - static_cast<float>(x0);
+    const float fy = y - static_cast<float>(y0);
 
-    // Bilinear interpolation using macros
-#define LERP(a, b, t) ((a) + ((b) - (a)) * (t))
-    fvec4 result;
-    result.x = LERP(LERP(c00.x, c10.x, x_frac), LERP(c01.x, c11.x, x_frac), y_frac);
-    result.y = LERP(LERP(c00.y, c10.y, x_frac), LERP(c01.y, c11.y, x_frac), y_frac);
-    result.z = LERP(LERP(c00.z, c10.z, x_frac), LERP(c01.z, c11.z, x_frac), y_frac);
-    result.w = LERP(LERP(c00.w, c10.w, x_frac), LERP(c01.w, c11.w, x_frac), y_frac);
-#undef LERP
+    const uint32_t c00 = mip.fetch(x0, y0);
+    const uint32_t c10 = mip.fetch(x1, y0);
+    const uint32_t c01 = mip.fetch(x0, y1);
+    const uint32_t c11 = mip.fetch(x1, y1);
 
-    if (applyGammeCorrect) {
-        result.x = std::pow(result.x, 2.2f);
-        result.y = std::pow(result.y, 2.2f);
-        result.z = std::pow(result.z, 2.2f);
+    float result[4];
+    for (int c = 0; c < 4; ++c) {
+        // alpha is never srgb encoded
+        const float* lut = c == 3 ? getUnormToFloatTable() : table;
+        const int    s   = c * 8;
+        const float  top = lut[(c00 >> s) & 0xff] + (lut[(c10 >> s) & 0xff] - lut[(c00 >> s) & 0xff]) * fx;
+        const float  bot = lut[(c01 >> s) & 0xff] + (lut[(c11 >> s) & 0xff] - lut[(c01 >> s) & 0xff]) * fx;
+        result[c]        = top + (bot - top) * fy;
     }
+    return fvec4{ result[0], result[1], result[2], result[3] };
+}
+
+/// @brief trilinear sample at an explicit level of detail
+inline fvec4
+sampleTextureTrilinear(const Texture2D& texture, float u, float v, float lod, bool repeat, bool isSRGB)
+{
+    if (texture.mips.empty()) { return fvec4{ 1.0f, 0.0f, 1.0f, 1.0f }; }
+    const float* table = isSRGB ? getSRGBToLinearTable() : getUnormToFloatTable();
+    lod                = std::clamp(lod, 0.0f, static_cast<float>(texture.mips.size() - 1));
+    const int   level0 = static_cast<int>(lod);
+    const float t      = lod - static_cast<float>(level0);
+    fvec4       c0     = sampleTextureMipBilinear(texture.mips[level0], u, v, repeat, table);
+    if (t <= 0.0f) { return c0; }
+    fvec4 c1 = sampleTextureMipBilinear(texture.mips[level0 + 1], u, v, repeat, table);
+    return fvec4{
+        c0.x + (c1.x - c0.x) * t, c0.y + (c1.y - c0.y) * t, c0.z + (c1.z - c0.z) * t, c0.w + (c1.w - c0.w) * t
+    };
+}
 
-    return result;
+/// @brief bilinear sample of the base level
+template<typename T>
+inline fvec4
+sampleTextureLinear(const Texture2D& texture, float u, float v, bool repeat, bool isSRGB)
+{
+    return sampleTextureTrilinear(texture, u, v, 0.0f, repeat, isSRGB);
 }
 
 inline void
@@ -27,6 +27,15 @@ cd riscv-gnu-toolchain
         ../configure --prefix=`pwd`/../install32 --disable-gdb --with-languages="c,c++" --with-arch=rv32im --with-abi=ilp32 --with-isa-spec="20191213"
         make -j`nproc`
     cd ../
+    # hardware float toolchain, used by the riscv32imfd presets
+    rm -rf build32fd
+    rm -rf install32fd
+    mkdir build32fd
+    mkdir install32fd
+    cd build32fd
+        ../configure --prefix=`pwd`/../install32fd --disable-gdb --with-languages="c,c++" --with-arch=rv32imfd --with-abi=ilp32d --with-isa-spec="20191213"
+        make -j`nproc`
+    cd ../
 cd ../
 
 
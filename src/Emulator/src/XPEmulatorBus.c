@@ -25,6 +25,8 @@ xp_emulator_bus_initialize(XPEmulatorBus* bus)
     xp_emulator_memory_initialize(&bus->memory);
     xp_emulator_uart_initialize(&bus->uart);
     xp_emulator_host_mapped_memory_initialize(&bus->hostMappedMemory);
+    bus->hostMappedMemory.guestMemory = &bus->memory;
+    xp_emulator_file_mapping_initialize(&bus->fileMapping);
 }
 
 XP_EMULATOR_EXTERN uint32_t
@@ -39,6 +41,9 @@ xp_emulator_bus_load(XPEmulatorBus* bus, uint32_t address, uint32_t size)
                address <= (XP_EMULATOR_CONFIG_HMM_BASE + XP_EMULATOR_CONFIG_HMM_SIZE)) {
         XP_EMULATOR_LOG_BUS("load host mapped memory");
         return xp_emulator_host_mapped_memory_load(&bus->hostMappedMemory, address, size);
+    } else if (address >= XP_EMULATOR_CONFIG_FILE_MAPPING_BASE && address < XP_EMULATOR_CONFIG_FILE_MAPPING_END) {
+        XP_EMULATOR_LOG_BUS("load file mapping");
+        return xp_emulator_file_mapping_load(&bus->fileMapping, address, size);
     } else {
         if (address >= XP_EMULATOR_CONFIG_MAIN_MEMORY_RANGE_START &&
             address <= XP_EMULATOR_CONFIG_MAIN_MEMORY_RANGE_END) {
@@ -65,6 +70,9 @@ xp_emulator_bus_store(XPEmulatorBus* bus, uint32_t address, uint32_t size, uint3
                address <= (XP_EMULATOR_CONFIG_HMM_BASE + XP_EMULATOR_CONFIG_HMM_SIZE)) {
         XP_EMULATOR_LOG_BUS("store host mapped memory");
         xp_emulator_host_mapped_memory_store(&bus->hostMappedMemory, address, size, value);
+    } else if (address >= XP_EMULATOR_CONFIG_FILE_MAPPING_BASE && address < XP_EMULATOR_CONFIG_FILE_MAPPING_END) {
+        // mappings are read only, drop the store like a write to rom
+        XP_EMULATOR_LOGV_BUS("store to read only file mapping 0x%08x", address);
     } else {
         if (address >= XP_EMULATOR_CONFIG_MAIN_MEMORY_RANGE_START &&
             address <= XP_EMULATOR_CONFIG_MAIN_MEMORY_RANGE_END) {
@@ -81,6 +89,7 @@ xp_emulator_bus_store(XPEmulatorBus* bus, uint32_t address, uint32_t size, uint3
 XP_EMULATOR_EXTERN void
 xp_emulator_bus_finalize(XPEmulatorBus* bus)
 {
+    xp_emulator_file_mapping_finalize(&bus->fileMapping);
     xp_emulator_host_mapped_memory_finalize(&bus->hostMappedMemory);
     xp_emulator_uart_finalize(&bus->uart);
     xp_emulator_memory_finalize(&bus->memory);
@@ -18,6 +18,165 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+static enum XPEmulatorEInstructionType
+decode_fp_instruction_type(uint32_t encodedInstruction)
+{
+    uint32_t opcode = encodedInstruction & 0b1111111;
+    uint32_t funct3 = (encodedInstruction >> 12) & 0b111;
+    uint32_t rs2    = (encodedInstruction >> 20) & 0b11111;
+    uint32_t fmt    = (encodedInstruction >> 25) & 0b11;
+    uint32_t funct7 = (encodedInstruction >> 25) & 0b1111111;
+
+    if (opcode == 0b0000111) {
+        if (funct3 == 0b010) {
+            return XPEmulatorEInstructionType_FLW;
+        }
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+        else if (funct3 == 0b011) {
+            return XPEmulatorEInstructionType_FLD;
+        }
+    #endif
+    } else if (opcode == 0b0100111) {
+        if (funct3 == 0b010) {
+            return XPEmulatorEInstructionType_FSW;
+        }
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+        else if (funct3 == 0b011) {
+            return XPEmulatorEInstructionType_FSD;
+        }
+    #endif
+    } else if (opcode == 0b1000011 || opcode == 0b1000111 || opcode == 0b1001011 || opcode == 0b1001111) {
+        // the four fused multiply-add opcodes are laid out in the same order for S and D
+        uint32_t fused = (opcode >> 2) & 0b11;
+        if (fmt == 0b00) {
+            return XPEmulatorEInstructionType_FMADD_S + fused;
+        }
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+        else if (fmt == 0b01) {
+            return XPEmulatorEInstructionType_FMADD_D + fused;
+        }
+    #endif
+    } else if (opcode == 0b1010011) {
+        if (funct7 == 0b0000000) {
+            return XPEmulatorEInstructionType_FADD_S;
+        } else if (funct7 == 0b0000100) {
+            return XPEmulatorEInstructionType_FSUB_S;
+        } else if (funct7 == 0b0001000) {
+            return XPEmulatorEInstructionType_FMUL_S;
+        } else if (funct7 == 0b0001100) {
+            return XPEmulatorEInstructionType_FDIV_S;
+        } else if (funct7 == 0b0101100 && rs2 == 0) {
+            return XPEmulatorEInstructionType_FSQRT_S;
+        } else if (funct7 == 0b0010000) {
+            if (funct3 == 0b000) {
+                return XPEmulatorEInstructionType_FSGNJ_S;
+            } else if (funct3 == 0b001) {
+                return XPEmulatorEInstructionType_FSGNJN_S;
+            } else if (funct3 == 0b010) {
+                return XPEmulatorEInstructionType_FSGNJX_S;
+            }
+        } else if (funct7 == 0b0010100) {
+            if (funct3 == 0b000) {
+                return XPEmulatorEInstructionType_FMIN_S;
+            } else if (funct3 == 0b001) {
+                return XPEmulatorEInstructionType_FMAX_S;
+            }
+        } else if (funct7 == 0b1100000) {
+            if (rs2 == 0) {
+                return XPEmulatorEInstructionType_FCVT_W_S;
+            } else if (rs2 == 1) {
+                return XPEmulatorEInstructionType_FCVT_WU_S;
+            }
+        } else if (funct7 == 0b1110000 && rs2 == 0) {
+            if (funct3 == 0b000) {
+                return XPEmulatorEInstructionType_FMV_X_W;
+            } else if (funct3 == 0b001) {
+                return XPEmulatorEInstructionType_FCLASS_S;
+            }
+        } else if (funct7 == 0b1010000) {
+            if (funct3 == 0b010) {
+                return XPEmulatorEInstructionType_FEQ_S;
+            } else if (funct3 == 0b001) {
+                return XPEmulatorEInstructionType_FLT_S;
+            } else if (funct3 == 0b000) {
+                return XPEmulatorEInstructionType_FLE_S;
+            }
+        } else if (funct7 == 0b1101000) {
+            if (rs2 == 0) {
+                return XPEmulatorEInstructionType_FCVT_S_W;
+            } else if (rs2 == 1) {
+                return XPEmulatorEInstructionType_FCVT_S_WU;
+            }
+        } else if (funct7 == 0b1111000 && rs2 == 0 && funct3 == 0b000) {
+            return XPEmulatorEInstructionType_FMV_W_X;
+        }
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+        else if (funct7 == 0b0000001) {
+            return XPEmulatorEInstructionType_FADD_D;
+        } else if (funct7 == 0b0000101) {
+            return XPEmulatorEInstructionType_FSUB_D;
+        } else if (funct7 == 0b0001001) {
+            return XPEmulatorEInstructionType_FMUL_D;
+        } else if (funct7 == 0b0001101) {
+            return XPEmulatorEInstructionType_FDIV_D;
+        } else if (funct7 == 0b0101101 && rs2 == 0) {
+            return XPEmulatorEInstructionType_FSQRT_D;
+        } else if (funct7 == 0b0010001) {
+            if (funct3 == 0b000) {
+                return XPEmulatorEInstructionType_FSGNJ_D;
+            } else if (funct3 == 0b001) {
+                return XPEmulatorEInstructionType_FSGNJN_D;
+            } else if (funct3 == 0b010) {
+                return XPEmulatorEInstructionType_FSGNJX_D;
+            }
+        } else if (funct7 == 0b0010101) {
+            if (funct3 == 0b000) {
+                return XPEmulatorEInstructionType_FMIN_D;
+            } else if (funct3 == 0b001) {
+                return XPEmulatorEInstructionType_FMAX_D;
+            }
+        } else if (funct7 == 0b0100000 && rs2 == 1) {
+            return XPEmulatorEInstructionType_FCVT_S_D;
+        } else if (funct7 == 0b0100001 && rs2 == 0) {
+            return XPEmulatorEInstructionType_FCVT_D_S;
+        } else if (funct7 == 0b1010001) {
+            if (funct3 == 0b010) {
+                return XPEmulatorEInstructionType_FEQ_D;
+            } else if (funct3 == 0b001) {
+                return XPEmulatorEInstructionType_FLT_D;
+            } else if (funct3 == 0b000) {
+                return XPEmulatorEInstructionType_FLE_D;
+            }
+        } else if (funct7 == 0b1110001 && rs2 == 0 && funct3 == 0b001) {
+            return XPEmulatorEInstructionType_FCLASS_D;
+        } else if (funct7 == 0b1100001) {
+            if (rs2 == 0) {
+                return XPEmulatorEInstructionType_FCVT_W_D;
+            } else if (rs2 == 1) {
+                return XPEmulatorEInstructionType_FCVT_WU_D;
+            }
+        } else if (funct7 == 0b1101001) {
+            if (rs2 == 0) {
+                return XPEmulatorEInstructionType_FCVT_D_W;
+            } else if (rs2 == 1) {
+                return XPEmulatorEInstructionType_FCVT_D_WU;
+            }
+        }
+    #endif
+    }
+
+    return XPEmulatorEInstructionType_Undefined;
+}
+
+static int
+is_fp_opcode(uint32_t opcode)
+{
+    return opcode == 0b0000111 || opcode == 0b0100111 || opcode == 0b1000011 || opcode == 0b1000111 ||
+           opcode == 0b1001011 || opcode == 0b1001111 || opcode == 0b1010011;
+}
+#endif
+
 XP_EMULATOR_EXTERN enum XPEmulatorEInstructionType
 xp_emulator_decoder_decode_instruction_type(uint32_t encodedInstruction)
 {
@@ -155,16 +314,38 @@ xp_emulator_decoder_decode_instruction_type(uint32_t encodedInstruction)
         }
     }
     #endif
+#endif
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+    else if (is_fp_opcode(opcode)) {
+        return decode_fp_instruction_type(encodedInstruction);
+    }
 #endif
     else if (opcode == 0b0001111) {
         return XPEmulatorEInstructionType_FENCE;
     } else if (opcode == 0b1110011) {
         uint32_t imm_11_0 = (encodedInstruction >> 20) & 0b111111111111;
-        if (imm_11_0 == 0b000000000000) {
-            return XPEmulatorEInstructionType_ECALL;
-        } else if (imm_11_0 == 0b000000000001) {
-            return XPEmulatorEInstructionType_EBREAK;
+        if (funct3 == 0b000) {
+            if (imm_11_0 == 0b000000000000) {
+                return XPEmulatorEInstructionType_ECALL;
+            } else if (imm_11_0 == 0b000000000001) {
+                return XPEmulatorEInstructionType_EBREAK;
+            }
         }
+#if defined(XP_EMULATOR_USE_ZICSR_EXTENSION)
+        else if (funct3 == 0b001) {
+            return XPEmulatorEInstructionType_CSRRW;
+        } else if (funct3 == 0b010) {
+            return XPEmulatorEInstructionType_CSRRS;
+        } else if (funct3 == 0b011) {
+            return XPEmulatorEInstructionType_CSRRC;
+        } else if (funct3 == 0b101) {
+            return XPEmulatorEInstructionType_CSRRWI;
+        } else if (funct3 == 0b110) {
+            return XPEmulatorEInstructionType_CSRRSI;
+        } else if (funct3 == 0b111) {
+            return XPEmulatorEInstructionType_CSRRCI;
+        }
+#endif
     }
 
     return -1;
@@ -198,6 +379,7 @@ xp_emulator_decoder_decode_instruction(uint32_t encodedInstruction)
 
     struct XPEmulatorEncodedInstruction instr = { 0 };
     instr.type                                = XPEmulatorEInstructionType_Undefined;
+    instr.size                                = 4;
 
     if (opcode == 0b0110111) {
         instr.type       = XPEmulatorEInstructionType_LUI;
@@ -606,6 +788,13 @@ xp_emulator_decoder_decode_instruction(uint32_t encodedInstruction)
         }
     }
     #endif
+#endif
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+    else if (is_fp_opcode(opcode)) {
+        // every FP format (FLOAD, FSTORE, FMA, FOP) overlays the raw encoding bit for bit
+        instr.type              = decode_fp_instruction_type(encodedInstruction);
+        instr.instruction.value = encodedInstruction;
+    }
 #endif
     else if (opcode == 0b0001111) {
         instr.type         = XPEmulatorEInstructionType_FENCE;
@@ -617,25 +806,243 @@ xp_emulator_decoder_decode_instruction(uint32_t encodedInstruction)
         instr.FENCE.pred   = (encodedInstruction >> 24) & 0b1111;
         instr.FENCE.fm     = (encodedInstruction >> 28) & 0b1111;
     } else if (opcode == 0b1110011) {
-        if (imm_11_0 == 0b000000000000) {
-            instr.type         = XPEmulatorEInstructionType_ECALL;
-            instr.ECALL.opcode = opcode;
-            instr.ECALL.rd     = rd;
-            instr.ECALL.funct3 = funct3;
-            instr.ECALL.rs1    = rs1;
-            instr.ECALL.imm    = imm_11_0;
-        } else if (imm_11_0 == 0b000000000001) {
-            instr.type          = XPEmulatorEInstructionType_EBREAK;
-            instr.EBREAK.opcode = opcode;
-            instr.EBREAK.rd     = rd;
-            instr.EBREAK.funct3 = funct3;
-            instr.EBREAK.rs1    = rs1;
-            instr.EBREAK.imm    = imm_11_0;
+        if (funct3 == 0b000) {
+            if (imm_11_0 == 0b000000000000) {
+                instr.type         = XPEmulatorEInstructionType_ECALL;
+                instr.ECALL.opcode = opcode;
+                instr.ECALL.rd     = rd;
+                instr.ECALL.funct3 = funct3;
+                instr.ECALL.rs1    = rs1;
+                instr.ECALL.imm    = imm_11_0;
+            } else if (imm_11_0 == 0b000000000001) {
+                instr.type          = XPEmulatorEInstructionType_EBREAK;
+                instr.EBREAK.opcode = opcode;
+                instr.EBREAK.rd     = rd;
+                instr.EBREAK.funct3 = funct3;
+                instr.EBREAK.rs1    = rs1;
+                instr.EBREAK.imm    = imm_11_0;
+            }
+        }
+#if defined(XP_EMULATOR_USE_ZICSR_EXTENSION)
+        else if (funct3 != 0b100) {
+            instr.type       = type;
+            instr.CSR.opcode = opcode;
+            instr.CSR.rd     = rd;
+            instr.CSR.funct3 = funct3;
+            instr.CSR.rs1    = rs1;
+            instr.CSR.csr    = imm_11_0;
+        }
+#endif
+    }
+
+    return instr;
+}
+
+#if defined(XP_EMULATOR_USE_C_EXTENSION)
+static uint32_t
+encode_r(uint32_t opcode, uint32_t rd, uint32_t funct3, uint32_t rs1, uint32_t rs2, uint32_t funct7)
+{
+    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+
+static uint32_t
+encode_i(uint32_t opcode, uint32_t rd, uint32_t funct3, uint32_t rs1, int32_t imm)
+{
+    return (((uint32_t)imm & 0xFFF) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+
+static uint32_t
+encode_s(uint32_t opcode, uint32_t funct3, uint32_t rs1, uint32_t rs2, int32_t imm)
+{
+    uint32_t u = (uint32_t)imm;
+    return (((u >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | ((u & 0x1F) << 7) | opcode;
+}
+
+static uint32_t
+encode_b(uint32_t funct3, uint32_t rs1, uint32_t rs2, int32_t imm)
+{
+    uint32_t u = (uint32_t)imm;
+    return (((u >> 12) & 0x1) << 31) | (((u >> 5) & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) |
+           (((u >> 1) & 0xF) << 8) | (((u >> 11) & 0x1) << 7) | 0b1100011;
+}
+
+static uint32_t
+encode_j(uint32_t rd, int32_t imm)
+{
+    uint32_t u = (uint32_t)imm;
+    return (((u >> 20) & 0x1) << 31) | (((u >> 1) & 0x3FF) << 21) | (((u >> 11) & 0x1) << 20) |
+           (((u >> 12) & 0xFF) << 12) | (rd << 7) | 0b1101111;
+}
+
+static int32_t
+sign_extend(uint32_t value, uint32_t bits)
+{
+    uint32_t shift = 32 - bits;
+    return (int32_t)(value << shift) >> shift;
+}
+
+// extracts inst[hi:lo] and places it at bit position `at`
+    #define XP_EMULATOR_CBITS(INST, HI, LO, AT) ((((INST) >> (LO)) & ((1U << ((HI) - (LO) + 1)) - 1)) << (AT))
+
+XP_EMULATOR_EXTERN uint32_t
+xp_emulator_decoder_expand_compressed_instruction(uint16_t encodedInstruction)
+{
+    uint32_t c        = encodedInstruction;
+    uint32_t quadrant = c & 0b11;
+    uint32_t funct3   = (c >> 13) & 0b111;
+    uint32_t rd       = (c >> 7) & 0b11111;  // also rs1 in CR / CI formats
+    uint32_t rs2      = (c >> 2) & 0b11111;  // CR / CSS formats
+    uint32_t rdp      = 8 + ((c >> 2) & 0b111); // rd' / rs2' in CIW / CL / CS formats
+    uint32_t rs1p     = 8 + ((c >> 7) & 0b111); // rs1' / rd' in CL / CS / CA / CB formats
+
+    if (quadrant == 0b00) {
+        // CL / CS word offsets: offset[5:3] = inst[12:10], offset[2] = inst[6], offset[6] = inst[5]
+        uint32_t offsetW =
+          XP_EMULATOR_CBITS(c, 12, 10, 3) | XP_EMULATOR_CBITS(c, 6, 6, 2) | XP_EMULATOR_CBITS(c, 5, 5, 6);
+        // CL / CS double offsets: offset[5:3] = inst[12:10], offset[7:6] = inst[6:5]
+        uint32_t offsetD = XP_EMULATOR_CBITS(c, 12, 10, 3) | XP_EMULATOR_CBITS(c, 6, 5, 6);
+        switch (funct3) {
+            case 0b000: {
+                // C.ADDI4SPN: nzuimm[5:4|9:6|2|3] = inst[12:11|10:7|6|5]
+                uint32_t imm = XP_EMULATOR_CBITS(c, 12, 11, 4) | XP_EMULATOR_CBITS(c, 10, 7, 6) |
+                               XP_EMULATOR_CBITS(c, 6, 6, 2) | XP_EMULATOR_CBITS(c, 5, 5, 3);
+                if (imm == 0) { return 0; }
+                return encode_i(0b0010011, rdp, 0b000, XPEmulatorEReg2, (int32_t)imm);
+            }
+            case 0b010: return encode_i(0b0000011, rdp, 0b010, rs1p, (int32_t)offsetW); // C.LW
+            case 0b110: return encode_s(0b0100011, 0b010, rs1p, rdp, (int32_t)offsetW); // C.SW
+    #if defined(XP_EMULATOR_USE_F_EXTENSION)
+            case 0b011: return encode_i(0b0000111, rdp, 0b010, rs1p, (int32_t)offsetW); // C.FLW
+            case 0b111: return encode_s(0b0100111, 0b010, rs1p, rdp, (int32_t)offsetW); // C.FSW
+    #endif
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+            case 0b001: return encode_i(0b0000111, rdp, 0b011, rs1p, (int32_t)offsetD); // C.FLD
+            case 0b101: return encode_s(0b0100111, 0b011, rs1p, rdp, (int32_t)offsetD); // C.FSD
+    #endif
+            default: (void)offsetD; return 0;
+        }
+    } else if (quadrant == 0b01) {
+        // CI immediate: imm[5] = inst[12], imm[4:0] = inst[6:2]
+        int32_t imm6 = sign_extend(XP_EMULATOR_CBITS(c, 12, 12, 5) | XP_EMULATOR_CBITS(c, 6, 2, 0), 6);
+        // CJ offset[11|4|9:8|10|6|7|3:1|5] = inst[12|11|10:9|8|7|6|5:3|2]
+        int32_t jumpOffset = sign_extend(XP_EMULATOR_CBITS(c, 12, 12, 11) | XP_EMULATOR_CBITS(c, 11, 11, 4) |
+                                           XP_EMULATOR_CBITS(c, 10, 9, 8) | XP_EMULATOR_CBITS(c, 8, 8, 10) |
+                                           XP_EMULATOR_CBITS(c, 7, 7, 6) | XP_EMULATOR_CBITS(c, 6, 6, 7) |
+                                           XP_EMULATOR_CBITS(c, 5, 3, 1) | XP_EMULATOR_CBITS(c, 2, 2, 5),
+                                         12);
+        // CB offset[8|4:3|7:6|2:1|5] = inst[12|11:10|6:5|4:3|2]
+        int32_t branchOffset = sign_extend(XP_EMULATOR_CBITS(c, 12, 12, 8) | XP_EMULATOR_CBITS(c, 11, 10, 3) |
+                                             XP_EMULATOR_CBITS(c, 6, 5, 6) | XP_EMULATOR_CBITS(c, 4, 3, 1) |
+                                             XP_EMULATOR_CBITS(c, 2, 2, 5),
+                                           9);
+        switch (funct3) {
+            case 0b000: return encode_i(0b0010011, rd, 0b000, rd, imm6);              // C.ADDI / C.NOP
+            case 0b001: return encode_j(XPEmulatorEReg1, jumpOffset);                  // C.JAL (RV32 only)
+            case 0b010: return encode_i(0b0010011, rd, 0b000, XPEmulatorEReg0, imm6); // C.LI
+            case 0b011: {
+                if (rd == XPEmulatorEReg2) {
+                    // C.ADDI16SP: nzimm[9] = inst[12], nzimm[4|6|8:7|5] = inst[6|5|4:3|2]
+                    int32_t imm = sign_extend(XP_EMULATOR_CBITS(c, 12, 12, 9) | XP_EMULATOR_CBITS(c, 6, 6, 4) |
+                                                XP_EMULATOR_CBITS(c, 5, 5, 6) | XP_EMULATOR_CBITS(c, 4, 3, 7) |
+                                                XP_EMULATOR_CBITS(c, 2, 2, 5),
+                                              10);
+                    if (imm == 0) { return 0; }
+                    return encode_i(0b0010011, XPEmulatorEReg2, 0b000, XPEmulatorEReg2, imm);
+                }
+                // C.LUI: nzimm[17] = inst[12], nzimm[16:12] = inst[6:2]
+                if (imm6 == 0) { return 0; }
+                return ((uint32_t)imm6 << 12) | (rd << 7) | 0b0110111;
+            }
+            case 0b100: {
+                uint32_t funct2 = (c >> 10) & 0b11;
+                if (funct2 == 0b00 || funct2 == 0b01) {
+                    // C.SRLI / C.SRAI, shamt[5] must be zero on RV32
+                    if (c & (1U << 12)) { return 0; }
+                    uint32_t shamt = (c >> 2) & 0b11111;
+                    return encode_i(0b0010011, rs1p, 0b101, rs1p, (int32_t)(shamt | (funct2 == 0b01 ? 0x400 : 0)));
+                } else if (funct2 == 0b10) {
+                    return encode_i(0b0010011, rs1p, 0b111, rs1p, imm6); // C.ANDI
+                } else if ((c & (1U << 12)) == 0) {
+                    switch ((c >> 5) & 0b11) {
+                        case 0b00: return encode_r(0b0110011, rs1p, 0b000, rs1p, rdp, 0b0100000); // C.SUB
+                        case 0b01: return encode_r(0b0110011, rs1p, 0b100, rs1p, rdp, 0b0000000); // C.XOR
+                        case 0b10: return encode_r(0b0110011, rs1p, 0b110, rs1p, rdp, 0b0000000); // C.OR
+                        default: return encode_r(0b0110011, rs1p, 0b111, rs1p, rdp, 0b0000000);   // C.AND
+                    }
+                }
+                return 0;
+            }
+            case 0b101: return encode_j(XPEmulatorEReg0, jumpOffset);                       // C.J
+            case 0b110: return encode_b(0b000, rs1p, XPEmulatorEReg0, branchOffset); // C.BEQZ
+            default: return encode_b(0b001, rs1p, XPEmulatorEReg0, branchOffset);    // C.BNEZ
+        }
+    } else if (quadrant == 0b10) {
+        // CI stack loads: offset[5] = inst[12]
+        // word offset[4:2|7:6] = inst[6:4|3:2], double offset[4:3|8:6] = inst[6:5|4:2]
+        uint32_t loadOffsetW =
+          XP_EMULATOR_CBITS(c, 12, 12, 5) | XP_EMULATOR_CBITS(c, 6, 4, 2) | XP_EMULATOR_CBITS(c, 3, 2, 6);
+        uint32_t loadOffsetD =
+          XP_EMULATOR_CBITS(c, 12, 12, 5) | XP_EMULATOR_CBITS(c, 6, 5, 3) | XP_EMULATOR_CBITS(c, 4, 2, 6);
+        // CSS stack stores: word offset[5:2|7:6] = inst[12:9|8:7], double offset[5:3|8:6] = inst[12:10|9:7]
+        uint32_t storeOffsetW = XP_EMULATOR_CBITS(c, 12, 9, 2) | XP_EMULATOR_CBITS(c, 8, 7, 6);
+        uint32_t storeOffsetD = XP_EMULATOR_CBITS(c, 12, 10, 3) | XP_EMULATOR_CBITS(c, 9, 7, 6);
+        (void)loadOffsetD;
+        (void)storeOffsetD;
+        switch (funct3) {
+            case 0b000: {
+                // C.SLLI, shamt[5] must be zero on RV32
+                if (c & (1U << 12)) { return 0; }
+                return encode_i(0b0010011, rd, 0b001, rd, (int32_t)rs2);
+            }
+            case 0b010: {
+                if (rd == XPEmulatorEReg0) { return 0; }
+                return encode_i(0b0000011, rd, 0b010, XPEmulatorEReg2, (int32_t)loadOffsetW); // C.LWSP
+            }
+            case 0b100: {
+                if ((c & (1U << 12)) == 0) {
+                    if (rs2 == 0) {
+                        if (rd == XPEmulatorEReg0) { return 0; }
+                        return encode_i(0b1100111, XPEmulatorEReg0, 0b000, rd, 0); // C.JR
+                    }
+                    return encode_r(0b0110011, rd, 0b000, XPEmulatorEReg0, rs2, 0); // C.MV
+                }
+                if (rs2 == 0) {
+                    if (rd == XPEmulatorEReg0) { return 0x00100073; } // C.EBREAK
+                    return encode_i(0b1100111, XPEmulatorEReg1, 0b000, rd, 0); // C.JALR
+                }
+                return encode_r(0b0110011, rd, 0b000, rd, rs2, 0); // C.ADD
+            }
+            case 0b110: return encode_s(0b0100011, 0b010, XPEmulatorEReg2, rs2, (int32_t)storeOffsetW); // C.SWSP
+    #if defined(XP_EMULATOR_USE_F_EXTENSION)
+            case 0b011: return encode_i(0b0000111, rd, 0b010, XPEmulatorEReg2, (int32_t)loadOffsetW);  // C.FLWSP
+            case 0b111: return encode_s(0b0100111, 0b010, XPEmulatorEReg2, rs2, (int32_t)storeOffsetW); // C.FSWSP
+    #endif
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+            case 0b001: return encode_i(0b0000111, rd, 0b011, XPEmulatorEReg2, (int32_t)loadOffsetD);  // C.FLDSP
+            case 0b101: return encode_s(0b0100111, 0b011, XPEmulatorEReg2, rs2, (int32_t)storeOffsetD); // C.FSDSP
+    #endif
+            default: return 0;
         }
     }
 
+    // quadrant 0b11 is a 32 bit encoding, not ours to expand
+    return 0;
+}
+
+    #undef XP_EMULATOR_CBITS
+
+XP_EMULATOR_EXTERN struct XPEmulatorEncodedInstruction
+xp_emulator_decoder_decode_compressed_instruction(uint16_t encodedInstruction)
+{
+    uint32_t expanded = xp_emulator_decoder_expand_compressed_instruction(encodedInstruction);
+
+    struct XPEmulatorEncodedInstruction instr = { 0 };
+    instr.type                                = XPEmulatorEInstructionType_Undefined;
+    if (expanded != 0) { instr = xp_emulator_decoder_decode_instruction(expanded); }
+    instr.size = 2;
     return instr;
 }
+#endif
 
 //XP_EMULATOR_EXTERN uint32_t
 //imm_I(struct XPEmulatorEncodedInstruction instr)
@@ -9,6 +9,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#if defined(_WIN32) || defined(_WIN64)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
 
 // ELF constants
 #define EI_MAG0    0
@@ -48,6 +56,12 @@
 #define PF_W 2
 #define PF_R 4
 
+#define SHT_SYMTAB 2
+
+#define STT_FUNC 2
+
+#define ELF_ST_TYPE(info) ((info) & 0xf)
+
 // ELF header structures
 typedef struct
 {
@@ -110,6 +124,56 @@ typedef struct
     uint64_t p_align;
 } Elf64_Phdr;
 
+// Section header structures
+typedef struct
+{
+    uint32_t sh_name;
+    uint32_t sh_type;
+    uint32_t sh_flags;
+    uint32_t sh_addr;
+    uint32_t sh_offset;
+    uint32_t sh_size;
+    uint32_t sh_link;
+    uint32_t sh_info;
+    uint32_t sh_addralign;
+    uint32_t sh_entsize;
+} Elf32_Shdr;
+
+typedef struct
+{
+    uint32_t sh_name;
+    uint32_t sh_type;
+    uint64_t sh_flags;
+    uint64_t sh_addr;
+    uint64_t sh_offset;
+    uint64_t sh_size;
+    uint32_t sh_link;
+    uint32_t sh_info;
+    uint64_t sh_addralign;
+    uint64_t sh_entsize;
+} Elf64_Shdr;
+
+// Symbol table structures
+typedef struct
+{
+    uint32_t      st_name;
+    uint32_t      st_value;
+    uint32_t      st_size;
+    unsigned char st_info;
+    unsigned char st_other;
+    uint16_t      st_shndx;
+} Elf32_Sym;
+
+typedef struct
+{
+    uint32_t      st_name;
+    unsigned char st_info;
+    unsigned char st_other;
+    uint16_t      st_shndx;
+    uint64_t      st_value;
+    uint64_t      st_size;
+} Elf64_Sym;
+
 // Byte swapping functions
 static uint16_t
 swap16(uint16_t value)
@@ -172,56 +236,93 @@ elf_loader_create(const char* filename)
     return loader;
 }
 
+// Unmap the file, every segment view and the symbol names die with it
+static void
+unmap_file(RiscvElfLoader* loader)
+{
+    if (!loader->file_data) { return; }
+#if defined(_WIN32) || defined(_WIN64)
+    UnmapViewOfFile((LPCVOID)loader->file_data);
+#else
+    munmap((void*)loader->file_data, loader->file_size);
+#endif
+    loader->file_data = NULL;
+    loader->file_size = 0;
+}
+
 // Free the ELF loader
 static void
 elf_loader_destroy(RiscvElfLoader* loader)
 {
     if (!loader) return;
 
-    // Free segments
-    for (int i = 0; i < loader->num_segments; i++) {
-        if (loader->segments[i].data) { free(loader->segments[i].data); }
-    }
+    unmap_file(loader);
 
-    if (loader->file_data) { free(loader->file_data); }
+    if (loader->symbols) { free(loader->symbols); }
 
     if (loader->filename) { free(loader->filename); }
 
     free(loader);
 }
 
-// Load file into memory
+// Map the whole file read only, the pages are shared with every other mapping of the same binary
 static bool
-load_file(RiscvElfLoader* loader)
+map_file(RiscvElfLoader* loader)
 {
-    FILE* file = fopen(loader->filename, "rb");
-    if (!file) {
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE file = CreateFileA(
+      loader->filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
         fprintf(stderr, "Failed to open file: %s\n", loader->filename);
         return false;
     }
 
-    // Get file size
-    fseek(file, 0, SEEK_END);
-    loader->file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < EI_NIDENT) {
+        fprintf(stderr, "File too small to be valid ELF\n");
+        CloseHandle(file);
+        return false;
+    }
 
-    // Allocate memory
-    loader->file_data = malloc(loader->file_size);
-    if (!loader->file_data) {
-        fprintf(stderr, "Failed to allocate memory for file\n");
-        fclose(file);
+    // the view keeps the section and the file alive
+    HANDLE section = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!section) {
+        fprintf(stderr, "Failed to map file: %s\n", loader->filename);
+        return false;
+    }
+    void* view = MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(section);
+    if (!view) {
+        fprintf(stderr, "Failed to map file: %s\n", loader->filename);
+        return false;
+    }
+    loader->file_size = (size_t)size.QuadPart;
+#else
+    int file = open(loader->filename, O_RDONLY);
+    if (file < 0) {
+        fprintf(stderr, "Failed to open file: %s\n", loader->filename);
         return false;
     }
 
-    // Read file
-    size_t bytes_read = fread(loader->file_data, 1, loader->file_size, file);
-    fclose(file);
+    struct stat st;
+    if (fstat(file, &st) != 0 || st.st_size < EI_NIDENT) {
+        fprintf(stderr, "File too small to be valid ELF\n");
+        close(file);
+        return false;
+    }
 
-    if (bytes_read != loader->file_size) {
-        fprintf(stderr, "Failed to read complete file\n");
+    // the mapping holds its own reference to the file
+    void* view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED) {
+        fprintf(stderr, "Failed to map file: %s\n", loader->filename);
         return false;
     }
+    loader->file_size = (size_t)st.st_size;
+#endif
 
+    loader->file_data = (const uint8_t*)view;
     return true;
 }
 
@@ -234,7 +335,7 @@ validate_elf_header(RiscvElfLoader* loader)
         return false;
     }
 
-    uint8_t* ident = loader->file_data;
+    const uint8_t* ident = loader->file_data;
 
     // Check ELF magic
     if (ident[EI_MAG0] != ELFMAG0 || ident[EI_MAG1] != ELFMAG1 || ident[EI_MAG2] != ELFMAG2 ||
@@ -263,19 +364,19 @@ validate_elf_header(RiscvElfLoader* loader)
 
 // Parse 32-bit program headers
 static bool
-parse_program_headers_32(RiscvElfLoader* loader, Elf32_Ehdr* header)
+parse_program_headers_32(RiscvElfLoader* loader, const Elf32_Ehdr* header)
 {
     uint32_t phoff     = fix_endian32(loader, header->e_phoff);
     uint16_t phnum     = fix_endian16(loader, header->e_phnum);
     uint16_t phentsize = fix_endian16(loader, header->e_phentsize);
 
-    if (phoff + phnum * phentsize > loader->file_size) {
+    if ((uint64_t)phoff + (uint64_t)phnum * phentsize > loader->file_size) {
         fprintf(stderr, "Program headers extend beyond file size\n");
         return false;
     }
 
     for (int i = 0; i < phnum && loader->num_segments < MAX_SEGMENTS; i++) {
-        Elf32_Phdr* phdr = (Elf32_Phdr*)(loader->file_data + phoff + i * phentsize);
+        const Elf32_Phdr* phdr = (const Elf32_Phdr*)(loader->file_data + phoff + i * phentsize);
 
         uint32_t type = fix_endian32(loader, phdr->p_type);
         if (type == PT_LOAD) {
@@ -285,7 +386,7 @@ parse_program_headers_32(RiscvElfLoader* loader, Elf32_Ehdr* header)
             uint32_t offset = fix_endian32(loader, phdr->p_offset);
             uint32_t flags  = fix_endian32(loader, phdr->p_flags);
 
-            if (offset + filesz > loader->file_size) {
+            if (offset > loader->file_size || filesz > loader->file_size - offset || filesz > memsz) {
                 fprintf(stderr, "Segment extends beyond file size\n");
                 return false;
             }
@@ -293,19 +394,9 @@ parse_program_headers_32(RiscvElfLoader* loader, Elf32_Ehdr* header)
             MemorySegment* segment = &loader->segments[loader->num_segments];
             segment->vaddr         = vaddr;
             segment->size          = memsz;
+            segment->file_size     = filesz;
             segment->flags         = flags;
-            segment->data          = malloc(memsz);
-
-            if (!segment->data) {
-                fprintf(stderr, "Failed to allocate segment memory\n");
-                return false;
-            }
-
-            // Initialize with zeros
-            memset(segment->data, 0, memsz);
-
-            // Copy file data
-            if (filesz > 0) { memcpy(segment->data, loader->file_data + offset, filesz); }
+            segment->data          = loader->file_data + offset;
 
             loader->num_segments++;
 
@@ -318,19 +409,19 @@ parse_program_headers_32(RiscvElfLoader* loader, Elf32_Ehdr* header)
 
 // Parse 64-bit program headers
 static bool
-parse_program_headers_64(RiscvElfLoader* loader, Elf64_Ehdr* header)
+parse_program_headers_64(RiscvElfLoader* loader, const Elf64_Ehdr* header)
 {
     uint64_t phoff     = fix_endian64(loader, header->e_phoff);
     uint16_t phnum     = fix_endian16(loader, header->e_phnum);
     uint16_t phentsize = fix_endian16(loader, header->e_phentsize);
 
-    if (phoff + phnum * phentsize > loader->file_size) {
+    if ((uint64_t)phoff + (uint64_t)phnum * phentsize > loader->file_size) {
         fprintf(stderr, "Program headers extend beyond file size\n");
         return false;
     }
 
     for (int i = 0; i < phnum && loader->num_segments < MAX_SEGMENTS; i++) {
-        Elf64_Phdr* phdr = (Elf64_Phdr*)(loader->file_data + phoff + i * phentsize);
+        const Elf64_Phdr* phdr = (const Elf64_Phdr*)(loader->file_data + phoff + i * phentsize);
 
         uint32_t type = fix_endian32(loader, phdr->p_type);
         if (type == PT_LOAD) {
@@ -340,7 +431,7 @@ parse_program_headers_64(RiscvElfLoader* loader, Elf64_Ehdr* header)
             uint64_t offset = fix_endian64(loader, phdr->p_offset);
             uint32_t flags  = fix_endian32(loader, phdr->p_flags);
 
-            if (offset + filesz > loader->file_size) {
+            if (offset > loader->file_size || filesz > loader->file_size - offset || filesz > memsz) {
                 fprintf(stderr, "Segment extends beyond file size\n");
                 return false;
             }
@@ -348,23 +439,137 @@ parse_program_headers_64(RiscvElfLoader* loader, Elf64_Ehdr* header)
             MemorySegment* segment = &loader->segments[loader->num_segments];
             segment->vaddr         = vaddr;
             segment->size          = memsz;
+            segment->file_size     = filesz;
             segment->flags         = flags;
-            segment->data          = malloc(memsz);
+            segment->data          = loader->file_data + offset;
 
-            if (!segment->data) {
-                fprintf(stderr, "Failed to allocate segment memory\n");
-                return false;
-            }
+            loader->num_segments++;
 
-            // Initialize with zeros
-            memset(segment->data, 0, memsz);
+            printf("Loaded segment: VA=0x%llx, size=0x%llx, flags=0x%x\n", vaddr, memsz, flags);
+        }
+    }
 
-            // Copy file data
-            if (filesz > 0) { memcpy(segment->data, loader->file_data + offset, filesz); }
+    return true;
+}
 
-            loader->num_segments++;
+static int
+compare_symbols(const void* a, const void* b)
+{
+    const ElfSymbol* lhs = (const ElfSymbol*)a;
+    const ElfSymbol* rhs = (const ElfSymbol*)b;
+    return (lhs->address > rhs->address) - (lhs->address < rhs->address);
+}
 
-            printf("Loaded segment: VA=0x%llx, size=0x%llx, flags=0x%x\n", vaddr, memsz, flags);
+// Copy the linked string table and collect the function symbols of a symbol table section
+static bool
+collect_function_symbols(RiscvElfLoader* loader,
+                         uint64_t        symoff,
+                         uint64_t        symsize,
+                         uint64_t        symentsize,
+                         uint64_t        stroff,
+                         uint64_t        strsize)
+{
+    if (symentsize == 0 || symoff + symsize > loader->file_size || stroff + strsize > loader->file_size) {
+        fprintf(stderr, "Symbol table extends beyond file size\n");
+        return false;
+    }
+    // names are used in place, a terminated table keeps every one of them inside the mapping
+    if (strsize == 0 || loader->file_data[stroff + strsize - 1] != '\0') {
+        fprintf(stderr, "Symbol string table is not terminated\n");
+        return false;
+    }
+
+    uint64_t count = symsize / symentsize;
+
+    loader->symbol_names = (const char*)(loader->file_data + stroff);
+    loader->symbols      = malloc(sizeof(ElfSymbol) * (count > 0 ? count : 1));
+    if (!loader->symbols) {
+        fprintf(stderr, "Failed to allocate symbol table memory\n");
+        return false;
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        const uint8_t* entry = loader->file_data + symoff + i * symentsize;
+        uint32_t       name;
+        uint8_t        info;
+        uint64_t       value;
+        uint64_t       size;
+        if (loader->is_64bit) {
+            const Elf64_Sym* sym = (const Elf64_Sym*)entry;
+            name                 = fix_endian32(loader, sym->st_name);
+            info                 = sym->st_info;
+            value                = fix_endian64(loader, sym->st_value);
+            size                 = fix_endian64(loader, sym->st_size);
+        } else {
+            const Elf32_Sym* sym = (const Elf32_Sym*)entry;
+            name                 = fix_endian32(loader, sym->st_name);
+            info                 = sym->st_info;
+            value                = fix_endian32(loader, sym->st_value);
+            size                 = fix_endian32(loader, sym->st_size);
+        }
+
+        if (ELF_ST_TYPE(info) != STT_FUNC || name >= strsize) { continue; }
+
+        ElfSymbol* symbol = &loader->symbols[loader->num_symbols++];
+        symbol->address   = value;
+        symbol->size      = size;
+        symbol->name      = loader->symbol_names + name;
+    }
+
+    qsort(loader->symbols, loader->num_symbols, sizeof(ElfSymbol), compare_symbols);
+
+    return true;
+}
+
+// Parse the function symbols out of .symtab, a stripped binary simply has none
+static bool
+parse_symbols(RiscvElfLoader* loader)
+{
+    uint64_t shoff;
+    uint16_t shnum;
+    uint16_t shentsize;
+    if (loader->is_64bit) {
+        const Elf64_Ehdr* header = (const Elf64_Ehdr*)loader->file_data;
+        shoff              = fix_endian64(loader, header->e_shoff);
+        shnum              = fix_endian16(loader, header->e_shnum);
+        shentsize          = fix_endian16(loader, header->e_shentsize);
+    } else {
+        const Elf32_Ehdr* header = (const Elf32_Ehdr*)loader->file_data;
+        shoff              = fix_endian32(loader, header->e_shoff);
+        shnum              = fix_endian16(loader, header->e_shnum);
+        shentsize          = fix_endian16(loader, header->e_shentsize);
+    }
+
+    if (shoff == 0 || shnum == 0) { return true; }
+    if (shoff + (uint64_t)shnum * shentsize > loader->file_size) {
+        fprintf(stderr, "Section headers extend beyond file size\n");
+        return false;
+    }
+
+    for (int i = 0; i < shnum; i++) {
+        const uint8_t* section = loader->file_data + shoff + i * shentsize;
+        if (loader->is_64bit) {
+            const Elf64_Shdr* shdr = (const Elf64_Shdr*)section;
+            uint32_t          link = fix_endian32(loader, shdr->sh_link);
+            if (fix_endian32(loader, shdr->sh_type) != SHT_SYMTAB || link >= shnum) { continue; }
+            const Elf64_Shdr* strtab = (const Elf64_Shdr*)(loader->file_data + shoff + link * shentsize);
+            return collect_function_symbols(loader,
+                                            fix_endian64(loader, shdr->sh_offset),
+                                            fix_endian64(loader, shdr->sh_size),
+                                            fix_endian64(loader, shdr->sh_entsize),
+                                            fix_endian64(loader, strtab->sh_offset),
+                                            fix_endian64(loader, strtab->sh_size));
+        } else {
+            const Elf32_Shdr* shdr = (const Elf32_Shdr*)section;
+            uint32_t          link = fix_endian32(loader, shdr->sh_link);
+            if (fix_endian32(loader, shdr->sh_type) != SHT_SYMTAB || link >= shnum) { continue; }
+            const Elf32_Shdr* strtab = (const Elf32_Shdr*)(loader->file_data + shoff + link * shentsize);
+            return collect_function_symbols(loader,
+                                            fix_endian32(loader, shdr->sh_offset),
+                                            fix_endian32(loader, shdr->sh_size),
+                                            fix_endian32(loader, shdr->sh_entsize),
+                                            fix_endian32(loader, strtab->sh_offset),
+                                            fix_endian32(loader, strtab->sh_size));
         }
     }
 
@@ -381,7 +586,7 @@ parse_elf_header(RiscvElfLoader* loader)
             return false;
         }
 
-        Elf64_Ehdr* header = (Elf64_Ehdr*)loader->file_data;
+        const Elf64_Ehdr* header = (const Elf64_Ehdr*)loader->file_data;
 
         if (fix_endian16(loader, header->e_machine) != EM_RISCV) {
             fprintf(stderr, "Not a RISC-V binary (machine type: %d)\n", fix_endian16(loader, header->e_machine));
@@ -396,7 +601,7 @@ parse_elf_header(RiscvElfLoader* loader)
             return false;
         }
 
-        Elf32_Ehdr* header = (Elf32_Ehdr*)loader->file_data;
+        const Elf32_Ehdr* header = (const Elf32_Ehdr*)loader->file_data;
 
         if (fix_endian16(loader, header->e_machine) != EM_RISCV) {
             fprintf(stderr, "Not a RISC-V binary (machine type: %d)\n", fix_endian16(loader, header->e_machine));
@@ -412,12 +617,14 @@ parse_elf_header(RiscvElfLoader* loader)
 static bool
 elf_loader_load(RiscvElfLoader* loader)
 {
-    if (!load_file(loader)) { return false; }
+    if (!map_file(loader)) { return false; }
 
     if (!validate_elf_header(loader)) { return false; }
 
     if (!parse_elf_header(loader)) { return false; }
 
+    if (!parse_symbols(loader)) { return false; }
+
     return true;
 }
 
@@ -435,8 +642,12 @@ elf_loader_read_memory(const RiscvElfLoader* loader, uint64_t address, void* buf
     for (int i = 0; i < loader->num_segments; i++) {
         const MemorySegment* segment = &loader->segments[i];
         if (address >= segment->vaddr && address + size <= segment->vaddr + segment->size) {
-            size_t offset = address - segment->vaddr;
-            memcpy(buffer, segment->data + offset, size);
+            // bytes past the file backed part are zero
+            uint64_t offset = address - segment->vaddr;
+            uint64_t backed = offset < segment->file_size ? segment->file_size - offset : 0;
+            if (backed > size) { backed = size; }
+            memcpy(buffer, segment->data + offset, (size_t)backed);
+            memset((uint8_t*)buffer + backed, 0, size - (size_t)backed);
             return true;
         }
     }
@@ -467,6 +678,7 @@ elf_loader_print_info(const RiscvElfLoader* loader)
     printf("Machine: RISC-V\n");
     printf("Entry point: 0x%llx\n", loader->entry_point);
     printf("Loadable segments: %d\n", loader->num_segments);
+    printf("Function symbols: %d\n", loader->num_symbols);
 
     printf("\nMemory segments:\n");
     for (int i = 0; i < loader->num_segments; i++) {
@@ -525,3 +737,27 @@ xp_emulator_elf_loader_unload(RiscvElfLoader* loader)
 {
     elf_loader_destroy(loader);
 }
+
+XP_EMULATOR_EXTERN const ElfSymbol*
+xp_emulator_elf_loader_find_symbol(const RiscvElfLoader* loader, uint64_t address)
+{
+    // last symbol starting at or before address
+    int low  = 0;
+    int high = loader->num_symbols - 1;
+    int best = -1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        if (loader->symbols[mid].address <= address) {
+            best = mid;
+            low  = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    if (best < 0) { return NULL; }
+
+    const ElfSymbol* symbol = &loader->symbols[best];
+    // zero sized symbols (hand written assembly) own everything up to the next symbol
+    if (symbol->size != 0 && address >= symbol->address + symbol->size) { return NULL; }
+    return symbol;
+}
@@ -0,0 +1,175 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Emulator/XPEmulatorFileMapping.h>
+#include <Emulator/XPEmulatorLogger.h>
+
+#include <string.h>
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <io.h>
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+static uint64_t
+host_file_size(FILE* file)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx((HANDLE)_get_osfhandle(_fileno(file)), &size)) { return 0; }
+    return (uint64_t)size.QuadPart;
+#else
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0) { return 0; }
+    return (uint64_t)st.st_size;
+#endif
+}
+
+static uint64_t
+host_mapping_granularity(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (uint64_t)info.dwAllocationGranularity;
+#else
+    return (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+static void*
+host_map(FILE* file, uint64_t alignedOffset, uint64_t length)
+{
+#if defined(_WIN32)
+    HANDLE section = CreateFileMappingW((HANDLE)_get_osfhandle(_fileno(file)), NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!section) { return NULL; }
+    void* view = MapViewOfFile(
+      section, FILE_MAP_READ, (DWORD)(alignedOffset >> 32), (DWORD)(alignedOffset & 0xFFFFFFFF), (SIZE_T)length);
+    // the view keeps the section alive
+    CloseHandle(section);
+    return view;
+#else
+    void* view = mmap(NULL, (size_t)length, PROT_READ, MAP_PRIVATE, fileno(file), (off_t)alignedOffset);
+    return view == MAP_FAILED ? NULL : view;
+#endif
+}
+
+static void
+host_unmap(void* view, uint64_t length)
+{
+#if defined(_WIN32)
+    (void)length;
+    UnmapViewOfFile(view);
+#else
+    munmap(view, (size_t)length);
+#endif
+}
+
+static XPEmulatorFileMappingSlot*
+find_slot(XPEmulatorFileMapping* mapping, uint32_t address)
+{
+    if (address < XP_EMULATOR_CONFIG_FILE_MAPPING_BASE || address >= XP_EMULATOR_CONFIG_FILE_MAPPING_END) {
+        return NULL;
+    }
+    XPEmulatorFileMappingSlot* slot =
+      &mapping->slots[(address - XP_EMULATOR_CONFIG_FILE_MAPPING_BASE) / XP_EMULATOR_CONFIG_FILE_MAPPING_SLOT_SIZE];
+    return slot->view ? slot : NULL;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_file_mapping_initialize(XPEmulatorFileMapping* mapping)
+{
+    memset(mapping->slots, 0, sizeof(mapping->slots));
+}
+
+XP_EMULATOR_EXTERN uint32_t
+xp_emulator_file_mapping_map(XPEmulatorFileMapping* mapping, FILE* file, uint64_t offset, uint32_t length)
+{
+    // pages past the end of the file can't be touched on the host, clamp the guest view to what exists
+    uint64_t fileSize = host_file_size(file);
+    if (offset >= fileSize) { return 0; }
+    if (length > fileSize - offset) { length = (uint32_t)(fileSize - offset); }
+    if (length == 0 || length > XP_EMULATOR_CONFIG_FILE_MAPPING_SLOT_SIZE) { return 0; }
+
+    for (uint32_t i = 0; i < XP_EMULATOR_CONFIG_FILE_MAPPING_MAX_SLOTS; ++i) {
+        XPEmulatorFileMappingSlot* slot = &mapping->slots[i];
+        if (slot->view) { continue; }
+
+        uint64_t alignedOffset = offset - (offset % host_mapping_granularity());
+        uint64_t viewLength    = (offset - alignedOffset) + length;
+        void*    view          = host_map(file, alignedOffset, viewLength);
+        if (!view) {
+            XP_EMULATOR_LOGV("Failed to map %u bytes at offset %llu", length, (unsigned long long)offset);
+            return 0;
+        }
+        slot->view       = view;
+        slot->viewLength = viewLength;
+        slot->data       = (uint8_t*)view + (offset - alignedOffset);
+        slot->length     = length;
+        return XP_EMULATOR_CONFIG_FILE_MAPPING_BASE + i * XP_EMULATOR_CONFIG_FILE_MAPPING_SLOT_SIZE;
+    }
+    return 0;
+}
+
+XP_EMULATOR_EXTERN int
+xp_emulator_file_mapping_unmap(XPEmulatorFileMapping* mapping, uint32_t address)
+{
+    XPEmulatorFileMappingSlot* slot = find_slot(mapping, address);
+    if (!slot || (address - XP_EMULATOR_CONFIG_FILE_MAPPING_BASE) % XP_EMULATOR_CONFIG_FILE_MAPPING_SLOT_SIZE != 0) {
+        return -1;
+    }
+    host_unmap(slot->view, slot->viewLength);
+    memset(slot, 0, sizeof(*slot));
+    return 0;
+}
+
+XP_EMULATOR_EXTERN uint32_t
+xp_emulator_file_mapping_load(XPEmulatorFileMapping* mapping, uint32_t address, uint32_t size)
+{
+    XPEmulatorFileMappingSlot* slot = find_slot(mapping, address);
+    if (!slot) {
+        XP_EMULATOR_LOGV("Load from unmapped file window 0x%08x", address);
+        return 0;
+    }
+    uint32_t offset = (address - XP_EMULATOR_CONFIG_FILE_MAPPING_BASE) % XP_EMULATOR_CONFIG_FILE_MAPPING_SLOT_SIZE;
+    uint32_t value  = 0;
+    for (uint32_t i = 0; i < size / 8; ++i) {
+        if (offset + i < slot->length) { value |= (uint32_t)slot->data[offset + i] << (i * 8); }
+    }
+    return value;
+}
+
+XP_EMULATOR_EXTERN const uint8_t*
+xp_emulator_file_mapping_translate(XPEmulatorFileMapping* mapping, uint32_t address, uint32_t length)
+{
+    XPEmulatorFileMappingSlot* slot = find_slot(mapping, address);
+    if (!slot) { return NULL; }
+    uint32_t offset = (address - XP_EMULATOR_CONFIG_FILE_MAPPING_BASE) % XP_EMULATOR_CONFIG_FILE_MAPPING_SLOT_SIZE;
+    if (offset > slot->length || length > slot->length - offset) { return NULL; }
+    return slot->data + offset;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_file_mapping_finalize(XPEmulatorFileMapping* mapping)
+{
+    for (uint32_t i = 0; i < XP_EMULATOR_CONFIG_FILE_MAPPING_MAX_SLOTS; ++i) {
+        XPEmulatorFileMappingSlot* slot = &mapping->slots[i];
+        if (slot->view) { host_unmap(slot->view, slot->viewLength); }
+    }
+    memset(mapping->slots, 0, sizeof(mapping->slots));
+}
@@ -13,15 +13,76 @@
 /// --------------------------------------------------------------------------------------
 
 #include <Emulator/XPEmulatorHostMappedMemory.h>
+#include <Emulator/XPEmulatorLogger.h>
+#include <Emulator/XPEmulatorMemory.h>
 
 #include <assert.h>
 #include <stdlib.h>
 #include <string.h>
 
+typedef void (*XPEmulatorHostMappedMemoryHandler)(XPEmulatorHostMappedMemory* memory);
+
+// returns 0 when the descriptor addresses anything outside of guest memory or its host buffer
+typedef int (*XPEmulatorDMATransfer)(XPEmulatorHostMappedMemory* memory,
+                                     uint32_t                    src,
+                                     uint32_t                    dst,
+                                     uint32_t                    length,
+                                     uint32_t                    slot);
+
+typedef struct XPEmulatorHostMappedMemoryTrigger
+{
+    uint32_t                          address;
+    XPEmulatorHostMappedMemoryHandler onStore;
+} XPEmulatorHostMappedMemoryTrigger;
+
+static void
+dispatch_command(XPEmulatorHostMappedMemory* memory);
+
+static void
+read_device_pointers(XPEmulatorHostMappedMemory* memory);
+
+static void
+dma_submit(XPEmulatorHostMappedMemory* memory);
+
+static int
+dma_copy(XPEmulatorHostMappedMemory* memory, uint32_t src, uint32_t dst, uint32_t length, uint32_t slot);
+
+static int
+dma_fill(XPEmulatorHostMappedMemory* memory, uint32_t src, uint32_t dst, uint32_t length, uint32_t slot);
+
+static int
+dma_host_read(XPEmulatorHostMappedMemory* memory, uint32_t src, uint32_t dst, uint32_t length, uint32_t slot);
+
+static int
+dma_host_write(XPEmulatorHostMappedMemory* memory, uint32_t src, uint32_t dst, uint32_t length, uint32_t slot);
+
+// registers with a side effect when the guest stores to them
+static const XPEmulatorHostMappedMemoryTrigger triggers[] = {
+    { XP_EMULATOR_CONFIG_HMM_BASE, dispatch_command },
+    { XP_EMULATOR_CONFIG_HMM_DMA_DOORBELL_PTR, dma_submit },
+};
+
+// indexed by the value stored to the command register, 0x2 - 0x9 belong to the mesh streaming protocol which the
+// host does not serve, DMA replaces it
+static const XPEmulatorHostMappedMemoryHandler commands[] = {
+    NULL,                 // 0x0
+    read_device_pointers, // 0x1
+};
+
+// indexed by kind[7:0]
+static const XPEmulatorDMATransfer dmaTransfers[] = {
+    dma_copy,       // XP_EMULATOR_CONFIG_HMM_DMA_KIND_COPY
+    dma_fill,       // XP_EMULATOR_CONFIG_HMM_DMA_KIND_FILL
+    dma_host_read,  // XP_EMULATOR_CONFIG_HMM_DMA_KIND_HOST_READ
+    dma_host_write, // XP_EMULATOR_CONFIG_HMM_DMA_KIND_HOST_WRITE
+};
+
 XP_EMULATOR_EXTERN void
 xp_emulator_host_mapped_memory_initialize(XPEmulatorHostMappedMemory* memory)
 {
     memset(memory->data, 0, XP_EMULATOR_CONFIG_HMM_SIZE);
+    memset(memory->dmaHostBuffers, 0, sizeof(memory->dmaHostBuffers));
+    memory->guestMemory = NULL;
 }
 
 XP_EMULATOR_EXTERN uint32_t
@@ -73,22 +134,10 @@ xp_emulator_host_mapped_memory_store(XPEmulatorHostMappedMemory* memory,
 
         default: assert(0 && "Unreachable"); break;
     }
-    if (mem_address == 0) {
-        uint32_t memVal = *((uint32_t*)&memory->data[mem_address]);
-        // we have requested a read here, lets do that now
-        if (memVal == 0x1) {
-            memory->deviceBottomStack =
-              xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_BOTTOM_STACK_PTR, 32);
-            memory->deviceTopStack =
-              xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_TOP_STACK_PTR, 32);
-            memory->deviceStartHeap =
-              xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_START_HEAP_PTR, 32);
-            memory->deviceEndHeap =
-              xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_END_HEAP_PTR, 32);
-            memory->deviceFramebuffer =
-              xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_FRAMEBUFFER_PTR, 32);
-            memory->deviceFrameMemoryPool =
-              xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_FRAMEMEMPOOL_PTR, 32);
+    for (size_t i = 0; i < sizeof(triggers) / sizeof(triggers[0]); ++i) {
+        if (triggers[i].address == address) {
+            triggers[i].onStore(memory);
+            break;
         }
     }
 }
@@ -96,4 +145,145 @@ xp_emulator_host_mapped_memory_store(XPEmulatorHostMappedMemory* memory,
 XP_EMULATOR_EXTERN void
 xp_emulator_host_mapped_memory_finalize(XPEmulatorHostMappedMemory* memory)
 {
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_host_mapped_memory_bind_dma_buffer(XPEmulatorHostMappedMemory* memory,
+                                               uint32_t                    slot,
+                                               void*                       data,
+                                               uint32_t                    size,
+                                               uint32_t                    writable)
+{
+    assert(slot < XP_EMULATOR_CONFIG_HMM_DMA_MAX_HOST_BUFFERS);
+    memory->dmaHostBuffers[slot].data     = (uint8_t*)data;
+    memory->dmaHostBuffers[slot].size     = data ? size : 0;
+    memory->dmaHostBuffers[slot].writable = writable;
+}
+
+static uint32_t
+read_le32(const uint8_t* bytes)
+{
+    return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+static void
+write_register(XPEmulatorHostMappedMemory* memory, uint32_t address, uint32_t value)
+{
+    // straight into the backing store, going through store would re-run the triggers
+    uint8_t* bytes = &memory->data[address - XP_EMULATOR_CONFIG_HMM_BASE];
+    bytes[0]       = (uint8_t)(value & 0xff);
+    bytes[1]       = (uint8_t)((value >> 8) & 0xff);
+    bytes[2]       = (uint8_t)((value >> 16) & 0xff);
+    bytes[3]       = (uint8_t)((value >> 24) & 0xff);
+}
+
+static void
+dispatch_command(XPEmulatorHostMappedMemory* memory)
+{
+    uint32_t command = xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_BASE, 32);
+    if (command < sizeof(commands) / sizeof(commands[0]) && commands[command]) { commands[command](memory); }
+}
+
+static void
+read_device_pointers(XPEmulatorHostMappedMemory* memory)
+{
+    memory->deviceBottomStack =
+      xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_BOTTOM_STACK_PTR, 32);
+    memory->deviceTopStack = xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_TOP_STACK_PTR, 32);
+    memory->deviceStartHeap =
+      xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_START_HEAP_PTR, 32);
+    memory->deviceEndHeap = xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_END_HEAP_PTR, 32);
+    memory->deviceFramebuffer =
+      xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_FRAMEBUFFER_PTR, 32);
+    memory->deviceFrameMemoryPool =
+      xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_FRAMEMEMPOOL_PTR, 32);
+}
+
+static void
+dma_submit(XPEmulatorHostMappedMemory* memory)
+{
+    uint32_t descriptors = xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_DMA_DESCRIPTORS_PTR, 32);
+    uint32_t count       = xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_DMA_COUNT_PTR, 32);
+    uint32_t completed   = xp_emulator_host_mapped_memory_load(memory, XP_EMULATOR_CONFIG_HMM_DMA_COMPLETED_PTR, 32);
+
+    write_register(memory, XP_EMULATOR_CONFIG_HMM_DMA_STATUS_PTR, XP_EMULATOR_CONFIG_HMM_DMA_STATUS_BUSY);
+
+    // the whole run is validated once, each descriptor is 4 words
+    const uint8_t* run = NULL;
+    if (memory->guestMemory && count <= UINT32_MAX / 16) {
+        run = xp_emulator_memory_translate(memory->guestMemory, descriptors, count * 16, 0);
+    }
+
+    uint32_t status = run ? XP_EMULATOR_CONFIG_HMM_DMA_STATUS_DONE : XP_EMULATOR_CONFIG_HMM_DMA_STATUS_ERROR;
+    for (uint32_t i = 0; run && i < count; ++i) {
+        const uint8_t* descriptor = run + i * 16;
+        uint32_t       src        = read_le32(descriptor + 0);
+        uint32_t       dst        = read_le32(descriptor + 4);
+        uint32_t       length     = read_le32(descriptor + 8);
+        uint32_t       kind       = read_le32(descriptor + 12);
+        uint32_t       transfer   = kind & 0xff;
+        uint32_t       slot       = (kind >> 8) & 0xff;
+
+        if (transfer >= sizeof(dmaTransfers) / sizeof(dmaTransfers[0]) ||
+            !dmaTransfers[transfer](memory, src, dst, length, slot)) {
+            XP_EMULATOR_LOGV("DMA descriptor %u rejected (kind 0x%x)", i, kind);
+            write_register(memory, XP_EMULATOR_CONFIG_HMM_DMA_ERROR_INDEX_PTR, i);
+            status = XP_EMULATOR_CONFIG_HMM_DMA_STATUS_ERROR;
+            break;
+        }
+        ++completed;
+    }
+
+    write_register(memory, XP_EMULATOR_CONFIG_HMM_DMA_COMPLETED_PTR, completed);
+    write_register(memory, XP_EMULATOR_CONFIG_HMM_DMA_STATUS_PTR, status);
+}
+
+static const XPEmulatorDMAHostBuffer*
+dma_host_buffer(XPEmulatorHostMappedMemory* memory, uint32_t slot, uint32_t offset, uint32_t length)
+{
+    if (slot >= XP_EMULATOR_CONFIG_HMM_DMA_MAX_HOST_BUFFERS) { return NULL; }
+    const XPEmulatorDMAHostBuffer* buffer = &memory->dmaHostBuffers[slot];
+    if (!buffer->data || (uint64_t)offset + length > buffer->size) { return NULL; }
+    return buffer;
+}
+
+static int
+dma_copy(XPEmulatorHostMappedMemory* memory, uint32_t src, uint32_t dst, uint32_t length, uint32_t slot)
+{
+    (void)slot;
+    const uint8_t* from = xp_emulator_memory_translate(memory->guestMemory, src, length, 0);
+    uint8_t*       to   = xp_emulator_memory_translate(memory->guestMemory, dst, length, 1);
+    if (!from || !to) { return 0; }
+    memmove(to, from, length);
+    return 1;
+}
+
+static int
+dma_fill(XPEmulatorHostMappedMemory* memory, uint32_t src, uint32_t dst, uint32_t length, uint32_t slot)
+{
+    (void)slot;
+    uint8_t* to = xp_emulator_memory_translate(memory->guestMemory, dst, length, 1);
+    if (!to) { return 0; }
+    memset(to, (int)(src & 0xff), length);
+    return 1;
+}
+
+static int
+dma_host_read(XPEmulatorHostMappedMemory* memory, uint32_t src, uint32_t dst, uint32_t length, uint32_t slot)
+{
+    const XPEmulatorDMAHostBuffer* buffer = dma_host_buffer(memory, slot, src, length);
+    uint8_t*                       to     = xp_emulator_memory_translate(memory->guestMemory, dst, length, 1);
+    if (!buffer || !to) { return 0; }
+    memcpy(to, buffer->data + src, length);
+    return 1;
+}
+
+static int
+dma_host_write(XPEmulatorHostMappedMemory* memory, uint32_t src, uint32_t dst, uint32_t length, uint32_t slot)
+{
+    const XPEmulatorDMAHostBuffer* buffer = dma_host_buffer(memory, slot, dst, length);
+    const uint8_t*                 from   = xp_emulator_memory_translate(memory->guestMemory, src, length, 0);
+    if (!buffer || !buffer->writable || !from) { return 0; }
+    memcpy(buffer->data + dst, from, length);
+    return 1;
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Emulator/XPEmulatorLogger.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+
+static XPEmulatorLogSink xp_emulator_logger_sink = NULL;
+
+XP_EMULATOR_EXTERN void
+xp_emulator_logger_set_sink(XPEmulatorLogSink sink)
+{
+    xp_emulator_logger_sink = sink;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_logger_write(const char* format, ...)
+{
+    char    buffer[1024];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (xp_emulator_logger_sink) {
+        xp_emulator_logger_sink(buffer);
+    } else {
+        puts(buffer);
+    }
+}
@@ -38,6 +38,8 @@ xp_emulator_memory_initialize(XPEmulatorMemory* memory)
     memset(memory->flash, 0, XP_EMULATOR_CONFIG_MEMORY_FLASH_SIZE);
     memset(memory->ram, 0, XP_EMULATOR_CONFIG_MEMORY_RAM_SIZE);
     memset(memory->heap, 0, XP_EMULATOR_CONFIG_MEMORY_HEAP_SIZE);
+    memory->text     = NULL;
+    memory->textSize = 0;
 }
 
 uint32_t
@@ -80,9 +82,54 @@ xp_emulator_memory_finalize(XPEmulatorMemory* memory)
 {
 }
 
+static uint8_t*
+translate_region(uint8_t* region, uint32_t base, uint32_t size, uint32_t address, uint32_t length)
+{
+    if (address < base || (uint64_t)address + length > (uint64_t)base + size) { return NULL; }
+    return region + (address - base);
+}
+
+uint8_t*
+xp_emulator_memory_translate(XPEmulatorMemory* memory, uint32_t address, uint32_t length, int writable)
+{
+    uint8_t* ptr = translate_region(
+      memory->ram, XP_EMULATOR_CONFIG_MEMORY_RAM_BASE, XP_EMULATOR_CONFIG_MEMORY_RAM_SIZE, address, length);
+    if (ptr) { return ptr; }
+    ptr = translate_region(
+      memory->heap, XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE, XP_EMULATOR_CONFIG_MEMORY_HEAP_SIZE, address, length);
+    if (ptr || writable) { return ptr; }
+    if (memory->text) {
+        ptr = translate_region(
+          (uint8_t*)memory->text, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE, memory->textSize, address, length);
+        if (ptr) { return ptr; }
+    }
+    return translate_region(
+      memory->flash, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE, XP_EMULATOR_CONFIG_MEMORY_FLASH_SIZE, address, length);
+}
+
 uint32_t
 load_flash(XPEmulatorMemory* memory, uint32_t address, uint32_t size)
 {
+    if (address + size / 8 <= memory->textSize) {
+        const uint8_t* text = memory->text + address;
+        switch (size) {
+            case 8: return (uint32_t)text[0];
+            case 16: return (uint32_t)text[0] | (uint32_t)text[1] << 8;
+            case 32:
+                return (uint32_t)text[0] | (uint32_t)text[1] << 8 | (uint32_t)text[2] << 16 | (uint32_t)text[3] << 24;
+            default: assert(0 && "Unreachable"); return 0;
+        }
+    }
+    if (address < memory->textSize) {
+        // a load straddling the end of the text takes its tail from flash
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < size / 8; ++i) {
+            uint32_t offset = address + i;
+            value |= (uint32_t)(offset < memory->textSize ? memory->text[offset] : memory->flash[offset]) << (8 * i);
+        }
+        return value;
+    }
+
     switch (size) {
         case 8: {
             return (uint32_t)memory->flash[address];
@@ -146,6 +193,9 @@ load_heap(XPEmulatorMemory* memory, uint32_t address, uint32_t size)
 void
 store_flash(XPEmulatorMemory* memory, uint32_t address, uint32_t size, uint32_t value)
 {
+    // mapped text is shared with every other processor running the same program
+    if (address < memory->textSize) { return; }
+
     switch (size) {
         case 8: {
             memory->flash[address] = (uint8_t)(value & 0xff);
@@ -20,29 +20,159 @@
 #include <Emulator/XPEmulatorInstruction.h>
 #include <Emulator/XPEmulatorLogger.h>
 #include <Emulator/XPEmulatorProcessor.h>
+#include <Emulator/XPEmulatorProfiler.h>
 #include <Emulator/XPEmulatorSyscalls.h>
 #include <Emulator/XPEmulatorUART.h>
 
 #include <assert.h>
 #include <errno.h>
 #include <inttypes.h>
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+    #include <fenv.h>
+    #include <math.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
-#if defined(__APPLE__)
-    #include <regex.h>
-    #include <unistd.h>
-    #define XP_EMULATOR_FD_FROM_FILE(FILE) FILE->_file
-#elif defined(__linux__)
-    #include <regex.h>
-    #include <unistd.h>
-    #define XP_EMULATOR_FD_FROM_FILE(FILE) FILE->_fileno
-#elif defined(_WIN32)
-    #define STDOUT_FILENO                  _fileno(stdout)
-    #define STDERR_FILENO                  _fileno(stderr)
-    #define STDIN_FILENO                   _fileno(stdin)
-    #define XP_EMULATOR_FD_FROM_FILE(FILE) _fileno(FILE)
+
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+    // guest FP ops run on the host FPU, the host rounding mode and exception flags are switched per instruction
+    #if defined(_MSC_VER)
+        #pragma fenv_access(on)
+    #elif defined(__clang__)
+        #pragma STDC FENV_ACCESS ON
+    #endif
+
+    // not every host libc exposes all of these (wasm only rounds to nearest and raises nothing)
+    #if defined(FE_TOWARDZERO)
+        #define XP_EMULATOR_FE_TOWARDZERO FE_TOWARDZERO
+    #else
+        #define XP_EMULATOR_FE_TOWARDZERO FE_TONEAREST
+    #endif
+    #if defined(FE_DOWNWARD)
+        #define XP_EMULATOR_FE_DOWNWARD FE_DOWNWARD
+    #else
+        #define XP_EMULATOR_FE_DOWNWARD FE_TONEAREST
+    #endif
+    #if defined(FE_UPWARD)
+        #define XP_EMULATOR_FE_UPWARD FE_UPWARD
+    #else
+        #define XP_EMULATOR_FE_UPWARD FE_TONEAREST
+    #endif
+    #if defined(FE_INEXACT)
+        #define XP_EMULATOR_FE_INEXACT FE_INEXACT
+    #else
+        #define XP_EMULATOR_FE_INEXACT 0
+    #endif
+    #if defined(FE_UNDERFLOW)
+        #define XP_EMULATOR_FE_UNDERFLOW FE_UNDERFLOW
+    #else
+        #define XP_EMULATOR_FE_UNDERFLOW 0
+    #endif
+    #if defined(FE_OVERFLOW)
+        #define XP_EMULATOR_FE_OVERFLOW FE_OVERFLOW
+    #else
+        #define XP_EMULATOR_FE_OVERFLOW 0
+    #endif
+    #if defined(FE_DIVBYZERO)
+        #define XP_EMULATOR_FE_DIVBYZERO FE_DIVBYZERO
+    #else
+        #define XP_EMULATOR_FE_DIVBYZERO 0
+    #endif
+    #if defined(FE_INVALID)
+        #define XP_EMULATOR_FE_INVALID FE_INVALID
+    #else
+        #define XP_EMULATOR_FE_INVALID 0
+    #endif
+
+    #define XP_EMULATOR_FFLAGS_NX (1U << 0) // inexact
+    #define XP_EMULATOR_FFLAGS_UF (1U << 1) // underflow
+    #define XP_EMULATOR_FFLAGS_OF (1U << 2) // overflow
+    #define XP_EMULATOR_FFLAGS_DZ (1U << 3) // divide by zero
+    #define XP_EMULATOR_FFLAGS_NV (1U << 4) // invalid operation
+
+    #define XP_EMULATOR_FRM_RNE 0b000 // round to nearest, ties to even
+    #define XP_EMULATOR_FRM_RTZ 0b001 // round towards zero
+    #define XP_EMULATOR_FRM_RDN 0b010 // round down
+    #define XP_EMULATOR_FRM_RUP 0b011 // round up
+    #define XP_EMULATOR_FRM_RMM 0b100 // round to nearest, ties to max magnitude
+    #define XP_EMULATOR_FRM_DYN 0b111 // use frm from fcsr
+
+    #define XP_EMULATOR_CSR_FFLAGS 0x001
+    #define XP_EMULATOR_CSR_FRM    0x002
+    #define XP_EMULATOR_CSR_FCSR   0x003
+
+    #define XP_EMULATOR_CANONICAL_NAN_S 0x7FC00000U
+    #define XP_EMULATOR_CANONICAL_NAN_D 0x7FF8000000000000ULL
+
+static int
+is_signaling_s(uint32_t bits);
+
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+static int
+is_signaling_d(uint64_t bits);
+    #endif
+
+static uint32_t
+read_f32_bits(XPEmulatorProcessor* processor, uint32_t reg);
+
+static float
+read_f32(XPEmulatorProcessor* processor, uint32_t reg);
+
+static void
+write_f32_bits(XPEmulatorProcessor* processor, uint32_t reg, uint32_t bits);
+
+static void
+write_f32(XPEmulatorProcessor* processor, uint32_t reg, float value);
+
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+static double
+read_f64(XPEmulatorProcessor* processor, uint32_t reg);
+
+static void
+write_f64(XPEmulatorProcessor* processor, uint32_t reg, double value);
+    #endif
+
+static int
+fp_begin(XPEmulatorProcessor* processor, uint32_t rm, int* hostRound);
+
+static void
+fp_end(XPEmulatorProcessor* processor, int hostRound);
+
+static int
+fp_resolve_rm(XPEmulatorProcessor* processor, uint32_t rm, uint32_t* resolved);
+
+static int
+fp_to_int(XPEmulatorProcessor* processor, double value, uint32_t rm, int isUnsigned, uint32_t* out);
+
+static uint32_t
+fp_classify(int isNegative, int fpClass, int isSignaling);
+
+static uint32_t
+fp_min_max_s(XPEmulatorProcessor* processor, uint32_t rs1, uint32_t rs2, int wantMax);
+
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+static uint64_t
+fp_min_max_d(XPEmulatorProcessor* processor, uint32_t rs1, uint32_t rs2, int wantMax);
+    #endif
+
+static uint32_t
+fp_compare(XPEmulatorProcessor* processor, double a, double b, int hasSignalingNaN, int op);
+#endif
+
+#if defined(XP_EMULATOR_USE_ZICNTR_EXTENSION)
+    #define XP_EMULATOR_CSR_CYCLE    0xC00
+    #define XP_EMULATOR_CSR_TIME     0xC01
+    #define XP_EMULATOR_CSR_INSTRET  0xC02
+    #define XP_EMULATOR_CSR_CYCLEH   0xC80
+    #define XP_EMULATOR_CSR_TIMEH    0xC81
+    #define XP_EMULATOR_CSR_INSTRETH 0xC82
+#endif
+
+#if defined(XP_EMULATOR_USE_ZICSR_EXTENSION)
+static int
+execute_csr(XPEmulatorProcessor* processor, struct XPEmulatorEncodedInstruction instr);
 #endif
 
 uint32_t
@@ -71,6 +201,18 @@ xp_emulator_processor_initialize(XPEmulatorProcessor* processor)
     processor->regs[XPEmulatorEReg0] = 0;
     processor->regs[XPEmulatorEReg2] = XP_EMULATOR_CONFIG_HMM_TOP_STACK_PTR;
     processor->pc                    = 0;
+    xp_emulator_syscalls_initialize(&processor->syscalls);
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+    memset(processor->fregs, 0, sizeof(processor->fregs));
+    processor->fcsr = 0;
+#endif
+#if defined(XP_EMULATOR_USE_ZICNTR_EXTENSION)
+    processor->cycle   = 0;
+    processor->instret = 0;
+#endif
+#if defined(XP_EMULATOR_USE_PROFILER)
+    processor->profiler = NULL;
+#endif
 }
 
 XP_EMULATOR_EXTERN int
@@ -80,9 +222,22 @@ xp_emulator_processor_load_program(XPEmulatorProcessor* processor, RiscvElfLoade
     assert(loader->segments[1].vaddr == XP_EMULATOR_CONFIG_MEMORY_RAM_BASE);
     assert(loader->segments[2].vaddr == XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE);
 
-    memcpy(processor->bus.memory.flash, loader->segments[0].data, loader->segments[0].size);
-    memcpy(processor->bus.memory.ram, loader->segments[1].data, loader->segments[1].size);
-    memcpy(processor->bus.memory.heap, loader->segments[2].data, loader->segments[2].size);
+    const MemorySegment* text = &loader->segments[0];
+    const MemorySegment* data = &loader->segments[1];
+    const MemorySegment* heap = &loader->segments[2];
+    if (text->size > XP_EMULATOR_CONFIG_MEMORY_FLASH_SIZE || data->size > XP_EMULATOR_CONFIG_MEMORY_RAM_SIZE ||
+        heap->size > XP_EMULATOR_CONFIG_MEMORY_HEAP_SIZE) {
+        return -1;
+    }
+
+    // text is read straight from the loader mapping, only the writable segments get a private copy
+    processor->bus.memory.text     = text->data;
+    processor->bus.memory.textSize = (uint32_t)text->file_size;
+    memset(processor->bus.memory.flash + text->file_size, 0, text->size - text->file_size);
+    memcpy(processor->bus.memory.ram, data->data, data->file_size);
+    memset(processor->bus.memory.ram + data->file_size, 0, data->size - data->file_size);
+    memcpy(processor->bus.memory.heap, heap->data, heap->file_size);
+    memset(processor->bus.memory.heap + heap->file_size, 0, heap->size - heap->file_size);
 
     processor->pc = loader->entry_point;
 
@@ -98,6 +253,10 @@ xp_emulator_processor_step(XPEmulatorProcessor* processor)
     // decode
     struct XPEmulatorEncodedInstruction instruction = decode(encodedInstr);
 
+#if defined(XP_EMULATOR_USE_PROFILER)
+    if (processor->profiler) { xp_emulator_profiler_sample(processor->profiler, processor->pc); }
+#endif
+
     // execute
     int ret = execute(processor, instruction);
     if (ret != XP_EMULATOR_PROGRAM_EXIT_CODE_SUCCESS) {
@@ -105,6 +264,12 @@ xp_emulator_processor_step(XPEmulatorProcessor* processor)
         return ret;
     }
 
+#if defined(XP_EMULATOR_USE_ZICNTR_EXTENSION)
+    // counters tick after retirement so a csr read observes the count up to but excluding itself
+    ++processor->cycle;
+    ++processor->instret;
+#endif
+
     return 0;
 }
 
@@ -179,28 +344,68 @@ xp_emulator_processor_run(XPEmulatorProcessor* processor)
     print_registers(processor);
 }
 
+XP_EMULATOR_EXTERN int
+xp_emulator_processor_run_budget(XPEmulatorProcessor* processor, uint32_t budget, uint32_t* retired)
+{
+    int      result = XP_EMULATOR_PROGRAM_EXIT_CODE_SUCCESS;
+    uint32_t count  = 0;
+    while (count < budget) {
+        uint64_t syscalls = processor->syscalls.count;
+        result            = xp_emulator_processor_step(processor);
+        if (result != XP_EMULATOR_PROGRAM_EXIT_CODE_SUCCESS) { break; }
+        ++count;
+        if (processor->syscalls.count != syscalls) {
+            result = XP_EMULATOR_PROGRAM_EXIT_CODE_YIELD;
+            break;
+        }
+    }
+    if (retired) { *retired = count; }
+    return result;
+}
+
 XP_EMULATOR_EXTERN void
 xp_emulator_processor_finalize(XPEmulatorProcessor* processor)
 {
+    xp_emulator_syscalls_finalize(&processor->syscalls);
     xp_emulator_bus_finalize(&processor->bus);
 }
 
+#if defined(XP_EMULATOR_USE_ZICNTR_EXTENSION)
+XP_EMULATOR_EXTERN uint64_t
+xp_emulator_processor_time(const XPEmulatorProcessor* processor)
+{
+    return processor->cycle / (XP_EMULATOR_CONFIG_CLOCK_FREQUENCY_HZ / XP_EMULATOR_CONFIG_TIMER_FREQUENCY_HZ);
+}
+#endif
+
 uint32_t
 fetch(XPEmulatorProcessor* processor)
 {
+#if defined(XP_EMULATOR_USE_C_EXTENSION)
+    // pc is only 2 byte aligned with compressed instructions, read the upper half only for 32 bit encodings
+    uint32_t lower = xp_emulator_bus_load(&processor->bus, processor->pc, 16);
+    if ((lower & 0b11) != 0b11) { return lower; }
+    return lower | (xp_emulator_bus_load(&processor->bus, processor->pc + 2, 16) << 16);
+#else
     return xp_emulator_bus_load(&processor->bus, processor->pc, 32);
+#endif
 }
 
 struct XPEmulatorEncodedInstruction
 decode(uint32_t instruction)
 {
+#if defined(XP_EMULATOR_USE_C_EXTENSION)
+    if ((instruction & 0b11) != 0b11) {
+        return xp_emulator_decoder_decode_compressed_instruction((uint16_t)instruction);
+    }
+#endif
     return xp_emulator_decoder_decode_instruction(instruction);
 }
 
 int
 execute(XPEmulatorProcessor* processor, struct XPEmulatorEncodedInstruction instr)
 {
-    int pcIncr = 4;
+    int pcIncr = (int)instr.size;
 
     switch (instr.type) {
         case XPEmulatorEInstructionType_Undefined: {
@@ -231,8 +436,13 @@ execute(XPEmulatorProcessor* processor, struct XPEmulatorEncodedInstruction inst
             if (imm & 0x00100000) { // If imm[20] (bit 20) is set
                 imm |= 0xFFE00000;  // Extend the sign to higher bits
             }
-            processor->regs[instr.JAL.rd] = processor->pc + 4;
+            processor->regs[instr.JAL.rd] = processor->pc + instr.size;
             pcIncr                        = imm;
+#if defined(XP_EMULATOR_USE_PROFILER)
+            if (processor->profiler && instr.JAL.rd == XPEmulatorEReg1) {
+                xp_emulator_profiler_on_call(processor->profiler, processor->pc + imm, processor->pc + instr.size);
+            }
+#endif
             break;
         }
         case XPEmulatorEInstructionType_JALR: {
@@ -243,8 +453,16 @@ execute(XPEmulatorProcessor* processor, struct XPEmulatorEncodedInstruction inst
             if (imm & 0x800) {
                 imm |= 0xFFFFF000; // Extend sign to higher bits
             }
-            uint32_t nextInstrAddress      = processor->pc + 4;
+            uint32_t nextInstrAddress      = processor->pc + instr.size;
             processor->pc                  = (processor->regs[instr.JALR.rs1] + imm) & 0xFFFFFFFE;
+#if defined(XP_EMULATOR_USE_PROFILER)
+            // the ABI linkage convention tells calls (rd = ra) and returns (rd = zero, rs1 = ra) apart
+            if (processor->profiler && instr.JALR.rd == XPEmulatorEReg1) {
+                xp_emulator_profiler_on_call(processor->profiler, processor->pc, nextInstrAddress);
+            } else if (processor->profiler && instr.JALR.rd == XPEmulatorEReg0 && instr.JALR.rs1 == XPEmulatorEReg1) {
+                xp_emulator_profiler_on_return(processor->profiler, processor->pc);
+            }
+#endif
             processor->regs[instr.JALR.rd] = nextInstrAddress;
             pcIncr                         = 0;
             break;
@@ -401,7 +619,7 @@ execute(XPEmulatorProcessor* processor, struct XPEmulatorEncodedInstruction inst
             xp_emulator_print_op("SLTI");
             // imm[11:0] = inst[31:20]
             uint32_t imm                   = ((int32_t)(int32_t)(instr.instruction.value & 0xFFF00000)) >> 20;
-            processor->regs[instr.SLTI.rd] = (processor->regs[instr.SLTI.rs1] < (int32_t)imm) ? 1 : 0;
+            processor->regs[instr.SLTI.rd] = ((int32_t)processor->regs[instr.SLTI.rs1] < (int32_t)imm) ? 1 : 0;
             break;
         }
         case XPEmulatorEInstructionType_SLTIU: {
@@ -479,7 +697,7 @@ execute(XPEmulatorProcessor* processor, struct XPEmulatorEncodedInstruction inst
         case XPEmulatorEInstructionType_SLT: {
             xp_emulator_print_op("SLT");
             processor->regs[instr.SLT.rd] =
-              (processor->regs[instr.SLT.rs1] < (int32_t)processor->regs[instr.SLT.rs2]) ? 1 : 0;
+              ((int32_t)processor->regs[instr.SLT.rs1] < (int32_t)processor->regs[instr.SLT.rs2]) ? 1 : 0;
             break;
         }
         case XPEmulatorEInstructionType_SLTU: {
@@ -609,115 +827,576 @@ execute(XPEmulatorProcessor* processor, struct XPEmulatorEncodedInstruction inst
             //     break;
             // }
     #endif
+#endif
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+        case XPEmulatorEInstructionType_FLW: {
+            xp_emulator_print_op("FLW");
+            // imm[11:0] = inst[31:20]
+            uint32_t imm  = ((int32_t)(instr.instruction.value & 0xFFF00000)) >> 20;
+            uint32_t addr = processor->regs[instr.FLOAD.rs1] + (int32_t)imm;
+            write_f32_bits(processor, instr.FLOAD.rd, load(processor, addr, 32));
+            break;
+        }
+        case XPEmulatorEInstructionType_FSW: {
+            xp_emulator_print_op("FSW");
+            int64_t  imm     = imm_S(instr);
+            uint32_t address = processor->regs[instr.FSTORE.rs1] + (int32_t)imm;
+            store(processor, address, 32, (uint32_t)processor->fregs[instr.FSTORE.rs2]);
+            break;
+        }
+        case XPEmulatorEInstructionType_FMADD_S: {
+            xp_emulator_print_op("FMADD.S");
+            float a = read_f32(processor, instr.FMA.rs1);
+            float b = read_f32(processor, instr.FMA.rs2);
+            float c = read_f32(processor, instr.FMA.rs3);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FMA.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = fmaf(a, b, c);
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FMA.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FMSUB_S: {
+            xp_emulator_print_op("FMSUB.S");
+            float a = read_f32(processor, instr.FMA.rs1);
+            float b = read_f32(processor, instr.FMA.rs2);
+            float c = read_f32(processor, instr.FMA.rs3);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FMA.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = fmaf(a, b, -c);
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FMA.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FNMSUB_S: {
+            xp_emulator_print_op("FNMSUB.S");
+            float a = read_f32(processor, instr.FMA.rs1);
+            float b = read_f32(processor, instr.FMA.rs2);
+            float c = read_f32(processor, instr.FMA.rs3);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FMA.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = fmaf(-a, b, c);
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FMA.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FNMADD_S: {
+            xp_emulator_print_op("FNMADD.S");
+            float a = read_f32(processor, instr.FMA.rs1);
+            float b = read_f32(processor, instr.FMA.rs2);
+            float c = read_f32(processor, instr.FMA.rs3);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FMA.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = fmaf(-a, b, -c);
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FMA.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FADD_S: {
+            xp_emulator_print_op("FADD.S");
+            float a = read_f32(processor, instr.FOP.rs1);
+            float b = read_f32(processor, instr.FOP.rs2);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = a + b;
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FSUB_S: {
+            xp_emulator_print_op("FSUB.S");
+            float a = read_f32(processor, instr.FOP.rs1);
+            float b = read_f32(processor, instr.FOP.rs2);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = a - b;
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FMUL_S: {
+            xp_emulator_print_op("FMUL.S");
+            float a = read_f32(processor, instr.FOP.rs1);
+            float b = read_f32(processor, instr.FOP.rs2);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = a * b;
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FDIV_S: {
+            xp_emulator_print_op("FDIV.S");
+            float a = read_f32(processor, instr.FOP.rs1);
+            float b = read_f32(processor, instr.FOP.rs2);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = a / b;
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FSQRT_S: {
+            xp_emulator_print_op("FSQRT.S");
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = sqrtf(read_f32(processor, instr.FOP.rs1));
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FSGNJ_S: {
+            xp_emulator_print_op("FSGNJ.S");
+            uint32_t a = read_f32_bits(processor, instr.FOP.rs1);
+            uint32_t b = read_f32_bits(processor, instr.FOP.rs2);
+            write_f32_bits(processor, instr.FOP.rd, (a & 0x7FFFFFFF) | (b & 0x80000000));
+            break;
+        }
+        case XPEmulatorEInstructionType_FSGNJN_S: {
+            xp_emulator_print_op("FSGNJN.S");
+            uint32_t a = read_f32_bits(processor, instr.FOP.rs1);
+            uint32_t b = read_f32_bits(processor, instr.FOP.rs2);
+            write_f32_bits(processor, instr.FOP.rd, (a & 0x7FFFFFFF) | (~b & 0x80000000));
+            break;
+        }
+        case XPEmulatorEInstructionType_FSGNJX_S: {
+            xp_emulator_print_op("FSGNJX.S");
+            uint32_t a = read_f32_bits(processor, instr.FOP.rs1);
+            uint32_t b = read_f32_bits(processor, instr.FOP.rs2);
+            write_f32_bits(processor, instr.FOP.rd, a ^ (b & 0x80000000));
+            break;
+        }
+        case XPEmulatorEInstructionType_FMIN_S: {
+            xp_emulator_print_op("FMIN.S");
+            write_f32_bits(processor, instr.FOP.rd, fp_min_max_s(processor, instr.FOP.rs1, instr.FOP.rs2, 0));
+            break;
+        }
+        case XPEmulatorEInstructionType_FMAX_S: {
+            xp_emulator_print_op("FMAX.S");
+            write_f32_bits(processor, instr.FOP.rd, fp_min_max_s(processor, instr.FOP.rs1, instr.FOP.rs2, 1));
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_W_S: {
+            xp_emulator_print_op("FCVT.W.S");
+            uint32_t value = 0;
+            if (!fp_to_int(processor, (double)read_f32(processor, instr.FOP.rs1), instr.FOP.rm, 0, &value)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            processor->regs[instr.FOP.rd] = value;
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_WU_S: {
+            xp_emulator_print_op("FCVT.WU.S");
+            uint32_t value = 0;
+            if (!fp_to_int(processor, (double)read_f32(processor, instr.FOP.rs1), instr.FOP.rm, 1, &value)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            processor->regs[instr.FOP.rd] = value;
+            break;
+        }
+        case XPEmulatorEInstructionType_FMV_X_W: {
+            xp_emulator_print_op("FMV.X.W");
+            processor->regs[instr.FOP.rd] = (uint32_t)processor->fregs[instr.FOP.rs1];
+            break;
+        }
+        case XPEmulatorEInstructionType_FEQ_S: {
+            xp_emulator_print_op("FEQ.S");
+            uint32_t aBits           = read_f32_bits(processor, instr.FOP.rs1);
+            uint32_t bBits           = read_f32_bits(processor, instr.FOP.rs2);
+            int      hasSignalingNaN = is_signaling_s(aBits) || is_signaling_s(bBits);
+            float    a               = read_f32(processor, instr.FOP.rs1);
+            float    b               = read_f32(processor, instr.FOP.rs2);
+            processor->regs[instr.FOP.rd] = fp_compare(processor, a, b, hasSignalingNaN, 0);
+            break;
+        }
+        case XPEmulatorEInstructionType_FLT_S: {
+            xp_emulator_print_op("FLT.S");
+            uint32_t aBits           = read_f32_bits(processor, instr.FOP.rs1);
+            uint32_t bBits           = read_f32_bits(processor, instr.FOP.rs2);
+            int      hasSignalingNaN = is_signaling_s(aBits) || is_signaling_s(bBits);
+            float    a               = read_f32(processor, instr.FOP.rs1);
+            float    b               = read_f32(processor, instr.FOP.rs2);
+            processor->regs[instr.FOP.rd] = fp_compare(processor, a, b, hasSignalingNaN, 1);
+            break;
+        }
+        case XPEmulatorEInstructionType_FLE_S: {
+            xp_emulator_print_op("FLE.S");
+            uint32_t aBits           = read_f32_bits(processor, instr.FOP.rs1);
+            uint32_t bBits           = read_f32_bits(processor, instr.FOP.rs2);
+            int      hasSignalingNaN = is_signaling_s(aBits) || is_signaling_s(bBits);
+            float    a               = read_f32(processor, instr.FOP.rs1);
+            float    b               = read_f32(processor, instr.FOP.rs2);
+            processor->regs[instr.FOP.rd] = fp_compare(processor, a, b, hasSignalingNaN, 2);
+            break;
+        }
+        case XPEmulatorEInstructionType_FCLASS_S: {
+            xp_emulator_print_op("FCLASS.S");
+            uint32_t bits  = read_f32_bits(processor, instr.FOP.rs1);
+            float    value = read_f32(processor, instr.FOP.rs1);
+            processor->regs[instr.FOP.rd] = fp_classify(signbit(value) != 0, fpclassify(value), is_signaling_s(bits));
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_S_W: {
+            xp_emulator_print_op("FCVT.S.W");
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = (float)(int32_t)processor->regs[instr.FOP.rs1];
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_S_WU: {
+            xp_emulator_print_op("FCVT.S.WU");
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = (float)processor->regs[instr.FOP.rs1];
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FMV_W_X: {
+            xp_emulator_print_op("FMV.W.X");
+            write_f32_bits(processor, instr.FOP.rd, processor->regs[instr.FOP.rs1]);
+            break;
+        }
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+        case XPEmulatorEInstructionType_FLD: {
+            xp_emulator_print_op("FLD");
+            // imm[11:0] = inst[31:20]
+            uint32_t imm  = ((int32_t)(instr.instruction.value & 0xFFF00000)) >> 20;
+            uint32_t addr = processor->regs[instr.FLOAD.rs1] + (int32_t)imm;
+            uint64_t low  = load(processor, addr, 32);
+            uint64_t high = load(processor, addr + 4, 32);
+            processor->fregs[instr.FLOAD.rd] = (high << 32) | low;
+            break;
+        }
+        case XPEmulatorEInstructionType_FSD: {
+            xp_emulator_print_op("FSD");
+            int64_t  imm     = imm_S(instr);
+            uint32_t address = processor->regs[instr.FSTORE.rs1] + (int32_t)imm;
+            uint64_t value   = processor->fregs[instr.FSTORE.rs2];
+            store(processor, address, 32, (uint32_t)value);
+            store(processor, address + 4, 32, (uint32_t)(value >> 32));
+            break;
+        }
+        case XPEmulatorEInstructionType_FMADD_D: {
+            xp_emulator_print_op("FMADD.D");
+            double a = read_f64(processor, instr.FMA.rs1);
+            double b = read_f64(processor, instr.FMA.rs2);
+            double c = read_f64(processor, instr.FMA.rs3);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FMA.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = fma(a, b, c);
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FMA.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FMSUB_D: {
+            xp_emulator_print_op("FMSUB.D");
+            double a = read_f64(processor, instr.FMA.rs1);
+            double b = read_f64(processor, instr.FMA.rs2);
+            double c = read_f64(processor, instr.FMA.rs3);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FMA.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = fma(a, b, -c);
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FMA.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FNMSUB_D: {
+            xp_emulator_print_op("FNMSUB.D");
+            double a = read_f64(processor, instr.FMA.rs1);
+            double b = read_f64(processor, instr.FMA.rs2);
+            double c = read_f64(processor, instr.FMA.rs3);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FMA.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = fma(-a, b, c);
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FMA.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FNMADD_D: {
+            xp_emulator_print_op("FNMADD.D");
+            double a = read_f64(processor, instr.FMA.rs1);
+            double b = read_f64(processor, instr.FMA.rs2);
+            double c = read_f64(processor, instr.FMA.rs3);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FMA.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = fma(-a, b, -c);
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FMA.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FADD_D: {
+            xp_emulator_print_op("FADD.D");
+            double a = read_f64(processor, instr.FOP.rs1);
+            double b = read_f64(processor, instr.FOP.rs2);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = a + b;
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FSUB_D: {
+            xp_emulator_print_op("FSUB.D");
+            double a = read_f64(processor, instr.FOP.rs1);
+            double b = read_f64(processor, instr.FOP.rs2);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = a - b;
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FMUL_D: {
+            xp_emulator_print_op("FMUL.D");
+            double a = read_f64(processor, instr.FOP.rs1);
+            double b = read_f64(processor, instr.FOP.rs2);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = a * b;
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FDIV_D: {
+            xp_emulator_print_op("FDIV.D");
+            double a = read_f64(processor, instr.FOP.rs1);
+            double b = read_f64(processor, instr.FOP.rs2);
+
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = a / b;
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FSQRT_D: {
+            xp_emulator_print_op("FSQRT.D");
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = sqrt(read_f64(processor, instr.FOP.rs1));
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FSGNJ_D: {
+            xp_emulator_print_op("FSGNJ.D");
+            uint64_t a = processor->fregs[instr.FOP.rs1];
+            uint64_t b = processor->fregs[instr.FOP.rs2];
+            processor->fregs[instr.FOP.rd] = (a & 0x7FFFFFFFFFFFFFFFULL) | (b & 0x8000000000000000ULL);
+            break;
+        }
+        case XPEmulatorEInstructionType_FSGNJN_D: {
+            xp_emulator_print_op("FSGNJN.D");
+            uint64_t a = processor->fregs[instr.FOP.rs1];
+            uint64_t b = processor->fregs[instr.FOP.rs2];
+            processor->fregs[instr.FOP.rd] = (a & 0x7FFFFFFFFFFFFFFFULL) | (~b & 0x8000000000000000ULL);
+            break;
+        }
+        case XPEmulatorEInstructionType_FSGNJX_D: {
+            xp_emulator_print_op("FSGNJX.D");
+            uint64_t a = processor->fregs[instr.FOP.rs1];
+            uint64_t b = processor->fregs[instr.FOP.rs2];
+            processor->fregs[instr.FOP.rd] = a ^ (b & 0x8000000000000000ULL);
+            break;
+        }
+        case XPEmulatorEInstructionType_FMIN_D: {
+            xp_emulator_print_op("FMIN.D");
+            processor->fregs[instr.FOP.rd] = fp_min_max_d(processor, instr.FOP.rs1, instr.FOP.rs2, 0);
+            break;
+        }
+        case XPEmulatorEInstructionType_FMAX_D: {
+            xp_emulator_print_op("FMAX.D");
+            processor->fregs[instr.FOP.rd] = fp_min_max_d(processor, instr.FOP.rs1, instr.FOP.rs2, 1);
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_S_D: {
+            xp_emulator_print_op("FCVT.S.D");
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile float result = (float)read_f64(processor, instr.FOP.rs1);
+            fp_end(processor, hostRound);
+            write_f32(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_D_S: {
+            xp_emulator_print_op("FCVT.D.S");
+            int hostRound = 0;
+            if (!fp_begin(processor, instr.FOP.rm, &hostRound)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            volatile double result = (double)read_f32(processor, instr.FOP.rs1);
+            fp_end(processor, hostRound);
+            write_f64(processor, instr.FOP.rd, result);
+            break;
+        }
+        case XPEmulatorEInstructionType_FEQ_D: {
+            xp_emulator_print_op("FEQ.D");
+            uint64_t aBits           = processor->fregs[instr.FOP.rs1];
+            uint64_t bBits           = processor->fregs[instr.FOP.rs2];
+            int      hasSignalingNaN = is_signaling_d(aBits) || is_signaling_d(bBits);
+            double   a               = read_f64(processor, instr.FOP.rs1);
+            double   b               = read_f64(processor, instr.FOP.rs2);
+            processor->regs[instr.FOP.rd] = fp_compare(processor, a, b, hasSignalingNaN, 0);
+            break;
+        }
+        case XPEmulatorEInstructionType_FLT_D: {
+            xp_emulator_print_op("FLT.D");
+            uint64_t aBits           = processor->fregs[instr.FOP.rs1];
+            uint64_t bBits           = processor->fregs[instr.FOP.rs2];
+            int      hasSignalingNaN = is_signaling_d(aBits) || is_signaling_d(bBits);
+            double   a               = read_f64(processor, instr.FOP.rs1);
+            double   b               = read_f64(processor, instr.FOP.rs2);
+            processor->regs[instr.FOP.rd] = fp_compare(processor, a, b, hasSignalingNaN, 1);
+            break;
+        }
+        case XPEmulatorEInstructionType_FLE_D: {
+            xp_emulator_print_op("FLE.D");
+            uint64_t aBits           = processor->fregs[instr.FOP.rs1];
+            uint64_t bBits           = processor->fregs[instr.FOP.rs2];
+            int      hasSignalingNaN = is_signaling_d(aBits) || is_signaling_d(bBits);
+            double   a               = read_f64(processor, instr.FOP.rs1);
+            double   b               = read_f64(processor, instr.FOP.rs2);
+            processor->regs[instr.FOP.rd] = fp_compare(processor, a, b, hasSignalingNaN, 2);
+            break;
+        }
+        case XPEmulatorEInstructionType_FCLASS_D: {
+            xp_emulator_print_op("FCLASS.D");
+            uint64_t bits  = processor->fregs[instr.FOP.rs1];
+            double   value = read_f64(processor, instr.FOP.rs1);
+            processor->regs[instr.FOP.rd] = fp_classify(signbit(value) != 0, fpclassify(value), is_signaling_d(bits));
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_W_D: {
+            xp_emulator_print_op("FCVT.W.D");
+            uint32_t value = 0;
+            if (!fp_to_int(processor, read_f64(processor, instr.FOP.rs1), instr.FOP.rm, 0, &value)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            processor->regs[instr.FOP.rd] = value;
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_WU_D: {
+            xp_emulator_print_op("FCVT.WU.D");
+            uint32_t value = 0;
+            if (!fp_to_int(processor, read_f64(processor, instr.FOP.rs1), instr.FOP.rm, 1, &value)) {
+                return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION;
+            }
+            processor->regs[instr.FOP.rd] = value;
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_D_W: {
+            xp_emulator_print_op("FCVT.D.W");
+            // every int32 is exactly representable as a double, no rounding or flags involved
+            write_f64(processor, instr.FOP.rd, (double)(int32_t)processor->regs[instr.FOP.rs1]);
+            break;
+        }
+        case XPEmulatorEInstructionType_FCVT_D_WU: {
+            xp_emulator_print_op("FCVT.D.WU");
+            write_f64(processor, instr.FOP.rd, (double)processor->regs[instr.FOP.rs1]);
+            break;
+        }
+    #endif
+#endif
+#if defined(XP_EMULATOR_USE_ZICSR_EXTENSION)
+        case XPEmulatorEInstructionType_CSRRW: {
+            xp_emulator_print_op("CSRRW");
+            if (!execute_csr(processor, instr)) { return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION; }
+            break;
+        }
+        case XPEmulatorEInstructionType_CSRRS: {
+            xp_emulator_print_op("CSRRS");
+            if (!execute_csr(processor, instr)) { return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION; }
+            break;
+        }
+        case XPEmulatorEInstructionType_CSRRC: {
+            xp_emulator_print_op("CSRRC");
+            if (!execute_csr(processor, instr)) { return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION; }
+            break;
+        }
+        case XPEmulatorEInstructionType_CSRRWI: {
+            xp_emulator_print_op("CSRRWI");
+            if (!execute_csr(processor, instr)) { return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION; }
+            break;
+        }
+        case XPEmulatorEInstructionType_CSRRSI: {
+            xp_emulator_print_op("CSRRSI");
+            if (!execute_csr(processor, instr)) { return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION; }
+            break;
+        }
+        case XPEmulatorEInstructionType_CSRRCI: {
+            xp_emulator_print_op("CSRRCI");
+            if (!execute_csr(processor, instr)) { return XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION; }
+            break;
+        }
 #endif
         case XPEmulatorEInstructionType_FENCE: {
             xp_emulator_print_op("FENCE");
             return XP_EMULATOR_PROGRAM_EXIT_CODE_FENCE_UNIMPLEMENTED;
         }
         case XPEmulatorEInstructionType_ECALL: {
-            // TODO: properly handle file system calls etc ..
-            // we're only allowing a single file to be read/written to at the same time
-            static FILE* file = NULL;
-
             xp_emulator_print_op("ECALL");
-            uint32_t syscall_num = processor->regs[XPEmulatorEReg17];
-            int32_t  arg0        = processor->regs[XPEmulatorEReg10];
-            int32_t  arg1        = processor->regs[XPEmulatorEReg11];
-            int32_t  arg2        = processor->regs[XPEmulatorEReg12];
-            int32_t  arg3        = processor->regs[XPEmulatorEReg13];
-            switch (syscall_num) {
-                case XP_EMULATOR_SYSCALL_OPEN: {
-                    assert(arg0 == -100 && "We're assuming dirfd is always AT_FDCWD");
-                    XP_EMULATOR_LOGV_SYSCALL("SYSCALL OPEN (%i, %i, %i, %i)", arg0, arg1, arg2, arg3);
-                    char     filePathBuffer[256];
-                    uint32_t numFilePathBufferBytesWritten = xp_emulator_bus_load_str(
-                      &processor->bus, (uint32_t)arg1, 8, filePathBuffer, sizeof(filePathBuffer));
-                    XP_EMULATOR_LOGV_SYSCALL(
-                      "fopen filepath: %s, flags: %i, mode: %i", filePathBuffer, (int32_t)arg2, (int32_t)arg3);
-#ifdef __clang__
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wdeprecated-declarations"
-#endif
-                    file = fopen((const char*)filePathBuffer, "r");
-#ifdef __clang__
-    #pragma clang diagnostic pop
-#endif
-                    if (file) {
-                        // we are supposed to set a0 to the file descriptor ?
-                        // f->_file is fd if unix, else is -1 !!
-                        processor->regs[XPEmulatorEReg10] = XP_EMULATOR_FD_FROM_FILE(file);
-                    }
-                    break;
-                }
-                case XP_EMULATOR_SYSCALL_CLOCKGETTIME: {
-                    XP_EMULATOR_LOGV_SYSCALL("SYSCALL CLOCKGETTIME (%i, %i, %i)", arg0, arg1, arg2);
-                    XP_EMULATOR_LOG_SYSCALL("Unimplemented syscall CLOCKGETTIME");
-                    return XP_EMULATOR_PROGRAM_EXIT_CODE_UNHANDLED_SYSCALL;
-                }
-                case XP_EMULATOR_SYSCALL_BRK: {
-                    XP_EMULATOR_LOGV_SYSCALL("SYSCALL BRK (%i, %i, %i)", arg0, arg1, arg2);
-                    XP_EMULATOR_LOG_SYSCALL("Unimplemented syscall BRK");
-                    return XP_EMULATOR_PROGRAM_EXIT_CODE_UNHANDLED_SYSCALL;
-                }
-                case XP_EMULATOR_SYSCALL_GETTIMEOFDAY: {
-                    XP_EMULATOR_LOGV_SYSCALL("SYSCALL GETTIMEOFDAY (%i, %i, %i)", arg0, arg1, arg2);
-                    XP_EMULATOR_LOG_SYSCALL("Unimplemented syscall GETTIMEOFDAY");
-                    return XP_EMULATOR_PROGRAM_EXIT_CODE_UNHANDLED_SYSCALL;
-                }
-                case XP_EMULATOR_SYSCALL_EXIT: {
-                    XP_EMULATOR_LOGV_SYSCALL("SYSCALL EXIT (%i, %i, %i)", arg0, arg1, arg2);
-                    int32_t exit_code = arg0;
-                    printf("Exit code: %i\n", exit_code);
-                    break;
-                }
-                case XP_EMULATOR_SYSCALL_FSTAT: {
-                    XP_EMULATOR_LOGV_SYSCALL("SYSCALL FSTAT (%i, %i, %i)", arg0, arg1, arg2);
-                    break;
-                }
-                case XP_EMULATOR_SYSCALL_WRITE: {
-                    if (arg0 == STDOUT_FILENO || arg0 == STDERR_FILENO) {
-                        XP_EMULATOR_LOGV_SYSCALL("SYSCALL WRITE (%i, %i, %i)", arg0, arg1, (int)((uint8_t)arg2));
-                        uint8_t*       ptr    = &processor->bus.uart.data[arg1];
-                        size_t         length = (int)((uint8_t)arg2);
-                        unsigned char* buffer = (unsigned char*)malloc(sizeof(unsigned char) * length);
-                        for (size_t i = 0; i < length; ++i) { buffer[i] = processor->bus.uart.data[arg1 + i]; }
-                        size_t return_value               = fwrite(buffer, 1, length, stdout);
-                        processor->regs[XPEmulatorEReg10] = return_value;
-                        free(buffer);
-                    }
-                    break;
-                }
-                case XP_EMULATOR_SYSCALL_READ: {
-                    XP_EMULATOR_LOGV_SYSCALL("SYSCALL READ (%i, %i, %i)", arg0, arg1, arg2);
-                    int32_t fd = (int32_t)arg0;
-                    if (fd == (int32_t)XP_EMULATOR_FD_FROM_FILE(file)) {
-                        uint32_t bufferPtrAddr = (uint32_t)arg1;
-                        uint32_t cnt           = (uint32_t)arg2;
-                        uint8_t* buff = &processor->bus.memory.ram[bufferPtrAddr - XP_EMULATOR_CONFIG_MEMORY_RAM_BASE];
-                        if (fread((void*)buff, cnt, 1, file) == 0) { processor->regs[XPEmulatorEReg10] = cnt; }
-                    }
-                    break;
-                }
-                case XP_EMULATOR_SYSCALL_LSEEK: {
-                    printf("SYSCALL LSEEK (%i, %i, %i)\n", arg0, arg1, arg2);
-                    int return_value                  = fseek(stdout, arg1, arg2);
-                    processor->regs[XPEmulatorEReg10] = return_value;
-                    break;
-                }
-                case XP_EMULATOR_SYSCALL_CLOSE: {
-                    XP_EMULATOR_LOGV_SYSCALL("SYSCALL CLOSE (%i, %i, %i)", arg0, arg1, arg2);
-                    if (file && ((uint32_t)XP_EMULATOR_FD_FROM_FILE(file)) == arg0) {
-                        fclose(file);
-                        file = NULL;
-                    }
-                    break;
-                }
-
-                default: {
-                    XP_EMULATOR_LOGV_SYSCALL("UNHANDLED SYSCALL: (%i, %i, %i)", arg0, arg1, arg2);
-                    return XP_EMULATOR_PROGRAM_EXIT_CODE_UNHANDLED_SYSCALL;
-                }
-            }
+            int result = xp_emulator_syscalls_handle(processor);
+            if (result != 0) { return result; }
         } break;
         case XPEmulatorEInstructionType_EBREAK: {
             xp_emulator_print_op("EBREAK");
@@ -782,4 +1461,288 @@ print_registers(XPEmulatorProcessor* processor)
     }
     XP_EMULATOR_LOGV("%4s: %#-20.2x\n\n", "pc", processor->pc);
 #endif
-}
\ No newline at end of file
+}
+#if defined(XP_EMULATOR_USE_F_EXTENSION)
+static int
+is_signaling_s(uint32_t bits)
+{
+    return (bits & 0x7F800000U) == 0x7F800000U && (bits & 0x007FFFFFU) != 0 && (bits & 0x00400000U) == 0;
+}
+
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+static int
+is_signaling_d(uint64_t bits)
+{
+    return (bits & 0x7FF0000000000000ULL) == 0x7FF0000000000000ULL && (bits & 0x000FFFFFFFFFFFFFULL) != 0 &&
+           (bits & 0x0008000000000000ULL) == 0;
+}
+    #endif
+
+static uint32_t
+read_f32_bits(XPEmulatorProcessor* processor, uint32_t reg)
+{
+    uint64_t bits = processor->fregs[reg];
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+    // a single that isn't NaN-boxed reads back as the canonical NaN
+    if ((bits >> 32) != 0xFFFFFFFFU) { return XP_EMULATOR_CANONICAL_NAN_S; }
+    #endif
+    return (uint32_t)bits;
+}
+
+static float
+read_f32(XPEmulatorProcessor* processor, uint32_t reg)
+{
+    uint32_t bits  = read_f32_bits(processor, reg);
+    float    value = 0.0f;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void
+write_f32_bits(XPEmulatorProcessor* processor, uint32_t reg, uint32_t bits)
+{
+    processor->fregs[reg] = 0xFFFFFFFF00000000ULL | bits;
+}
+
+static void
+write_f32(XPEmulatorProcessor* processor, uint32_t reg, float value)
+{
+    uint32_t bits = XP_EMULATOR_CANONICAL_NAN_S;
+    if (!isnan(value)) { memcpy(&bits, &value, sizeof(bits)); }
+    write_f32_bits(processor, reg, bits);
+}
+
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+static double
+read_f64(XPEmulatorProcessor* processor, uint32_t reg)
+{
+    double value = 0.0;
+    memcpy(&value, &processor->fregs[reg], sizeof(value));
+    return value;
+}
+
+static void
+write_f64(XPEmulatorProcessor* processor, uint32_t reg, double value)
+{
+    uint64_t bits = XP_EMULATOR_CANONICAL_NAN_D;
+    if (!isnan(value)) { memcpy(&bits, &value, sizeof(bits)); }
+    processor->fregs[reg] = bits;
+}
+    #endif
+
+static int
+fp_resolve_rm(XPEmulatorProcessor* processor, uint32_t rm, uint32_t* resolved)
+{
+    if (rm == XP_EMULATOR_FRM_DYN) { rm = (processor->fcsr >> 5) & 0b111; }
+    if (rm > XP_EMULATOR_FRM_RMM) { return 0; }
+    *resolved = rm;
+    return 1;
+}
+
+static int
+fp_begin(XPEmulatorProcessor* processor, uint32_t rm, int* hostRound)
+{
+    uint32_t resolved = 0;
+    if (!fp_resolve_rm(processor, rm, &resolved)) { return 0; }
+
+    switch (resolved) {
+        case XP_EMULATOR_FRM_RTZ: *hostRound = XP_EMULATOR_FE_TOWARDZERO; break;
+        case XP_EMULATOR_FRM_RDN: *hostRound = XP_EMULATOR_FE_DOWNWARD; break;
+        case XP_EMULATOR_FRM_RUP: *hostRound = XP_EMULATOR_FE_UPWARD; break;
+        // hosts have no ties-to-max-magnitude mode, RMM arithmetic rounds like RNE (conversions to int are exact)
+        default: *hostRound = FE_TONEAREST; break;
+    }
+
+    // the host thread always runs with round to nearest, only switch (and later restore) when the guest asks otherwise
+    if (*hostRound != FE_TONEAREST) { fesetround(*hostRound); }
+    feclearexcept(FE_ALL_EXCEPT);
+    return 1;
+}
+
+static void
+fp_end(XPEmulatorProcessor* processor, int hostRound)
+{
+    int raised = fetestexcept(FE_ALL_EXCEPT);
+    if (raised & XP_EMULATOR_FE_INEXACT) { processor->fcsr |= XP_EMULATOR_FFLAGS_NX; }
+    if (raised & XP_EMULATOR_FE_UNDERFLOW) { processor->fcsr |= XP_EMULATOR_FFLAGS_UF; }
+    if (raised & XP_EMULATOR_FE_OVERFLOW) { processor->fcsr |= XP_EMULATOR_FFLAGS_OF; }
+    if (raised & XP_EMULATOR_FE_DIVBYZERO) { processor->fcsr |= XP_EMULATOR_FFLAGS_DZ; }
+    if (raised & XP_EMULATOR_FE_INVALID) { processor->fcsr |= XP_EMULATOR_FFLAGS_NV; }
+
+    if (hostRound != FE_TONEAREST) { fesetround(FE_TONEAREST); }
+}
+
+static int
+fp_to_int(XPEmulatorProcessor* processor, double value, uint32_t rm, int isUnsigned, uint32_t* out)
+{
+    uint32_t resolved = 0;
+    if (!fp_resolve_rm(processor, rm, &resolved)) { return 0; }
+
+    if (isnan(value)) {
+        processor->fcsr |= XP_EMULATOR_FFLAGS_NV;
+        *out = isUnsigned ? 0xFFFFFFFFU : 0x7FFFFFFFU;
+        return 1;
+    }
+
+    // rounding is done explicitly so conversions never touch the host rounding mode
+    double rounded = value;
+    switch (resolved) {
+        case XP_EMULATOR_FRM_RTZ: rounded = trunc(value); break;
+        case XP_EMULATOR_FRM_RDN: rounded = floor(value); break;
+        case XP_EMULATOR_FRM_RUP: rounded = ceil(value); break;
+        case XP_EMULATOR_FRM_RMM: rounded = round(value); break;
+        default: rounded = nearbyint(value); break;
+    }
+
+    if (isUnsigned) {
+        if (rounded < 0.0) {
+            processor->fcsr |= XP_EMULATOR_FFLAGS_NV;
+            *out = 0;
+            return 1;
+        }
+        if (rounded > 4294967295.0) {
+            processor->fcsr |= XP_EMULATOR_FFLAGS_NV;
+            *out = 0xFFFFFFFFU;
+            return 1;
+        }
+        *out = (uint32_t)rounded;
+    } else {
+        if (rounded < -2147483648.0) {
+            processor->fcsr |= XP_EMULATOR_FFLAGS_NV;
+            *out = 0x80000000U;
+            return 1;
+        }
+        if (rounded > 2147483647.0) {
+            processor->fcsr |= XP_EMULATOR_FFLAGS_NV;
+            *out = 0x7FFFFFFFU;
+            return 1;
+        }
+        *out = (uint32_t)(int32_t)rounded;
+    }
+
+    if (rounded != value) { processor->fcsr |= XP_EMULATOR_FFLAGS_NX; }
+    return 1;
+}
+
+static uint32_t
+fp_classify(int isNegative, int fpClass, int isSignaling)
+{
+    switch (fpClass) {
+        case FP_INFINITE: return isNegative ? (1U << 0) : (1U << 7);
+        case FP_NORMAL: return isNegative ? (1U << 1) : (1U << 6);
+        case FP_SUBNORMAL: return isNegative ? (1U << 2) : (1U << 5);
+        case FP_ZERO: return isNegative ? (1U << 3) : (1U << 4);
+        default: return isSignaling ? (1U << 8) : (1U << 9);
+    }
+}
+
+static uint32_t
+fp_min_max_s(XPEmulatorProcessor* processor, uint32_t rs1, uint32_t rs2, int wantMax)
+{
+    uint32_t aBits = read_f32_bits(processor, rs1);
+    uint32_t bBits = read_f32_bits(processor, rs2);
+    float    a     = read_f32(processor, rs1);
+    float    b     = read_f32(processor, rs2);
+
+    if (is_signaling_s(aBits) || is_signaling_s(bBits)) { processor->fcsr |= XP_EMULATOR_FFLAGS_NV; }
+    if (isnan(a) && isnan(b)) { return XP_EMULATOR_CANONICAL_NAN_S; }
+    if (isnan(a)) { return bBits; }
+    if (isnan(b)) { return aBits; }
+    // equal values only differ in bits when they are -0.0 and +0.0, min picks the negative one
+    if (a == b) { return wantMax ? (aBits & bBits) : (aBits | bBits); }
+    if (wantMax) { return a > b ? aBits : bBits; }
+    return a < b ? aBits : bBits;
+}
+
+    #if defined(XP_EMULATOR_USE_D_EXTENSION)
+static uint64_t
+fp_min_max_d(XPEmulatorProcessor* processor, uint32_t rs1, uint32_t rs2, int wantMax)
+{
+    uint64_t aBits = processor->fregs[rs1];
+    uint64_t bBits = processor->fregs[rs2];
+    double   a     = read_f64(processor, rs1);
+    double   b     = read_f64(processor, rs2);
+
+    if (is_signaling_d(aBits) || is_signaling_d(bBits)) { processor->fcsr |= XP_EMULATOR_FFLAGS_NV; }
+    if (isnan(a) && isnan(b)) { return XP_EMULATOR_CANONICAL_NAN_D; }
+    if (isnan(a)) { return bBits; }
+    if (isnan(b)) { return aBits; }
+    if (a == b) { return wantMax ? (aBits & bBits) : (aBits | bBits); }
+    if (wantMax) { return a > b ? aBits : bBits; }
+    return a < b ? aBits : bBits;
+}
+    #endif
+
+static uint32_t
+fp_compare(XPEmulatorProcessor* processor, double a, double b, int hasSignalingNaN, int op)
+{
+    // FEQ is a quiet compare and only traps on signaling NaNs, FLT/FLE trap on any NaN
+    if (isnan(a) || isnan(b)) {
+        if (op != 0 || hasSignalingNaN) { processor->fcsr |= XP_EMULATOR_FFLAGS_NV; }
+        return 0;
+    }
+    switch (op) {
+        case 0: return a == b ? 1 : 0;
+        case 1: return a < b ? 1 : 0;
+        default: return a <= b ? 1 : 0;
+    }
+}
+
+#endif
+
+#if defined(XP_EMULATOR_USE_ZICSR_EXTENSION)
+static int
+execute_csr(XPEmulatorProcessor* processor, struct XPEmulatorEncodedInstruction instr)
+{
+    uint32_t previous = 0;
+    switch (instr.CSR.csr) {
+    #if defined(XP_EMULATOR_USE_F_EXTENSION)
+        case XP_EMULATOR_CSR_FFLAGS: previous = processor->fcsr & 0x1F; break;
+        case XP_EMULATOR_CSR_FRM: previous = (processor->fcsr >> 5) & 0b111; break;
+        case XP_EMULATOR_CSR_FCSR: previous = processor->fcsr & 0xFF; break;
+    #endif
+    #if defined(XP_EMULATOR_USE_ZICNTR_EXTENSION)
+        case XP_EMULATOR_CSR_CYCLE: previous = (uint32_t)processor->cycle; break;
+        case XP_EMULATOR_CSR_CYCLEH: previous = (uint32_t)(processor->cycle >> 32); break;
+        case XP_EMULATOR_CSR_TIME: previous = (uint32_t)xp_emulator_processor_time(processor); break;
+        case XP_EMULATOR_CSR_TIMEH: previous = (uint32_t)(xp_emulator_processor_time(processor) >> 32); break;
+        case XP_EMULATOR_CSR_INSTRET: previous = (uint32_t)processor->instret; break;
+        case XP_EMULATOR_CSR_INSTRETH: previous = (uint32_t)(processor->instret >> 32); break;
+    #endif
+        default: return 0;
+    }
+
+    // funct3 bit 2 selects the immediate forms where rs1 holds a zero extended 5 bit value
+    int      isImmediate = (instr.CSR.funct3 & 0b100) != 0;
+    uint32_t source      = isImmediate ? instr.CSR.rs1 : processor->regs[instr.CSR.rs1];
+    uint32_t value       = previous;
+    int      doWrite     = 1;
+    switch (instr.CSR.funct3 & 0b011) {
+        case 0b01: value = source; break;
+        case 0b10:
+            value   = previous | source;
+            doWrite = instr.CSR.rs1 != 0;
+            break;
+        default:
+            value   = previous & ~source;
+            doWrite = instr.CSR.rs1 != 0;
+            break;
+    }
+
+    if (doWrite) {
+        // csr[11:10] == 0b11 marks the read only space, the counters live there
+        if ((instr.CSR.csr >> 10) == 0b11) { return 0; }
+        switch (instr.CSR.csr) {
+    #if defined(XP_EMULATOR_USE_F_EXTENSION)
+            case XP_EMULATOR_CSR_FFLAGS: processor->fcsr = (processor->fcsr & ~0x1FU) | (value & 0x1F); break;
+            case XP_EMULATOR_CSR_FRM: processor->fcsr = (processor->fcsr & ~0xE0U) | ((value & 0b111) << 5); break;
+            case XP_EMULATOR_CSR_FCSR: processor->fcsr = value & 0xFF; break;
+    #endif
+            default: break;
+        }
+    }
+
+    processor->regs[instr.CSR.rd] = previous;
+    return 1;
+}
+#endif
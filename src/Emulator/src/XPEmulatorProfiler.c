@@ -0,0 +1,379 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Emulator/XPEmulatorProfiler.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define XP_EMULATOR_PROFILER_INITIAL_CAPACITY 1024U
+
+static uint32_t
+hash_pc(uint32_t pc)
+{
+    // instructions are at least 2 byte aligned, fold the low bit away before mixing
+    return (pc >> 1) * 0x9E3779B1U;
+}
+
+static uint64_t
+hash_frames(const uint32_t* frames, uint32_t depth)
+{
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (uint32_t i = 0; i < depth; ++i) {
+        hash ^= frames[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static void
+grow_pc_buckets(XPEmulatorProfiler* profiler)
+{
+    uint32_t                  oldCapacity = profiler->pcCapacity;
+    XPEmulatorProfilerPcHits* oldBuckets  = profiler->pcBuckets;
+
+    profiler->pcCapacity = oldCapacity ? oldCapacity * 2 : XP_EMULATOR_PROFILER_INITIAL_CAPACITY;
+    profiler->pcBuckets  = calloc(profiler->pcCapacity, sizeof(XPEmulatorProfilerPcHits));
+
+    uint32_t mask = profiler->pcCapacity - 1;
+    for (uint32_t i = 0; i < oldCapacity; ++i) {
+        if (oldBuckets[i].hits == 0) { continue; }
+        uint32_t slot = hash_pc(oldBuckets[i].pc) & mask;
+        while (profiler->pcBuckets[slot].hits != 0) { slot = (slot + 1) & mask; }
+        profiler->pcBuckets[slot] = oldBuckets[i];
+    }
+    free(oldBuckets);
+}
+
+static void
+grow_stack_buckets(XPEmulatorProfiler* profiler)
+{
+    uint32_t                     oldCapacity = profiler->stackCapacity;
+    XPEmulatorProfilerStackHits* oldBuckets  = profiler->stackBuckets;
+
+    profiler->stackCapacity = oldCapacity ? oldCapacity * 2 : XP_EMULATOR_PROFILER_INITIAL_CAPACITY;
+    profiler->stackBuckets  = calloc(profiler->stackCapacity, sizeof(XPEmulatorProfilerStackHits));
+
+    uint32_t mask = profiler->stackCapacity - 1;
+    for (uint32_t i = 0; i < oldCapacity; ++i) {
+        if (oldBuckets[i].hits == 0) { continue; }
+        uint32_t slot = (uint32_t)oldBuckets[i].hash & mask;
+        while (profiler->stackBuckets[slot].hits != 0) { slot = (slot + 1) & mask; }
+        profiler->stackBuckets[slot] = oldBuckets[i];
+    }
+    free(oldBuckets);
+}
+
+static void
+record_pc(XPEmulatorProfiler* profiler, uint32_t pc)
+{
+    // keep the load factor under 3/4
+    if ((profiler->pcCount + 1) * 4 > profiler->pcCapacity * 3) { grow_pc_buckets(profiler); }
+
+    uint32_t mask = profiler->pcCapacity - 1;
+    uint32_t slot = hash_pc(pc) & mask;
+    while (profiler->pcBuckets[slot].hits != 0 && profiler->pcBuckets[slot].pc != pc) { slot = (slot + 1) & mask; }
+    if (profiler->pcBuckets[slot].hits == 0) {
+        profiler->pcBuckets[slot].pc = pc;
+        ++profiler->pcCount;
+    }
+    ++profiler->pcBuckets[slot].hits;
+}
+
+static void
+record_stack(XPEmulatorProfiler* profiler, uint32_t pc)
+{
+    // the outermost return address stands in for the function that was running when profiling started
+    uint32_t depth = profiler->callDepth ? profiler->callDepth + 2 : 1;
+
+    // stage the stack at the end of the pool, it is only kept when it turns out to be a new one
+    if (profiler->framePoolSize + depth > profiler->framePoolCapacity) {
+        size_t capacity = profiler->framePoolCapacity ? profiler->framePoolCapacity * 2
+                                                       : XP_EMULATOR_PROFILER_INITIAL_CAPACITY;
+        while (capacity < profiler->framePoolSize + depth) { capacity *= 2; }
+        profiler->framePool         = realloc(profiler->framePool, capacity * sizeof(uint32_t));
+        profiler->framePoolCapacity = capacity;
+    }
+    uint32_t* frames = profiler->framePool + profiler->framePoolSize;
+    if (profiler->callDepth) {
+        // step back onto the call instruction so a call at the very end of a function stays inside it
+        frames[0] = profiler->callStack[0].returnAddress - 1;
+        for (uint32_t i = 0; i < profiler->callDepth; ++i) { frames[i + 1] = profiler->callStack[i].entry; }
+    }
+    frames[depth - 1] = pc;
+
+    if ((profiler->stackCount + 1) * 4 > profiler->stackCapacity * 3) { grow_stack_buckets(profiler); }
+
+    uint64_t hash = hash_frames(frames, depth);
+    uint32_t mask = profiler->stackCapacity - 1;
+    uint32_t slot = (uint32_t)hash & mask;
+    while (profiler->stackBuckets[slot].hits != 0) {
+        const XPEmulatorProfilerStackHits* bucket = &profiler->stackBuckets[slot];
+        if (bucket->hash == hash && bucket->depth == depth &&
+            memcmp(profiler->framePool + bucket->framesIndex, frames, depth * sizeof(uint32_t)) == 0) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    XPEmulatorProfilerStackHits* bucket = &profiler->stackBuckets[slot];
+    if (bucket->hits == 0) {
+        bucket->hash        = hash;
+        bucket->depth       = depth;
+        bucket->framesIndex = profiler->framePoolSize;
+        profiler->framePoolSize += depth;
+        ++profiler->stackCount;
+    }
+    ++bucket->hits;
+}
+
+static int
+compare_pc_hits(const void* a, const void* b)
+{
+    const XPEmulatorProfilerPcHits* lhs = (const XPEmulatorProfilerPcHits*)a;
+    const XPEmulatorProfilerPcHits* rhs = (const XPEmulatorProfilerPcHits*)b;
+    if (lhs->hits != rhs->hits) { return lhs->hits > rhs->hits ? -1 : 1; }
+    return (lhs->pc > rhs->pc) - (lhs->pc < rhs->pc);
+}
+
+static int
+compare_function_hits(const void* a, const void* b)
+{
+    const XPEmulatorProfilerFunctionHits* lhs = (const XPEmulatorProfilerFunctionHits*)a;
+    const XPEmulatorProfilerFunctionHits* rhs = (const XPEmulatorProfilerFunctionHits*)b;
+    if (lhs->hits != rhs->hits) { return lhs->hits > rhs->hits ? -1 : 1; }
+    return (lhs->address > rhs->address) - (lhs->address < rhs->address);
+}
+
+static const ElfSymbol*
+find_symbol(const RiscvElfLoader* loader, uint32_t address)
+{
+    return loader ? xp_emulator_elf_loader_find_symbol(loader, address) : NULL;
+}
+
+typedef struct FoldedLine
+{
+    char*    text;
+    uint64_t hits;
+} FoldedLine;
+
+static int
+compare_folded_lines(const void* a, const void* b)
+{
+    return strcmp(((const FoldedLine*)a)->text, ((const FoldedLine*)b)->text);
+}
+
+// appends a frame name to a growable string, returns 0 on allocation failure
+static int
+append_frame(char** text, size_t* length, size_t* capacity, const ElfSymbol* symbol, uint32_t address)
+{
+    char        unknown[16];
+    const char* name = symbol ? symbol->name : unknown;
+    if (!symbol) { snprintf(unknown, sizeof(unknown), "0x%08x", address); }
+
+    size_t nameLength = strlen(name);
+    size_t required   = *length + nameLength + 2; // separator and terminator
+    if (required > *capacity) {
+        size_t newCapacity = *capacity ? *capacity : 64;
+        while (newCapacity < required) { newCapacity *= 2; }
+        char* grown = realloc(*text, newCapacity);
+        if (!grown) { return 0; }
+        *text     = grown;
+        *capacity = newCapacity;
+    }
+    if (*length > 0) { (*text)[(*length)++] = ';'; }
+    memcpy(*text + *length, name, nameLength + 1);
+    *length += nameLength;
+    return 1;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_initialize(XPEmulatorProfiler* profiler, uint32_t interval)
+{
+    memset(profiler, 0, sizeof(XPEmulatorProfiler));
+    profiler->interval  = interval ? interval : 1;
+    profiler->countdown = profiler->interval;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_reset(XPEmulatorProfiler* profiler)
+{
+    // the shadow call stack describes the running guest, only the histograms are dropped
+    if (profiler->pcBuckets) {
+        memset(profiler->pcBuckets, 0, profiler->pcCapacity * sizeof(XPEmulatorProfilerPcHits));
+    }
+    if (profiler->stackBuckets) {
+        memset(profiler->stackBuckets, 0, profiler->stackCapacity * sizeof(XPEmulatorProfilerStackHits));
+    }
+    profiler->pcCount       = 0;
+    profiler->stackCount    = 0;
+    profiler->framePoolSize = 0;
+    profiler->totalSamples  = 0;
+    profiler->countdown     = profiler->interval;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_sample(XPEmulatorProfiler* profiler, uint32_t pc)
+{
+    if (--profiler->countdown != 0) { return; }
+    profiler->countdown = profiler->interval;
+
+    ++profiler->totalSamples;
+    record_pc(profiler, pc);
+    record_stack(profiler, pc);
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_on_call(XPEmulatorProfiler* profiler, uint32_t entry, uint32_t returnAddress)
+{
+    if (profiler->callDepth == XP_EMULATOR_CONFIG_PROFILER_MAX_CALL_DEPTH) {
+        ++profiler->droppedCalls;
+        return;
+    }
+    profiler->callStack[profiler->callDepth].entry         = entry;
+    profiler->callStack[profiler->callDepth].returnAddress = returnAddress;
+    ++profiler->callDepth;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_on_return(XPEmulatorProfiler* profiler, uint32_t target)
+{
+    // calls past max depth are always the innermost ones, their returns come first
+    if (profiler->droppedCalls > 0) {
+        --profiler->droppedCalls;
+        return;
+    }
+    // unwind to the frame the return lands in, this also recovers from frames skipped by longjmp and the like,
+    // returns from frames entered before profiling started match nothing and are ignored
+    for (uint32_t depth = profiler->callDepth; depth > 0; --depth) {
+        if (profiler->callStack[depth - 1].returnAddress == target) {
+            profiler->callDepth = depth - 1;
+            return;
+        }
+    }
+}
+
+XP_EMULATOR_EXTERN size_t
+xp_emulator_profiler_pc_histogram(const XPEmulatorProfiler* profiler, XPEmulatorProfilerPcHits* out, size_t capacity)
+{
+    if (profiler->pcCount == 0 || capacity == 0) { return 0; }
+
+    XPEmulatorProfilerPcHits* sorted = malloc(profiler->pcCount * sizeof(XPEmulatorProfilerPcHits));
+    if (!sorted) { return 0; }
+
+    size_t count = 0;
+    for (uint32_t i = 0; i < profiler->pcCapacity; ++i) {
+        if (profiler->pcBuckets[i].hits != 0) { sorted[count++] = profiler->pcBuckets[i]; }
+    }
+    qsort(sorted, count, sizeof(XPEmulatorProfilerPcHits), compare_pc_hits);
+
+    if (count > capacity) { count = capacity; }
+    memcpy(out, sorted, count * sizeof(XPEmulatorProfilerPcHits));
+    free(sorted);
+    return count;
+}
+
+XP_EMULATOR_EXTERN size_t
+xp_emulator_profiler_function_histogram(const XPEmulatorProfiler*       profiler,
+                                        const RiscvElfLoader*           loader,
+                                        XPEmulatorProfilerFunctionHits* out,
+                                        size_t                          capacity)
+{
+    if (profiler->pcCount == 0 || capacity == 0) { return 0; }
+
+    // one slot per symbol plus a trailing one for unknown code
+    size_t                          numSymbols = loader ? (size_t)loader->num_symbols : 0;
+    XPEmulatorProfilerFunctionHits* functions  = calloc(numSymbols + 1, sizeof(XPEmulatorProfilerFunctionHits));
+    if (!functions) { return 0; }
+
+    for (uint32_t i = 0; i < profiler->pcCapacity; ++i) {
+        const XPEmulatorProfilerPcHits* bucket = &profiler->pcBuckets[i];
+        if (bucket->hits == 0) { continue; }
+        const ElfSymbol* symbol = find_symbol(loader, bucket->pc);
+        size_t           index  = symbol ? (size_t)(symbol - loader->symbols) : numSymbols;
+        functions[index].hits += bucket->hits;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i <= numSymbols; ++i) {
+        if (functions[i].hits == 0) { continue; }
+        functions[count].hits    = functions[i].hits;
+        functions[count].name    = i < numSymbols ? loader->symbols[i].name : NULL;
+        functions[count].address = i < numSymbols ? loader->symbols[i].address : 0;
+        ++count;
+    }
+    qsort(functions, count, sizeof(XPEmulatorProfilerFunctionHits), compare_function_hits);
+
+    if (count > capacity) { count = capacity; }
+    memcpy(out, functions, count * sizeof(XPEmulatorProfilerFunctionHits));
+    free(functions);
+    return count;
+}
+
+XP_EMULATOR_EXTERN int
+xp_emulator_profiler_write_folded(const XPEmulatorProfiler* profiler, const RiscvElfLoader* loader, FILE* file)
+{
+    if (profiler->stackCount == 0) { return 0; }
+
+    // stacks are bucketed by address, different PCs of the same function fold into one line once symbolized
+    FoldedLine* lines = calloc(profiler->stackCount, sizeof(FoldedLine));
+    if (!lines) { return -1; }
+
+    int    result    = 0;
+    size_t lineCount = 0;
+    for (uint32_t i = 0; i < profiler->stackCapacity && result == 0; ++i) {
+        const XPEmulatorProfilerStackHits* bucket = &profiler->stackBuckets[i];
+        if (bucket->hits == 0) { continue; }
+
+        FoldedLine*      line     = &lines[lineCount++];
+        size_t           length   = 0;
+        size_t           capacity = 0;
+        const uint32_t*  frames   = profiler->framePool + bucket->framesIndex;
+        const ElfSymbol* previous = NULL;
+        line->hits                = bucket->hits;
+        for (uint32_t f = 0; f < bucket->depth; ++f) {
+            const ElfSymbol* symbol = find_symbol(loader, frames[f]);
+            // the sampled pc usually sits in the function of the innermost call, don't repeat it
+            if (f + 1 == bucket->depth && f > 0 && symbol && symbol == previous) { break; }
+            if (!append_frame(&line->text, &length, &capacity, symbol, frames[f])) {
+                result = -1;
+                break;
+            }
+            previous = symbol;
+        }
+    }
+
+    if (result == 0) {
+        qsort(lines, lineCount, sizeof(FoldedLine), compare_folded_lines);
+        for (size_t i = 0; i < lineCount && result == 0; ++i) {
+            uint64_t hits = lines[i].hits;
+            while (i + 1 < lineCount && strcmp(lines[i].text, lines[i + 1].text) == 0) { hits += lines[++i].hits; }
+            if (fprintf(file, "%s %llu\n", lines[i].text, (unsigned long long)hits) < 0) { result = -1; }
+        }
+    }
+
+    for (size_t i = 0; i < lineCount; ++i) { free(lines[i].text); }
+    free(lines);
+    return result;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_profiler_finalize(XPEmulatorProfiler* profiler)
+{
+    free(profiler->pcBuckets);
+    free(profiler->stackBuckets);
+    free(profiler->framePool);
+    memset(profiler, 0, sizeof(XPEmulatorProfiler));
+}
@@ -0,0 +1,296 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Emulator/XPEmulatorLogger.h>
+#include <Emulator/XPEmulatorProcessor.h>
+#include <Emulator/XPEmulatorSyscalls.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static void
+set_result(XPEmulatorProcessor* processor, int32_t value)
+{
+    processor->regs[XPEmulatorEReg10] = (uint32_t)value;
+}
+
+static FILE*
+file_from_fd(XPEmulatorSyscalls* syscalls, int32_t fd)
+{
+    if (fd <= XP_EMULATOR_STDERR_FILENO || fd >= (int32_t)XP_EMULATOR_CONFIG_MAX_OPEN_FILES) { return NULL; }
+    return syscalls->files[fd];
+}
+
+// guest buffers are handed to the host file calls directly, no bouncing through a temporary
+static uint8_t*
+guest_buffer(XPEmulatorProcessor* processor, uint32_t address, uint32_t length, int writable)
+{
+    uint8_t* buffer = xp_emulator_memory_translate(&processor->bus.memory, address, length, writable);
+    if (!buffer && !writable) {
+        buffer = (uint8_t*)xp_emulator_file_mapping_translate(&processor->bus.fileMapping, address, length);
+    }
+    return buffer;
+}
+
+static void
+store_u64(XPEmulatorProcessor* processor, uint32_t address, uint64_t value)
+{
+    xp_emulator_bus_store(&processor->bus, address, 32, (uint32_t)value);
+    xp_emulator_bus_store(&processor->bus, address + 4, 32, (uint32_t)(value >> 32));
+}
+
+// microseconds since the processor started, derived from retired cycles so guests see the same time on every run
+static uint64_t
+guest_time_us(XPEmulatorProcessor* processor)
+{
+#if defined(XP_EMULATOR_USE_ZICNTR_EXTENSION)
+    return xp_emulator_processor_time(processor) * (1000000ULL / XP_EMULATOR_CONFIG_TIMER_FREQUENCY_HZ);
+#else
+    (void)processor;
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000ULL;
+#endif
+}
+
+static const char*
+fopen_mode(int32_t flags)
+{
+    int32_t access = flags & XP_EMULATOR_O_ACCMODE;
+    if (flags & XP_EMULATOR_O_APPEND) { return access == XP_EMULATOR_O_RDWR ? "a+b" : "ab"; }
+    if (access == XP_EMULATOR_O_RDONLY) { return "rb"; }
+    if (flags & (XP_EMULATOR_O_CREAT | XP_EMULATOR_O_TRUNC)) { return access == XP_EMULATOR_O_RDWR ? "w+b" : "wb"; }
+    return "r+b";
+}
+
+static int32_t
+sys_open(XPEmulatorProcessor* processor, uint32_t pathAddress, int32_t flags)
+{
+    XPEmulatorSyscalls* syscalls = &processor->syscalls;
+    int32_t             fd       = XP_EMULATOR_STDERR_FILENO + 1;
+    while (fd < (int32_t)XP_EMULATOR_CONFIG_MAX_OPEN_FILES && syscalls->files[fd]) { ++fd; }
+    if (fd == (int32_t)XP_EMULATOR_CONFIG_MAX_OPEN_FILES) { return -XP_EMULATOR_EMFILE; }
+
+    char path[256];
+    xp_emulator_bus_load_str(&processor->bus, pathAddress, 8, path, sizeof(path) - 1);
+    XP_EMULATOR_LOGV_SYSCALL("open %s, flags: %i", path, flags);
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+    FILE* file = fopen(path, fopen_mode(flags));
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
+    if (!file) { return -XP_EMULATOR_ENOENT; }
+    syscalls->files[fd] = file;
+    return fd;
+}
+
+static int32_t
+sys_read(XPEmulatorProcessor* processor, int32_t fd, uint32_t address, uint32_t count, int64_t offset)
+{
+    // the guest runtime reads stdin from the uart itself
+    if (fd == XP_EMULATOR_STDIN_FILENO) { return 0; }
+    FILE* file = file_from_fd(&processor->syscalls, fd);
+    if (!file) { return -XP_EMULATOR_EBADF; }
+    uint8_t* buffer = guest_buffer(processor, address, count, 1);
+    if (!buffer) { return -XP_EMULATOR_EFAULT; }
+
+    // pread leaves the file position where it was
+    long position = 0;
+    if (offset >= 0) {
+        position = ftell(file);
+        if (fseek(file, (long)offset, SEEK_SET) != 0) { return -XP_EMULATOR_EINVAL; }
+    }
+    size_t numRead = fread(buffer, 1, count, file);
+    if (offset >= 0) { fseek(file, position, SEEK_SET); }
+    if (numRead == 0 && ferror(file)) {
+        clearerr(file);
+        return -XP_EMULATOR_EIO;
+    }
+    return (int32_t)numRead;
+}
+
+static int32_t
+sys_write(XPEmulatorProcessor* processor, int32_t fd, uint32_t address, uint32_t count)
+{
+    FILE* file = NULL;
+    if (fd == XP_EMULATOR_STDOUT_FILENO) {
+        file = stdout;
+    } else if (fd == XP_EMULATOR_STDERR_FILENO) {
+        file = stderr;
+    } else {
+        file = file_from_fd(&processor->syscalls, fd);
+    }
+    if (!file) { return -XP_EMULATOR_EBADF; }
+    const uint8_t* buffer = guest_buffer(processor, address, count, 0);
+    if (!buffer) { return -XP_EMULATOR_EFAULT; }
+    return (int32_t)fwrite(buffer, 1, count, file);
+}
+
+static int32_t
+sys_lseek(XPEmulatorProcessor* processor, int32_t fd, int32_t offset, int32_t whence)
+{
+    FILE* file = file_from_fd(&processor->syscalls, fd);
+    if (!file) { return -XP_EMULATOR_EBADF; }
+    if (fseek(file, offset, whence) != 0) { return -XP_EMULATOR_EINVAL; }
+    return (int32_t)ftell(file);
+}
+
+static int32_t
+sys_close(XPEmulatorProcessor* processor, int32_t fd)
+{
+    FILE* file = file_from_fd(&processor->syscalls, fd);
+    if (!file) { return -XP_EMULATOR_EBADF; }
+    fclose(file);
+    processor->syscalls.files[fd] = NULL;
+    return 0;
+}
+
+// linux brk, returns the new break on success and the current one when the request can't be met
+static int32_t
+sys_brk(XPEmulatorProcessor* processor, uint32_t address)
+{
+    if (address >= XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE &&
+        address <= XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE + XP_EMULATOR_CONFIG_MEMORY_HEAP_SIZE) {
+        processor->syscalls.programBreak = address;
+    }
+    return (int32_t)processor->syscalls.programBreak;
+}
+
+static int32_t
+sys_mmap(XPEmulatorProcessor* processor, uint32_t length, int32_t prot, int32_t fd, uint32_t offset)
+{
+    // only read only file backed mappings, the guest sees the host pages without a copy
+    if (prot & XP_EMULATOR_PROT_WRITE) { return -XP_EMULATOR_EACCES; }
+    FILE* file = file_from_fd(&processor->syscalls, fd);
+    if (!file) { return -XP_EMULATOR_EBADF; }
+    fflush(file);
+    uint32_t address = xp_emulator_file_mapping_map(
+      &processor->bus.fileMapping, file, (uint64_t)offset * XP_EMULATOR_MMAP_OFFSET_UNIT, length);
+    return address ? (int32_t)address : -XP_EMULATOR_ENOMEM;
+}
+
+static int32_t
+sys_clock_gettime(XPEmulatorProcessor* processor, uint32_t address)
+{
+    // struct timespec64 { int64_t tv_sec; int64_t tv_nsec; }
+    uint64_t us = guest_time_us(processor);
+    store_u64(processor, address, us / 1000000ULL);
+    store_u64(processor, address + 8, (us % 1000000ULL) * 1000ULL);
+    return 0;
+}
+
+static int32_t
+sys_gettimeofday(XPEmulatorProcessor* processor, uint32_t address)
+{
+    // struct timeval { int64_t tv_sec; long tv_usec; }, padded to 16 bytes
+    if (address == 0) { return 0; }
+    uint64_t us = guest_time_us(processor);
+    store_u64(processor, address, us / 1000000ULL);
+    store_u64(processor, address + 8, us % 1000000ULL);
+    return 0;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_syscalls_initialize(XPEmulatorSyscalls* syscalls)
+{
+    memset(syscalls->files, 0, sizeof(syscalls->files));
+    syscalls->programBreak = XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE;
+    syscalls->count        = 0;
+}
+
+XP_EMULATOR_EXTERN int
+xp_emulator_syscalls_handle(struct XPEmulatorProcessor* processor)
+{
+    uint32_t number = processor->regs[XPEmulatorEReg17];
+    uint32_t arg0   = processor->regs[XPEmulatorEReg10];
+    uint32_t arg1   = processor->regs[XPEmulatorEReg11];
+    uint32_t arg2   = processor->regs[XPEmulatorEReg12];
+    uint32_t arg3   = processor->regs[XPEmulatorEReg13];
+    uint32_t arg4   = processor->regs[XPEmulatorEReg14];
+    uint32_t arg5   = processor->regs[XPEmulatorEReg15];
+    XP_EMULATOR_LOGV_SYSCALL("SYSCALL %u (%i, %i, %i, %i)", number, arg0, arg1, arg2, arg3);
+    ++processor->syscalls.count;
+
+    switch (number) {
+        case XP_EMULATOR_SYSCALL_OPEN: {
+            // arg0 is dirfd, always AT_FDCWD from the guest runtime
+            set_result(processor, sys_open(processor, arg1, (int32_t)arg2));
+        } break;
+        case XP_EMULATOR_SYSCALL_READ: {
+            set_result(processor, sys_read(processor, (int32_t)arg0, arg1, arg2, -1));
+        } break;
+        case XP_EMULATOR_SYSCALL_PREAD: {
+            // the 64 bit offset comes split over a3 (low) and a4 (high)
+            int64_t offset = (int64_t)(((uint64_t)arg4 << 32) | arg3);
+            if (offset < 0) {
+                set_result(processor, -XP_EMULATOR_EINVAL);
+            } else {
+                set_result(processor, sys_read(processor, (int32_t)arg0, arg1, arg2, offset));
+            }
+        } break;
+        case XP_EMULATOR_SYSCALL_WRITE: {
+            set_result(processor, sys_write(processor, (int32_t)arg0, arg1, arg2));
+        } break;
+        case XP_EMULATOR_SYSCALL_LSEEK: {
+            set_result(processor, sys_lseek(processor, (int32_t)arg0, (int32_t)arg1, (int32_t)arg2));
+        } break;
+        case XP_EMULATOR_SYSCALL_CLOSE: {
+            set_result(processor, sys_close(processor, (int32_t)arg0));
+        } break;
+        case XP_EMULATOR_SYSCALL_FSTAT: {
+            int32_t fd    = (int32_t)arg0;
+            int     valid = fd <= XP_EMULATOR_STDERR_FILENO || file_from_fd(&processor->syscalls, fd);
+            set_result(processor, valid ? 0 : -XP_EMULATOR_EBADF);
+        } break;
+        case XP_EMULATOR_SYSCALL_BRK: {
+            set_result(processor, sys_brk(processor, arg0));
+        } break;
+        case XP_EMULATOR_SYSCALL_MMAP: {
+            // arg0 (hint) and arg3 (flags) don't matter for a read only private view
+            set_result(processor, sys_mmap(processor, arg1, (int32_t)arg2, (int32_t)arg4, arg5));
+        } break;
+        case XP_EMULATOR_SYSCALL_MUNMAP: {
+            int result = xp_emulator_file_mapping_unmap(&processor->bus.fileMapping, arg0);
+            set_result(processor, result == 0 ? 0 : -XP_EMULATOR_EINVAL);
+        } break;
+        case XP_EMULATOR_SYSCALL_CLOCKGETTIME: {
+            set_result(processor, sys_clock_gettime(processor, arg1));
+        } break;
+        case XP_EMULATOR_SYSCALL_GETTIMEOFDAY: {
+            set_result(processor, sys_gettimeofday(processor, arg0));
+        } break;
+        case XP_EMULATOR_SYSCALL_EXIT: {
+            printf("Exit code: %i\n", (int32_t)arg0);
+        } break;
+
+        default: {
+            XP_EMULATOR_LOGV_SYSCALL("UNHANDLED SYSCALL: %u", number);
+            return XP_EMULATOR_PROGRAM_EXIT_CODE_UNHANDLED_SYSCALL;
+        }
+    }
+    return 0;
+}
+
+XP_EMULATOR_EXTERN void
+xp_emulator_syscalls_finalize(XPEmulatorSyscalls* syscalls)
+{
+    for (uint32_t fd = 0; fd < XP_EMULATOR_CONFIG_MAX_OPEN_FILES; ++fd) {
+        if (syscalls->files[fd]) { fclose(syscalls->files[fd]); }
+    }
+    memset(syscalls->files, 0, sizeof(syscalls->files));
+}
@@ -2,7 +2,8 @@ set(CMAKE_SYSTEM_NAME Generic)
 set(CMAKE_SYSTEM_PROCESSOR riscv32)
 
 # Set the toolchain prefix
-set(RISCV_GCC_TOOLCHAIN_PREFIX "${CMAKE_CURRENT_SOURCE_DIR}/../thirdparty/riscv-gnu-toolchain/install32/bin/riscv32-unknown-elf-")
+set(RISCV_GCC_TOOLCHAIN_INSTALL_DIR "${CMAKE_CURRENT_SOURCE_DIR}/../thirdparty/riscv-gnu-toolchain/install32")
+set(RISCV_GCC_TOOLCHAIN_PREFIX "${RISCV_GCC_TOOLCHAIN_INSTALL_DIR}/bin/riscv32-unknown-elf-")
 
 # Specify compilers
 set(CMAKE_C_COMPILER "${RISCV_GCC_TOOLCHAIN_PREFIX}gcc")
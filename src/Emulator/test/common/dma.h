@@ -0,0 +1,60 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+// SAME AS EMULATOR //
+#define DMA_BASE        0x08000100
+#define DMA_DESCRIPTORS *((volatile uint32_t*)(DMA_BASE + 0x00)) // Guest address of the first descriptor
+#define DMA_COUNT       *((volatile uint32_t*)(DMA_BASE + 0x04)) // Number of descriptors
+#define DMA_DOORBELL    *((volatile uint32_t*)(DMA_BASE + 0x08)) // Any store submits the run
+#define DMA_STATUS      *((volatile uint32_t*)(DMA_BASE + 0x0C)) // Status of the last run
+#define DMA_ERROR_INDEX *((volatile uint32_t*)(DMA_BASE + 0x14)) // Failing descriptor of the last run
+
+#define DMA_STATUS_BUSY  1
+#define DMA_STATUS_DONE  2
+#define DMA_STATUS_ERROR 3
+
+#define DMA_KIND_COPY       0
+#define DMA_KIND_FILL       1
+#define DMA_KIND_HOST_READ  2
+#define DMA_KIND_HOST_WRITE 3
+#define DMA_KIND(KIND, SLOT) ((KIND) | ((SLOT) << 8))
+
+#define DMA_SLOT_VERTICES  0
+#define DMA_SLOT_NORMALS   1
+#define DMA_SLOT_TEXCOORDS 2
+#define DMA_SLOT_INDICES   3
+#define DMA_SLOT_TEXTURE   4
+
+typedef struct dma_descriptor
+{
+    uint32_t src; // guest address, fill byte or byte offset into the host buffer
+    uint32_t dst; // guest address or byte offset into the host buffer
+    uint32_t length;
+    uint32_t kind;
+} dma_descriptor;
+
+// submits a run of descriptors and waits for it, returns the failing descriptor index or -1
+static inline int
+dma_submit(const dma_descriptor* descriptors, uint32_t count)
+{
+    DMA_DESCRIPTORS = (uint32_t)(uintptr_t)descriptors;
+    DMA_COUNT       = count;
+    DMA_DOORBELL    = 1;
+    while (DMA_STATUS == DMA_STATUS_BUSY) {}
+    return DMA_STATUS == DMA_STATUS_ERROR ? (int)DMA_ERROR_INDEX : -1;
+}
@@ -21,10 +21,16 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-XPEXTERN char _start_heap;
-XPEXTERN char _end_heap;
-
-static char* heap_ptr = &_start_heap;
+// the emulator reports failures as negated errno values like linux does
+static int
+syscall_result(int32_t ret)
+{
+    if (ret < 0 && ret > -4096) {
+        errno = -ret;
+        return -1;
+    }
+    return ret;
+}
 
 XPEXTERN uint32_t
 riscv_syscall1(uint32_t num, uint32_t arg0)
@@ -88,6 +94,44 @@ riscv_syscall4(uint32_t num, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32
     return ret;
 }
 
+XPEXTERN uint32_t
+riscv_syscall6(uint32_t num, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4, uint32_t arg5)
+{
+    register uint32_t a0 asm("a0") = arg0;
+    register uint32_t a1 asm("a1") = arg1;
+    register uint32_t a2 asm("a2") = arg2;
+    register uint32_t a3 asm("a3") = arg3;
+    register uint32_t a4 asm("a4") = arg4;
+    register uint32_t a5 asm("a5") = arg5;
+    register uint32_t a7 asm("a7") = num;
+    asm volatile("ecall" : "+r"(a0) : "r"(a1), "r"(a2), "r"(a3), "r"(a4), "r"(a5), "r"(a7) : "memory");
+    return a0;
+}
+
+XPEXTERN int
+riscv_pread(int fd, void* buffer, uint32_t count, uint32_t offset)
+{
+    return syscall_result(riscv_syscall6(SYSCALL_PREAD, fd, (uint32_t)buffer, count, offset, 0, 0));
+}
+
+XPEXTERN const void*
+riscv_mmap(int fd, uint32_t length, uint32_t offset)
+{
+    // PROT_READ, MAP_PRIVATE, offset in 4096 byte units
+    int32_t ret = (int32_t)riscv_syscall6(SYSCALL_MMAP, 0, length, 0x1, 0x2, fd, offset / 4096);
+    if (ret < 0 && ret > -4096) {
+        errno = -ret;
+        return (const void*)-1;
+    }
+    return (const void*)ret;
+}
+
+XPEXTERN int
+riscv_munmap(const void* address, uint32_t length)
+{
+    return syscall_result(riscv_syscall2(SYSCALL_MUNMAP, (uint32_t)address, length));
+}
+
 XPEXTERN void
 __dso_handle()
 {
@@ -98,9 +142,7 @@ _close(int __fd)
 {
     DBG_PRNT("_close");
 
-    int fd = riscv_syscall1(SYSCALL_CLOSE, __fd);
-
-    return fd;
+    return syscall_result(riscv_syscall1(SYSCALL_CLOSE, __fd));
 }
 XPEXTERN int
 _execve(const char* __f, char* const* __arg, char* const* __env)
@@ -186,8 +228,7 @@ _open(const char* __path, int __flag, int __m)
 {
     DBG_PRNT("_open");
     // assuming -100 -> AT_FDCWD (not really used in this emulator)
-    int fd = riscv_syscall4(SYSCALL_OPEN, -100, (uint32_t)__path, (uint32_t)__flag, (uint32_t)__m);
-    return fd;
+    return syscall_result(riscv_syscall4(SYSCALL_OPEN, -100, (uint32_t)__path, (uint32_t)__flag, (uint32_t)__m));
 }
 XPEXTERN _ssize_t
 _read(int __fd, void* __buff, size_t __cnt)
@@ -207,7 +248,7 @@ _read(int __fd, void* __buff, size_t __cnt)
         return i;
     }
 
-    return riscv_syscall3(SYSCALL_READ, __fd, (uint32_t)__buff, (uint32_t)__cnt);
+    return syscall_result(riscv_syscall3(SYSCALL_READ, __fd, (uint32_t)__buff, (uint32_t)__cnt));
 }
 XPEXTERN int
 _rename(const char* __old, const char* __new)
@@ -220,13 +261,15 @@ XPEXTERN void*
 _sbrk(ptrdiff_t __incr)
 {
     DBG_PRNT("_sbrk");
-    if (heap_ptr + __incr > &_end_heap) {
+    static uint32_t heap_end = 0;
+    if (heap_end == 0) { heap_end = riscv_syscall1(SYSCALL_BRK, 0); }
+    uint32_t prev_end_heap = heap_end;
+    if (riscv_syscall1(SYSCALL_BRK, prev_end_heap + __incr) != prev_end_heap + __incr) {
         errno = ENOMEM;
         return (void*)-1;
     }
-    char* prev_end_heap = heap_ptr;
-    heap_ptr += __incr;
-    return prev_end_heap;
+    heap_end += __incr;
+    return (void*)prev_end_heap;
 }
 XPEXTERN int
 _stat(const char* __path, struct stat* __buff)
@@ -262,7 +305,7 @@ _write(int __fd, const void* __buff, size_t __cnt)
     DBG_PRNT("_write");
     if (__fd != STDOUT_FILENO && __fd != STDERR_FILENO) {
         // handle writing to file
-        return riscv_syscall3(SYSCALL_WRITE, __fd, (uint32_t)__buff, (uint32_t)__cnt);
+        return syscall_result(riscv_syscall3(SYSCALL_WRITE, __fd, (uint32_t)__buff, (uint32_t)__cnt));
     }
 
     // handle stdout and stderr
@@ -18,10 +18,13 @@
 
 #define SYSCALL_OPEN         1024
 #define SYSCALL_CLOCKGETTIME 403
+#define SYSCALL_MMAP         222
+#define SYSCALL_MUNMAP       215
 #define SYSCALL_BRK          214
 #define SYSCALL_GETTIMEOFDAY 169
 #define SYSCALL_EXIT         93
 #define SYSCALL_FSTAT        80
+#define SYSCALL_PREAD        67
 #define SYSCALL_WRITE        64
 #define SYSCALL_READ         63
 #define SYSCALL_LSEEK        62
@@ -47,4 +50,17 @@ XPEXTERN uint32_t
 riscv_syscall3(uint32_t num, uint32_t arg0, uint32_t arg1, uint32_t arg2);
 
 XPEXTERN uint32_t
-riscv_syscall4(uint32_t num, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
\ No newline at end of file
+riscv_syscall4(uint32_t num, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3);
+XPEXTERN uint32_t
+riscv_syscall6(uint32_t num, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3, uint32_t arg4, uint32_t arg5);
+
+// reads at an absolute offset without moving the file position
+XPEXTERN int
+riscv_pread(int fd, void* buffer, uint32_t count, uint32_t offset);
+
+// maps a file read only without copying it, offset must be a multiple of 4096, returns (void*)-1 on failure
+XPEXTERN const void*
+riscv_mmap(int fd, uint32_t length, uint32_t offset);
+
+XPEXTERN int
+riscv_munmap(const void* address, uint32_t length);
@@ -13,9 +13,15 @@
 /// --------------------------------------------------------------------------------------
 
 #include <Engine/XPConsole.h>
+#if !defined(__EMSCRIPTEN__)
+    #include <Engine/XPScriptScheduler.h>
+#endif
 #if defined(XP_EDITOR_MODE)
     #include <UI/Interface/XPIUI.h>
 #endif
+#include <Utilities/XPFS.h>
+#include <Utilities/XPLogger.h>
+#include <algorithm>
 #include <sstream>
 
 #ifdef __clang__
@@ -59,6 +65,62 @@ XPConsole::XPConsole(XPEngine* const engine)
         // show/hide bounding boxes
         std::make_pair("r.bb", std::make_shared<XPConsoleVar<bool>>(false, "r.bb", [](XPRegistry* const, bool) {})),
 
+        // quiet period in milliseconds the file watcher waits for before reloading a batch of changed assets
+        std::make_pair("fw.debounceMs",
+                       std::make_shared<XPConsoleVar<int>>(50, "fw.debounceMs", [](XPRegistry* const, int) {})),
+
+        // drop log records below this severity before they are queued (0 info, 1 trace, 2 warning, 3 error)
+        std::make_pair("log.minSeverity",
+                       std::make_shared<XPConsoleVar<int>>(
+                         XPLoggerSeverityInfo,
+                         "log.minSeverity",
+                         [](XPRegistry* const, int val) {
+                             const int severity = std::clamp(
+                               val, static_cast<int>(XPLoggerSeverityInfo), static_cast<int>(XPLoggerSeverityError));
+                             XPLogger::instance().setMinSeverity(static_cast<XPLoggerSeverity>(severity));
+                         })),
+
+        // mirror the log into a rotating file in the cache directory
+        std::make_pair("log.file",
+                       std::make_shared<XPConsoleVar<bool>>(false,
+                                                            "log.file",
+                                                            [](XPRegistry* const, bool val) {
+                                                                if (val) {
+                                                                    XPLogger::instance().setFileOutput(
+                                                                      XPFS::buildCachePath("logs/engine.log"),
+                                                                      8 * 1024 * 1024,
+                                                                      4);
+                                                                } else {
+                                                                    XPLogger::instance().closeFileOutput();
+                                                                }
+                                                            })),
+
+        // worker threads of the job pool the engine and physics share, read once when the engine starts
+        // 0 keeps one worker per core besides the main thread
+        std::make_pair("jobs.workers",
+                       std::make_shared<XPConsoleVar<int>>(0, "jobs.workers", [](XPRegistry* const, int) {})),
+
+        // threads the physics update splits its work for on the shared job pool, 0 uses all of them
+        std::make_pair("physics.threads",
+                       std::make_shared<XPConsoleVar<int>>(0, "physics.threads", [](XPRegistry* const, int) {})),
+
+        // size in megabytes the physics temp allocator starts with, it grows when an update needs more
+        std::make_pair(
+          "physics.tempAllocatorMB",
+          std::make_shared<XPConsoleVar<int>>(100, "physics.tempAllocatorMB", [](XPRegistry* const, int) {})),
+
+#if !defined(__EMSCRIPTEN__)
+        // instructions every script may retire per frame before it is preempted
+        std::make_pair("script.budget",
+                       std::make_shared<XPConsoleVar<int>>(XPScriptScheduler::DefaultInstructionBudget,
+                                                           "script.budget",
+                                                           [](XPRegistry* const registry, int val) {
+                                                               registry->getEngine()
+                                                                 ->getScriptScheduler()
+                                                                 ->setInstructionBudget(std::max(val, 1));
+                                                           })),
+#endif
+
         // capturing debug frames for metal
         std::make_pair(
           "r.captureDebugFrames",
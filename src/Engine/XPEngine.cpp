@@ -15,6 +15,9 @@
 #include <Engine/XPConsole.h>
 #include <Engine/XPEngine.h>
 #include <Engine/XPRegistry.h>
+#if !defined(__EMSCRIPTEN__)
+    #include <Engine/XPScriptScheduler.h>
+#endif
 #include <Physics/Interface/XPIPhysics.h>
 #include <Renderer/Interface/XPIRenderer.h>
 #if defined(XP_RENDERER_SW)
@@ -28,7 +31,9 @@
 #include <SceneDescriptor/XPSceneDescriptorStore.h>
 #include <Utilities/XPLogger.h>
 #include <Utilities/XPProfiler.h>
+#include <Utilities/XPThreadPool.h>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <mutex>
@@ -53,6 +58,23 @@ XPEngine::~XPEngine()
 XPProfilable void
 XPEngine::initialize()
 {
+#if !defined(__EMSCRIPTEN__)
+    const uint32_t numCores   = std::max(std::thread::hardware_concurrency(), 1u);
+    uint32_t       numWorkers = numCores - 1;
+    if (_console) {
+        auto optVariable = _console->getVariable("jobs.workers");
+        if (optVariable.has_value()) {
+            if (auto variable = std::dynamic_pointer_cast<XPConsoleVar<int>>(optVariable.value())) {
+                if (variable->getValue() > 0) { numWorkers = static_cast<uint32_t>(variable->getValue()); }
+            }
+        }
+    }
+    _scriptScheduler = std::make_unique<XPScriptScheduler>(numCores - 1);
+    _threadPool      = std::make_unique<XPThreadPool>(numWorkers);
+#else
+    // no worker threads on the web, jobs run on the thread that waits for them
+    _threadPool = std::make_unique<XPThreadPool>(0);
+#endif
 #if defined(XP_MCP_SERVER)
     _registry->getMcpServer()->initialize();
 #endif
@@ -62,7 +84,8 @@ XPEngine::initialize()
     _registry->getRenderer()->initialize();
     _registry->getPhysics()->initialize();
 #if defined(XP_EDITOR_MODE)
-    _registry->getUI()->initialize();
+    // headless runs have no ui
+    if (_registry->getUI()) { _registry->getUI()->initialize(); }
 #endif
 }
 
@@ -70,7 +93,7 @@ XPProfilable void
 XPEngine::finalize()
 {
 #if defined(XP_EDITOR_MODE)
-    _registry->getUI()->finalize();
+    if (_registry->getUI()) { _registry->getUI()->finalize(); }
 #endif
     _registry->getPhysics()->finalize();
     _registry->getRenderer()->finalize();
@@ -80,6 +103,10 @@ XPEngine::finalize()
 #if defined(XP_MCP_SERVER)
     _registry->getMcpServer()->finalize();
 #endif
+#if !defined(__EMSCRIPTEN__)
+    _scriptScheduler.reset();
+#endif
+    _threadPool.reset();
 }
 
 #if defined(__EMSCRIPTEN__)
@@ -121,7 +148,14 @@ XPEngine::run()
         physicsShouldStep = _registry->getUI()->isPhysicsPlaying();
     #endif
         _registry->triggerAllChangesIfAny();
-        if (physicsShouldStep) { _registry->getPhysics()->update(); }
+        bool frameShouldStep = true;
+    #if defined(XP_MCP_SERVER)
+        // automation requests run here, after pending swaps and before anything of the frame touched the scene
+        _registry->getMcpServer()->update();
+        frameShouldStep = _registry->getMcpServer()->shouldStepFrame();
+    #endif
+        if (frameShouldStep) { _scriptScheduler->tick(); }
+        if (physicsShouldStep && frameShouldStep) { _registry->getPhysics()->update(); }
         _registry->getRenderer()->update();
     #if defined(XP_EDITOR_MODE)
         _registry->getUI()->update(_registry->getRenderer()->getDeltaTime());
@@ -132,6 +166,38 @@ XPEngine::run()
 #endif
 }
 
+XPProfilable int
+XPEngine::runHeadless(uint32_t numFrames)
+{
+#if defined(__EMSCRIPTEN__)
+    XP_UNUSED(numFrames)
+    XP_LOG(XPLoggerSeverityError, "Headless runs are not supported in the browser");
+    return 1;
+#else
+    for (uint32_t frame = 0; frame < numFrames && !_shouldQuitLock.load(); ++frame) {
+        XPProfiler::instance().next();
+        _registry->triggerAllChangesIfAny();
+        _scriptScheduler->tick();
+        _registry->getPhysics()->update();
+        _registry->getRenderer()->update();
+    }
+    _registry->triggerAllChangesIfAny();
+
+    #if defined(XP_RENDERER_SW)
+    XPSWRasterizerEventListener listener;
+    XPScene*                    scene = _registry->getScene();
+    if (!_registry->getSWRenderer()->renderScene(*scene, listener)) {
+        XP_LOGV(XPLoggerSeverityError, "Scene <%s> has no cameras or meshes to render", scene->getName().c_str());
+        return 1;
+    }
+    return 0;
+    #else
+    XP_LOG(XPLoggerSeverityError, "Headless runs need the software renderer, configure with XP_RENDERER_SW");
+    return 1;
+    #endif
+#endif
+}
+
 XPProfilable void
 XPEngine::quit()
 {
@@ -181,11 +247,12 @@ XPEngine::runRenderTasks()
 XPProfilable void
 XPEngine::runComputeTasks()
 {
-    while (!_computeThreadQueue.empty()) {
-        auto& task = _computeThreadQueue.front();
-        task();
-        _computeThreadQueue.pop_front();
-    }
+    // compute tasks don't depend on each other, they all run on the pool and this waits until they are done
+    std::deque<std::function<void()>> tasks;
+    tasks.swap(_computeThreadQueue);
+    _threadPool->parallelFor(0, tasks.size(), 1, [&tasks](size_t first, size_t last, uint32_t) {
+        for (size_t i = first; i < last; ++i) { tasks[i](); }
+    });
 }
 
 XPProfilable void
@@ -264,3 +331,17 @@ XPEngine::getConsole() const
 {
     return _console.get();
 }
+
+XPThreadPool*
+XPEngine::getThreadPool() const
+{
+    return _threadPool.get();
+}
+
+#if !defined(__EMSCRIPTEN__)
+XPScriptScheduler*
+XPEngine::getScriptScheduler() const
+{
+    return _scriptScheduler.get();
+}
+#endif
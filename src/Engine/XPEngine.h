@@ -17,12 +17,15 @@
 #include <Utilities/XPPlatforms.h>
 
 #include <atomic>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <memory>
 
 class XPRegistry;
 class XPConsole;
+class XPScriptScheduler;
+class XPThreadPool;
 
 /// @brief A class to represent the root of all engine structures
 class XPEngine final
@@ -40,13 +43,18 @@ class XPEngine final
     /// @brief Blocks and starts all threads in loops
     void run();
 
+    /// @brief Blocks and steps the current scene for a fixed number of frames without a window or ui, then renders
+    /// every camera in software. returns the process exit code, 0 when every camera was rendered
+    int runHeadless(uint32_t numFrames);
+
     /// @brief stops all threads and shuts down the engine
     void quit();
 
     /// @brief schedules a new task on the render thread
     void scheduleRenderTask(std::function<void()>&& task);
 
-    /// @brief schedules a new task on the compute thread
+    /// @brief schedules a new task for the thread pool, it must not depend on other compute tasks nor schedule tasks
+    /// itself
     void scheduleComputeTask(std::function<void()>&& task);
 
     /// @brief schedules a new task on the physics thread
@@ -61,7 +69,7 @@ class XPEngine final
     /// @brief run all the render queued thread tasks
     void runRenderTasks();
 
-    /// @brief run all the compute queued thread tasks
+    /// @brief runs all the queued compute tasks in parallel on the thread pool and waits for them
     void runComputeTasks();
 
     /// @brief run all the physics queued thread tasks
@@ -70,7 +78,7 @@ class XPEngine final
     /// @brief run all the ui thread queued tasks
     void runUITasks();
 
-    /// @brief run all the game thread queued tasks
+    /// @brief run all the game thread queued tasks, in order on the calling thread since they change the scene
     void runGameTasks();
 
     /// @brief returns whether any of the thread queues have tasks
@@ -80,10 +88,19 @@ class XPEngine final
     void        setConsole(std::unique_ptr<XPConsole> console);
     XPRegistry* getRegistry() const;
     XPConsole*  getConsole() const;
+    /// @brief work stealing pool shared by the engine systems, null before initialize() and after finalize()
+    XPThreadPool* getThreadPool() const;
+#if !defined(__EMSCRIPTEN__)
+    XPScriptScheduler* getScriptScheduler() const;
+#endif
 
   private:
     std::unique_ptr<XPRegistry>       _registry;
     std::unique_ptr<XPConsole>        _console;
+    std::unique_ptr<XPThreadPool>     _threadPool;
+#if !defined(__EMSCRIPTEN__)
+    std::unique_ptr<XPScriptScheduler> _scriptScheduler;
+#endif
     std::atomic_bool                  _shouldQuitLock;
     std::deque<std::function<void()>> _renderThreadQueue;
     std::deque<std::function<void()>> _computeThreadQueue;
@@ -0,0 +1,164 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Engine/XPScriptScheduler.h>
+
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorProcessor.h>
+#include <Utilities/XPProfiler.h>
+
+#include <algorithm>
+#include <chrono>
+
+XPScriptScheduler::XPScriptScheduler(uint32_t numWorkers)
+{
+    _next.store(0);
+    _workers.reserve(numWorkers);
+    for (uint32_t i = 0; i < numWorkers; ++i) { _workers.emplace_back([this]() { workerLoop(); }); }
+}
+
+XPScriptScheduler::~XPScriptScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _shouldFinish = true;
+    }
+    _wake.notify_all();
+    for (std::thread& worker : _workers) { worker.join(); }
+}
+
+void
+XPScriptScheduler::add(uint32_t nodeId, XPEmulatorProcessor* processor)
+{
+    auto it = std::lower_bound(
+      _entries.begin(), _entries.end(), nodeId, [](const Entry& entry, uint32_t id) { return entry.nodeId < id; });
+    if (it != _entries.end() && it->nodeId == nodeId) {
+        it->processor = processor;
+        it->stats     = {};
+        return;
+    }
+    _entries.insert(it, Entry{ nodeId, processor, {} });
+}
+
+bool
+XPScriptScheduler::remove(uint32_t nodeId)
+{
+    auto it = std::lower_bound(
+      _entries.begin(), _entries.end(), nodeId, [](const Entry& entry, uint32_t id) { return entry.nodeId < id; });
+    if (it == _entries.end() || it->nodeId != nodeId) { return false; }
+    _entries.erase(it);
+    return true;
+}
+
+XPProfilable void
+XPScriptScheduler::tick()
+{
+    if (_entries.empty()) { return; }
+
+    _next.store(0);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_generation;
+        _numBusy = static_cast<uint32_t>(_workers.size());
+    }
+    _wake.notify_all();
+    drain();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this]() { return _numBusy == 0; });
+}
+
+void
+XPScriptScheduler::setInstructionBudget(uint32_t budget)
+{
+    _budget = budget;
+}
+
+uint32_t
+XPScriptScheduler::getInstructionBudget() const
+{
+    return _budget;
+}
+
+uint32_t
+XPScriptScheduler::getNumWorkers() const
+{
+    return static_cast<uint32_t>(_workers.size());
+}
+
+size_t
+XPScriptScheduler::getNumScripts() const
+{
+    return _entries.size();
+}
+
+const XPScriptStats*
+XPScriptScheduler::getStats(uint32_t nodeId) const
+{
+    auto it = std::lower_bound(
+      _entries.begin(), _entries.end(), nodeId, [](const Entry& entry, uint32_t id) { return entry.nodeId < id; });
+    if (it == _entries.end() || it->nodeId != nodeId) { return nullptr; }
+    return &it->stats;
+}
+
+void
+XPScriptScheduler::workerLoop()
+{
+    uint64_t generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [&]() { return _shouldFinish || _generation != generation; });
+            if (_shouldFinish) { return; }
+            generation = _generation;
+        }
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_numBusy == 0) { _done.notify_one(); }
+        }
+    }
+}
+
+void
+XPScriptScheduler::drain()
+{
+    // entries are claimed in node id order, each one by exactly one thread
+    for (size_t i = _next.fetch_add(1); i < _entries.size(); i = _next.fetch_add(1)) { runSlice(_entries[i]); }
+}
+
+void
+XPScriptScheduler::runSlice(Entry& entry)
+{
+    XPScriptStats& stats = entry.stats;
+    if (stats.finished) { return; }
+
+    const auto start   = std::chrono::steady_clock::now();
+    uint32_t   retired = 0;
+    const int  result  = xp_emulator_processor_run_budget(entry.processor, _budget, &retired);
+    const auto elapsed =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    stats.lastFrameInstructions = retired;
+    stats.lastFrameNanoseconds  = static_cast<uint64_t>(elapsed);
+    stats.totalInstructions += retired;
+    stats.totalHostNanoseconds += static_cast<uint64_t>(elapsed);
+    ++stats.frames;
+    if (result == XP_EMULATOR_PROGRAM_EXIT_CODE_YIELD) {
+        ++stats.yields;
+    } else if (result != XP_EMULATOR_PROGRAM_EXIT_CODE_SUCCESS) {
+        stats.exitCode = result;
+        stats.finished = true;
+    }
+}
@@ -0,0 +1,91 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct XPEmulatorProcessor;
+
+/// @brief CPU accounting of one scheduled script
+struct XPScriptStats
+{
+    uint64_t totalInstructions     = 0; // retired over the script lifetime
+    uint64_t totalHostNanoseconds  = 0;
+    uint64_t frames                = 0; // ticks the script got a slice in
+    uint64_t yields                = 0; // slices that ended early on an ecall
+    uint32_t lastFrameInstructions = 0;
+    uint64_t lastFrameNanoseconds  = 0;
+    int      exitCode              = 0; // XP_EMULATOR_PROGRAM_EXIT_CODE of the stop, valid once finished
+    bool     finished              = false;
+};
+
+/// @brief Multiplexes script processors over a fixed worker pool, one instruction budgeted slice per tick.
+/// Scripts are dispatched in node id order and every processor is only ever touched by one worker per tick,
+/// a script only observes its own instruction count so runs are reproducible regardless of the worker count.
+/// add/remove/tick must all be called from the same (game) thread.
+class XPScriptScheduler final
+{
+  public:
+    static constexpr uint32_t DefaultInstructionBudget = 100000;
+
+    /// @brief spawns numWorkers threads, the ticking thread always takes part so 0 runs everything inline
+    explicit XPScriptScheduler(uint32_t numWorkers);
+    ~XPScriptScheduler();
+
+    /// @brief registers a loaded processor, the processor stays owned by the caller
+    void add(uint32_t nodeId, XPEmulatorProcessor* processor);
+
+    /// @brief unregisters the script of a node, returns false when it wasn't scheduled
+    bool remove(uint32_t nodeId);
+
+    /// @brief runs one slice of every unfinished script and blocks until all of them yielded
+    void tick();
+
+    void                 setInstructionBudget(uint32_t budget);
+    uint32_t             getInstructionBudget() const;
+    uint32_t             getNumWorkers() const;
+    size_t               getNumScripts() const;
+    const XPScriptStats* getStats(uint32_t nodeId) const;
+
+  private:
+    struct Entry
+    {
+        uint32_t             nodeId;
+        XPEmulatorProcessor* processor;
+        XPScriptStats        stats;
+    };
+
+    void workerLoop();
+    void drain();
+    void runSlice(Entry& entry);
+
+    std::vector<Entry>       _entries; // sorted by node id
+    std::vector<std::thread> _workers;
+    std::mutex               _mutex;
+    std::condition_variable  _wake;
+    std::condition_variable  _done;
+    std::atomic<size_t>      _next;
+    uint64_t                 _generation   = 0;
+    uint32_t                 _numBusy      = 0;
+    uint32_t                 _budget       = DefaultInstructionBudget;
+    bool                     _shouldFinish = false;
+};
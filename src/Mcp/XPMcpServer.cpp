@@ -14,9 +14,115 @@
 
 #include <Mcp/XPMcpServer.h>
 
+#include <DataPipeline/XPDataPipelineStore.h>
+#include <DataPipeline/XPFile.h>
+#include <Engine/XPRegistry.h>
+#include <SceneDescriptor/XPLayer.h>
+#include <SceneDescriptor/XPNode.h>
+#include <SceneDescriptor/XPScene.h>
+#include <SceneDescriptor/XPSceneStore.h>
+#include <Utilities/XPLogger.h>
+#include <Utilities/XPProfiler.h>
+
+#include <algorithm>
+#include <ctype.h>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+#if !defined(XP_PLATFORM_WINDOWS) && !defined(XP_PLATFORM_EMSCRIPTEN)
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+// JSON-RPC 2.0 error codes
+#define XP_MCP_PARSE_ERROR      -32700
+#define XP_MCP_INVALID_REQUEST  -32600
+#define XP_MCP_METHOD_NOT_FOUND -32601
+#define XP_MCP_INVALID_PARAMS   -32602
+#define XP_MCP_SERVER_ERROR     -32000
+
+// responses are handed to the socket thread every time this many bytes are pending
+#define XP_MCP_CHUNK_SIZE              (64 * 1024)
+// a client sending a longer line without a newline is dropped
+#define XP_MCP_MAX_LINE_LENGTH         (16 * 1024 * 1024)
+// connection ids start at 1, output written for this one is thrown away instead of reaching any client
+#define XP_MCP_DISCARDED_CONNECTION_ID 0
+
+static char
+toLowerAscii(char c)
+{
+    return static_cast<char>(tolower(static_cast<unsigned char>(c)));
+}
+
+static bool
+readUnsigned(const nlohmann::json& params, const char* key, uint32_t& value)
+{
+    auto it = params.find(key);
+    if (it == params.end()) { return true; }
+    if (!it->is_number_unsigned() || it->get<uint64_t>() > std::numeric_limits<uint32_t>::max()) { return false; }
+    value = it->get<uint32_t>();
+    return true;
+}
+
+static nlohmann::json
+nodeRecord(XPNode* node)
+{
+    nlohmann::json record;
+    record["id"]   = node->getId();
+    record["name"] = node->getName();
+    XPNode* root   = node;
+    while (root->getParentNode().has_value()) { root = root->getParentNode().value(); }
+    record["layer"] = root->getParentLayer().has_value() ? root->getParentLayer().value()->getName() : std::string();
+    if (node->getParentNode().has_value()) {
+        record["parent"] = node->getParentNode().value()->getId();
+    } else {
+        record["parent"] = nullptr;
+    }
+    std::vector<std::string_view> attachments;
+    node->getAttachmentNames(attachments);
+    nlohmann::json& names = record["attachments"] = nlohmann::json::array();
+    for (std::string_view name : attachments) { names.push_back(name); }
+    return record;
+}
+
+// visits the scene's nodes in the order the hierarchy panel lists them, stops as soon as fn returns false
+template<typename Fn>
+static void
+forEachNode(XPScene* scene, Fn&& fn)
+{
+    std::vector<XPNode*> stack;
+    for (XPLayer* layer : scene->getLayers()) {
+        stack.assign(layer->getNodes().rbegin(), layer->getNodes().rend());
+        while (!stack.empty()) {
+            XPNode* node = stack.back();
+            stack.pop_back();
+            if (!fn(node)) { return; }
+            const std::list<XPNode*>& children = node->getNodes();
+            stack.insert(stack.end(), children.rbegin(), children.rend());
+        }
+    }
+}
+
 XPMcpServer::XPMcpServer(XPRegistry* const registry)
   : _registry(registry)
 {
+    _methods["scene.listNodes"]      = &XPMcpServer::listNodes;
+    _methods["scene.findNodes"]      = &XPMcpServer::findNodes;
+    _methods["node.getFields"]       = &XPMcpServer::getFields;
+    _methods["node.setFields"]       = &XPMcpServer::setFields;
+    _methods["assets.reload"]        = &XPMcpServer::reloadAssets;
+    _methods["profiler.getCounters"] = &XPMcpServer::getCounters;
+    _methods["engine.pause"]         = &XPMcpServer::pause;
+    _methods["engine.resume"]        = &XPMcpServer::resume;
+    _methods["engine.step"]          = &XPMcpServer::step;
+    _methods["engine.getState"]      = &XPMcpServer::getState;
 }
 
 XPMcpServer::~XPMcpServer() {}
@@ -24,31 +130,614 @@ XPMcpServer::~XPMcpServer() {}
 void
 XPMcpServer::initialize()
 {
-    t = std::thread([]() {
-        // /* Create MCP server */
-        // oatpp::mcp::Server server;
+#if defined(XP_PLATFORM_WINDOWS) || defined(XP_PLATFORM_EMSCRIPTEN)
+    XP_LOG(XPLoggerSeverityWarning, "The automation server needs unix domain sockets, it is disabled on this platform");
+#else
+    if (const char* socketPath = getenv("XP_MCP_SOCKET"); socketPath && socketPath[0] != '\0') {
+        _socketPath = socketPath;
+    } else {
+        // the default lives in a directory only this user can enter, other users cannot reach the socket through it
+        std::error_code             ec;
+        const std::filesystem::path directory =
+          std::filesystem::temp_directory_path(ec) / ("xp-engine-" + std::to_string(getuid()));
+        struct stat info = {};
+        if ((mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) || lstat(directory.c_str(), &info) != 0 ||
+            !S_ISDIR(info.st_mode) || info.st_uid != getuid() || (info.st_mode & 0077) != 0) {
+            XP_LOGV(XPLoggerSeverityError,
+                    "Automation socket directory <%s> is not a directory private to this user",
+                    directory.string().c_str());
+            return;
+        }
+        _socketPath = (directory / (std::to_string(getpid()) + ".sock")).string();
+    }
 
-        // /* Add prompts */
-        // server.addPrompt(std::make_shared<prompts::CodeReview>());
+    sockaddr_un address = {};
+    address.sun_family  = AF_UNIX;
+    if (_socketPath.size() >= sizeof(address.sun_path)) {
+        XP_LOGV(XPLoggerSeverityError, "Automation socket path <%s> is too long", _socketPath.c_str());
+        return;
+    }
+    memcpy(address.sun_path, _socketPath.c_str(), _socketPath.size() + 1);
 
-        // /* Add resource */
-        // server.addResource(std::make_shared<resource::File>());
+    // a socket file left behind by a crashed run would make bind fail, anything else at that path is left alone
+    if (struct stat info = {}; lstat(_socketPath.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            XP_LOGV(
+              XPLoggerSeverityError, "Automation socket path <%s> exists and is not a socket", _socketPath.c_str());
+            return;
+        }
+        unlink(_socketPath.c_str());
+    }
+    // only the user running the engine may connect, the socket drives the scene and reloads assets
+    _listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_listenFd < 0 || bind(_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        chmod(_socketPath.c_str(), 0600) != 0 || listen(_listenFd, 8) != 0 || pipe(_wakeFds) != 0) {
+        XP_LOGV(XPLoggerSeverityError, "Failed to listen on automation socket <%s>", _socketPath.c_str());
+        if (_listenFd >= 0) { close(_listenFd); }
+        _listenFd = -1;
+        return;
+    }
+    fcntl(_listenFd, F_SETFL, fcntl(_listenFd, F_GETFL) | O_NONBLOCK);
+    fcntl(_wakeFds[0], F_SETFL, fcntl(_wakeFds[0], F_GETFL) | O_NONBLOCK);
+    fcntl(_wakeFds[1], F_SETFL, fcntl(_wakeFds[1], F_GETFL) | O_NONBLOCK);
 
-        // /* Add tools */
-        // server.addTool(std::make_shared<tools::Logger>());
-
-        // /* Run server */
-        // server.stdioListen();
-    });
+    _shouldStop.store(false);
+    _thread = std::thread(&XPMcpServer::serve, this);
+    XP_LOGV(XPLoggerSeverityInfo, "Automation server listening on <%s>", _socketPath.c_str());
+#endif
 }
 
 void
 XPMcpServer::finalize()
 {
-    t.join();
+#if !defined(XP_PLATFORM_WINDOWS) && !defined(XP_PLATFORM_EMSCRIPTEN)
+    if (!_thread.joinable()) { return; }
+    _shouldStop.store(true);
+    wake();
+    _thread.join();
+    for (auto& [connectionId, connection] : _connections) { close(connection.fd); }
+    _connections.clear();
+    close(_listenFd);
+    close(_wakeFds[0]);
+    close(_wakeFds[1]);
+    _listenFd = _wakeFds[0] = _wakeFds[1] = -1;
+    unlink(_socketPath.c_str());
+#endif
 }
 
 void
 XPMcpServer::update()
 {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _executing.swap(_requests);
+    }
+    for (const Request& request : _executing) {
+        Output out = { request.connectionId, std::string() };
+        if (request.message.is_array()) {
+            // notifications inside a batch are executed but not answered, a batch of only notifications sends nothing
+            bool isFirst = true;
+            for (const nlohmann::json& message : request.message) {
+                const bool isAnswered = !message.is_object() || message.contains("id");
+                if (isAnswered) { write(out, isFirst ? "[" : ","); }
+                isFirst &= !isAnswered;
+                execute(out, message);
+            }
+            if (request.message.empty()) {
+                writeError(out, nullptr, XP_MCP_INVALID_REQUEST, "Empty batch");
+            } else if (!isFirst) {
+                write(out, "]");
+            }
+        } else {
+            execute(out, request.message);
+        }
+        if (!out.buffer.empty()) { write(out, "\n"); }
+        flush(out);
+    }
+    _executing.clear();
+}
+
+bool
+XPMcpServer::shouldStepFrame()
+{
+    if (_isPaused) {
+        if (_pendingFrames == 0) { return false; }
+        --_pendingFrames;
+    }
+    ++_frame;
+    return true;
+}
+
+void
+XPMcpServer::serve()
+{
+#if !defined(XP_PLATFORM_WINDOWS) && !defined(XP_PLATFORM_EMSCRIPTEN)
+    std::vector<pollfd>   fds;
+    std::vector<uint32_t> connectionIds;
+    while (!_shouldStop.load()) {
+        fds.clear();
+        connectionIds.clear();
+        fds.push_back({ _listenFd, POLLIN, 0 });
+        fds.push_back({ _wakeFds[0], POLLIN, 0 });
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto& [connectionId, connection] : _connections) {
+                const short events = connection.output.empty() ? POLLIN : (POLLIN | POLLOUT);
+                fds.push_back({ connection.fd, events, 0 });
+                connectionIds.push_back(connectionId);
+            }
+        }
+
+        if (poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) {
+            if (errno == EINTR) { continue; }
+            XP_LOG(XPLoggerSeverityError, "Automation server stopped polling its sockets");
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            char drain[64];
+            while (read(_wakeFds[0], drain, sizeof(drain)) > 0) {}
+        }
+
+        if (fds[0].revents & POLLIN) {
+            for (int fd = accept(_listenFd, nullptr, nullptr); fd >= 0; fd = accept(_listenFd, nullptr, nullptr)) {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    #if defined(SO_NOSIGPIPE)
+                int noSigPipe = 1;
+                setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+    #endif
+                std::lock_guard<std::mutex> lock(_mutex);
+                _connections[_nextConnectionId++] = { fd, std::string(), {}, 0 };
+            }
+        }
+
+        for (size_t i = 2; i < fds.size(); ++i) {
+            const uint32_t connectionId = connectionIds[i - 2];
+            // only this thread inserts or erases connections, the reference stays valid while the lock is released
+            Connection*    connection   = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                connection = &_connections.at(connectionId);
+            }
+
+            bool isOpen = (fds[i].revents & (POLLERR | POLLNVAL)) == 0;
+            if (isOpen && (fds[i].revents & (POLLIN | POLLHUP))) {
+                char buffer[16 * 1024];
+                for (;;) {
+                    const ssize_t numBytes = recv(connection->fd, buffer, sizeof(buffer), 0);
+                    if (numBytes > 0) {
+                        connection->input.append(buffer, static_cast<size_t>(numBytes));
+                        continue;
+                    }
+                    isOpen = numBytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+                    break;
+                }
+                receiveLines(connectionId, *connection);
+                if (connection->input.size() > XP_MCP_MAX_LINE_LENGTH) {
+                    XP_LOG(XPLoggerSeverityWarning, "Automation client sent an oversized request, disconnecting");
+                    isOpen = false;
+                }
+            }
+
+            if (isOpen && (fds[i].revents & POLLOUT)) {
+    #if defined(MSG_NOSIGNAL)
+                const int sendFlags = MSG_NOSIGNAL;
+    #else
+                const int sendFlags = 0;
+    #endif
+                std::lock_guard<std::mutex> lock(_mutex);
+                while (isOpen && !connection->output.empty()) {
+                    const std::string& chunk    = connection->output.front();
+                    const ssize_t      numBytes = send(connection->fd,
+                                                  chunk.data() + connection->outputOffset,
+                                                  chunk.size() - connection->outputOffset,
+                                                  sendFlags);
+                    if (numBytes < 0) {
+                        isOpen = errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+                        break;
+                    }
+                    connection->outputOffset += static_cast<size_t>(numBytes);
+                    if (connection->outputOffset == chunk.size()) {
+                        connection->output.pop_front();
+                        connection->outputOffset = 0;
+                    }
+                }
+            }
+
+            if (!isOpen) { closeConnection(connectionId); }
+        }
+    }
+#endif
+}
+
+void
+XPMcpServer::wake()
+{
+#if !defined(XP_PLATFORM_WINDOWS) && !defined(XP_PLATFORM_EMSCRIPTEN)
+    const char byte = 1;
+    // a full pipe already has a wake up pending
+    [[maybe_unused]] ssize_t numBytes = ::write(_wakeFds[1], &byte, 1);
+#endif
+}
+
+void
+XPMcpServer::closeConnection(uint32_t connectionId)
+{
+#if !defined(XP_PLATFORM_WINDOWS) && !defined(XP_PLATFORM_EMSCRIPTEN)
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto                        it = _connections.find(connectionId);
+    if (it == _connections.end()) { return; }
+    close(it->second.fd);
+    _connections.erase(it);
+#else
+    XP_UNUSED(connectionId)
+#endif
+}
+
+void
+XPMcpServer::receiveLines(uint32_t connectionId, Connection& connection)
+{
+    size_t lineStart = 0;
+    for (size_t lineEnd = connection.input.find('\n'); lineEnd != std::string::npos;
+         lineEnd        = connection.input.find('\n', lineStart)) {
+        std::string_view line(connection.input.data() + lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos) { continue; }
+
+        // parsing here keeps the engine thread's share of a request down to executing it
+        nlohmann::json message = nlohmann::json::parse(line, nullptr, false);
+        if (message.is_discarded()) {
+            Output out = { connectionId, std::string() };
+            writeError(out, nullptr, XP_MCP_PARSE_ERROR, "Parse error");
+            write(out, "\n");
+            enqueueOutput(connectionId, std::move(out.buffer));
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _requests.push_back({ connectionId, std::move(message) });
+    }
+    connection.input.erase(0, lineStart);
+}
+
+void
+XPMcpServer::enqueueOutput(uint32_t connectionId, std::string&& bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto                        it = _connections.find(connectionId);
+        // the client went away while its request was executing
+        if (it == _connections.end()) { return; }
+        it->second.output.push_back(std::move(bytes));
+    }
+    wake();
+}
+
+void
+XPMcpServer::execute(Output& out, const nlohmann::json& message)
+{
+    if (!message.is_object()) {
+        writeError(out, nullptr, XP_MCP_INVALID_REQUEST, "Request is not an object");
+        return;
+    }
+    auto                 idIt = message.find("id");
+    const bool           isNotification = idIt == message.end();
+    const nlohmann::json id             = isNotification ? nlohmann::json() : *idIt;
+    auto                 methodIt       = message.find("method");
+    if (methodIt == message.end() || !methodIt->is_string() || (!id.is_null() && !id.is_string() && !id.is_number())) {
+        if (!isNotification) { writeError(out, id, XP_MCP_INVALID_REQUEST, "Invalid request"); }
+        return;
+    }
+    auto paramsIt = message.find("params");
+    if (paramsIt != message.end() && !paramsIt->is_object()) {
+        if (!isNotification) { writeError(out, id, XP_MCP_INVALID_PARAMS, "Params must be an object"); }
+        return;
+    }
+    auto method = _methods.find(methodIt->get_ref<const std::string&>());
+    if (method == _methods.end()) {
+        if (!isNotification) { writeError(out, id, XP_MCP_METHOD_NOT_FOUND, "Method not found"); }
+        return;
+    }
+
+    static const nlohmann::json noParams = nlohmann::json::object();
+    if (isNotification) {
+        // the method still runs, whatever it writes is thrown away
+        Output discarded = { XP_MCP_DISCARDED_CONNECTION_ID, std::string() };
+        (this->*method->second)(discarded, id, paramsIt != message.end() ? *paramsIt : noParams);
+        return;
+    }
+    (this->*method->second)(out, id, paramsIt != message.end() ? *paramsIt : noParams);
+}
+
+void
+XPMcpServer::write(Output& out, std::string_view bytes)
+{
+    out.buffer.append(bytes);
+    if (out.buffer.size() >= XP_MCP_CHUNK_SIZE) { flush(out); }
+}
+
+void
+XPMcpServer::flush(Output& out)
+{
+    if (out.buffer.empty()) { return; }
+    if (out.connectionId == XP_MCP_DISCARDED_CONNECTION_ID) {
+        out.buffer.clear();
+        return;
+    }
+    enqueueOutput(out.connectionId, std::move(out.buffer));
+    out.buffer = std::string();
+}
+
+void
+XPMcpServer::writeResult(Output& out, const nlohmann::json& id, const nlohmann::json& result)
+{
+    nlohmann::json response;
+    response["jsonrpc"] = "2.0";
+    response["id"]      = id;
+    response["result"]  = result;
+    write(out, response.dump());
+}
+
+void
+XPMcpServer::writeError(Output& out, const nlohmann::json& id, int code, std::string_view message)
+{
+    nlohmann::json response;
+    response["jsonrpc"]          = "2.0";
+    response["id"]               = id;
+    response["error"]["code"]    = code;
+    response["error"]["message"] = message;
+    write(out, response.dump());
+}
+
+void
+XPMcpServer::beginResult(Output& out, const nlohmann::json& id)
+{
+    write(out, "{\"jsonrpc\":\"2.0\",\"id\":");
+    write(out, id.dump());
+    write(out, ",\"result\":");
+}
+
+void
+XPMcpServer::endResult(Output& out)
+{
+    write(out, "}");
+}
+
+void
+XPMcpServer::listNodes(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    uint32_t offset = 0;
+    uint32_t limit  = std::numeric_limits<uint32_t>::max();
+    if (!readUnsigned(params, "offset", offset) || !readUnsigned(params, "limit", limit)) {
+        writeError(out, id, XP_MCP_INVALID_PARAMS, "offset and limit must be unsigned integers");
+        return;
+    }
+    XPScene* scene = _registry->getScene();
+    if (!scene) {
+        writeError(out, id, XP_MCP_SERVER_ERROR, "No scene is loaded");
+        return;
+    }
+
+    beginResult(out, id);
+    write(out, "[");
+    uint32_t index   = 0;
+    uint32_t written = 0;
+    forEachNode(scene, [&](XPNode* node) {
+        if (written == limit) { return false; }
+        if (index++ < offset) { return true; }
+        if (written++ > 0) { write(out, ","); }
+        write(out, nodeRecord(node).dump());
+        return true;
+    });
+    write(out, "]");
+    endResult(out);
+}
+
+void
+XPMcpServer::findNodes(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    auto     queryIt = params.find("query");
+    uint32_t limit   = std::numeric_limits<uint32_t>::max();
+    if (queryIt == params.end() || !queryIt->is_string() || !readUnsigned(params, "limit", limit)) {
+        writeError(out, id, XP_MCP_INVALID_PARAMS, "query must be a string and limit an unsigned integer");
+        return;
+    }
+    XPScene* scene = _registry->getScene();
+    if (!scene) {
+        writeError(out, id, XP_MCP_SERVER_ERROR, "No scene is loaded");
+        return;
+    }
+
+    std::string query = queryIt->get<std::string>();
+    std::transform(query.begin(), query.end(), query.begin(), toLowerAscii);
+    std::string name;
+
+    beginResult(out, id);
+    write(out, "[");
+    uint32_t written = 0;
+    forEachNode(scene, [&](XPNode* node) {
+        if (written == limit) { return false; }
+        name = node->getName();
+        std::transform(name.begin(), name.end(), name.begin(), toLowerAscii);
+        if (name.find(query) == std::string::npos) { return true; }
+        if (written++ > 0) { write(out, ","); }
+        write(out, nodeRecord(node).dump());
+        return true;
+    });
+    write(out, "]");
+    endResult(out);
+}
+
+void
+XPMcpServer::getFields(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    uint32_t nodeId       = 0;
+    auto     attachmentIt = params.find("attachment");
+    if (!params.contains("id") || !readUnsigned(params, "id", nodeId) || attachmentIt == params.end() ||
+        !attachmentIt->is_string()) {
+        writeError(out, id, XP_MCP_INVALID_PARAMS, "id must be a node id and attachment a string");
+        return;
+    }
+    XPScene*               scene = _registry->getScene();
+    std::optional<XPNode*> node  = scene ? scene->getSceneStore()->getNode(nodeId) : std::nullopt;
+    if (!node.has_value()) {
+        writeError(out, id, XP_MCP_SERVER_ERROR, "Unknown node");
+        return;
+    }
+
+    nlohmann::json fields;
+    if (!node.value()->getAttachmentFields(attachmentIt->get_ref<const std::string&>(), fields)) {
+        writeError(out, id, XP_MCP_SERVER_ERROR, "The node has no such attachment");
+        return;
+    }
+    writeResult(out, id, fields);
+}
+
+void
+XPMcpServer::setFields(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    uint32_t nodeId       = 0;
+    auto     attachmentIt = params.find("attachment");
+    auto     fieldsIt     = params.find("fields");
+    if (!params.contains("id") || !readUnsigned(params, "id", nodeId) || attachmentIt == params.end() ||
+        !attachmentIt->is_string() || fieldsIt == params.end() || !fieldsIt->is_object()) {
+        writeError(out, id, XP_MCP_INVALID_PARAMS, "id must be a node id, attachment a string and fields an object");
+        return;
+    }
+    XPScene*               scene = _registry->getScene();
+    std::optional<XPNode*> node  = scene ? scene->getSceneStore()->getNode(nodeId) : std::nullopt;
+    if (!node.has_value()) {
+        writeError(out, id, XP_MCP_SERVER_ERROR, "Unknown node");
+        return;
+    }
+
+    const std::string& attachment = attachmentIt->get_ref<const std::string&>();
+    if (!node.value()->setAttachmentFields(attachment, *fieldsIt)) {
+        // fields that converted are kept, same as a partially applied edit in the properties panel
+        writeError(out, id, XP_MCP_INVALID_PARAMS, "Unknown attachment or fields that do not convert");
+        return;
+    }
+    nlohmann::json result;
+    result["id"]         = nodeId;
+    result["attachment"] = attachment;
+    writeResult(out, id, result);
+}
+
+void
+XPMcpServer::reloadAssets(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    auto pathIt = params.find("path");
+    if (pathIt != params.end() && !pathIt->is_string()) {
+        writeError(out, id, XP_MCP_INVALID_PARAMS, "path must be a string");
+        return;
+    }
+    XPDataPipelineStore* dataPipelineStore = _registry->getDataPipelineStore();
+
+    uint32_t numCommitted = 0;
+    if (pathIt != params.end()) {
+        // reloads the file even if the watcher did not see it change, e.g. when it was written by the client itself
+        const std::string& path = pathIt->get_ref<const std::string&>();
+        XPFile*            file = nullptr;
+        for (const auto& [type, files] : dataPipelineStore->getFiles()) {
+            if (auto it = files.find(path); it != files.end()) { file = it->second; }
+        }
+        if (!file) {
+            writeError(out, id, XP_MCP_SERVER_ERROR, "Unknown file");
+            return;
+        }
+        file->stageChanges();
+        file->commitChanges();
+        numCommitted = 1;
+    } else {
+        // same as the reload button in the editor's toolbar
+        dataPipelineStore->clearFilesNeedReload();
+        for (const auto& pair : dataPipelineStore->getMeshAssets()) {
+            if (pair.first->hasChanges()) {
+                ++numCommitted;
+                pair.first->commitChanges();
+            }
+        }
+        for (const auto& pair : dataPipelineStore->getShaderAssets()) {
+            if (pair.first->hasChanges()) {
+                ++numCommitted;
+                pair.first->commitChanges();
+            }
+        }
+        for (const auto& pair : dataPipelineStore->getTextureAssets()) {
+            if (pair.first->hasChanges()) {
+                ++numCommitted;
+                pair.first->commitChanges();
+            }
+        }
+    }
+    nlohmann::json result;
+    result["committed"] = numCommitted;
+    writeResult(out, id, result);
+}
+
+void
+XPMcpServer::getCounters(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    XP_UNUSED(params)
+
+    // update() runs after the profiler moved on to the new frame, the slot before it is the last whole frame
+    const uint32_t index =
+      (XPProfiler::instance().getIndex() + XP_PROFILER_TIMELINE_WIDTH - 1) % XP_PROFILER_TIMELINE_WIDTH;
+
+    beginResult(out, id);
+    write(out, "[");
+    bool isFirst = true;
+    for (const auto& [trace, timeline] : XPProfiler::instance().getTimelines()) {
+        nlohmann::json counter;
+        counter["function"] = trace.function;
+        counter["file"]     = trace.file;
+        counter["ms"]       = timeline.values[index];
+        write(out, isFirst ? "" : ",");
+        write(out, counter.dump());
+        isFirst = false;
+    }
+    write(out, "]");
+    endResult(out);
+}
+
+void
+XPMcpServer::pause(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    _isPaused = true;
+    getState(out, id, params);
+}
+
+void
+XPMcpServer::resume(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    _isPaused      = false;
+    _pendingFrames = 0;
+    getState(out, id, params);
+}
+
+void
+XPMcpServer::step(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    uint32_t numFrames = 1;
+    if (!readUnsigned(params, "frames", numFrames)) {
+        writeError(out, id, XP_MCP_INVALID_PARAMS, "frames must be an unsigned integer");
+        return;
+    }
+    // stepping implies pausing, the requested frames run on the following iterations of the engine loop and
+    // engine.getState reports when they are done
+    _isPaused      = true;
+    _pendingFrames = static_cast<uint32_t>(
+      std::min<uint64_t>(static_cast<uint64_t>(_pendingFrames) + numFrames, std::numeric_limits<uint32_t>::max()));
+    getState(out, id, params);
+}
+
+void
+XPMcpServer::getState(Output& out, const nlohmann::json& id, const nlohmann::json& params)
+{
+    XP_UNUSED(params)
+
+    nlohmann::json result;
+    result["paused"]        = _isPaused;
+    result["frame"]         = _frame;
+    result["pendingFrames"] = _pendingFrames;
+    writeResult(out, id, result);
 }
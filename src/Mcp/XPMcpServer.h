@@ -17,10 +17,43 @@
 #include <Utilities/XPMacros.h>
 #include <Utilities/XPPlatforms.h>
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wall"
+#endif
+#include <nlohmann/json.hpp>
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
 
 class XPRegistry;
 
+/// @brief Local automation server, speaks newline delimited JSON-RPC 2.0 over a unix domain socket. The socket path is
+/// taken from XP_MCP_SOCKET or defaults to xp-engine-<uid>/<pid>.sock in the temp directory, either way only the user
+/// running the engine may connect. A line holds either a single request or a batch array. A background thread only
+/// moves bytes and parses lines, every request is executed by update() on the engine thread between two frames, so
+/// handlers touch the scene exactly like the editor panels do. Large results are written out in chunks while they are
+/// being produced instead of being built as one json value.
+///
+/// Methods:
+///   scene.listNodes     { offset?, limit? }              -> [ { id, name, layer, parent, attachments } ]
+///   scene.findNodes     { query, limit? }                -> same records, case insensitive substring of the name
+///   node.getFields      { id, attachment }               -> { field: value }
+///   node.setFields      { id, attachment, fields }       -> { id, attachment }
+///   assets.reload       { path? }                        -> { committed }
+///   profiler.getCounters                                 -> [ { function, file, ms } ] of the last whole frame
+///   engine.pause / engine.resume / engine.getState       -> { paused, frame, pendingFrames }
+///   engine.step         { frames? }                      -> same state, the frames run on the following updates
 class XPMcpServer
 {
   public:
@@ -28,9 +61,76 @@ class XPMcpServer
     ~XPMcpServer();
     void initialize();
     void finalize();
+    // executes the requests received since the last call, must be called from the engine thread between two frames
     void update();
+    // whether scripts and physics advance this frame, false while paused unless a step was requested
+    [[nodiscard]] bool shouldStepFrame();
 
   private:
-    XPRegistry* const _registry = nullptr;
-    std::thread       t;
-};
\ No newline at end of file
+    struct Request
+    {
+        uint32_t       connectionId;
+        nlohmann::json message;
+    };
+
+    struct Connection
+    {
+        int                     fd;
+        std::string             input;
+        // written by the engine thread, drained by the socket thread, both under _mutex
+        std::deque<std::string> output;
+        size_t                  outputOffset;
+    };
+
+    // bytes of one connection's response on their way to the socket thread
+    struct Output
+    {
+        uint32_t    connectionId;
+        std::string buffer;
+    };
+
+    typedef void (XPMcpServer::*MethodFn)(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+
+    void serve();
+    void wake();
+    void closeConnection(uint32_t connectionId);
+    void receiveLines(uint32_t connectionId, Connection& connection);
+    void enqueueOutput(uint32_t connectionId, std::string&& bytes);
+
+    void execute(Output& out, const nlohmann::json& message);
+    void write(Output& out, std::string_view bytes);
+    void flush(Output& out);
+    void writeResult(Output& out, const nlohmann::json& id, const nlohmann::json& result);
+    void writeError(Output& out, const nlohmann::json& id, int code, std::string_view message);
+    void beginResult(Output& out, const nlohmann::json& id);
+    void endResult(Output& out);
+
+    void listNodes(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+    void findNodes(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+    void getFields(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+    void setFields(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+    void reloadAssets(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+    void getCounters(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+    void pause(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+    void resume(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+    void step(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+    void getState(Output& out, const nlohmann::json& id, const nlohmann::json& params);
+
+    XPRegistry* const                              _registry = nullptr;
+    std::unordered_map<std::string_view, MethodFn> _methods;
+    std::thread                                    _thread;
+    std::atomic<bool>                              _shouldStop = false;
+    std::string                                    _socketPath;
+    int                                            _listenFd   = -1;
+    int                                            _wakeFds[2] = { -1, -1 };
+    // guards _connections' output queues, the connection set itself and _requests
+    std::mutex                               _mutex;
+    std::unordered_map<uint32_t, Connection> _connections;
+    uint32_t                                 _nextConnectionId = 1;
+    std::vector<Request>                     _requests;
+    // engine thread only
+    std::vector<Request> _executing;
+    bool                 _isPaused      = false;
+    uint32_t             _pendingFrames = 0;
+    uint64_t             _frame         = 0;
+};
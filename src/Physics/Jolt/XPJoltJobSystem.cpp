@@ -0,0 +1,104 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Physics/Jolt/XPJoltJobSystem.h>
+
+#include <Utilities/XPThreadPool.h>
+
+#include <algorithm>
+
+XPJoltJobSystem::XPJoltJobSystem(XPThreadPool* threadPool, JPH::uint maxJobs, JPH::uint maxBarriers)
+  : JPH::JobSystemWithBarrier(maxBarriers)
+  , _threadPool(threadPool)
+  , _maxConcurrency(0)
+  , _numQueuedJobs(0)
+{
+    _jobs.Init(maxJobs, maxJobs);
+}
+
+XPJoltJobSystem::~XPJoltJobSystem()
+{
+    // every queued job holds a reference until it ran, wait for them before the free list goes away. only for ours,
+    // the pool is shared and the rest of the engine may keep it busy
+    _threadPool->waitUntil([this] { return _numQueuedJobs.load(std::memory_order_acquire) == 0; });
+}
+
+int
+XPJoltJobSystem::GetMaxConcurrency() const
+{
+    // the thread waiting on a barrier runs jobs as well
+    const int numThreads     = static_cast<int>(_threadPool->getNumWorkers()) + 1;
+    const int maxConcurrency = _maxConcurrency.load(std::memory_order_relaxed);
+    return maxConcurrency > 0 ? std::min(maxConcurrency, numThreads) : numThreads;
+}
+
+XPJoltJobSystem::JobHandle
+XPJoltJobSystem::CreateJob(const char*        inName,
+                           JPH::ColorArg      inColor,
+                           const JobFunction& inJobFunction,
+                           JPH::uint32        inNumDependencies)
+{
+    // out of jobs, run queued pool jobs until one of them frees its Jolt job rather than sleeping on workers that may
+    // not exist
+    JPH::uint32 index = JPH::FixedSizeFreeList<Job>::cInvalidObjectIndex;
+    _threadPool->waitUntil([&] {
+        index = _jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+        return index != JPH::FixedSizeFreeList<Job>::cInvalidObjectIndex;
+    });
+    Job* job = &_jobs.Get(index);
+
+    // the handle keeps the job alive, jobs with dependencies are queued once the last one is done
+    JobHandle handle(job);
+    if (inNumDependencies == 0) { QueueJob(job); }
+    return handle;
+}
+
+void
+XPJoltJobSystem::setMaxConcurrency(int maxConcurrency)
+{
+    _maxConcurrency.store(std::max(maxConcurrency, 0), std::memory_order_relaxed);
+}
+
+void
+XPJoltJobSystem::QueueJob(Job* inJob)
+{
+    // without workers nothing would run the pool job until the pool is waited on, run it right away like
+    // JobSystemSingleThreaded does
+    if (_threadPool->getNumWorkers() == 0) {
+        inJob->Execute();
+        return;
+    }
+
+    // a barrier may run the job before a worker picks it up, Execute only lets the first caller through
+    inJob->AddRef();
+    _numQueuedJobs.fetch_add(1, std::memory_order_relaxed);
+    _threadPool->submit([this, inJob](uint32_t) {
+        inJob->Execute();
+        inJob->Release();
+        // last access to this, the destructor may return right after
+        _numQueuedJobs.fetch_sub(1, std::memory_order_release);
+    });
+}
+
+void
+XPJoltJobSystem::QueueJobs(Job** inJobs, JPH::uint inNumJobs)
+{
+    for (JPH::uint i = 0; i < inNumJobs; ++i) { QueueJob(inJobs[i]); }
+}
+
+void
+XPJoltJobSystem::FreeJob(Job* inJob)
+{
+    _jobs.DestroyObject(inJob);
+}
@@ -0,0 +1,64 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wall"
+    #pragma clang diagnostic ignored "-Weverything"
+#endif
+// Always keep it before including others
+#include <Jolt/Jolt.h>
+// --------------------------------------
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
+
+#include <atomic>
+
+class XPThreadPool;
+
+/// @brief Runs the jobs of the physics update on the engine's XPThreadPool instead of a pool of its own, so physics,
+/// the software rasterizer and the rest of the engine's parallel work share the same workers. Jolt's jobs are kept in
+/// a free list like JobSystemThreadPool does, queueing one only wraps it into a pool job that executes and releases it.
+class XPJoltJobSystem final : public JPH::JobSystemWithBarrier
+{
+  public:
+    XPJoltJobSystem(XPThreadPool* threadPool, JPH::uint maxJobs, JPH::uint maxBarriers);
+    ~XPJoltJobSystem() final;
+    int       GetMaxConcurrency() const final;
+    JobHandle CreateJob(const char*        inName,
+                        JPH::ColorArg      inColor,
+                        const JobFunction& inJobFunction,
+                        JPH::uint32        inNumDependencies = 0) final;
+    // caps how many threads the physics update splits its work for, 0 or more than the pool has means all of them
+    void setMaxConcurrency(int maxConcurrency);
+
+  protected:
+    void QueueJob(Job* inJob) final;
+    void QueueJobs(Job** inJobs, JPH::uint inNumJobs) final;
+    void FreeJob(Job* inJob) final;
+
+  private:
+    XPThreadPool* const         _threadPool;
+    JPH::FixedSizeFreeList<Job> _jobs;
+    std::atomic<int>            _maxConcurrency;
+    // pool jobs queued by QueueJob that still hold a reference to their Jolt job
+    std::atomic<uint32_t> _numQueuedJobs;
+};
@@ -18,16 +18,26 @@
 #include <DataPipeline/XPFile.h>
 #include <DataPipeline/XPMeshAsset.h>
 #include <DataPipeline/XPMeshBuffer.h>
+#include <Engine/XPConsole.h>
+#include <Engine/XPEngine.h>
 #include <Engine/XPRegistry.h>
+#include <Physics/Jolt/XPJoltJobSystem.h>
+#include <Physics/Jolt/XPJoltTempAllocator.h>
 #include <Renderer/Interface/XPIRenderer.h>
 #include <SceneDescriptor/XPAttachments.h>
 #include <SceneDescriptor/XPLayer.h>
 #include <SceneDescriptor/XPNode.h>
 #include <SceneDescriptor/XPScene.h>
+#include <SceneDescriptor/XPSceneStore.h>
 #include <Utilities/XPLogger.h>
+#include <Utilities/XPProfiler.h>
+#include <Utilities/XPThreadPool.h>
 
+#include <algorithm>
+#include <optional>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #ifdef __clang__
     #pragma clang diagnostic push
@@ -39,8 +49,6 @@
 #include <Jolt/Jolt.h>
 // ------------------------------------------
 #include <Jolt/Core/Factory.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
-#include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Physics/Body/BodyActivationListener.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
@@ -240,6 +248,30 @@ class XPPhysicsBodyActivationListener : public BodyActivationListener
     std::unordered_map<Collider*, BodyID> bodies_to_update;
 };
 
+static constexpr int XPJoltDefaultTempAllocatorMB = 100;
+
+// console variables are optional, headless tools run without a console
+static int
+getConsoleInt(XPRegistry* const registry, const char* name, int fallback)
+{
+    XPEngine* engine = registry->getEngine();
+    if (engine == nullptr || engine->getConsole() == nullptr) { return fallback; }
+    auto optVariable = engine->getConsole()->getVariable(name);
+    if (optVariable.has_value()) {
+        if (auto variable = std::dynamic_pointer_cast<XPConsoleVar<int>>(optVariable.value())) {
+            return variable->getValue();
+        }
+    }
+    return fallback;
+}
+
+static size_t
+getTempAllocatorBudget(XPRegistry* const registry)
+{
+    const int megabytes = getConsoleInt(registry, "physics.tempAllocatorMB", XPJoltDefaultTempAllocatorMB);
+    return static_cast<size_t>(std::max(megabytes, 1)) * 1024 * 1024;
+}
+
 XPJoltPhysics::XPJoltPhysics(XPRegistry* const registry)
   : XPIPhysics(registry)
   , _registry(registry)
@@ -273,14 +305,19 @@ XPJoltPhysics::initialize()
     RegisterTypes();
 
     // We need a temp allocator for temporary allocations during the physics update.
-    // We're pre-allocating 80 MB to avoid having to do allocations during the physics simulation update.
-    // If you don't want to pre-allocate you can also use TempAllocatorMalloc to fallback to malloc/free.
-    _temp_allocator = XP_NEW JPH::TempAllocatorImpl(100 * 1024 * 1024);
+    // It pre-allocates physics.tempAllocatorMB and grows between two updates when one of them needed more.
+    _temp_allocator = XP_NEW XPJoltTempAllocator(getTempAllocatorBudget(_registry));
 
     // We need a job system that will execute physics jobs on multiple threads.
-    // Typically you would implement the JobSystem interface yourself and let Jolt Physics run on top of your own job
-    // scheduler. JobSystemThreadPool is an example implementation.
-    _job_system = XP_NEW JPH::JobSystemThreadPool(cMaxPhysicsJobs, cMaxPhysicsBarriers, 4);
+    // The jobs run on the engine's job pool next to the rest of its parallel work, tools that never initialize the
+    // engine get a pool of their own.
+    XPThreadPool* threadPool = _registry->getEngine() ? _registry->getEngine()->getThreadPool() : nullptr;
+    if (threadPool == nullptr) {
+        _threadPool = std::make_unique<XPThreadPool>();
+        threadPool  = _threadPool.get();
+    }
+    _job_system = XP_NEW XPJoltJobSystem(threadPool, cMaxPhysicsJobs, cMaxPhysicsBarriers);
+    _job_system->setMaxConcurrency(getConsoleInt(_registry, "physics.threads", 0));
 
     // This is the max amount of rigidbodies that you can add to the physics system.
     // If you try to add more you'll get an error.
@@ -336,6 +373,7 @@ XPJoltPhysics::finalize()
     XP_DELETE _broad_phase_layer_interface;
     XP_DELETE _job_system;
     XP_DELETE _temp_allocator;
+    _threadPool.reset();
 
     // Unregisters all types with the factory and cleans up the default material
     UnregisterTypes();
@@ -347,13 +385,21 @@ XPJoltPhysics::finalize()
 XPProfilable void
 XPJoltPhysics::update()
 {
+    createPendingColliders(_registry->getScene());
+
     if (_isPlaying) {
         float               deltaTime      = _registry->getRenderer()->getDeltaTime();
         const uint          collisionSteps = 1;
         XPPhysicsSceneData& sceneData      = getOrCreateScene();
         JPH::BodyInterface& bodyInterface  = sceneData._physics_system->GetBodyInterface();
+        _job_system->setMaxConcurrency(getConsoleInt(_registry, "physics.threads", 0));
         sceneData._physics_system->Update(deltaTime, collisionSteps, _temp_allocator, _job_system);
 
+        // nothing is allocated between two updates, grow after an overflow or apply a new budget now
+        _temp_allocator->resize(getTempAllocatorBudget(_registry));
+        XPProfiler::instance().setCounter("physics.tempAllocatorHighWaterMark", _temp_allocator->getHighWaterMark());
+        XPProfiler::instance().setCounter("physics.tempAllocatorSize", _temp_allocator->getSize());
+
         JPH::RMat44 mat;
         JPH::RVec3  position;
         JPH::Quat   rotation;
@@ -382,15 +428,8 @@ XPJoltPhysics::onSceneTraitsChanged()
 {
     XPScene* scene = _registry->getScene();
     if (scene->hasAnyAttachmentChanges(XPEInteractionHasColliderChanges | XPEInteractionHasRigidbodyChanges)) {
-        for (auto& layer : scene->getLayers()) {
-            for (auto& node : layer->getNodes()) {
-                if (node->hasAnyAttachmentChanges(XPEInteractionHasColliderChanges |
-                                                  XPEInteractionHasRigidbodyChanges)) {
-                    destroyColliders(node);
-                    if (node->hasColliderAttachment() && node->hasRigidbodyAttachment()) { createColliders(node); }
-                }
-            }
-        }
+        // the attach hooks already queued every node that needs a body, field edits go through the onChanged hooks
+        createPendingColliders(scene);
         scene->removeAttachmentChanges(XPEInteractionHasColliderChanges | XPEInteractionHasRigidbodyChanges);
     }
 }
@@ -414,6 +453,22 @@ XPJoltPhysics::fetchModelMatrix(void* rigidbody, void* shape, XPMat4<float>& mod
 
 XPProfilable void
 XPJoltPhysics::createColliders(XPNode* node)
+{
+    XPPhysicsSceneData& physicsSceneData = getOrCreateScene(node->getAbsoluteScene());
+
+    if (physicsSceneData._bodies.find(node->getId()) != physicsSceneData._bodies.end()) {
+        // no need to create anything, just return
+        return;
+    }
+
+    // the body is created together with the rest of the batch by the next createPendingColliders
+    if (physicsSceneData._pendingNodesSet.insert(node->getId()).second) {
+        physicsSceneData._pendingNodes.push_back(node->getId());
+    }
+}
+
+XPProfilable void
+XPJoltPhysics::createCollidersImmediately(XPNode* node)
 {
     XPPhysicsSceneData& physicsSceneData = getOrCreateScene();
 
@@ -466,6 +521,7 @@ XPJoltPhysics::destroyColliders(XPNode* node)
     if (_scenes.find(scene->getId()) == _scenes.end()) { return; }
 
     XPPhysicsSceneData& sceneData = _scenes[scene->getId()];
+    sceneData._pendingNodesSet.erase(node->getId());
     if (sceneData._bodies.find(node->getId()) != sceneData._bodies.end()) {
         JPH::Body* body = sceneData._bodies[node->getId()];
 
@@ -480,11 +536,14 @@ XPJoltPhysics::destroyColliders(XPNode* node)
             XPColliderInfo& colliderInfo = collider->info[i];
             sceneData._body_activation_listener->bodies_to_update.erase(colliderInfo.owner);
         }
+        if (node->hasRigidbodyAttachment()) { node->getRigidbody()->simRef = nullptr; }
     }
 }
 
-XPProfilable JPH::ShapeRefC
-             createPlaneShape(XPColliderInfo& colliderInfo)
+// the primitive shapes are also built on the job threads by createPendingColliders, the profiler is not thread safe
+// so they are left out of it
+JPH::ShapeRefC
+createPlaneShape(XPColliderInfo& colliderInfo)
 {
     BoxShapeSettings shapeSettings(
       Vec3(colliderInfo.parameters.boxWidth <= 0.1f ? 0.1f : colliderInfo.parameters.boxWidth,
@@ -498,8 +557,8 @@ XPProfilable JPH::ShapeRefC
     return shape;
 }
 
-XPProfilable JPH::ShapeRefC
-             createBoxShape(XPColliderInfo& colliderInfo)
+JPH::ShapeRefC
+createBoxShape(XPColliderInfo& colliderInfo)
 {
     BoxShapeSettings shapeSettings(
       Vec3(colliderInfo.parameters.boxWidth <= 0.1f ? 0.1f : colliderInfo.parameters.boxWidth,
@@ -513,8 +572,8 @@ XPProfilable JPH::ShapeRefC
     return shape;
 }
 
-XPProfilable JPH::ShapeRefC
-             createSphereShape(XPColliderInfo& colliderInfo)
+JPH::ShapeRefC
+createSphereShape(XPColliderInfo& colliderInfo)
 {
     SphereShapeSettings shapeSettings(colliderInfo.parameters.sphereRadius);
     shapeSettings.SetEmbedded();
@@ -525,8 +584,8 @@ XPProfilable JPH::ShapeRefC
     return shape;
 }
 
-XPProfilable JPH::ShapeRefC
-             createCapsuleShape(XPColliderInfo& colliderInfo)
+JPH::ShapeRefC
+createCapsuleShape(XPColliderInfo& colliderInfo)
 {
     CapsuleShapeSettings shapeSettings(colliderInfo.parameters.capsuleHeight / 2.0f,
                                        colliderInfo.parameters.capsuleRadius);
@@ -538,8 +597,8 @@ XPProfilable JPH::ShapeRefC
     return shape;
 }
 
-XPProfilable JPH::ShapeRefC
-             createCylinderShape(XPColliderInfo& colliderInfo)
+JPH::ShapeRefC
+createCylinderShape(XPColliderInfo& colliderInfo)
 {
     CylinderShapeSettings shapeSettings(colliderInfo.parameters.cylinderHeight / 2.0f,
                                         colliderInfo.parameters.cylinderRadius);
@@ -591,6 +650,195 @@ XPProfilable JPH::ShapeRefC
     return shape;
 }
 
+// lookup without uploading for the job threads, the mesh assets of a batch are uploaded before its jobs are kicked
+static JPH::ShapeRefC
+findCachedMeshShape(XPColliderInfo& colliderInfo, const XPJoltShapesCache& shapesCache, const XPMeshBuffer* mb)
+{
+    ShapeRefC shape;
+    auto      assetIt = shapesCache.find(mb->getMeshAsset()->getId());
+    if (assetIt != shapesCache.end()) {
+        auto objectIt = assetIt->second.find(colliderInfo.meshBufferObjectIndex);
+        if (objectIt != assetIt->second.end()) { shape = objectIt->second; }
+    }
+    colliderInfo.shapeRef = (void*)shape.GetPtr();
+    return shape;
+}
+
+// one body of a createPendingColliders batch, everything the shape needs is resolved before the jobs start
+struct XPJoltPendingBody
+{
+    XPNode*                          node;
+    Collider*                        collider;
+    std::vector<const XPMeshBuffer*> meshBuffers;
+    ShapeRefC                        shape;
+};
+
+static ShapeRefC
+buildPendingSubShape(XPJoltPendingBody& pendingBody, const XPJoltShapesCache& shapesCache, size_t infoIndex)
+{
+    XPColliderInfo& colliderInfo = pendingBody.collider->info[infoIndex];
+    switch (colliderInfo.shape) {
+        case XPEColliderShapePlane: return createPlaneShape(colliderInfo);
+        case XPEColliderShapeBox: return createBoxShape(colliderInfo);
+        case XPEColliderShapeSphere: return createSphereShape(colliderInfo);
+        case XPEColliderShapeCapsule: return createCapsuleShape(colliderInfo);
+        case XPEColliderShapeCylinder: return createCylinderShape(colliderInfo);
+        case XPEColliderShapeConvexMesh:
+        case XPEColliderShapeTriangleMesh: {
+            const XPMeshBuffer* mb = pendingBody.meshBuffers[infoIndex];
+            return mb != nullptr ? findCachedMeshShape(colliderInfo, shapesCache, mb) : ShapeRefC();
+        }
+
+        default: assert(false); return ShapeRefC();
+    }
+}
+
+static void
+buildPendingShape(XPJoltPendingBody& pendingBody, const XPJoltShapesCache& shapesCache)
+{
+    if (pendingBody.collider->info.size() == 1) {
+        pendingBody.shape = buildPendingSubShape(pendingBody, shapesCache, 0);
+        return;
+    }
+
+    // compound shapes
+    JPH::StaticCompoundShapeSettings compoundSettings;
+    for (size_t i = 0; i < pendingBody.collider->info.size(); ++i) {
+        ShapeRefC shape = buildPendingSubShape(pendingBody, shapesCache, i);
+        if (shape != nullptr) { compoundSettings.AddShape(Vec3::sZero(), Quat::sIdentity(), shape); }
+    }
+    ShapeSettings::ShapeResult shapeResult = compoundSettings.Create();
+    if (shapeResult.IsValid()) { pendingBody.shape = shapeResult.Get(); }
+}
+
+XPProfilable void
+XPJoltPhysics::createPendingColliders(XPScene* scene)
+{
+    auto sceneIt = _scenes.find(scene->getId());
+    if (sceneIt == _scenes.end() || sceneIt->second._pendingNodes.empty()) { return; }
+
+    XPPhysicsSceneData&  sceneData         = sceneIt->second;
+    XPSceneStore*        sceneStore        = scene->getSceneStore();
+    XPDataPipelineStore* dataPipelineStore = scene->getRegistry()->getDataPipelineStore();
+
+    // gather what is still valid, mesh assets upload on this thread since they write into the shapes cache
+    std::vector<XPJoltPendingBody> pendingBodies;
+    pendingBodies.reserve(sceneData._pendingNodes.size());
+    for (uint32_t nodeId : sceneData._pendingNodes) {
+        // destroyColliders drops the id from the set only, the vector may still hold it
+        if (sceneData._pendingNodesSet.erase(nodeId) == 0) { continue; }
+        if (sceneData._bodies.find(nodeId) != sceneData._bodies.end()) { continue; }
+
+        std::optional<XPNode*> optNode = sceneStore->getNode(nodeId);
+        if (!optNode.has_value()) { continue; }
+        XPNode* node = optNode.value();
+        if (!node->hasColliderAttachment() || !node->hasRigidbodyAttachment() || !node->hasTransformAttachment()) {
+            continue;
+        }
+        Collider* collider = node->getCollider();
+        if (collider->info.empty()) { continue; }
+
+        XPJoltPendingBody& pendingBody = pendingBodies.emplace_back();
+        pendingBody.node               = node;
+        pendingBody.collider           = collider;
+        pendingBody.meshBuffers.resize(collider->info.size(), nullptr);
+        for (size_t i = 0; i < collider->info.size(); ++i) {
+            if (collider->info[i].shape != XPEColliderShapeConvexMesh &&
+                collider->info[i].shape != XPEColliderShapeTriangleMesh) {
+                continue;
+            }
+            // a single collider info points at the main mesh buffer through the first mesh renderer info
+            const size_t  mrInfoIndex = collider->info.size() == 1 ? 0 : i;
+            XPMeshBuffer* mb          = nullptr;
+            if (node->hasMeshRendererAttachment()) {
+                MeshRenderer* mr = node->getMeshRenderer();
+                if (mrInfoIndex < mr->info.size() && mr->info[mrInfoIndex].meshBuffer != nullptr) {
+                    mb = dataPipelineStore->getMeshBuffer(mr->info[mrInfoIndex].meshBuffer->getId()).value_or(nullptr);
+                }
+            }
+            if (mb == nullptr) {
+                XP_LOGV(
+                  XPLoggerSeverityError, "Mesh renderer info %zu seems to be incorrect, skipping ..", mrInfoIndex);
+                continue;
+            }
+            uploadMeshAsset(mb->getMeshAsset());
+            pendingBody.meshBuffers[i] = mb;
+        }
+    }
+    sceneData._pendingNodes.clear();
+
+    // build the shapes, small batches are not worth waking the job system up for
+    const size_t cMinBodiesPerJob = 64;
+    const size_t bodiesCount      = pendingBodies.size();
+    if (bodiesCount < cMinBodiesPerJob * 2) {
+        for (XPJoltPendingBody& pendingBody : pendingBodies) { buildPendingShape(pendingBody, _shapesCache); }
+    } else {
+        const size_t maxJobs      = static_cast<size_t>(std::max(_job_system->GetMaxConcurrency(), 1)) * 4;
+        const size_t jobsCount    = std::min(maxJobs, bodiesCount / cMinBodiesPerJob);
+        const size_t bodiesPerJob = (bodiesCount + jobsCount - 1) / jobsCount;
+
+        const XPJoltShapesCache& shapesCache = _shapesCache;
+        JobSystem::Barrier*      barrier     = _job_system->CreateBarrier();
+        for (size_t begin = 0; begin < bodiesCount; begin += bodiesPerJob) {
+            const size_t         end = std::min(begin + bodiesPerJob, bodiesCount);
+            JobSystem::JobHandle handle =
+              _job_system->CreateJob("XPJoltBuildShapes", Color::sGreen, [&pendingBodies, &shapesCache, begin, end]() {
+                  for (size_t i = begin; i < end; ++i) { buildPendingShape(pendingBodies[i], shapesCache); }
+              });
+            barrier->AddJob(handle);
+        }
+        _job_system->WaitForJobs(barrier);
+        _job_system->DestroyBarrier(barrier);
+    }
+
+    // create the bodies and insert them into the broadphase at once instead of one tree update per body
+    BodyInterface&      bodyInterface = sceneData._physics_system->GetBodyInterface();
+    std::vector<BodyID> bodyIds;
+    bodyIds.reserve(bodiesCount);
+    for (XPJoltPendingBody& pendingBody : pendingBodies) {
+        XPNode*    node     = pendingBody.node;
+        Collider*  collider = pendingBody.collider;
+        Rigidbody* rb       = node->getRigidbody();
+        Transform* tr       = node->getTransform();
+        if (pendingBody.shape == nullptr) {
+            XP_LOGV(XPLoggerSeverityError, "Failed to create collision shape for <%s>", node->getName().c_str());
+            continue;
+        }
+
+        // triangle meshes and compounds are always static
+        const bool isStatic = rb->isStatic || collider->info.size() > 1 ||
+                              collider->info[0].shape == XPEColliderShapeTriangleMesh;
+        BodyCreationSettings settings(pendingBody.shape,
+                                      RVec3(tr->location.x, tr->location.y, tr->location.z),
+                                      Quat::sEulerAngles(RVec3(tr->euler.x, tr->euler.y, tr->euler.z)),
+                                      isStatic ? EMotionType::Static : EMotionType::Dynamic,
+                                      isStatic ? Layers::NON_MOVING : Layers::MOVING);
+        settings.mUserData = (uint64_t)collider;
+        if (!isStatic) {
+            // the velocity setters skip bodies that are still pending, pick up what they were given meanwhile
+            settings.mLinearVelocity  = Vec3(rb->linearVelocity.x, rb->linearVelocity.y, rb->linearVelocity.z);
+            settings.mAngularVelocity = Vec3(rb->angularVelocity.x, rb->angularVelocity.y, rb->angularVelocity.z);
+        }
+
+        Body* body = bodyInterface.CreateBody(settings);
+        if (body == nullptr) {
+            XP_LOG(XPLoggerSeverityError, "Exceeded the maximum number of physics bodies");
+            break;
+        }
+
+        sceneData._bodies[node->getId()]                                = body;
+        sceneData._body_activation_listener->bodies_to_update[collider] = body->GetID();
+        rb->simRef                                                      = (void*)body;
+        bodyIds.push_back(body->GetID());
+    }
+
+    if (!bodyIds.empty()) {
+        const int               addCount = static_cast<int>(bodyIds.size());
+        BodyInterface::AddState addState = bodyInterface.AddBodiesPrepare(bodyIds.data(), addCount);
+        bodyInterface.AddBodiesFinalize(bodyIds.data(), addCount, addState, EActivation::Activate);
+    }
+}
+
 XPProfilable void
 XPJoltPhysics::createPlaneCollider(XPNode* node)
 {
@@ -747,14 +995,7 @@ XPJoltPhysics::createConvexMeshCollider(XPNode* node)
     XPColliderInfo& colliderInfo = collider->info[0];
 
     XPDataPipelineStore* dataPipelineStore = node->getAbsoluteScene()->getRegistry()->getDataPipelineStore();
-    const auto&          meshBuffers       = dataPipelineStore->getMeshBuffers();
-    const XPMeshBuffer*  mb                = nullptr;
-    for (const auto& pair : meshBuffers) {
-        if (mr->info[0].meshBuffer->getId() == pair.second->getId()) {
-            mb = mr->info[0].meshBuffer;
-            break;
-        }
-    }
+    const XPMeshBuffer*  mb = dataPipelineStore->getMeshBuffer(mr->info[0].meshBuffer->getId()).value_or(nullptr);
 
     if (mb == nullptr) { return; }
 
@@ -790,17 +1031,10 @@ XPJoltPhysics::createTriMeshCollider(XPNode* node)
 
     XPColliderInfo& colliderInfo = collider->info[0];
 
+    // Note that it doesn't matter if we're only accessing index 0 of info
+    // We just want to point to the main mesh buffer which contains the whole main mesh buffer
     XPDataPipelineStore* dataPipelineStore = node->getAbsoluteScene()->getRegistry()->getDataPipelineStore();
-    const auto&          meshBuffers       = dataPipelineStore->getMeshBuffers();
-    const XPMeshBuffer*  mb                = nullptr;
-    for (const auto& pair : meshBuffers) {
-        // Note that it doesn't matter if we're only accessing index 0 of info
-        // We just want to point to the main mesh buffer which contains the whole main mesh buffer
-        if (mr->info[0].meshBuffer->getId() == pair.second->getId()) {
-            mb = mr->info[0].meshBuffer;
-            break;
-        }
-    }
+    const XPMeshBuffer*  mb = dataPipelineStore->getMeshBuffer(mr->info[0].meshBuffer->getId()).value_or(nullptr);
 
     if (mb == nullptr) { return; }
 
@@ -837,7 +1071,6 @@ XPJoltPhysics::createCompoundCollider(XPNode* node)
     BodyInterface&      bodyInterface    = physicsSceneData._physics_system->GetBodyInterface();
 
     XPDataPipelineStore* dataPipelineStore = node->getAbsoluteScene()->getRegistry()->getDataPipelineStore();
-    const auto&          meshBuffers       = dataPipelineStore->getMeshBuffers();
 
     // Create compound shape settings
     JPH::StaticCompoundShapeSettings compoundSettings;
@@ -862,15 +1095,8 @@ XPJoltPhysics::createCompoundCollider(XPNode* node)
             } break;
             case XPEColliderShapeConvexMesh: {
                 XPMeshRendererInfo& mrInfo = mr->info[i];
-                const XPMeshBuffer* mb     = nullptr;
-                for (const auto& pair : meshBuffers) {
-                    // Note that it doesn't matter if we're only accessing index 0 of info
-                    // We just want to point to the main mesh buffer which contains the whole main mesh buffer
-                    if (mrInfo.meshBuffer->getId() == pair.second->getId()) {
-                        mb = mrInfo.meshBuffer;
-                        break;
-                    }
-                }
+                const XPMeshBuffer* mb =
+                  dataPipelineStore->getMeshBuffer(mrInfo.meshBuffer->getId()).value_or(nullptr);
                 if (mb == nullptr) {
                     XP_LOGV(XPLoggerSeverityError, "Mesh renderer info %zu seems to be incorrect, skipping ..", i);
                     continue;
@@ -882,15 +1108,8 @@ XPJoltPhysics::createCompoundCollider(XPNode* node)
             } break;
             case XPEColliderShapeTriangleMesh: {
                 XPMeshRendererInfo& mrInfo = mr->info[i];
-                const XPMeshBuffer* mb     = nullptr;
-                for (const auto& pair : meshBuffers) {
-                    // Note that it doesn't matter if we're only accessing index 0 of info
-                    // We just want to point to the main mesh buffer which contains the whole main mesh buffer
-                    if (mrInfo.meshBuffer->getId() == pair.second->getId()) {
-                        mb = mrInfo.meshBuffer;
-                        break;
-                    }
-                }
+                const XPMeshBuffer* mb =
+                  dataPipelineStore->getMeshBuffer(mrInfo.meshBuffer->getId()).value_or(nullptr);
                 if (mb == nullptr) {
                     XP_LOGV(XPLoggerSeverityError, "Mesh renderer info %zu seems to be incorrect, skipping ..", i);
                     continue;
@@ -931,7 +1150,8 @@ XPJoltPhysics::createCompoundCollider(XPNode* node)
 XPProfilable void
 XPJoltPhysics::setRigidbodyPositionAndRotation(XPNode* node)
 {
-    if (node->hasRigidbodyAttachment() && node->hasTransformAttachment()) {
+    // bodies that are still pending read the transform when they get created
+    if (node->hasRigidbodyAttachment() && node->hasTransformAttachment() && node->getRigidbody()->simRef != nullptr) {
         Rigidbody*          rb = node->getRigidbody();
         Transform*          tr = node->getTransform();
         JPH::RVec3          position(tr->location.x, tr->location.y, tr->location.z);
@@ -946,7 +1166,7 @@ XPJoltPhysics::setRigidbodyPositionAndRotation(XPNode* node)
 XPProfilable void
 XPJoltPhysics::setRigidbodyLinearVelocity(XPNode* node)
 {
-    if (node->hasRigidbodyAttachment()) {
+    if (node->hasRigidbodyAttachment() && node->getRigidbody()->simRef != nullptr) {
         Rigidbody*          rb               = node->getRigidbody();
         XPPhysicsSceneData& physicsSceneData = getOrCreateScene();
         BodyInterface&      bodyInterface    = physicsSceneData._physics_system->GetBodyInterface();
@@ -958,7 +1178,7 @@ XPJoltPhysics::setRigidbodyLinearVelocity(XPNode* node)
 XPProfilable void
 XPJoltPhysics::setRigidbodyAngularVelocity(XPNode* node)
 {
-    if (node->hasRigidbodyAttachment()) {
+    if (node->hasRigidbodyAttachment() && node->getRigidbody()->simRef != nullptr) {
         Rigidbody*          rb               = node->getRigidbody();
         XPPhysicsSceneData& physicsSceneData = getOrCreateScene();
         BodyInterface&      bodyInterface    = physicsSceneData._physics_system->GetBodyInterface();
@@ -971,7 +1191,7 @@ XPJoltPhysics::setRigidbodyAngularVelocity(XPNode* node)
 XPProfilable void
 XPJoltPhysics::setRigidbodyStatic(XPNode* node)
 {
-    if (node->hasRigidbodyAttachment()) {
+    if (node->hasRigidbodyAttachment() && node->getRigidbody()->simRef != nullptr) {
         Rigidbody*          rb               = node->getRigidbody();
         XPPhysicsSceneData& physicsSceneData = getOrCreateScene();
         BodyInterface&      bodyInterface    = physicsSceneData._physics_system->GetBodyInterface();
@@ -988,7 +1208,10 @@ XPProfilable void
 XPJoltPhysics::updateColliderShape(XPNode* node)
 {
     if (node->hasColliderAttachment() && node->hasRigidbodyAttachment() && node->hasTransformAttachment()) {
-        Rigidbody*          rb               = node->getRigidbody();
+        Rigidbody* rb = node->getRigidbody();
+        // a pending body picks up the new shape when it gets created
+        if (rb->simRef == nullptr) { return; }
+
         XPPhysicsSceneData& physicsSceneData = getOrCreateScene();
         BodyInterface&      bodyInterface    = physicsSceneData._physics_system->GetBodyInterface();
         std::tuple<JPH::Vec3, JPH::Vec3, JPH::Vec3> old;
@@ -1004,9 +1227,11 @@ XPJoltPhysics::updateColliderShape(XPNode* node)
         bodyInterface.DestroyBody(((JPH::Body*)rb->simRef)->GetID());
 
         physicsSceneData._bodies.erase(node->getId());
+        rb->simRef = nullptr;
 
         // create new collision shapes and rigidbodies
-        createColliders(node);
+        createCollidersImmediately(node);
+        if (rb->simRef == nullptr) { return; }
 
         // set rigidbody values back
         bodyInterface.SetPosition(((JPH::Body*)rb->simRef)->GetID(), std::get<0>(old), JPH::EActivation::Activate);
@@ -1102,7 +1327,12 @@ XPJoltPhysics::reUploadMeshAsset(XPMeshAsset* meshAsset)
 XPProfilable XPPhysicsSceneData&
 XPJoltPhysics::getOrCreateScene()
 {
-    XPScene* scene = _registry->getScene();
+    return getOrCreateScene(_registry->getScene());
+}
+
+XPProfilable XPPhysicsSceneData&
+XPJoltPhysics::getOrCreateScene(XPScene* scene)
+{
     assert(scene != nullptr);
     if (_scenes.find(scene->getId()) != _scenes.end()) {
         // scene is already created previously
@@ -33,11 +33,15 @@
 #endif
 
 #include <list>
+#include <memory>
+#include <unordered_set>
+#include <vector>
 
 class XPScene;
+class XPThreadPool;
+class XPJoltJobSystem;
+class XPJoltTempAllocator;
 namespace JPH {
-class TempAllocatorImpl;
-class JobSystemThreadPool;
 class PhysicsSystem;
 class Body;
 class Shape;
@@ -56,6 +60,9 @@ struct XPPhysicsSceneData
     XPPhysicsBodyActivationListener*         _body_activation_listener;
     XPPhysicsContactListener*                _contact_listener;
     std::unordered_map<uint32_t, JPH::Body*> _bodies;
+    // ids of the nodes waiting for their bodies in the order they were requested, the set only filters duplicates
+    std::vector<uint32_t>                    _pendingNodes;
+    std::unordered_set<uint32_t>             _pendingNodesSet;
 };
 
 class XPJoltPhysics final : public XPIPhysics
@@ -93,19 +100,27 @@ class XPJoltPhysics final : public XPIPhysics
     void        endReUploadMeshAssets() final;
     void        reUploadMeshAsset(XPMeshAsset* meshAsset) final;
 
+    // creates the bodies of every node createColliders was called for since the last call, the shapes are built in
+    // parallel on the job system and the bodies are inserted into the broadphase together
+    void createPendingColliders(XPScene* scene);
+
   private:
     XPPhysicsSceneData& getOrCreateScene();
+    XPPhysicsSceneData& getOrCreateScene(XPScene* scene);
+    void                createCollidersImmediately(XPNode* node);
     void                createScene(XPScene* scene);
     void                destroyScene(uint32_t sceneId);
     void                reCreateScene(XPScene* scene);
 
     XPRegistry* const                                _registry = nullptr;
     bool                                             _isPlaying;
-    JPH::TempAllocatorImpl*                          _temp_allocator;
-    JPH::JobSystemThreadPool*                        _job_system;
+    XPJoltTempAllocator*                             _temp_allocator;
+    XPJoltJobSystem*                                 _job_system;
     BPLayerInterfaceImpl*                            _broad_phase_layer_interface;
     ObjectVsBroadPhaseLayerFilterImpl*               _object_vs_broadphase_layer_filter;
     ObjectLayerPairFilterImpl*                       _object_vs_object_layer_filter;
     std::unordered_map<uint32_t, XPPhysicsSceneData> _scenes;
     XPJoltShapesCache                                _shapesCache;
+    // only when the engine has no job pool to share, like in the benchmarks
+    std::unique_ptr<XPThreadPool> _threadPool;
 };
\ No newline at end of file
@@ -0,0 +1,115 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Physics/Jolt/XPJoltTempAllocator.h>
+
+#include <Utilities/XPLogger.h>
+
+#include <algorithm>
+#include <cassert>
+
+static constexpr size_t XPJoltTempAllocatorGranularity = 1024 * 1024;
+
+static size_t
+alignSize(JPH::uint size)
+{
+    return JPH::AlignUp(size, JPH_RVECTOR_ALIGNMENT);
+}
+
+XPJoltTempAllocator::XPJoltTempAllocator(size_t budget)
+  : _base(nullptr)
+  , _size(0)
+  , _top(0)
+  , _overflow(0)
+  , _highWaterMark(0)
+{
+    resize(budget);
+}
+
+XPJoltTempAllocator::~XPJoltTempAllocator()
+{
+    assert(_top == 0 && _overflow == 0);
+    JPH::AlignedFree(_base);
+}
+
+void*
+XPJoltTempAllocator::Allocate(JPH::uint inSize)
+{
+    if (inSize == 0) { return nullptr; }
+
+    // jolt orders the allocations and frees of an update through job dependencies, no locking needed
+    const size_t size = alignSize(inSize);
+    void*        address;
+    if (_top + size <= _size) {
+        address = _base + _top;
+        _top += size;
+    } else {
+        address = JPH::AlignedAllocate(size, JPH_RVECTOR_ALIGNMENT);
+        _overflow += size;
+    }
+    _highWaterMark = std::max(_highWaterMark, _top + _overflow);
+    return address;
+}
+
+void
+XPJoltTempAllocator::Free(void* inAddress, JPH::uint inSize)
+{
+    if (inAddress == nullptr) {
+        assert(inSize == 0);
+        return;
+    }
+
+    const size_t size  = alignSize(inSize);
+    uint8_t*     bytes = static_cast<uint8_t*>(inAddress);
+    if (bytes >= _base && bytes < _base + _size) {
+        _top -= size;
+        assert(_base + _top == bytes && "Temp allocations have to be freed in reverse order");
+    } else {
+        _overflow -= size;
+        JPH::AlignedFree(inAddress);
+    }
+}
+
+void
+XPJoltTempAllocator::resize(size_t budget)
+{
+    assert(_top == 0 && _overflow == 0);
+
+    const size_t needed = std::max(budget, _highWaterMark);
+    const size_t size =
+      (needed + XPJoltTempAllocatorGranularity - 1) / XPJoltTempAllocatorGranularity * XPJoltTempAllocatorGranularity;
+    if (size == _size) { return; }
+
+    if (_highWaterMark > _size && _size != 0) {
+        XP_LOGV(XPLoggerSeverityWarning,
+                "Physics temp allocator ran out of its %zu MB, growing it to %zu MB",
+                _size / XPJoltTempAllocatorGranularity,
+                size / XPJoltTempAllocatorGranularity);
+    }
+    JPH::AlignedFree(_base);
+    _base = static_cast<uint8_t*>(JPH::AlignedAllocate(size, JPH_RVECTOR_ALIGNMENT));
+    _size = size;
+}
+
+size_t
+XPJoltTempAllocator::getSize() const
+{
+    return _size;
+}
+
+size_t
+XPJoltTempAllocator::getHighWaterMark() const
+{
+    return _highWaterMark;
+}
@@ -0,0 +1,57 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wall"
+    #pragma clang diagnostic ignored "-Weverything"
+#endif
+// Always keep it before including others
+#include <Jolt/Jolt.h>
+// --------------------------------------
+#include <Jolt/Core/TempAllocator.h>
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// @brief Stack allocator for the physics update like JPH::TempAllocatorImpl, except that running out of the block
+/// does not abort. Allocations that do not fit go to the heap, and the next resize() between two updates grows the
+/// block to the most bytes that were in use at once so the following updates fit again.
+class XPJoltTempAllocator final : public JPH::TempAllocator
+{
+  public:
+    explicit XPJoltTempAllocator(size_t budget);
+    ~XPJoltTempAllocator() final;
+    void* Allocate(JPH::uint inSize) final;
+    void  Free(void* inAddress, JPH::uint inSize) final;
+    // has to be called while nothing is allocated, the block never gets smaller than the high water mark
+    void                 resize(size_t budget);
+    [[nodiscard]] size_t getSize() const;
+    [[nodiscard]] size_t getHighWaterMark() const;
+
+  private:
+    uint8_t* _base;
+    size_t   _size;
+    size_t   _top;
+    // bytes currently allocated on the heap because the block was full
+    size_t _overflow;
+    size_t _highWaterMark;
+};
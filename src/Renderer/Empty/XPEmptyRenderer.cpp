@@ -0,0 +1,295 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Renderer/Empty/XPEmptyRenderer.h>
+
+XPEmptyRenderer::XPEmptyRenderer(XPRegistry* const registry)
+  : XPIRenderer(registry)
+  , _registry(registry)
+  , _resolution(1024, 720)
+  , _deltaTime(1.0f / 60.0f)
+{
+}
+
+XPEmptyRenderer::~XPEmptyRenderer() {}
+
+void
+XPEmptyRenderer::initialize()
+{
+}
+
+void
+XPEmptyRenderer::finalize()
+{
+}
+
+void
+XPEmptyRenderer::update()
+{
+}
+
+void
+XPEmptyRenderer::onSceneTraitsChanged()
+{
+}
+
+void
+XPEmptyRenderer::invalidateDeviceObjects()
+{
+}
+
+void
+XPEmptyRenderer::createDeviceObjects()
+{
+}
+
+void
+XPEmptyRenderer::beginUploadMeshAssets()
+{
+}
+
+void
+XPEmptyRenderer::endUploadMeshAssets()
+{
+}
+
+void
+XPEmptyRenderer::beginUploadShaderAssets()
+{
+}
+
+void
+XPEmptyRenderer::endUploadShaderAssets()
+{
+}
+
+void
+XPEmptyRenderer::beginUploadTextureAssets()
+{
+}
+
+void
+XPEmptyRenderer::endUploadTextureAssets()
+{
+}
+
+void
+XPEmptyRenderer::beginReUploadMeshAssets()
+{
+}
+
+void
+XPEmptyRenderer::endReUploadMeshAssets()
+{
+}
+
+void
+XPEmptyRenderer::beginReUploadShaderAssets()
+{
+}
+
+void
+XPEmptyRenderer::endReUploadShaderAssets()
+{
+}
+
+void
+XPEmptyRenderer::beginReUploadTextureAssets()
+{
+}
+
+void
+XPEmptyRenderer::endReUploadTextureAssets()
+{
+}
+
+void
+XPEmptyRenderer::uploadMeshAsset(XPMeshAsset* meshAsset)
+{
+    XP_UNUSED(meshAsset)
+}
+
+void
+XPEmptyRenderer::uploadShaderAsset(XPShaderAsset* shaderAsset)
+{
+    XP_UNUSED(shaderAsset)
+}
+
+void
+XPEmptyRenderer::uploadTextureAsset(XPTextureAsset* textureAsset)
+{
+    XP_UNUSED(textureAsset)
+}
+
+void
+XPEmptyRenderer::reUploadMeshAsset(XPMeshAsset* meshAsset)
+{
+    XP_UNUSED(meshAsset)
+}
+
+void
+XPEmptyRenderer::reUploadShaderAsset(XPShaderAsset* shaderAsset)
+{
+    XP_UNUSED(shaderAsset)
+}
+
+void
+XPEmptyRenderer::reUploadTextureAsset(XPTextureAsset* textureAsset)
+{
+    XP_UNUSED(textureAsset)
+}
+
+XPRegistry*
+XPEmptyRenderer::getRegistry()
+{
+    return _registry;
+}
+
+void
+XPEmptyRenderer::getSelectedNodeFromViewport(XPVec2<float> coordinates, const std::function<void(XPNode*)>& callback)
+{
+    XP_UNUSED(coordinates)
+
+    callback(nullptr);
+}
+
+void*
+XPEmptyRenderer::getMainTexture()
+{
+    return nullptr;
+}
+
+XPVec2<int>
+XPEmptyRenderer::getWindowSize()
+{
+    return _resolution;
+}
+
+XPVec2<int>
+XPEmptyRenderer::getResolution()
+{
+    return _resolution;
+}
+
+XPVec2<float>
+XPEmptyRenderer::getMouseLocation()
+{
+    return { 0.0f, 0.0f };
+}
+
+XPVec2<float>
+XPEmptyRenderer::getNormalizedMouseLocation()
+{
+    return { 0.0f, 0.0f };
+}
+
+bool
+XPEmptyRenderer::isLeftMouseButtonPressed()
+{
+    return false;
+}
+
+bool
+XPEmptyRenderer::isMiddleMouseButtonPressed()
+{
+    return false;
+}
+
+bool
+XPEmptyRenderer::isRightMouseButtonPressed()
+{
+    return false;
+}
+
+float
+XPEmptyRenderer::getDeltaTime()
+{
+    return _deltaTime;
+}
+
+uint32_t
+XPEmptyRenderer::getNumDrawCallsVertices()
+{
+    return 0;
+}
+
+uint32_t
+XPEmptyRenderer::getTotalNumDrawCallsVertices()
+{
+    return 0;
+}
+
+uint32_t
+XPEmptyRenderer::getNumDrawCalls()
+{
+    return 0;
+}
+
+uint32_t
+XPEmptyRenderer::getTotalNumDrawCalls()
+{
+    return 0;
+}
+
+bool
+XPEmptyRenderer::isCapturingDebugFrames()
+{
+    return false;
+}
+
+bool
+XPEmptyRenderer::isFramebufferResized()
+{
+    return false;
+}
+
+float
+XPEmptyRenderer::getRenderingGPUTime()
+{
+    return 0.0f;
+}
+
+float
+XPEmptyRenderer::getUIGPUTime()
+{
+    return 0.0f;
+}
+
+float
+XPEmptyRenderer::getComputeGPUTime()
+{
+    return 0.0f;
+}
+
+void
+XPEmptyRenderer::captureDebugFrames()
+{
+}
+
+void
+XPEmptyRenderer::setFramebufferResized()
+{
+}
+
+void
+XPEmptyRenderer::simulateCopy(const char* text)
+{
+    XP_UNUSED(text)
+}
+
+std::string
+XPEmptyRenderer::simulatePaste()
+{
+    return {};
+}
@@ -0,0 +1,81 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#include <Renderer/Interface/XPIRenderer.h>
+
+/// @brief A renderer without a window or a device, it advances frames at a fixed rate for headless runs
+class XPEmptyRenderer final : public XPIRenderer
+{
+  public:
+    XPEmptyRenderer(XPRegistry* const registry);
+    ~XPEmptyRenderer() final;
+    void          initialize() final;
+    void          finalize() final;
+    void          update() final;
+    void          onSceneTraitsChanged() final;
+    void          invalidateDeviceObjects() final;
+    void          createDeviceObjects() final;
+    void          beginUploadMeshAssets() final;
+    void          endUploadMeshAssets() final;
+    void          beginUploadShaderAssets() final;
+    void          endUploadShaderAssets() final;
+    void          beginUploadTextureAssets() final;
+    void          endUploadTextureAssets() final;
+    void          beginReUploadMeshAssets() final;
+    void          endReUploadMeshAssets() final;
+    void          beginReUploadShaderAssets() final;
+    void          endReUploadShaderAssets() final;
+    void          beginReUploadTextureAssets() final;
+    void          endReUploadTextureAssets() final;
+    void          uploadMeshAsset(XPMeshAsset* meshAsset) final;
+    void          uploadShaderAsset(XPShaderAsset* shaderAsset) final;
+    void          uploadTextureAsset(XPTextureAsset* textureAsset) final;
+    void          reUploadMeshAsset(XPMeshAsset* meshAsset) final;
+    void          reUploadShaderAsset(XPShaderAsset* shaderAsset) final;
+    void          reUploadTextureAsset(XPTextureAsset* textureAsset) final;
+    XPRegistry*   getRegistry() final;
+    void          getSelectedNodeFromViewport(XPVec2<float> coordinates, const std::function<void(XPNode*)>&) final;
+    void*         getMainTexture() final;
+    XPVec2<int>   getWindowSize() final;
+    XPVec2<int>   getResolution() final;
+    XPVec2<float> getMouseLocation() final;
+    XPVec2<float> getNormalizedMouseLocation() final;
+    bool          isLeftMouseButtonPressed() final;
+    bool          isMiddleMouseButtonPressed() final;
+    bool          isRightMouseButtonPressed() final;
+    float         getDeltaTime() final;
+    uint32_t      getNumDrawCallsVertices() final;
+    uint32_t      getTotalNumDrawCallsVertices() final;
+    uint32_t      getNumDrawCalls() final;
+    uint32_t      getTotalNumDrawCalls() final;
+    bool          isCapturingDebugFrames() final;
+    bool          isFramebufferResized() final;
+    float         getRenderingGPUTime() final;
+    float         getUIGPUTime() final;
+    float         getComputeGPUTime() final;
+    void          captureDebugFrames() final;
+    void          setFramebufferResized() final;
+    void          simulateCopy(const char* text) final;
+    std::string   simulatePaste() final;
+
+  private:
+    XPRegistry* const _registry = nullptr;
+    XPVec2<int>       _resolution;
+    // every frame advances the same amount of time so that headless runs are reproducible
+    float             _deltaTime;
+};
@@ -43,7 +43,9 @@
 #include <Utilities/XPFreeCameraSystem.h>
 #include <Utilities/XPLogger.h>
 
+#include <algorithm>
 #include <cstring>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -71,52 +73,53 @@ XPMetalRenderer::XPMetalRenderer(XPRegistry* const registry)
 
 XPMetalRenderer::~XPMetalRenderer() {}
 
+// the GLSL prototypes are cross compiled to MSL next to the shader assets. they don't depend on each other so they
+// compile as one batch, the ones that didn't change since the last run come out of the shader cache
+static void
+crossCompilePrototypeShaders(const std::string& prototypesPath)
+{
+    std::vector<std::filesystem::path> files;
+    XPFS::iterateFilesRecursivelyFromDirectory(prototypesPath.c_str(), files);
+
+    std::vector<std::filesystem::path>      prototypes;
+    std::vector<XPCrossShaderOperationInfo> operations;
+    for (const auto& prototypeEntry : files) {
+        if (!std::filesystem::is_regular_file(prototypeEntry)) { continue; }
+        const std::string fullPath = prototypeEntry.string();
+        if (!XPFile::isShaderFile(fullPath) || prototypeEntry.extension() != ".glsl") { continue; }
+
+        XPCrossShaderOperationInfo operation = {};
+        operation.input.format               = XPCrossShaderFormat_GLSL_CORE_410;
+        // anything that isn't a vertex shader is assumed to be a fragment shader
+        operation.input.stage =
+          prototypeEntry.stem() == "vert" ? XPCrossShaderStage_Vertex : XPCrossShaderStage_Fragment;
+        operation.output.format = XPCrossShaderFormat_MSL;
+        if (!XPFS::readFileText(fullPath.c_str(), operation.input.source)) { continue; }
+        prototypes.push_back(prototypeEntry);
+        operations.push_back(std::move(operation));
+    }
+
+    crossShaderCompileBatch(operations);
+    for (size_t i = 0; i < operations.size(); ++i) {
+        const std::filesystem::path& prototypeEntry = prototypes[i];
+        if (!operations[i].succeeded) {
+            XP_LOGV(XPLoggerSeverityError,
+                    "Failed to cross compile the prototype shader [%s]\n%s",
+                    prototypeEntry.string().c_str(),
+                    operations[i].output.errors.c_str());
+            continue;
+        }
+        std::filesystem::create_directories(XPFS::buildShaderAssetsPath(prototypeEntry.parent_path().stem().string()));
+        const std::string outputFilepath = XPFS::buildShaderAssetsPath(
+          fmt::format("{}/{}.metal", prototypeEntry.parent_path().stem().string(), prototypeEntry.stem().string()));
+        XPFS::writeFileText(outputFilepath.c_str(), operations[i].output.source);
+    }
+}
+
 void
 XPMetalRenderer::initialize()
 {
-    // // TODO: Find a way out for cross compiling from GLSL or whatever else I see possible ..
-    // XPCrossShaderInputInfo inputInfo = {};
-    // inputInfo.format                 = XPCrossShaderFormat_GLSL_CORE_410;
-    // std::vector<std::filesystem::path> files;
-    // XPFS::iterateFilesRecursivelyFromDirectory(_registry->getFileWatch()->getPrototypesPath().c_str(), files);
-    // for (const auto& prototypeEntry : files) {
-    //     if (!std::filesystem::is_regular_file(prototypeEntry)) { continue; }
-    //     auto fullPath = prototypeEntry.string();
-    //     if (XPFile::isShaderFile(fullPath) && prototypeEntry.extension() == ".glsl") {
-    //         XPCrossShaderOutputInfo outputInfo;
-    //         outputInfo.format = XPCrossShaderFormat_MSL;
-    //         bool success      = false;
-    //         if (prototypeEntry.stem() == "frag") {
-    //             inputInfo.stage = XPCrossShaderStage_Fragment;
-    //             if (XPFS::readFileText(fullPath.c_str(), inputInfo.source)) {
-    //                 success = crossShaderCompile(inputInfo, outputInfo);
-    //             }
-    //         } else if (prototypeEntry.stem() == "vert") {
-    //             inputInfo.stage = XPCrossShaderStage_Vertex;
-    //             if (XPFS::readFileText(fullPath.c_str(), inputInfo.source)) {
-    //                 success = crossShaderCompile(inputInfo, outputInfo);
-    //             }
-    //         } else {
-    //             // assume it's a fragment shader
-    //             inputInfo.stage = XPCrossShaderStage_Fragment;
-    //             if (XPFS::readFileText(fullPath.c_str(), inputInfo.source)) {
-    //                 success = crossShaderCompile(inputInfo, outputInfo);
-    //             }
-    //         }
-    //         if (!success) {
-    //             XP_LOGV(XPLoggerSeverityError,
-    //                     "Failed to cross compile the prototype shader [%s]\n%s",
-    //                     fullPath.c_str(),
-    //                     outputInfo.errors.c_str());
-    //         } else {
-    //             std::filesystem::create_directories(XPFS::buildShaderAssetsPath(prototypeEntry.parent_path().stem()));
-    //             std::string outputFilepath = XPFS::buildShaderAssetsPath(fmt::format(
-    //               "{}/{}.metal", prototypeEntry.parent_path().stem().string().c_str(),
-    //               prototypeEntry.stem().string()));
-    //             XPFS::writeFileText(outputFilepath.c_str(), outputInfo.source);
-    //         }
-    //     }
-    // }
+    crossCompilePrototypeShaders(_registry->getFileWatch()->getPrototypesPath());
 
     _autoReleasePool = NS::AutoreleasePool::alloc()->init();
     _window->initialize();
@@ -557,6 +560,35 @@ XPMetalRenderer::uploadMeshAsset(XPMeshAsset* meshAsset)
     }
 }
 
+static MTL::PixelFormat
+getMetalPixelFormat(XPETextureBufferFormat format)
+{
+    switch (format) {
+        case XPETextureBufferFormat::R8: return MTL::PixelFormat::PixelFormatR8Unorm;
+        case XPETextureBufferFormat::R8_G8: return MTL::PixelFormat::PixelFormatRG8Unorm;
+        case XPETextureBufferFormat::R8_G8_B8_A8: return MTL::PixelFormat::PixelFormatRGBA8Unorm;
+        case XPETextureBufferFormat::BC1_RGBA: return MTL::PixelFormat::PixelFormatBC1_RGBA;
+        case XPETextureBufferFormat::BC3_RGBA: return MTL::PixelFormat::PixelFormatBC3_RGBA;
+        case XPETextureBufferFormat::BC5_RG: return MTL::PixelFormat::PixelFormatBC5_RGUnorm;
+        case XPETextureBufferFormat::BC7_RGBA: return MTL::PixelFormat::PixelFormatBC7_RGBAUnorm;
+        default: XP_LOG(XPLoggerSeverityFatal, "Couldn't find a corresponding texture format to this"); break;
+    }
+    return MTL::PixelFormat::PixelFormatInvalid;
+}
+
+static void
+replaceTextureMipLevels(MTL::Texture* texture, XPTextureBuffer* textureBuffer)
+{
+    const auto& mipLevels = textureBuffer->getMipLevels();
+    for (uint32_t level = 0; level < mipLevels.size(); ++level) {
+        const XPTextureBufferMipLevel& mip    = mipLevels[level];
+        MTL::Region                    region = MTL::Region(0, 0, 0, mip.dimensions.x, mip.dimensions.y, 1);
+        NS::UInteger                   bytesPerRow =
+          XPTextureBuffer::getMipLevelRowPitch(textureBuffer->getFormat(), mip.dimensions.x);
+        texture->replaceRegion(region, level, textureBuffer->getMipPixels(level).data(), bytesPerRow);
+    }
+}
+
 XPProfilable void
 XPMetalRenderer::uploadShaderAsset(XPShaderAsset* shaderAsset){ XP_UNUSED(shaderAsset) }
 
@@ -566,36 +598,19 @@ XPProfilable void XPMetalRenderer::uploadTextureAsset(XPTextureAsset* textureAss
     std::unique_ptr<XPMetalTexture> metalTexture  = std::make_unique<XPMetalTexture>();
     int                             width         = textureBuffer->getDimensions().x;
     int                             height        = textureBuffer->getDimensions().y;
-    int                             channels      = 0;
 
     metalTexture->textureDescriptor = NS::TransferPtr(MTL::TextureDescriptor::alloc()->init());
     metalTexture->textureDescriptor->setWidth(width);
     metalTexture->textureDescriptor->setHeight(height);
-    switch (textureBuffer->getFormat()) {
-        case XPETextureBufferFormat::R8: {
-            metalTexture->textureDescriptor->setPixelFormat(MTL::PixelFormat::PixelFormatR8Unorm);
-            channels = 1;
-        } break;
-        case XPETextureBufferFormat::R8_G8: {
-            metalTexture->textureDescriptor->setPixelFormat(MTL::PixelFormat::PixelFormatRG8Unorm);
-            channels = 2;
-        } break;
-        case XPETextureBufferFormat::R8_G8_B8_A8: {
-            metalTexture->textureDescriptor->setPixelFormat(MTL::PixelFormat::PixelFormatRGBA8Unorm);
-            channels = 4;
-        } break;
-        default: XP_LOG(XPLoggerSeverityFatal, "Couldn't find a corresponding texture format to this"); break;
-    }
+    metalTexture->textureDescriptor->setMipmapLevelCount(std::max(1u, textureBuffer->getMipLevelCount()));
+    metalTexture->textureDescriptor->setPixelFormat(getMetalPixelFormat(textureBuffer->getFormat()));
     metalTexture->textureDescriptor->setStorageMode(MTL::StorageModeShared);
     metalTexture->textureDescriptor->setUsage(MTL::TextureUsageShaderRead);
 
     metalTexture->texture = NS::TransferPtr(_device->newTexture(metalTexture->textureDescriptor.get()));
 
     // fill data
-    MTL::Region  region      = MTL::Region(0, 0, 0, width, height, 1);
-    NS::UInteger bytesPerRow = channels * width;
-
-    metalTexture->texture->replaceRegion(region, 0, textureBuffer->getPixels().data(), bytesPerRow);
+    replaceTextureMipLevels(metalTexture->texture.get(), textureBuffer);
 
     textureAsset->setGPURef((void*)metalTexture->texture.get());
     metalTexture->textureAsset = textureAsset;
@@ -833,38 +848,21 @@ XPMetalRenderer::reUploadTextureAsset(XPTextureAsset* textureAsset)
         XPTextureBuffer* textureBuffer   = textureAsset->getTextureBuffer();
         XPMetalTexture*  metalTextureRef = _textureMap[textureAsset->getFile()->getPath()].get();
 
-        int width    = textureBuffer->getDimensions().x;
-        int height   = textureBuffer->getDimensions().y;
-        int channels = 0;
+        int width  = textureBuffer->getDimensions().x;
+        int height = textureBuffer->getDimensions().y;
 
         metalTextureRef->textureDescriptor = NS::TransferPtr(MTL::TextureDescriptor::alloc()->init());
         metalTextureRef->textureDescriptor->setWidth(width);
         metalTextureRef->textureDescriptor->setHeight(height);
-        switch (textureBuffer->getFormat()) {
-            case XPETextureBufferFormat::R8: {
-                metalTextureRef->textureDescriptor->setPixelFormat(MTL::PixelFormat::PixelFormatR8Unorm);
-                channels = 1;
-            } break;
-            case XPETextureBufferFormat::R8_G8: {
-                metalTextureRef->textureDescriptor->setPixelFormat(MTL::PixelFormat::PixelFormatRG8Unorm);
-                channels = 2;
-            } break;
-            case XPETextureBufferFormat::R8_G8_B8_A8: {
-                metalTextureRef->textureDescriptor->setPixelFormat(MTL::PixelFormat::PixelFormatRGBA8Unorm);
-                channels = 4;
-            } break;
-            default: XP_LOG(XPLoggerSeverityFatal, "Couldn't find a corresponding texture format to this"); break;
-        }
+        metalTextureRef->textureDescriptor->setMipmapLevelCount(std::max(1u, textureBuffer->getMipLevelCount()));
+        metalTextureRef->textureDescriptor->setPixelFormat(getMetalPixelFormat(textureBuffer->getFormat()));
         metalTextureRef->textureDescriptor->setStorageMode(MTL::StorageModeShared);
         metalTextureRef->textureDescriptor->setUsage(MTL::TextureUsageShaderRead);
 
         metalTextureRef->texture = NS::TransferPtr(_device->newTexture(metalTextureRef->textureDescriptor.get()));
 
         // fill data
-        MTL::Region  region      = MTL::Region(0, 0, 0, width, height, 1);
-        NS::UInteger bytesPerRow = channels * width;
-
-        metalTextureRef->texture->replaceRegion(region, 0, textureBuffer->getPixels().data(), bytesPerRow);
+        replaceTextureMipLevels(metalTextureRef->texture.get(), textureBuffer);
 
         textureAsset->setGPURef((void*)metalTextureRef->texture.get());
 
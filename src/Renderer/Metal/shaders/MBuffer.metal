@@ -44,7 +44,7 @@ fragment float4 fragmentShader(VertexOut in [[stage_in]],
                                texture2d<float> albedoTexture [[texture(XPMBufferIndexAlbedo)]],
                                texture2d<float> metallicRoughnessAmbientObjectIdTexture [[texture(XPMBufferIndexMetallicRoughnessAmbientObjectId)]])
 {
-  constexpr sampler textureSampler (mag_filter::linear, min_filter::linear);
+  constexpr sampler textureSampler (mag_filter::linear, min_filter::linear, mip_filter::linear);
   const float4 metallicRoughnessAmbientObjectIdSample = metallicRoughnessAmbientObjectIdTexture.sample(textureSampler, in.texcoord);
   float4 color = idToColorVibrant(uint(metallicRoughnessAmbientObjectIdSample.w));
   return color;
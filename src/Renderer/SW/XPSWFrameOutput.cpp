@@ -0,0 +1,251 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Renderer/SW/XPSWFrameOutput.h>
+#include <Renderer/SW/XPSWLogger.h>
+#include <Renderer/SW/XPSWMaths.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+// the depth buffer stores exponential inverted z, files get it linear and scaled by the range of the frame
+static void
+linearizeDepth(const float* depthBuffer, size_t numPixels, std::vector<float>& depth)
+{
+    depth.resize(numPixels);
+    float maxVal = FLT_MIN, minVal = FLT_MAX;
+    for (size_t i = 0; i < numPixels; ++i) {
+        depth[i] = ExponentialInvertedToLinearZ(depthBuffer[i]);
+        maxVal   = std::max(maxVal, depth[i]);
+        minVal   = std::min(minVal, depth[i]);
+    }
+    float rangeVal = fabs(maxVal - minVal);
+    for (size_t i = 0; i < numPixels; ++i) { depth[i] = (depth[i] / rangeVal) * 255.0f; }
+}
+
+#ifndef __EMSCRIPTEN__
+static bool
+writeEXR(const std::string&               path,
+         const std::vector<const float*>& channels,
+         const std::vector<const char*>&  channelNames,
+         uint32_t                         width,
+         uint32_t                         height,
+         int                              compressionLevel)
+{
+    EXRHeader header;
+    InitEXRHeader(&header);
+
+    EXRImage image;
+    InitEXRImage(&image);
+
+    image.num_channels = static_cast<int>(channels.size());
+    image.width        = static_cast<int>(width);
+    image.height       = static_cast<int>(height);
+    image.images       = reinterpret_cast<unsigned char**>(const_cast<float**>(channels.data()));
+
+    std::vector<EXRChannelInfo> channelInfos(channels.size());
+    std::vector<int>            pixelTypes(channels.size(), TINYEXR_PIXELTYPE_FLOAT);
+    std::vector<int>            requestedPixelTypes(channels.size(), TINYEXR_PIXELTYPE_FLOAT);
+    for (size_t i = 0; i < channels.size(); ++i) { strncpy(channelInfos[i].name, channelNames[i], 255); }
+    header.num_channels          = image.num_channels;
+    header.channels              = channelInfos.data();
+    header.pixel_types           = pixelTypes.data();
+    header.requested_pixel_types = requestedPixelTypes.data();
+    header.compression_type      = compressionLevel > 0 ? TINYEXR_COMPRESSIONTYPE_ZIP : TINYEXR_COMPRESSIONTYPE_NONE;
+
+    const char* err = nullptr;
+    if (SaveEXRImageToFile(&image, &header, path.c_str(), &err) != TINYEXR_SUCCESS) {
+        LOGV_ERROR("Error saving EXR file {}: {}", path, err ? err : "");
+        FreeEXRErrorMessage(err);
+        return false;
+    }
+    return true;
+}
+#endif
+
+static bool
+writePNG(const std::string& path, const float* data, uint32_t width, uint32_t height, uint32_t srcComponents)
+{
+    // 8 bit RGB for color, single channel for depth which is already scaled to 0..255
+    const uint32_t       dstComponents = srcComponents == 4 ? 3 : 1;
+    const float          scale         = srcComponents == 4 ? 255.0f : 1.0f;
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * dstComponents);
+    for (size_t p = 0; p < static_cast<size_t>(width) * height; ++p) {
+        for (uint32_t c = 0; c < dstComponents; ++c) {
+            pixels[p * dstComponents + c] =
+              static_cast<uint8_t>(std::clamp(data[p * srcComponents + c] * scale, 0.0f, 255.0f));
+        }
+    }
+    if (stbi_write_png(path.c_str(), width, height, dstComponents, pixels.data(), width * dstComponents) == 0) {
+        LOGV_ERROR("Error saving PNG file {}", path);
+        return false;
+    }
+    return true;
+}
+
+static bool
+writeRaw(const std::string& path, const float* data, size_t numFloats)
+{
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(numFloats * sizeof(float)));
+    if (!out) {
+        LOGV_ERROR("Error saving raw file {}", path);
+        return false;
+    }
+    return true;
+}
+
+XPSWFrameOutput::XPSWFrameOutput(const XPSWFrameOutputSettings& settings)
+  : _settings(settings)
+  , _numBusyWorkers(0)
+  , _stopping(false)
+{
+    _settings.numWorkers     = std::max(_settings.numWorkers, 1u);
+    _settings.queueCapacity  = std::max(_settings.queueCapacity, 1u);
+    _settings.framesInFlight = std::max(_settings.framesInFlight, 1u);
+    // the level is a global of stb, it is only written here before any worker encodes
+    if (_settings.compressionLevel > 0) { stbi_write_png_compression_level = _settings.compressionLevel; }
+    if (_settings.sink == XPSWEFrameOutputSink_Disk) { std::filesystem::create_directories(_settings.directory); }
+    _workers.reserve(_settings.numWorkers);
+    for (uint32_t i = 0; i < _settings.numWorkers; ++i) { _workers.emplace_back([this] { workerLoop(); }); }
+}
+
+XPSWFrameOutput::~XPSWFrameOutput()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> l(_mut);
+        _stopping = true;
+    }
+    _queueNotEmpty.notify_all();
+    for (std::thread& worker : _workers) { worker.join(); }
+}
+
+void
+XPSWFrameOutput::submit(XPSWFrameBuffers& frameBuffers,
+                        std::string       name,
+                        uint64_t          frameIndex,
+                        uint32_t          width,
+                        uint32_t          height)
+{
+    frameBuffers.inFlight.store(true);
+    {
+        std::unique_lock<std::mutex> l(_mut);
+        _queueNotFull.wait(l, [this] { return _queue.size() < _settings.queueCapacity; });
+        _queue.push_back(Job{ &frameBuffers, std::move(name), frameIndex, width, height });
+    }
+    _queueNotEmpty.notify_one();
+}
+
+void
+XPSWFrameOutput::flush()
+{
+    std::unique_lock<std::mutex> l(_mut);
+    _idle.wait(l, [this] { return _queue.empty() && _numBusyWorkers == 0; });
+}
+
+bool
+XPSWFrameOutput::takeFrame(const std::string& name, XPSWOutputFrame& frame)
+{
+    std::lock_guard<std::mutex> l(_framesMut);
+    auto                        it = _frames.find(name);
+    if (it == _frames.end()) { return false; }
+    frame = std::move(it->second);
+    _frames.erase(it);
+    return true;
+}
+
+void
+XPSWFrameOutput::workerLoop()
+{
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> l(_mut);
+            _queueNotEmpty.wait(l, [this] { return _stopping || !_queue.empty(); });
+            if (_queue.empty()) { return; }
+            job = std::move(_queue.front());
+            _queue.pop_front();
+            ++_numBusyWorkers;
+        }
+        _queueNotFull.notify_one();
+
+        encode(job);
+        job.frameBuffers->inFlight.store(false);
+        job.frameBuffers->inFlight.notify_all();
+
+        {
+            std::lock_guard<std::mutex> l(_mut);
+            --_numBusyWorkers;
+        }
+        _idle.notify_all();
+    }
+}
+
+void
+XPSWFrameOutput::encode(const Job& job)
+{
+    const size_t numPixels   = static_cast<size_t>(job.width) * job.height;
+    const float* colorBuffer = job.frameBuffers->colorBuffer;
+
+    std::vector<float> depth;
+    linearizeDepth(job.frameBuffers->depthBuffer, numPixels, depth);
+
+    if (_settings.sink == XPSWEFrameOutputSink_Memory) {
+        XPSWOutputFrame frame;
+        frame.name       = job.name;
+        frame.frameIndex = job.frameIndex;
+        frame.width      = job.width;
+        frame.height     = job.height;
+        frame.color.assign(colorBuffer, colorBuffer + numPixels * 4);
+        frame.depth = std::move(depth);
+
+        // only the newest frame of every camera is kept so memory stays bounded when nobody takes them
+        std::lock_guard<std::mutex> l(_framesMut);
+        _frames[job.name] = std::move(frame);
+        return;
+    }
+
+    const std::string basePath =
+      (std::filesystem::path(_settings.directory) / (job.name + "_" + std::to_string(job.frameIndex))).string();
+    if (_settings.formats & XPSWEFrameOutputFormat_EXR) {
+#ifndef __EMSCRIPTEN__
+        std::vector<float> r(numPixels), g(numPixels), b(numPixels);
+        for (size_t i = 0; i < numPixels; ++i) {
+            r[i] = colorBuffer[4 * i + 0];
+            g[i] = colorBuffer[4 * i + 1];
+            b[i] = colorBuffer[4 * i + 2];
+        }
+        writeEXR(basePath + "_color.exr",
+                 { r.data(), g.data(), b.data() },
+                 { "R", "G", "B" },
+                 job.width,
+                 job.height,
+                 _settings.compressionLevel);
+        writeEXR(basePath + "_depth.exr", { depth.data() }, { "Z" }, job.width, job.height, _settings.compressionLevel);
+#endif
+    }
+    if (_settings.formats & XPSWEFrameOutputFormat_PNG) {
+        writePNG(basePath + "_color.png", colorBuffer, job.width, job.height, 4);
+        writePNG(basePath + "_depth.png", depth.data(), job.width, job.height, 1);
+    }
+    if (_settings.formats & XPSWEFrameOutputFormat_Raw) {
+        writeRaw(basePath + "_color.raw", colorBuffer, numPixels * 4);
+        writeRaw(basePath + "_depth.raw", depth.data(), numPixels);
+    }
+}
@@ -0,0 +1,126 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum XPSWEFrameOutputFormat : uint32_t
+{
+    XPSWEFrameOutputFormat_None = 0,
+    XPSWEFrameOutputFormat_EXR  = 1 << 0,
+    XPSWEFrameOutputFormat_PNG  = 1 << 1,
+    XPSWEFrameOutputFormat_Raw  = 1 << 2,
+};
+
+enum XPSWEFrameOutputSink
+{
+    XPSWEFrameOutputSink_Disk,
+    XPSWEFrameOutputSink_Memory,
+};
+
+struct XPSWFrameOutputSettings
+{
+    /// @brief bitmask of XPSWEFrameOutputFormat, only used by the disk sink
+    uint32_t             formats = XPSWEFrameOutputFormat_EXR;
+    XPSWEFrameOutputSink sink    = XPSWEFrameOutputSink_Disk;
+    /// @brief 0 writes EXR uncompressed and PNG with the stb default, anything above uses ZIP and that zlib level
+    int      compressionLevel = 0;
+    uint32_t numWorkers       = 2;
+    /// @brief frames waiting to be encoded, submitting more blocks the render thread
+    uint32_t queueCapacity = 4;
+    /// @brief framebuffers every camera cycles through so rasterizing and encoding overlap
+    uint32_t    framesInFlight = 2;
+    std::string directory      = "./output/";
+};
+
+/// @brief a depth and color buffer pair in the framebuffer ring of a camera, marked in flight until the output stage
+/// is done reading it
+struct XPSWFrameBuffers
+{
+    XPSWFrameBuffers()                        = default;
+    XPSWFrameBuffers(const XPSWFrameBuffers&) = delete;
+    ~XPSWFrameBuffers() { free(memory); }
+
+    /// @brief blocks until the output stage released the buffers
+    void waitUntilReleased() const { inFlight.wait(true); }
+
+    uint8_t*          memory      = nullptr;
+    size_t            numBytes    = 0;
+    float*            depthBuffer = nullptr;
+    float*            colorBuffer = nullptr;
+    std::atomic<bool> inFlight    = false;
+};
+
+/// @brief a frame kept by the memory sink, depth is linearized the same way it is for the EXR file
+struct XPSWOutputFrame
+{
+    std::string        name;
+    uint64_t           frameIndex = 0;
+    uint32_t           width      = 0;
+    uint32_t           height     = 0;
+    std::vector<float> color;
+    std::vector<float> depth;
+};
+
+class XPSWFrameOutput
+{
+  public:
+    explicit XPSWFrameOutput(const XPSWFrameOutputSettings& settings);
+    ~XPSWFrameOutput();
+    XPSWFrameOutput(const XPSWFrameOutput&) = delete;
+
+    /// @brief queues the framebuffers for encoding and marks them in flight, blocks while the queue is full. name is
+    /// the same for every frame of a camera, the disk sink appends frameIndex to the file names
+    void submit(XPSWFrameBuffers& frameBuffers, std::string name, uint64_t frameIndex, uint32_t width, uint32_t height);
+    /// @brief blocks until every queued frame is encoded
+    void flush();
+    /// @brief moves out the last frame the memory sink kept for that name, returns false if there is none
+    bool takeFrame(const std::string& name, XPSWOutputFrame& frame);
+    [[nodiscard]] const XPSWFrameOutputSettings& getSettings() const { return _settings; }
+
+  private:
+    struct Job
+    {
+        XPSWFrameBuffers* frameBuffers;
+        std::string       name;
+        uint64_t          frameIndex;
+        uint32_t          width;
+        uint32_t          height;
+    };
+
+    void workerLoop();
+    void encode(const Job& job);
+
+    XPSWFrameOutputSettings                          _settings;
+    std::vector<std::thread>                         _workers;
+    std::deque<Job>                                  _queue;
+    std::mutex                                       _mut;
+    std::condition_variable                          _queueNotEmpty;
+    std::condition_variable                          _queueNotFull;
+    std::condition_variable                          _idle;
+    uint32_t                                         _numBusyWorkers;
+    bool                                             _stopping;
+    std::mutex                                       _framesMut;
+    std::unordered_map<std::string, XPSWOutputFrame> _frames;
+};
@@ -160,6 +160,7 @@ processTextureLoading(XPSWScene<T>&     scene,
             } else {
                 XP_SW_ASSERT_ERROR(false, "We do not handle such cases yet.");
             }
+            buildTextureMips(texture);
             hasTexture = true;
         } else {
             // Handle external texture file
@@ -180,6 +181,9 @@ processTextureLoading(XPSWScene<T>&     scene,
                     texture.channels = 0;
                 } else {
                     LOGV_NOTICE("Done loading texture <{}>", path.string());
+                    // stb reports the channel count of the file, the buffer itself was expanded to rgba
+                    texture.channels = 4;
+                    buildTextureMips(texture);
                     hasTexture = true;
                 }
             }
@@ -339,6 +343,9 @@ processNode(const aiNode*                           node,
         }
 
         // Extract vertices and apply the global transformation
+        meshData.positionsStorage.reserve(aiMesh->mNumVertices);
+        meshData.tangentsStorage.reserve(aiMesh->mNumVertices);
+        meshData.biTangentsStorage.reserve(aiMesh->mNumVertices);
         for (unsigned int j = 0; j < aiMesh->mNumVertices; j++) {
             const aiVector3D&             vertex = aiMesh->mVertices[j];
             glm::vec<4, T, glm::defaultp> transformedVertex =
@@ -349,42 +356,48 @@ processNode(const aiNode*                           node,
             if (transformedVertex.y > meshData.boundingBox.max.y) { meshData.boundingBox.max.y = transformedVertex.y; }
             if (transformedVertex.z < meshData.boundingBox.min.z) { meshData.boundingBox.min.z = transformedVertex.z; }
             if (transformedVertex.z > meshData.boundingBox.max.z) { meshData.boundingBox.max.z = transformedVertex.z; }
-            meshData.vertices.push_back(transformedVertex);
+            meshData.positionsStorage.push_back(transformedVertex);
 
-            const aiVector3D& tangent = aiMesh->mTangents[j];
-            meshData.tangents.push_back(glm::vec<3, T, glm::defaultp>(tangent.x, tangent.y, tangent.z));
+            if (aiMesh->HasTangentsAndBitangents()) {
+                const aiVector3D& tangent = aiMesh->mTangents[j];
+                meshData.tangentsStorage.push_back(
+                  glm::vec<4, T, glm::defaultp>(tangent.x, tangent.y, tangent.z, 0.0f));
 
-            const aiVector3D& biTangent = aiMesh->mBitangents[j];
-            meshData.biTangents.push_back(glm::vec<3, T, glm::defaultp>(biTangent.x, biTangent.y, biTangent.z));
-
-            meshData.colors.push_back(XPVec3<T>{ 1.0f, 1.0f, 1.0f });
+                const aiVector3D& biTangent = aiMesh->mBitangents[j];
+                meshData.biTangentsStorage.push_back(
+                  glm::vec<4, T, glm::defaultp>(biTangent.x, biTangent.y, biTangent.z, 0.0f));
+            }
         }
 
         // Extract normals and apply the normal matrix
         XP_SW_ASSERT_ERROR(aiMesh->HasNormals(), "Expecting a mesh with normals");
         if (aiMesh->HasNormals()) {
+            meshData.normalsStorage.reserve(aiMesh->mNumVertices);
             for (unsigned int j = 0; j < aiMesh->mNumVertices; j++) {
                 const aiVector3D&             normal = aiMesh->mNormals[j];
                 glm::vec<3, T, glm::defaultp> transformedNormal =
-                  normalMatrix * glm::vec<3, T, glm::defaultp>(normal.x, normal.y, normal.z);
-                meshData.normals.push_back(glm::normalize(transformedNormal));
+                  glm::normalize(normalMatrix * glm::vec<3, T, glm::defaultp>(normal.x, normal.y, normal.z));
+                meshData.normalsStorage.push_back(glm::vec<4, T, glm::defaultp>(transformedNormal, 0.0f));
             }
         }
 
         // Extract texture coordinates (UVs)
         XP_SW_ASSERT_ERROR(aiMesh->HasTextureCoords(0), "Expecting a mesh with texture coordinates");
         if (aiMesh->HasTextureCoords(0)) { // Check for the first set of texture coordinates
+            meshData.texCoordsStorage.reserve(aiMesh->mNumVertices);
             for (unsigned int j = 0; j < aiMesh->mNumVertices; j++) {
                 const aiVector3D& texCoord = aiMesh->mTextureCoords[0][j]; // First UV channel
-                meshData.texCoords.push_back(glm::vec<2, T, glm::defaultp>(texCoord.x, texCoord.y));
+                meshData.texCoordsStorage.push_back(glm::vec<4, T, glm::defaultp>(texCoord.x, texCoord.y, 0.0f, 0.0f));
             }
         }
 
         // Extract indices
+        meshData.indicesStorage.reserve(static_cast<size_t>(aiMesh->mNumFaces) * 3);
         for (unsigned int j = 0; j < aiMesh->mNumFaces; j++) {
             const aiFace& face = aiMesh->mFaces[j];
-            for (unsigned int k = 0; k < face.mNumIndices; k++) { meshData.indices.push_back(face.mIndices[k]); }
+            for (unsigned int k = 0; k < face.mNumIndices; k++) { meshData.indicesStorage.push_back(face.mIndices[k]); }
         }
+        meshData.bindStorage();
     }
 
     // Process cameras
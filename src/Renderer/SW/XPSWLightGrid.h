@@ -0,0 +1,188 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Renderer/SW/XPSWLogger.h>
+#include <Renderer/SW/XPSWMaths.h>
+#include <Renderer/SW/XPSWSceneDescriptor.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/// @brief froxel grid of the camera being rendered, screen tiles split into exponential depth slices between the near
+/// and far planes. point lights are assigned to the clusters their range touches so a fragment only iterates the lights
+/// of its own cluster. spot and directional lights light every fragment (the spot light adds ambient outside its cone
+/// at any distance) so they stay in a list every fragment iterates
+template<typename T>
+struct XPSWLightGrid
+{
+    static constexpr uint32_t TileSize  = 64;
+    static constexpr uint32_t NumSlices = 16;
+    // a point light is culled where it adds less than this to a pixel before tone mapping
+    static constexpr float LightCutoff = 1.0f / 256.0f;
+
+    /// @brief distance past which the point light stays under LightCutoff. the light color is the ambient plus the
+    /// diffuse and specular scaled by the attenuation, all of them carrying the intensity, calculateRadiance scales it
+    /// by intensity / d^2 again and the BRDF is assumed to stay under 1. the attenuation goes over 1 when its constant
+    /// term is under 1, so the range is searched for instead of leaving the attenuation out
+    static T getLightRange(const XPSWLight<T>& light)
+    {
+        const XPVec3<T> direct      = light.diffuse + light.specular;
+        const T         peakAmbient = std::max({ light.ambient.x, light.ambient.y, light.ambient.z, T(0) });
+        const T         peakDirect  = std::max({ direct.x, direct.y, direct.z, T(0) });
+        const T         constant    = std::max(light.attenuationConstant, T(0));
+        const T         linear      = std::max(light.attenuationLinear, T(0));
+        const T         quadratic   = std::max(light.attenuationQuadratic, T(0));
+        if (light.intensity == 0 || (peakAmbient == 0 && peakDirect == 0)) { return 0; }
+        if (peakDirect > 0 && constant == 0 && linear == 0 && quadratic == 0) { return FLT_MAX; }
+
+        // the contribution only falls with the distance, the first distance found under the cutoff bounds the range
+        const auto getContribution = [&](T distance) {
+            const T falloff = constant + (linear + quadratic * distance) * distance;
+            const T color   = peakAmbient + (peakDirect > 0 ? peakDirect / falloff : T(0));
+            return color * light.intensity * light.intensity / (distance * distance);
+        };
+        T outside = 1;
+        while (getContribution(outside) > LightCutoff) {
+            if (outside > FLT_MAX / 4) { return FLT_MAX; }
+            outside *= 2;
+        }
+        T inside = 0;
+        for (uint32_t i = 0; i < 16; ++i) {
+            const T middle = (inside + outside) * T(0.5);
+            if (getContribution(middle) > LightCutoff) {
+                inside = middle;
+            } else {
+                outside = middle;
+            }
+        }
+        return outside;
+    }
+
+    /// @brief resets the clusters for the camera and sorts the lights, the slices are then filled by buildSlice
+    void prepare(const std::vector<XPSWLight<T>>& lights, const XPSWCamera<T>& camera)
+    {
+        numTilesX     = (camera.resolution.x + TileSize - 1) / TileSize;
+        numTilesY     = (camera.resolution.y + TileSize - 1) / TileSize;
+        zNear         = camera.zNearPlane;
+        zFar          = camera.zFarPlane;
+        logDepthRatio = std::log(zFar / zNear);
+        viewDepthRow  = { -camera.viewMatrix.glm[0][2],
+                          -camera.viewMatrix.glm[1][2],
+                          -camera.viewMatrix.glm[2][2],
+                          -camera.viewMatrix.glm[3][2] };
+
+        // view space direction through every tile corner, scaled to a depth of 1
+        const uint32_t numCornersX = numTilesX + 1;
+        tileCorners.resize(static_cast<size_t>(numCornersX) * (numTilesY + 1));
+        for (uint32_t cy = 0; cy <= numTilesY; ++cy) {
+            for (uint32_t cx = 0; cx <= numTilesX; ++cx) {
+                const T x = static_cast<T>(std::min(cx * TileSize, camera.resolution.x)) / camera.resolution.x;
+                const T y = static_cast<T>(std::min(cy * TileSize, camera.resolution.y)) / camera.resolution.y;
+                glm::vec<4, T, glm::defaultp> p =
+                  camera.inverseProjectionMatrix.glm * glm::vec<4, T, glm::defaultp>(x * 2 - 1, 1 - y * 2, -1, 1);
+                p /= p.w;
+                tileCorners[cy * numCornersX + cx] = glm::vec<3, T, glm::defaultp>(p) / -p.z;
+            }
+        }
+
+        globalLights.clear();
+        pointLights.clear();
+        pointLightIndices.clear();
+        for (size_t li = 0; li < lights.size(); ++li) {
+            const XPSWLight<T>& light = lights[li];
+            if (light.type != XPSWELightType_Point) {
+                globalLights.push_back(static_cast<uint32_t>(li));
+                continue;
+            }
+            const glm::vec<4, T, glm::defaultp> center =
+              camera.viewMatrix.glm * glm::vec<4, T, glm::defaultp>(light.location.glm, 1);
+            pointLights.push_back({ center.x, center.y, center.z, getLightRange(light) });
+            pointLightIndices.push_back(static_cast<uint32_t>(li));
+        }
+
+        // keep the capacity of the lists from the last frame
+        clusters.resize(static_cast<size_t>(numTilesX) * numTilesY * NumSlices);
+        for (std::vector<uint32_t>& cluster : clusters) { cluster.clear(); }
+    }
+
+    /// @brief assigns the point lights to the clusters of one slice, slices touch disjoint clusters and can be built
+    /// in parallel
+    void buildSlice(uint32_t slice)
+    {
+        const T        sliceNear   = getSliceDepth(slice);
+        const T        sliceFar    = getSliceDepth(slice + 1);
+        const uint32_t numCornersX = numTilesX + 1;
+        for (size_t pi = 0; pi < pointLights.size(); ++pi) {
+            const glm::vec<4, T, glm::defaultp>& light = pointLights[pi];
+            // view space looks down -z
+            if (-light.z + light.w < sliceNear || -light.z - light.w > sliceFar) { continue; }
+            for (uint32_t ty = 0; ty < numTilesY; ++ty) {
+                for (uint32_t tx = 0; tx < numTilesX; ++tx) {
+                    glm::vec<3, T, glm::defaultp> boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+                    for (uint32_t corner = 0; corner < 4; ++corner) {
+                        const glm::vec<3, T, glm::defaultp>& direction =
+                          tileCorners[(ty + (corner >> 1)) * numCornersX + tx + (corner & 1)];
+                        boundsMin = glm::min(boundsMin, glm::min(direction * sliceNear, direction * sliceFar));
+                        boundsMax = glm::max(boundsMax, glm::max(direction * sliceNear, direction * sliceFar));
+                    }
+                    const glm::vec<3, T, glm::defaultp> center(light);
+                    const glm::vec<3, T, glm::defaultp> delta = glm::clamp(center, boundsMin, boundsMax) - center;
+                    if (glm::dot(delta, delta) > light.w * light.w) { continue; }
+                    clusters[getClusterIndex(tx, ty, slice)].push_back(pointLightIndices[pi]);
+                }
+            }
+        }
+    }
+
+    /// @brief point lights of the cluster holding the pixel at the world position
+    [[nodiscard]] const std::vector<uint32_t>& getClusterLights(int64_t x, int64_t y, const XPVec3<T>& worldPos) const
+    {
+        const T        depth  = glm::dot(viewDepthRow, glm::vec<4, T, glm::defaultp>(worldPos.glm, 1));
+        const T        slices = std::log(std::max(depth, zNear) / zNear) / logDepthRatio * NumSlices;
+        const uint32_t slice  = std::min(static_cast<uint32_t>(std::max(slices, T(0))), NumSlices - 1);
+        const uint32_t tx     = std::min(static_cast<uint32_t>(std::max<int64_t>(x, 0) / TileSize), numTilesX - 1);
+        const uint32_t ty     = std::min(static_cast<uint32_t>(std::max<int64_t>(y, 0) / TileSize), numTilesY - 1);
+        return clusters[getClusterIndex(tx, ty, slice)];
+    }
+
+    [[nodiscard]] T getSliceDepth(uint32_t slice) const
+    {
+        return zNear * std::exp(logDepthRatio * static_cast<T>(slice) / NumSlices);
+    }
+    [[nodiscard]] size_t getClusterIndex(uint32_t tx, uint32_t ty, uint32_t slice) const
+    {
+        return (static_cast<size_t>(slice) * numTilesY + ty) * numTilesX + tx;
+    }
+
+    uint32_t numTilesX     = 0;
+    uint32_t numTilesY     = 0;
+    T        zNear         = 0;
+    T        zFar          = 0;
+    T        logDepthRatio = 0;
+    // dot with a world position gives its distance in front of the camera
+    glm::vec<4, T, glm::defaultp>              viewDepthRow;
+    std::vector<glm::vec<3, T, glm::defaultp>> tileCorners;
+    // view space center and range of every point light, pointLightIndices maps them back to the scene lights
+    std::vector<glm::vec<4, T, glm::defaultp>> pointLights;
+    std::vector<uint32_t>                      pointLightIndices;
+    // scene light indices every fragment iterates
+    std::vector<uint32_t> globalLights;
+    // scene light indices per cluster, slice major then tile rows
+    std::vector<std::vector<uint32_t>> clusters;
+};
@@ -14,22 +14,104 @@
 
 #pragma once
 
+#include <Renderer/SW/XPSWLightGrid.h>
 #include <Renderer/SW/XPSWLogger.h>
 #include <Renderer/SW/XPSWMaths.h>
 #include <Renderer/SW/XPSWMemoryPool.h>
 #include <Renderer/SW/XPSWRenderer.h>
 #include <Renderer/SW/XPSWRendererCommon.h>
 #include <Renderer/SW/XPSWSceneDescriptor.h>
+#include <Renderer/SW/XPSWShadowMaps.h>
+#include <Utilities/XPThreadPool.h>
 
+#include <algorithm>
 #include <array>
+#include <cfloat>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 struct XPSWRenderer;
 
 #define MAX_CLIPPED_TRIANGLE_VERTICES (3 * 3)
 
+/// @brief screen tiles of the z pre-pass. triangles are binned per context first, then every tile is rasterized by a
+/// single thread so depth needs no atomics, the depth range each tile ends up with lets the color pass skip triangles
+template<typename T>
+struct XPSWDepthTiles
+{
+    static constexpr uint32_t TileSize = 32;
+    // per pixel depth of a triangle can come out an ulp below the depth of its vertices
+    static constexpr float DepthBias = 1e-5f;
+
+    void reset(const XPVec2<uint32_t>& resolution, uint32_t numContexts)
+    {
+        numTilesX = (resolution.x + TileSize - 1) / TileSize;
+        numTilesY = (resolution.y + TileSize - 1) / TileSize;
+        minDepth.assign(static_cast<size_t>(numTilesX) * numTilesY, 0.0f);
+        maxDepth.assign(static_cast<size_t>(numTilesX) * numTilesY, FLT_MAX);
+        // keep the capacity of the bins from the last frame
+        triangles.resize(numContexts);
+        bins.resize(numContexts);
+        for (uint32_t c = 0; c < numContexts; ++c) {
+            triangles[c].clear();
+            bins[c].resize(minDepth.size());
+            for (std::vector<uint32_t>& bin : bins[c]) { bin.clear(); }
+        }
+    }
+    void bin(const std::array<XPVec4<T>, 3>& projectedVertices, const XPSWBoundingSquare<int64_t>& bs, uint32_t context)
+    {
+        const uint32_t index = static_cast<uint32_t>(triangles[context].size());
+        triangles[context].push_back(projectedVertices);
+        for (int64_t ty = bs.min.y / TileSize; ty <= bs.max.y / TileSize; ++ty) {
+            for (int64_t tx = bs.min.x / TileSize; tx <= bs.max.x / TileSize; ++tx) {
+                bins[context][ty * numTilesX + tx].push_back(index);
+            }
+        }
+    }
+    [[nodiscard]] XPVec4<T> getTileViewport(uint32_t tile, const XPVec2<uint32_t>& resolution) const
+    {
+        const uint32_t x = (tile % numTilesX) * TileSize;
+        const uint32_t y = (tile / numTilesX) * TileSize;
+        return XPVec4<T>{ static_cast<T>(x),
+                          static_cast<T>(y),
+                          static_cast<T>(std::min(x + TileSize, resolution.x)),
+                          static_cast<T>(std::min(y + TileSize, resolution.y)) };
+    }
+    /// @brief true when a triangle with this nearest depth is behind the farthest depth of every tile it covers
+    [[nodiscard]] bool isOccluded(const XPSWBoundingSquare<int64_t>& bs, float nearestDepth) const
+    {
+        if (maxDepth.empty()) { return false; }
+        for (int64_t ty = bs.min.y / TileSize; ty <= bs.max.y / TileSize; ++ty) {
+            for (int64_t tx = bs.min.x / TileSize; tx <= bs.max.x / TileSize; ++tx) {
+                if (nearestDepth <= maxDepth[ty * numTilesX + tx] + DepthBias) { return false; }
+            }
+        }
+        return true;
+    }
+    /// @brief true when a triangle with this farthest depth is in front of the nearest depth of every tile it covers
+    [[nodiscard]] bool isInFront(const XPSWBoundingSquare<int64_t>& bs, float farthestDepth) const
+    {
+        if (minDepth.empty()) { return false; }
+        for (int64_t ty = bs.min.y / TileSize; ty <= bs.max.y / TileSize; ++ty) {
+            for (int64_t tx = bs.min.x / TileSize; tx <= bs.max.x / TileSize; ++tx) {
+                if (farthestDepth > minDepth[ty * numTilesX + tx]) { return false; }
+            }
+        }
+        return true;
+    }
+
+    uint32_t           numTilesX = 0;
+    uint32_t           numTilesY = 0;
+    std::vector<float> minDepth;
+    std::vector<float> maxDepth;
+    // triangles in screen space binned by every context, bins[context][tile] index into triangles[context]
+    std::vector<std::vector<std::array<XPVec4<T>, 3>>> triangles;
+    std::vector<std::vector<std::vector<uint32_t>>>    bins;
+};
+
 template<typename T>
 struct XPSWRasterizer
 {
@@ -46,6 +128,9 @@ struct XPSWRasterizer
         // frameMemoryEnd   = 8 * 1024 * 1024 * sizeof(uint8_t);
         // frameMemory      = static_cast<uint8_t*>(malloc(frameMemoryEnd));
         // frameMemoryStart = 0;
+
+        // the calling thread rasterizes as context 0 until a pool is set
+        threadMemoryPools.resize(1);
     }
     ~XPSWRasterizer()
     {
@@ -55,6 +140,33 @@ struct XPSWRasterizer
         // frameMemoryEnd = 0;
     }
     void                    setScene(XPSWScene<T>* scene) { this->scene = scene; }
+    /// @brief rasterizes on the given pool, null rasterizes on the calling thread
+    void setThreadPool(XPThreadPool* pool)
+    {
+        threadPool = pool;
+        threadMemoryPools.clear();
+        threadMemoryPools.resize(getNumContexts());
+    }
+    [[nodiscard]] uint32_t getNumContexts() const { return threadPool ? threadPool->getMaxContexts() : 1; }
+    // runs function(first, last, contextIndex) over [0, count) on the pool, or at once on the calling thread
+    template<typename F>
+    void forEachRange(size_t count, size_t grainSize, F&& function)
+    {
+#if defined(XP_SW_USE_THREADS)
+        if (threadPool) {
+            threadPool->parallelFor(0, count, grainSize, function);
+            return;
+        }
+#endif
+        if (count > 0) { function(0, count, 0); }
+    }
+    // every context of the pool is only ever used by one thread at a time, so its scratch memory needs no lock
+    XPSWMemoryPool& getThreadMemoryPool(uint32_t contextIndex)
+    {
+        std::unique_ptr<XPSWMemoryPool>& tpm = threadMemoryPools[contextIndex];
+        if (!tpm) { tpm = std::make_unique<XPSWMemoryPool>(32 * 1024 * sizeof(uint8_t)); }
+        return *tpm;
+    }
     [[nodiscard]] XPVec4<T> interpolateVec4(const XPVec3<T>& barycentricCoordinates,
                                             const XPVec4<T>& v0,
                                             const XPVec4<T>& v1,
@@ -362,60 +474,67 @@ struct XPSWRasterizer
 
         return radiance;
     }
+    [[nodiscard]] XPVec3<T> computeLightContribution(const XPVec3<T>&    V,
+                                                     const XPVec3<T>&    point,
+                                                     const XPVec3<T>&    N,
+                                                     const XPSWLight<T>& light,
+                                                     const XPVec3<T>&    BaseColor,
+                                                     const XPVec3<T>&    EmissionColor,
+                                                     const float         Metallic,
+                                                     const float         Roughness,
+                                                     const float         AO)
+    {
+        if (light.type == XPSWELightType_Spot) {
+            return computeSpotLightContribution(V, point, N, light, BaseColor, EmissionColor, Metallic, Roughness, AO);
+        } else if (light.type == XPSWELightType_Point) {
+            return computePointLightContribution(V, point, N, light, BaseColor, EmissionColor, Metallic, Roughness, AO);
+        } else if (light.type == XPSWELightType_Directional) {
+            return computeDirectionalLightContribution(
+              V, point, N, light, BaseColor, EmissionColor, Metallic, Roughness, AO);
+        }
+        XP_SW_ASSERT_ERROR(false, "Unreachable");
+        return { 0.0f, 0.0f, 0.0f };
+    }
     [[nodiscard]] XPVec4<float> fragmentShader(XPSWMemoryPool&                          tpm,
                                                const XPSWCamera<T>&                     camera,
-                                               const XPSWMaterial<T>&                   material,
+                                               const XPSWPBRSample<T>&                  pbrSample,
                                                const XPSWVertexFragmentVaryings<T>&     vertexFragmentVaryings,
-                                               const XPSWVertexFragmentFlatVaryings<T>& vertexFragmentFlatVaryings)
+                                               const XPSWVertexFragmentFlatVaryings<T>& vertexFragmentFlatVaryings,
+                                               const std::vector<uint32_t>&             clusterLights)
     {
         // -------------------------------------------------------------------------------------------------------------
         // VERTEX/FRAGMENT SHADER INTERPOLATED VALUES
         // -------------------------------------------------------------------------------------------------------------
-        const std::vector<XPSWELightType>& LightType            = vertexFragmentFlatVaryings.lightType;
-        const std::vector<float>&     LightAttenuationConstant  = vertexFragmentFlatVaryings.lightAttenuationConstant;
-        const std::vector<float>&     LightAttenuationLinear    = vertexFragmentFlatVaryings.lightAttenuationLinear;
-        const std::vector<float>&     LightAttenuationQuadratic = vertexFragmentFlatVaryings.lightAttenuationQuadratic;
-        const std::vector<float>&     LightAngleOuterCone       = vertexFragmentFlatVaryings.lightAngleOuterCone;
-        const std::vector<XPVec3<T>>& LightPos                  = vertexFragmentFlatVaryings.lightPos;
-        const std::vector<XPVec3<T>>& LightDirection            = vertexFragmentFlatVaryings.lightDirection;
-        const std::vector<XPVec3<T>>& LightColor                = vertexFragmentFlatVaryings.lightColor;
-        const std::vector<float>&     LightIntensity            = vertexFragmentFlatVaryings.lightIntensity;
-        const XPVec3<T>&              ViewPos                   = vertexFragmentFlatVaryings.viewPos;
-        const XPVec4<T>&              FragPos                   = vertexFragmentVaryings.fragPos;
-        const XPVec3<T>&              FragNormal                = vertexFragmentVaryings.fragNormal;
-        const XPVec3<T>&              FragTangent               = vertexFragmentVaryings.fragTangent;
-        const XPVec3<T>&              FragBiTangent             = vertexFragmentVaryings.fragBiTangent;
-        const XPVec2<T>&              FragTexCoord              = vertexFragmentVaryings.fragTextureCoord;
-        const XPVec3<T>&              FragColor                 = vertexFragmentVaryings.fragColor;
+        const XPVec3<T>& ViewPos = vertexFragmentFlatVaryings.viewPos;
+        const XPVec4<T>& FragPos = vertexFragmentVaryings.fragPos;
         // -------------------------------------------------------------------------------------------------------------
 
-        XPVec3<T> BaseColor;
-        XPVec3<T> N;
-        XPVec3<T> EmissionColor;
-        float     Metallic;
-        float     Roughness;
-        float     AO;
-        getPBRMaterial(
-          material, FragTexCoord, FragColor, FragNormal, BaseColor, N, EmissionColor, Metallic, Roughness, AO, true);
+        const XPVec3<T>& BaseColor     = pbrSample.baseColor;
+        const XPVec3<T>& N             = pbrSample.normal;
+        const XPVec3<T>& EmissionColor = pbrSample.emission;
+        const float      Metallic      = pbrSample.metallic;
+        const float      Roughness     = pbrSample.roughness;
+        const float      AO            = pbrSample.ao;
         // -------------------------------------------------------------------------------------------------------------
 
         XPVec3<T> V = ViewPos - FragPos.xyz;
         V.normalize();
 
+        // lights reaching every fragment, then the point lights whose range touches the cluster of this one
         XPVec3<T> Lo = { 0.0f, 0.0f, 0.0f };
-        for (size_t li = 0; li < LightColor.size(); ++li) {
-            if (scene->lights[li].type == XPSWELightType_Spot) {
-                Lo = Lo + computeSpotLightContribution(
-                            V, FragPos.xyz, N, scene->lights[li], BaseColor, EmissionColor, Metallic, Roughness, AO);
-            } else if (scene->lights[li].type == XPSWELightType_Point) {
-                Lo = Lo + computePointLightContribution(
-                            V, FragPos.xyz, N, scene->lights[li], BaseColor, EmissionColor, Metallic, Roughness, AO);
-            } else if (scene->lights[li].type == XPSWELightType_Directional) {
-                Lo = Lo + computeDirectionalLightContribution(
-                            V, FragPos.xyz, N, scene->lights[li], BaseColor, EmissionColor, Metallic, Roughness, AO);
-            } else {
-                XP_SW_ASSERT_ERROR(false, "Unreachable");
-            }
+        for (uint32_t li : lightGrid.globalLights) {
+            const float visibility = shadowMaps.getVisibility(li, FragPos.xyz, N, camera);
+            if (visibility == 0.0f) { continue; }
+            const XPVec3<T> contribution = computeLightContribution(
+              V, FragPos.xyz, N, scene->lights[li], BaseColor, EmissionColor, Metallic, Roughness, AO);
+            Lo = Lo + visibility * contribution;
+        }
+        for (uint32_t li : clusterLights) {
+            const float visibility = shadowMaps.getVisibility(li, FragPos.xyz, N, camera);
+            if (visibility == 0.0f) { continue; }
+            const XPVec3<T> contribution = computePointLightContribution(
+              V, FragPos.xyz, N, scene->lights[li], BaseColor, EmissionColor, Metallic, Roughness, AO);
+            Lo = Lo + visibility * contribution;
         }
 
         // Final color
@@ -424,6 +543,28 @@ struct XPSWRasterizer
         XPVec4<T> finalcolor = XPVec4<T>{ color.x, color.y, color.z, 1.0f };
         return finalcolor;
     }
+
+    // shades a 2x2 quad, textures are sampled once for the quad and lighting runs for the covered lanes only
+    void fragmentShaderQuad(XPSWMemoryPool&                          tpm,
+                            const XPSWCamera<T>&                     camera,
+                            const XPSWMaterial<T>&                   material,
+                            const XPSWVertexFragmentVaryings<T>*     vertexFragmentVaryings,
+                            const XPSWVertexFragmentFlatVaryings<T>& vertexFragmentFlatVaryings,
+                            int64_t                                  x,
+                            int64_t                                  y,
+                            uint32_t                                 laneMask,
+                            XPVec4<float>*                           fragColors)
+    {
+        XPSWPBRSample<T> pbrSamples[4];
+        getPBRMaterialQuad(material, vertexFragmentVaryings, pbrSamples, true);
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            if ((laneMask & (1u << lane)) == 0) { continue; }
+            const std::vector<uint32_t>& clusterLights = lightGrid.getClusterLights(
+              x + (lane & 1), y + (lane >> 1), vertexFragmentVaryings[lane].fragPos.xyz);
+            fragColors[lane] = fragmentShader(
+              tpm, camera, pbrSamples[lane], vertexFragmentVaryings[lane], vertexFragmentFlatVaryings, clusterLights);
+        }
+    }
     void drawTriangle(XPSWMemoryPool&                                     tpm,
                       XPSWRasterizerEventListener&                        listener,
                       const std::array<XPVec4<T>, 3>&                     projectedVertices,
@@ -445,47 +586,74 @@ struct XPSWRasterizer
           projectedVertices[0].xy,
           projectedVertices[1].xy,
           projectedVertices[2].xy);
+        if (bs.max.x < bs.min.x || bs.max.y < bs.min.y) { return; }
         // ----------------------------------------------------------------------------------------------------------------
 
-        // loop over bounding square
-        for (int64_t y = bs.min.y; y <= bs.max.y; ++y) {
-            for (int64_t x = bs.min.x; x <= bs.max.x; ++x) {
-                // Compute barycentric coordinates for (x, y)
-                XPVec3<T> barycentricCoordinates = computeBarycentricCoordinates(
-                  projectedVertices[0].xy, projectedVertices[1].xy, projectedVertices[2].xy, x, y);
+        // depth is monotonic in w, so the vertices bound the depth of every pixel of the triangle
+        // --------------------------------------------------------------------------------
+        const T nearestW  = std::min({ projectedVertices[0].w, projectedVertices[1].w, projectedVertices[2].w });
+        const T farthestW = std::max({ projectedVertices[0].w, projectedVertices[1].w, projectedVertices[2].w });
+        if (depthTiles.isOccluded(bs, LinearToExponentialInvertedZ(nearestW, camera.zNearPlane, camera.zFarPlane))) {
+            return;
+        }
+        // no need to read the depth buffer when the whole triangle is in front of what the pre-pass wrote
+        const bool depthTestPasses =
+          depthTiles.isInFront(bs, LinearToExponentialInvertedZ(farthestW, camera.zNearPlane, camera.zFarPlane));
+        // ----------------------------------------------------------------------------------------------------------------
 
-                if (barycentricCoordinates.x >= 0 && barycentricCoordinates.y >= 0 && barycentricCoordinates.z >= 0) {
-                    // point is inside the triangle
-                    T d = calculateDepthZeroToOne(barycentricCoordinates,
-                                                  projectedVertices[0],
-                                                  projectedVertices[1],
-                                                  projectedVertices[2],
-                                                  camera.zNearPlane,
-                                                  camera.zFarPlane);
-                    XP_SW_ASSERT_ERROR(d >= 0.0 && d <= 1.0, "Depth should be between 0.0 and 1.0");
-                    if (d <= camera.getDepthBufferPixel(x, y)) {
-                        // Interpolate attributes ----------------------------------------------------------------------
-                        XPSWVertexFragmentVaryings<T>* fragmentVaryings =
-                          (XPSWVertexFragmentVaryings<T>*)tpm.pushFrameMemory(sizeof(XPSWVertexFragmentVaryings<T>));
-                        interpolateVertex(
-                          barycentricCoordinates, projectedVertices, vertexFragmentVaryings, *fragmentVaryings);
-                        // ---------------------------------------------------------------------------------------------
-
-                        XPVec4<float> fragColor = fragmentShader(tpm,
-                                                                 camera,
-                                                                 scene->materials.at(materialIndex),
-                                                                 *fragmentVaryings,
-                                                                 vertexFragmentFlatVaryings);
-
-                        camera.writeColorBuffer(fragColor, x, y);
-
-                        // fragmentVaryings
-                        tpm.popFrameMemory(sizeof(XPSWVertexFragmentVaryings<T>));
+        // loop over bounding square in 2x2 quads aligned to even pixels, so that texture sampling gets screen space
+        // derivatives from neighbouring lanes. lanes outside the triangle are still interpolated (helper lanes)
+        const XPSWMaterial<T>& material = scene->materials.at(materialIndex);
+        for (int64_t y = bs.min.y & ~int64_t(1); y <= bs.max.y; y += 2) {
+            for (int64_t x = bs.min.x & ~int64_t(1); x <= bs.max.x; x += 2) {
+                XPVec3<T> barycentricCoordinates[4];
+                uint32_t  laneMask = 0;
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    const int64_t px = x + (lane & 1);
+                    const int64_t py = y + (lane >> 1);
+                    // Compute barycentric coordinates for (px, py)
+                    barycentricCoordinates[lane] = computeBarycentricCoordinates(
+                      projectedVertices[0].xy, projectedVertices[1].xy, projectedVertices[2].xy, px, py);
+                    const XPVec3<T>& bc = barycentricCoordinates[lane];
+                    if (px < bs.min.x || px > bs.max.x || py < bs.min.y || py > bs.max.y) { continue; }
+                    if (bc.x >= 0 && bc.y >= 0 && bc.z >= 0) {
+                        // point is inside the triangle
+                        T d = calculateDepthZeroToOne(bc,
+                                                      projectedVertices[0],
+                                                      projectedVertices[1],
+                                                      projectedVertices[2],
+                                                      camera.zNearPlane,
+                                                      camera.zFarPlane);
+                        XP_SW_ASSERT_ERROR(d >= 0.0 && d <= 1.0, "Depth should be between 0.0 and 1.0");
+                        if (depthTestPasses || d <= camera.getDepthBufferPixel(px, py)) { laneMask |= 1u << lane; }
                     }
                 }
+                if (laneMask == 0) { continue; }
+
+                // Interpolate attributes --------------------------------------------------------------------------
+                XPSWVertexFragmentVaryings<T>* fragmentVaryings =
+                  (XPSWVertexFragmentVaryings<T>*)tpm.pushFrameMemory(4 * sizeof(XPSWVertexFragmentVaryings<T>));
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    interpolateVertex(
+                      barycentricCoordinates[lane], projectedVertices, vertexFragmentVaryings, fragmentVaryings[lane]);
+                }
+                // -------------------------------------------------------------------------------------------------
+
+                XPVec4<float> fragColors[4];
+                fragmentShaderQuad(
+                  tpm, camera, material, fragmentVaryings, vertexFragmentFlatVaryings, x, y, laneMask, fragColors);
+
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    if ((laneMask & (1u << lane)) == 0) { continue; }
+                    camera.writeColorBuffer(fragColors[lane], x + (lane & 1), y + (lane >> 1));
+                }
+
+                // fragmentVaryings
+                tpm.popFrameMemory(4 * sizeof(XPSWVertexFragmentVaryings<T>));
             }
         }
     }
+
     // Clip against a single 3D plane (e.g., near/far)
     [[nodiscard]] int clipAgainstPlane3D(XPSWMemoryPool&      tpm,
                                          const XPSWVertex<T>* input,
@@ -702,18 +870,18 @@ struct XPSWRasterizer
             clippedTriangle.v2.location.z /= clippedTriangle.v2.location.w;
 
             // viewport transformation
-            clippedTriangle.v0.location.x = (clippedTriangle.v0.location.x + 1.0f) * 0.5f * WIDTH;
-            clippedTriangle.v0.location.y = (1.0f - clippedTriangle.v0.location.y) * 0.5f * HEIGHT;
+            clippedTriangle.v0.location.x = (clippedTriangle.v0.location.x + 1.0f) * 0.5f * camera.resolution.x;
+            clippedTriangle.v0.location.y = (1.0f - clippedTriangle.v0.location.y) * 0.5f * camera.resolution.y;
             clippedTriangle.v0.location.z =
               (clippedTriangle.v0.location.z + 1.0f) * 0.5f * (camera.zFarPlane - camera.zNearPlane) +
               camera.zNearPlane;
-            clippedTriangle.v1.location.x = (clippedTriangle.v1.location.x + 1.0f) * 0.5f * WIDTH;
-            clippedTriangle.v1.location.y = (1.0f - clippedTriangle.v1.location.y) * 0.5f * HEIGHT;
+            clippedTriangle.v1.location.x = (clippedTriangle.v1.location.x + 1.0f) * 0.5f * camera.resolution.x;
+            clippedTriangle.v1.location.y = (1.0f - clippedTriangle.v1.location.y) * 0.5f * camera.resolution.y;
             clippedTriangle.v1.location.z =
               (clippedTriangle.v1.location.z + 1.0f) * 0.5f * (camera.zFarPlane - camera.zNearPlane) +
               camera.zNearPlane;
-            clippedTriangle.v2.location.x = (clippedTriangle.v2.location.x + 1.0f) * 0.5f * WIDTH;
-            clippedTriangle.v2.location.y = (1.0f - clippedTriangle.v2.location.y) * 0.5f * HEIGHT;
+            clippedTriangle.v2.location.x = (clippedTriangle.v2.location.x + 1.0f) * 0.5f * camera.resolution.x;
+            clippedTriangle.v2.location.y = (1.0f - clippedTriangle.v2.location.y) * 0.5f * camera.resolution.y;
             clippedTriangle.v2.location.z =
               (clippedTriangle.v2.location.z + 1.0f) * 0.5f * (camera.zFarPlane - camera.zNearPlane) +
               camera.zNearPlane;
@@ -722,15 +890,7 @@ struct XPSWRasterizer
             //       clippedTriangle.v0.location, clippedTriangle.v1.location, clippedTriangle.v2.location)) {
 
             // interpolate varyings ------------------------------------------------------------------------
-            vertexFragmentFlatVaryings.lightType.resize(scene->lights.size());
-            vertexFragmentFlatVaryings.lightAttenuationConstant.resize(scene->lights.size());
-            vertexFragmentFlatVaryings.lightAttenuationLinear.resize(scene->lights.size());
-            vertexFragmentFlatVaryings.lightAttenuationQuadratic.resize(scene->lights.size());
-            vertexFragmentFlatVaryings.lightAngleOuterCone.resize(scene->lights.size());
-            vertexFragmentFlatVaryings.lightPos.resize(scene->lights.size());
-            vertexFragmentFlatVaryings.lightDirection.resize(scene->lights.size());
-            vertexFragmentFlatVaryings.lightColor.resize(scene->lights.size());
-            vertexFragmentFlatVaryings.lightIntensity.resize(scene->lights.size());
+            // lights are read from the scene through lightGrid, nothing about them is copied per triangle
             vertexFragmentFlatVaryings.viewPos = camera.location;
 
             vertexFragmentVaryings[0].fragPos          = worldTriangle.v0.location;
@@ -751,17 +911,6 @@ struct XPSWRasterizer
             vertexFragmentVaryings[2].fragBiTangent    = worldTriangle.v2.biTangent;
             vertexFragmentVaryings[2].fragTextureCoord = worldTriangle.v2.coord;
             vertexFragmentVaryings[2].fragColor        = worldTriangle.v2.color.xyz;
-            for (size_t li = 0; li < scene->lights.size(); ++li) {
-                vertexFragmentFlatVaryings.lightType[li]                 = scene->lights[li].type;
-                vertexFragmentFlatVaryings.lightAttenuationConstant[li]  = scene->lights[li].attenuationConstant;
-                vertexFragmentFlatVaryings.lightAttenuationLinear[li]    = scene->lights[li].attenuationLinear;
-                vertexFragmentFlatVaryings.lightAttenuationQuadratic[li] = scene->lights[li].attenuationQuadratic;
-                vertexFragmentFlatVaryings.lightAngleOuterCone[li]       = scene->lights[li].angleOuterCone;
-                vertexFragmentFlatVaryings.lightPos[li]                  = scene->lights[li].location;
-                vertexFragmentFlatVaryings.lightDirection[li]            = scene->lights[li].direction;
-                vertexFragmentFlatVaryings.lightColor[li]                = scene->lights[li].diffuse;
-                vertexFragmentFlatVaryings.lightIntensity[li]            = scene->lights[li].intensity;
-            }
             // ---------------------------------------------------------------------------------------------
             std::array<XPVec4<T>, 3> projectedVerticesToRasterize = { clippedTriangle.v0.location,
                                                                       clippedTriangle.v1.location,
@@ -782,38 +931,53 @@ struct XPSWRasterizer
         // worldTriangle
         tpm.popFrameMemory(sizeof(XPSWTriangle<T>));
     }
+    // Fetches the vertex of the mesh streams straight into the projected triangle, the streams are never copied
+    static void fetchVertex(const XPSWMesh<T>& mesh, uint32_t index, XPSWVertex<T>& vertex)
+    {
+        vertex.location  = mesh.positions[index];
+        vertex.normal    = mesh.normals[index].xyz;
+        vertex.coord     = mesh.texCoords[index].xy;
+        vertex.color     = XPVec4<T>{ 1.0f, 1.0f, 1.0f, 1.0f };
+        vertex.tangent   = mesh.tangents ? mesh.tangents[index].xyz : XPVec3<T>{ 0.0f, 0.0f, 0.0f };
+        vertex.biTangent = mesh.biTangents ? mesh.biTangents[index].xyz : XPVec3<T>{ 0.0f, 0.0f, 0.0f };
+    }
     void vertexShader(XPSWMemoryPool&                         tpm,
                       XPSWRasterizerEventListener&            listener,
-                      const XPSWTriangle<T>&                  t,
-                      const XPMat4<T>&                        modelMatrix,
+                      const XPSWMesh<T>&                      mesh,
+                      uint32_t                                firstIndex,
                       const glm::mat<3, 3, T, glm::defaultp>& normalMatrix,
                       const XPMat4<T>&                        viewProjectionMatrix,
-                      const XPSWCamera<T>&                    camera,
-                      unsigned int                            materialIndex)
+                      const XPSWCamera<T>&                    camera)
     {
         auto& projectedVertices = *(XPSWTriangle<T>*)tpm.pushFrameMemory(sizeof(XPSWTriangle<T>));
-        projectedVertices       = t;
-
-        projectedVertices.v0.normal = normalMatrix * t.v0.normal.glm;
-        projectedVertices.v1.normal = normalMatrix * t.v1.normal.glm;
-        projectedVertices.v2.normal = normalMatrix * t.v2.normal.glm;
-
-        projectedVertices.v0.location = viewProjectionMatrix * modelMatrix * t.v0.location;
-        projectedVertices.v1.location = viewProjectionMatrix * modelMatrix * t.v1.location;
-        projectedVertices.v2.location = viewProjectionMatrix * modelMatrix * t.v2.location;
+        fetchVertex(mesh, mesh.indices[firstIndex], projectedVertices.v0);
+        fetchVertex(mesh, mesh.indices[firstIndex + 1], projectedVertices.v1);
+        fetchVertex(mesh, mesh.indices[firstIndex + 2], projectedVertices.v2);
+
+        projectedVertices.v0.normal = normalMatrix * projectedVertices.v0.normal.glm;
+        projectedVertices.v1.normal = normalMatrix * projectedVertices.v1.normal.glm;
+        projectedVertices.v2.normal = normalMatrix * projectedVertices.v2.normal.glm;
+
+        const XPMat4<T>& modelMatrix  = mesh.transform;
+        projectedVertices.v0.location = viewProjectionMatrix * modelMatrix * projectedVertices.v0.location;
+        projectedVertices.v1.location = viewProjectionMatrix * modelMatrix * projectedVertices.v1.location;
+        projectedVertices.v2.location = viewProjectionMatrix * modelMatrix * projectedVertices.v2.location;
         // Here, officially traditional vertex shader ends -------------------------------
 
-        clipStage(
-          tpm, listener, projectedVertices, modelMatrix, normalMatrix, viewProjectionMatrix, camera, materialIndex);
+        clipStage(tpm,
+                  listener,
+                  projectedVertices,
+                  modelMatrix,
+                  normalMatrix,
+                  viewProjectionMatrix,
+                  camera,
+                  mesh.materialIndex);
 
         // projectedVertices
         tpm.popFrameMemory(sizeof(XPSWTriangle<T>));
     }
     void renderFrame(XPSWRasterizerEventListener& listener, XPSWCamera<T>& camera)
     {
-#ifndef XP_SW_USE_THREADS
-        XPSWMemoryPool tpm(32 * 1024 * sizeof(uint8_t));
-#endif
         camera.clearColorBuffer();
 #ifdef __EMSCRIPTEN__
         listener.onFrameSetColorBufferPtr(camera.colorBuffer, camera.resolution.x, camera.resolution.y);
@@ -821,6 +985,13 @@ struct XPSWRasterizer
         const XPMat4<T>&                 viewProjectionMatrix = camera.projectionMatrix * camera.viewMatrix;
         std::array<XPSWPlane<T>, 6>      frustumPlanes = XPSWPlane<T>::extractFrustumPlanes(viewProjectionMatrix);
         glm::mat<3, 3, T, glm::defaultp> normalMatrix;
+
+        // assign the lights to the clusters of this camera once, every fragment then only walks its own cluster
+        lightGrid.prepare(scene->lights, camera);
+        forEachRange(XPSWLightGrid<T>::NumSlices, 1, [&](size_t first, size_t last, uint32_t) {
+            for (size_t slice = first; slice < last; ++slice) { lightGrid.buildSlice(static_cast<uint32_t>(slice)); }
+        });
+
         for (int64_t mi = 0; mi < scene->meshes.size(); ++mi) {
             XPSWMesh<T>& mesh = scene->meshes[mi];
             // frustum culling
@@ -829,72 +1000,26 @@ struct XPSWRasterizer
                 continue;
             }
             normalMatrix = glm::transpose(glm::inverse(glm::mat3(mesh.transform.glm)));
-            for (size_t ii = 0; ii < mesh.indices.size() - 2; ii += 3) {
-                uint32_t i0 = mesh.indices[ii];
-                uint32_t i1 = mesh.indices[ii + 1];
-                uint32_t i2 = mesh.indices[ii + 2];
-
-                XPSWTriangle<T> tr = {};
-                tr.v0.location     = mesh.vertices[i0];
-                tr.v0.normal       = mesh.normals[i0];
-                tr.v0.coord        = mesh.texCoords[i0];
-                tr.v0.color        = XPVec4<T>{ mesh.colors[i0].x, mesh.colors[i0].y, mesh.colors[i0].z, 1.0f };
-                tr.v0.tangent      = mesh.tangents[i0];
-                tr.v0.biTangent    = mesh.biTangents[i0];
-
-                tr.v1.location  = mesh.vertices[i1];
-                tr.v1.normal    = mesh.normals[i1];
-                tr.v1.coord     = mesh.texCoords[i1];
-                tr.v1.color     = XPVec4<T>{ mesh.colors[i1].x, mesh.colors[i1].y, mesh.colors[i1].z, 1.0f };
-                tr.v1.tangent   = mesh.tangents[i1];
-                tr.v1.biTangent = mesh.biTangents[i1];
-
-                tr.v2.location  = mesh.vertices[i2];
-                tr.v2.normal    = mesh.normals[i2];
-                tr.v2.coord     = mesh.texCoords[i2];
-                tr.v2.color     = XPVec4<T>{ mesh.colors[i2].x, mesh.colors[i2].y, mesh.colors[i2].z, 1.0f };
-                tr.v2.tangent   = mesh.tangents[i2];
-                tr.v2.biTangent = mesh.biTangents[i2];
-#if defined(XP_SW_USE_THREADS)
-                threadPool->submit(
-                  [&listener, tr, normalMatrix, viewProjectionMatrix, &camera, &mesh, this](XPSWMemoryPool& tpm) {
-#endif
-                      vertexShader(tpm,
-                                   listener,
-                                   tr,
-                                   mesh.transform,
-                                   normalMatrix,
-                                   viewProjectionMatrix,
-                                   camera,
-                                   mesh.materialIndex);
-#if defined(XP_SW_USE_THREADS)
-                  });
-#else
-                tpm.checkClear();
-                tpm.popAllFrameMemory();
-#endif
-            }
+            // chunks of triangles are split across the workers, each one shades into its own scratch memory
+            forEachRange(mesh.numIndices / 3, TrianglesPerJob, [&](size_t first, size_t last, uint32_t contextIndex) {
+                XPSWMemoryPool& tpm = getThreadMemoryPool(contextIndex);
+                for (size_t ti = first; ti < last; ++ti) {
+                    vertexShader(
+                      tpm, listener, mesh, static_cast<uint32_t>(ti * 3), normalMatrix, viewProjectionMatrix, camera);
+                    tpm.checkClear();
+                    tpm.popAllFrameMemory();
+                }
+            });
         }
-#if defined(XP_SW_USE_THREADS)
-        threadPool->waitForWork();
-#endif
 
-#ifndef __EMSCRIPTEN__
-        std::stringstream ss;
-        ss.str("");
-
-        // display
-        ss << std::filesystem::path(scene->filepath).stem().string() << "_" << camera.name << "_depth";
-        XP_SW_ASSERT_ERROR(camera.saveDepthToEXR(ss.str()), "Failed to save depth to EXR file");
-        ss.str("");
-        ss << std::filesystem::path(scene->filepath).stem().string() << "_" << camera.name << "_color";
-        XP_SW_ASSERT_ERROR(camera.saveColorToEXR(ss.str()), "Failed to save color to EXR file");
-#else
+#ifdef __EMSCRIPTEN__
         LOG_ALERT("WRITING BACK TO GL TEXTURES");
         listener.onFrameRenderBoundingSquare(0, camera.resolution.x, 0, camera.resolution.y);
 #endif
     }
-    void zDrawTriangle(const std::array<XPVec4<T>, 3>& projectedVertices, const XPSWCamera<T>& camera)
+    void zDrawTriangle(const std::array<XPVec4<T>, 3>& projectedVertices,
+                       const XPVec4<T>&                viewport,
+                       const XPSWCamera<T>&            camera)
     {
         // Avoid degenerate triangles
         // -------------------------------------------------------------------------------------
@@ -905,10 +1030,7 @@ struct XPSWRasterizer
         // bounding square around triangle
         // --------------------------------------------------------------------------------
         XPSWBoundingSquare<int64_t> bs = calculateTriangleBoundingSquare(
-          XPVec4<T>{ 0, 0, static_cast<T>(camera.resolution.x), static_cast<T>(camera.resolution.y) },
-          projectedVertices[0].xy,
-          projectedVertices[1].xy,
-          projectedVertices[2].xy);
+          viewport, projectedVertices[0].xy, projectedVertices[1].xy, projectedVertices[2].xy);
         // ----------------------------------------------------------------------------------------------------------------
 
         // loop over bounding square
@@ -932,6 +1054,7 @@ struct XPSWRasterizer
             }
         }
     }
+
     // Clip against a single 3D plane (e.g., near/far)
     [[nodiscard]] int zClipAgainstPlane3D(XPSWMemoryPool&      tpm,
                                           const XPSWVertex<T>* input,
@@ -1079,7 +1202,25 @@ struct XPSWRasterizer
         clippedTriangles[0].v1 = clippedPolygon[1];
         clippedTriangles[0].v2 = clippedPolygon[2];
     }
-    void zClipStage(XPSWMemoryPool& tpm, XPSWTriangle<T>& projectedVertices, const XPSWCamera<T>& camera)
+    void zBinTriangle(const std::array<XPVec4<T>, 3>& projectedVertices,
+                      const XPSWCamera<T>&            camera,
+                      uint32_t                        contextIndex)
+    {
+        // Avoid degenerate triangles
+        T area = XPSWTriangle<T>::area(projectedVertices[0].xy, projectedVertices[1].xy, projectedVertices[2].xy);
+        if (area == 0) { return; }
+
+        XPSWBoundingSquare<int64_t> bs = calculateTriangleBoundingSquare(
+          XPVec4<T>{ 0, 0, static_cast<T>(camera.resolution.x), static_cast<T>(camera.resolution.y) },
+          projectedVertices[0].xy,
+          projectedVertices[1].xy,
+          projectedVertices[2].xy);
+        if (bs.max.x < bs.min.x || bs.max.y < bs.min.y) { return; }
+        depthTiles.bin(projectedVertices, bs, contextIndex);
+    }
+    // clips and maps the triangle to the viewport of the camera, emit gets every resulting triangle
+    template<typename F>
+    void zClipStage(XPSWMemoryPool& tpm, XPSWTriangle<T>& projectedVertices, const XPSWCamera<T>& camera, F&& emit)
     {
         // clipping
         std::vector<XPSWTriangle<T>> clippedTriangles;
@@ -1119,28 +1260,35 @@ struct XPSWRasterizer
             clippedTriangle.v2.location.z /= clippedTriangle.v2.location.w;
 
             // viewport transformation
-            clippedTriangle.v0.location.x = (clippedTriangle.v0.location.x + 1.0f) * 0.5f * WIDTH;
-            clippedTriangle.v0.location.y = (1.0f - clippedTriangle.v0.location.y) * 0.5f * HEIGHT;
+            clippedTriangle.v0.location.x = (clippedTriangle.v0.location.x + 1.0f) * 0.5f * camera.resolution.x;
+            clippedTriangle.v0.location.y = (1.0f - clippedTriangle.v0.location.y) * 0.5f * camera.resolution.y;
             clippedTriangle.v0.location.z =
               (clippedTriangle.v0.location.z + 1.0f) * 0.5f * (camera.zFarPlane - camera.zNearPlane) +
               camera.zNearPlane;
-            clippedTriangle.v1.location.x = (clippedTriangle.v1.location.x + 1.0f) * 0.5f * WIDTH;
-            clippedTriangle.v1.location.y = (1.0f - clippedTriangle.v1.location.y) * 0.5f * HEIGHT;
+            clippedTriangle.v1.location.x = (clippedTriangle.v1.location.x + 1.0f) * 0.5f * camera.resolution.x;
+            clippedTriangle.v1.location.y = (1.0f - clippedTriangle.v1.location.y) * 0.5f * camera.resolution.y;
             clippedTriangle.v1.location.z =
               (clippedTriangle.v1.location.z + 1.0f) * 0.5f * (camera.zFarPlane - camera.zNearPlane) +
               camera.zNearPlane;
-            clippedTriangle.v2.location.x = (clippedTriangle.v2.location.x + 1.0f) * 0.5f * WIDTH;
-            clippedTriangle.v2.location.y = (1.0f - clippedTriangle.v2.location.y) * 0.5f * HEIGHT;
+            clippedTriangle.v2.location.x = (clippedTriangle.v2.location.x + 1.0f) * 0.5f * camera.resolution.x;
+            clippedTriangle.v2.location.y = (1.0f - clippedTriangle.v2.location.y) * 0.5f * camera.resolution.y;
             clippedTriangle.v2.location.z =
               (clippedTriangle.v2.location.z + 1.0f) * 0.5f * (camera.zFarPlane - camera.zNearPlane) +
               camera.zNearPlane;
 
+            // orthographic projections keep w at 1, the depth they map linearly into z takes its place
+            if (camera.projectionMatrix.glm[3][3] == T(1)) {
+                clippedTriangle.v0.location.w = clippedTriangle.v0.location.z;
+                clippedTriangle.v1.location.w = clippedTriangle.v1.location.z;
+                clippedTriangle.v2.location.w = clippedTriangle.v2.location.z;
+            }
+
             // if (!camera.isBackFace(
             //       clippedTriangle.v0.location, clippedTriangle.v1.location, clippedTriangle.v2.location)) {
             std::array<XPVec4<T>, 3> projectedVerticesToRasterize = { clippedTriangle.v0.location,
                                                                       clippedTriangle.v1.location,
                                                                       clippedTriangle.v2.location };
-            zDrawTriangle(projectedVerticesToRasterize, camera);
+            emit(projectedVerticesToRasterize);
             // }
         }
         // inverseViewMatrix
@@ -1150,11 +1298,13 @@ struct XPSWRasterizer
         // worldTriangle
         tpm.popFrameMemory(sizeof(XPSWTriangle<T>));
     }
+    template<typename F>
     void zVertexShader(XPSWMemoryPool&        tpm,
                        const XPSWTriangle<T>& t,
                        const XPMat4<T>&       modelMatrix,
                        const XPMat4<T>&       viewProjectionMatrix,
-                       const XPSWCamera<T>&   camera)
+                       const XPSWCamera<T>&   camera,
+                       F&&                    emit)
     {
         auto& projectedVertices = *(XPSWTriangle<T>*)tpm.pushFrameMemory(sizeof(XPSWTriangle<T>));
         projectedVertices       = t;
@@ -1164,14 +1314,41 @@ struct XPSWRasterizer
         projectedVertices.v2.location = viewProjectionMatrix * modelMatrix * t.v2.location;
         // Here, officially traditional vertex shader ends -------------------------------
 
-        zClipStage(tpm, projectedVertices, camera);
+        zClipStage(tpm, projectedVertices, camera, emit);
 
         tpm.popFrameMemory(sizeof(XPSWTriangle<T>));
     }
+    void zDrawTile(uint32_t tile, const XPSWCamera<T>& camera)
+    {
+        const XPVec4<T> viewport = depthTiles.getTileViewport(tile, camera.resolution);
+        const int64_t   x0       = static_cast<int64_t>(viewport.x);
+        const int64_t   y0       = static_cast<int64_t>(viewport.y);
+        const int64_t   x1       = static_cast<int64_t>(viewport.z);
+        const int64_t   y1       = static_cast<int64_t>(viewport.w);
+        for (int64_t y = y0; y < y1; ++y) {
+            std::fill_n(&camera.depthBuffer[y * camera.resolution.x + x0], x1 - x0, FLT_MAX);
+        }
+
+        for (size_t c = 0; c < depthTiles.bins.size(); ++c) {
+            for (uint32_t index : depthTiles.bins[c][tile]) {
+                zDrawTriangle(depthTiles.triangles[c][index], viewport, camera);
+            }
+        }
+
+        float minDepth = FLT_MAX, maxDepth = 0.0f;
+        for (int64_t y = y0; y < y1; ++y) {
+            for (int64_t x = x0; x < x1; ++x) {
+                const float d = camera.getDepthBufferPixel(x, y);
+                minDepth      = std::min(minDepth, d);
+                maxDepth      = std::max(maxDepth, d);
+            }
+        }
+        depthTiles.minDepth[tile] = minDepth;
+        depthTiles.maxDepth[tile] = maxDepth;
+    }
     void renderZPrePass(XPSWCamera<T>& camera)
     {
-        XPSWMemoryPool tpm(32 * 1024 * sizeof(uint8_t));
-        camera.clearDepthBuffer();
+        depthTiles.reset(camera.resolution, getNumContexts());
 
         const XPMat4<T>&            viewProjectionMatrix = camera.projectionMatrix * camera.viewMatrix;
         std::array<XPSWPlane<T>, 6> frustumPlanes        = XPSWPlane<T>::extractFrustumPlanes(viewProjectionMatrix);
@@ -1182,44 +1359,111 @@ struct XPSWRasterizer
                 LOGV_DEBUG("[FRUSTUM CULLING ELIMINATED] {}", mesh.name);
                 continue;
             }
-            for (size_t ii = 0; ii < mesh.indices.size() - 2; ii += 3) {
-                uint32_t i0 = mesh.indices[ii];
-                uint32_t i1 = mesh.indices[ii + 1];
-                uint32_t i2 = mesh.indices[ii + 2];
+            // transform, clip and bin into the tiles it covers
+            forEachRange(mesh.numIndices / 3, TrianglesPerJob, [&](size_t first, size_t last, uint32_t contextIndex) {
+                XPSWMemoryPool& tpm = getThreadMemoryPool(contextIndex);
+                for (size_t ti = first; ti < last; ++ti) {
+                    const size_t    ii = ti * 3;
+                    XPSWTriangle<T> tr = {};
+                    tr.v0.location     = mesh.positions[mesh.indices[ii]];
+                    tr.v1.location     = mesh.positions[mesh.indices[ii + 1]];
+                    tr.v2.location     = mesh.positions[mesh.indices[ii + 2]];
+                    zVertexShader(tpm,
+                                  tr,
+                                  mesh.transform,
+                                  viewProjectionMatrix,
+                                  camera,
+                                  [&](const std::array<XPVec4<T>, 3>& projectedVertices) {
+                                      zBinTriangle(projectedVertices, camera, contextIndex);
+                                  });
+                    tpm.checkClear();
+                    tpm.popAllFrameMemory();
+                }
+            });
+        }
 
+        // every tile is cleared and rasterized by the one thread that took it
+        forEachRange(depthTiles.minDepth.size(), 1, [&](size_t first, size_t last, uint32_t) {
+            for (size_t tile = first; tile < last; ++tile) { zDrawTile(static_cast<uint32_t>(tile), camera); }
+        });
+    }
+    // a single thread renders the whole view, views of different lights and faces run in parallel
+    void renderShadowView(XPSWMemoryPool& tpm, XPSWShadowView<T>& view)
+    {
+        std::fill(view.depth.begin(), view.depth.end(), FLT_MAX);
+        const XPVec4<T> viewport = {
+            0, 0, static_cast<T>(view.camera.resolution.x), static_cast<T>(view.camera.resolution.y)
+        };
+        std::array<XPSWPlane<T>, 6> frustumPlanes = XPSWPlane<T>::extractFrustumPlanes(view.viewProjectionMatrix);
+        for (int64_t mi = 0; mi < scene->meshes.size(); ++mi) {
+            XPSWMesh<T>& mesh = scene->meshes[mi];
+            if (mesh.boundingBox.testFrustum(frustumPlanes) == XPSWEBoundingBoxFrustumTest_FullyOutside) { continue; }
+            for (size_t ii = 0; ii + 2 < mesh.numIndices; ii += 3) {
                 XPSWTriangle<T> tr = {};
-                tr.v0.location     = mesh.vertices[i0];
-                tr.v1.location     = mesh.vertices[i1];
-                tr.v2.location     = mesh.vertices[i2];
-                zVertexShader(tpm, tr, mesh.transform, viewProjectionMatrix, camera);
+                tr.v0.location     = mesh.positions[mesh.indices[ii]];
+                tr.v1.location     = mesh.positions[mesh.indices[ii + 1]];
+                tr.v2.location     = mesh.positions[mesh.indices[ii + 2]];
+                zVertexShader(tpm,
+                              tr,
+                              mesh.transform,
+                              view.viewProjectionMatrix,
+                              view.camera,
+                              [&](const std::array<XPVec4<T>, 3>& projectedVertices) {
+                                  zDrawTriangle(projectedVertices, viewport, view.camera);
+                              });
                 tpm.checkClear();
                 tpm.popAllFrameMemory();
             }
         }
     }
+    void renderShadowMaps(size_t cameraIndex)
+    {
+        shadowMaps.prepare(*scene, cameraIndex);
+        LOGV_DEBUG("[SHADOW MAPS] {} views to render", shadowMaps.dirtyViews.size());
+        forEachRange(shadowMaps.dirtyViews.size(), 1, [&](size_t first, size_t last, uint32_t contextIndex) {
+            XPSWMemoryPool& tpm = getThreadMemoryPool(contextIndex);
+            for (size_t vi = first; vi < last; ++vi) { renderShadowView(tpm, *shadowMaps.dirtyViews[vi]); }
+        });
+    }
     void render(XPSWRasterizerEventListener& listener)
     {
         if (scene == nullptr) { return; }
         for (size_t ci = 0; ci < scene->cameras.size(); ++ci) {
             XPSWCamera<T>& camera = scene->cameras[ci];
             LOGV_DEBUG("[CAMERA] {}", camera.name);
-            camera.createFrameBuffers();
+            // rasterizes into the next framebuffers of the ring while the output stage still encodes the previous ones
+            camera.createFrameBuffers(frameOutput ? frameOutput->getSettings().framesInFlight : 1);
 
+            LOG_ALERT("RENDERING SHADOW MAPS");
+            renderShadowMaps(ci);
             LOG_ALERT("RENDERING Z PRE_PASS");
             renderZPrePass(camera);
             LOG_ALERT("RENDERING FRAME");
             renderFrame(listener, camera);
             LOGV_ALERT("DONE FRAME {}", ci);
 
-#ifndef __EMSCRIPTEN__
-            // for now on the web app we need the camera framebuffers still afterwards
-            camera.destroyFrameBuffers();
-#endif
+            if (frameOutput) {
+                // the frame index is passed on its own, the disk sink appends it to the file names
+                std::stringstream ss;
+                ss << std::filesystem::path(scene->filepath).stem().string() << "_" << camera.name;
+                frameOutput->submit(
+                  camera.getFrameBuffers(), ss.str(), camera.frameIndex, camera.resolution.x, camera.resolution.y);
+            }
+            ++camera.frameIndex;
         }
     }
-#if defined(XP_SW_USE_THREADS)
-    XPSWThreadPool* threadPool;
-#endif
+    // encodes the framebuffers of every rendered camera, frames are only kept in the camera when it is null
+    XPSWFrameOutput* frameOutput = nullptr;
+    static constexpr size_t TrianglesPerJob = 64;
+    XPThreadPool*           threadPool      = nullptr;
+    // scratch memory per context of threadPool, allocated the first time a context rasterizes
+    std::vector<std::unique_ptr<XPSWMemoryPool>> threadMemoryPools;
+    // depth pre-pass tiles of the camera being rendered
+    XPSWDepthTiles<T> depthTiles;
+    // light clusters of the camera being rendered
+    XPSWLightGrid<T> lightGrid;
+    // depth of the lights, kept across frames
+    XPSWShadowMaps<T> shadowMaps;
     XPSWRenderer* renderer;
     XPSWScene<T>* scene;
     // uint8_t*       frameMemory;
@@ -17,39 +17,223 @@
 #include <Renderer/SW/XPSWRenderer.h>
 #include <Renderer/SW/XPSWSceneDescriptor.h>
 
+#include <DataPipeline/XPMaterialAsset.h>
+#include <DataPipeline/XPMaterialBuffer.h>
+#include <DataPipeline/XPMeshAsset.h>
+#include <DataPipeline/XPMeshBuffer.h>
+#include <Engine/XPEngine.h>
+#include <Engine/XPRegistry.h>
+#include <SceneDescriptor/XPAttachments.h>
+#include <SceneDescriptor/XPNode.h>
+#include <SceneDescriptor/XPScene.h>
+#include <Utilities/XPMacros.h>
+
+#include <algorithm>
+#include <cmath>
 #include <thread>
+#include <unordered_map>
+#include <vector>
+
+// the scene graph keeps nodes in hash sets, order them by id so that every run produces the same meshes and cameras
+static std::vector<XPNode*>
+sortedNodes(const std::unordered_set<XPNode*>& nodes)
+{
+    std::vector<XPNode*> sorted(nodes.begin(), nodes.end());
+    std::sort(sorted.begin(), sorted.end(), [](XPNode* a, XPNode* b) { return a->getId() < b->getId(); });
+    return sorted;
+}
+
+static void
+importMaterial(const XPMaterialBuffer* materialBuffer, XPSWMaterial<float>& material)
+{
+    material.name               = materialBuffer ? materialBuffer->getMaterialAsset()->getName() : "default";
+    material.baseColorValue     = XPVec3<float>{ 1.0f, 1.0f, 1.0f };
+    material.emissionColorValue = XPVec3<float>{ 0.0f, 0.0f, 0.0f };
+    material.metallicValue      = 0.0f;
+    material.roughnessValue     = 0.0f;
+    material.aoValue            = 0.01f;
+    if (materialBuffer == nullptr) { return; }
+
+    if (auto pbr = materialBuffer->getPBRSystem()) {
+        material.baseColorValue     = pbr->albedo;
+        material.emissionColorValue = pbr->emission;
+        material.metallicValue      = pbr->metallic;
+        material.roughnessValue     = pbr->roughness;
+    } else if (auto phong = materialBuffer->getPhongSystem()) {
+        material.baseColorValue     = phong->diffuse;
+        material.emissionColorValue = phong->emission;
+    }
+}
+
+// the mesh views the object straight out of the mesh buffer, indices of an object are relative to its vertex offset
+static void
+viewMeshBufferObject(const XPMeshBufferObject& object, uint64_t generation, XPSWMesh<float>& mesh)
+{
+    const XPMeshBuffer* meshBuffer = object.meshBuffer;
+    mesh.name                      = object.name;
+    mesh.transform                 = XPMat4<float>::identity();
+    mesh.positions                 = meshBuffer->getPositions() + object.vertexOffset;
+    mesh.normals                   = meshBuffer->getNormals() + object.vertexOffset;
+    mesh.texCoords                 = meshBuffer->getTexcoords() + object.vertexOffset;
+    mesh.indices                   = meshBuffer->getIndices() + object.indexOffset;
+    mesh.numIndices                = object.numIndices;
+    mesh.generation                = generation;
+    mesh.boundingBox.min           = object.boundingBox.minPoint.xyz;
+    mesh.boundingBox.max           = object.boundingBox.maxPoint.xyz;
+    mesh.materialIndex             = object.materialBuffer ? object.materialBuffer->getId() : UINT32_MAX;
+}
+
+// builds a software scene out of the layers as they are right now instead of importing the file from disk again
+static bool
+importSceneGraph(XPScene&                                                                     scene,
+                 const std::unordered_map<const XPMeshBuffer*, std::vector<XPSWMesh<float>>>& meshViews,
+                 XPSWScene<float>&                                                            swScene)
+{
+    swScene.filepath = scene.getName();
+
+    for (XPNode* node : sortedNodes(scene.getNodes(MeshRendererAttachmentDescriptor | TransformAttachmentDescriptor))) {
+        Transform* transform  = node->getTransform();
+        auto       operations = static_cast<XPMat4<float>::ModelMatrixOperations>(
+          XPMat4<float>::ModelMatrixOperation_Translation | XPMat4<float>::ModelMatrixOperation_Rotation |
+          XPMat4<float>::ModelMatrixOperation_Scale);
+        XPMat4<float>::buildModelMatrix(
+          transform->modelMatrix, transform->location, transform->euler, transform->scale, operations);
+        for (const XPMeshRendererInfo& info : node->getMeshRenderer()->info) {
+            if (info.meshBuffer == nullptr) { continue; }
+            auto it = meshViews.find(info.meshBuffer);
+            if (it == meshViews.end() || info.meshBufferObjectIndex >= it->second.size()) { continue; }
+            const XPSWMesh<float>& meshView = it->second[info.meshBufferObjectIndex];
+            if (meshView.numIndices < 3) { continue; }
+
+            if (swScene.materials.find(meshView.materialIndex) == swScene.materials.end()) {
+                const XPMeshBufferObject& object = info.meshBuffer->getObjects()[info.meshBufferObjectIndex];
+                importMaterial(object.materialBuffer, swScene.materials[meshView.materialIndex]);
+            }
+            // the rasterizer transforms the object space streams, only the bounds are moved to world space here
+            swScene.meshes.push_back({});
+            XPSWMesh<float>& mesh = swScene.meshes.back();
+            mesh.viewStreamsOf(meshView);
+            mesh.name          = meshView.name;
+            mesh.transform     = transform->modelMatrix;
+            mesh.boundingBox   = meshView.boundingBox.transformed(transform->modelMatrix);
+            mesh.materialIndex = meshView.materialIndex;
+        }
+    }
+
+    const auto cameraNodes = sortedNodes(scene.getNodes(FreeCameraAttachmentDescriptor));
+    swScene.cameras.reserve(cameraNodes.size());
+    for (XPNode* node : cameraNodes) {
+        const CameraProperties& properties = node->getFreeCamera()->activeProperties;
+        swScene.cameras.push_back({});
+        if (!XPSWRenderer::importFreeCamera(node->getName(), properties, swScene.cameras.back())) {
+            swScene.cameras.pop_back();
+        }
+    }
+    if (swScene.cameras.empty() || swScene.meshes.empty()) { return false; }
+
+    // the scene graph has no light attachments yet, light it from the first camera like an imported file without lights
+    swScene.lights.push_back({});
+    XPSWLight<float>& light    = swScene.lights.back();
+    light.name                 = "default";
+    light.location             = swScene.cameras[0].location;
+    light.direction            = XPVec3<float>{ 0.0f, 0.0f, -1.0f };
+    light.ambient              = XPVec3<float>{ 1.0f, 1.0f, 1.0f };
+    light.diffuse              = XPVec3<float>{ 100.0f, 100.0f, 100.0f };
+    light.specular             = XPVec3<float>{ 100.0f, 100.0f, 100.0f };
+    light.intensity            = 100.0f;
+    light.attenuationConstant  = 0.1f;
+    light.attenuationLinear    = 0.01f;
+    light.attenuationQuadratic = 0.001f;
+    light.type                 = XPSWELightType_Point;
+    light.angleInnerCone       = 20.0f;
+    light.angleOuterCone       = 45.0f;
+    return true;
+}
+
+bool
+XPSWRenderer::importFreeCamera(const std::string& name, const CameraProperties& properties, XPSWCamera<float>& camera)
+{
+    // the frame is as big as the viewport the camera was last resized to, the projection and the viewport transform of
+    // the rasterizer both follow camera.resolution
+    if (properties.width < 1.0f || properties.height < 1.0f) { return false; }
+    const auto width  = static_cast<uint32_t>(std::lround(properties.width));
+    const auto height = static_cast<uint32_t>(std::lround(properties.height));
+
+    XPMat4<float> viewProjection, inverseViewProjection, view, inverseView, projection;
+    XPMat4<float>::buildViewProjectionMatrices(viewProjection,
+                                               inverseViewProjection,
+                                               view,
+                                               inverseView,
+                                               projection,
+                                               properties.location,
+                                               properties.euler,
+                                               properties.fov,
+                                               properties.width,
+                                               properties.height,
+                                               properties.znear,
+                                               properties.zfar);
+
+    camera.name       = name;
+    camera.fov        = properties.fov;
+    camera.resolution = XPVec2<uint32_t>{ width, height };
+    camera.zNearPlane = properties.znear;
+    camera.zFarPlane  = properties.zfar;
+    camera.location   = properties.location;
+    camera.target.glm = properties.location.glm - glm::vec3(inverseView.glm[2]);
+    camera.up.glm     = glm::vec3(inverseView.glm[1]);
+    camera.updateMatrices();
+    return true;
+}
 
 XPSWRenderer::XPSWRenderer(XPRegistry* const registry)
   : _registry(registry)
   , _scene(nullptr)
+  , _frameOutput(nullptr)
+  , _status(false)
+  , _meshGeneration(0)
 {
     rasterizer = new XPSWRasterizer<float>(this);
+#ifndef __EMSCRIPTEN__
+    _frameOutput            = new XPSWFrameOutput(XPSWFrameOutputSettings{});
+    rasterizer->frameOutput = _frameOutput;
+#endif
 }
 
-XPSWRenderer::~XPSWRenderer() { delete rasterizer; }
+XPSWRenderer::~XPSWRenderer()
+{
+    wait();
+    // cameras wait for their framebuffers to be released, let the output stage finish before the scene goes away
+    delete _frameOutput;
+    delete rasterizer;
+    delete _scene;
+}
 
 void
 XPSWRenderer::initialize()
 {
+#if defined(XP_SW_USE_THREADS)
+    rasterizer->setThreadPool(_registry->getEngine()->getThreadPool());
+#endif
 }
 
 void
 XPSWRenderer::loadScene(std::string filepath)
 {
-    std::thread t([this, filepath] {
+    wait();
+    _worker = std::thread([this, filepath] {
         std::lock_guard<std::mutex> l(_mut);
         if (_scene) { delete _scene; }
         _scene           = new XPSWScene<float>();
         _scene->filepath = filepath;
         _status          = importAsset(*_scene);
     });
-    t.detach();
 }
 
 void
 XPSWRenderer::render(XPSWRasterizerEventListener& listener)
 {
-    std::thread t([this, &listener] {
+    wait();
+    _worker = std::thread([this, &listener] {
         std::lock_guard<std::mutex> l(_mut);
         if (_scene) {
             if (_status) {
@@ -58,14 +242,78 @@ XPSWRenderer::render(XPSWRasterizerEventListener& listener)
             }
         }
     });
-    t.detach();
 }
 
 void
-XPSWRenderer::finalize()
+XPSWRenderer::wait()
 {
-    {
-        std::lock_guard<std::mutex> l(_mut);
-        // in case we are still loading or rendering, wait for all work here
+    if (_worker.joinable()) { _worker.join(); }
+}
+
+bool
+XPSWRenderer::renderScene(XPScene& scene, XPSWRasterizerEventListener& listener)
+{
+    wait();
+    std::lock_guard<std::mutex> l(_mut);
+    if (_scene) { delete _scene; }
+    _scene  = new XPSWScene<float>();
+    _status = importSceneGraph(scene, _meshViews, *_scene);
+    if (!_status) { return false; }
+    rasterizer->setScene(_scene);
+    rasterizer->render(listener);
+    return true;
+}
+
+void
+XPSWRenderer::uploadMeshAsset(XPMeshAsset* meshAsset)
+{
+    std::lock_guard<std::mutex> l(_mut);
+    const XPMeshBuffer*         meshBuffer = meshAsset->getMeshBuffer();
+    if (meshBuffer == nullptr) { return; }
+
+    std::vector<XPSWMesh<float>>& meshViews = _meshViews[meshBuffer];
+    meshViews.clear();
+    meshViews.resize(meshBuffer->getObjectsCount());
+    // a re-upload can refill the streams where they are, a new generation tells the caches built on the old data
+    const uint64_t generation = ++_meshGeneration;
+    for (size_t i = 0; i < meshViews.size(); ++i) {
+        viewMeshBufferObject(meshBuffer->getObjects()[i], generation, meshViews[i]);
     }
+}
+
+void
+XPSWRenderer::reUploadMeshAsset(XPMeshAsset* meshAsset)
+{
+    // the mesh buffer may have reallocated its streams, the old views are rebuilt from scratch
+    uploadMeshAsset(meshAsset);
+}
+
+void
+XPSWRenderer::setFrameOutputSettings(const XPSWFrameOutputSettings& settings)
+{
+#ifndef __EMSCRIPTEN__
+    wait();
+    std::lock_guard<std::mutex> l(_mut);
+    delete _frameOutput;
+    _frameOutput            = new XPSWFrameOutput(settings);
+    rasterizer->frameOutput = _frameOutput;
+#else
+    XP_UNUSED(settings)
+#endif
+}
+
+XPSWFrameOutput*
+XPSWRenderer::getFrameOutput() const
+{
+    return _frameOutput;
+}
+
+void
+XPSWRenderer::finalize()
+{
+    // in case we are still loading, rendering or encoding, wait for all work here
+    wait();
+    if (_frameOutput) { _frameOutput->flush(); }
+    // the engine pool goes away after finalize
+    rasterizer->setThreadPool(nullptr);
 }
\ No newline at end of file
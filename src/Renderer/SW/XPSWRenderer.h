@@ -14,8 +14,14 @@
 
 #pragma once
 
+#include <Renderer/SW/XPSWFrameOutput.h>
+
 #include <functional>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 template<typename T>
 struct XPSWRasterizer;
@@ -23,7 +29,17 @@ struct XPSWRasterizer;
 template<typename T>
 struct XPSWScene;
 
+template<typename T>
+struct XPSWMesh;
+
+template<typename T>
+struct XPSWCamera;
+
+struct CameraProperties;
 class XPRegistry;
+class XPScene;
+class XPMeshAsset;
+class XPMeshBuffer;
 
 struct XPSWRasterizerEventListener
 {
@@ -50,8 +66,29 @@ struct XPSWRenderer
     explicit XPSWRenderer(XPRegistry* const registry);
     ~XPSWRenderer();
     void initialize();
+    /// @brief imports a file on a worker thread, previous work is joined first
     void loadScene(std::string filepath);
+    /// @brief renders the last loaded file on a worker thread, previous work is joined first
     void render(XPSWRasterizerEventListener& listener);
+    /// @brief blocks until the worker thread is done loading or rendering
+    void wait();
+    /// @brief blocks and renders every camera of the scene as it currently is in the scene graph, returns false if
+    /// there was nothing to render
+    bool renderScene(XPScene& scene, XPSWRasterizerEventListener& listener);
+    /// @brief sets up the camera to look through the free camera properties and rasterize at their size, returns false
+    /// when they have no area to rasterize into
+    static bool importFreeCamera(const std::string&      name,
+                                 const CameraProperties& properties,
+                                 XPSWCamera<float>&      camera);
+    /// @brief references the positions, normals, texcoords and index ranges of every object in the mesh buffer of the
+    /// mesh asset, nothing is copied so the mesh buffer has to outlive the rendered scenes
+    void uploadMeshAsset(XPMeshAsset* meshAsset);
+    /// @brief drops the old references of the mesh asset and uploads it again
+    void reUploadMeshAsset(XPMeshAsset* meshAsset);
+    /// @brief writes out the frames still queued with the old settings, then encodes the next renders with these
+    void setFrameOutputSettings(const XPSWFrameOutputSettings& settings);
+    /// @brief the stage encoding rendered frames on its own workers, null on the web where frames go to the listener
+    [[nodiscard]] XPSWFrameOutput* getFrameOutput() const;
     void finalize();
 
 #if defined(XP_SW_RASTERIZER_ENABLE)
@@ -61,6 +98,11 @@ struct XPSWRenderer
   private:
     XPRegistry* const _registry;
     XPSWScene<float>* _scene;
+    XPSWFrameOutput*  _frameOutput;
     bool              _status;
+    uint64_t          _meshGeneration;
     std::mutex        _mut;
+    std::thread       _worker;
+    // one mesh per mesh buffer object, viewing the streams of the mesh buffer in object space
+    std::unordered_map<const XPMeshBuffer*, std::vector<XPSWMesh<float>>> _meshViews;
 };
\ No newline at end of file
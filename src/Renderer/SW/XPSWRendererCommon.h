@@ -143,15 +143,15 @@ getPBRMaterial(const XPSWMaterial<T>& material,
         : XPVec4<T>{ 1.0f, 1.0f, 1.0f, 1.0f };
     XPVec4<T> emissionTexture =
       material.hasEmissionColorTexture
-        ? sampleTextureLinear<T>(material.emissionColorTexture, texCoord.x, texCoord.y, repeatUVCoords, false)
+        ? sampleTextureLinear<T>(material.emissionColorTexture, texCoord.x, texCoord.y, repeatUVCoords, true)
         : XPVec4<T>{ 1.0f, 1.0f, 1.0f, 1.0f };
     XPVec4<T> metallicTexture =
       material.hasMetallicTexture
-        ? sampleTextureLinear<T>(material.metallicTexture, texCoord.x, texCoord.y, repeatUVCoords, true)
+        ? sampleTextureLinear<T>(material.metallicTexture, texCoord.x, texCoord.y, repeatUVCoords, false)
         : XPVec4<T>{ 1.0f, 1.0f, 1.0f, 1.0f };
     XPVec4<T> roughnessTexture =
       material.hasRoughnessTexture
-        ? sampleTextureLinear<T>(material.roughnessTexture, texCoord.x, texCoord.y, repeatUVCoords, true)
+        ? sampleTextureLinear<T>(material.roughnessTexture, texCoord.x, texCoord.y, repeatUVCoords, false)
         : XPVec4<T>{ 1.0f, 1.0f, 1.0f, 1.0f };
     XPVec4<T> aoTexture = material.hasAOTexture
                             ? sampleTextureLinear<T>(material.aoTexture, texCoord.x, texCoord.y, repeatUVCoords, false)
@@ -165,3 +165,66 @@ getPBRMaterial(const XPSWMaterial<T>& material,
     roughness = material.hasRoughnessTexture ? (roughnessTexture).x : material.roughnessValue;
     ao        = material.hasAOTexture ? (aoTexture).x : material.aoValue;
 }
+
+template<typename T>
+struct XPSWPBRSample
+{
+    XPVec3<T> baseColor;
+    XPVec3<T> normal;
+    XPVec3<T> emission;
+    float     metallic;
+    float     roughness;
+    float     ao;
+};
+
+// same as getPBRMaterial but for the 4 fragments of a 2x2 quad, every texture is sampled once per quad with a level
+// of detail derived from the quad uv derivatives. helper lanes outside the triangle still need valid texCoords
+template<typename T>
+void
+getPBRMaterialQuad(const XPSWMaterial<T>&               material,
+                   const XPSWVertexFragmentVaryings<T>* fragments,
+                   XPSWPBRSample<T>*                    samples,
+                   bool                                 repeatUVCoords)
+{
+    const XPSWFloat4 u = XPSWFloat4::set(fragments[0].fragTextureCoord.x,
+                                         fragments[1].fragTextureCoord.x,
+                                         fragments[2].fragTextureCoord.x,
+                                         fragments[3].fragTextureCoord.x);
+    const XPSWFloat4 v = XPSWFloat4::set(fragments[0].fragTextureCoord.y,
+                                         fragments[1].fragTextureCoord.y,
+                                         fragments[2].fragTextureCoord.y,
+                                         fragments[3].fragTextureCoord.y);
+
+    float lanes[6][4][4]; // [texture][channel][lane]
+    auto  sample = [&](const XPSWTexture2D& texture, bool isSRGB, float out[4][4]) {
+        const XPSWQuadColor color = sampleTextureQuad(texture, u, v, repeatUVCoords, isSRGB);
+        color.r.store(out[0]);
+        color.g.store(out[1]);
+        color.b.store(out[2]);
+        color.a.store(out[3]);
+    };
+    if (material.hasBaseColorTexture) { sample(material.baseColorTexture, true, lanes[0]); }
+    if (material.hasNormalMapTexture) { sample(material.normalMapTexture, false, lanes[1]); }
+    if (material.hasEmissionColorTexture) { sample(material.emissionColorTexture, true, lanes[2]); }
+    if (material.hasMetallicTexture) { sample(material.metallicTexture, false, lanes[3]); }
+    if (material.hasRoughnessTexture) { sample(material.roughnessTexture, false, lanes[4]); }
+    if (material.hasAOTexture) { sample(material.aoTexture, false, lanes[5]); }
+
+    for (int lane = 0; lane < 4; ++lane) {
+        XPSWPBRSample<T>& out = samples[lane];
+        out.baseColor         = material.hasBaseColorTexture
+                                  ? XPVec3<T>{ lanes[0][0][lane], lanes[0][1][lane], lanes[0][2][lane] }
+                                  : fragments[lane].fragColor;
+        out.normal            = material.hasNormalMapTexture ? XPVec3<T>{ 2.0f * lanes[1][0][lane] - 1.0f,
+                                                                          2.0f * lanes[1][1][lane] - 1.0f,
+                                                                          2.0f * lanes[1][2][lane] - 1.0f }
+                                                             : fragments[lane].fragNormal;
+        out.normal.normalize();
+        out.emission  = material.hasEmissionColorTexture
+                          ? XPVec3<T>{ lanes[2][0][lane], lanes[2][1][lane], lanes[2][2][lane] }
+                          : material.emissionColorValue;
+        out.metallic  = material.hasMetallicTexture ? lanes[3][0][lane] : material.metallicValue;
+        out.roughness = material.hasRoughnessTexture ? lanes[4][0][lane] : material.roughnessValue;
+        out.ao        = material.hasAOTexture ? lanes[5][0][lane] : material.aoValue;
+    }
+}
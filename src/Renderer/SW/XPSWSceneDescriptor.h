@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Renderer/SW/XPSWFrameOutput.h>
 #include <Renderer/SW/XPSWMaths.h>
 #include <Renderer/SW/XPSWTexture.h>
 #include <Renderer/SW/XPSWThirdParty.h>
@@ -27,6 +28,7 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <memory>
 
 static const size_t WIDTH  = 1920;
 static const size_t HEIGHT = 1080;
@@ -189,6 +191,24 @@ struct XPSWBoundingBox
 
         return XPSWEBoundingBoxFrustumTest_FullyInside;
     }
+    // Function to get the AABB around this one after transforming its 8 corners
+    [[nodiscard]] XPSWBoundingBox transformed(const XPMat4<T>& matrix) const
+    {
+        XPSWBoundingBox result(XPVec3<T>{ std::numeric_limits<T>::infinity(),
+                                          std::numeric_limits<T>::infinity(),
+                                          std::numeric_limits<T>::infinity() },
+                               XPVec3<T>{ -std::numeric_limits<T>::infinity(),
+                                          -std::numeric_limits<T>::infinity(),
+                                          -std::numeric_limits<T>::infinity() });
+        for (int i = 0; i < 8; ++i) {
+            glm::vec<4, T, glm::defaultp> corner(
+              (i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z, static_cast<T>(1));
+            glm::vec<3, T, glm::defaultp> transformedCorner = glm::vec<3, T, glm::defaultp>(matrix.glm * corner);
+            result.min.glm = glm::min(result.min.glm, transformedCorner);
+            result.max.glm = glm::max(result.max.glm, transformedCorner);
+        }
+        return result;
+    }
 
     XPVec3<T> min;
     XPVec3<T> max;
@@ -197,6 +217,9 @@ struct XPSWBoundingBox
 template<typename T>
 struct XPSWCamera
 {
+    XPSWCamera() noexcept                   = default;
+    XPSWCamera(XPSWCamera&& other) noexcept = default;
+    XPSWCamera(const XPSWCamera& other)     = delete;
     ~XPSWCamera() { destroyFrameBuffers(); }
 
     void updateMatrices()
@@ -287,24 +310,43 @@ struct XPSWCamera
     [[nodiscard]] size_t getDepthBufferNumBytes() const { return resolution.x * resolution.y * sizeof(float); }
     [[nodiscard]] size_t getColorBufferNumBytes() const { return resolution.x * resolution.y * 4 * sizeof(float); }
 
-    void createFrameBuffers()
+    // Rotates to the next framebuffers of the ring, waits for the output stage if it is still reading them and
+    // reallocates them when the resolution changed
+    void createFrameBuffers(size_t ringSize = 1)
     {
-        size_t numBytes = getDepthBufferNumBytes() + getColorBufferNumBytes();
+        if (frameBuffersRing.size() != ringSize) {
+            destroyFrameBuffers();
+            frameBuffersRing.resize(ringSize);
+            for (auto& frameBuffers : frameBuffersRing) { frameBuffers = std::make_unique<XPSWFrameBuffers>(); }
+        }
+        frameBuffersRingIndex     = (frameBuffersRingIndex + 1) % frameBuffersRing.size();
+        XPSWFrameBuffers& current = *frameBuffersRing[frameBuffersRingIndex];
+        current.waitUntilReleased();
 
-        frameBuffersPtr = static_cast<uint8_t*>(malloc(numBytes));
-        if (frameBuffersPtr == nullptr) {
-            LOGV_CRITICAL("Could not allocate camera framebuffers memory of {} bytes", numBytes);
+        size_t numBytes = getDepthBufferNumBytes() + getColorBufferNumBytes();
+        if (current.numBytes != numBytes) {
+            free(current.memory);
+            current.memory   = static_cast<uint8_t*>(malloc(numBytes));
+            current.numBytes = numBytes;
+            if (current.memory == nullptr) {
+                LOGV_CRITICAL("Could not allocate camera framebuffers memory of {} bytes", numBytes);
+            }
+            current.depthBuffer = reinterpret_cast<float*>(current.memory);
+            current.colorBuffer = reinterpret_cast<float*>(current.memory + getDepthBufferNumBytes());
         }
-        depthBuffer = reinterpret_cast<float*>(frameBuffersPtr);
-        colorBuffer = reinterpret_cast<float*>(frameBuffersPtr + getDepthBufferNumBytes());
+        depthBuffer = current.depthBuffer;
+        colorBuffer = current.colorBuffer;
     }
 
+    [[nodiscard]] XPSWFrameBuffers& getFrameBuffers() const { return *frameBuffersRing[frameBuffersRingIndex]; }
+
     void destroyFrameBuffers()
     {
-        if (frameBuffersPtr) {
-            free(frameBuffersPtr);
-            frameBuffersPtr = nullptr;
-        }
+        for (auto& frameBuffers : frameBuffersRing) { frameBuffers->waitUntilReleased(); }
+        frameBuffersRing.clear();
+        frameBuffersRingIndex = 0;
+        depthBuffer           = nullptr;
+        colorBuffer           = nullptr;
     }
 
     void clearColorBuffer() const
@@ -342,142 +384,6 @@ struct XPSWCamera
         }
     }
 
-    bool saveColorToEXR(const std::string& filename) const
-    {
-#ifndef __EMSCRIPTEN__
-        // Prepare EXR image
-        EXRHeader header;
-        InitEXRHeader(&header);
-
-        EXRImage image;
-        InitEXRImage(&image);
-
-        image.num_channels = 3;
-        image.width        = resolution.x;
-        image.height       = resolution.y;
-
-        // Split the color buffer into separate channels
-        std::vector<float> rChannel(resolution.x * resolution.y);
-        std::vector<float> gChannel(resolution.x * resolution.y);
-        std::vector<float> bChannel(resolution.x * resolution.y);
-
-        for (int i = 0; i < resolution.x * resolution.y; ++i) {
-            rChannel[i] = colorBuffer[4 * i + 0]; // R
-            gChannel[i] = colorBuffer[4 * i + 1]; // G
-            bChannel[i] = colorBuffer[4 * i + 2]; // B
-        }
-
-        // Pointers to each channel
-        std::vector<float*> image_ptr(image.num_channels);
-        image_ptr[0] = rChannel.data(); // R
-        image_ptr[1] = gChannel.data(); // G
-        image_ptr[2] = bChannel.data(); // B
-
-        image.images = reinterpret_cast<unsigned char**>(image_ptr.data());
-
-        // Set up EXR header
-        header.num_channels = image.num_channels;
-        header.channels     = new EXRChannelInfo[header.num_channels];
-        strncpy(header.channels[0].name, "R", 255);
-        strncpy(header.channels[1].name, "G", 255);
-        strncpy(header.channels[2].name, "B", 255);
-
-        header.pixel_types           = new int[header.num_channels];
-        header.requested_pixel_types = new int[header.num_channels];
-        for (int i = 0; i < header.num_channels; i++) {
-            header.pixel_types[i]           = TINYEXR_PIXELTYPE_FLOAT; // Input pixel type (float for HDR)
-            header.requested_pixel_types[i] = TINYEXR_PIXELTYPE_FLOAT; // Output pixel type (float for HDR)
-        }
-
-        // Save EXR file
-        std::filesystem::path filepath(filename);
-        std::filesystem::create_directories("./output/");
-        auto outName = std::string("./output/").append(filepath.filename().string()).append(".exr");
-
-        const char* err = nullptr;
-        int         ret = SaveEXRImageToFile(&image, &header, outName.c_str(), &err);
-        if (ret != TINYEXR_SUCCESS) {
-            fprintf(stderr, "Error saving color EXR file: %s\n", err);
-            FreeEXRErrorMessage(err);
-            return false;
-        }
-
-        // Cleanup
-        delete[] header.channels;
-        delete[] header.pixel_types;
-        delete[] header.requested_pixel_types;
-#endif
-
-        return true;
-    }
-
-    [[nodiscard]] bool saveDepthToEXR(const std::string& filename) const
-    {
-#ifndef __EMSCRIPTEN__
-        // Convert uint32_t depth buffer to float
-        std::vector<float> depthBufferFloat(getDepthBufferNumBytes() / sizeof(float));
-        float              maxVal = FLT_MIN, minVal = FLT_MAX;
-        for (size_t i = 0; i < depthBufferFloat.size(); ++i) {
-            float val = ExponentialInvertedToLinearZ(depthBuffer[i]);
-            if (val > maxVal) { maxVal = val; }
-            if (val < minVal) { minVal = val; }
-        }
-        float rangeVal = fabs(maxVal - minVal);
-        for (size_t i = 0; i < depthBufferFloat.size(); ++i) {
-            depthBufferFloat[i] = (ExponentialInvertedToLinearZ(depthBuffer[i]) / rangeVal) * 255.0f;
-        }
-
-        // Prepare EXR image
-        EXRHeader header;
-        InitEXRHeader(&header);
-
-        EXRImage image;
-        InitEXRImage(&image);
-
-        image.num_channels = 1; // 1 channel for depth (Z)
-        image.width        = resolution.x;
-        image.height       = resolution.y;
-
-        // Pointers to the depth channel
-        std::vector<float*> image_ptr(1);
-        image_ptr[0] = depthBufferFloat.data(); // Z
-
-        image.images = reinterpret_cast<unsigned char**>(image_ptr.data());
-
-        // Set up EXR header
-        header.num_channels = 1;
-        header.channels     = new EXRChannelInfo[header.num_channels];
-        strncpy(header.channels[0].name, "Z", 255);
-        header.compression_type = TINYEXR_COMPRESSIONTYPE_NONE;
-
-        header.pixel_types           = new int[header.num_channels];
-        header.requested_pixel_types = new int[header.num_channels];
-        for (int i = 0; i < header.num_channels; i++) {
-            header.pixel_types[i]           = TINYEXR_PIXELTYPE_FLOAT; // Input pixel type (float for HDR)
-            header.requested_pixel_types[i] = TINYEXR_PIXELTYPE_FLOAT; // Output pixel type (float for HDR)
-        }
-
-        // Save EXR file
-        std::filesystem::path filepath(filename);
-        std::filesystem::create_directories("./output/");
-        auto outName = std::string("./output/").append(filepath.filename().string()).append(".exr");
-
-        const char* err = nullptr;
-        int         ret = SaveEXRImageToFile(&image, &header, outName.c_str(), &err);
-        if (ret != TINYEXR_SUCCESS) {
-            fprintf(stderr, "Error saving depth EXR file: %s\n", err);
-            FreeEXRErrorMessage(err);
-            return false;
-        }
-
-        // Cleanup
-        delete[] header.channels;
-        delete[] header.pixel_types;
-        delete[] header.requested_pixel_types;
-#endif
-        return true;
-    }
-
     // void exportDepth(const std::string& filename) const
     // {
     //     std::vector<uint8_t> data;
@@ -527,9 +433,12 @@ struct XPSWCamera
     XPMat4<T>        projectionMatrix;
     XPMat4<T>        inverseViewMatrix;
     XPMat4<T>        inverseProjectionMatrix;
-    uint8_t*         frameBuffersPtr;
-    float*           colorBuffer;
-    float*           depthBuffer;
+    float*           colorBuffer = nullptr;
+    float*           depthBuffer = nullptr;
+    uint64_t         frameIndex  = 0;
+    // the ring outlives the frame so nothing is allocated per frame, the output stage reads the previous entries
+    std::vector<std::unique_ptr<XPSWFrameBuffers>> frameBuffersRing;
+    size_t                                         frameBuffersRingIndex = 0;
 };
 
 enum XPSWELightType
@@ -582,16 +491,7 @@ struct XPSWVertexFragmentVaryings
 template<typename T>
 struct XPSWVertexFragmentFlatVaryings
 {
-    std::vector<XPSWELightType> lightType;
-    std::vector<float>          lightAttenuationConstant;
-    std::vector<float>          lightAttenuationLinear;
-    std::vector<float>          lightAttenuationQuadratic;
-    std::vector<float>          lightAngleOuterCone;
-    std::vector<XPVec3<T>>      lightPos;
-    std::vector<XPVec3<T>>      lightDirection;
-    std::vector<XPVec3<T>>      lightColor;
-    std::vector<float>          lightIntensity;
-    XPVec3<T>                   viewPos;
+    XPVec3<T> viewPos;
 };
 
 template<typename T>
@@ -728,6 +628,9 @@ struct XPSWTriangle
 // };
 
 // Struct to store mesh data
+// Vertex fetch goes through the stream pointers, they either view the buffers of an XPMeshBuffer in the data pipeline
+// or the storage vectors of a mesh imported from a file. Normals, texture coordinates, tangents and biTangents are
+// padded to 4 components to match the data pipeline layout, tangents and biTangents are optional.
 template<typename T>
 struct XPSWMesh
 {
@@ -735,17 +638,49 @@ struct XPSWMesh
     XPSWMesh(XPSWMesh&& other) noexcept = default;
     XPSWMesh(const XPSWMesh& other)     = delete;
 
+    // Points the streams at the storage vectors, call it once the storage is filled
+    void bindStorage()
+    {
+        positions  = positionsStorage.data();
+        normals    = normalsStorage.data();
+        texCoords  = texCoordsStorage.data();
+        tangents   = tangentsStorage.empty() ? nullptr : tangentsStorage.data();
+        biTangents = biTangentsStorage.empty() ? nullptr : biTangentsStorage.data();
+        indices    = indicesStorage.data();
+        numIndices = static_cast<uint32_t>(indicesStorage.size());
+    }
+    // Shares the streams of another mesh, the other mesh has to outlive this one
+    void viewStreamsOf(const XPSWMesh& other)
+    {
+        positions  = other.positions;
+        normals    = other.normals;
+        texCoords  = other.texCoords;
+        tangents   = other.tangents;
+        biTangents = other.biTangents;
+        indices    = other.indices;
+        numIndices = other.numIndices;
+        generation = other.generation;
+    }
+
     std::string            name;
     XPMat4<T>              transform;
-    std::vector<XPVec4<T>> vertices;
-    std::vector<XPVec3<T>> normals;
-    std::vector<XPVec2<T>> texCoords;
-    std::vector<XPVec3<T>> colors;
-    std::vector<XPVec3<T>> tangents;
-    std::vector<XPVec3<T>> biTangents;
-    std::vector<uint32_t>  indices;
+    const XPVec4<T>*       positions  = nullptr;
+    const XPVec4<T>*       normals    = nullptr;
+    const XPVec4<T>*       texCoords  = nullptr;
+    const XPVec4<T>*       tangents   = nullptr;
+    const XPVec4<T>*       biTangents = nullptr;
+    const uint32_t*        indices    = nullptr;
+    uint32_t               numIndices = 0;
+    // changes whenever the streams are refilled in place, the pointers alone don't tell
+    uint64_t               generation = 0;
     XPSWBoundingBox<T>     boundingBox;
     unsigned int           materialIndex;
+    std::vector<XPVec4<T>> positionsStorage;
+    std::vector<XPVec4<T>> normalsStorage;
+    std::vector<XPVec4<T>> texCoordsStorage;
+    std::vector<XPVec4<T>> tangentsStorage;
+    std::vector<XPVec4<T>> biTangentsStorage;
+    std::vector<uint32_t>  indicesStorage;
 };
 
 template<typename T>
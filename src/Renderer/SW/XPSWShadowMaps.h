@@ -0,0 +1,329 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Renderer/SW/XPSWLogger.h>
+#include <Renderer/SW/XPSWMaths.h>
+#include <Renderer/SW/XPSWSceneDescriptor.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/// @brief one depth target of a light. the camera is only used by the depth-only path of the rasterizer, its depth
+/// buffer points into depth and its planes and resolution describe the target
+template<typename T>
+struct XPSWShadowView
+{
+    void resize(uint32_t resolution)
+    {
+        camera.resolution = { resolution, resolution };
+        depth.resize(static_cast<size_t>(resolution) * resolution);
+        camera.depthBuffer = depth.data();
+    }
+
+    XPSWCamera<T>      camera;
+    std::vector<float> depth;
+    XPMat4<T>          viewProjectionMatrix;
+    // orthographic views keep w at 1, the rasterizer moves their linear depth into w instead
+    bool orthographic = false;
+    // cascades only, view depth of the main camera up to which this cascade is used
+    T splitDepth = 0;
+    // what the depth currently holds, the view is only rendered again when it changes
+    uint64_t signature = 0;
+    bool     valid     = false;
+};
+
+/// @brief views of one light, one for a spot light, six cube faces for a point light and NumCascades per camera for a
+/// directional light, empty for lights without shadows
+template<typename T>
+struct XPSWLightShadow
+{
+    XPSWELightType                 type = XPSWELightType_Directional;
+    std::vector<XPSWShadowView<T>> views;
+};
+
+/// @brief shadow maps of the scene lights. views are kept across frames and only the ones whose light, casters or
+/// cascade moved are collected into dirtyViews to be rendered again
+template<typename T>
+struct XPSWShadowMaps
+{
+    static constexpr uint32_t Resolution     = 1024;
+    static constexpr uint32_t CubeResolution = 512;
+    static constexpr uint32_t NumCascades    = 3;
+    // cube maps are six full renders, only that many point lights get them and the rest stay unshadowed
+    static constexpr uint32_t MaxPointLightShadows = 16;
+    // blend between uniform and logarithmic cascade splits
+    static constexpr float CascadeSplitLambda  = 0.5f;
+    static constexpr float PointLightNearPlane = 0.05f;
+    static constexpr float MaxSpotLightFov     = 170.0f;
+    // receivers are pushed along their normal and towards the light by that many texels against acne
+    static constexpr float NormalOffsetTexels = 1.0f;
+    static constexpr float DepthBiasTexels    = 1.5f;
+
+    /// @brief lays out the views of every light for the camera and collects the ones that have to be rendered again
+    void prepare(const XPSWScene<T>& scene, size_t cameraIndex)
+    {
+        const XPSWCamera<T>& camera = scene.cameras[cameraIndex];
+        currentCamera               = cameraIndex;
+        dirtyViews.clear();
+
+        // anything that moves, appears or disappears among the casters invalidates every view
+        uint64_t  castersHash = FNVOffsetBasis;
+        XPVec3<T> sceneMin    = { FLT_MAX, FLT_MAX, FLT_MAX };
+        XPVec3<T> sceneMax    = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (const XPSWMesh<T>& mesh : scene.meshes) {
+            castersHash  = hashBytes(castersHash, &mesh.transform, sizeof(mesh.transform));
+            castersHash  = hashBytes(castersHash, &mesh.positions, sizeof(mesh.positions));
+            castersHash  = hashBytes(castersHash, &mesh.numIndices, sizeof(mesh.numIndices));
+            castersHash  = hashBytes(castersHash, &mesh.generation, sizeof(mesh.generation));
+            sceneMin.glm = glm::min(sceneMin.glm, mesh.boundingBox.min.glm);
+            sceneMax.glm = glm::max(sceneMax.glm, mesh.boundingBox.max.glm);
+        }
+        if (scene.meshes.empty()) { sceneMin = sceneMax = { 0, 0, 0 }; }
+        const glm::vec<3, T, glm::defaultp> sceneCenter = (sceneMin.glm + sceneMax.glm) * T(0.5);
+        const T                             sceneRadius = glm::length(sceneMax.glm - sceneMin.glm) * T(0.5);
+
+        lights.resize(scene.lights.size());
+        uint32_t numPointLights = 0;
+        for (size_t li = 0; li < scene.lights.size(); ++li) {
+            const XPSWLight<T>&             light = scene.lights[li];
+            std::vector<XPSWShadowView<T>>& views = lights[li].views;
+            lights[li].type                       = light.type;
+            if (light.type == XPSWELightType_Spot) {
+                views.resize(1);
+                views[0].resize(Resolution);
+                setPerspectiveView(views[0],
+                                   light.location,
+                                   light.location + light.direction,
+                                   std::min(glm::degrees(2.0f * light.angleOuterCone), MaxSpotLightFov),
+                                   PointLightNearPlane,
+                                   camera.zFarPlane);
+            } else if (light.type == XPSWELightType_Point) {
+                if (numPointLights++ >= MaxPointLightShadows) {
+                    views.clear();
+                    continue;
+                }
+                static const XPVec3<T> axes[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 },
+                                                   { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+                views.resize(6);
+                for (uint32_t face = 0; face < 6; ++face) {
+                    views[face].resize(CubeResolution);
+                    setPerspectiveView(views[face],
+                                       light.location,
+                                       light.location + axes[face],
+                                       T(90),
+                                       PointLightNearPlane,
+                                       camera.zFarPlane);
+                }
+            } else if (light.type == XPSWELightType_Directional) {
+                views.resize(static_cast<size_t>(NumCascades) * scene.cameras.size());
+                for (uint32_t cascade = 0; cascade < NumCascades; ++cascade) {
+                    XPSWShadowView<T>& view = views[cameraIndex * NumCascades + cascade];
+                    view.resize(Resolution);
+                    setCascadeView(view, light, camera, cascade, sceneCenter, sceneRadius);
+                }
+            }
+
+            for (size_t vi = 0; vi < views.size(); ++vi) {
+                XPSWShadowView<T>& view = views[vi];
+                if (light.type == XPSWELightType_Directional && vi / NumCascades != cameraIndex) { continue; }
+                const uint64_t signature =
+                  hashBytes(castersHash, &view.viewProjectionMatrix, sizeof(view.viewProjectionMatrix));
+                if (view.valid && view.signature == signature) { continue; }
+                view.signature = signature;
+                view.valid     = true;
+                dirtyViews.push_back(&view);
+            }
+        }
+    }
+
+    /// @brief fraction of the PCF taps around the world position that the light reaches, 1 for lights without views
+    /// and for positions outside of every view
+    [[nodiscard]] float getVisibility(uint32_t             lightIndex,
+                                      const XPVec3<T>&     worldPos,
+                                      const XPVec3<T>&     normal,
+                                      const XPSWCamera<T>& camera) const
+    {
+        if (lightIndex >= lights.size() || lights[lightIndex].views.empty()) { return 1.0f; }
+        const std::vector<XPSWShadowView<T>>& views = lights[lightIndex].views;
+        if (lights[lightIndex].type == XPSWELightType_Spot) { return sampleView(views[0], worldPos, normal); }
+        if (lights[lightIndex].type == XPSWELightType_Point) {
+            // the cube face is picked by the major axis from the light towards the position
+            const glm::vec<3, T, glm::defaultp> d    = worldPos.glm - views[0].camera.location.glm;
+            const glm::vec<3, T, glm::defaultp> a    = glm::abs(d);
+            const uint32_t                      face = a.x >= a.y && a.x >= a.z ? (d.x >= 0 ? 0 : 1)
+                                                       : a.y >= a.z             ? (d.y >= 0 ? 2 : 3)
+                                                                                : (d.z >= 0 ? 4 : 5);
+            return sampleView(views[face], worldPos, normal);
+        }
+        const T viewDepth = -(camera.viewMatrix.glm * glm::vec<4, T, glm::defaultp>(worldPos.glm, 1)).z;
+        for (uint32_t cascade = 0; cascade < NumCascades; ++cascade) {
+            const XPSWShadowView<T>& view = views[currentCamera * NumCascades + cascade];
+            if (viewDepth <= view.splitDepth) { return sampleView(view, worldPos, normal); }
+        }
+        return 1.0f;
+    }
+
+    // per scene light
+    std::vector<XPSWLightShadow<T>> lights;
+    // views to render before the frame, filled by prepare
+    std::vector<XPSWShadowView<T>*> dirtyViews;
+    size_t                          currentCamera = 0;
+
+  private:
+    static constexpr uint64_t FNVOffsetBasis = 14695981039346656037ull;
+    static constexpr uint64_t FNVPrime       = 1099511628211ull;
+
+    static uint64_t hashBytes(uint64_t hash, const void* data, size_t numBytes)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < numBytes; ++i) { hash = (hash ^ bytes[i]) * FNVPrime; }
+        return hash;
+    }
+
+    static XPVec3<T> getUpVector(const XPVec3<T>& forward)
+    {
+        XPVec3<T> f = forward;
+        f.normalize();
+        return std::abs(f.y) > T(0.99) ? XPVec3<T>{ 1, 0, 0 } : XPVec3<T>{ 0, 1, 0 };
+    }
+
+    static void setPerspectiveView(XPSWShadowView<T>& view,
+                                   const XPVec3<T>&   location,
+                                   const XPVec3<T>&   target,
+                                   T                  fov,
+                                   T                  zNear,
+                                   T                  zFar)
+    {
+        XPSWCamera<T>& camera = view.camera;
+        camera.fov            = fov;
+        camera.zNearPlane     = zNear;
+        camera.zFarPlane      = zFar;
+        camera.location       = location;
+        camera.target         = target;
+        camera.up             = getUpVector(target - location);
+        camera.updateMatrices();
+        view.orthographic         = false;
+        view.viewProjectionMatrix = camera.projectionMatrix * camera.viewMatrix;
+    }
+
+    // the slice of the camera frustum is bounded by a sphere so the cascade keeps its size while the camera turns
+    static void setCascadeView(XPSWShadowView<T>&                   view,
+                               const XPSWLight<T>&                  light,
+                               const XPSWCamera<T>&                 camera,
+                               uint32_t                             cascade,
+                               const glm::vec<3, T, glm::defaultp>& sceneCenter,
+                               T                                    sceneRadius)
+    {
+        const T sliceNear = getCascadeSplit(camera, cascade);
+        const T sliceFar  = getCascadeSplit(camera, cascade + 1);
+
+        glm::vec<3, T, glm::defaultp> corners[8];
+        glm::vec<3, T, glm::defaultp> center(0);
+        for (uint32_t i = 0; i < 8; ++i) {
+            glm::vec<4, T, glm::defaultp> p = camera.inverseProjectionMatrix.glm *
+                                              glm::vec<4, T, glm::defaultp>((i & 1) ? 1 : -1, (i & 2) ? 1 : -1, -1, 1);
+            const glm::vec<3, T, glm::defaultp> direction = glm::vec<3, T, glm::defaultp>(p) / -p.z;
+            p          = glm::vec<4, T, glm::defaultp>(direction * ((i & 4) ? sliceFar : sliceNear), 1);
+            corners[i] = glm::vec<3, T, glm::defaultp>(camera.inverseViewMatrix.glm * p);
+            center += corners[i] / T(8);
+        }
+        T radius = 0;
+        for (const glm::vec<3, T, glm::defaultp>& corner : corners) {
+            radius = std::max(radius, glm::length(corner - center));
+        }
+
+        // far enough back along the light that every caster of the scene is in front of the near plane
+        XPVec3<T> direction = light.direction;
+        direction.normalize();
+        const T distance = radius + glm::length(center - sceneCenter) + sceneRadius;
+
+        XPSWCamera<T>& shadowCamera = view.camera;
+        shadowCamera.zNearPlane     = T(0.01);
+        shadowCamera.zFarPlane      = distance + radius;
+        shadowCamera.location       = { center.x - direction.x * distance,
+                                        center.y - direction.y * distance,
+                                        center.z - direction.z * distance };
+        shadowCamera.target         = { center.x, center.y, center.z };
+        shadowCamera.up             = getUpVector(direction);
+        shadowCamera.viewMatrix     = createViewMatrix(shadowCamera.location, shadowCamera.target, shadowCamera.up);
+        shadowCamera.projectionMatrix.glm =
+          glm::orthoRH_NO(-radius, radius, -radius, radius, shadowCamera.zNearPlane, shadowCamera.zFarPlane);
+        shadowCamera.inverseViewMatrix.glm       = glm::inverse(shadowCamera.viewMatrix.glm);
+        shadowCamera.inverseProjectionMatrix.glm = glm::inverse(shadowCamera.projectionMatrix.glm);
+        view.orthographic                        = true;
+        view.splitDepth                          = sliceFar;
+        view.viewProjectionMatrix                = shadowCamera.projectionMatrix * shadowCamera.viewMatrix;
+    }
+
+    [[nodiscard]] static T getCascadeSplit(const XPSWCamera<T>& camera, uint32_t split)
+    {
+        const T ratio       = static_cast<T>(split) / NumCascades;
+        const T logarithmic = camera.zNearPlane * std::pow(camera.zFarPlane / camera.zNearPlane, ratio);
+        const T uniform     = camera.zNearPlane + (camera.zFarPlane - camera.zNearPlane) * ratio;
+        return CascadeSplitLambda * logarithmic + (1 - CascadeSplitLambda) * uniform;
+    }
+
+    // projects the position the same way the depth-only path of the rasterizer projected the casters and compares it
+    // against the 3x3 texels around it
+    [[nodiscard]] static float
+    sampleView(const XPSWShadowView<T>& view, const XPVec3<T>& worldPos, const XPVec3<T>& normal)
+    {
+        const XPSWCamera<T>& camera     = view.camera;
+        const T              resolution = static_cast<T>(camera.resolution.x);
+
+        // world size of a texel at the position, the offsets against acne scale with it
+        T texelSize = 0;
+        if (view.orthographic) {
+            texelSize = T(2) / (camera.projectionMatrix.glm[0][0] * resolution);
+        } else {
+            const glm::vec<4, T, glm::defaultp> viewPos =
+              camera.viewMatrix.glm * glm::vec<4, T, glm::defaultp>(worldPos.glm, 1);
+            texelSize = T(2) * -viewPos.z / (camera.projectionMatrix.glm[0][0] * resolution);
+        }
+
+        const glm::vec<4, T, glm::defaultp> clip =
+          view.viewProjectionMatrix.glm *
+          glm::vec<4, T, glm::defaultp>(worldPos.glm + normal.glm * (texelSize * NormalOffsetTexels), 1);
+        if (clip.w <= 0) { return 1.0f; }
+        const glm::vec<3, T, glm::defaultp> ndc = glm::vec<3, T, glm::defaultp>(clip) / clip.w;
+        if (ndc.x < -1 || ndc.x > 1 || ndc.y < -1 || ndc.y > 1 || ndc.z > 1) { return 1.0f; }
+
+        const T x = (ndc.x + T(1)) * T(0.5) * resolution;
+        const T y = (T(1) - ndc.y) * T(0.5) * resolution;
+        T       linearDepth =
+          view.orthographic
+                  ? (ndc.z + T(1)) * T(0.5) * (camera.zFarPlane - camera.zNearPlane) + camera.zNearPlane
+                  : clip.w;
+        linearDepth   = std::max(linearDepth - texelSize * DepthBiasTexels, camera.zNearPlane);
+        const float d = LinearToExponentialInvertedZ(linearDepth, camera.zNearPlane, camera.zFarPlane);
+
+        const int64_t size = static_cast<int64_t>(camera.resolution.x);
+        const int64_t cx   = static_cast<int64_t>(std::floor(x + T(0.5)));
+        const int64_t cy   = static_cast<int64_t>(std::floor(y + T(0.5)));
+        uint32_t      lit  = 0;
+        for (int64_t dy = -1; dy <= 1; ++dy) {
+            for (int64_t dx = -1; dx <= 1; ++dx) {
+                const int64_t sx = std::clamp<int64_t>(cx + dx, 0, size - 1);
+                const int64_t sy = std::clamp<int64_t>(cy + dy, 0, size - 1);
+                if (d <= view.depth[sy * size + sx]) { ++lit; }
+            }
+        }
+        return static_cast<float>(lit) / 9.0f;
+    }
+};
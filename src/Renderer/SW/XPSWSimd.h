@@ -0,0 +1,187 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cmath>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define XP_SW_SIMD_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define XP_SW_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+/// @brief 4 wide float register, one lane per pixel of a 2x2 quad (top-left, top-right, bottom-left, bottom-right)
+struct XPSWFloat4
+{
+#if defined(XP_SW_SIMD_SSE2)
+    __m128 v;
+#elif defined(XP_SW_SIMD_NEON)
+    float32x4_t v;
+#else
+    float v[4];
+#endif
+
+    [[nodiscard]] static inline XPSWFloat4 broadcast(float x)
+    {
+        XPSWFloat4 r;
+#if defined(XP_SW_SIMD_SSE2)
+        r.v = _mm_set1_ps(x);
+#elif defined(XP_SW_SIMD_NEON)
+        r.v = vdupq_n_f32(x);
+#else
+        r.v[0] = r.v[1] = r.v[2] = r.v[3] = x;
+#endif
+        return r;
+    }
+    [[nodiscard]] static inline XPSWFloat4 load(const float* p)
+    {
+        XPSWFloat4 r;
+#if defined(XP_SW_SIMD_SSE2)
+        r.v = _mm_loadu_ps(p);
+#elif defined(XP_SW_SIMD_NEON)
+        r.v = vld1q_f32(p);
+#else
+        for (int i = 0; i < 4; ++i) { r.v[i] = p[i]; }
+#endif
+        return r;
+    }
+    [[nodiscard]] static inline XPSWFloat4 set(float a, float b, float c, float d)
+    {
+        const float values[4] = { a, b, c, d };
+        return load(values);
+    }
+    inline void store(float* p) const
+    {
+#if defined(XP_SW_SIMD_SSE2)
+        _mm_storeu_ps(p, v);
+#elif defined(XP_SW_SIMD_NEON)
+        vst1q_f32(p, v);
+#else
+        for (int i = 0; i < 4; ++i) { p[i] = v[i]; }
+#endif
+    }
+    /// @brief truncates towards zero, callers clamp to a valid range beforehand
+    inline void storeInt(int32_t* p) const
+    {
+#if defined(XP_SW_SIMD_SSE2)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(v));
+#elif defined(XP_SW_SIMD_NEON)
+        vst1q_s32(p, vcvtq_s32_f32(v));
+#else
+        for (int i = 0; i < 4; ++i) { p[i] = static_cast<int32_t>(v[i]); }
+#endif
+    }
+    [[nodiscard]] inline float lane(int i) const
+    {
+        float values[4];
+        store(values);
+        return values[i];
+    }
+
+    friend inline XPSWFloat4 operator+(const XPSWFloat4& a, const XPSWFloat4& b)
+    {
+        XPSWFloat4 r;
+#if defined(XP_SW_SIMD_SSE2)
+        r.v = _mm_add_ps(a.v, b.v);
+#elif defined(XP_SW_SIMD_NEON)
+        r.v = vaddq_f32(a.v, b.v);
+#else
+        for (int i = 0; i < 4; ++i) { r.v[i] = a.v[i] + b.v[i]; }
+#endif
+        return r;
+    }
+    friend inline XPSWFloat4 operator-(const XPSWFloat4& a, const XPSWFloat4& b)
+    {
+        XPSWFloat4 r;
+#if defined(XP_SW_SIMD_SSE2)
+        r.v = _mm_sub_ps(a.v, b.v);
+#elif defined(XP_SW_SIMD_NEON)
+        r.v = vsubq_f32(a.v, b.v);
+#else
+        for (int i = 0; i < 4; ++i) { r.v[i] = a.v[i] - b.v[i]; }
+#endif
+        return r;
+    }
+    friend inline XPSWFloat4 operator*(const XPSWFloat4& a, const XPSWFloat4& b)
+    {
+        XPSWFloat4 r;
+#if defined(XP_SW_SIMD_SSE2)
+        r.v = _mm_mul_ps(a.v, b.v);
+#elif defined(XP_SW_SIMD_NEON)
+        r.v = vmulq_f32(a.v, b.v);
+#else
+        for (int i = 0; i < 4; ++i) { r.v[i] = a.v[i] * b.v[i]; }
+#endif
+        return r;
+    }
+    [[nodiscard]] static inline XPSWFloat4 min(const XPSWFloat4& a, const XPSWFloat4& b)
+    {
+        XPSWFloat4 r;
+#if defined(XP_SW_SIMD_SSE2)
+        r.v = _mm_min_ps(a.v, b.v);
+#elif defined(XP_SW_SIMD_NEON)
+        r.v = vminq_f32(a.v, b.v);
+#else
+        for (int i = 0; i < 4; ++i) { r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i]; }
+#endif
+        return r;
+    }
+    [[nodiscard]] static inline XPSWFloat4 max(const XPSWFloat4& a, const XPSWFloat4& b)
+    {
+        XPSWFloat4 r;
+#if defined(XP_SW_SIMD_SSE2)
+        r.v = _mm_max_ps(a.v, b.v);
+#elif defined(XP_SW_SIMD_NEON)
+        r.v = vmaxq_f32(a.v, b.v);
+#else
+        for (int i = 0; i < 4; ++i) { r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; }
+#endif
+        return r;
+    }
+    [[nodiscard]] static inline XPSWFloat4 clamp(const XPSWFloat4& x, const XPSWFloat4& lo, const XPSWFloat4& hi)
+    {
+        return min(max(x, lo), hi);
+    }
+    [[nodiscard]] static inline XPSWFloat4 floor(const XPSWFloat4& x)
+    {
+        XPSWFloat4 r;
+#if defined(XP_SW_SIMD_SSE2)
+        // sse2 has no round instruction, truncate then step down where truncation went up
+        const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x.v));
+        r.v = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, x.v), _mm_set1_ps(1.0f)));
+#elif defined(XP_SW_SIMD_NEON)
+        r.v = vrndmq_f32(x.v);
+#else
+        for (int i = 0; i < 4; ++i) { r.v[i] = std::floor(x.v[i]); }
+#endif
+        return r;
+    }
+    [[nodiscard]] static inline XPSWFloat4 lerp(const XPSWFloat4& a, const XPSWFloat4& b, const XPSWFloat4& t)
+    {
+        return a + (b - a) * t;
+    }
+};
+
+/// @brief structure of arrays color for the 4 lanes of a quad
+struct XPSWQuadColor
+{
+    XPSWFloat4 r;
+    XPSWFloat4 g;
+    XPSWFloat4 b;
+    XPSWFloat4 a;
+};
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Renderer/SW/XPSWMaths.h>
+#include <Renderer/SW/XPSWSimd.h>
 #include <Renderer/SW/XPSWThirdParty.h>
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -22,9 +23,31 @@
     #define _CRT_SECURE_NO_DEPRECATE
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <filesystem>
 #include <vector>
 
+/// @brief One level of a texture stored as 4x4 tiles of rgba8 texels, a tile is exactly one 64 byte cache line so
+/// that the 2x2 footprint of a bilinear fetch touches a single line most of the time
+struct XPSWTextureMip
+{
+    int                   width  = 0;
+    int                   height = 0;
+    int                   tilesX = 0;
+    std::vector<uint32_t> texels;
+
+    [[nodiscard]] inline uint32_t fetch(int x, int y) const
+    {
+        return texels[((static_cast<size_t>(y >> 2) * tilesX + (x >> 2)) << 4) + ((y & 3) << 2) + (x & 3)];
+    }
+    inline void write(int x, int y, uint32_t texel)
+    {
+        texels[((static_cast<size_t>(y >> 2) * tilesX + (x >> 2)) << 4) + ((y & 3) << 2) + (x & 3)] = texel;
+    }
+};
+
 struct XPSWTexture2D
 {
     XPSWTexture2D()
@@ -81,86 +104,257 @@ struct XPSWTexture2D
             XPVec4<float>* f32rgbapixels;
         };
     };
-    std::string path;
-    int         width;
-    int         height;
-    int         channels;
-    bool        isHDR;
+    std::string                 path;
+    int                         width;
+    int                         height;
+    int                         channels;
+    bool                        isHDR;
+    std::vector<XPSWTextureMip> mips;
 };
 
+// 8-bit to float conversion tables, the srgb one replaces the per sample pow of the gamma curve
+inline const float*
+getUnormToFloatTable()
+{
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> t = {};
+        for (int i = 0; i < 256; ++i) { t[i] = static_cast<float>(i) / 255.0f; }
+        return t;
+    }();
+    return table.data();
+}
+
+inline const float*
+getSRGBToLinearTable()
+{
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> t = {};
+        for (int i = 0; i < 256; ++i) {
+            const float c = static_cast<float>(i) / 255.0f;
+            t[i]          = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return t;
+    }();
+    return table.data();
+}
+
+/// @brief converts the loaded rgba8 pixels into a tiled mip chain, required before sampling the texture
+inline void
+buildTextureMips(XPSWTexture2D& texture)
+{
+    texture.mips.clear();
+    if (texture.u8data == nullptr || texture.isHDR || texture.channels != 4 || texture.width <= 0 ||
+        texture.height <= 0) {
+        return;
+    }
+
+    auto allocateMip = [](int width, int height) {
+        XPSWTextureMip mip;
+        mip.width  = width;
+        mip.height = height;
+        mip.tilesX = (width + 3) / 4;
+        mip.texels.resize(static_cast<size_t>(mip.tilesX) * ((height + 3) / 4) * 16, 0);
+        return mip;
+    };
+
+    XPSWTextureMip base = allocateMip(texture.width, texture.height);
+    for (int y = 0; y < texture.height; ++y) {
+        for (int x = 0; x < texture.width; ++x) {
+            uint32_t texel;
+            memcpy(&texel, &texture.u8rgbapixels[static_cast<size_t>(y) * texture.width + x], sizeof(texel));
+            base.write(x, y, texel);
+        }
+    }
+    texture.mips.push_back(std::move(base));
+
+    while (texture.mips.back().width > 1 || texture.mips.back().height > 1) {
+        const XPSWTextureMip& src = texture.mips.back();
+        XPSWTextureMip        dst = allocateMip(std::max(1, src.width >> 1), std::max(1, src.height >> 1));
+        for (int y = 0; y < dst.height; ++y) {
+            const int y0 = std::min(y * 2, src.height - 1);
+            const int y1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; ++x) {
+                const int      x0       = std::min(x * 2, src.width - 1);
+                const int      x1       = std::min(x * 2 + 1, src.width - 1);
+                const uint32_t texels[] = {
+                    src.fetch(x0, y0), src.fetch(x1, y0), src.fetch(x0, y1), src.fetch(x1, y1)
+                };
+                uint32_t result = 0;
+                for (int c = 0; c < 4; ++c) {
+                    uint32_t sum = 2;
+                    for (uint32_t texel : texels) { sum += (texel >> (c * 8)) & 0xff; }
+                    result |= (sum >> 2) << (c * 8);
+                }
+                dst.write(x, y, result);
+            }
+        }
+        texture.mips.push_back(std::move(dst));
+    }
+}
+
+/// @brief mip level from the uv footprint of one pixel, derivatives are in uv units per pixel
+inline float
+computeTextureLod(const XPSWTexture2D& texture, float dudx, float dvdx, float dudy, float dvdy)
+{
+    if (texture.mips.size() <= 1) { return 0.0f; }
+    const float w    = static_cast<float>(texture.width);
+    const float h    = static_cast<float>(texture.height);
+    const float dx   = (dudx * w) * (dudx * w) + (dvdx * h) * (dvdx * h);
+    const float dy   = (dudy * w) * (dudy * w) + (dvdy * h) * (dvdy * h);
+    const float rho2 = std::max(dx, dy);
+    if (rho2 <= 1.0f) { return 0.0f; }
+    return std::min(0.5f * std::log2(rho2), static_cast<float>(texture.mips.size() - 1));
+}
+
+inline XPVec4<float>
+sampleTextureMipBilinear(const XPSWTextureMip& mip, float u, float v, bool repeat, const float* table)
+{
+    if (repeat) {
+        u = u - std::floor(u);
+        v = v - std::floor(v);
+    }
+    u = std::clamp(u, 0.0f, 1.0f);
+    v = std::clamp(v, 0.0f, 1.0f);
+
+    // texel space, adjusted for pixel centers
+    const float x  = std::clamp(u * static_cast<float>(mip.width) - 0.5f, 0.0f, static_cast<float>(mip.width - 1));
+    const float y  = std::clamp(v * static_cast<float>(mip.height) - 0.5f, 0.0f, static_cast<float>(mip.height - 1));
+    const int   x0 = static_cast<int>(x);
+    const int   y0 = static_cast<int>(y);
+    const int   x1 = x0 + 1 < mip.width ? x0 + 1 : (repeat ? 0 : x0);
+    const int   y1 = y0 + 1 < mip.height ? y0 + 1 : (repeat ? 0 : y0);
+    const float fx = x - static_cast<float>(x0);
+    const float fy = y - static_cast<float>(y0);
+
+    const uint32_t c00 = mip.fetch(x0, y0);
+    const uint32_t c10 = mip.fetch(x1, y0);
+    const uint32_t c01 = mip.fetch(x0, y1);
+    const uint32_t c11 = mip.fetch(x1, y1);
+
+    float result[4];
+    for (int c = 0; c < 4; ++c) {
+        // alpha is never srgb encoded
+        const float* lut = c == 3 ? getUnormToFloatTable() : table;
+        const int    s   = c * 8;
+        const float  top = lut[(c00 >> s) & 0xff] + (lut[(c10 >> s) & 0xff] - lut[(c00 >> s) & 0xff]) * fx;
+        const float  bot = lut[(c01 >> s) & 0xff] + (lut[(c11 >> s) & 0xff] - lut[(c01 >> s) & 0xff]) * fx;
+        result[c]        = top + (bot - top) * fy;
+    }
+    return XPVec4<float>{ result[0], result[1], result[2], result[3] };
+}
+
+/// @brief trilinear sample at an explicit level of detail
+inline XPVec4<float>
+sampleTextureTrilinear(const XPSWTexture2D& texture, float u, float v, float lod, bool repeat, bool isSRGB)
+{
+    if (texture.mips.empty()) { return XPVec4<float>{ 1.0f, 0.0f, 1.0f, 1.0f }; }
+    const float* table = isSRGB ? getSRGBToLinearTable() : getUnormToFloatTable();
+    lod                  = std::clamp(lod, 0.0f, static_cast<float>(texture.mips.size() - 1));
+    const int     level0 = static_cast<int>(lod);
+    const float   t      = lod - static_cast<float>(level0);
+    XPVec4<float> c0     = sampleTextureMipBilinear(texture.mips[level0], u, v, repeat, table);
+    if (t <= 0.0f) { return c0; }
+    XPVec4<float> c1 = sampleTextureMipBilinear(texture.mips[level0 + 1], u, v, repeat, table);
+    return XPVec4<float>{
+        c0.x + (c1.x - c0.x) * t, c0.y + (c1.y - c0.y) * t, c0.z + (c1.z - c0.z) * t, c0.w + (c1.w - c0.w) * t
+    };
+}
+
+/// @brief bilinear sample of the base level
 template<typename T>
 inline XPVec4<float>
-sampleTextureLinear(const XPSWTexture2D& texture, float u, float v, bool repeat, bool applyGammeCorrect)
+sampleTextureLinear(const XPSWTexture2D& texture, float u, float v, bool repeat, bool isSRGB)
 {
-    // Handle UV wrapping (can be changed to CLAMP or other modes)
+    return sampleTextureTrilinear(texture, u, v, 0.0f, repeat, isSRGB);
+}
+
+inline XPSWQuadColor
+sampleTextureMipBilinearQuad(const XPSWTextureMip& mip,
+                             XPSWFloat4            u,
+                             XPSWFloat4            v,
+                             bool                  repeat,
+                             const float*          table)
+{
+    const XPSWFloat4 zero = XPSWFloat4::broadcast(0.0f);
+    const XPSWFloat4 one  = XPSWFloat4::broadcast(1.0f);
     if (repeat) {
-        u = u - floor(u);
-        v = v - floor(v);
+        u = u - XPSWFloat4::floor(u);
+        v = v - XPSWFloat4::floor(v);
     }
+    u = XPSWFloat4::clamp(u, zero, one);
+    v = XPSWFloat4::clamp(v, zero, one);
+
+    const XPSWFloat4 half = XPSWFloat4::broadcast(0.5f);
+    const XPSWFloat4 x    = XPSWFloat4::clamp(u * XPSWFloat4::broadcast(static_cast<float>(mip.width)) - half,
+                                           zero,
+                                           XPSWFloat4::broadcast(static_cast<float>(mip.width - 1)));
+    const XPSWFloat4 y    = XPSWFloat4::clamp(v * XPSWFloat4::broadcast(static_cast<float>(mip.height)) - half,
+                                           zero,
+                                           XPSWFloat4::broadcast(static_cast<float>(mip.height - 1)));
+    const XPSWFloat4 x0f  = XPSWFloat4::floor(x);
+    const XPSWFloat4 y0f  = XPSWFloat4::floor(y);
+    const XPSWFloat4 fx   = x - x0f;
+    const XPSWFloat4 fy   = y - y0f;
 
-    u = glm::fclamp(u, 0.0f, 1.0f);
-    v = glm::fclamp(v, 0.0f, 1.0f);
-
-    // Convert UV to texture coordinates
-    float x = u * static_cast<float>(texture.width) - 0.5f; // Adjust for pixel centers
-    float y = v * static_cast<float>(texture.height) - 0.5f;
-
-    x = glm::fclamp(x, 0.0f, static_cast<float>(texture.width));
-    y = glm::fclamp(y, 0.0f, static_cast<float>(texture.height));
-
-    // Get integer coordinates of surrounding pixels
-    int x0 = (int)floorf(x);
-    int y0 = (int)floorf(y);
-    int x1 = x0 + 1;
-    int y1 = y0 + 1;
-
-    // Clamp coordinates to texture boundaries
-    x0 = glm::clamp(x0, 0, texture.width - 1);
-    x1 = glm::clamp(x1, 0, texture.width - 1);
-    y0 = glm::clamp(y0, 0, texture.height - 1);
-    y1 = glm::clamp(y1, 0, texture.height - 1);
-
-    // Calculate fractional parts
-    float x_frac = x - static_cast<float>(x0);
-    float y_frac = y - static_cast<float>(y0);
-
-    // Sample four texels
-    const XPVec4<uint8_t>* row0 = texture.u8rgbapixels + y0 * texture.width;
-    const XPVec4<uint8_t>* row1 = texture.u8rgbapixels + y1 * texture.width;
-
-    auto c00 = XPVec4<float>{ static_cast<float>(row0[x0].x) / 255.0f,
-                              static_cast<float>(row0[x0].y) / 255.0f,
-                              static_cast<float>(row0[x0].z) / 255.0f,
-                              static_cast<float>(row0[x0].w) / 255.0f };
-    auto c10 = XPVec4<float>{ static_cast<float>(row0[x1].x) / 255.0f,
-                              static_cast<float>(row0[x1].y) / 255.0f,
-                              static_cast<float>(row0[x1].z) / 255.0f,
-                              static_cast<float>(row0[x1].w) / 255.0f };
-    auto c01 = XPVec4<float>{ static_cast<float>(row1[x0].x) / 255.0f,
-                              static_cast<float>(row1[x0].y) / 255.0f,
-                              static_cast<float>(row1[x0].z) / 255.0f,
-                              static_cast<float>(row1[x0].w) / 255.0f };
-    auto c11 = XPVec4<float>{ static_cast<float>(row1[x1].x) / 255.0f,
-                              static_cast<float>(row1[x1].y) / 255.0f,
-                              static_cast<float>(row1[x1].z) / 255.0f,
-                              static_cast<float>(row1[x1].w) / 255.0f };
-
-    // Bilinear interpolation using macros
-#define LERP(a, b, t) ((a) + ((b) - (a)) * (t))
-    XPVec4<float> result;
-    result.x = LERP(LERP(c00.x, c10.x, x_frac), LERP(c01.x, c11.x, x_frac), y_frac);
-    result.y = LERP(LERP(c00.y, c10.y, x_frac), LERP(c01.y, c11.y, x_frac), y_frac);
-    result.z = LERP(LERP(c00.z, c10.z, x_frac), LERP(c01.z, c11.z, x_frac), y_frac);
-    result.w = LERP(LERP(c00.w, c10.w, x_frac), LERP(c01.w, c11.w, x_frac), y_frac);
-#undef LERP
-
-    if (applyGammeCorrect) {
-        result.x = std::pow(result.x, 1.0f / 2.2f);
-        result.y = std::pow(result.y, 1.0f / 2.2f);
-        result.z = std::pow(result.z, 1.0f / 2.2f);
+    int32_t x0[4], y0[4];
+    x0f.storeInt(x0);
+    y0f.storeInt(y0);
+
+    // gather the 2x2 footprint of every lane, then filter all lanes at once
+    alignas(16) float texels[4][4][4]; // [corner][channel][lane]
+    const float*      alpha = getUnormToFloatTable();
+    for (int lane = 0; lane < 4; ++lane) {
+        const int      x1         = x0[lane] + 1 < mip.width ? x0[lane] + 1 : (repeat ? 0 : x0[lane]);
+        const int      y1         = y0[lane] + 1 < mip.height ? y0[lane] + 1 : (repeat ? 0 : y0[lane]);
+        const uint32_t fetched[4] = {
+            mip.fetch(x0[lane], y0[lane]), mip.fetch(x1, y0[lane]), mip.fetch(x0[lane], y1), mip.fetch(x1, y1)
+        };
+        for (int corner = 0; corner < 4; ++corner) {
+            texels[corner][0][lane] = table[fetched[corner] & 0xff];
+            texels[corner][1][lane] = table[(fetched[corner] >> 8) & 0xff];
+            texels[corner][2][lane] = table[(fetched[corner] >> 16) & 0xff];
+            texels[corner][3][lane] = alpha[fetched[corner] >> 24];
+        }
     }
 
-    return result;
+    XPSWFloat4 result[4];
+    for (int c = 0; c < 4; ++c) {
+        const XPSWFloat4 top = XPSWFloat4::lerp(XPSWFloat4::load(texels[0][c]), XPSWFloat4::load(texels[1][c]), fx);
+        const XPSWFloat4 bot = XPSWFloat4::lerp(XPSWFloat4::load(texels[2][c]), XPSWFloat4::load(texels[3][c]), fx);
+        result[c]            = XPSWFloat4::lerp(top, bot, fy);
+    }
+    return XPSWQuadColor{ result[0], result[1], result[2], result[3] };
+}
+
+/// @brief samples a whole 2x2 quad at once, lanes are ordered top-left, top-right, bottom-left, bottom-right. the
+/// level of detail is shared by the quad and comes from the screen space uv differences between its lanes
+inline XPSWQuadColor
+sampleTextureQuad(const XPSWTexture2D& texture, const XPSWFloat4& u, const XPSWFloat4& v, bool repeat, bool isSRGB)
+{
+    if (texture.mips.empty()) {
+        return XPSWQuadColor{ XPSWFloat4::broadcast(1.0f),
+                              XPSWFloat4::broadcast(0.0f),
+                              XPSWFloat4::broadcast(1.0f),
+                              XPSWFloat4::broadcast(1.0f) };
+    }
+
+    float us[4], vs[4];
+    u.store(us);
+    v.store(vs);
+    const float  lod   = computeTextureLod(texture, us[1] - us[0], vs[1] - vs[0], us[2] - us[0], vs[2] - vs[0]);
+    const float* table = isSRGB ? getSRGBToLinearTable() : getUnormToFloatTable();
+
+    const int     level0 = static_cast<int>(lod);
+    const float   t      = lod - static_cast<float>(level0);
+    XPSWQuadColor c0     = sampleTextureMipBilinearQuad(texture.mips[level0], u, v, repeat, table);
+    if (t <= 0.0f) { return c0; }
+
+    const XPSWQuadColor c1 = sampleTextureMipBilinearQuad(texture.mips[level0 + 1], u, v, repeat, table);
+    const XPSWFloat4    tt = XPSWFloat4::broadcast(t);
+    return XPSWQuadColor{ XPSWFloat4::lerp(c0.r, c1.r, tt),
+                          XPSWFloat4::lerp(c0.g, c1.g, tt),
+                          XPSWFloat4::lerp(c0.b, c1.b, tt),
+                          XPSWFloat4::lerp(c0.a, c1.a, tt) };
 }
 
 inline void
@@ -13,7 +13,9 @@
 /// --------------------------------------------------------------------------------------
 
 #include "XPScript.h"
+#include <Engine/XPEngine.h>
 #include <Engine/XPRegistry.h>
+#include <Engine/XPScriptScheduler.h>
 #include <SceneDescriptor/XPLayer.h>
 #include <SceneDescriptor/XPNode.h>
 #include <SceneDescriptor/XPScene.h>
@@ -23,8 +25,26 @@
 #endif
 #include <Compute/include/Compute/XPCompute.h>
 #include <Emulator/XPEmulatorElfLoader.h>
+#include <Emulator/XPEmulatorLogger.h>
 #include <Emulator/XPEmulatorProcessor.h>
+#include <Emulator/XPEmulatorProfiler.h>
 #include <Utilities/XPFS.h>
+#include <Utilities/XPLogger.h>
+
+static XPScriptScheduler*
+getScheduler(Script* script)
+{
+    return script->owner->getAbsoluteScene()->getRegistry()->getEngine()->getScriptScheduler();
+}
+
+// takes the script off the scheduler, the processor is only safe to free afterwards
+static void
+unschedule(Script* script)
+{
+    if (!script->isRunning.load()) { return; }
+    if (XPScriptScheduler* scheduler = getScheduler(script)) { scheduler->remove(script->owner->getId()); }
+    script->isRunning.store(false);
+}
 
 void
 Script::onChanged_source()
@@ -42,8 +62,11 @@ onTraitAttached(Script* script)
     script->processor = (XPEmulatorProcessor*)malloc(sizeof(XPEmulatorProcessor));
     script->program   = "";
     script->elfLoader = NULL;
+    script->profiler  = NULL;
     script->isLoaded.store(false);
     script->isRunning.store(false);
+    // emulator logs are queued on the engine logger instead of blocking the guest on stdout
+    xp_emulator_logger_set_sink([](const char* text) { XPLogger::instance().logText(XPLoggerSeverityTrace, text); });
 #if defined(XP_EDITOR_MODE)
 // _textEditor->setBreakpoints();
 #endif
@@ -52,12 +75,16 @@ onTraitAttached(Script* script)
 void
 onTraitDettached(Script* script)
 {
-    if (script->executionThread.joinable()) { script->executionThread.join(); }
+    unschedule(script);
     if (script->processor) {
         xp_emulator_processor_finalize(script->processor);
         free(script->processor);
     }
     if (script->elfLoader) { xp_emulator_elf_loader_unload((RiscvElfLoader*)script->elfLoader); }
+    if (script->profiler) {
+        xp_emulator_profiler_finalize((XPEmulatorProfiler*)script->profiler);
+        free(script->profiler);
+    }
 }
 
 void
@@ -73,6 +100,10 @@ onRenderUI(Script* script, XPIUI* ui)
 
                 script->processor = (XPEmulatorProcessor*)malloc(sizeof(XPEmulatorProcessor));
                 xp_emulator_processor_initialize(script->processor);
+                if (script->profiler) {
+                    xp_emulator_profiler_reset((XPEmulatorProfiler*)script->profiler);
+                    script->processor->profiler = (XPEmulatorProfiler*)script->profiler;
+                }
 
                 if (xp_emulator_processor_load_program(script->processor, ((RiscvElfLoader*)script->elfLoader)) == 0) {
                     std::vector<XPUITab*> tabs       = ui->getTabs();
@@ -90,26 +121,18 @@ onRenderUI(Script* script, XPIUI* ui)
     ImGui::SameLine();
     if (ImGui::Button(ICON_FA_PLAY, ImVec2(25.0f, 25.0f))) {
         if (script->isLoaded.load() == true && script->isRunning.load() == false) {
-            std::vector<XPUITab*> tabs          = ui->getTabs();
-            XPTextEditorUITab*    textEditorTab = static_cast<XPTextEditorUITab*>(tabs[XPUiViewMaskTextEditorBit]);
-            XPTextEditor*         textEditor    = textEditorTab->getTextEditor();
-
-            script->isRunning.store(true);
-            script->executionThread = std::thread([&]() {
-                const std::string fullProgramPath = XPFS::buildRiscvBianryAssetsPath(script->program);
-                xp_emulator_processor_run(script->processor);
     #if defined(XP_USE_COMPUTE)
-                xp_compute_load_and_run(fullProgramPath.c_str());
+            const std::string fullProgramPath = XPFS::buildRiscvBianryAssetsPath(script->program);
+            xp_compute_load_and_run(fullProgramPath.c_str());
     #endif
-                script->isRunning.store(false);
-            });
-            script->executionThread.join();
+            getScheduler(script)->add(script->owner->getId(), script->processor);
+            script->isRunning.store(true);
         }
     }
     ImGui::SameLine();
     if (ImGui::Button(ICON_FA_STOP, ImVec2(25.0f, 25.0f))) {
         if (script->isLoaded.load() == true) {
-            if (script->executionThread.joinable()) { script->executionThread.join(); }
+            unschedule(script);
             if (script->processor) {
                 xp_emulator_processor_finalize(script->processor);
                 free(script->processor);
@@ -119,5 +142,21 @@ onRenderUI(Script* script, XPIUI* ui)
             script->isRunning.store(false);
         }
     }
+    if (script->isRunning.load()) {
+        if (const XPScriptStats* stats = getScheduler(script)->getStats(script->owner->getId())) {
+            ImGui::Text("%u instr/frame, %.3f ms/frame, %llu yields",
+                        stats->lastFrameInstructions,
+                        static_cast<double>(stats->lastFrameNanoseconds) / 1e6,
+                        static_cast<unsigned long long>(stats->yields));
+            if (stats->finished) {
+                XP_LOGV(XPLoggerSeverityInfo,
+                        "Script %s stopped with %i after %llu instructions",
+                        script->program.c_str(),
+                        stats->exitCode,
+                        static_cast<unsigned long long>(stats->totalInstructions));
+                unschedule(script);
+            }
+        }
+    }
 #endif
 }
\ No newline at end of file
@@ -20,7 +20,6 @@
 
 #include <atomic>
 #include <string>
-#include <thread>
 
 class XPNode;
 class XPIUI;
@@ -40,10 +39,10 @@ struct XPAttachStruct Script
     XPEmulatorProcessor* processor;
     XPAttachField std::string program;
     void*                     elfLoader;
+    void*                     profiler; // XPEmulatorProfiler, only while sampling from the emulator tab
     // XPAttachField std::string debug_info;
     std::atomic<bool> isLoaded;
-    std::atomic<bool> isRunning;
-    std::thread       executionThread;
+    std::atomic<bool> isRunning; // scheduled on the engine XPScriptScheduler, ticked once per frame
 };
 
 void
@@ -0,0 +1,418 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <SceneDescriptor/XPAttachmentJson.h>
+
+#include <Utilities/XPMacros.h>
+
+#include <array>
+#include <limits>
+
+template<typename T>
+static bool
+readNumber(const nlohmann::json& j, T& value)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        if (!j.is_number()) { return false; }
+        value = j.get<T>();
+        return true;
+    } else if constexpr (std::is_signed_v<T>) {
+        if (!j.is_number_integer()) { return false; }
+        const int64_t raw = j.get<int64_t>();
+        if (raw < std::numeric_limits<T>::min() || raw > std::numeric_limits<T>::max()) { return false; }
+        value = static_cast<T>(raw);
+        return true;
+    } else {
+        if (!j.is_number_unsigned()) { return false; }
+        const uint64_t raw = j.get<uint64_t>();
+        if (raw > std::numeric_limits<T>::max()) { return false; }
+        value = static_cast<T>(raw);
+        return true;
+    }
+}
+
+template<typename T, size_t N>
+static void
+writeArray(nlohmann::json& j, const std::array<T, N>& values)
+{
+    j = nlohmann::json::array();
+    for (const T& value : values) { j.push_back(value); }
+}
+
+// all or nothing, a partially converted array does not touch the field
+template<typename T, size_t N>
+static bool
+readArray(const nlohmann::json& j, std::array<T, N>& values)
+{
+    if (!j.is_array() || j.size() != N) { return false; }
+    std::array<T, N> converted = values;
+    for (size_t i = 0; i < N; ++i) {
+        if (!readNumber(j[i], converted[i])) { return false; }
+    }
+    values = converted;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// WRITE
+// ---------------------------------------------------------------------------------------------------------------------
+void
+XPAttachmentJson::write(nlohmann::json& j, bool value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, int8_t value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, int16_t value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, int32_t value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, int64_t value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, uint8_t value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, uint16_t value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, uint32_t value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, uint64_t value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, float value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, double value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const std::string& value)
+{
+    j = value;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const XPVec2<int>& value)
+{
+    writeArray(j, value.arr);
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const XPVec2<float>& value)
+{
+    writeArray(j, value.arr);
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const XPVec3<float>& value)
+{
+    writeArray(j, value.arr);
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const XPVec4<float>& value)
+{
+    writeArray(j, value.arr);
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const XPMat3<float>& value)
+{
+    writeArray(j, value.arr);
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const XPMat4<float>& value)
+{
+    writeArray(j, value.arr);
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const std::list<XPLogicSource>& value)
+{
+    // sources point at logic owned by the data pipeline, only how many are attached means anything outside
+    j = value.size();
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const std::vector<XPMeshRendererInfo>& value)
+{
+    j = nlohmann::json::array();
+    for (const XPMeshRendererInfo& info : value) {
+        nlohmann::json& item = j.emplace_back(nlohmann::json::object());
+        write(item["meshBufferObjectIndex"], info.meshBufferObjectIndex);
+        write(item["mesh"], info.mesh);
+        write(item["material"], info.material);
+        write(item["polygonMode"], info.polygonMode);
+    }
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const std::vector<XPColliderInfo>& value)
+{
+    j = nlohmann::json::array();
+    for (const XPColliderInfo& info : value) {
+        nlohmann::json& item = j.emplace_back(nlohmann::json::object());
+        write(item["meshBufferObjectIndex"], info.meshBufferObjectIndex);
+        write(item["shapeName"], info.shapeName);
+        write(item["shape"], info.shape);
+    }
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const XPColliderRefString& value)
+{
+    j = value.text;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const XPMeshRefString& value)
+{
+    j = value.text;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const XPMaterialRefString& value)
+{
+    j = value.text;
+}
+
+void
+XPAttachmentJson::write(nlohmann::json& j, const CameraProperties& value)
+{
+    j = nlohmann::json::object();
+    write(j["fov"], value.fov);
+    write(j["znear"], value.znear);
+    write(j["zfar"], value.zfar);
+    write(j["location"], value.location);
+    write(j["euler"], value.euler);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// READ
+// ---------------------------------------------------------------------------------------------------------------------
+bool
+XPAttachmentJson::read(const nlohmann::json& j, bool& value)
+{
+    if (!j.is_boolean()) { return false; }
+    value = j.get<bool>();
+    return true;
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, int8_t& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, int16_t& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, int32_t& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, int64_t& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, uint8_t& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, uint16_t& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, uint32_t& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, uint64_t& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, float& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, double& value)
+{
+    return readNumber(j, value);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, std::string& value)
+{
+    if (!j.is_string()) { return false; }
+    value = j.get<std::string>();
+    return true;
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, XPVec2<int>& value)
+{
+    return readArray(j, value.arr);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, XPVec2<float>& value)
+{
+    return readArray(j, value.arr);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, XPVec3<float>& value)
+{
+    return readArray(j, value.arr);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, XPVec4<float>& value)
+{
+    return readArray(j, value.arr);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, XPMat3<float>& value)
+{
+    return readArray(j, value.arr);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, XPMat4<float>& value)
+{
+    return readArray(j, value.arr);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, std::list<XPLogicSource>& value)
+{
+    XP_UNUSED(j)
+    XP_UNUSED(value)
+    return false;
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, std::vector<XPMeshRendererInfo>& value)
+{
+    XP_UNUSED(j)
+    XP_UNUSED(value)
+    return false;
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, std::vector<XPColliderInfo>& value)
+{
+    XP_UNUSED(j)
+    XP_UNUSED(value)
+    return false;
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, XPColliderRefString& value)
+{
+    return read(j, value.text);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, XPMeshRefString& value)
+{
+    return read(j, value.text);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, XPMaterialRefString& value)
+{
+    return read(j, value.text);
+}
+
+bool
+XPAttachmentJson::read(const nlohmann::json& j, CameraProperties& value)
+{
+    if (!j.is_object()) { return false; }
+    CameraProperties converted = value;
+    for (const auto& [key, field] : j.items()) {
+        bool isConverted = false;
+        if (key == "fov") {
+            isConverted = read(field, converted.fov);
+        } else if (key == "znear") {
+            isConverted = read(field, converted.znear);
+        } else if (key == "zfar") {
+            isConverted = read(field, converted.zfar);
+        } else if (key == "location") {
+            isConverted = read(field, converted.location);
+        } else if (key == "euler") {
+            isConverted = read(field, converted.euler);
+        }
+        if (!isConverted) { return false; }
+    }
+    value = converted;
+    return true;
+}
@@ -0,0 +1,116 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#include <SceneDescriptor/Attachments/XPCollider.h>
+#include <SceneDescriptor/Attachments/XPFreeCamera.h>
+#include <SceneDescriptor/Attachments/XPLogic.h>
+#include <SceneDescriptor/Attachments/XPMeshRenderer.h>
+#include <Utilities/XPMaths.h>
+
+#include <list>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifdef __clang__
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wall"
+#endif
+#include <nlohmann/json.hpp>
+#ifdef __clang__
+    #pragma clang diagnostic pop
+#endif
+
+/// @brief Converts single attachment fields to and from json, the generated XPNode calls one overload per field the
+/// same way XPSceneSnapshotWriter is driven. Vectors and matrices are flat arrays, the mesh and collider lists are
+/// written with their references only and cannot be assigned since their runtime handles are resolved on load.
+class XPAttachmentJson final
+{
+  public:
+    XPAttachmentJson()  = delete;
+    ~XPAttachmentJson() = delete;
+
+    static void write(nlohmann::json& j, bool value);
+    static void write(nlohmann::json& j, int8_t value);
+    static void write(nlohmann::json& j, int16_t value);
+    static void write(nlohmann::json& j, int32_t value);
+    static void write(nlohmann::json& j, int64_t value);
+    static void write(nlohmann::json& j, uint8_t value);
+    static void write(nlohmann::json& j, uint16_t value);
+    static void write(nlohmann::json& j, uint32_t value);
+    static void write(nlohmann::json& j, uint64_t value);
+    static void write(nlohmann::json& j, float value);
+    static void write(nlohmann::json& j, double value);
+    static void write(nlohmann::json& j, const std::string& value);
+    static void write(nlohmann::json& j, const XPVec2<int>& value);
+    static void write(nlohmann::json& j, const XPVec2<float>& value);
+    static void write(nlohmann::json& j, const XPVec3<float>& value);
+    static void write(nlohmann::json& j, const XPVec4<float>& value);
+    static void write(nlohmann::json& j, const XPMat3<float>& value);
+    static void write(nlohmann::json& j, const XPMat4<float>& value);
+    static void write(nlohmann::json& j, const std::list<XPLogicSource>& value);
+    static void write(nlohmann::json& j, const std::vector<XPMeshRendererInfo>& value);
+    static void write(nlohmann::json& j, const std::vector<XPColliderInfo>& value);
+    static void write(nlohmann::json& j, const XPColliderRefString& value);
+    static void write(nlohmann::json& j, const XPMeshRefString& value);
+    static void write(nlohmann::json& j, const XPMaterialRefString& value);
+    static void write(nlohmann::json& j, const CameraProperties& value);
+    template<typename E>
+        requires std::is_enum_v<E>
+    static void write(nlohmann::json& j, E value)
+    {
+        j = static_cast<uint32_t>(value);
+    }
+
+    // every read leaves the field untouched and returns false when the json does not convert
+    [[nodiscard]] static bool read(const nlohmann::json& j, bool& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, int8_t& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, int16_t& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, int32_t& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, int64_t& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, uint8_t& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, uint16_t& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, uint32_t& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, uint64_t& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, float& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, double& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, std::string& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, XPVec2<int>& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, XPVec2<float>& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, XPVec3<float>& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, XPVec4<float>& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, XPMat3<float>& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, XPMat4<float>& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, std::list<XPLogicSource>& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, std::vector<XPMeshRendererInfo>& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, std::vector<XPColliderInfo>& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, XPColliderRefString& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, XPMeshRefString& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, XPMaterialRefString& value);
+    [[nodiscard]] static bool read(const nlohmann::json& j, CameraProperties& value);
+    template<typename E>
+        requires std::is_enum_v<E>
+    [[nodiscard]] static bool read(const nlohmann::json& j, E& value)
+    {
+        uint32_t raw = static_cast<uint32_t>(value);
+        if (!read(j, raw)) { return false; }
+        value = static_cast<E>(raw);
+        return true;
+    }
+};
@@ -44,6 +44,7 @@ class XPNode;
 class XPLayer
 {
     XP_MPL_MEMORY_POOL(XPLayer)
+    friend class XPSceneStore;
 
   public:
     // returns the name of the layer
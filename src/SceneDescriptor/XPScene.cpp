@@ -28,6 +28,7 @@ XPScene::XPScene(XPRegistry* const       registry,
   , _name(std::move(name))
   , _id(id)
   , _interaction(XPEInteractionHasRenderingChanges)
+  , _hierarchyVersion(0)
   , _sceneDescriptorStore(sceneDescriptorStore)
   , _sceneStore(XP_NEW XPSceneStore(this))
 {
@@ -262,6 +263,12 @@ XPScene::hasOnlyAttachmentChanges(uint32_t changesFlags) const
     return _interaction.is(changesFlags);
 }
 
+uint64_t
+XPScene::getHierarchyVersion() const
+{
+    return _hierarchyVersion;
+}
+
 void
 XPScene::to_json(nlohmann::json& j, const XPScene& scene)
 {
@@ -283,19 +290,20 @@ XPScene::onLayerCreated(XPLayer* layer)
 {
     XP_UNUSED(layer)
 
-    // nothing to do here for now ..
+    ++_hierarchyVersion;
 }
 
 void
 XPScene::onLayerDestroyed(XPLayer* layer)
 {
-    // nothing to do here for now ..
     layer->destroyAllNodes();
+    ++_hierarchyVersion;
 }
 
 void
 XPScene::onNodeCreated(XPNode* node)
 {
+    ++_hierarchyVersion;
     for (auto& filter : _filters) { filter.second.onAddNode(node); }
 }
 
@@ -304,6 +312,7 @@ XPScene::onNodeDestroyed(XPNode* node)
 {
     node->destroyAllNodes();
     for (auto& filter : _filters) { filter.second.onRemoveNode(node); }
+    ++_hierarchyVersion;
 }
 
 void
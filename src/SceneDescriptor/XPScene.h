@@ -123,6 +123,10 @@ class XPScene
     // returns true if only the given changes exist
     [[nodiscard]] bool hasOnlyAttachmentChanges(uint32_t changesFlags) const;
 
+    // returns a counter bumped whenever a layer or a node is created or destroyed, views caching the hierarchy compare
+    // it against the value they were built with
+    [[nodiscard]] uint64_t getHierarchyVersion() const;
+
     // [serialize] fills a json object representing the scene
     static void to_json(nlohmann::json& j, const XPScene& scene);
 
@@ -181,6 +185,9 @@ class XPScene
     // embeds interactive information about the layer
     XPBitFlag<uint32_t> _interaction;
 
+    // bumped by the layer and node notifications
+    uint64_t _hierarchyVersion;
+
     // main store
     XPSceneDescriptorStore* _sceneDescriptorStore;
 
@@ -0,0 +1,784 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <SceneDescriptor/XPSceneSnapshot.h>
+
+#include <Utilities/XPFS.h>
+#include <Utilities/XPHash.h>
+#include <Utilities/XPLogger.h>
+#include <Utilities/XPMacros.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string.h>
+
+static size_t
+alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+template<typename T>
+static bool
+getSection(std::span<const uint8_t> body, uint64_t offset, uint64_t count, std::span<const T>& section)
+{
+    if (offset % alignof(T) != 0 || offset > body.size() || count > (body.size() - offset) / sizeof(T)) {
+        return false;
+    }
+    section = std::span<const T>(reinterpret_cast<const T*>(body.data() + offset), static_cast<size_t>(count));
+    return true;
+}
+
+template<typename T>
+static void
+putSection(std::vector<uint8_t>& body, size_t offset, const std::vector<T>& section)
+{
+    if (!section.empty()) { memcpy(body.data() + offset, section.data(), section.size() * sizeof(T)); }
+}
+
+static bool
+writeFileAtomically(const std::string& path, const void* header, size_t headerSize, const std::vector<uint8_t>& body)
+{
+    // write next to the final path then rename, readers never observe a partially written file
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open()) { return false; }
+        stream.write(reinterpret_cast<const char*>(header), static_cast<std::streamsize>(headerSize));
+        stream.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+        if (!stream.good()) { return false; }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    return !ec;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// WRITER
+// ---------------------------------------------------------------------------------------------------------------------
+uint32_t
+XPSceneSnapshotWriter::addString(std::string_view text)
+{
+    auto it = _stringTable.find(std::string(text));
+    if (it != _stringTable.end()) { return it->second; }
+    const uint32_t index = static_cast<uint32_t>(_stringOffsets.size() - 1);
+    _stringBytes.insert(_stringBytes.end(), text.begin(), text.end());
+    _stringOffsets.push_back(static_cast<uint32_t>(_stringBytes.size()));
+    _stringTable.emplace(std::string(text), index);
+    return index;
+}
+
+uint32_t
+XPSceneSnapshotWriter::addLayer(std::string_view name)
+{
+    _layers.push_back({ addString(name) });
+    return static_cast<uint32_t>(_layers.size() - 1);
+}
+
+void
+XPSceneSnapshotWriter::beginNode(uint32_t         id,
+                                 uint32_t         parentId,
+                                 uint32_t         layer,
+                                 std::string_view name,
+                                 uint32_t         interaction)
+{
+    XPSceneSnapshotNode node  = {};
+    node.id                   = id;
+    node.parentId             = parentId;
+    node.layer                = layer;
+    node.name                 = addString(name);
+    node.interaction          = interaction;
+    node.attachmentDescriptor = 0;
+    node.firstAttachment      = static_cast<uint32_t>(_attachments.size());
+    node.numAttachments       = 0;
+    _nodes.push_back(node);
+}
+
+void
+XPSceneSnapshotWriter::beginAttachment(uint32_t descriptor)
+{
+    _nodes.back().attachmentDescriptor |= descriptor;
+    ++_nodes.back().numAttachments;
+    _attachments.push_back({ descriptor, 0, _payload.size(), 0 });
+}
+
+void
+XPSceneSnapshotWriter::endAttachment()
+{
+    _attachments.back().size = _payload.size() - _attachments.back().offset;
+}
+
+void
+XPSceneSnapshotWriter::removeNode(uint32_t id)
+{
+    _removedNodes.push_back(id);
+}
+
+void
+XPSceneSnapshotWriter::removeLayer(std::string_view name)
+{
+    _removedLayers.push_back(addString(name));
+}
+
+void
+XPSceneSnapshotWriter::clear()
+{
+    _stringTable.clear();
+    _stringOffsets = { 0 };
+    _stringBytes.clear();
+    _layers.clear();
+    _nodes.clear();
+    _attachments.clear();
+    _removedNodes.clear();
+    _removedLayers.clear();
+    _payload.clear();
+}
+
+size_t
+XPSceneSnapshotWriter::getNumNodes() const
+{
+    return _nodes.size();
+}
+
+bool
+XPSceneSnapshotWriter::isEmpty() const
+{
+    return _layers.empty() && _nodes.empty() && _removedNodes.empty() && _removedLayers.empty();
+}
+
+void
+XPSceneSnapshotWriter::finish(std::vector<uint8_t>& body) const
+{
+    XPSceneSnapshotBody header = {};
+    header.numStrings          = static_cast<uint32_t>(_stringOffsets.size() - 1);
+    header.numLayers           = static_cast<uint32_t>(_layers.size());
+    header.numNodes            = static_cast<uint32_t>(_nodes.size());
+    header.numAttachments      = static_cast<uint32_t>(_attachments.size());
+    header.numRemovedNodes     = static_cast<uint32_t>(_removedNodes.size());
+    header.numRemovedLayers    = static_cast<uint32_t>(_removedLayers.size());
+
+    size_t offset  = alignUp(sizeof(header), XPSceneSnapshotAlignment);
+    auto   section = [&offset](size_t size) {
+        const size_t sectionOffset = offset;
+        offset                     = alignUp(offset + size, XPSceneSnapshotAlignment);
+        return sectionOffset;
+    };
+    header.stringOffsetsOffset = section(_stringOffsets.size() * sizeof(uint32_t));
+    header.stringBytesOffset   = section(_stringBytes.size());
+    header.stringBytesSize     = _stringBytes.size();
+    header.layersOffset        = section(_layers.size() * sizeof(XPSceneSnapshotLayer));
+    header.nodesOffset         = section(_nodes.size() * sizeof(XPSceneSnapshotNode));
+    header.attachmentsOffset   = section(_attachments.size() * sizeof(XPSceneSnapshotAttachment));
+    header.removedNodesOffset  = section(_removedNodes.size() * sizeof(uint32_t));
+    header.removedLayersOffset = section(_removedLayers.size() * sizeof(uint32_t));
+    header.payloadOffset       = section(_payload.size());
+    header.payloadSize         = _payload.size();
+
+    body.assign(offset, 0);
+    memcpy(body.data(), &header, sizeof(header));
+    putSection(body, header.stringOffsetsOffset, _stringOffsets);
+    putSection(body, header.stringBytesOffset, _stringBytes);
+    putSection(body, header.layersOffset, _layers);
+    putSection(body, header.nodesOffset, _nodes);
+    putSection(body, header.attachmentsOffset, _attachments);
+    putSection(body, header.removedNodesOffset, _removedNodes);
+    putSection(body, header.removedLayersOffset, _removedLayers);
+    putSection(body, header.payloadOffset, _payload);
+}
+
+void
+XPSceneSnapshotWriter::writeBytes(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    _payload.insert(_payload.end(), bytes, bytes + size);
+}
+
+void
+XPSceneSnapshotWriter::write(bool value)
+{
+    write(static_cast<uint8_t>(value ? 1 : 0));
+}
+
+void
+XPSceneSnapshotWriter::write(int8_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(int16_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(int32_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(int64_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(uint8_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(uint16_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(uint32_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(uint64_t value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(float value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(double value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(const std::string& value)
+{
+    write(addString(value));
+}
+
+void
+XPSceneSnapshotWriter::write(const XPVec2<int>& value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(const XPVec2<float>& value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(const XPVec3<float>& value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(const XPVec4<float>& value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(const XPMat3<float>& value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(const XPMat4<float>& value)
+{
+    writeBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotWriter::write(const std::list<XPLogicSource>& value)
+{
+    // sources point at logic owned by the data pipeline, they are attached again when the logic is loaded
+    XP_UNUSED(value)
+}
+
+void
+XPSceneSnapshotWriter::write(const std::vector<XPMeshRendererInfo>& value)
+{
+    // the mesh buffer is resolved by name, only the references survive the snapshot
+    write(static_cast<uint32_t>(value.size()));
+    for (const XPMeshRendererInfo& info : value) {
+        write(info.meshBufferObjectIndex);
+        write(info.mesh);
+        write(info.material);
+        write(info.polygonMode);
+    }
+}
+
+void
+XPSceneSnapshotWriter::write(const std::vector<XPColliderInfo>& value)
+{
+    write(static_cast<uint32_t>(value.size()));
+    for (const XPColliderInfo& info : value) {
+        write(info.meshBufferObjectIndex);
+        write(info.shapeName);
+        writeBytes(&info.parameters, sizeof(info.parameters));
+        write(info.shape);
+    }
+}
+
+void
+XPSceneSnapshotWriter::write(const XPColliderRefString& value)
+{
+    write(value.text);
+}
+
+void
+XPSceneSnapshotWriter::write(const XPMeshRefString& value)
+{
+    write(value.text);
+}
+
+void
+XPSceneSnapshotWriter::write(const XPMaterialRefString& value)
+{
+    write(value.text);
+}
+
+void
+XPSceneSnapshotWriter::write(const CameraProperties& value)
+{
+    write(value.fov);
+    write(value.znear);
+    write(value.zfar);
+    write(value.location);
+    write(value.euler);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// READER
+// ---------------------------------------------------------------------------------------------------------------------
+bool
+XPSceneSnapshotReader::open(std::span<const uint8_t> body)
+{
+    *this = XPSceneSnapshotReader();
+    if (body.size() < sizeof(XPSceneSnapshotBody) ||
+        reinterpret_cast<uintptr_t>(body.data()) % XPSceneSnapshotAlignment != 0) {
+        return false;
+    }
+    XPSceneSnapshotBody header = {};
+    memcpy(&header, body.data(), sizeof(header));
+    if (!getSection(body, header.stringOffsetsOffset, uint64_t(header.numStrings) + 1, _stringOffsets) ||
+        !getSection(body, header.stringBytesOffset, header.stringBytesSize, _stringBytes) ||
+        !getSection(body, header.layersOffset, header.numLayers, _layers) ||
+        !getSection(body, header.nodesOffset, header.numNodes, _nodes) ||
+        !getSection(body, header.attachmentsOffset, header.numAttachments, _attachments) ||
+        !getSection(body, header.removedNodesOffset, header.numRemovedNodes, _removedNodes) ||
+        !getSection(body, header.removedLayersOffset, header.numRemovedLayers, _removedLayers) ||
+        !getSection(body, header.payloadOffset, header.payloadSize, _payload)) {
+        *this = XPSceneSnapshotReader();
+        return false;
+    }
+    _body = body;
+    return true;
+}
+
+std::string_view
+XPSceneSnapshotReader::getString(uint32_t index) const
+{
+    if (index + 1 >= _stringOffsets.size()) { return {}; }
+    const uint32_t first = _stringOffsets[index];
+    const uint32_t last  = _stringOffsets[index + 1];
+    if (first > last || last > _stringBytes.size()) { return {}; }
+    return std::string_view(_stringBytes.data() + first, last - first);
+}
+
+std::span<const XPSceneSnapshotLayer>
+XPSceneSnapshotReader::getLayers() const
+{
+    return _layers;
+}
+
+std::span<const XPSceneSnapshotNode>
+XPSceneSnapshotReader::getNodes() const
+{
+    return _nodes;
+}
+
+std::span<const XPSceneSnapshotAttachment>
+XPSceneSnapshotReader::getAttachments(const XPSceneSnapshotNode& node) const
+{
+    if (node.firstAttachment > _attachments.size() ||
+        node.numAttachments > _attachments.size() - node.firstAttachment) {
+        return {};
+    }
+    return _attachments.subspan(node.firstAttachment, node.numAttachments);
+}
+
+std::span<const uint32_t>
+XPSceneSnapshotReader::getRemovedNodes() const
+{
+    return _removedNodes;
+}
+
+std::span<const uint32_t>
+XPSceneSnapshotReader::getRemovedLayers() const
+{
+    return _removedLayers;
+}
+
+void
+XPSceneSnapshotReader::beginAttachment(const XPSceneSnapshotAttachment& attachment)
+{
+    _overrun = attachment.offset > _payload.size() || attachment.size > _payload.size() - attachment.offset;
+    _cursor  = _overrun ? std::span<const uint8_t>() : _payload.subspan(attachment.offset, attachment.size);
+}
+
+bool
+XPSceneSnapshotReader::endAttachment()
+{
+    // leftover bytes mean the fields of the attachment changed without bumping the version
+    const bool consumed = !_overrun && _cursor.empty();
+    _cursor             = {};
+    _overrun            = false;
+    return consumed;
+}
+
+bool
+XPSceneSnapshotReader::readBytes(void* data, size_t size)
+{
+    if (_overrun || size > _cursor.size()) {
+        _overrun = true;
+        return false;
+    }
+    memcpy(data, _cursor.data(), size);
+    _cursor = _cursor.subspan(size);
+    return true;
+}
+
+void
+XPSceneSnapshotReader::read(bool& value)
+{
+    uint8_t raw = 0;
+    if (readBytes(&raw, sizeof(raw))) { value = raw != 0; }
+}
+
+void
+XPSceneSnapshotReader::read(int8_t& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(int16_t& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(int32_t& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(int64_t& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(uint8_t& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(uint16_t& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(uint32_t& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(uint64_t& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(float& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(double& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(std::string& value)
+{
+    uint32_t index = 0;
+    if (readBytes(&index, sizeof(index))) { value = getString(index); }
+}
+
+void
+XPSceneSnapshotReader::read(XPVec2<int>& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(XPVec2<float>& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(XPVec3<float>& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(XPVec4<float>& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(XPMat3<float>& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(XPMat4<float>& value)
+{
+    readBytes(&value, sizeof(value));
+}
+
+void
+XPSceneSnapshotReader::read(std::list<XPLogicSource>& value)
+{
+    XP_UNUSED(value)
+}
+
+void
+XPSceneSnapshotReader::read(std::vector<XPMeshRendererInfo>& value)
+{
+    uint32_t count = 0;
+    read(count);
+    // every entry takes at least 16 bytes, a larger count comes from a damaged payload
+    if (count > _cursor.size() / 16) {
+        _overrun = true;
+        return;
+    }
+    value.assign(count, XPMeshRendererInfo{});
+    for (XPMeshRendererInfo& info : value) {
+        info.meshBuffer = nullptr;
+        read(info.meshBufferObjectIndex);
+        read(info.mesh);
+        read(info.material);
+        read(info.polygonMode);
+    }
+}
+
+void
+XPSceneSnapshotReader::read(std::vector<XPColliderInfo>& value)
+{
+    uint32_t count = 0;
+    read(count);
+    // every entry takes at least 24 bytes, a larger count comes from a damaged payload
+    if (count > _cursor.size() / 24) {
+        _overrun = true;
+        return;
+    }
+    value.assign(count, XPColliderInfo{});
+    for (XPColliderInfo& info : value) {
+        info.owner      = nullptr;
+        info.meshBuffer = nullptr;
+        info.shapeRef   = nullptr;
+        read(info.meshBufferObjectIndex);
+        read(info.shapeName);
+        readBytes(&info.parameters, sizeof(info.parameters));
+        read(info.shape);
+    }
+}
+
+void
+XPSceneSnapshotReader::read(XPColliderRefString& value)
+{
+    read(value.text);
+    value.inputBuffer = value.text;
+}
+
+void
+XPSceneSnapshotReader::read(XPMeshRefString& value)
+{
+    read(value.text);
+    value.inputBuffer = value.text;
+}
+
+void
+XPSceneSnapshotReader::read(XPMaterialRefString& value)
+{
+    read(value.text);
+    value.inputBuffer = value.text;
+}
+
+void
+XPSceneSnapshotReader::read(CameraProperties& value)
+{
+    read(value.fov);
+    read(value.znear);
+    read(value.zfar);
+    read(value.location);
+    read(value.euler);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FILE
+// ---------------------------------------------------------------------------------------------------------------------
+bool
+XPSceneSnapshotFile::save(const std::string& path, const std::vector<uint8_t>& body)
+{
+    XPSceneSnapshotHeader header = {};
+    memcpy(header.magic, XPSceneSnapshotMagic, sizeof(header.magic));
+    header.version  = XPSceneSnapshotVersion;
+    header.key      = XPHash::xxh64(body.data(), body.size());
+    header.bodySize = body.size();
+    if (!writeFileAtomically(path, &header, sizeof(header), body)) {
+        XP_LOGV(XPLoggerSeverityWarning, "Failed to write scene snapshot %s", path.c_str());
+        return false;
+    }
+
+    // the deltas of the previous snapshot are folded into this one, the journal starts over
+    XPSceneSnapshotJournalHeader journalHeader = {};
+    memcpy(journalHeader.magic, XPSceneSnapshotJournalMagic, sizeof(journalHeader.magic));
+    journalHeader.version = XPSceneSnapshotVersion;
+    journalHeader.key     = header.key;
+    const std::string journalPath = path + XPSceneSnapshotJournalSuffix;
+    if (!writeFileAtomically(journalPath, &journalHeader, sizeof(journalHeader), {})) {
+        XP_LOGV(XPLoggerSeverityWarning, "Failed to write scene journal %s", journalPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool
+XPSceneSnapshotFile::append(const std::string& path, const std::vector<uint8_t>& body)
+{
+    const std::string journalPath = path + XPSceneSnapshotJournalSuffix;
+    if (!XPFS::isFile(path.c_str()) || !XPFS::isFile(journalPath.c_str())) {
+        XP_LOGV(XPLoggerSeverityWarning, "Cannot append to scene journal %s without a snapshot", journalPath.c_str());
+        return false;
+    }
+
+    XPSceneSnapshotJournalBlock block = {};
+    block.bodySize                    = body.size();
+    block.checksum                    = XPHash::xxh64(body.data(), body.size());
+    std::ofstream stream(journalPath, std::ios::binary | std::ios::app);
+    if (!stream.is_open()) {
+        XP_LOGV(XPLoggerSeverityWarning, "Failed to open scene journal %s", journalPath.c_str());
+        return false;
+    }
+    stream.write(reinterpret_cast<const char*>(&block), sizeof(block));
+    stream.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+    stream.flush();
+    if (!stream.good()) {
+        XP_LOGV(XPLoggerSeverityWarning, "Failed to append to scene journal %s", journalPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool
+XPSceneSnapshotFile::open(const std::string& path)
+{
+    _bodies.clear();
+    _journal.close();
+    _isJournalTorn = false;
+    if (!_snapshot.open(path) || _snapshot.getSize() < sizeof(XPSceneSnapshotHeader)) { return false; }
+
+    XPSceneSnapshotHeader header = {};
+    memcpy(&header, _snapshot.getData(), sizeof(header));
+    if (memcmp(header.magic, XPSceneSnapshotMagic, sizeof(header.magic)) != 0 ||
+        header.version != XPSceneSnapshotVersion || header.bodySize > _snapshot.getSize() - sizeof(header)) {
+        XP_LOGV(XPLoggerSeverityWarning, "Ignoring invalid scene snapshot %s", path.c_str());
+        return false;
+    }
+    const std::span<const uint8_t> body = _snapshot.getBytes().subspan(sizeof(header), header.bodySize);
+    if (XPHash::xxh64(body.data(), body.size()) != header.key) {
+        XP_LOGV(XPLoggerSeverityWarning, "Ignoring damaged scene snapshot %s", path.c_str());
+        return false;
+    }
+    _bodies.push_back(body);
+
+    // a missing or foreign journal only means there were no autosaves since the snapshot was written
+    const std::string journalPath = path + XPSceneSnapshotJournalSuffix;
+    if (!XPFS::isFile(journalPath.c_str()) || !_journal.open(journalPath) ||
+        _journal.getSize() < sizeof(XPSceneSnapshotJournalHeader)) {
+        return true;
+    }
+    XPSceneSnapshotJournalHeader journalHeader = {};
+    memcpy(&journalHeader, _journal.getData(), sizeof(journalHeader));
+    if (memcmp(journalHeader.magic, XPSceneSnapshotJournalMagic, sizeof(journalHeader.magic)) != 0 ||
+        journalHeader.version != XPSceneSnapshotVersion || journalHeader.key != header.key) {
+        XP_LOGV(XPLoggerSeverityWarning, "Ignoring scene journal %s of another snapshot", journalPath.c_str());
+        return true;
+    }
+    size_t offset = sizeof(journalHeader);
+    while (offset + sizeof(XPSceneSnapshotJournalBlock) <= _journal.getSize()) {
+        XPSceneSnapshotJournalBlock block = {};
+        memcpy(&block, _journal.getData() + offset, sizeof(block));
+        offset += sizeof(block);
+        if (block.bodySize > _journal.getSize() - offset) { break; }
+        const std::span<const uint8_t> delta = _journal.getBytes().subspan(offset, block.bodySize);
+        if (XPHash::xxh64(delta.data(), delta.size()) != block.checksum) { break; }
+        _bodies.push_back(delta);
+        offset += block.bodySize;
+    }
+    if (offset != _journal.getSize()) {
+        _isJournalTorn = true;
+        XP_LOGV(XPLoggerSeverityWarning, "Dropping the torn tail of scene journal %s", journalPath.c_str());
+    }
+    return true;
+}
+
+const std::vector<std::span<const uint8_t>>&
+XPSceneSnapshotFile::getBodies() const
+{
+    return _bodies;
+}
+
+bool
+XPSceneSnapshotFile::isJournalTorn() const
+{
+    return _isJournalTorn;
+}
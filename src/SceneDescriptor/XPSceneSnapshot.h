@@ -0,0 +1,279 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#include <SceneDescriptor/Attachments/XPCollider.h>
+#include <SceneDescriptor/Attachments/XPFreeCamera.h>
+#include <SceneDescriptor/Attachments/XPLogic.h>
+#include <SceneDescriptor/Attachments/XPMeshRenderer.h>
+#include <SceneDescriptor/XPTypes.h>
+#include <Utilities/XPMappedFile.h>
+#include <Utilities/XPMaths.h>
+
+#include <list>
+#include <span>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// bump whenever a record layout or the encoding of an attachment field changes, older snapshots are rejected and the
+// scene has to be imported again
+static constexpr uint32_t    XPSceneSnapshotVersion         = 2;
+static constexpr char        XPSceneSnapshotMagic[4]        = { 'X', 'P', 'S', 'N' };
+static constexpr char        XPSceneSnapshotJournalMagic[4] = { 'X', 'P', 'S', 'J' };
+static constexpr size_t      XPSceneSnapshotAlignment       = 8;
+static constexpr uint32_t    XPSceneSnapshotNoParent        = 0;
+static constexpr const char* XPSceneSnapshotJournalSuffix   = ".journal";
+
+struct XPSceneSnapshotHeader
+{
+    char     magic[4];
+    uint32_t version;
+    // xxh64 of the body, the journal only applies on top of the snapshot carrying the same key
+    uint64_t key;
+    uint64_t bodySize;
+};
+
+struct XPSceneSnapshotJournalHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint64_t key;
+};
+
+// every autosave appends one block, a block whose checksum does not match was torn by a crash and ends the journal
+struct XPSceneSnapshotJournalBlock
+{
+    uint64_t bodySize;
+    uint64_t checksum;
+};
+
+// a body is the same for a full snapshot and for a journal block, offsets are relative to the start of the body
+struct XPSceneSnapshotBody
+{
+    uint32_t numStrings;
+    uint32_t numLayers;
+    uint32_t numNodes;
+    uint32_t numAttachments;
+    uint32_t numRemovedNodes;
+    uint32_t numRemovedLayers;
+    uint64_t stringOffsetsOffset;
+    uint64_t stringBytesOffset;
+    uint64_t stringBytesSize;
+    uint64_t layersOffset;
+    uint64_t nodesOffset;
+    uint64_t attachmentsOffset;
+    uint64_t removedNodesOffset;
+    uint64_t removedLayersOffset;
+    uint64_t payloadOffset;
+    uint64_t payloadSize;
+};
+
+struct XPSceneSnapshotLayer
+{
+    uint32_t name;
+};
+
+// nodes are stored parents first, parentId is the id of the parent node or XPSceneSnapshotNoParent for layer roots
+struct XPSceneSnapshotNode
+{
+    uint32_t id;
+    uint32_t parentId;
+    uint32_t layer;
+    uint32_t name;
+    uint32_t interaction;
+    uint32_t attachmentDescriptor;
+    uint32_t firstAttachment;
+    uint32_t numAttachments;
+};
+
+struct XPSceneSnapshotAttachment
+{
+    uint32_t descriptor;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+};
+
+/// @brief Encodes layers, nodes and the fields of their attachments into a snapshot body. Strings are deduplicated
+/// into one table and every attachment is a range of the payload written through the write overloads, the generated
+/// XPSceneStore calls one overload per attachment field. Layers are identified by name, a journal block removes the
+/// layers it lists by name before it adds its own.
+class XPSceneSnapshotWriter final
+{
+  public:
+    uint32_t addString(std::string_view text);
+    uint32_t addLayer(std::string_view name);
+    void     beginNode(uint32_t id, uint32_t parentId, uint32_t layer, std::string_view name, uint32_t interaction);
+    void     beginAttachment(uint32_t descriptor);
+    void     endAttachment();
+    void     removeNode(uint32_t id);
+    void     removeLayer(std::string_view name);
+    void     clear();
+
+    [[nodiscard]] size_t getNumNodes() const;
+    [[nodiscard]] bool   isEmpty() const;
+
+    // lays the sections out one after another, every section starts aligned so records can be read in place
+    void finish(std::vector<uint8_t>& body) const;
+
+    void write(bool value);
+    void write(int8_t value);
+    void write(int16_t value);
+    void write(int32_t value);
+    void write(int64_t value);
+    void write(uint8_t value);
+    void write(uint16_t value);
+    void write(uint32_t value);
+    void write(uint64_t value);
+    void write(float value);
+    void write(double value);
+    void write(const std::string& value);
+    void write(const XPVec2<int>& value);
+    void write(const XPVec2<float>& value);
+    void write(const XPVec3<float>& value);
+    void write(const XPVec4<float>& value);
+    void write(const XPMat3<float>& value);
+    void write(const XPMat4<float>& value);
+    void write(const std::list<XPLogicSource>& value);
+    void write(const std::vector<XPMeshRendererInfo>& value);
+    void write(const std::vector<XPColliderInfo>& value);
+    void write(const XPColliderRefString& value);
+    void write(const XPMeshRefString& value);
+    void write(const XPMaterialRefString& value);
+    void write(const CameraProperties& value);
+    template<typename E>
+        requires std::is_enum_v<E>
+    void write(E value)
+    {
+        write(static_cast<uint32_t>(value));
+    }
+
+  private:
+    void writeBytes(const void* data, size_t size);
+
+    std::unordered_map<std::string, uint32_t> _stringTable;
+    std::vector<uint32_t>                     _stringOffsets = { 0 };
+    std::vector<char>                         _stringBytes;
+    std::vector<XPSceneSnapshotLayer>         _layers;
+    std::vector<XPSceneSnapshotNode>          _nodes;
+    std::vector<XPSceneSnapshotAttachment>    _attachments;
+    std::vector<uint32_t>                     _removedNodes;
+    std::vector<uint32_t>                     _removedLayers;
+    std::vector<uint8_t>                      _payload;
+};
+
+/// @brief Read only view of a snapshot body, the record arrays point straight into the mapped file. Attachment fields
+/// are decoded through the read overloads mirroring XPSceneSnapshotWriter, a read past the end of the current
+/// attachment leaves the field untouched and fails endAttachment.
+class XPSceneSnapshotReader final
+{
+  public:
+    [[nodiscard]] bool open(std::span<const uint8_t> body);
+
+    [[nodiscard]] std::string_view                           getString(uint32_t index) const;
+    [[nodiscard]] std::span<const XPSceneSnapshotLayer>      getLayers() const;
+    [[nodiscard]] std::span<const XPSceneSnapshotNode>       getNodes() const;
+    [[nodiscard]] std::span<const XPSceneSnapshotAttachment> getAttachments(const XPSceneSnapshotNode& node) const;
+    [[nodiscard]] std::span<const uint32_t>                  getRemovedNodes() const;
+    // names of the removed layers, as indices of the string table
+    [[nodiscard]] std::span<const uint32_t>                  getRemovedLayers() const;
+
+    void               beginAttachment(const XPSceneSnapshotAttachment& attachment);
+    [[nodiscard]] bool endAttachment();
+
+    void read(bool& value);
+    void read(int8_t& value);
+    void read(int16_t& value);
+    void read(int32_t& value);
+    void read(int64_t& value);
+    void read(uint8_t& value);
+    void read(uint16_t& value);
+    void read(uint32_t& value);
+    void read(uint64_t& value);
+    void read(float& value);
+    void read(double& value);
+    void read(std::string& value);
+    void read(XPVec2<int>& value);
+    void read(XPVec2<float>& value);
+    void read(XPVec3<float>& value);
+    void read(XPVec4<float>& value);
+    void read(XPMat3<float>& value);
+    void read(XPMat4<float>& value);
+    void read(std::list<XPLogicSource>& value);
+    void read(std::vector<XPMeshRendererInfo>& value);
+    void read(std::vector<XPColliderInfo>& value);
+    void read(XPColliderRefString& value);
+    void read(XPMeshRefString& value);
+    void read(XPMaterialRefString& value);
+    void read(CameraProperties& value);
+    template<typename E>
+        requires std::is_enum_v<E>
+    void read(E& value)
+    {
+        uint32_t raw = static_cast<uint32_t>(value);
+        read(raw);
+        value = static_cast<E>(raw);
+    }
+
+  private:
+    bool readBytes(void* data, size_t size);
+
+    std::span<const uint8_t>                   _body;
+    std::span<const uint32_t>                  _stringOffsets;
+    std::span<const char>                      _stringBytes;
+    std::span<const XPSceneSnapshotLayer>      _layers;
+    std::span<const XPSceneSnapshotNode>       _nodes;
+    std::span<const XPSceneSnapshotAttachment> _attachments;
+    std::span<const uint32_t>                  _removedNodes;
+    std::span<const uint32_t>                  _removedLayers;
+    std::span<const uint8_t>                   _payload;
+    std::span<const uint8_t>                   _cursor;
+    bool                                       _overrun = false;
+};
+
+/// @brief A snapshot file and the journal next to it (path + ".journal"). save writes the full body and starts an
+/// empty journal keyed on it, append adds one delta body per autosave, open maps both and returns the base body
+/// followed by every intact delta in the order they were appended. Blocks appended after a torn one are never read,
+/// a torn journal has to be folded into a new snapshot before the next append.
+class XPSceneSnapshotFile final
+{
+  public:
+    XPSceneSnapshotFile()  = default;
+    ~XPSceneSnapshotFile() = default;
+
+    XPSceneSnapshotFile(XPSceneSnapshotFile const&)            = delete;
+    XPSceneSnapshotFile(XPSceneSnapshotFile&&)                 = delete;
+    XPSceneSnapshotFile& operator=(XPSceneSnapshotFile const&) = delete;
+    XPSceneSnapshotFile& operator=(XPSceneSnapshotFile&&)      = delete;
+
+    [[nodiscard]] static bool save(const std::string& path, const std::vector<uint8_t>& body);
+    [[nodiscard]] static bool append(const std::string& path, const std::vector<uint8_t>& body);
+
+    [[nodiscard]] bool                                          open(const std::string& path);
+    [[nodiscard]] const std::vector<std::span<const uint8_t>>& getBodies() const;
+    [[nodiscard]] bool                                          isJournalTorn() const;
+
+  private:
+    XPMappedFile                          _snapshot;
+    XPMappedFile                          _journal;
+    std::vector<std::span<const uint8_t>> _bodies;
+    bool                                  _isJournalTorn = false;
+};
@@ -18,7 +18,24 @@
 #include <DataPipeline/XPTextureBuffer.h>
 #include <SceneDescriptor/XPSceneDescriptorStore.h>
 
-#include <string.h>
+#include <algorithm>
+
+static const char*
+getFileResourceTypeName(XPEFileResourceType type)
+{
+    switch (type) {
+        case XPEFileResourceType::Unknown: return "UnknownFiles";
+        case XPEFileResourceType::PreloadedMesh: return "PreloadedMeshFiles";
+        case XPEFileResourceType::Mesh: return "MeshFiles";
+        case XPEFileResourceType::Shader: return "ShaderFiles";
+        case XPEFileResourceType::Texture: return "TextureFiles";
+        case XPEFileResourceType::Plugin: return "PluginFiles";
+        case XPEFileResourceType::Scene: return "SceneFiles";
+        case XPEFileResourceType::RiscvBinary: return "RiscvBinaryFiles";
+        case XPEFileResourceType::Count: return "";
+    };
+    return "";
+}
 
 XPAssetsUITab::XPAssetsUITab(XPRegistry* const registry)
   : XPUITab(registry)
@@ -453,55 +470,90 @@ XPAssetsUITab::renderFilesView(XPScene* scene, uint32_t& openViewsMask)
 
     ImGui::PushID("TAB_ASSETS_FILES");
 
-    static std::list<std::string> output;
-    static std::string            filterBuff = "";
     ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
-    ImGui::InputText("%s", &filterBuff, 0);
+    bool isFilterEdited = ImGui::InputTextWithHint("##files filter", "Filter", &_filesFilter);
 
-    typedef std::pair<XPEFileResourceType, std::unordered_map<std::string, XPFile*>> FileTypeMapPair;
-
-    static const std::function<void(const XPFile*)> fnFile = [&](const XPFile* file) {
-        ImGuiTreeNodeFlags nodeTreeNodeFlags =
-          ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_NavLeftJumpsBackHere |
-          ImGuiTreeNodeFlags_NoAutoOpenOnLog | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_Leaf;
-        const char* filePath = file->getPath().c_str();
-        if (strstr(filePath, filterBuff.c_str()) != nullptr) {
-            if (ImGui::TreeNodeEx(file->getPath().c_str(), nodeTreeNodeFlags)) { ImGui::TreePop(); }
-        }
-    };
-    static const std::function<void(const FileTypeMapPair&)> fnFileType = [&](const FileTypeMapPair& fileTypePair) {
-        ImGui::TableNextRow();
-        ImGui::TableNextColumn();
-
-        const char* resourceTypeName = [](const FileTypeMapPair& fileTypePair) {
-            switch (fileTypePair.first) {
-                case XPEFileResourceType::Unknown: return "UnknownFiles";
-                case XPEFileResourceType::PreloadedMesh: return "PreloadedMeshFiles";
-                case XPEFileResourceType::Mesh: return "MeshFiles";
-                case XPEFileResourceType::Shader: return "ShaderFiles";
-                case XPEFileResourceType::Texture: return "TextureFiles";
-                case XPEFileResourceType::Plugin: return "PluginFiles";
-                case XPEFileResourceType::Scene: return "SceneFiles";
-                case XPEFileResourceType::RiscvBinary: return "RiscvBinaryFiles";
-                case XPEFileResourceType::Count: return "";
-            };
-            return "";
-        }(fileTypePair);
-
-        if (ImGui::TreeNode(resourceTypeName)) {
-            for (const auto& filePair : fileTypePair.second) { fnFile(filePair.second); }
-            ImGui::TreePop();
-        }
-    };
+    XPDataPipelineStore* dataPipelineStore = scene->getRegistry()->getDataPipelineStore();
+    if (_filesStore != dataPipelineStore || _filesVersion != dataPipelineStore->getFilesVersion()) {
+        rebuildFilesIndex(dataPipelineStore);
+        isFilterEdited = true;
+    }
+    if (isFilterEdited) {
+        _filesIndex.find(_filesFilter, _filteredFiles);
+        _areFileRowsDirty = true;
+    }
+    if (_areFileRowsDirty) { rebuildFileRows(); }
 
     static ImGuiTableFlags sceneFlags =
       ImGuiTableFlags_RowBg | ImGuiTableFlags_NoBordersInBody | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
     if (ImGui::BeginTable("##files table", 1, sceneFlags)) {
-        for (const auto& fileTypePair : scene->getRegistry()->getDataPipelineStore()->getFiles()) {
-            fnFileType(fileTypePair);
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(_fileRows.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const FileRow& row = _fileRows[i];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (row.file) {
+                    ImGuiTreeNodeFlags nodeTreeNodeFlags =
+                      ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_NoAutoOpenOnLog |
+                      ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+                    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetStyle().IndentSpacing);
+                    ImGui::TreeNodeEx(row.file->getPath().c_str(), nodeTreeNodeFlags);
+                    continue;
+                }
+                const uint32_t typeBit = 1u << static_cast<uint32_t>(row.type);
+                ImGui::SetNextItemOpen((_openFileTypes & typeBit) != 0);
+                const bool isOpen =
+                  ImGui::TreeNodeEx(getFileResourceTypeName(row.type), ImGuiTreeNodeFlags_NoTreePushOnOpen);
+                if (isOpen != ((_openFileTypes & typeBit) != 0)) {
+                    _openFileTypes ^= typeBit;
+                    _areFileRowsDirty = true;
+                }
+            }
         }
+        clipper.End();
         ImGui::EndTable();
     }
 
     ImGui::PopID();
 }
+
+void
+XPAssetsUITab::rebuildFilesIndex(XPDataPipelineStore* dataPipelineStore)
+{
+    _filesIndex.clear();
+    _indexedFiles.clear();
+    for (uint32_t type = 0; type < static_cast<uint32_t>(XPEFileResourceType::Count); ++type) {
+        auto it = dataPipelineStore->getFiles().find(static_cast<XPEFileResourceType>(type));
+        if (it == dataPipelineStore->getFiles().end()) { continue; }
+        const size_t firstFile = _indexedFiles.size();
+        for (const auto& filePair : it->second) { _indexedFiles.push_back(filePair.second); }
+        std::sort(_indexedFiles.begin() + firstFile, _indexedFiles.end(), [](const XPFile* a, const XPFile* b) {
+            return a->getPath() < b->getPath();
+        });
+    }
+    for (const XPFile* file : _indexedFiles) { _filesIndex.add(file->getPath()); }
+    _filesIndex.build();
+    _filesStore   = dataPipelineStore;
+    _filesVersion = dataPipelineStore->getFilesVersion();
+}
+
+void
+XPAssetsUITab::rebuildFileRows()
+{
+    // the index lists files grouped by type and find keeps that order, so the results of a type are one run and a
+    // type without results gets no header
+    _fileRows.clear();
+    for (size_t result = 0; result < _filteredFiles.size();) {
+        const XPEFileResourceType type   = _indexedFiles[_filteredFiles[result]]->getResourceType();
+        const bool                isOpen = (_openFileTypes & (1u << static_cast<uint32_t>(type))) != 0;
+        _fileRows.push_back({ type, nullptr });
+        for (; result < _filteredFiles.size(); ++result) {
+            const XPFile* file = _indexedFiles[_filteredFiles[result]];
+            if (file->getResourceType() != type) { break; }
+            if (isOpen) { _fileRows.push_back({ type, file }); }
+        }
+    }
+    _areFileRowsDirty = false;
+}
@@ -15,6 +15,10 @@
 #pragma once
 
 #include <UI/ImGUI/Tabs/Tabs.h>
+#include <Utilities/XPNameIndex.h>
+
+#include <string>
+#include <vector>
 
 class XPAssetsUITab final : public XPUITab
 {
@@ -39,4 +43,26 @@ class XPAssetsUITab final : public XPUITab
     void renderTexturesView(XPScene* scene, uint32_t& openViewsMask);
     void renderRiscvBinariesView(XPScene* scene, uint32_t& openViewsMask);
     void renderFilesView(XPScene* scene, uint32_t& openViewsMask);
+
+    // one line of the files view, a resource type header when there is no file
+    struct FileRow
+    {
+        XPEFileResourceType type;
+        const XPFile*       file;
+    };
+
+    // lists every file path in the name index grouped by resource type, only done when the files version moves
+    void rebuildFilesIndex(XPDataPipelineStore* dataPipelineStore);
+    // lays the headers and the filtered files under every open header out into rows
+    void rebuildFileRows();
+
+    XPNameIndex                _filesIndex;
+    std::vector<const XPFile*> _indexedFiles;
+    std::vector<uint32_t>      _filteredFiles;
+    std::vector<FileRow>       _fileRows;
+    std::string                _filesFilter;
+    XPDataPipelineStore*       _filesStore       = nullptr;
+    uint64_t                   _filesVersion     = 0;
+    uint32_t                   _openFileTypes    = 0;
+    bool                       _areFileRowsDirty = true;
 };
@@ -15,11 +15,90 @@
 #include <UI/ImGUI/Tabs/Emulator.h>
 
 #include <Emulator/XPEmulatorConfig.h>
+#include <Emulator/XPEmulatorElfLoader.h>
 #include <Emulator/XPEmulatorProcessor.h>
+#include <Emulator/XPEmulatorProfiler.h>
 #include <SceneDescriptor/Attachments/XPScript.h>
 #include <SceneDescriptor/XPNode.h>
+#include <Utilities/XPFS.h>
+#include <Utilities/XPLogger.h>
 #include <imgui_memory_editor/imgui_memory_editor.h>
 
+#include <stdio.h>
+
+static void
+renderProfiler(Script* script)
+{
+    static int interval = XP_EMULATOR_CONFIG_PROFILER_DEFAULT_INTERVAL;
+
+    auto* profiler = static_cast<XPEmulatorProfiler*>(script->profiler);
+    bool  enabled  = profiler != nullptr;
+    if (ImGui::Checkbox("Sample", &enabled)) {
+        if (enabled) {
+            profiler = static_cast<XPEmulatorProfiler*>(malloc(sizeof(XPEmulatorProfiler)));
+            xp_emulator_profiler_initialize(profiler, static_cast<uint32_t>(interval));
+        } else {
+            xp_emulator_profiler_finalize(profiler);
+            free(profiler);
+            profiler = nullptr;
+        }
+        script->profiler            = profiler;
+        script->processor->profiler = profiler;
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120.0f);
+    if (ImGui::DragInt("Interval", &interval, 10.0f, 1, 1000000) && profiler) {
+        profiler->interval  = static_cast<uint32_t>(interval);
+        profiler->countdown = profiler->interval;
+    }
+    if (!profiler) { return; }
+
+    const auto* loader = static_cast<const RiscvElfLoader*>(script->elfLoader);
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) { xp_emulator_profiler_reset(profiler); }
+    ImGui::SameLine();
+    if (ImGui::Button("Export folded stacks")) {
+        const std::string path = XPFS::buildRiscvBianryAssetsPath(script->program) + ".folded";
+        FILE*             file = fopen(path.c_str(), "w");
+        if (file && xp_emulator_profiler_write_folded(profiler, loader, file) == 0) {
+            XP_LOGV(XPLoggerSeverityInfo, "Wrote folded stacks to %s", path.c_str());
+        } else {
+            XP_LOGV(XPLoggerSeverityError, "Failed to write folded stacks to %s", path.c_str());
+        }
+        if (file) { fclose(file); }
+    }
+
+    ImGui::Text("%llu samples, %u PCs, %u stacks, call depth %u",
+                static_cast<unsigned long long>(profiler->totalSamples),
+                profiler->pcCount,
+                profiler->stackCount,
+                profiler->callDepth);
+
+    static XPEmulatorProfilerFunctionHits functions[64];
+    const size_t                          numFunctions =
+      xp_emulator_profiler_function_histogram(profiler, loader, functions, sizeof(functions) / sizeof(functions[0]));
+    if (numFunctions == 0) { return; }
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##profiler table", 3, flags, ImVec2(0.0f, 200.0f))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Function");
+        ImGui::TableSetupColumn("Self", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("%", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableHeadersRow();
+        for (size_t i = 0; i < numFunctions; ++i) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(functions[i].name ? functions[i].name : "[unknown]");
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(functions[i].hits));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", 100.0 * static_cast<double>(functions[i].hits) / profiler->totalSamples);
+        }
+        ImGui::EndTable();
+    }
+}
+
 XPEmulatorUITab::XPEmulatorUITab(XPRegistry* const registry)
   : XPUITab(registry)
 {
@@ -40,6 +119,8 @@ XPEmulatorUITab::renderView(XPScene* scene, uint32_t& openViewsMask, float delta
 
     if (!script->isLoaded) { return; }
 
+    if (ImGui::CollapsingHeader("Profiler")) { renderProfiler(script); }
+
     static MemoryEditor mem_edit;
 
     void*               mem_data          = script->processor->bus.memory.ram;
@@ -36,59 +36,52 @@ XPHierarchyUITab::renderView(XPScene* scene, uint32_t& openViewsMask, float delt
     XP_UNUSED(openViewsMask)
     XP_UNUSED(deltaTime)
 
-    static const std::function<void(XPNode*)> fnNode = [&](XPNode* node) {
-        ImGuiTreeNodeFlags nodeTreeNodeFlags =
-          ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_NavLeftJumpsBackHere |
-          ImGuiTreeNodeFlags_NoAutoOpenOnLog | ImGuiTreeNodeFlags_OpenOnDoubleClick;
-        if (node->getNodes().empty()) { nodeTreeNodeFlags |= ImGuiTreeNodeFlags_Leaf; }
-        if (node->isSelected()) { nodeTreeNodeFlags |= ImGuiTreeNodeFlags_Selected; }
-        if (ImGui::TreeNodeEx(node->getName().c_str(), nodeTreeNodeFlags, "%s", node->getName().c_str())) {
-            // node context menu
-            {
-                ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
-                if (ImGui::BeginPopupContextItem(node->getName().c_str())) {
-                    if (ImGui::Selectable("Delete")) {
-                        scene->getRegistry()->getEngine()->scheduleUITask(
-                          [&]() { node->getAbsoluteLayer()->destroyNode(node); });
+    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
+    bool isFilterEdited = ImGui::InputTextWithHint("##HierarchyFilter", "Filter", &_filter);
+
+    ImGui::BeginChild("##HierarchyScrolling", ImVec2(0.0f, 0.0f), false, ImGuiWindowFlags_HorizontalScrollbar);
+    if (_filter.empty()) {
+        if (_areRowsDirty || _rowsScene != scene || _rowsHierarchyVersion != scene->getHierarchyVersion()) {
+            rebuildRows(scene);
+        }
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(_rows.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const Row& row = _rows[i];
+                const bool isOpen =
+                  row.node ? renderNodeRow(scene, row, row.node->getNodes().empty()) : renderLayerRow(scene, row);
+                if (isOpen != row.isOpen) {
+                    // the rows stay as they are until the clipper is done, the next frame picks the change up
+                    std::unordered_set<uint32_t>& openItems = row.node ? _openNodes : _openLayers;
+                    const uint32_t                id        = row.node ? row.node->getId() : row.layer->getId();
+                    if (isOpen) {
+                        openItems.insert(id);
+                    } else {
+                        openItems.erase(id);
                     }
-                    ImGui::EndPopup();
-                }
-                ImGui::PopStyleVar();
-            }
-            if (ImGui::IsMouseReleased(ImGuiMouseButton_Left) && ImGui::IsItemHovered(ImGuiHoveredFlags_None)) {
-                ImVec2 dragDelta = ImGui::GetMouseDragDelta();
-                if (dragDelta.x == 0.0f && dragDelta.y == 0.0f) {
-                    //                            if (_window->isKeyboardShiftKeyDown()) {
-                    //                                scene->addSelectedNode(node);
-                    //                            } else {
-                    scene->setSelectedNode(node);
-                    //                            }
+                    _areRowsDirty = true;
                 }
             }
-            for (XPNode* child : node->getNodes()) { fnNode(child); }
-            ImGui::TreePop();
         }
-    };
-    static const std::function<void(XPLayer*)> fnLayer = [&](XPLayer* layer) {
-        if (ImGui::TreeNode(layer->getName().c_str())) {
-            // layer context menu
-            {
-                ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
-                if (ImGui::BeginPopupContextItem(layer->getName().c_str())) {
-                    if (ImGui::Selectable("Add Node")) {
-                        auto&       freeCameras = _registry->getScene()->getNodes(FreeCameraAttachmentDescriptor);
-                        FreeCamera* camera      = (*freeCameras.begin())->getFreeCamera();
-                        spawnCube(_registry->getScene(), camera);
-                    }
-                    ImGui::EndPopup();
-                }
-                ImGui::PopStyleVar();
+        clipper.End();
+    } else {
+        if (_isIndexDirty || _indexScene != scene || _indexHierarchyVersion != scene->getHierarchyVersion()) {
+            rebuildNameIndex(scene);
+            isFilterEdited = true;
+        }
+        if (isFilterEdited) { _nameIndex.find(_filter, _filteredNodes); }
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(_filteredNodes.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                XPNode* node = _indexedNodes[_filteredNodes[i]];
+                renderNodeRow(scene, Row{ node->getAbsoluteLayer(), node, 0, false }, true);
             }
-            for (XPNode* child : layer->getNodes()) { fnNode(child); }
-            ImGui::TreePop();
         }
-    };
-    for (XPLayer* layer : scene->getLayers()) { fnLayer(layer); }
+        clipper.End();
+    }
+    ImGui::EndChild();
 }
 
 void
@@ -116,3 +109,120 @@ XPHierarchyUITab::getWindowPadding() const
 {
     return ImVec2(1.0f, 1.0f);
 }
+
+void
+XPHierarchyUITab::rebuildRows(XPScene* scene)
+{
+    // open state is kept by id, a node destroyed and recreated from the same memory does not come back open
+    if (_rowsScene != scene) {
+        _openLayers.clear();
+        _openNodes.clear();
+    }
+    _rows.clear();
+    std::vector<std::pair<XPNode*, uint32_t>> stack;
+    for (XPLayer* layer : scene->getLayers()) {
+        const bool isLayerOpen = _openLayers.contains(layer->getId());
+        _rows.push_back({ layer, nullptr, 0, isLayerOpen });
+        if (!isLayerOpen) { continue; }
+        for (auto it = layer->getNodes().rbegin(); it != layer->getNodes().rend(); ++it) { stack.emplace_back(*it, 1); }
+        while (!stack.empty()) {
+            auto [node, depth] = stack.back();
+            stack.pop_back();
+            const bool isNodeOpen = _openNodes.contains(node->getId());
+            _rows.push_back({ layer, node, depth, isNodeOpen });
+            if (!isNodeOpen) { continue; }
+            for (auto it = node->getNodes().rbegin(); it != node->getNodes().rend(); ++it) {
+                stack.emplace_back(*it, depth + 1);
+            }
+        }
+    }
+    _rowsScene            = scene;
+    _rowsHierarchyVersion = scene->getHierarchyVersion();
+    _areRowsDirty         = false;
+}
+
+void
+XPHierarchyUITab::rebuildNameIndex(XPScene* scene)
+{
+    _nameIndex.clear();
+    _indexedNodes.clear();
+    std::vector<XPNode*> stack;
+    for (XPLayer* layer : scene->getLayers()) {
+        stack.assign(layer->getNodes().begin(), layer->getNodes().end());
+        while (!stack.empty()) {
+            XPNode* node = stack.back();
+            stack.pop_back();
+            _nameIndex.add(node->getName());
+            _indexedNodes.push_back(node);
+            stack.insert(stack.end(), node->getNodes().begin(), node->getNodes().end());
+        }
+    }
+    _nameIndex.build();
+    _indexScene            = scene;
+    _indexHierarchyVersion = scene->getHierarchyVersion();
+    _isIndexDirty          = false;
+}
+
+bool
+XPHierarchyUITab::renderLayerRow(XPScene* scene, const Row& row)
+{
+    XP_UNUSED(scene)
+
+    XPLayer* layer = row.layer;
+    ImGui::PushID(static_cast<const void*>(layer));
+    ImGui::SetNextItemOpen(row.isOpen);
+    const bool isOpen = ImGui::TreeNodeEx("##layer",
+                                          ImGuiTreeNodeFlags_NoTreePushOnOpen | ImGuiTreeNodeFlags_SpanFullWidth,
+                                          "%s",
+                                          layer->getName().c_str());
+    // layer context menu
+    {
+        ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
+        if (ImGui::BeginPopupContextItem("##layer context")) {
+            if (ImGui::Selectable("Add Node")) {
+                auto&       freeCameras = _registry->getScene()->getNodes(FreeCameraAttachmentDescriptor);
+                FreeCamera* camera      = (*freeCameras.begin())->getFreeCamera();
+                spawnCube(_registry->getScene(), camera);
+            }
+            ImGui::EndPopup();
+        }
+        ImGui::PopStyleVar();
+    }
+    ImGui::PopID();
+    return isOpen;
+}
+
+bool
+XPHierarchyUITab::renderNodeRow(XPScene* scene, const Row& row, bool isLeaf)
+{
+    XPNode*            node = row.node;
+    ImGuiTreeNodeFlags nodeTreeNodeFlags =
+      ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_NavLeftJumpsBackHere |
+      ImGuiTreeNodeFlags_NoAutoOpenOnLog | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    if (isLeaf) { nodeTreeNodeFlags |= ImGuiTreeNodeFlags_Leaf; }
+    if (node->isSelected()) { nodeTreeNodeFlags |= ImGuiTreeNodeFlags_Selected; }
+
+    // rows are drawn flat, the depth only shifts them as a pushed tree would
+    ImGui::PushID(static_cast<int>(node->getId()));
+    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + static_cast<float>(row.depth) * ImGui::GetStyle().IndentSpacing);
+    ImGui::SetNextItemOpen(row.isOpen);
+    const bool isOpen = ImGui::TreeNodeEx("##node", nodeTreeNodeFlags, "%s", node->getName().c_str());
+    // node context menu
+    {
+        ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
+        if (ImGui::BeginPopupContextItem("##node context")) {
+            if (ImGui::Selectable("Delete")) {
+                scene->getRegistry()->getEngine()->scheduleUITask(
+                  [node]() { node->getAbsoluteLayer()->destroyNode(node); });
+            }
+            ImGui::EndPopup();
+        }
+        ImGui::PopStyleVar();
+    }
+    if (ImGui::IsMouseReleased(ImGuiMouseButton_Left) && ImGui::IsItemHovered(ImGuiHoveredFlags_None)) {
+        ImVec2 dragDelta = ImGui::GetMouseDragDelta();
+        if (dragDelta.x == 0.0f && dragDelta.y == 0.0f) { scene->setSelectedNode(node); }
+    }
+    ImGui::PopID();
+    return isOpen && !isLeaf;
+}
@@ -15,6 +15,11 @@
 #pragma once
 
 #include <UI/ImGUI/Tabs/Tabs.h>
+#include <Utilities/XPNameIndex.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 class XPHierarchyUITab final : public XPUITab
 {
@@ -26,4 +31,39 @@ class XPHierarchyUITab final : public XPUITab
     ImGuiWindowFlags getWindowFlags() const final;
     const char*      getTitle() const final;
     ImVec2           getWindowPadding() const;
+
+  private:
+    // one line of the tree as it is drawn, a layer row has no node
+    struct Row
+    {
+        XPLayer* layer;
+        XPNode*  node;
+        uint32_t depth;
+        bool     isOpen;
+    };
+
+    // flattens the layers and the nodes under every open item into rows
+    void rebuildRows(XPScene* scene);
+    // lists every node of the scene in the name index, only done while a filter is typed
+    void rebuildNameIndex(XPScene* scene);
+    // both return whether the item is open after this frame's clicks
+    bool renderLayerRow(XPScene* scene, const Row& row);
+    bool renderNodeRow(XPScene* scene, const Row& row, bool isLeaf);
+
+    // the rows are rebuilt when the scene is swapped, its hierarchy version moves or an item is opened or closed,
+    // so a frame only pays for the rows the clipper shows
+    std::vector<Row>             _rows;
+    std::unordered_set<uint32_t> _openLayers;
+    std::unordered_set<uint32_t> _openNodes;
+    XPScene*                     _rowsScene            = nullptr;
+    uint64_t                     _rowsHierarchyVersion = 0;
+    bool                         _areRowsDirty         = true;
+    // filtering searches the node names instead of walking the tree
+    std::string           _filter;
+    XPNameIndex           _nameIndex;
+    std::vector<XPNode*>  _indexedNodes;
+    std::vector<uint32_t> _filteredNodes;
+    XPScene*              _indexScene            = nullptr;
+    uint64_t              _indexHierarchyVersion = 0;
+    bool                  _isIndexDirty          = true;
 };
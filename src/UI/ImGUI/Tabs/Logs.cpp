@@ -25,6 +25,48 @@ XPLogsUITab::renderView(XPScene* scene, uint32_t& openViewsMask, float deltaTime
     XP_UNUSED(scene)
     XP_UNUSED(openViewsMask)
     XP_UNUSED(deltaTime)
+
+    // the logger keeps a bounded history, mirror the new lines and keep our copy bounded the same way
+    static constexpr size_t MaxLines = 4096;
+    XPLogger::instance().copyRecentLines(_lines, _cursor);
+    if (_lines.size() > MaxLines) { _lines.erase(_lines.begin(), _lines.end() - MaxLines); }
+
+    static const char* severities[] = { "Info", "Trace", "Warning", "Error" };
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::Combo("##LogsSeverity", &_minSeverity, severities, IM_ARRAYSIZE(severities));
+    ImGui::SameLine();
+    ImGui::Checkbox("Auto-scroll", &_autoScroll);
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) { _lines.clear(); }
+
+    _visibleLines.clear();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(_lines.size()); ++i) {
+        if (_lines[i].severity >= _minSeverity) { _visibleLines.push_back(i); }
+    }
+
+    ImGui::BeginChild("##LogsScrolling", ImVec2(0.0f, 0.0f), false, ImGuiWindowFlags_HorizontalScrollbar);
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(_visibleLines.size()));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            const XPLoggerLine& line  = _lines[_visibleLines[i]];
+            ImVec4              color = ImVec4(XP_COLOR_LIGHTESTGRAY, 1.0f);
+            switch (line.severity) {
+                case XPLoggerSeverityTrace: color = ImVec4(XP_COLOR_GRAY, 1.0f); break;
+                case XPLoggerSeverityWarning: color = ImVec4(XP_COLOR_YELLOW, 1.0f); break;
+                case XPLoggerSeverityError:
+                case XPLoggerSeverityFatal:
+                case XPLoggerSeverityBreakPoint: color = ImVec4(XP_COLOR_RED, 1.0f); break;
+                default: break;
+            }
+            ImGui::PushStyleColor(ImGuiCol_Text, color);
+            ImGui::TextUnformatted(line.text.c_str(), line.text.c_str() + line.text.size());
+            ImGui::PopStyleColor();
+        }
+    }
+    clipper.End();
+    if (_autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) { ImGui::SetScrollHereY(1.0f); }
+    ImGui::EndChild();
 }
 
 void
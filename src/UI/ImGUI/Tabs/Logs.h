@@ -15,6 +15,9 @@
 #pragma once
 
 #include <UI/ImGUI/Tabs/Tabs.h>
+#include <Utilities/XPLogger.h>
+
+#include <vector>
 
 class XPLogsUITab final : public XPUITab
 {
@@ -26,4 +29,11 @@ class XPLogsUITab final : public XPUITab
     ImGuiWindowFlags getWindowFlags() const final;
     const char*      getTitle() const final;
     ImVec2           getWindowPadding() const;
+
+  private:
+    std::vector<XPLoggerLine> _lines;
+    std::vector<uint32_t>     _visibleLines;
+    uint64_t                  _cursor      = 0;
+    int                       _minSeverity = XPLoggerSeverityInfo;
+    bool                      _autoScroll  = true;
 };
@@ -41,6 +41,10 @@ XPProfilerUITab::renderView(XPScene* scene, uint32_t& openViewsMask, float delta
     XP_UNUSED(openViewsMask)
     XP_UNUSED(deltaTime)
 
+    for (const auto& [name, value] : XPProfiler::instance().getCounters()) {
+        ImGui::Text("%.*s: %llu", static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(value));
+    }
+
     auto&  timelines = XPProfiler::instance().getTimelines();
     ImVec2 available = ImGui::GetContentRegionAvail();
     ImVec2 graphSize(available.x, (available.y / timelines.size()) - (timelines.size() - 1));
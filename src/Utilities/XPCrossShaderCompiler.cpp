@@ -13,13 +13,25 @@
 /// --------------------------------------------------------------------------------------
 
 #include <Utilities/XPCrossShaderCompiler.h>
+#include <Utilities/XPFS.h>
+#include <Utilities/XPHash.h>
 #include <Utilities/XPLogger.h>
+#include <Utilities/XPMappedFile.h>
 #include <Utilities/XPPlatforms.h>
 
+#include <algorithm>
+#include <atomic>
 #include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
 #include <optional>
 #include <sstream>
+#include <string.h>
 #include <string>
+#include <thread>
+#include <vector>
 
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -39,6 +51,9 @@
 #include <spirv_cross/spirv_glsl.hpp>
 #include <spirv_cross/spirv_hlsl.hpp>
 #include <spirv_cross/spirv_msl.hpp>
+
+#define FMT_HEADER_ONLY
+#include <fmt/format.h>
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
@@ -52,6 +67,19 @@
 //     XP_LOGV(XPLoggerSeverityError, "[CROSS_SHADER] %s", error);
 // }
 
+// bump whenever the cache layout or the compiler options (spir-v / vulkan targets, cross options) change
+static constexpr uint32_t XPCrossShaderCacheVersion  = 1;
+static constexpr char     XPCrossShaderCacheMagic[4] = { 'X', 'P', 'S', 'H' };
+
+struct XPCrossShaderCacheHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint64_t spirvWordCount;
+    uint64_t sourceSize;
+};
+
 static std::optional<EShLanguage>
 getMappedStage(const XPCrossShaderInputInfo& inputInfo)
 {
@@ -82,184 +110,219 @@ getMappedShaderVersion(const XPCrossShaderInputInfo& inputInfo)
     }
 }
 
-extern bool
-crossShaderCompile(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderOutputInfo& output)
+// glslang keeps process wide tables, set them up once and tear them down at exit instead of around every compilation
+static void
+initializeGlslangProcess()
 {
-    if (inputInfo.format > XPCrossShaderFormat_GLSL_CORE_450) {
-        // Metal Shader Language is not supported as an input format (maybe this
-        // should be typesafe, but it probably will be supported in the future).
-        output.errors += "\nOnly GLSL is currently supported as an input format.";
-        return false;
-    }
+    struct XPGlslangProcess
+    {
+        XPGlslangProcess() { glslang::InitializeProcess(); }
+        ~XPGlslangProcess() { glslang::FinalizeProcess(); }
+    };
+    static XPGlslangProcess process;
+}
 
-    std::vector<uint32_t> spirvSource;
-
-    if (inputInfo.format <= XPCrossShaderFormat_GLSL_CORE_450) {
-        const char* strs = inputInfo.source.c_str();
-
-        glslang::InitializeProcess();
-
-        EShLanguage      stage = getMappedStage(inputInfo).value();
-        glslang::TShader shader(stage);
-        shader.setStrings(&strs, 1);
-
-        const TBuiltInResource DefaultTBuiltInResource = { /* .MaxLights = */ 32,
-                                                           /* .MaxClipPlanes = */ 6,
-                                                           /* .MaxTextureUnits = */ 32,
-                                                           /* .MaxTextureCoords = */ 32,
-                                                           /* .MaxVertexAttribs = */ 64,
-                                                           /* .MaxVertexUniformComponents = */ 4096,
-                                                           /* .MaxVaryingFloats = */ 64,
-                                                           /* .MaxVertexTextureImageUnits = */ 32,
-                                                           /* .MaxCombinedTextureImageUnits = */ 80,
-                                                           /* .MaxTextureImageUnits = */ 32,
-                                                           /* .MaxFragmentUniformComponents = */ 4096,
-                                                           /* .MaxDrawBuffers = */ 32,
-                                                           /* .MaxVertexUniformVectors = */ 128,
-                                                           /* .MaxVaryingVectors = */ 8,
-                                                           /* .MaxFragmentUniformVectors = */ 16,
-                                                           /* .MaxVertexOutputVectors = */ 16,
-                                                           /* .MaxFragmentInputVectors = */ 15,
-                                                           /* .MinProgramTexelOffset = */ -8,
-                                                           /* .MaxProgramTexelOffset = */ 7,
-                                                           /* .MaxClipDistances = */ 8,
-                                                           /* .MaxComputeWorkGroupCountX = */ 65535,
-                                                           /* .MaxComputeWorkGroupCountY = */ 65535,
-                                                           /* .MaxComputeWorkGroupCountZ = */ 65535,
-                                                           /* .MaxComputeWorkGroupSizeX = */ 1024,
-                                                           /* .MaxComputeWorkGroupSizeY = */ 1024,
-                                                           /* .MaxComputeWorkGroupSizeZ = */ 64,
-                                                           /* .MaxComputeUniformComponents = */ 1024,
-                                                           /* .MaxComputeTextureImageUnits = */ 16,
-                                                           /* .MaxComputeImageUniforms = */ 8,
-                                                           /* .MaxComputeAtomicCounters = */ 8,
-                                                           /* .MaxComputeAtomicCounterBuffers = */ 1,
-                                                           /* .MaxVaryingComponents = */ 60,
-                                                           /* .MaxVertexOutputComponents = */ 64,
-                                                           /* .MaxGeometryInputComponents = */ 64,
-                                                           /* .MaxGeometryOutputComponents = */ 128,
-                                                           /* .MaxFragmentInputComponents = */ 128,
-                                                           /* .MaxImageUnits = */ 8,
-                                                           /* .MaxCombinedImageUnitsAndFragmentOutputs = */ 8,
-                                                           /* .MaxCombinedShaderOutputResources = */ 8,
-                                                           /* .MaxImageSamples = */ 0,
-                                                           /* .MaxVertexImageUniforms = */ 0,
-                                                           /* .MaxTessControlImageUniforms = */ 0,
-                                                           /* .MaxTessEvaluationImageUniforms = */ 0,
-                                                           /* .MaxGeometryImageUniforms = */ 0,
-                                                           /* .MaxFragmentImageUniforms = */ 8,
-                                                           /* .MaxCombinedImageUniforms = */ 8,
-                                                           /* .MaxGeometryTextureImageUnits = */ 16,
-                                                           /* .MaxGeometryOutputVertices = */ 256,
-                                                           /* .MaxGeometryTotalOutputComponents = */ 1024,
-                                                           /* .MaxGeometryUniformComponents = */ 1024,
-                                                           /* .MaxGeometryVaryingComponents = */ 64,
-                                                           /* .MaxTessControlInputComponents = */ 128,
-                                                           /* .MaxTessControlOutputComponents = */ 128,
-                                                           /* .MaxTessControlTextureImageUnits = */ 16,
-                                                           /* .MaxTessControlUniformComponents = */ 1024,
-                                                           /* .MaxTessControlTotalOutputComponents = */ 4096,
-                                                           /* .MaxTessEvaluationInputComponents = */ 128,
-                                                           /* .MaxTessEvaluationOutputComponents = */ 128,
-                                                           /* .MaxTessEvaluationTextureImageUnits = */ 16,
-                                                           /* .MaxTessEvaluationUniformComponents = */ 1024,
-                                                           /* .MaxTessPatchComponents = */ 120,
-                                                           /* .MaxPatchVertices = */ 32,
-                                                           /* .MaxTessGenLevel = */ 64,
-                                                           /* .MaxViewports = */ 16,
-                                                           /* .MaxVertexAtomicCounters = */ 0,
-                                                           /* .MaxTessControlAtomicCounters = */ 0,
-                                                           /* .MaxTessEvaluationAtomicCounters = */ 0,
-                                                           /* .MaxGeometryAtomicCounters = */ 0,
-                                                           /* .MaxFragmentAtomicCounters = */ 8,
-                                                           /* .MaxCombinedAtomicCounters = */ 8,
-                                                           /* .MaxAtomicCounterBindings = */ 1,
-                                                           /* .MaxVertexAtomicCounterBuffers = */ 0,
-                                                           /* .MaxTessControlAtomicCounterBuffers = */ 0,
-                                                           /* .MaxTessEvaluationAtomicCounterBuffers = */ 0,
-                                                           /* .MaxGeometryAtomicCounterBuffers = */ 0,
-                                                           /* .MaxFragmentAtomicCounterBuffers = */ 1,
-                                                           /* .MaxCombinedAtomicCounterBuffers = */ 1,
-                                                           /* .MaxAtomicCounterBufferSize = */ 16384,
-                                                           /* .MaxTransformFeedbackBuffers = */ 4,
-                                                           /* .MaxTransformFeedbackInterleavedComponents = */ 64,
-                                                           /* .MaxCullDistances = */ 8,
-                                                           /* .MaxCombinedClipAndCullDistances = */ 8,
-                                                           /* .MaxSamples = */ 4,
-                                                           /* .maxMeshOutputVerticesNV = */ 256,
-                                                           /* .maxMeshOutputPrimitivesNV = */ 512,
-                                                           /* .maxMeshWorkGroupSizeX_NV = */ 32,
-                                                           /* .maxMeshWorkGroupSizeY_NV = */ 1,
-                                                           /* .maxMeshWorkGroupSizeZ_NV = */ 1,
-                                                           /* .maxTaskWorkGroupSizeX_NV = */ 32,
-                                                           /* .maxTaskWorkGroupSizeY_NV = */ 1,
-                                                           /* .maxTaskWorkGroupSizeZ_NV = */ 1,
-                                                           /* .maxMeshViewCountNV = */ 4,
-                                                           /* .maxMeshOutputVerticesEXT = */ 256,
-                                                           /* .maxMeshOutputPrimitivesEXT = */ 256,
-                                                           /* .maxMeshWorkGroupSizeX_EXT = */ 128,
-                                                           /* .maxMeshWorkGroupSizeY_EXT = */ 128,
-                                                           /* .maxMeshWorkGroupSizeZ_EXT = */ 128,
-                                                           /* .maxTaskWorkGroupSizeX_EXT = */ 128,
-                                                           /* .maxTaskWorkGroupSizeY_EXT = */ 128,
-                                                           /* .maxTaskWorkGroupSizeZ_EXT = */ 128,
-                                                           /* .maxMeshViewCountEXT = */ 4,
-                                                           /* .maxDualSourceDrawBuffersEXT = */ 6,
-
-                                                           /* .limits = */
-                                                           {
-                                                             /* .nonInductiveForLoops = */ 1,
-                                                             /* .whileLoops = */ 1,
-                                                             /* .doWhileLoops = */ 1,
-                                                             /* .generalUniformIndexing = */ 1,
-                                                             /* .generalAttributeMatrixVectorIndexing = */ 1,
-                                                             /* .generalVaryingIndexing = */ 1,
-                                                             /* .generalSamplerIndexing = */ 1,
-                                                             /* .generalVariableIndexing = */ 1,
-                                                             /* .generalConstantMatrixVectorIndexing = */ 1,
-                                                           } };
-
-        TBuiltInResource builtInResources = DefaultTBuiltInResource;
-        builtInResources.maxDrawBuffers   = true;
-        EShMessages messages              = getMappedMessages(inputInfo);
-
-        shader.setAutoMapBindings(true);
-        shader.setAutoMapLocations(true);
-
-        shader.setEnvInput(glslang::EShSourceGlsl, stage, glslang::EShClientVulkan, getMappedShaderVersion(inputInfo));
-        shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_5);
-        shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_2);
-
-        shader.parse(&builtInResources, getMappedShaderVersion(inputInfo), true, messages);
-
-        glslang::SpvOptions spvOptions;
-        spvOptions.validate         = false;
-        spvOptions.disableOptimizer = true;
-        spvOptions.optimizeSize     = false;
-
-        spv::SpvBuildLogger logger;
-
-        const char* log = shader.getInfoLog();
-
-        if (strlen(log) > 0) {
-            output.errors += std::string(log);
-            return false;
+static std::string
+buildPreamble(const XPCrossShaderInputInfo& inputInfo)
+{
+    std::string preamble;
+    for (const auto& define : inputInfo.defines) {
+        const size_t separator = define.find('=');
+        if (separator == std::string::npos) {
+            preamble += fmt::format("#define {}\n", define);
+        } else {
+            preamble += fmt::format("#define {} {}\n", define.substr(0, separator), define.substr(separator + 1));
         }
+    }
+    return preamble;
+}
 
-        glslang::TIntermediate* inter = shader.getIntermediate();
+static uint64_t
+computeCacheKey(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderFormat_ outputFormat)
+{
+    uint64_t key = XPHash::xxh64(inputInfo.source);
+    key          = XPHash::combine(key, XPCrossShaderCacheVersion);
+    key          = XPHash::combine(key, static_cast<uint32_t>(inputInfo.format));
+    key          = XPHash::combine(key, static_cast<uint32_t>(inputInfo.stage));
+    key          = XPHash::combine(key, static_cast<uint32_t>(outputFormat));
+    key          = XPHash::combine(key, static_cast<uint64_t>(inputInfo.defines.size()));
+    for (const auto& define : inputInfo.defines) { key = XPHash::xxh64(define, key); }
+    return key;
+}
 
-        try {
-            glslang::GlslangToSpv(*inter, spirvSource, &logger, &spvOptions);
-        } catch (std::exception& exp) {
-            output.errors += exp.what();
-            return false;
-        }
+static bool
+compileToSpirv(const XPCrossShaderInputInfo& inputInfo, std::vector<uint32_t>& spirv, std::string& errors)
+{
+    const char*       strs     = inputInfo.source.c_str();
+    const std::string preamble = buildPreamble(inputInfo);
+
+    initializeGlslangProcess();
+
+    EShLanguage      stage = getMappedStage(inputInfo).value();
+    glslang::TShader shader(stage);
+    shader.setStrings(&strs, 1);
+    if (!preamble.empty()) { shader.setPreamble(preamble.c_str()); }
+
+    const TBuiltInResource DefaultTBuiltInResource = { /* .MaxLights = */ 32,
+                                                       /* .MaxClipPlanes = */ 6,
+                                                       /* .MaxTextureUnits = */ 32,
+                                                       /* .MaxTextureCoords = */ 32,
+                                                       /* .MaxVertexAttribs = */ 64,
+                                                       /* .MaxVertexUniformComponents = */ 4096,
+                                                       /* .MaxVaryingFloats = */ 64,
+                                                       /* .MaxVertexTextureImageUnits = */ 32,
+                                                       /* .MaxCombinedTextureImageUnits = */ 80,
+                                                       /* .MaxTextureImageUnits = */ 32,
+                                                       /* .MaxFragmentUniformComponents = */ 4096,
+                                                       /* .MaxDrawBuffers = */ 32,
+                                                       /* .MaxVertexUniformVectors = */ 128,
+                                                       /* .MaxVaryingVectors = */ 8,
+                                                       /* .MaxFragmentUniformVectors = */ 16,
+                                                       /* .MaxVertexOutputVectors = */ 16,
+                                                       /* .MaxFragmentInputVectors = */ 15,
+                                                       /* .MinProgramTexelOffset = */ -8,
+                                                       /* .MaxProgramTexelOffset = */ 7,
+                                                       /* .MaxClipDistances = */ 8,
+                                                       /* .MaxComputeWorkGroupCountX = */ 65535,
+                                                       /* .MaxComputeWorkGroupCountY = */ 65535,
+                                                       /* .MaxComputeWorkGroupCountZ = */ 65535,
+                                                       /* .MaxComputeWorkGroupSizeX = */ 1024,
+                                                       /* .MaxComputeWorkGroupSizeY = */ 1024,
+                                                       /* .MaxComputeWorkGroupSizeZ = */ 64,
+                                                       /* .MaxComputeUniformComponents = */ 1024,
+                                                       /* .MaxComputeTextureImageUnits = */ 16,
+                                                       /* .MaxComputeImageUniforms = */ 8,
+                                                       /* .MaxComputeAtomicCounters = */ 8,
+                                                       /* .MaxComputeAtomicCounterBuffers = */ 1,
+                                                       /* .MaxVaryingComponents = */ 60,
+                                                       /* .MaxVertexOutputComponents = */ 64,
+                                                       /* .MaxGeometryInputComponents = */ 64,
+                                                       /* .MaxGeometryOutputComponents = */ 128,
+                                                       /* .MaxFragmentInputComponents = */ 128,
+                                                       /* .MaxImageUnits = */ 8,
+                                                       /* .MaxCombinedImageUnitsAndFragmentOutputs = */ 8,
+                                                       /* .MaxCombinedShaderOutputResources = */ 8,
+                                                       /* .MaxImageSamples = */ 0,
+                                                       /* .MaxVertexImageUniforms = */ 0,
+                                                       /* .MaxTessControlImageUniforms = */ 0,
+                                                       /* .MaxTessEvaluationImageUniforms = */ 0,
+                                                       /* .MaxGeometryImageUniforms = */ 0,
+                                                       /* .MaxFragmentImageUniforms = */ 8,
+                                                       /* .MaxCombinedImageUniforms = */ 8,
+                                                       /* .MaxGeometryTextureImageUnits = */ 16,
+                                                       /* .MaxGeometryOutputVertices = */ 256,
+                                                       /* .MaxGeometryTotalOutputComponents = */ 1024,
+                                                       /* .MaxGeometryUniformComponents = */ 1024,
+                                                       /* .MaxGeometryVaryingComponents = */ 64,
+                                                       /* .MaxTessControlInputComponents = */ 128,
+                                                       /* .MaxTessControlOutputComponents = */ 128,
+                                                       /* .MaxTessControlTextureImageUnits = */ 16,
+                                                       /* .MaxTessControlUniformComponents = */ 1024,
+                                                       /* .MaxTessControlTotalOutputComponents = */ 4096,
+                                                       /* .MaxTessEvaluationInputComponents = */ 128,
+                                                       /* .MaxTessEvaluationOutputComponents = */ 128,
+                                                       /* .MaxTessEvaluationTextureImageUnits = */ 16,
+                                                       /* .MaxTessEvaluationUniformComponents = */ 1024,
+                                                       /* .MaxTessPatchComponents = */ 120,
+                                                       /* .MaxPatchVertices = */ 32,
+                                                       /* .MaxTessGenLevel = */ 64,
+                                                       /* .MaxViewports = */ 16,
+                                                       /* .MaxVertexAtomicCounters = */ 0,
+                                                       /* .MaxTessControlAtomicCounters = */ 0,
+                                                       /* .MaxTessEvaluationAtomicCounters = */ 0,
+                                                       /* .MaxGeometryAtomicCounters = */ 0,
+                                                       /* .MaxFragmentAtomicCounters = */ 8,
+                                                       /* .MaxCombinedAtomicCounters = */ 8,
+                                                       /* .MaxAtomicCounterBindings = */ 1,
+                                                       /* .MaxVertexAtomicCounterBuffers = */ 0,
+                                                       /* .MaxTessControlAtomicCounterBuffers = */ 0,
+                                                       /* .MaxTessEvaluationAtomicCounterBuffers = */ 0,
+                                                       /* .MaxGeometryAtomicCounterBuffers = */ 0,
+                                                       /* .MaxFragmentAtomicCounterBuffers = */ 1,
+                                                       /* .MaxCombinedAtomicCounterBuffers = */ 1,
+                                                       /* .MaxAtomicCounterBufferSize = */ 16384,
+                                                       /* .MaxTransformFeedbackBuffers = */ 4,
+                                                       /* .MaxTransformFeedbackInterleavedComponents = */ 64,
+                                                       /* .MaxCullDistances = */ 8,
+                                                       /* .MaxCombinedClipAndCullDistances = */ 8,
+                                                       /* .MaxSamples = */ 4,
+                                                       /* .maxMeshOutputVerticesNV = */ 256,
+                                                       /* .maxMeshOutputPrimitivesNV = */ 512,
+                                                       /* .maxMeshWorkGroupSizeX_NV = */ 32,
+                                                       /* .maxMeshWorkGroupSizeY_NV = */ 1,
+                                                       /* .maxMeshWorkGroupSizeZ_NV = */ 1,
+                                                       /* .maxTaskWorkGroupSizeX_NV = */ 32,
+                                                       /* .maxTaskWorkGroupSizeY_NV = */ 1,
+                                                       /* .maxTaskWorkGroupSizeZ_NV = */ 1,
+                                                       /* .maxMeshViewCountNV = */ 4,
+                                                       /* .maxMeshOutputVerticesEXT = */ 256,
+                                                       /* .maxMeshOutputPrimitivesEXT = */ 256,
+                                                       /* .maxMeshWorkGroupSizeX_EXT = */ 128,
+                                                       /* .maxMeshWorkGroupSizeY_EXT = */ 128,
+                                                       /* .maxMeshWorkGroupSizeZ_EXT = */ 128,
+                                                       /* .maxTaskWorkGroupSizeX_EXT = */ 128,
+                                                       /* .maxTaskWorkGroupSizeY_EXT = */ 128,
+                                                       /* .maxTaskWorkGroupSizeZ_EXT = */ 128,
+                                                       /* .maxMeshViewCountEXT = */ 4,
+                                                       /* .maxDualSourceDrawBuffersEXT = */ 6,
 
-        glslang::FinalizeProcess();
+                                                       /* .limits = */
+                                                       {
+                                                         /* .nonInductiveForLoops = */ 1,
+                                                         /* .whileLoops = */ 1,
+                                                         /* .doWhileLoops = */ 1,
+                                                         /* .generalUniformIndexing = */ 1,
+                                                         /* .generalAttributeMatrixVectorIndexing = */ 1,
+                                                         /* .generalVaryingIndexing = */ 1,
+                                                         /* .generalSamplerIndexing = */ 1,
+                                                         /* .generalVariableIndexing = */ 1,
+                                                         /* .generalConstantMatrixVectorIndexing = */ 1,
+                                                       } };
+
+    TBuiltInResource builtInResources = DefaultTBuiltInResource;
+    builtInResources.maxDrawBuffers   = true;
+    EShMessages messages              = getMappedMessages(inputInfo);
+
+    shader.setAutoMapBindings(true);
+    shader.setAutoMapLocations(true);
+
+    shader.setEnvInput(glslang::EShSourceGlsl, stage, glslang::EShClientVulkan, getMappedShaderVersion(inputInfo));
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_5);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_2);
+
+    shader.parse(&builtInResources, getMappedShaderVersion(inputInfo), true, messages);
+
+    glslang::SpvOptions spvOptions;
+    spvOptions.validate         = false;
+    spvOptions.disableOptimizer = true;
+    spvOptions.optimizeSize     = false;
+
+    spv::SpvBuildLogger logger;
+
+    const char* log = shader.getInfoLog();
+
+    if (strlen(log) > 0) {
+        errors += std::string(log);
+        return false;
+    }
+
+    glslang::TIntermediate* inter = shader.getIntermediate();
+
+    try {
+        glslang::GlslangToSpv(*inter, spirv, &logger, &spvOptions);
+    } catch (std::exception& exp) {
+        errors += exp.what();
+        return false;
     }
 
+    return true;
+}
+
+static bool
+crossCompileSpirv(XPCrossShaderOutputInfo& output)
+{
     if (output.format == XPCrossShaderFormat_GLSL_ES_300) {
-        spirv_cross::CompilerGLSL          glsl(spirvSource);
+        spirv_cross::CompilerGLSL          glsl(output.spirv);
         spirv_cross::CompilerGLSL::Options options;
         options.version = 300;
         options.es      = true;
@@ -267,7 +330,7 @@ crossShaderCompile(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderOutputI
         output.source = glsl.compile();
         return true;
     } else if (output.format == XPCrossShaderFormat_GLSL_CORE_410) {
-        spirv_cross::CompilerGLSL          glsl(spirvSource);
+        spirv_cross::CompilerGLSL          glsl(output.spirv);
         spirv_cross::CompilerGLSL::Options options;
         options.version = 410;
         options.es      = false;
@@ -275,7 +338,7 @@ crossShaderCompile(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderOutputI
         output.source = glsl.compile();
         return true;
     } else if (output.format == XPCrossShaderFormat_GLSL_CORE_450) {
-        spirv_cross::CompilerGLSL          glsl(spirvSource);
+        spirv_cross::CompilerGLSL          glsl(output.spirv);
         spirv_cross::CompilerGLSL::Options options;
         options.version = 450;
         options.es      = false;
@@ -283,12 +346,12 @@ crossShaderCompile(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderOutputI
         output.source = glsl.compile();
         return true;
     } else if (output.format == XPCrossShaderFormat_MSL) {
-        spirv_cross::CompilerMSL msl(spirvSource);
+        spirv_cross::CompilerMSL msl(output.spirv);
         output.source = msl.compile();
         return true;
     } else if (output.format == XPCrossShaderFormat_SPIRV) {
         std::stringstream result;
-        std::copy(spirvSource.begin(), spirvSource.end(), std::ostream_iterator<uint32_t>(result, " "));
+        std::copy(output.spirv.begin(), output.spirv.end(), std::ostream_iterator<uint32_t>(result, " "));
         output.source = result.str().c_str();
         return true;
     }
@@ -296,3 +359,144 @@ crossShaderCompile(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderOutputI
     output.errors += "\nUnknown or unsupported output format.";
     return false;
 }
+
+static bool
+readCache(const std::string& path, uint64_t key, XPCrossShaderOutputInfo& output)
+{
+    if (!XPFS::isFile(path.c_str())) { return false; }
+
+    XPMappedFile mapping;
+    if (!mapping.open(path) || mapping.getSize() < sizeof(XPCrossShaderCacheHeader)) { return false; }
+
+    XPCrossShaderCacheHeader header = {};
+    memcpy(&header, mapping.getData(), sizeof(header));
+    const uint64_t spirvSize = header.spirvWordCount * sizeof(uint32_t);
+    if (memcmp(header.magic, XPCrossShaderCacheMagic, sizeof(header.magic)) != 0 ||
+        header.version != XPCrossShaderCacheVersion || header.key != key ||
+        sizeof(header) + spirvSize + header.sourceSize != mapping.getSize()) {
+        XP_LOGV(XPLoggerSeverityWarning, "Ignoring invalid cached shader %s", path.c_str());
+        return false;
+    }
+
+    const uint8_t* data = mapping.getData() + sizeof(header);
+    output.spirv.resize(header.spirvWordCount);
+    memcpy(output.spirv.data(), data, spirvSize);
+    output.source.assign(reinterpret_cast<const char*>(data + spirvSize), header.sourceSize);
+    return true;
+}
+
+static void
+writeCache(const std::string& path, uint64_t key, const XPCrossShaderOutputInfo& output)
+{
+    XPCrossShaderCacheHeader header = {};
+    memcpy(header.magic, XPCrossShaderCacheMagic, sizeof(header.magic));
+    header.version        = XPCrossShaderCacheVersion;
+    header.key            = key;
+    header.spirvWordCount = output.spirv.size();
+    header.sourceSize     = output.source.size();
+
+    // write next to the final path then rename, readers never observe a partially written entry. the temporary name
+    // is unique per thread since a batch may hold the same permutation more than once
+    const std::string tmpPath =
+      fmt::format("{}.{}.tmp", path, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!stream.is_open()) {
+            XP_LOGV(XPLoggerSeverityWarning, "Failed to write cached shader %s", tmpPath.c_str());
+            return;
+        }
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(output.spirv.data()), output.spirv.size() * sizeof(uint32_t));
+        stream.write(output.source.data(), output.source.size());
+        if (!stream.good()) {
+            XP_LOGV(XPLoggerSeverityWarning, "Failed to write cached shader %s", tmpPath.c_str());
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        XP_LOGV(XPLoggerSeverityWarning, "Failed to store cached shader %s", path.c_str());
+    }
+}
+
+static std::string
+buildCachePath(uint64_t key)
+{
+    return XPFS::buildCachePath(fmt::format("shaders/{:016x}.xpsh", key));
+}
+
+std::string
+crossShaderGetCachePath(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderFormat_ outputFormat)
+{
+    return buildCachePath(computeCacheKey(inputInfo, outputFormat));
+}
+
+extern bool
+crossShaderCompile(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderOutputInfo& output)
+{
+    if (inputInfo.format > XPCrossShaderFormat_GLSL_CORE_450) {
+        // Metal Shader Language is not supported as an input format (maybe this
+        // should be typesafe, but it probably will be supported in the future).
+        output.errors += "\nOnly GLSL is currently supported as an input format.";
+        return false;
+    }
+
+    output.fromCache = false;
+    output.spirv.clear();
+    output.source.clear();
+
+    const uint64_t    key       = computeCacheKey(inputInfo, output.format);
+    const std::string cachePath = buildCachePath(key);
+    if (inputInfo.useCache && readCache(cachePath, key, output)) {
+        output.fromCache = true;
+        return true;
+    }
+
+    if (!compileToSpirv(inputInfo, output.spirv, output.errors)) { return false; }
+    try {
+        if (!crossCompileSpirv(output)) { return false; }
+    } catch (std::exception& exp) {
+        output.errors += exp.what();
+        return false;
+    }
+
+    if (inputInfo.useCache) {
+        XPFS::createDirectory(XPFS::buildCachePath("shaders").c_str());
+        writeCache(cachePath, key, output);
+    }
+    return true;
+}
+
+extern bool
+crossShaderCompileBatch(std::vector<XPCrossShaderOperationInfo>& operations, uint32_t maxThreads)
+{
+    std::atomic<size_t>   next      = 0;
+    std::atomic<uint32_t> failures  = 0;
+    auto                  compileFn = [&]() {
+        // permutations differ a lot in cost, threads pull the next operation instead of owning a fixed range
+        for (size_t i = next.fetch_add(1); i < operations.size(); i = next.fetch_add(1)) {
+            XPCrossShaderOperationInfo& operation = operations[i];
+            operation.succeeded                   = crossShaderCompile(operation.input, operation.output);
+            if (!operation.succeeded) { failures.fetch_add(1); }
+        }
+    };
+
+#ifdef __EMSCRIPTEN__
+    XP_UNUSED(maxThreads)
+    compileFn();
+#else
+    const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const uint32_t allowedThreads  = maxThreads == 0 ? hardwareThreads : std::min(maxThreads, hardwareThreads);
+    const uint32_t numThreads = static_cast<uint32_t>(std::min<size_t>(allowedThreads, operations.size()));
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads > 0 ? numThreads - 1 : 0);
+    for (uint32_t t = 1; t < numThreads; ++t) { threads.emplace_back(compileFn); }
+    compileFn();
+    for (auto& thread : threads) { thread.join(); }
+#endif
+
+    return failures.load() == 0;
+}
@@ -18,7 +18,9 @@
 #include <Utilities/XPPlatforms.h>
 
 #include <optional>
+#include <stdint.h>
 #include <string>
+#include <vector>
 
 enum XPCrossShaderFormat_
 {
@@ -44,23 +46,37 @@ enum XPCrossShaderStage_
 
 struct XPCrossShaderInputInfo
 {
-    std::string          source;
-    XPCrossShaderFormat_ format;
-    XPCrossShaderStage_  stage;
+    std::string              source;
+    XPCrossShaderFormat_     format;
+    XPCrossShaderStage_      stage;
+    std::vector<std::string> defines;         // "NAME" or "NAME=VALUE", injected into the preamble of the source
+    bool                     useCache = true; // compiled results are stored under the cache directory
 };
 
 struct XPCrossShaderOutputInfo
 {
-    XPCrossShaderFormat_ format;
-    std::string          source;
-    std::string          errors;
+    XPCrossShaderFormat_  format;
+    std::string           source;
+    std::string           errors;
+    std::vector<uint32_t> spirv;
+    bool                  fromCache = false;
 };
 
 struct XPCrossShaderOperationInfo
 {
     XPCrossShaderInputInfo  input;
     XPCrossShaderOutputInfo output;
+    bool                    succeeded = false; // set by crossShaderCompileBatch
 };
 
 extern bool
 crossShaderCompile(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderOutputInfo& output);
+
+/// @brief compiles independent permutations concurrently, output.format of every operation must be set
+/// @return false if any of the operations failed, errors are reported per operation
+extern bool
+crossShaderCompileBatch(std::vector<XPCrossShaderOperationInfo>& operations, uint32_t maxThreads = 0);
+
+/// @brief location of the cached result of compiling inputInfo to outputFormat
+extern std::string
+crossShaderGetCachePath(const XPCrossShaderInputInfo& inputInfo, XPCrossShaderFormat_ outputFormat);
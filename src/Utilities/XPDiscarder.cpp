@@ -13,17 +13,7 @@
 /// --------------------------------------------------------------------------------------
 
 #include <Utilities/XPDiscarder.h>
-
-#ifdef __clang__
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wall"
-    #pragma clang diagnostic ignored "-Weverything"
-#endif
-#define FMT_HEADER_ONLY
-#include <fmt/format.h>
-#ifdef __clang__
-    #pragma clang diagnostic pop
-#endif
+#include <Utilities/XPLogger.h>
 
 XPDiscarder::XPDiscarder() {}
 
@@ -39,11 +29,11 @@ XPDiscarder::instance()
 void
 XPDiscarder::entry(const char* file, const char* function, int line)
 {
-    puts(fmt::format("[DISCARDER::ENTRY] {0}:{1} {2}", file, line, function).c_str());
+    XP_LOGV(XPLoggerSeverityTrace, "[DISCARDER::ENTRY] %s:%d %s", file, line, function);
 }
 
 void
 XPDiscarder::exit(const char* file, const char* function, int line)
 {
-    puts(fmt::format("[DISCARDER::EXIT] {0}:{1} {2}", file, line, function).c_str());
+    XP_LOGV(XPLoggerSeverityTrace, "[DISCARDER::EXIT] %s:%d %s", file, line, function);
 }
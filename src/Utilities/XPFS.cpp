@@ -297,6 +297,13 @@ XPFS::getRiscvBinaryAssetsDirectory()
     return p.c_str();
 }
 
+const char*
+XPFS::getCacheDirectory()
+{
+    static std::string p = std::format("{}cache/", getExecutableDirectoryPath());
+    return p.c_str();
+}
+
 const std::string
 XPFS::buildMeshAssetsPath(std::string path)
 {
@@ -344,3 +351,9 @@ XPFS::buildRiscvBianryAssetsPath(std::string path)
 {
     return fmt::format("{}{}", getRiscvBinaryAssetsDirectory(), path);
 }
+
+const std::string
+XPFS::buildCachePath(std::string path)
+{
+    return fmt::format("{}{}", getCacheDirectory(), path);
+}
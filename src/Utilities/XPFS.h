@@ -18,6 +18,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -49,6 +50,7 @@ class XPFS
     static const char*                         getPluginAssetsDirectory();
     static const char*                         getFontAssetsDirectory();
     static const char*                         getRiscvBinaryAssetsDirectory();
+    static const char*                         getCacheDirectory();
     static const std::string                   buildMeshAssetsPath(std::string path);
     static const std::string                   buildShaderAssetsPath(std::string path);
     static const std::string                   buildTextureAssetsPath(std::string path);
@@ -57,4 +59,5 @@ class XPFS
     static const std::string                   buildFontAssetsPath(std::string path);
     static const std::string                   buildSceneAssetsPath(std::string path);
     static const std::string                   buildRiscvBianryAssetsPath(std::string path);
+    static const std::string                   buildCachePath(std::string path);
 };
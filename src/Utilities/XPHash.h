@@ -0,0 +1,127 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <string_view>
+
+/// @brief Non cryptographic content hashing (XXH64), used to key on-disk caches and detect content changes
+class XPHash final
+{
+  public:
+    XPHash()  = delete;
+    ~XPHash() = delete;
+
+    [[nodiscard]] static uint64_t xxh64(const void* data, size_t length, uint64_t seed = 0)
+    {
+        const uint8_t*       p   = static_cast<const uint8_t*>(data);
+        const uint8_t* const end = p + length;
+        uint64_t             h   = 0;
+
+        if (length >= 32) {
+            const uint8_t* const limit = end - 32;
+            uint64_t             v1    = seed + Prime1 + Prime2;
+            uint64_t             v2    = seed + Prime2;
+            uint64_t             v3    = seed;
+            uint64_t             v4    = seed - Prime1;
+            do {
+                v1 = round(v1, read64(p));
+                v2 = round(v2, read64(p + 8));
+                v3 = round(v3, read64(p + 16));
+                v4 = round(v4, read64(p + 24));
+                p += 32;
+            } while (p <= limit);
+            h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+            h = mergeRound(h, v1);
+            h = mergeRound(h, v2);
+            h = mergeRound(h, v3);
+            h = mergeRound(h, v4);
+        } else {
+            h = seed + Prime5;
+        }
+
+        h += static_cast<uint64_t>(length);
+
+        while (p + 8 <= end) {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * Prime1 + Prime4;
+            p += 8;
+        }
+        if (p + 4 <= end) {
+            h ^= static_cast<uint64_t>(read32(p)) * Prime1;
+            h = rotl(h, 23) * Prime2 + Prime3;
+            p += 4;
+        }
+        while (p < end) {
+            h ^= static_cast<uint64_t>(*p) * Prime5;
+            h = rotl(h, 11) * Prime1;
+            ++p;
+        }
+
+        h ^= h >> 33;
+        h *= Prime2;
+        h ^= h >> 29;
+        h *= Prime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    [[nodiscard]] static uint64_t xxh64(std::string_view text, uint64_t seed = 0)
+    {
+        return xxh64(text.data(), text.size(), seed);
+    }
+
+    /// @brief folds a value into an existing hash, order dependent
+    template<typename T>
+    [[nodiscard]] static uint64_t combine(uint64_t hash, const T& value)
+    {
+        return xxh64(&value, sizeof(T), hash);
+    }
+
+  private:
+    static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+    static XP_FORCE_INLINE uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+    static XP_FORCE_INLINE uint64_t read64(const uint8_t* p)
+    {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    static XP_FORCE_INLINE uint32_t read32(const uint8_t* p)
+    {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    static XP_FORCE_INLINE uint64_t round(uint64_t acc, uint64_t input)
+    {
+        acc += input * Prime2;
+        acc = rotl(acc, 31);
+        return acc * Prime1;
+    }
+    static XP_FORCE_INLINE uint64_t mergeRound(uint64_t acc, uint64_t val)
+    {
+        acc ^= round(0, val);
+        return acc * Prime1 + Prime4;
+    }
+};
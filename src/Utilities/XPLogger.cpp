@@ -0,0 +1,514 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Utilities/XPLogger.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+
+static constexpr size_t XPLoggerRecentLinesCapacity = 4096;
+static constexpr auto   XPLoggerWorkerPeriod        = std::chrono::milliseconds(5);
+
+namespace {
+struct XPLoggerThreadRing
+{
+    XPLoggerRing* ring = nullptr;
+    ~XPLoggerThreadRing();
+};
+
+thread_local XPLoggerThreadRing threadRing;
+// trivially destructible so it stays readable while the rest of the thread locals are torn down
+thread_local bool threadRingDestroyed = false;
+
+XPLoggerThreadRing::~XPLoggerThreadRing()
+{
+    // the worker frees the ring once it has drained whatever is left in it
+    if (ring) { ring->retire(); }
+    threadRingDestroyed = true;
+}
+
+int64_t
+argAsSigned(uint8_t type, uint64_t bits)
+{
+    if (type == XPLoggerArgTypeDouble) {
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        return static_cast<int64_t>(d);
+    }
+    return static_cast<int64_t>(bits);
+}
+
+uint64_t
+argAsUnsigned(uint8_t type, uint64_t bits)
+{
+    return static_cast<uint64_t>(argAsSigned(type, bits));
+}
+
+long double
+argAsFloating(uint8_t type, uint64_t bits)
+{
+    if (type == XPLoggerArgTypeDouble) {
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+    if (type == XPLoggerArgTypeSigned) { return static_cast<long double>(static_cast<int64_t>(bits)); }
+    return static_cast<long double>(bits);
+}
+
+// formats a single conversion, casting the stored argument back to the type the length modifier asks for
+int
+formatConversion(char*            buffer,
+                 size_t           bufferSize,
+                 const char*      spec,
+                 std::string_view length,
+                 char             conversion,
+                 uint8_t          type,
+                 uint64_t         bits,
+                 const char*      text)
+{
+    switch (conversion) {
+        case 'd':
+        case 'i': {
+            const int64_t v = argAsSigned(type, bits);
+            if (length == "hh") { return snprintf(buffer, bufferSize, spec, static_cast<signed char>(v)); }
+            if (length == "h") { return snprintf(buffer, bufferSize, spec, static_cast<short>(v)); }
+            if (length == "l") { return snprintf(buffer, bufferSize, spec, static_cast<long>(v)); }
+            if (length == "ll" || length == "q") {
+                return snprintf(buffer, bufferSize, spec, static_cast<long long>(v));
+            }
+            if (length == "j") { return snprintf(buffer, bufferSize, spec, static_cast<intmax_t>(v)); }
+            if (length == "z" || length == "t") {
+                return snprintf(buffer, bufferSize, spec, static_cast<ptrdiff_t>(v));
+            }
+            return snprintf(buffer, bufferSize, spec, static_cast<int>(v));
+        }
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X': {
+            const uint64_t v = argAsUnsigned(type, bits);
+            if (length == "hh") { return snprintf(buffer, bufferSize, spec, static_cast<unsigned char>(v)); }
+            if (length == "h") { return snprintf(buffer, bufferSize, spec, static_cast<unsigned short>(v)); }
+            if (length == "l") { return snprintf(buffer, bufferSize, spec, static_cast<unsigned long>(v)); }
+            if (length == "ll" || length == "q") {
+                return snprintf(buffer, bufferSize, spec, static_cast<unsigned long long>(v));
+            }
+            if (length == "j") { return snprintf(buffer, bufferSize, spec, static_cast<uintmax_t>(v)); }
+            if (length == "z" || length == "t") {
+                return snprintf(buffer, bufferSize, spec, static_cast<size_t>(v));
+            }
+            return snprintf(buffer, bufferSize, spec, static_cast<unsigned int>(v));
+        }
+        case 'c': return snprintf(buffer, bufferSize, spec, static_cast<int>(argAsSigned(type, bits)));
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A': {
+            if (length == "L") { return snprintf(buffer, bufferSize, spec, argAsFloating(type, bits)); }
+            return snprintf(buffer, bufferSize, spec, static_cast<double>(argAsFloating(type, bits)));
+        }
+        case 's': {
+            if (type == XPLoggerArgTypeString) { return snprintf(buffer, bufferSize, spec, text); }
+            return snprintf(buffer, bufferSize, spec, bits == 0 ? "(null)" : "(invalid)");
+        }
+        case 'p': {
+            return snprintf(buffer, bufferSize, spec, reinterpret_cast<void*>(static_cast<uintptr_t>(bits)));
+        }
+        default: return -1;
+    }
+}
+} // namespace
+
+XPLogger&
+XPLogger::instance()
+{
+    // never destroyed, static destructors and thread exits may still log after main returns
+    static XPLogger* x = new XPLogger();
+    return *x;
+}
+
+XPLogger::XPLogger()
+{
+    _startTimestamp = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count());
+#if !defined(XP_PLATFORM_EMSCRIPTEN)
+    _workerRunning.store(true);
+    _worker = std::thread(&XPLogger::workerLoop, this);
+    atexit([]() { XPLogger::instance().shutdown(); });
+#endif
+}
+
+void
+XPLogger::logText(XPLoggerSeverity severity, const char* text)
+{
+    log(severity, "%s", text);
+}
+
+void
+XPLogger::flush()
+{
+    std::lock_guard<std::mutex> lock(_drainMutex);
+    drainLocked();
+}
+
+void
+XPLogger::setMinSeverity(XPLoggerSeverity severity)
+{
+    _minSeverity.store(severity, std::memory_order_relaxed);
+}
+
+XPLoggerSeverity
+XPLogger::getMinSeverity() const
+{
+    return _minSeverity.load(std::memory_order_relaxed);
+}
+
+void
+XPLogger::setStdoutEnabled(bool enabled)
+{
+    _stdoutEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool
+XPLogger::setFileOutput(const std::string& path, size_t maxBytes, uint32_t maxFiles)
+{
+    std::lock_guard<std::mutex> lock(_drainMutex);
+    if (_file) {
+        fclose(_file);
+        _file = nullptr;
+    }
+
+    std::error_code             ec;
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) { std::filesystem::create_directories(parent, ec); }
+
+    _file = fopen(path.c_str(), "ab");
+    if (!_file) { return false; }
+    fseek(_file, 0, SEEK_END);
+    const long size = ftell(_file);
+    _filePath       = path;
+    _fileBytes      = size > 0 ? static_cast<size_t>(size) : 0;
+    _fileMaxBytes   = maxBytes;
+    _fileMaxFiles   = maxFiles;
+    return true;
+}
+
+void
+XPLogger::closeFileOutput()
+{
+    std::lock_guard<std::mutex> lock(_drainMutex);
+    if (_file) {
+        fclose(_file);
+        _file = nullptr;
+    }
+}
+
+void
+XPLogger::copyRecentLines(std::vector<XPLoggerLine>& lines, uint64_t& cursor) const
+{
+    std::lock_guard<std::mutex> lock(_recentMutex);
+    for (const auto& line : _recent) {
+        if (line.sequence < cursor) { continue; }
+        lines.push_back(line);
+        cursor = line.sequence + 1;
+    }
+}
+
+const char*
+XPLogger::getSeverityName(XPLoggerSeverity severity)
+{
+    switch (severity) {
+        case XPLoggerSeverityInfo: return "INFO";
+        case XPLoggerSeverityTrace: return "TRACE";
+        case XPLoggerSeverityWarning: return "WARNING";
+        case XPLoggerSeverityError: return "ERROR";
+        case XPLoggerSeverityFatal: return "FATAL";
+        case XPLoggerSeverityBreakPoint: return "BREAKPOINT";
+    }
+    return "UNKNOWN";
+}
+
+void
+XPLogger::formatRecord(const uint8_t* record, std::string& text)
+{
+    XPLoggerRecordHeader header;
+    memcpy(&header, record, sizeof(header));
+    text.clear();
+    if (header.format == nullptr) { return; }
+
+    const uint8_t* cursor    = record + sizeof(header);
+    uint32_t       remaining = header.argCount;
+    uint8_t        type      = 0;
+    uint64_t       bits      = 0;
+    const char*    str       = nullptr;
+    const auto     nextArg   = [&]() -> bool {
+        if (remaining == 0) { return false; }
+        --remaining;
+        type = *cursor++;
+        str  = nullptr;
+        if (type == XPLoggerArgTypeString) {
+            uint32_t length = 0;
+            memcpy(&length, cursor, sizeof(length));
+            cursor += sizeof(length);
+            str  = reinterpret_cast<const char*>(cursor);
+            bits = length;
+            cursor += length + 1;
+        } else {
+            memcpy(&bits, cursor, sizeof(bits));
+            cursor += sizeof(bits);
+        }
+        return true;
+    };
+
+    char        buffer[256];
+    std::string spec;
+    const char* p = header.format;
+    while (*p) {
+        if (*p != '%') {
+            const char* run = p;
+            while (*p && *p != '%') { ++p; }
+            text.append(run, p - run);
+            continue;
+        }
+        if (p[1] == '%') {
+            text.push_back('%');
+            p += 2;
+            continue;
+        }
+
+        const char* begin = p++;
+        spec.assign("%");
+        while (*p && strchr("-+ #0'", *p)) { spec.push_back(*p++); }
+        for (int field = 0; field < 2; ++field) {
+            if (field == 1) {
+                if (*p != '.') { break; }
+                spec.push_back(*p++);
+            }
+            if (*p == '*') {
+                ++p;
+                spec += std::to_string(nextArg() ? static_cast<int>(argAsSigned(type, bits)) : 0);
+            } else {
+                while (*p >= '0' && *p <= '9') { spec.push_back(*p++); }
+            }
+        }
+        const char* lengthBegin = p;
+        while (*p && strchr("hljztLq", *p)) { ++p; }
+        const std::string_view length(lengthBegin, p - lengthBegin);
+        spec.append(lengthBegin, p);
+
+        const char conversion = *p;
+        if (conversion == '\0') {
+            text.append(begin);
+            break;
+        }
+        ++p;
+        spec.push_back(conversion);
+
+        if (!nextArg()) {
+            text.append(begin, p - begin);
+            continue;
+        }
+        if (conversion == 'n') { continue; }
+
+        const int written =
+          formatConversion(buffer, sizeof(buffer), spec.c_str(), length, conversion, type, bits, str);
+        if (written < 0) {
+            text.append(begin, p - begin);
+        } else if (static_cast<size_t>(written) < sizeof(buffer)) {
+            text.append(buffer, written);
+        } else {
+            const size_t offset = text.size();
+            text.resize(offset + written + 1);
+            formatConversion(&text[offset], written + 1, spec.c_str(), length, conversion, type, bits, str);
+            text.resize(offset + written);
+        }
+    }
+}
+
+XPLoggerRing*
+XPLogger::getThreadRing()
+{
+    if (threadRingDestroyed) { return nullptr; }
+    if (threadRing.ring == nullptr) {
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+        threadRing.ring = new XPLoggerRing(_nextThreadIndex++);
+        _rings.push_back(threadRing.ring);
+    }
+    return threadRing.ring;
+}
+
+void
+XPLogger::onRecordCommitted(XPLoggerRing* ring)
+{
+    if (!_workerRunning.load(std::memory_order_relaxed)) {
+        flush();
+        return;
+    }
+    if (ring->isMoreThanHalfFull()) { _workerCondition.notify_one(); }
+}
+
+void
+XPLogger::logImmediate(const uint8_t* record)
+{
+    // everything queued before this record has to reach the sinks first
+    flush();
+
+    XPLoggerRecordHeader header;
+    memcpy(&header, record, sizeof(header));
+
+    std::vector<XPLoggerLine> lines(1);
+    lines[0].timestamp   = header.timestamp;
+    lines[0].severity    = static_cast<XPLoggerSeverity>(header.severity);
+    lines[0].threadIndex = header.threadIndex;
+    formatRecord(record, lines[0].text);
+    {
+        std::lock_guard<std::mutex> lock(_drainMutex);
+        emitLocked(lines);
+    }
+
+    if (header.severity == XPLoggerSeverityFatal) { exit(-1); }
+    if (header.severity == XPLoggerSeverityBreakPoint) { XPDebugBreak(); }
+}
+
+void
+XPLogger::drainLocked()
+{
+    std::vector<XPLoggerRing*> rings;
+    {
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+        rings = _rings;
+    }
+
+    _pending.clear();
+    for (XPLoggerRing* ring : rings) {
+        while (const uint8_t* record = ring->peek()) {
+            XPLoggerRecordHeader header;
+            memcpy(&header, record, sizeof(header));
+            XPLoggerLine line = {};
+            line.timestamp    = header.timestamp;
+            line.severity     = static_cast<XPLoggerSeverity>(header.severity);
+            line.threadIndex  = header.threadIndex;
+            formatRecord(record, line.text);
+            ring->pop(header.size);
+            _pending.push_back(std::move(line));
+        }
+    }
+    // each ring is ordered already, interleave the threads by the time the records were made
+    std::stable_sort(_pending.begin(), _pending.end(), [](const XPLoggerLine& a, const XPLoggerLine& b) {
+        return a.timestamp < b.timestamp;
+    });
+    emitLocked(_pending);
+
+    std::lock_guard<std::mutex> lock(_ringsMutex);
+    _rings.erase(std::remove_if(_rings.begin(),
+                                _rings.end(),
+                                [](XPLoggerRing* ring) {
+                                    if (ring->isRetired() && ring->peek() == nullptr) {
+                                        delete ring;
+                                        return true;
+                                    }
+                                    return false;
+                                }),
+                 _rings.end());
+}
+
+void
+XPLogger::emitLocked(std::vector<XPLoggerLine>& lines)
+{
+    if (lines.empty()) { return; }
+
+    const bool toStdout = _stdoutEnabled.load(std::memory_order_relaxed);
+    for (auto& line : lines) {
+        line.sequence = _nextSequence++;
+        if (toStdout) { fprintf(stdout, "[%s] %s\n", getSeverityName(line.severity), line.text.c_str()); }
+        if (_file) { writeFileLocked(line); }
+    }
+    if (toStdout) { fflush(stdout); }
+    if (_file) { fflush(_file); }
+
+    std::lock_guard<std::mutex> lock(_recentMutex);
+    for (auto& line : lines) { _recent.push_back(std::move(line)); }
+    while (_recent.size() > XPLoggerRecentLinesCapacity) { _recent.pop_front(); }
+}
+
+void
+XPLogger::writeFileLocked(const XPLoggerLine& line)
+{
+    const double seconds = static_cast<double>(line.timestamp - _startTimestamp) * 1e-9;
+    const int    written = fprintf(_file,
+                                "[%10.4f][T%u][%s] %s\n",
+                                seconds,
+                                line.threadIndex,
+                                getSeverityName(line.severity),
+                                line.text.c_str());
+    if (written > 0) { _fileBytes += static_cast<size_t>(written); }
+    if (_fileMaxBytes > 0 && _fileBytes >= _fileMaxBytes) { rotateFileLocked(); }
+}
+
+void
+XPLogger::rotateFileLocked()
+{
+    fclose(_file);
+    _file = nullptr;
+
+    std::error_code ec;
+    for (uint32_t i = _fileMaxFiles; i > 1; --i) {
+        const std::string from = _filePath + "." + std::to_string(i - 1);
+        if (std::filesystem::exists(from, ec)) {
+            std::filesystem::rename(from, _filePath + "." + std::to_string(i), ec);
+        }
+    }
+    if (_fileMaxFiles > 0) {
+        std::filesystem::rename(_filePath, _filePath + ".1", ec);
+    } else {
+        std::filesystem::remove(_filePath, ec);
+    }
+
+    _file      = fopen(_filePath.c_str(), "wb");
+    _fileBytes = 0;
+}
+
+void
+XPLogger::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(_workerMutex);
+    while (!_stopRequested) {
+        _workerCondition.wait_for(lock, XPLoggerWorkerPeriod);
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+void
+XPLogger::shutdown()
+{
+    // producers start draining on their own threads from here on
+    _workerRunning.store(false);
+    {
+        std::lock_guard<std::mutex> lock(_workerMutex);
+        _stopRequested = true;
+    }
+    _workerCondition.notify_one();
+    if (_worker.joinable()) { _worker.join(); }
+    flush();
+    closeFileOutput();
+}
@@ -16,6 +16,20 @@
 
 #include <Utilities/XPPlatforms.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 enum XPLoggerSeverity
 {
     XPLoggerSeverityInfo,
@@ -26,43 +40,324 @@ enum XPLoggerSeverity
     XPLoggerSeverityBreakPoint
 };
 
+// anything below this severity is compiled out, define it project wide to strip verbose logs from release builds
+#ifndef XP_LOG_MIN_SEVERITY
+    #define XP_LOG_MIN_SEVERITY XPLoggerSeverityInfo
+#endif
+
+enum XPLoggerArgType : uint8_t
+{
+    XPLoggerArgTypeSigned,
+    XPLoggerArgTypeUnsigned,
+    XPLoggerArgTypeDouble,
+    XPLoggerArgTypePointer,
+    XPLoggerArgTypeString
+};
+
+/// @brief fixed part of every binary log record, the format string literal doubles as the format id
+struct XPLoggerRecordHeader
+{
+    uint32_t    size;
+    uint8_t     severity;
+    uint8_t     argCount;
+    uint16_t    threadIndex;
+    const char* format;
+    uint64_t    timestamp;
+};
+
+/// @brief a formatted log line as handed to the sinks and to the logs tab
+struct XPLoggerLine
+{
+    uint64_t         sequence;
+    uint64_t         timestamp;
+    XPLoggerSeverity severity;
+    uint32_t         threadIndex;
+    std::string      text;
+};
+
+/// @brief single producer single consumer byte ring, one per logging thread
+class XPLoggerRing final
+{
+  public:
+    static constexpr uint32_t Capacity      = 64 * 1024;
+    static constexpr uint32_t MaxRecordSize = Capacity / 4;
+
+    explicit XPLoggerRing(uint16_t threadIndex)
+      : _threadIndex(threadIndex)
+    {
+    }
+
+    /// @brief producer side, returns nullptr when the consumer has not caught up yet
+    uint8_t* reserve(uint32_t size)
+    {
+        const uint64_t head    = _head.load(std::memory_order_relaxed);
+        const uint32_t offset  = static_cast<uint32_t>(head & (Capacity - 1));
+        const uint32_t padding = offset + size > Capacity ? Capacity - offset : 0;
+        if (head + padding + size - _tail.load(std::memory_order_acquire) > Capacity) { return nullptr; }
+        if (padding > 0) {
+            // a zero size tells the consumer to skip to the start of the buffer
+            const uint32_t zero = 0;
+            memcpy(_buffer + offset, &zero, sizeof(zero));
+        }
+        _reserved = padding + size;
+        return _buffer + ((head + padding) & (Capacity - 1));
+    }
+    void commit()
+    {
+        _head.store(_head.load(std::memory_order_relaxed) + _reserved, std::memory_order_release);
+        _reserved = 0;
+    }
+    [[nodiscard]] bool isMoreThanHalfFull() const
+    {
+        return _head.load(std::memory_order_relaxed) - _tail.load(std::memory_order_relaxed) > Capacity / 2;
+    }
+
+    /// @brief consumer side, returns the oldest committed record or nullptr when the ring is empty
+    const uint8_t* peek()
+    {
+        const uint64_t head = _head.load(std::memory_order_acquire);
+        uint64_t       tail = _tail.load(std::memory_order_relaxed);
+        if (tail == head) { return nullptr; }
+        uint32_t size = 0;
+        memcpy(&size, _buffer + (tail & (Capacity - 1)), sizeof(size));
+        if (size == 0) {
+            tail += Capacity - (tail & (Capacity - 1));
+            _tail.store(tail, std::memory_order_release);
+            if (tail == head) { return nullptr; }
+        }
+        return _buffer + (tail & (Capacity - 1));
+    }
+    void pop(uint32_t size) { _tail.store(_tail.load(std::memory_order_relaxed) + size, std::memory_order_release); }
+
+    [[nodiscard]] uint16_t getThreadIndex() const { return _threadIndex; }
+    [[nodiscard]] bool     isRetired() const { return _retired.load(std::memory_order_acquire); }
+    void                   retire() { _retired.store(true, std::memory_order_release); }
+
+  private:
+    alignas(64) std::atomic<uint64_t> _head = 0;
+    alignas(64) std::atomic<uint64_t> _tail = 0;
+    alignas(64) uint8_t _buffer[Capacity];
+    uint32_t          _reserved = 0;
+    uint16_t          _threadIndex;
+    std::atomic<bool> _retired = false;
+};
+
+namespace XPLoggerDetail {
+static constexpr uint32_t MaxStringLength = 8 * 1024;
+
+template<typename T>
+inline constexpr bool IsString =
+  std::is_same_v<T, const char*> || std::is_same_v<T, char*> || std::is_same_v<T, const unsigned char*>;
+
+template<typename T>
+XP_FORCE_INLINE uint32_t
+encodedSize(T value)
+{
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> ||
+                    std::is_null_pointer_v<T>,
+                  "log arguments must be scalars, pass strings as const char*");
+    if constexpr (IsString<T>) {
+        const char*  text   = value ? reinterpret_cast<const char*>(value) : "(null)";
+        const size_t length = strnlen(text, MaxStringLength);
+        return static_cast<uint32_t>(1 + sizeof(uint32_t) + length + 1);
+    } else {
+        return static_cast<uint32_t>(1 + sizeof(uint64_t));
+    }
+}
+
+template<typename T>
+XP_FORCE_INLINE uint8_t*
+encode(uint8_t* dst, T value)
+{
+    if constexpr (IsString<T>) {
+        const char*    text   = value ? reinterpret_cast<const char*>(value) : "(null)";
+        const uint32_t length = static_cast<uint32_t>(strnlen(text, MaxStringLength));
+        *dst++                = XPLoggerArgTypeString;
+        memcpy(dst, &length, sizeof(length));
+        dst += sizeof(length);
+        memcpy(dst, text, length);
+        dst[length] = '\0';
+        return dst + length + 1;
+    } else {
+        uint64_t bits = 0;
+        if constexpr (std::is_floating_point_v<T>) {
+            const double d = static_cast<double>(value);
+            memcpy(&bits, &d, sizeof(bits));
+            *dst++ = XPLoggerArgTypeDouble;
+        } else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>) {
+            bits   = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<const void*>(value)));
+            *dst++ = XPLoggerArgTypePointer;
+        } else if constexpr (std::is_enum_v<T>) {
+            bits   = static_cast<uint64_t>(static_cast<int64_t>(value));
+            *dst++ = XPLoggerArgTypeSigned;
+        } else if constexpr (std::is_signed_v<T>) {
+            bits   = static_cast<uint64_t>(static_cast<int64_t>(value));
+            *dst++ = XPLoggerArgTypeSigned;
+        } else {
+            bits   = static_cast<uint64_t>(value);
+            *dst++ = XPLoggerArgTypeUnsigned;
+        }
+        memcpy(dst, &bits, sizeof(bits));
+        return dst + sizeof(bits);
+    }
+}
+
+XP_FORCE_INLINE uint32_t
+alignRecordSize(uint32_t size)
+{
+    return (size + 7u) & ~7u;
+}
+} // namespace XPLoggerDetail
+
+/// @brief asynchronous logger, callers push compact binary records into per thread rings and a background thread
+/// formats them and writes them to stdout, an optional rotating file and the recent lines shown in the logs tab
+class XPLogger final
+{
+  public:
+    static XPLogger& instance();
+
+    // delete copy and move constructors and assign operators
+    XPLogger(XPLogger const&)            = delete; // Copy construct
+    XPLogger(XPLogger&&)                 = delete; // Move construct
+    XPLogger& operator=(XPLogger const&) = delete; // Copy assign
+    XPLogger& operator=(XPLogger&&)      = delete; // Move assign
+
+    template<typename... Args>
+    void log(XPLoggerSeverity severity, const char* format, Args... args)
+    {
+        if (severity < _minSeverity.load(std::memory_order_relaxed) && severity < XPLoggerSeverityFatal) { return; }
+
+        const uint32_t size = XPLoggerDetail::alignRecordSize(
+          static_cast<uint32_t>(sizeof(XPLoggerRecordHeader)) + (0u + ... + XPLoggerDetail::encodedSize(args)));
+        XPLoggerRing* ring = severity < XPLoggerSeverityFatal ? getThreadRing() : nullptr;
+
+        if (ring != nullptr && size <= XPLoggerRing::MaxRecordSize) {
+            uint8_t* record = ring->reserve(size);
+            if (record == nullptr) {
+                // the consumer fell behind, drain on this thread rather than dropping records
+                flush();
+                record = ring->reserve(size);
+            }
+            if (record != nullptr) {
+                encodeRecord(record, size, severity, ring->getThreadIndex(), format, args...);
+                ring->commit();
+                onRecordCommitted(ring);
+                return;
+            }
+        }
+
+        std::vector<uint8_t> record(size);
+        encodeRecord(record.data(), size, severity, ring ? ring->getThreadIndex() : 0, format, args...);
+        logImmediate(record.data());
+    }
+
+    /// @brief formats printf style arguments the same way the background thread does, mostly useful for tests
+    template<typename... Args>
+    static std::string format(const char* format, Args... args)
+    {
+        const uint32_t size = XPLoggerDetail::alignRecordSize(
+          static_cast<uint32_t>(sizeof(XPLoggerRecordHeader)) + (0u + ... + XPLoggerDetail::encodedSize(args)));
+        std::vector<uint8_t> record(size);
+        encodeRecord(record.data(), size, XPLoggerSeverityInfo, 0, format, args...);
+        std::string text;
+        formatRecord(record.data(), text);
+        return text;
+    }
+
+    /// @brief pushes already formatted text, used by code that cannot use the templated path (the C emulator)
+    void logText(XPLoggerSeverity severity, const char* text);
+
+    /// @brief drains every ring on the calling thread, blocks until all records committed so far are written
+    void flush();
+
+    void                           setMinSeverity(XPLoggerSeverity severity);
+    [[nodiscard]] XPLoggerSeverity getMinSeverity() const;
+    void                           setStdoutEnabled(bool enabled);
+
+    /// @brief mirrors every line into path, rotating it into path.1 .. path.maxFiles once it exceeds maxBytes
+    bool setFileOutput(const std::string& path, size_t maxBytes, uint32_t maxFiles);
+    void closeFileOutput();
+
+    /// @brief appends recent lines newer than cursor to lines and advances cursor
+    void copyRecentLines(std::vector<XPLoggerLine>& lines, uint64_t& cursor) const;
+
+    static const char* getSeverityName(XPLoggerSeverity severity);
+    static void        formatRecord(const uint8_t* record, std::string& text);
+
+  private:
+    XPLogger();
+    ~XPLogger() = delete;
+
+    template<typename... Args>
+    static void encodeRecord(uint8_t*         record,
+                             uint32_t         size,
+                             XPLoggerSeverity severity,
+                             uint16_t         threadIndex,
+                             const char*      format,
+                             Args... args)
+    {
+        XPLoggerRecordHeader header = {};
+        header.size                 = size;
+        header.severity             = static_cast<uint8_t>(severity);
+        header.argCount             = static_cast<uint8_t>(sizeof...(Args));
+        header.threadIndex          = threadIndex;
+        header.format               = format;
+        header.timestamp            = static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+        memcpy(record, &header, sizeof(header));
+        uint8_t* dst = record + sizeof(header);
+        ((dst = XPLoggerDetail::encode(dst, args)), ...);
+        (void)dst;
+    }
+
+    XPLoggerRing* getThreadRing();
+    void          onRecordCommitted(XPLoggerRing* ring);
+    void          logImmediate(const uint8_t* record);
+    void          drainLocked();
+    void          emitLocked(std::vector<XPLoggerLine>& lines);
+    void          writeFileLocked(const XPLoggerLine& line);
+    void          rotateFileLocked();
+    void          workerLoop();
+    void          shutdown();
+
+    std::atomic<XPLoggerSeverity> _minSeverity   = XPLoggerSeverityInfo;
+    std::atomic<bool>             _stdoutEnabled = true;
+    std::atomic<bool>             _workerRunning = false;
+
+    std::mutex                 _ringsMutex;
+    std::vector<XPLoggerRing*> _rings;
+    uint16_t                   _nextThreadIndex = 0;
+
+    std::mutex                _drainMutex;
+    std::vector<XPLoggerLine> _pending;
+    uint64_t                  _nextSequence   = 0;
+    uint64_t                  _startTimestamp = 0;
+    FILE*                     _file         = nullptr;
+    std::string               _filePath;
+    size_t                    _fileBytes    = 0;
+    size_t                    _fileMaxBytes = 0;
+    uint32_t                  _fileMaxFiles = 0;
+
+    mutable std::mutex       _recentMutex;
+    std::deque<XPLoggerLine> _recent;
+
+    std::mutex              _workerMutex;
+    std::condition_variable _workerCondition;
+    bool                    _stopRequested = false;
+    std::thread             _worker;
+};
+
 #define XP_LOG(Severity, Text)                                                                                         \
-    switch (Severity) {                                                                                                \
-        case XPLoggerSeverityInfo: printf("[INFO] %s\n", Text); break;                                                 \
-        case XPLoggerSeverityTrace: printf("[TRACE] %s\n", Text); break;                                               \
-        case XPLoggerSeverityWarning: printf("[WARNING] %s\n", Text); break;                                           \
-        case XPLoggerSeverityError: printf("[ERROR] %s\n", Text); break;                                               \
-        case XPLoggerSeverityFatal: {                                                                                  \
-            printf("[FATAL] %s\n", Text);                                                                              \
-            exit(-1);                                                                                                  \
-        } break;                                                                                                       \
-        case XPLoggerSeverityBreakPoint: {                                                                             \
-            printf("[BREAKPOINT] %s\n", Text);                                                                         \
-            XPDebugBreak();                                                                                            \
-        } break;                                                                                                       \
+    {                                                                                                                  \
+        if constexpr ((Severity) >= XP_LOG_MIN_SEVERITY) {                                                             \
+            XPLogger::instance().log((Severity), "%s", static_cast<const char*>(Text));                                \
+        }                                                                                                              \
     }
 
 #define XP_LOGV(Severity, Text, ...)                                                                                   \
-    switch (Severity) {                                                                                                \
-        case XPLoggerSeverityInfo:                                                                                     \
-            printf("[INFO] ");                                                                                         \
-            printf(Text "\n", ##__VA_ARGS__);                                                                          \
-            break;                                                                                                     \
-        case XPLoggerSeverityTrace:                                                                                    \
-            printf("[TRACE] ");                                                                                        \
-            printf(Text "\n", ##__VA_ARGS__);                                                                          \
-            break;                                                                                                     \
-        case XPLoggerSeverityWarning:                                                                                  \
-            printf("[WARNING] ");                                                                                      \
-            printf(Text "\n", ##__VA_ARGS__);                                                                          \
-            break;                                                                                                     \
-        case XPLoggerSeverityError:                                                                                    \
-            printf("[ERROR] ");                                                                                        \
-            printf(Text "\n", ##__VA_ARGS__);                                                                          \
-            break;                                                                                                     \
-        case XPLoggerSeverityFatal: {                                                                                  \
-            printf("[FATAL] ");                                                                                        \
-            printf(Text "\n", ##__VA_ARGS__);                                                                          \
-            exit(-1);                                                                                                  \
-        } break;                                                                                                       \
-    }
\ No newline at end of file
+    {                                                                                                                  \
+        if constexpr ((Severity) >= XP_LOG_MIN_SEVERITY) {                                                             \
+            XPLogger::instance().log((Severity), Text, ##__VA_ARGS__);                                                 \
+        }                                                                                                              \
+    }
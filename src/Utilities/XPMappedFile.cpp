@@ -0,0 +1,143 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Utilities/XPMappedFile.h>
+
+#if defined(XP_PLATFORM_WINDOWS)
+    #include <Windows.h>
+#elif !defined(XP_PLATFORM_EMSCRIPTEN)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <fstream>
+
+XPMappedFile::XPMappedFile() {}
+
+XPMappedFile::~XPMappedFile() { close(); }
+
+bool
+XPMappedFile::open(const std::string& path)
+{
+    close();
+    _path = path;
+
+#if defined(XP_PLATFORM_WINDOWS)
+    HANDLE file =
+      CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { return false; }
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    _fileHandle    = file;
+    _mappingHandle = mapping;
+    _data          = static_cast<const uint8_t*>(view);
+    _size          = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+#elif defined(XP_PLATFORM_EMSCRIPTEN)
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream.is_open()) { return false; }
+    const std::streamsize fileSize = stream.tellg();
+    if (fileSize <= 0) { return false; }
+    _fallback.resize(static_cast<size_t>(fileSize));
+    stream.seekg(0, std::ios::beg);
+    if (!stream.read(reinterpret_cast<char*>(_fallback.data()), fileSize)) {
+        _fallback.clear();
+        return false;
+    }
+    _data = _fallback.data();
+    _size = _fallback.size();
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return false; }
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED) { return false; }
+    _data = static_cast<const uint8_t*>(view);
+    _size = static_cast<size_t>(st.st_size);
+    return true;
+#endif
+}
+
+void
+XPMappedFile::close()
+{
+    if (_data == nullptr) { return; }
+#if defined(XP_PLATFORM_WINDOWS)
+    UnmapViewOfFile(_data);
+    CloseHandle(static_cast<HANDLE>(_mappingHandle));
+    CloseHandle(static_cast<HANDLE>(_fileHandle));
+    _mappingHandle = nullptr;
+    _fileHandle    = nullptr;
+#elif defined(XP_PLATFORM_EMSCRIPTEN)
+    _fallback.clear();
+    _fallback.shrink_to_fit();
+#else
+    munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+    _data = nullptr;
+    _size = 0;
+}
+
+bool
+XPMappedFile::isOpen() const
+{
+    return _data != nullptr;
+}
+
+const uint8_t*
+XPMappedFile::getData() const
+{
+    return _data;
+}
+
+size_t
+XPMappedFile::getSize() const
+{
+    return _size;
+}
+
+std::span<const uint8_t>
+XPMappedFile::getBytes() const
+{
+    return std::span<const uint8_t>(_data, _size);
+}
+
+const std::string&
+XPMappedFile::getPath() const
+{
+    return _path;
+}
@@ -0,0 +1,54 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#include <span>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/// @brief Read only view of a whole file mapped into the address space, falls back to a heap copy where mapping
+/// is not available (emscripten)
+class XPMappedFile final
+{
+  public:
+    XPMappedFile();
+    ~XPMappedFile();
+
+    XPMappedFile(XPMappedFile const&)            = delete;
+    XPMappedFile(XPMappedFile&&)                 = delete;
+    XPMappedFile& operator=(XPMappedFile const&) = delete;
+    XPMappedFile& operator=(XPMappedFile&&)      = delete;
+
+    [[nodiscard]] bool                     open(const std::string& path);
+    void                                   close();
+    [[nodiscard]] bool                     isOpen() const;
+    [[nodiscard]] const uint8_t*           getData() const;
+    [[nodiscard]] size_t                   getSize() const;
+    [[nodiscard]] std::span<const uint8_t> getBytes() const;
+    [[nodiscard]] const std::string&       getPath() const;
+
+  private:
+    std::string          _path;
+    const uint8_t*       _data = nullptr;
+    size_t               _size = 0;
+    std::vector<uint8_t> _fallback;
+#if defined(XP_PLATFORM_WINDOWS)
+    void* _fileHandle    = nullptr;
+    void* _mappingHandle = nullptr;
+#endif
+};
@@ -59,6 +59,12 @@ struct XPMemoryPool
     // get the reserved chunk size
     size_t getNextChunkSize() const { return pool.get_next_size(); }
 
+    // makes the next chunk hold at least count items so a bulk load allocates one block instead of doubling up to it
+    void reserve(size_t count)
+    {
+        if (count > pool.get_next_size()) { pool.set_next_size(count); }
+    }
+
     XPMemoryPool(size_t nextChunkSize, size_t maxNextChunkSize)
       : pool(nextChunkSize, maxNextChunkSize)
     {
@@ -0,0 +1,163 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Utilities/XPNameIndex.h>
+
+#include <algorithm>
+#include <ctype.h>
+
+static char
+toLowerAscii(char c)
+{
+    return static_cast<char>(tolower(static_cast<unsigned char>(c)));
+}
+
+static uint32_t
+packGram(const char* gram)
+{
+    return (static_cast<uint32_t>(static_cast<uint8_t>(gram[0])) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(gram[1])) << 8) |
+           static_cast<uint32_t>(static_cast<uint8_t>(gram[2]));
+}
+
+void
+XPNameIndex::clear()
+{
+    _names.clear();
+    _offsets.assign(1, 0);
+    _gramKeys.clear();
+    _gramStarts.clear();
+    _gramEntries.clear();
+    _lastQuery.clear();
+    _lastResults.clear();
+    _hasLastResults = false;
+}
+
+uint32_t
+XPNameIndex::add(std::string_view name)
+{
+    for (char c : name) { _names.push_back(toLowerAscii(c)); }
+    _offsets.push_back(static_cast<uint32_t>(_names.size()));
+    return static_cast<uint32_t>(_offsets.size() - 2);
+}
+
+void
+XPNameIndex::build()
+{
+    // (gram, index) pairs sorted by gram then index, duplicates of a gram inside the same name collapse to one
+    std::vector<uint64_t> pairs;
+    pairs.reserve(_names.size());
+    for (uint32_t i = 0; i < size(); ++i) {
+        std::string_view name = getName(i);
+        for (size_t c = 0; c + 3 <= name.size(); ++c) {
+            pairs.push_back((static_cast<uint64_t>(packGram(name.data() + c)) << 32) | i);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    _gramKeys.clear();
+    _gramStarts.clear();
+    _gramEntries.resize(pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        const uint32_t gram = static_cast<uint32_t>(pairs[i] >> 32);
+        if (_gramKeys.empty() || _gramKeys.back() != gram) {
+            _gramKeys.push_back(gram);
+            _gramStarts.push_back(static_cast<uint32_t>(i));
+        }
+        _gramEntries[i] = static_cast<uint32_t>(pairs[i]);
+    }
+    _gramStarts.push_back(static_cast<uint32_t>(pairs.size()));
+
+    _lastQuery.clear();
+    _lastResults.clear();
+    _hasLastResults = false;
+}
+
+size_t
+XPNameIndex::size() const
+{
+    return _offsets.size() - 1;
+}
+
+void
+XPNameIndex::find(std::string_view query, std::vector<uint32_t>& results)
+{
+    std::string lowered(query.size(), '\0');
+    std::transform(query.begin(), query.end(), lowered.begin(), toLowerAscii);
+
+    results.clear();
+    if (lowered.empty()) {
+        results.resize(size());
+        for (uint32_t i = 0; i < size(); ++i) { results[i] = i; }
+    } else if (_hasLastResults && !_lastQuery.empty() && lowered.starts_with(_lastQuery)) {
+        // every name holding the longer query also holds the previous one
+        for (uint32_t i : _lastResults) {
+            if (contains(i, lowered)) { results.push_back(i); }
+        }
+    } else if (lowered.size() < 3) {
+        for (uint32_t i = 0; i < size(); ++i) {
+            if (contains(i, lowered)) { results.push_back(i); }
+        }
+    } else {
+        // intersect the postings starting from the shortest, the trigrams do not say where in the name they are so
+        // the survivors are verified against the whole query
+        std::vector<std::pair<uint32_t, uint32_t>> postings;
+        for (size_t c = 0; c + 3 <= lowered.size(); ++c) {
+            auto it = std::lower_bound(_gramKeys.begin(), _gramKeys.end(), packGram(lowered.data() + c));
+            if (it == _gramKeys.end() || *it != packGram(lowered.data() + c)) {
+                postings.clear();
+                break;
+            }
+            const size_t key = static_cast<size_t>(it - _gramKeys.begin());
+            postings.emplace_back(_gramStarts[key], _gramStarts[key + 1]);
+        }
+        if (!postings.empty()) {
+            std::sort(postings.begin(), postings.end(), [](const auto& a, const auto& b) {
+                return a.second - a.first < b.second - b.first;
+            });
+            std::vector<uint32_t> candidates(_gramEntries.begin() + postings[0].first,
+                                             _gramEntries.begin() + postings[0].second);
+            std::vector<uint32_t> intersection;
+            for (size_t p = 1; p < postings.size() && !candidates.empty(); ++p) {
+                intersection.clear();
+                std::set_intersection(candidates.begin(),
+                                      candidates.end(),
+                                      _gramEntries.begin() + postings[p].first,
+                                      _gramEntries.begin() + postings[p].second,
+                                      std::back_inserter(intersection));
+                candidates.swap(intersection);
+            }
+            for (uint32_t i : candidates) {
+                if (contains(i, lowered)) { results.push_back(i); }
+            }
+        }
+    }
+
+    _lastQuery      = std::move(lowered);
+    _lastResults    = results;
+    _hasLastResults = true;
+}
+
+std::string_view
+XPNameIndex::getName(uint32_t index) const
+{
+    return std::string_view(_names.data() + _offsets[index], _offsets[index + 1] - _offsets[index]);
+}
+
+bool
+XPNameIndex::contains(uint32_t index, std::string_view loweredQuery) const
+{
+    return getName(index).find(loweredQuery) != std::string_view::npos;
+}
@@ -0,0 +1,60 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <Utilities/XPPlatforms.h>
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief Case insensitive substring search over a set of names, built once and queried on every keystroke. Names
+/// are referred to by the index add returned. Queries of three characters or more intersect the posting lists of
+/// their trigrams and only verify the few candidates left, shorter queries scan the packed names. A query that extends
+/// the previous one only filters the previous results, so typing narrows down without touching the index again.
+class XPNameIndex final
+{
+  public:
+    void clear();
+
+    // returns the index find reports the name with, indices are given out in order starting from zero
+    uint32_t add(std::string_view name);
+
+    // sorts the trigram postings, has to be called after the last add and before the first find
+    void build();
+
+    [[nodiscard]] size_t size() const;
+
+    // fills results with the indices of every name containing query, in ascending order, an empty query matches all
+    void find(std::string_view query, std::vector<uint32_t>& results);
+
+  private:
+    [[nodiscard]] std::string_view getName(uint32_t index) const;
+    [[nodiscard]] bool             contains(uint32_t index, std::string_view loweredQuery) const;
+
+    // lowered names packed one after another, name i spans [_offsets[i], _offsets[i + 1])
+    std::vector<char>     _names;
+    std::vector<uint32_t> _offsets = { 0 };
+    // trigram postings in compressed rows, the names holding _gramKeys[i] are
+    // _gramEntries[_gramStarts[i] .. _gramStarts[i + 1]], sorted and without duplicates
+    std::vector<uint32_t> _gramKeys;
+    std::vector<uint32_t> _gramStarts;
+    std::vector<uint32_t> _gramEntries;
+    // the last query and its results, reused when the next query extends it
+    std::string           _lastQuery;
+    std::vector<uint32_t> _lastResults;
+    bool                  _hasLastResults = false;
+};
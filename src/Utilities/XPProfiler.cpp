@@ -85,6 +85,24 @@ XPProfiler::getXAxis() const
     return _xAxis;
 }
 
+uint32_t
+XPProfiler::getIndex() const
+{
+    return _index;
+}
+
+void
+XPProfiler::setCounter(std::string_view name, uint64_t value)
+{
+    _counters[name] = value;
+}
+
+const std::unordered_map<std::string_view, uint64_t>&
+XPProfiler::getCounters() const
+{
+    return _counters;
+}
+
 XPProfilerTimeline::XPProfilerTimeline()
   : file("")
   , function("")
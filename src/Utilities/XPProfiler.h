@@ -20,6 +20,7 @@
 #include <array>
 #include <chrono>
 #include <stack>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -110,6 +111,11 @@ class XPProfiler
 
     const std::unordered_map<XPProfilerTrace, XPProfilerTimeline>& getTimelines() const;
     const std::array<uint32_t, XP_PROFILER_TIMELINE_WIDTH>&        getXAxis() const;
+    // slot of the timelines' values the current frame is recorded into, the previous slot holds the last whole frame
+    uint32_t getIndex() const;
+    // latest value reported for numbers that are not timings, the name has to outlive the profiler
+    void                                                  setCounter(std::string_view name, uint64_t value);
+    const std::unordered_map<std::string_view, uint64_t>& getCounters() const;
 
   protected:
     XPProfiler();
@@ -119,4 +125,5 @@ class XPProfiler
     std::unordered_map<XPProfilerTrace, XPProfilerTimeline> _timelines;
     std::array<uint32_t, XP_PROFILER_TIMELINE_WIDTH>        _xAxis;
     uint32_t                                                _index;
+    std::unordered_map<std::string_view, uint64_t>          _counters;
 };
@@ -13,17 +13,7 @@
 /// --------------------------------------------------------------------------------------
 
 #include <Utilities/XPRecorder.h>
-
-#ifdef __clang__
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wall"
-    #pragma clang diagnostic ignored "-Weverything"
-#endif
-#define FMT_HEADER_ONLY
-#include <fmt/format.h>
-#ifdef __clang__
-    #pragma clang diagnostic pop
-#endif
+#include <Utilities/XPLogger.h>
 
 XPRecorder::XPRecorder() {}
 
@@ -39,11 +29,11 @@ XPRecorder::instance()
 void
 XPRecorder::entry(const char* file, const char* function, int line)
 {
-    puts(fmt::format("[RECORDER::ENTRY] {0}:{1} {2}", file, line, function).c_str());
+    XP_LOGV(XPLoggerSeverityTrace, "[RECORDER::ENTRY] %s:%d %s", file, line, function);
 }
 
 void
 XPRecorder::exit(const char* file, const char* function, int line)
 {
-    puts(fmt::format("[RECORDER::EXIT] {0}:{1} {2}", file, line, function).c_str());
+    XP_LOGV(XPLoggerSeverityTrace, "[RECORDER::EXIT] %s:%d %s", file, line, function);
 }
@@ -12,4 +12,485 @@
 /// limitations under the License.
 /// --------------------------------------------------------------------------------------
 
-#pragma once
\ No newline at end of file
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief a unit of work for XPThreadPool, the callable lives inline in the job so creating one never allocates
+struct alignas(64) XPJob
+{
+    static constexpr size_t PayloadSize = 96;
+
+    void (*function)(XPJob& job, uint32_t contextIndex) = nullptr;
+    void (*destroy)(XPJob& job)                         = nullptr;
+    XPJob*                parent                        = nullptr;
+    std::atomic<uint32_t> unfinished                    = 0;
+    alignas(16) unsigned char payload[PayloadSize];
+};
+
+/// @brief fixed capacity Chase-Lev deque, the owning context pushes and pops at the bottom while others steal at the
+/// top
+class XPJobDeque
+{
+  public:
+    explicit XPJobDeque(uint32_t capacity)
+      : _buffer(new std::atomic<XPJob*>[capacity])
+      , _mask(static_cast<int64_t>(capacity) - 1)
+      , _top(0)
+      , _bottom(0)
+    {
+        assert((capacity & (capacity - 1)) == 0 && "Deque capacity has to be a power of two");
+    }
+
+    void push(XPJob* job)
+    {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        assert(b - _top.load(std::memory_order_acquire) <= _mask && "Job deque is full");
+        _buffer[b & _mask].store(job, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] XPJob* pop()
+    {
+        const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+        if (t > b) {
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        XPJob* job = _buffer[b & _mask].load(std::memory_order_relaxed);
+        if (t == b) {
+            // last job left, race the thieves for it
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    [[nodiscard]] XPJob* steal()
+    {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = _bottom.load(std::memory_order_acquire);
+        if (t >= b) { return nullptr; }
+        XPJob* job = _buffer[t & _mask].load(std::memory_order_relaxed);
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return job;
+    }
+
+  private:
+    std::unique_ptr<std::atomic<XPJob*>[]> _buffer;
+    const int64_t                          _mask;
+    alignas(64) std::atomic<int64_t> _top;
+    alignas(64) std::atomic<int64_t> _bottom;
+};
+
+/// @brief work stealing scheduler shared by the engine and the software rasterizers
+///
+/// every worker and every outside thread that creates jobs gets a context with its own job ring and deque, so
+/// creating and running a job never takes a lock. outside threads lease a context for the duration of a call and give
+/// it back when it returns, so any number of them can share the few there are. idle workers steal from the top of the
+/// other deques and go to sleep when there is nothing left, waiting on a job helps running other jobs until it is done.
+/// callables take the context index (void(uint32_t)), or the job itself as well (void(XPJob&, uint32_t)) when they
+/// want to spawn children of it. no two threads run jobs with the same context index at once, use it to address per
+/// thread scratch memory.
+class XPThreadPool
+{
+  public:
+    static constexpr uint32_t JobsPerContext      = 4096;
+    // outside threads inside a call at the same time, more of them wait until one of those calls returns
+    static constexpr uint32_t MaxExternalContexts = 16;
+
+    /// @brief starts numWorkers threads, 0 runs every job on the thread that waits for it
+    explicit XPThreadPool(uint32_t numWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1)
+      : _id(nextPoolId())
+      , _contexts(numWorkers + MaxExternalContexts)
+      , _numWorkers(numWorkers)
+      , _numContexts(numWorkers)
+      , _workEpoch(0)
+      , _numPendingSubmits(0)
+      , _stopping(false)
+    {
+        for (uint32_t i = 0; i < numWorkers; ++i) {
+            _contexts[i]         = std::make_unique<Context>();
+            _contexts[i]->index  = i;
+            _contexts[i]->victim = i + 1;
+        }
+        _workers.reserve(numWorkers);
+        for (uint32_t i = 0; i < numWorkers; ++i) { _workers.emplace_back([this, i] { workerLoop(i); }); }
+    }
+    XPThreadPool(const XPThreadPool&) = delete;
+    ~XPThreadPool()
+    {
+        waitForWork();
+        _stopping.store(true);
+        _workEpoch.fetch_add(1);
+        _workEpoch.notify_all();
+        for (std::thread& worker : _workers) { worker.join(); }
+    }
+
+    /// @brief creates a job without queueing it, a parent is only done once all of its children are done
+    template<typename F>
+    [[nodiscard]] XPJob* createJob(F&& function, XPJob* parent = nullptr)
+    {
+        using Callable = std::decay_t<F>;
+        static_assert(sizeof(Callable) <= XPJob::PayloadSize, "Job callable doesn't fit in the job payload");
+        static_assert(alignof(Callable) <= 16, "Job callable is over aligned");
+
+        ContextScope scope(*this);
+        XPJob*       job = allocateJob(scope.context);
+
+        new (job->payload) Callable(std::forward<F>(function));
+        job->function = [](XPJob& self, uint32_t contextIndex) {
+            Callable& callable = *std::launder(reinterpret_cast<Callable*>(self.payload));
+            if constexpr (std::is_invocable_v<Callable&, XPJob&, uint32_t>) {
+                callable(self, contextIndex);
+            } else {
+                callable(contextIndex);
+            }
+        };
+        job->destroy = [](XPJob& self) { std::launder(reinterpret_cast<Callable*>(self.payload))->~Callable(); };
+        job->parent  = parent;
+        job->unfinished.store(1, std::memory_order_relaxed);
+        if (parent) { parent->unfinished.fetch_add(1, std::memory_order_relaxed); }
+        return job;
+    }
+
+    /// @brief queues the job on the deque of the calling thread, which has to be the one that created it
+    void run(XPJob* job)
+    {
+        ContextScope scope(*this);
+        scope.context.deque.push(job);
+        _workEpoch.fetch_add(1, std::memory_order_release);
+        _workEpoch.notify_one();
+    }
+
+    /// @brief blocks until the job and all of its children are done, running queued jobs in the meantime
+    void wait(const XPJob* job)
+    {
+        while (job->unfinished.load(std::memory_order_acquire) != 0) {
+            if (!helpOnce()) {
+                const uint32_t unfinished = job->unfinished.load(std::memory_order_acquire);
+                if (unfinished != 0) { job->unfinished.wait(unfinished, std::memory_order_acquire); }
+            }
+        }
+    }
+
+    /// @brief fire and forget, waitForWork() blocks until every submitted job is done
+    template<typename F>
+    void submit(F&& function)
+    {
+        _numPendingSubmits.fetch_add(1, std::memory_order_relaxed);
+        run(createJob([this, f = std::forward<F>(function)](uint32_t contextIndex) mutable {
+            f(contextIndex);
+            if (_numPendingSubmits.fetch_sub(1, std::memory_order_acq_rel) == 1) { _numPendingSubmits.notify_all(); }
+        }));
+    }
+
+    /// @brief blocks until every submitted job is done, running queued jobs in the meantime
+    void waitForWork()
+    {
+        while (_numPendingSubmits.load(std::memory_order_acquire) != 0) {
+            if (!helpOnce()) {
+                const uint32_t pending = _numPendingSubmits.load(std::memory_order_acquire);
+                if (pending != 0) { _numPendingSubmits.wait(pending, std::memory_order_acquire); }
+            }
+        }
+    }
+
+    /// @brief blocks until done() returns true, running queued jobs in the meantime. for counters of a subset of the
+    /// submitted jobs, unlike waitForWork it doesn't wait for the work others keep submitting
+    template<typename P>
+    void waitUntil(P&& done)
+    {
+        while (!done()) {
+            if (!helpOnce()) { std::this_thread::yield(); }
+        }
+    }
+
+    /// @brief queues a job that calls function(first, last, contextIndex) on chunks of at most grainSize elements of
+    /// [begin, end), the range is halved lazily so idle workers steal big chunks first. function is referenced, it has
+    /// to outlive the returned job
+    template<typename F>
+    [[nodiscard]] XPJob*
+    parallelForAsync(size_t begin, size_t end, size_t grainSize, F& function, XPJob* parent = nullptr)
+    {
+        grainSize  = std::max<size_t>(grainSize, 1);
+        XPJob* job = createJob(
+          [this, begin, end, grainSize, f = &function](XPJob& self, uint32_t contextIndex) {
+              splitRange(self, begin, end, grainSize, *f, contextIndex);
+          },
+          parent);
+        run(job);
+        return job;
+    }
+
+    /// @brief blocks until function ran over the whole range, see parallelForAsync
+    template<typename F>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, F&& function)
+    {
+        if (begin >= end) { return; }
+        wait(parallelForAsync(begin, end, grainSize, function, nullptr));
+    }
+
+    /// @brief index of the context of the calling thread, outside threads only hold one during a call and this is the
+    /// one they most likely get again
+    [[nodiscard]] uint32_t getContextIndex()
+    {
+        ContextScope scope(*this);
+        return scope.context.index;
+    }
+    /// @brief upper bound of context indices, size per thread data with this
+    [[nodiscard]] uint32_t getMaxContexts() const { return static_cast<uint32_t>(_contexts.size()); }
+    [[nodiscard]] uint32_t getNumWorkers() const { return _numWorkers; }
+
+  private:
+    struct Context
+    {
+        Context()
+          : jobs(new XPJob[JobsPerContext])
+          , deque(JobsPerContext)
+        {
+        }
+
+        std::unique_ptr<XPJob[]> jobs;
+        XPJobDeque               deque;
+        uint32_t                 nextJob = 0;
+        uint32_t                 index   = 0;
+        uint32_t                 victim  = 0;
+        // calls of the holding thread into the pool, nested ones through the jobs it runs included
+        uint32_t depth = 0;
+        // outside threads lease a context for a call, it goes back to the pool when the outermost one returns
+        std::atomic<bool> leased = false;
+    };
+
+    // holds the context of the calling thread for the duration of a call
+    struct ContextScope
+    {
+        explicit ContextScope(XPThreadPool& pool)
+          : pool(pool)
+          , context(pool.acquireContext())
+        {
+        }
+        ContextScope(const ContextScope&) = delete;
+        ~ContextScope() { pool.releaseContext(context); }
+
+        XPThreadPool& pool;
+        Context&      context;
+    };
+
+    // pools are told apart by id rather than address, a new pool can be allocated where a destroyed one was
+    struct ThreadContexts
+    {
+        struct Entry
+        {
+            uint64_t poolId;
+            Context* context;
+        };
+
+        std::vector<Entry> entries;
+        uint64_t           lastPoolId  = 0;
+        Context*           lastContext = nullptr;
+        // context the thread leased last time, trying it first keeps the index of a thread mostly the same
+        uint32_t leaseHint = 0;
+    };
+
+    static uint64_t nextPoolId()
+    {
+        static std::atomic<uint64_t> counter = 0;
+        return ++counter;
+    }
+
+    static ThreadContexts& threadContexts()
+    {
+        static thread_local ThreadContexts tc;
+        return tc;
+    }
+
+    Context& acquireContext()
+    {
+        ThreadContexts& tc = threadContexts();
+        if (tc.lastPoolId != _id) {
+            // a thread switching between pools, or an outside thread calling into this pool
+            auto it = std::find_if(
+              tc.entries.begin(), tc.entries.end(), [this](const ThreadContexts::Entry& e) { return e.poolId == _id; });
+            if (it == tc.entries.end()) {
+                Context* context = leaseContext(tc.leaseHint);
+                tc.leaseHint     = context->index;
+                tc.entries.push_back(ThreadContexts::Entry{ _id, context });
+                it = tc.entries.end() - 1;
+            }
+            tc.lastPoolId  = _id;
+            tc.lastContext = it->context;
+        }
+        ++tc.lastContext->depth;
+        return *tc.lastContext;
+    }
+
+    void releaseContext(Context& context)
+    {
+        // workers keep their context, outside threads give theirs back once the outermost call returns
+        if (--context.depth != 0 || context.index < _numWorkers) { return; }
+        ThreadContexts& tc = threadContexts();
+        std::erase_if(tc.entries, [this](const ThreadContexts::Entry& e) { return e.poolId == _id; });
+        if (tc.lastPoolId == _id) { tc.lastPoolId = 0; }
+        context.leased.store(false, std::memory_order_release);
+    }
+
+    Context* leaseContext(uint32_t hint)
+    {
+        const auto tryLease = [this](uint32_t index) {
+            bool expected = false;
+            return _contexts[index]->leased.compare_exchange_strong(expected, true, std::memory_order_acquire);
+        };
+        for (;;) {
+            const uint32_t numContexts = _numContexts.load(std::memory_order_acquire);
+            if (hint >= _numWorkers && hint < numContexts && tryLease(hint)) { return _contexts[hint].get(); }
+            for (uint32_t i = _numWorkers; i < numContexts; ++i) {
+                if (tryLease(i)) { return _contexts[i].get(); }
+            }
+            {
+                std::lock_guard<std::mutex> l(_externalMut);
+                const uint32_t              index = _numContexts.load(std::memory_order_relaxed);
+                if (index < _contexts.size()) {
+                    _contexts[index]         = std::make_unique<Context>();
+                    _contexts[index]->index  = index;
+                    _contexts[index]->leased = true;
+                    // publish the context only after it is constructed so thieves never see a half built one
+                    _numContexts.store(index + 1, std::memory_order_release);
+                    return _contexts[index].get();
+                }
+            }
+            // every context is in use by a call of another outside thread, they hold them only until it returns
+            std::this_thread::yield();
+        }
+    }
+
+    XPJob* allocateJob(Context& context)
+    {
+        // slots still in use when the ring wraps around are skipped, a pending parent can hold one for long
+        for (uint32_t numBusy = 0;; ++numBusy) {
+            XPJob* job = &context.jobs[context.nextJob++ & (JobsPerContext - 1)];
+            if (job->unfinished.load(std::memory_order_acquire) == 0) { return job; }
+            if (numBusy >= JobsPerContext && !helpOnce(context)) { std::this_thread::yield(); }
+        }
+    }
+
+    template<typename F>
+    void splitRange(XPJob& self, size_t begin, size_t end, size_t grainSize, F& function, uint32_t contextIndex)
+    {
+        while (end - begin > grainSize) {
+            const size_t middle = begin + (end - begin) / 2;
+            run(createJob(
+              [this, middle, end, grainSize, f = &function](XPJob& child, uint32_t childContextIndex) {
+                  splitRange(child, middle, end, grainSize, *f, childContextIndex);
+              },
+              &self));
+            end = middle;
+        }
+        function(begin, end, contextIndex);
+    }
+
+    XPJob* findJob(Context& context)
+    {
+        if (XPJob* job = context.deque.pop()) { return job; }
+        const uint32_t numContexts = _numContexts.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < numContexts; ++i) {
+            const uint32_t victim = (context.victim + i) % numContexts;
+            if (victim == context.index) { continue; }
+            if (XPJob* job = _contexts[victim]->deque.steal()) {
+                // keep stealing from the same context while it has work
+                context.victim = victim;
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void execute(XPJob* job, uint32_t contextIndex)
+    {
+        job->function(*job, contextIndex);
+        job->destroy(*job);
+        finish(job);
+    }
+
+    static void finish(XPJob* job)
+    {
+        while (job) {
+            // read the parent first, the job slot can be reused as soon as it is marked done
+            XPJob* parent = job->parent;
+            if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) { return; }
+            job->unfinished.notify_all();
+            job = parent;
+        }
+    }
+
+    // outside threads don't hold on to their context while there is nothing to run, so waiting never keeps a context
+    // from the others
+    bool helpOnce()
+    {
+        ContextScope scope(*this);
+        return helpOnce(scope.context);
+    }
+
+    bool helpOnce(Context& context)
+    {
+        XPJob* job = findJob(context);
+        if (job == nullptr) { return false; }
+        execute(job, context.index);
+        return true;
+    }
+
+    void workerLoop(uint32_t index)
+    {
+        Context&        context = *_contexts[index];
+        ThreadContexts& tc      = threadContexts();
+        tc.entries.push_back(ThreadContexts::Entry{ _id, &context });
+        tc.lastPoolId  = _id;
+        tc.lastContext = &context;
+
+        uint32_t idleRounds = 0;
+        while (!_stopping.load(std::memory_order_acquire)) {
+            const uint32_t epoch = _workEpoch.load(std::memory_order_acquire);
+            if (helpOnce(context)) {
+                idleRounds = 0;
+                continue;
+            }
+            if (++idleRounds < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+            // nothing was queued since the epoch was read, sleep until someone runs a job
+            _workEpoch.wait(epoch, std::memory_order_acquire);
+            idleRounds = 0;
+        }
+    }
+
+    const uint64_t                        _id;
+    std::vector<std::unique_ptr<Context>> _contexts;
+    std::vector<std::thread>              _workers;
+    std::mutex                            _externalMut;
+    const uint32_t                        _numWorkers;
+    std::atomic<uint32_t>                 _numContexts;
+    std::atomic<uint32_t>                 _workEpoch;
+    std::atomic<uint32_t>                 _numPendingSubmits;
+    std::atomic<bool>                     _stopping;
+};
@@ -0,0 +1,106 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Utilities/XPCrossShaderCompiler.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// every run compiles a source no earlier run cached, so the first compilation is always a miss
+static XPCrossShaderInputInfo
+createFragmentShader()
+{
+    const auto             now = std::chrono::steady_clock::now().time_since_epoch().count();
+    XPCrossShaderInputInfo input;
+    input.format  = XPCrossShaderFormat_GLSL_CORE_450;
+    input.stage   = XPCrossShaderStage_Fragment;
+    input.defines = { "INTENSITY=0.5" };
+    input.source  = "#version 450\n// " + std::to_string(now) +
+                   "\nlayout(location = 0) out vec4 color;\nvoid main() { color = vec4(INTENSITY); }\n";
+    return input;
+}
+
+TEST(CrossShaderCompilerTests, CacheKeyCoversDefinesStageAndTarget)
+{
+    const XPCrossShaderInputInfo input = createFragmentShader();
+    const std::string            path  = crossShaderGetCachePath(input, XPCrossShaderFormat_MSL);
+    EXPECT_EQ(crossShaderGetCachePath(input, XPCrossShaderFormat_MSL), path);
+    EXPECT_NE(crossShaderGetCachePath(input, XPCrossShaderFormat_SPIRV), path);
+
+    XPCrossShaderInputInfo otherDefine = input;
+    otherDefine.defines                = { "INTENSITY=1.0" };
+    EXPECT_NE(crossShaderGetCachePath(otherDefine, XPCrossShaderFormat_MSL), path);
+
+    XPCrossShaderInputInfo moreDefines = input;
+    moreDefines.defines.push_back("SHADOWS");
+    EXPECT_NE(crossShaderGetCachePath(moreDefines, XPCrossShaderFormat_MSL), path);
+
+    XPCrossShaderInputInfo otherStage = input;
+    otherStage.stage                  = XPCrossShaderStage_Vertex;
+    EXPECT_NE(crossShaderGetCachePath(otherStage, XPCrossShaderFormat_MSL), path);
+}
+
+TEST(CrossShaderCompilerTests, SecondCompilationComesFromTheCache)
+{
+    const XPCrossShaderInputInfo input = createFragmentShader();
+    const std::string            path  = crossShaderGetCachePath(input, XPCrossShaderFormat_GLSL_CORE_410);
+
+    XPCrossShaderOutputInfo miss;
+    miss.format = XPCrossShaderFormat_GLSL_CORE_410;
+    ASSERT_TRUE(crossShaderCompile(input, miss)) << miss.errors;
+    EXPECT_FALSE(miss.fromCache);
+    EXPECT_TRUE(std::filesystem::exists(path));
+
+    XPCrossShaderOutputInfo hit;
+    hit.format = XPCrossShaderFormat_GLSL_CORE_410;
+    ASSERT_TRUE(crossShaderCompile(input, hit)) << hit.errors;
+    EXPECT_TRUE(hit.fromCache);
+    EXPECT_EQ(hit.spirv, miss.spirv);
+    EXPECT_EQ(hit.source, miss.source);
+
+    // a compilation that doesn't use the cache never reads from it either
+    XPCrossShaderInputInfo uncached = input;
+    uncached.useCache               = false;
+    XPCrossShaderOutputInfo output;
+    output.format = XPCrossShaderFormat_GLSL_CORE_410;
+    ASSERT_TRUE(crossShaderCompile(uncached, output)) << output.errors;
+    EXPECT_FALSE(output.fromCache);
+
+    std::filesystem::remove(path);
+}
+
+TEST(CrossShaderCompilerTests, BatchCompilesEveryPermutation)
+{
+    const XPCrossShaderInputInfo            input = createFragmentShader();
+    std::vector<XPCrossShaderOperationInfo> operations(8);
+    for (size_t i = 0; i < operations.size(); ++i) {
+        operations[i].input         = input;
+        operations[i].input.defines = { "INTENSITY=" + std::to_string(i) + ".0" };
+        operations[i].output.format = XPCrossShaderFormat_GLSL_CORE_410;
+    }
+    // the same permutation twice in one batch, both threads may write its cache entry
+    operations.push_back(operations.front());
+
+    ASSERT_TRUE(crossShaderCompileBatch(operations, 4));
+    for (const XPCrossShaderOperationInfo& operation : operations) {
+        EXPECT_TRUE(operation.succeeded) << operation.output.errors;
+        EXPECT_FALSE(operation.output.source.empty());
+    }
+    for (const XPCrossShaderOperationInfo& operation : operations) {
+        std::filesystem::remove(crossShaderGetCachePath(operation.input, operation.output.format));
+    }
+}
@@ -0,0 +1,141 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorDecoder.h>
+#include <Emulator/XPEmulatorProcessor.h>
+
+#include <initializer_list>
+#include <memory>
+
+namespace {
+
+// encodings below were produced by assembling the commented instruction for rv32imfdc, and for rv32imfd for the
+// expanded form
+struct CompressedCase
+{
+    uint16_t compressed;
+    uint32_t expanded;
+};
+
+class EmulatorCompressedTests : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        _processor = std::make_unique<XPEmulatorProcessor>();
+        xp_emulator_processor_initialize(_processor.get());
+    }
+
+    void TearDown() override { xp_emulator_processor_finalize(_processor.get()); }
+
+    // program is a stream of 16 bit parcels, a 32 bit instruction takes two (lower half first)
+    void load(std::initializer_list<uint16_t> parcels)
+    {
+        uint32_t address = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+        for (uint16_t parcel : parcels) {
+            xp_emulator_bus_store(&_processor->bus, address, 16, parcel);
+            address += 2;
+        }
+        _processor->pc = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+    }
+
+    std::unique_ptr<XPEmulatorProcessor> _processor;
+};
+
+} // namespace
+
+TEST_F(EmulatorCompressedTests, ExpansionMatchesTheEquivalentEncoding)
+{
+    const CompressedCase cases[] = {
+        { 0x1fe8, 0x3fc10513 }, // c.addi4spn a0, sp, 1020
+        { 0x5e6c, 0x07c62583 }, // c.lw a1, 124(a2)
+        { 0xc334, 0x04d72023 }, // c.sw a3, 64(a4)
+        { 0x63c8, 0x0047a507 }, // c.flw fa0, 4(a5)
+        { 0xe40c, 0x00b42427 }, // c.fsw fa1, 8(s0)
+        { 0x3cf0, 0x0f84b607 }, // c.fld fa2, 248(s1)
+        { 0xa914, 0x00d53827 }, // c.fsd fa3, 16(a0)
+        { 0x0001, 0x00000013 }, // c.nop
+        { 0x1501, 0xfe050513 }, // c.addi a0, -32
+        { 0x3001, 0x801ff0ef }, // c.jal -2048
+        { 0x42fd, 0x01f00293 }, // c.li t0, 31
+        { 0x7101, 0xe0010113 }, // c.addi16sp sp, -512
+        { 0x617d, 0x1f010113 }, // c.addi16sp sp, 496
+        { 0x737d, 0xfffff337 }, // c.lui t1, 0xfffff
+        { 0x6305, 0x00001337 }, // c.lui t1, 1
+        { 0x817d, 0x01f55513 }, // c.srli a0, 31
+        { 0x8585, 0x4015d593 }, // c.srai a1, 1
+        { 0x9a7d, 0xfff67613 }, // c.andi a2, -1
+        { 0x8e99, 0x40e686b3 }, // c.sub a3, a4
+        { 0x8fa1, 0x0087c7b3 }, // c.xor a5, s0
+        { 0x8cc9, 0x00a4e4b3 }, // c.or s1, a0
+        { 0x8df1, 0x00c5f5b3 }, // c.and a1, a2
+        { 0xaffd, 0x7fe0006f }, // c.j 2046
+        { 0xd101, 0xf00500e3 }, // c.beqz a0, -256
+        { 0xedfd, 0x0e059f63 }, // c.bnez a1, 254
+        { 0x03c6, 0x01139393 }, // c.slli t2, 17
+        { 0x50fe, 0x0fc12083 }, // c.lwsp ra, 252(sp)
+        { 0x600a, 0x08012007 }, // c.flwsp ft0, 128(sp)
+        { 0x30fe, 0x1f813087 }, // c.fldsp ft1, 504(sp)
+        { 0x8082, 0x00008067 }, // c.jr ra
+        { 0x857e, 0x01f00533 }, // c.mv a0, t6
+        { 0x9002, 0x00100073 }, // c.ebreak
+        { 0x9282, 0x000280e7 }, // c.jalr t0
+        { 0x9426, 0x00940433 }, // c.add s0, s1
+        { 0xdf86, 0x0e112e23 }, // c.swsp ra, 252(sp)
+        { 0xe20a, 0x00212227 }, // c.fswsp ft2, 4(sp)
+        { 0xbf8e, 0x1e313c27 }, // c.fsdsp ft3, 504(sp)
+    };
+    for (const CompressedCase& c : cases) {
+        EXPECT_EQ(xp_emulator_decoder_expand_compressed_instruction(c.compressed), c.expanded) << std::hex << c.compressed;
+        struct XPEmulatorEncodedInstruction instr = xp_emulator_decoder_decode_compressed_instruction(c.compressed);
+        EXPECT_NE(instr.type, XPEmulatorEInstructionType_Undefined) << std::hex << c.compressed;
+        EXPECT_EQ(instr.size, 2u);
+    }
+}
+
+TEST_F(EmulatorCompressedTests, ReservedEncodingsAreIllegal)
+{
+    const uint16_t reserved[] = {
+        0x0000, // all zeros
+        0x6101, // c.addi16sp sp, 0
+        0x6501, // c.lui a0, 0
+        0x4002, // c.lwsp zero, 0(sp)
+        0x8002, // c.jr zero
+        0x1002, // c.slli zero, 32 (shamt[5] set on rv32)
+        0x9c41, // c.subw (rv64 only)
+    };
+    for (uint16_t encoding : reserved) {
+        EXPECT_EQ(xp_emulator_decoder_expand_compressed_instruction(encoding), 0u) << std::hex << encoding;
+        EXPECT_EQ(xp_emulator_decoder_decode_compressed_instruction(encoding).type, XPEmulatorEInstructionType_Undefined);
+    }
+}
+
+TEST_F(EmulatorCompressedTests, MixedWidthProgramAdvancesAndLinksByInstructionSize)
+{
+    load({
+      0x4515,         // c.li  a0, 5
+      0x0593, 0x0015, // addi  a1, a0, 1 (only 2 byte aligned)
+      0x2011,         // c.jal 4
+      0x0001,         // c.nop (jumped over)
+      0x862e,         // c.mv  a2, a1
+    });
+    for (int i = 0; i < 4; ++i) { ASSERT_EQ(xp_emulator_processor_step(_processor.get()), 0); }
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg10], 5u);
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg11], 6u);
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg12], 6u);
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg1], XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE + 8u);
+    EXPECT_EQ(_processor->pc, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE + 12u);
+}
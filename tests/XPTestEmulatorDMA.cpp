@@ -0,0 +1,127 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Emulator/XPEmulatorBus.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace {
+
+class EmulatorDMATests : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        _bus = std::make_unique<XPEmulatorBus>();
+        xp_emulator_bus_initialize(_bus.get());
+    }
+
+    void TearDown() override { xp_emulator_bus_finalize(_bus.get()); }
+
+    // writes the descriptors at the start of ram the way a guest would and rings the doorbell
+    void submit(std::initializer_list<std::array<uint32_t, 4>> descriptors)
+    {
+        uint32_t address = DescriptorsBase;
+        for (const auto& descriptor : descriptors) {
+            for (uint32_t word : descriptor) {
+                xp_emulator_bus_store(_bus.get(), address, 32, word);
+                address += 4;
+            }
+        }
+        xp_emulator_bus_store(_bus.get(), XP_EMULATOR_CONFIG_HMM_DMA_DESCRIPTORS_PTR, 32, DescriptorsBase);
+        xp_emulator_bus_store(_bus.get(), XP_EMULATOR_CONFIG_HMM_DMA_COUNT_PTR, 32, (uint32_t)descriptors.size());
+        xp_emulator_bus_store(_bus.get(), XP_EMULATOR_CONFIG_HMM_DMA_DOORBELL_PTR, 32, 1);
+    }
+
+    uint32_t status() { return xp_emulator_bus_load(_bus.get(), XP_EMULATOR_CONFIG_HMM_DMA_STATUS_PTR, 32); }
+    uint32_t completed() { return xp_emulator_bus_load(_bus.get(), XP_EMULATOR_CONFIG_HMM_DMA_COMPLETED_PTR, 32); }
+
+    static constexpr uint32_t DescriptorsBase = XP_EMULATOR_CONFIG_MEMORY_RAM_BASE;
+    static constexpr uint32_t DataBase        = XP_EMULATOR_CONFIG_MEMORY_RAM_BASE + 0x1000;
+
+    std::unique_ptr<XPEmulatorBus> _bus;
+};
+
+} // namespace
+
+TEST_F(EmulatorDMATests, HostBuffersStreamIntoGuestMemoryAndBack)
+{
+    std::vector<float> vertices = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    std::vector<float> readback(vertices.size(), 0.0f);
+    xp_emulator_host_mapped_memory_bind_dma_buffer(&_bus->hostMappedMemory,
+                                                   XP_EMULATOR_CONFIG_HMM_DMA_SLOT_VERTICES,
+                                                   vertices.data(),
+                                                   (uint32_t)(vertices.size() * sizeof(float)),
+                                                   0);
+    xp_emulator_host_mapped_memory_bind_dma_buffer(&_bus->hostMappedMemory,
+                                                   XP_EMULATOR_CONFIG_HMM_DMA_SLOT_TEXTURE,
+                                                   readback.data(),
+                                                   (uint32_t)(readback.size() * sizeof(float)),
+                                                   1);
+
+    const uint32_t bytes = (uint32_t)(vertices.size() * sizeof(float));
+    submit({
+      { 0, DataBase, bytes, XP_EMULATOR_CONFIG_HMM_DMA_KIND(XP_EMULATOR_CONFIG_HMM_DMA_KIND_HOST_READ, 0) },
+      { DataBase, 0, bytes, XP_EMULATOR_CONFIG_HMM_DMA_KIND(XP_EMULATOR_CONFIG_HMM_DMA_KIND_HOST_WRITE, 4) },
+    });
+
+    EXPECT_EQ(status(), XP_EMULATOR_CONFIG_HMM_DMA_STATUS_DONE);
+    EXPECT_EQ(completed(), 2u);
+    EXPECT_EQ(readback, vertices);
+    uint32_t second = xp_emulator_bus_load(_bus.get(), DataBase + 4, 32);
+    EXPECT_EQ(second, 0x40000000u); // 2.0f
+}
+
+TEST_F(EmulatorDMATests, GuestCopyAndFill)
+{
+    submit({
+      { 0xAB, DataBase, 8, XP_EMULATOR_CONFIG_HMM_DMA_KIND_FILL },
+      { DataBase, DataBase + 4, 8, XP_EMULATOR_CONFIG_HMM_DMA_KIND_COPY }, // overlapping
+    });
+    EXPECT_EQ(status(), XP_EMULATOR_CONFIG_HMM_DMA_STATUS_DONE);
+    EXPECT_EQ(xp_emulator_bus_load(_bus.get(), DataBase + 8, 32), 0xABABABABu);
+    EXPECT_EQ(xp_emulator_bus_load(_bus.get(), DataBase + 12, 32), 0u);
+}
+
+TEST_F(EmulatorDMATests, InvalidDescriptorsStopTheRunAndReportTheirIndex)
+{
+    std::array<uint8_t, 16> readOnly = {};
+    xp_emulator_host_mapped_memory_bind_dma_buffer(&_bus->hostMappedMemory, 1, readOnly.data(), 16, 0);
+
+    submit({
+      { 0x11, DataBase, 4, XP_EMULATOR_CONFIG_HMM_DMA_KIND_FILL },
+      { DataBase, 0, 4, XP_EMULATOR_CONFIG_HMM_DMA_KIND(XP_EMULATOR_CONFIG_HMM_DMA_KIND_HOST_WRITE, 1) },
+      { 0x22, DataBase, 4, XP_EMULATOR_CONFIG_HMM_DMA_KIND_FILL },
+    });
+    EXPECT_EQ(status(), XP_EMULATOR_CONFIG_HMM_DMA_STATUS_ERROR);
+    EXPECT_EQ(xp_emulator_bus_load(_bus.get(), XP_EMULATOR_CONFIG_HMM_DMA_ERROR_INDEX_PTR, 32), 1u);
+    EXPECT_EQ(completed(), 1u);
+    EXPECT_EQ(xp_emulator_bus_load(_bus.get(), DataBase, 32), 0x11111111u);
+
+    // flash is never a destination and ranges may not run off the end of a region
+    submit({
+      { 0, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE, 4, XP_EMULATOR_CONFIG_HMM_DMA_KIND_FILL },
+    });
+    EXPECT_EQ(status(), XP_EMULATOR_CONFIG_HMM_DMA_STATUS_ERROR);
+    submit({
+      { 0,
+        XP_EMULATOR_CONFIG_MEMORY_RAM_BASE + XP_EMULATOR_CONFIG_MEMORY_RAM_SIZE - 2,
+        4,
+        XP_EMULATOR_CONFIG_HMM_DMA_KIND_FILL },
+    });
+    EXPECT_EQ(status(), XP_EMULATOR_CONFIG_HMM_DMA_STATUS_ERROR);
+}
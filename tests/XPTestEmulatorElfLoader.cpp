@@ -0,0 +1,194 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorElfLoader.h>
+#include <Emulator/XPEmulatorProcessor.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// encodings below were produced by assembling the commented instruction for rv32i
+const uint32_t kText[] = {
+    0x800005b7, // lui    a1, 0x80000
+    0x0005a503, // lw     a0, 0(a1)
+    0x0045a603, // lw     a2, 4(a1)     past the file backed part of the data segment
+    0x040002b7, // lui    t0, 0x4000
+    0x00a2a023, // sw     a0, 0(t0)     into the mapped text
+    0x0002a683, // lw     a3, 0(t0)
+    0x00100073, // ebreak
+};
+
+class EmulatorElfLoaderTests : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        _path = (std::filesystem::temp_directory_path() / "xp_emulator_elf_loader.elf").string();
+        writeProgram(_path, sizeof(kText));
+    }
+
+    void TearDown() override { std::filesystem::remove(_path); }
+
+    template<typename T>
+    static void put(std::vector<uint8_t>& file, size_t offset, T value)
+    {
+        if (file.size() < offset + sizeof(T)) { file.resize(offset + sizeof(T)); }
+        memcpy(file.data() + offset, &value, sizeof(T));
+    }
+
+    // a 32 bit executable with flash, ram and heap segments and a symbol table naming the entry point
+    // textFileSize lets a test claim more file backed text than the file holds
+    static void writeProgram(const std::string& path, uint32_t textFileSize)
+    {
+        constexpr uint32_t PhOff = 52, TextOff = 0x100, DataOff = 0x200, HeapOff = 0x210;
+        constexpr uint32_t SymOff = 0x220, StrOff = 0x240, ShOff = 0x260;
+        const char         names[] = "\0main";
+
+        std::vector<uint8_t> file;
+        const uint8_t        ident[16] = { 0x7f, 'E', 'L', 'F', 1, 1, 1 };
+        file.assign(ident, ident + 16);
+        put<uint16_t>(file, 16, 2);   // ET_EXEC
+        put<uint16_t>(file, 18, 243); // EM_RISCV
+        put<uint32_t>(file, 20, 1);
+        put<uint32_t>(file, 24, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE);
+        put<uint32_t>(file, 28, PhOff);
+        put<uint32_t>(file, 32, ShOff);
+        put<uint16_t>(file, 40, 52);
+        put<uint16_t>(file, 42, 32);
+        put<uint16_t>(file, 44, 3);
+        put<uint16_t>(file, 46, 40);
+        put<uint16_t>(file, 48, 3);
+
+        struct
+        {
+            uint32_t offset, vaddr, filesz, memsz, flags;
+        } segments[] = {
+            { TextOff, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE, textFileSize, textFileSize, 5 },
+            { DataOff, XP_EMULATOR_CONFIG_MEMORY_RAM_BASE, 4, 8, 6 },
+            { HeapOff, XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE, 4, 16, 6 },
+        };
+        for (size_t i = 0; i < 3; ++i) {
+            const size_t base = PhOff + i * 32;
+            put<uint32_t>(file, base + 0, 1); // PT_LOAD
+            put<uint32_t>(file, base + 4, segments[i].offset);
+            put<uint32_t>(file, base + 8, segments[i].vaddr);
+            put<uint32_t>(file, base + 12, segments[i].vaddr);
+            put<uint32_t>(file, base + 16, segments[i].filesz);
+            put<uint32_t>(file, base + 20, segments[i].memsz);
+            put<uint32_t>(file, base + 24, segments[i].flags);
+            put<uint32_t>(file, base + 28, 4);
+        }
+        for (size_t i = 0; i < sizeof(kText) / sizeof(kText[0]); ++i) { put<uint32_t>(file, TextOff + i * 4, kText[i]); }
+        put<uint32_t>(file, DataOff, 0x1234ABCD);
+        put<uint32_t>(file, HeapOff, 0xCAFEF00D);
+
+        // symbol 0 is the null symbol, symbol 1 is main covering the whole text
+        put<uint32_t>(file, SymOff + 16 + 0, 1);
+        put<uint32_t>(file, SymOff + 16 + 4, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE);
+        put<uint32_t>(file, SymOff + 16 + 8, sizeof(kText));
+        put<uint8_t>(file, SymOff + 16 + 12, 0x12); // STB_GLOBAL | STT_FUNC
+        for (size_t i = 0; i < sizeof(names); ++i) { put<char>(file, StrOff + i, names[i]); }
+
+        // section 0 is the null section, 1 the symbol table linked to 2, the string table
+        put<uint32_t>(file, ShOff + 40 + 4, 2); // SHT_SYMTAB
+        put<uint32_t>(file, ShOff + 40 + 16, SymOff);
+        put<uint32_t>(file, ShOff + 40 + 20, 32);
+        put<uint32_t>(file, ShOff + 40 + 24, 2);
+        put<uint32_t>(file, ShOff + 40 + 36, 16);
+        put<uint32_t>(file, ShOff + 80 + 4, 3); // SHT_STRTAB
+        put<uint32_t>(file, ShOff + 80 + 16, StrOff);
+        put<uint32_t>(file, ShOff + 80 + 20, sizeof(names));
+        file.resize(ShOff + 3 * 40);
+
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+    }
+
+    std::string _path;
+};
+
+} // namespace
+
+TEST_F(EmulatorElfLoaderTests, SegmentsAndSymbolsAreViewsIntoTheMappedFile)
+{
+    RiscvElfLoader* loader = xp_emulator_elf_loader_load(_path.c_str());
+    ASSERT_NE(loader, nullptr);
+    ASSERT_EQ(loader->num_segments, 3);
+
+    const uint8_t* begin = loader->file_data;
+    const uint8_t* end   = loader->file_data + loader->file_size;
+    for (int i = 0; i < loader->num_segments; ++i) {
+        EXPECT_GE(loader->segments[i].data, begin);
+        EXPECT_LE(loader->segments[i].data + loader->segments[i].file_size, end);
+    }
+    EXPECT_EQ(loader->segments[0].data, begin + 0x100);
+    EXPECT_EQ(loader->segments[1].file_size, 4u);
+    EXPECT_EQ(loader->segments[1].size, 8u);
+
+    const ElfSymbol* symbol = xp_emulator_elf_loader_find_symbol(loader, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE + 8);
+    ASSERT_NE(symbol, nullptr);
+    EXPECT_STREQ(symbol->name, "main");
+    EXPECT_GE(reinterpret_cast<const uint8_t*>(symbol->name), begin);
+    EXPECT_LT(reinterpret_cast<const uint8_t*>(symbol->name), end);
+
+    xp_emulator_elf_loader_unload(loader);
+}
+
+TEST_F(EmulatorElfLoaderTests, ProcessorsShareTheMappedTextAndOwnTheirData)
+{
+    RiscvElfLoader* loader = xp_emulator_elf_loader_load(_path.c_str());
+    ASSERT_NE(loader, nullptr);
+
+    auto first  = std::make_unique<XPEmulatorProcessor>();
+    auto second = std::make_unique<XPEmulatorProcessor>();
+    for (XPEmulatorProcessor* processor : { first.get(), second.get() }) {
+        xp_emulator_processor_initialize(processor);
+        // dirty the bss so loading has to clear it
+        xp_emulator_bus_store(&processor->bus, XP_EMULATOR_CONFIG_MEMORY_RAM_BASE + 4, 32, 0xFFFFFFFF);
+        ASSERT_EQ(xp_emulator_processor_load_program(processor, loader), 0);
+    }
+    EXPECT_EQ(first->bus.memory.text, loader->segments[0].data);
+    EXPECT_EQ(second->bus.memory.text, loader->segments[0].data);
+
+    // writable segments are private to each processor
+    xp_emulator_bus_store(&second->bus, XP_EMULATOR_CONFIG_MEMORY_RAM_BASE, 32, 0x55555555);
+    EXPECT_EQ(xp_emulator_processor_run_budget(first.get(), 100, nullptr), XP_EMULATOR_PROGRAM_EXIT_CODE_EBREAK);
+    EXPECT_EQ(first->regs[XPEmulatorEReg10], 0x1234ABCDu);
+    EXPECT_EQ(first->regs[XPEmulatorEReg12], 0u);
+    EXPECT_EQ(xp_emulator_bus_load(&first->bus, XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE, 32), 0xCAFEF00Du);
+
+    // the store into text was dropped, the shared mapping is untouched for the other processor
+    EXPECT_EQ(first->regs[XPEmulatorEReg13], kText[0]);
+    EXPECT_EQ(xp_emulator_processor_run_budget(second.get(), 100, nullptr), XP_EMULATOR_PROGRAM_EXIT_CODE_EBREAK);
+    EXPECT_EQ(second->regs[XPEmulatorEReg10], 0x55555555u);
+    EXPECT_EQ(second->regs[XPEmulatorEReg13], kText[0]);
+
+    xp_emulator_processor_finalize(first.get());
+    xp_emulator_processor_finalize(second.get());
+    xp_emulator_elf_loader_unload(loader);
+}
+
+TEST_F(EmulatorElfLoaderTests, SegmentsPastTheEndOfTheFileAreRejected)
+{
+    writeProgram(_path, 0x10000);
+    EXPECT_EQ(xp_emulator_elf_loader_load(_path.c_str()), nullptr);
+}
@@ -0,0 +1,199 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorProcessor.h>
+
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+
+namespace {
+
+// encodings below were produced by assembling the commented instruction for rv32imfd
+class EmulatorFloatTests : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        _processor = std::make_unique<XPEmulatorProcessor>();
+        xp_emulator_processor_initialize(_processor.get());
+    }
+
+    void TearDown() override { xp_emulator_processor_finalize(_processor.get()); }
+
+    void run(std::initializer_list<uint32_t> program)
+    {
+        uint32_t address = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+        for (uint32_t word : program) {
+            xp_emulator_bus_store(&_processor->bus, address, 32, word);
+            address += 4;
+        }
+        _processor->pc = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+        for (size_t i = 0; i < program.size(); ++i) { ASSERT_EQ(xp_emulator_processor_step(_processor.get()), 0); }
+    }
+
+    static uint32_t bitsOf(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    static float floatOf(uint32_t bits)
+    {
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::unique_ptr<XPEmulatorProcessor> _processor;
+};
+
+} // namespace
+
+TEST_F(EmulatorFloatTests, SingleAddRoundTripsThroughIntegerRegisters)
+{
+    _processor->regs[XPEmulatorEReg10] = bitsOf(1.5f);
+    _processor->regs[XPEmulatorEReg11] = bitsOf(2.25f);
+    run({
+      0xf0050553, // fmv.w.x fa0, a0
+      0xf00585d3, // fmv.w.x fa1, a1
+      0x00b57653, // fadd.s  fa2, fa0, fa1
+      0xe0060653, // fmv.x.w a2, fa2
+    });
+    EXPECT_EQ(floatOf(_processor->regs[XPEmulatorEReg12]), 3.75f);
+    // singles are NaN-boxed in the 64 bit register file
+    EXPECT_EQ(_processor->fregs[12] >> 32, 0xFFFFFFFFu);
+}
+
+TEST_F(EmulatorFloatTests, ConversionHonoursStaticRoundingModes)
+{
+    struct Case
+    {
+        uint32_t encoding;
+        int32_t  expected;
+    };
+    const Case cases[] = {
+        { 0xc0051553, -2 }, // fcvt.w.s a0, fa0, rtz
+        { 0xc0052553, -3 }, // fcvt.w.s a0, fa0, rdn
+        { 0xc0053553, -2 }, // fcvt.w.s a0, fa0, rup
+        { 0xc0054553, -3 }, // fcvt.w.s a0, fa0, rmm
+        { 0xc0050553, -2 }, // fcvt.w.s a0, fa0, rne
+    };
+    for (const Case& c : cases) {
+        _processor->fregs[10] = 0xFFFFFFFF00000000ull | bitsOf(-2.5f);
+        run({ c.encoding });
+        EXPECT_EQ(static_cast<int32_t>(_processor->regs[XPEmulatorEReg10]), c.expected);
+    }
+
+    // negative values saturate unsigned conversions and raise invalid
+    _processor->fcsr      = 0;
+    _processor->fregs[10] = 0xFFFFFFFF00000000ull | bitsOf(-7.0f);
+    run({ 0xc0151553 }); // fcvt.wu.s a0, fa0, rtz
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg10], 0u);
+    EXPECT_EQ(_processor->fcsr & 0x1F, 0x10u);
+}
+
+TEST_F(EmulatorFloatTests, ExceptionFlagsAccrueAndAreReadableThroughCsrs)
+{
+    _processor->fregs[10] = 0xFFFFFFFF00000000ull | bitsOf(1.0f);
+    _processor->fregs[11] = 0xFFFFFFFF00000000ull | bitsOf(0.0f);
+    run({
+      0x18b57653, // fdiv.s  fa2, fa0, fa1
+      0x00102573, // frflags a0
+      0x00101073, // fsflags zero
+    });
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg10], 0x08u); // DZ
+    EXPECT_EQ(_processor->fcsr & 0x1F, 0u);
+    EXPECT_EQ(floatOf(static_cast<uint32_t>(_processor->fregs[12])), std::numeric_limits<float>::infinity());
+}
+
+TEST_F(EmulatorFloatTests, DynamicRoundingModeComesFromFrm)
+{
+    _processor->fregs[10] = 0xFFFFFFFF00000000ull | bitsOf(1.0f);
+    _processor->fregs[11] = 0xFFFFFFFF00000000ull | bitsOf(3.0f);
+    run({
+      0x00215073, // fsrmi  2 (round down)
+      0x18b57653, // fdiv.s fa2, fa0, fa1, dyn
+    });
+    const uint32_t roundedDown = static_cast<uint32_t>(_processor->fregs[12]);
+    run({ 0x18b50653 }); // fdiv.s fa2, fa0, fa1, rne
+    const uint32_t roundedNearest = static_cast<uint32_t>(_processor->fregs[12]);
+
+    EXPECT_EQ(roundedNearest, bitsOf(1.0f / 3.0f));
+    EXPECT_EQ(roundedDown, roundedNearest - 1);
+    EXPECT_EQ((_processor->fcsr >> 5) & 0b111, 2u);
+    EXPECT_EQ(_processor->fcsr & 0x01, 0x01u); // NX
+}
+
+TEST_F(EmulatorFloatTests, DoublePrecisionLoadStoreAndFusedMultiplyAdd)
+{
+    _processor->regs[XPEmulatorEReg10] = static_cast<uint32_t>(-6);
+    _processor->regs[XPEmulatorEReg11] = 7;
+    _processor->regs[XPEmulatorEReg13] = XP_EMULATOR_CONFIG_MEMORY_RAM_BASE + 0x100;
+    run({
+      0xd2050553, // fcvt.d.w fa0, a0
+      0xd20585d3, // fcvt.d.w fa1, a1
+      0x12b57653, // fmul.d   fa2, fa0, fa1
+      0xc2067653, // fcvt.w.d a2, fa2
+      0x00c6b027, // fsd      fa2, 0(a3)
+      0x0006b687, // fld      fa3, 0(a3)
+      0x6ab57743, // fmadd.d  fa4, fa0, fa1, fa3
+    });
+    EXPECT_EQ(static_cast<int32_t>(_processor->regs[XPEmulatorEReg12]), -42);
+    EXPECT_EQ(_processor->fregs[13], _processor->fregs[12]);
+    double fa4 = 0.0;
+    memcpy(&fa4, &_processor->fregs[14], sizeof(fa4));
+    EXPECT_EQ(fa4, -84.0);
+}
+
+TEST_F(EmulatorFloatTests, MinMaxCompareAndClassifyFollowTheSpec)
+{
+    _processor->fregs[10] = 0xFFFFFFFF00000000ull | bitsOf(-0.0f);
+    _processor->fregs[11] = 0xFFFFFFFF00000000ull | bitsOf(0.0f);
+    run({ 0x28b50653 }); // fmin.s fa2, fa0, fa1
+    EXPECT_EQ(static_cast<uint32_t>(_processor->fregs[12]), bitsOf(-0.0f));
+    run({ 0x28b51653 }); // fmax.s fa2, fa0, fa1
+    EXPECT_EQ(static_cast<uint32_t>(_processor->fregs[12]), bitsOf(0.0f));
+    run({ 0xe0051553 }); // fclass.s a0, fa0
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg10], 1u << 3);
+
+    // a quiet NaN makes FEQ false silently but FLT raises invalid, FMIN returns the other operand
+    _processor->fcsr      = 0;
+    _processor->fregs[10] = 0xFFFFFFFF00000000ull | 0x7FC00000u;
+    _processor->fregs[11] = 0xFFFFFFFF00000000ull | bitsOf(2.0f);
+    run({ 0xa0b52553 }); // feq.s a0, fa0, fa1
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg10], 0u);
+    EXPECT_EQ(_processor->fcsr & 0x1F, 0u);
+    run({ 0xa0b51553 }); // flt.s a0, fa0, fa1
+    EXPECT_EQ(_processor->fcsr & 0x1F, 0x10u);
+    run({ 0x28b50653 }); // fmin.s fa2, fa0, fa1
+    EXPECT_EQ(static_cast<uint32_t>(_processor->fregs[12]), bitsOf(2.0f));
+
+    // a single that isn't NaN-boxed reads back as the canonical NaN
+    _processor->fregs[10] = bitsOf(1.0f);
+    run({ 0xe0051553 }); // fclass.s a0, fa0
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg10], 1u << 9);
+}
+
+TEST_F(EmulatorFloatTests, ReservedRoundingModeIsAnIllegalInstruction)
+{
+    _processor->fregs[10] = 0xFFFFFFFF00000000ull | bitsOf(1.0f);
+    xp_emulator_bus_store(&_processor->bus, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE, 32, 0xc0055553); // fcvt.w.s rm=5
+    _processor->pc = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+    EXPECT_EQ(xp_emulator_processor_step(_processor.get()), XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION);
+}
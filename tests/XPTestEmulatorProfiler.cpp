@@ -0,0 +1,161 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorProcessor.h>
+#include <Emulator/XPEmulatorProfiler.h>
+
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+namespace {
+
+// encodings below were produced by assembling the commented instruction for rv32i
+class EmulatorProfilerTests : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        _processor = std::make_unique<XPEmulatorProcessor>();
+        xp_emulator_processor_initialize(_processor.get());
+    }
+
+    void TearDown() override { xp_emulator_processor_finalize(_processor.get()); }
+
+    void load(std::initializer_list<uint32_t> program)
+    {
+        uint32_t address = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+        for (uint32_t word : program) {
+            xp_emulator_bus_store(&_processor->bus, address, 32, word);
+            address += 4;
+        }
+        _processor->pc = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+    }
+
+    void step(int count)
+    {
+        for (int i = 0; i < count; ++i) { ASSERT_EQ(xp_emulator_processor_step(_processor.get()), 0); }
+    }
+
+    std::unique_ptr<XPEmulatorProcessor> _processor;
+};
+
+// main calls f once, f bumps a0 and returns
+const std::initializer_list<uint32_t> CallProgram = {
+    0x00000513, // 0x00 main: li   a0, 0
+    0x00c000ef, // 0x04       jal  ra, f
+    0x00100593, // 0x08       li   a1, 1
+    0x00000013, // 0x0c       nop
+    0x00150513, // 0x10 f:    addi a0, a0, 1
+    0x00008067, // 0x14       ret
+};
+
+} // namespace
+
+TEST_F(EmulatorProfilerTests, CountersReportRetiredInstructions)
+{
+    load({
+      0x00000013, // nop
+      0x00000013, // nop
+      0xc0002573, // rdcycle   a0
+      0xc02025f3, // rdinstret a1
+      0xc0102673, // rdtime    a2
+      0xc80026f3, // rdcycleh  a3
+    });
+    step(6);
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg10], 2u);
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg11], 3u);
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg12], 0u);
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg13], 0u);
+    EXPECT_EQ(_processor->instret, 6u);
+
+    // time follows cycles at the configured rate and the high halves carry past 32 bits
+    _processor->cycle = (5ull << 32) | 0x10;
+    load({ 0xc80026f3 }); // rdcycleh a3
+    step(1);
+    EXPECT_EQ(_processor->regs[XPEmulatorEReg13], 5u);
+    EXPECT_EQ(xp_emulator_processor_time(_processor.get()),
+              _processor->cycle / (XP_EMULATOR_CONFIG_CLOCK_FREQUENCY_HZ / XP_EMULATOR_CONFIG_TIMER_FREQUENCY_HZ));
+}
+
+TEST_F(EmulatorProfilerTests, CountersAreReadOnly)
+{
+    load({ 0xc0051073 }); // csrw cycle, a0
+    EXPECT_EQ(xp_emulator_processor_step(_processor.get()), XP_EMULATOR_PROGRAM_EXIT_CODE_UNDEFINED_INSTRUCTION);
+}
+
+TEST_F(EmulatorProfilerTests, SamplesAreSymbolizedAndFolded)
+{
+    XPEmulatorProfiler profiler;
+    xp_emulator_profiler_initialize(&profiler, 1);
+    _processor->profiler = &profiler;
+
+    load(CallProgram);
+    step(5); // li, jal, addi, ret, li
+
+    EXPECT_EQ(profiler.totalSamples, 5u);
+    EXPECT_EQ(profiler.callDepth, 0u);
+
+    XPEmulatorProfilerPcHits pcs[8];
+    ASSERT_EQ(xp_emulator_profiler_pc_histogram(&profiler, pcs, 8), 5u);
+    EXPECT_EQ(pcs[0].hits, 1u);
+
+    ElfSymbol      symbols[] = { { XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE, 0x10, "main" },
+                                 { XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE + 0x10, 0x08, "f" } };
+    RiscvElfLoader loader;
+    memset(&loader, 0, sizeof(loader));
+    loader.symbols     = symbols;
+    loader.num_symbols = 2;
+
+    XPEmulatorProfilerFunctionHits functions[4];
+    ASSERT_EQ(xp_emulator_profiler_function_histogram(&profiler, &loader, functions, 4), 2u);
+    EXPECT_STREQ(functions[0].name, "main");
+    EXPECT_EQ(functions[0].hits, 3u);
+    EXPECT_STREQ(functions[1].name, "f");
+    EXPECT_EQ(functions[1].hits, 2u);
+
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(xp_emulator_profiler_write_folded(&profiler, &loader, file), 0);
+    char buffer[256] = {};
+    rewind(file);
+    fread(buffer, 1, sizeof(buffer) - 1, file);
+    fclose(file);
+    const std::string folded(buffer);
+    EXPECT_EQ(folded, "main 3\nmain;f 2\n");
+
+    xp_emulator_profiler_finalize(&profiler);
+}
+
+TEST_F(EmulatorProfilerTests, SamplingIntervalAndReset)
+{
+    XPEmulatorProfiler profiler;
+    xp_emulator_profiler_initialize(&profiler, 2);
+    _processor->profiler = &profiler;
+
+    load(CallProgram);
+    step(5);
+    EXPECT_EQ(profiler.totalSamples, 2u);
+
+    xp_emulator_profiler_reset(&profiler);
+    EXPECT_EQ(profiler.totalSamples, 0u);
+    XPEmulatorProfilerPcHits pcs[8];
+    EXPECT_EQ(xp_emulator_profiler_pc_histogram(&profiler, pcs, 8), 0u);
+
+    xp_emulator_profiler_finalize(&profiler);
+}
@@ -0,0 +1,178 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorProcessor.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace {
+
+class EmulatorSyscallTests : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        _processor = std::make_unique<XPEmulatorProcessor>();
+        xp_emulator_processor_initialize(_processor.get());
+        _path = (std::filesystem::temp_directory_path() / "xp_emulator_syscalls.bin").string();
+        std::ofstream out(_path, std::ios::binary);
+        for (int i = 0; i < 8192; ++i) { out.put(static_cast<char>(i & 0xFF)); }
+    }
+
+    void TearDown() override
+    {
+        xp_emulator_processor_finalize(_processor.get());
+        std::filesystem::remove(_path);
+    }
+
+    // runs a single ecall the way the guest runtime issues it and returns a0
+    static int32_t syscall(XPEmulatorProcessor* processor,
+                           uint32_t             number,
+                           uint32_t             a0 = 0,
+                           uint32_t             a1 = 0,
+                           uint32_t             a2 = 0,
+                           uint32_t             a3 = 0,
+                           uint32_t             a4 = 0,
+                           uint32_t             a5 = 0)
+    {
+        xp_emulator_bus_store(&processor->bus, XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE, 32, 0x00000073); // ecall
+        processor->pc                      = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+        processor->regs[XPEmulatorEReg17] = number;
+        processor->regs[XPEmulatorEReg10] = a0;
+        processor->regs[XPEmulatorEReg11] = a1;
+        processor->regs[XPEmulatorEReg12] = a2;
+        processor->regs[XPEmulatorEReg13] = a3;
+        processor->regs[XPEmulatorEReg14] = a4;
+        processor->regs[XPEmulatorEReg15] = a5;
+        EXPECT_EQ(xp_emulator_processor_step(processor), 0);
+        return static_cast<int32_t>(processor->regs[XPEmulatorEReg10]);
+    }
+
+    int32_t open(XPEmulatorProcessor* processor)
+    {
+        uint32_t address = PathAddress;
+        for (char c : _path) { xp_emulator_bus_store(&processor->bus, address++, 8, static_cast<uint8_t>(c)); }
+        xp_emulator_bus_store(&processor->bus, address, 8, 0);
+        return syscall(processor, XP_EMULATOR_SYSCALL_OPEN, static_cast<uint32_t>(-100), PathAddress, 0, 0);
+    }
+
+    uint32_t loadByte(uint32_t address) { return xp_emulator_bus_load(&_processor->bus, address, 8); }
+
+    static constexpr uint32_t PathAddress   = XP_EMULATOR_CONFIG_MEMORY_RAM_BASE;
+    static constexpr uint32_t BufferAddress = XP_EMULATOR_CONFIG_MEMORY_RAM_BASE + 0x1000;
+
+    std::unique_ptr<XPEmulatorProcessor> _processor;
+    std::string                          _path;
+};
+
+} // namespace
+
+TEST_F(EmulatorSyscallTests, ManyFilesReadIndependently)
+{
+    const int32_t first  = open(_processor.get());
+    const int32_t second = open(_processor.get());
+    ASSERT_GT(first, XP_EMULATOR_STDERR_FILENO);
+    ASSERT_NE(first, second);
+
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_READ, first, BufferAddress, 4), 4);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_LSEEK, second, 300, SEEK_SET), 300);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_READ, second, BufferAddress + 4, 1), 1);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_READ, first, BufferAddress + 5, 1), 1);
+    EXPECT_EQ(loadByte(BufferAddress + 3), 3u);
+    EXPECT_EQ(loadByte(BufferAddress + 4), 300u & 0xFF);
+    EXPECT_EQ(loadByte(BufferAddress + 5), 4u);
+
+    // pread doesn't move the file position
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_PREAD, first, BufferAddress, 2, 1000, 0), 2);
+    EXPECT_EQ(loadByte(BufferAddress + 1), 1001u & 0xFF);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_LSEEK, first, 0, SEEK_CUR), 5);
+
+    // reads past the end of guest memory fault instead of scribbling over the host
+    const uint32_t ramEnd = XP_EMULATOR_CONFIG_MEMORY_RAM_BASE + XP_EMULATOR_CONFIG_MEMORY_RAM_SIZE;
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_READ, first, ramEnd - 2, 4), -XP_EMULATOR_EFAULT);
+
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_CLOSE, first), 0);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_CLOSE, first), -XP_EMULATOR_EBADF);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_READ, second, BufferAddress, 1), 1);
+}
+
+TEST_F(EmulatorSyscallTests, BreakGrowsWithinTheHeap)
+{
+    const int32_t start = syscall(_processor.get(), XP_EMULATOR_SYSCALL_BRK, 0);
+    EXPECT_EQ(static_cast<uint32_t>(start), XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_BRK, start + 4096), start + 4096);
+    // asking for more than the heap holds leaves the break alone
+    const uint32_t tooFar = XP_EMULATOR_CONFIG_MEMORY_HEAP_BASE + XP_EMULATOR_CONFIG_MEMORY_HEAP_SIZE + 1;
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_BRK, tooFar), start + 4096);
+}
+
+TEST_F(EmulatorSyscallTests, MmapExposesTheFileReadOnly)
+{
+    const int32_t fd = open(_processor.get());
+    // offset is in 4096 byte units
+    const int32_t address = syscall(_processor.get(), XP_EMULATOR_SYSCALL_MMAP, 0, 100, 1, 2, fd, 1);
+    ASSERT_GT(static_cast<uint32_t>(address), XP_EMULATOR_CONFIG_FILE_MAPPING_BASE - 1);
+    EXPECT_EQ(xp_emulator_bus_load(&_processor->bus, address, 32), 0x03020100u);
+    EXPECT_EQ(loadByte(address + 99), 99u);
+    EXPECT_EQ(loadByte(address + 100), 0u);
+
+    // the window can't be written and the mapping outlives the fd
+    xp_emulator_bus_store(&_processor->bus, address, 8, 0xFF);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_CLOSE, fd), 0);
+    EXPECT_EQ(loadByte(address), 0u);
+
+    // guest writes can source straight from the mapping
+    const int32_t out = open(_processor.get());
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_WRITE, XP_EMULATOR_STDOUT_FILENO, address, 0), 0);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_MMAP, 0, 16, 3, 2, out, 0), -XP_EMULATOR_EACCES);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_MMAP, 0, 16, 1, 2, out, 64), -XP_EMULATOR_ENOMEM);
+
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_MUNMAP, address, 100), 0);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_MUNMAP, address, 100), -XP_EMULATOR_EINVAL);
+}
+
+TEST_F(EmulatorSyscallTests, ClocksFollowRetiredCycles)
+{
+    const uint32_t timespec = BufferAddress;
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_CLOCKGETTIME, 1, timespec), 0);
+    const uint32_t first = xp_emulator_bus_load(&_processor->bus, timespec + 8, 32);
+    _processor->cycle += XP_EMULATOR_CONFIG_CLOCK_FREQUENCY_HZ / 1000; // 1 ms
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_CLOCKGETTIME, 1, timespec), 0);
+    const uint32_t second = xp_emulator_bus_load(&_processor->bus, timespec + 8, 32);
+    // the single cycle the first ecall retired is below the 1 MHz timer resolution
+    EXPECT_EQ(second - first, 1000000u);
+
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_GETTIMEOFDAY, timespec, 0), 0);
+    EXPECT_EQ(xp_emulator_bus_load(&_processor->bus, timespec + 8, 32), second / 1000u);
+}
+
+TEST_F(EmulatorSyscallTests, ProcessorsDoNotShareDescriptors)
+{
+    auto other = std::make_unique<XPEmulatorProcessor>();
+    xp_emulator_processor_initialize(other.get());
+
+    const int32_t fd = open(_processor.get());
+    EXPECT_EQ(syscall(other.get(), XP_EMULATOR_SYSCALL_READ, fd, BufferAddress, 1), -XP_EMULATOR_EBADF);
+    EXPECT_EQ(open(other.get()), fd);
+    EXPECT_EQ(syscall(other.get(), XP_EMULATOR_SYSCALL_CLOSE, fd), 0);
+    EXPECT_EQ(syscall(_processor.get(), XP_EMULATOR_SYSCALL_READ, fd, BufferAddress, 1), 1);
+
+    xp_emulator_processor_finalize(other.get());
+}
@@ -0,0 +1,128 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Utilities/XPLogger.h>
+
+#include <thread>
+
+TEST(LoggerTests, FormatMatchesPrintf)
+{
+    char expected[256];
+    snprintf(expected,
+             sizeof(expected),
+             "%d %u %lu %zu %.3f %s %08X %c %*d %lld %p %%",
+             -5,
+             7u,
+             9ul,
+             static_cast<size_t>(11),
+             3.14159,
+             "text",
+             255u,
+             'q',
+             6,
+             42,
+             -1234567890123ll,
+             reinterpret_cast<void*>(0x1000));
+    EXPECT_EQ(XPLogger::format("%d %u %lu %zu %.3f %s %08X %c %*d %lld %p %%",
+                               -5,
+                               7u,
+                               9ul,
+                               static_cast<size_t>(11),
+                               3.14159,
+                               "text",
+                               255u,
+                               'q',
+                               6,
+                               42,
+                               -1234567890123ll,
+                               reinterpret_cast<void*>(0x1000)),
+              std::string(expected));
+}
+
+TEST(LoggerTests, FormatCopiesStrings)
+{
+    std::string text = "transient";
+    std::string line = XPLogger::format("[%s] [%s]", text.c_str(), static_cast<const char*>(nullptr));
+    text.assign("overwritten");
+    EXPECT_EQ(line, "[transient] [(null)]");
+}
+
+TEST(LoggerTests, FormatKeepsUnmatchedConversions)
+{
+    EXPECT_EQ(XPLogger::format("value %d and %s"), "value %d and %s");
+    EXPECT_EQ(XPLogger::format("value %d", 3), "value 3");
+}
+
+TEST(LoggerTests, RecordsFromAllThreadsReachTheSinks)
+{
+    XPLogger& logger = XPLogger::instance();
+    logger.setStdoutEnabled(false);
+    logger.flush();
+
+    std::vector<XPLoggerLine> lines;
+    uint64_t                  cursor = 0;
+    logger.copyRecentLines(lines, cursor);
+    lines.clear();
+
+    constexpr int            NumThreads        = 4;
+    constexpr int            NumLinesPerThread = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NumThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < NumLinesPerThread; ++i) {
+                XP_LOGV(XPLoggerSeverityWarning, "logger test %d %d", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    logger.flush();
+    logger.copyRecentLines(lines, cursor);
+    logger.setStdoutEnabled(true);
+
+    std::vector<int> nextLine(NumThreads, 0);
+    for (const auto& line : lines) {
+        int t = 0, i = 0;
+        if (sscanf(line.text.c_str(), "logger test %d %d", &t, &i) != 2) { continue; }
+        EXPECT_EQ(line.severity, XPLoggerSeverityWarning);
+        // lines of a single thread come out in the order they were logged
+        EXPECT_EQ(i, nextLine[t]);
+        nextLine[t] = i + 1;
+    }
+    for (int t = 0; t < NumThreads; ++t) { EXPECT_EQ(nextLine[t], NumLinesPerThread); }
+}
+
+TEST(LoggerTests, RuntimeSeverityFilter)
+{
+    XPLogger& logger = XPLogger::instance();
+    logger.setStdoutEnabled(false);
+    logger.flush();
+
+    std::vector<XPLoggerLine> lines;
+    uint64_t                  cursor = 0;
+    logger.copyRecentLines(lines, cursor);
+    lines.clear();
+
+    logger.setMinSeverity(XPLoggerSeverityError);
+    XP_LOG(XPLoggerSeverityWarning, "filtered out");
+    XP_LOG(XPLoggerSeverityError, "kept");
+    logger.setMinSeverity(XPLoggerSeverityInfo);
+    logger.flush();
+    logger.copyRecentLines(lines, cursor);
+    logger.setStdoutEnabled(true);
+
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0].text, "kept");
+    EXPECT_EQ(lines[0].severity, XPLoggerSeverityError);
+}
@@ -0,0 +1,203 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <Engine/XPRegistry.h>
+#include <Mcp/XPMcpServer.h>
+#include <Utilities/XPProfiler.h>
+#include <gtest/gtest.h>
+
+#if defined(XP_MCP_SERVER) && !defined(XP_PLATFORM_WINDOWS) && !defined(XP_PLATFORM_EMSCRIPTEN)
+
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+
+    #include <chrono>
+    #include <cstdlib>
+    #include <deque>
+    #include <filesystem>
+    #include <fstream>
+    #include <string>
+
+class McpServerTests : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        const std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        socketPath = (std::filesystem::temp_directory_path() / ("XPTestMcpServer_" + name + ".sock")).string();
+        setenv("XP_MCP_SOCKET", socketPath.c_str(), 1);
+        server = new XPMcpServer(&registry);
+        server->initialize();
+        unsetenv("XP_MCP_SOCKET");
+
+        sockaddr_un address = {};
+        address.sun_family  = AF_UNIX;
+        ASSERT_LT(socketPath.size(), sizeof(address.sun_path));
+        memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+        client = socket(AF_UNIX, SOCK_STREAM, 0);
+        ASSERT_EQ(connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    }
+    void TearDown() override
+    {
+        if (client >= 0) { close(client); }
+        server->finalize();
+        delete server;
+    }
+
+    void sendLine(std::string line)
+    {
+        line += "\n";
+        for (size_t offset = 0; offset < line.size();) {
+            const ssize_t numBytes = send(client, line.data() + offset, line.size() - offset, 0);
+            ASSERT_GT(numBytes, 0);
+            offset += static_cast<size_t>(numBytes);
+        }
+    }
+
+    // executes requests on this thread like the engine loop does until a whole line arrived, empty after the timeout
+    std::string receiveLine(std::chrono::milliseconds timeout = std::chrono::seconds(5))
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            if (size_t newline = received.find('\n'); newline != std::string::npos) {
+                std::string line = received.substr(0, newline);
+                received.erase(0, newline + 1);
+                return line;
+            }
+            if (std::chrono::steady_clock::now() > deadline) { return std::string(); }
+            server->update();
+            pollfd fd = { client, POLLIN, 0 };
+            if (poll(&fd, 1, 10) > 0) {
+                char          buffer[16 * 1024];
+                const ssize_t numBytes = recv(client, buffer, sizeof(buffer), 0);
+                if (numBytes > 0) { received.append(buffer, static_cast<size_t>(numBytes)); }
+            }
+        }
+    }
+
+    nlohmann::json receiveMessage()
+    {
+        const std::string line = receiveLine();
+        EXPECT_FALSE(line.empty()) << "no response";
+        return nlohmann::json::parse(line, nullptr, false);
+    }
+
+    XPRegistry   registry = XPRegistry(nullptr);
+    XPMcpServer* server   = nullptr;
+    std::string  socketPath;
+    int          client = -1;
+    std::string  received;
+};
+
+TEST_F(McpServerTests, BatchAnswersOnlyRequestsOnOneLine)
+{
+    sendLine(R"([{"jsonrpc":"2.0","id":1,"method":"engine.getState"},)"
+             R"({"jsonrpc":"2.0","method":"engine.pause"},)"
+             R"({"jsonrpc":"2.0","id":"two","method":"engine.unknown"}])");
+    const nlohmann::json batch = receiveMessage();
+    ASSERT_TRUE(batch.is_array());
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[0]["id"], 1);
+    EXPECT_EQ(batch[0]["result"]["paused"], false);
+    EXPECT_EQ(batch[1]["id"], "two");
+    EXPECT_EQ(batch[1]["error"]["code"], -32601);
+
+    // a batch of notifications is executed without an answer, the next line belongs to the next request
+    sendLine(R"([{"jsonrpc":"2.0","method":"engine.resume"},{"jsonrpc":"2.0","method":"engine.pause"}])");
+    sendLine(R"({"jsonrpc":"2.0","id":3,"method":"engine.getState"})");
+    const nlohmann::json state = receiveMessage();
+    EXPECT_EQ(state["id"], 3);
+    EXPECT_EQ(state["result"]["paused"], true);
+
+    sendLine("[]");
+    const nlohmann::json empty = receiveMessage();
+    EXPECT_TRUE(empty.is_object());
+    EXPECT_EQ(empty["error"]["code"], -32600);
+}
+
+TEST_F(McpServerTests, NotificationsNeverReachTheClient)
+{
+    // enough counters for a result several times the size of the chunks handed to the socket thread
+    static std::deque<std::string> functions;
+    for (size_t i = functions.size(); i < 2048; ++i) {
+        functions.push_back("XPTestMcpServer_" + std::string(96, 'f') + "_" + std::to_string(i));
+        XPProfiler::instance().entry(__FILE__, functions.back().c_str(), __LINE__);
+        XPProfiler::instance().exit(__FILE__, functions.back().c_str(), __LINE__);
+    }
+
+    sendLine(R"({"jsonrpc":"2.0","method":"profiler.getCounters"})");
+    sendLine(R"([{"jsonrpc":"2.0","method":"profiler.getCounters"}])");
+    sendLine(R"({"jsonrpc":"2.0","id":1,"method":"engine.getState"})");
+    const nlohmann::json state = receiveMessage();
+    EXPECT_EQ(state["id"], 1);
+    EXPECT_TRUE(state.contains("result"));
+
+    // the same result asked for with an id arrives whole, however many chunks it took
+    sendLine(R"({"jsonrpc":"2.0","id":2,"method":"profiler.getCounters"})");
+    const std::string line = receiveLine();
+    EXPECT_GT(line.size(), 4u * 64 * 1024);
+    const nlohmann::json counters = nlohmann::json::parse(line, nullptr, false);
+    ASSERT_FALSE(counters.is_discarded());
+    EXPECT_EQ(counters["id"], 2);
+    EXPECT_GE(counters["result"].size(), 2048u);
+    EXPECT_TRUE(receiveLine(std::chrono::milliseconds(100)).empty());
+}
+
+TEST_F(McpServerTests, ParseErrorsAreAnsweredWithoutDroppingTheConnection)
+{
+    sendLine(R"({"jsonrpc":"2.0","id":1,"method")");
+    const nlohmann::json error = receiveMessage();
+    EXPECT_TRUE(error["id"].is_null());
+    EXPECT_EQ(error["error"]["code"], -32700);
+
+    // blank lines are skipped, the connection keeps serving requests after the broken one
+    sendLine("   ");
+    sendLine(R"({"jsonrpc":"2.0","id":2,"method":"engine.getState"})");
+    const nlohmann::json state = receiveMessage();
+    EXPECT_EQ(state["id"], 2);
+    EXPECT_TRUE(state.contains("result"));
+}
+
+TEST_F(McpServerTests, OnlyTheOwnerCanConnect)
+{
+    struct stat info = {};
+    ASSERT_EQ(lstat(socketPath.c_str(), &info), 0);
+    EXPECT_TRUE(S_ISSOCK(info.st_mode));
+    EXPECT_EQ(info.st_mode & 0777, 0600u);
+}
+
+TEST(McpServerSocketTests, FilesThatAreNotSocketsAreNotRemoved)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "XPTestMcpServer_NotASocket").string();
+    {
+        std::ofstream file(path);
+        file << "not a socket";
+    }
+    setenv("XP_MCP_SOCKET", path.c_str(), 1);
+    XPRegistry  registry(nullptr);
+    XPMcpServer server(&registry);
+    server.initialize();
+    unsetenv("XP_MCP_SOCKET");
+    server.finalize();
+
+    std::ifstream     file(path);
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(contents, "not a socket");
+    std::filesystem::remove(path);
+}
+
+#endif
@@ -0,0 +1,95 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Utilities/XPNameIndex.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::vector<uint32_t>
+findLinear(const std::vector<std::string>& names, std::string query)
+{
+    std::transform(query.begin(), query.end(), query.begin(), ::tolower);
+    std::vector<uint32_t> results;
+    for (uint32_t i = 0; i < names.size(); ++i) {
+        std::string name = names[i];
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        if (name.find(query) != std::string::npos) { results.push_back(i); }
+    }
+    return results;
+}
+
+TEST(NameIndexTests, MatchesSubstringsIgnoringCase)
+{
+    XPNameIndex index;
+    index.add("Cube");
+    index.add("SpotLight");
+    index.add("cube.001");
+    index.add("");
+    index.add("Light Probe");
+    index.build();
+
+    std::vector<uint32_t> results;
+    index.find("cube", results);
+    EXPECT_EQ(results, std::vector<uint32_t>({ 0, 2 }));
+    index.find("LIGHT", results);
+    EXPECT_EQ(results, std::vector<uint32_t>({ 1, 4 }));
+    index.find("t p", results);
+    EXPECT_EQ(results, std::vector<uint32_t>({ 4 }));
+    index.find("xyz", results);
+    EXPECT_TRUE(results.empty());
+    index.find("", results);
+    EXPECT_EQ(results.size(), 5u);
+}
+
+TEST(NameIndexTests, MatchesLinearScan)
+{
+    std::mt19937             rng(7);
+    std::vector<std::string> names;
+    const char*              words[] = { "Mesh", "light", "Camera", "node", "cube", "_", ".", "0", "1", "2" };
+    XPNameIndex              index;
+    for (int i = 0; i < 5000; ++i) {
+        std::string name;
+        for (int w = 0, n = 1 + static_cast<int>(rng() % 4); w < n; ++w) { name += words[rng() % 10]; }
+        names.push_back(name);
+        EXPECT_EQ(index.add(name), static_cast<uint32_t>(i));
+    }
+    index.build();
+
+    // typing one character at a time goes through the narrowing path, the rest hit the postings or the scan
+    std::vector<uint32_t> results;
+    for (const char* query : { "c", "ca", "cam", "came", "camera1", "e_", "enode", "1.", "light", "ghtcu", "0.1" }) {
+        index.find(query, results);
+        EXPECT_EQ(results, findLinear(names, query)) << query;
+    }
+}
+
+TEST(NameIndexTests, FindsAmongHundredThousandNamesQuickly)
+{
+    XPNameIndex index;
+    for (int i = 0; i < 100000; ++i) { index.add("node " + std::to_string(i) + (i % 2 ? " mesh" : " light")); }
+    index.build();
+
+    std::vector<uint32_t> results;
+    const auto            start = std::chrono::steady_clock::now();
+    index.find("98 l", results);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(results.size(), 1000u);
+    // generous bound so sanitizer and debug builds pass, an optimized build stays well under a millisecond
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 50);
+}
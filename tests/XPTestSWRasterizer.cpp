@@ -0,0 +1,283 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#if defined(XP_RENDERER_SW) && defined(XP_SW_RASTERIZER_ENABLE)
+
+    #include <Renderer/SW/XPSWFrameOutput.h>
+    #include <Renderer/SW/XPSWLightGrid.h>
+    #include <Renderer/SW/XPSWRasterizer.h>
+    #include <Renderer/SW/XPSWRenderer.h>
+    #include <Renderer/SW/XPSWShadowMaps.h>
+    #include <SceneDescriptor/Attachments/XPFreeCamera.h>
+    #include <gtest/gtest.h>
+
+    #include <algorithm>
+    #include <cfloat>
+    #include <string>
+    #include <utility>
+
+// a quad facing the camera at depth z, spanning [-extent, extent] on x and y
+static void
+addQuad(XPSWScene<float>& scene, float extent, float z, uint32_t materialIndex, float ao)
+{
+    scene.meshes.push_back({});
+    XPSWMesh<float>& mesh = scene.meshes.back();
+    mesh.name             = "quad " + std::to_string(materialIndex);
+    mesh.transform        = XPMat4<float>::identity();
+    mesh.positionsStorage = { XPVec4<float>{ -extent, -extent, z, 1.0f },
+                              XPVec4<float>{ -extent, extent, z, 1.0f },
+                              XPVec4<float>{ extent, extent, z, 1.0f },
+                              XPVec4<float>{ extent, -extent, z, 1.0f } };
+    mesh.normalsStorage.assign(4, XPVec4<float>{ 0.0f, 0.0f, -1.0f, 0.0f });
+    mesh.texCoordsStorage.assign(4, XPVec4<float>{ 0.0f, 0.0f, 0.0f, 0.0f });
+    mesh.indicesStorage = { 0, 1, 2, 0, 2, 3 };
+    mesh.bindStorage();
+    mesh.boundingBox.min = XPVec3<float>{ -extent, -extent, z };
+    mesh.boundingBox.max = XPVec3<float>{ extent, extent, z };
+    mesh.materialIndex   = materialIndex;
+
+    XPSWMaterial<float>& material    = scene.materials[materialIndex];
+    material.name                    = mesh.name;
+    material.hasBaseColorTexture     = false;
+    material.hasNormalMapTexture     = false;
+    material.hasEmissionColorTexture = false;
+    material.hasMetallicTexture      = false;
+    material.hasRoughnessTexture     = false;
+    material.hasAOTexture            = false;
+    material.baseColorValue          = XPVec3<float>{ 1.0f, 1.0f, 1.0f };
+    material.emissionColorValue      = XPVec3<float>{ 0.0f, 0.0f, 0.0f };
+    material.metallicValue           = 0.0f;
+    material.roughnessValue          = 0.5f;
+    material.aoValue                 = ao;
+}
+
+// a bright quad in front of a larger dark one, dimly lit from where the cameras look at them so that neither of them
+// saturates
+static void
+createOverlappingQuads(XPSWScene<float>& scene)
+{
+    scene.filepath = "overlapping quads";
+    addQuad(scene, 0.5f, -1.0f, 0, 1.0f);
+    addQuad(scene, 1.5f, 0.0f, 1, 0.1f);
+
+    scene.lights.push_back({});
+    XPSWLight<float>& light    = scene.lights.back();
+    light.name                 = "light";
+    light.location             = XPVec3<float>{ 0.0f, 0.0f, -5.0f };
+    light.direction            = XPVec3<float>{ 0.0f, 0.0f, 1.0f };
+    light.ambient              = XPVec3<float>{ 0.1f, 0.1f, 0.1f };
+    light.diffuse              = XPVec3<float>{ 1.0f, 1.0f, 1.0f };
+    light.specular             = XPVec3<float>{ 0.0f, 0.0f, 0.0f };
+    light.intensity            = 1.0f;
+    light.attenuationConstant  = 1.0f;
+    light.attenuationLinear    = 0.0f;
+    light.attenuationQuadratic = 0.01f;
+    light.type                 = XPSWELightType_Point;
+    light.angleInnerCone       = 20.0f;
+    light.angleOuterCone       = 45.0f;
+}
+
+static void
+addCamera(XPSWScene<float>& scene, const XPVec2<uint32_t>& resolution)
+{
+    scene.cameras.push_back({});
+    XPSWCamera<float>& camera = scene.cameras.back();
+    camera.name               = "camera";
+    camera.fov                = 60.0f;
+    camera.resolution         = resolution;
+    camera.zNearPlane         = 0.1f;
+    camera.zFarPlane          = 100.0f;
+    camera.location           = XPVec3<float>{ 0.0f, 0.0f, -5.0f };
+    camera.target             = XPVec3<float>{ 0.0f, 0.0f, 0.0f };
+    camera.up                 = XPVec3<float>{ 0.0f, 1.0f, 0.0f };
+    camera.updateMatrices();
+}
+
+static XPVec4<float>
+colorAt(const XPSWCamera<float>& camera, uint32_t x, uint32_t y)
+{
+    const float* pixel = &camera.colorBuffer[4 * (static_cast<size_t>(y) * camera.resolution.x + x)];
+    return XPVec4<float>{ pixel[0], pixel[1], pixel[2], pixel[3] };
+}
+
+TEST(SWRasterizerTests, ColorPassAgreesWithDepthPrePassOffDefaultResolution)
+{
+    for (const XPVec2<uint32_t>& resolution : { XPVec2<uint32_t>{ 640, 360 }, XPVec2<uint32_t>{ 300, 500 } }) {
+        XPSWScene<float> scene;
+        createOverlappingQuads(scene);
+        addCamera(scene, resolution);
+
+        XPSWRasterizer<float>       rasterizer(nullptr);
+        XPSWRasterizerEventListener listener;
+        rasterizer.setScene(&scene);
+        rasterizer.render(listener);
+
+        // every pixel the pre-pass covered has to be shaded by the color pass and nothing else
+        const XPSWCamera<float>& camera       = scene.cameras[0];
+        size_t                   numCovered   = 0;
+        size_t                   numDisagreed = 0;
+        for (uint32_t y = 0; y < resolution.y; ++y) {
+            for (uint32_t x = 0; x < resolution.x; ++x) {
+                const bool covered = camera.getDepthBufferPixel(x, y) != FLT_MAX;
+                const bool shaded  = colorAt(camera, x, y).w == 1.0f;
+                numCovered += covered ? 1 : 0;
+                numDisagreed += covered != shaded ? 1 : 0;
+            }
+        }
+        EXPECT_GT(numCovered, 0u);
+        EXPECT_EQ(numDisagreed, 0u) << resolution.x << "x" << resolution.y;
+
+        // the front quad wins the depth test in the middle, the back one is only seen around it
+        const uint32_t centerX = resolution.x / 2;
+        const uint32_t borderX = centerX + static_cast<uint32_t>(resolution.y * 0.16f);
+        const uint32_t y       = resolution.y / 2;
+        EXPECT_LT(camera.getDepthBufferPixel(centerX, y), camera.getDepthBufferPixel(borderX, y));
+        EXPECT_GT(colorAt(camera, centerX, y).x, 2.0f * colorAt(camera, borderX, y).x);
+    }
+}
+
+TEST(SWRendererTests, HeadlessFrameOfAFreeCameraHasItsResolution)
+{
+    // free cameras are 1024x720 until a viewport resizes them, headless runs never do
+    FreeCamera freeCamera(nullptr);
+    freeCamera.activeProperties.location = XPVec3<float>(0.0f, 0.0f, -5.0f);
+    freeCamera.activeProperties.euler    = XPVec3<float>(0.0f, 180.0f, 0.0f);
+    freeCamera.activeProperties.znear    = 0.1f;
+    freeCamera.activeProperties.zfar     = 100.0f;
+
+    XPSWScene<float> scene;
+    createOverlappingQuads(scene);
+    scene.cameras.push_back({});
+    ASSERT_TRUE(XPSWRenderer::importFreeCamera("camera", freeCamera.activeProperties, scene.cameras.back()));
+    EXPECT_EQ(scene.cameras[0].resolution.x, 1024u);
+    EXPECT_EQ(scene.cameras[0].resolution.y, 720u);
+
+    XPSWFrameOutputSettings settings;
+    settings.sink = XPSWEFrameOutputSink_Memory;
+    XPSWFrameOutput             frameOutput(settings);
+    XPSWRasterizer<float>       rasterizer(nullptr);
+    XPSWRasterizerEventListener listener;
+    rasterizer.frameOutput = &frameOutput;
+    rasterizer.setScene(&scene);
+    rasterizer.render(listener);
+    rasterizer.render(listener);
+    frameOutput.flush();
+
+    // frames of a camera share a name, the memory sink only keeps the newest one
+    XPSWOutputFrame frame;
+    ASSERT_TRUE(frameOutput.takeFrame("overlapping quads_camera", frame));
+    EXPECT_EQ(frame.frameIndex, 1u);
+    XPSWOutputFrame olderFrame;
+    EXPECT_FALSE(frameOutput.takeFrame("overlapping quads_camera", olderFrame));
+    ASSERT_EQ(frame.width, 1024u);
+    ASSERT_EQ(frame.height, 720u);
+
+    // the quads are centered in front of the camera, so are the pixels shaded for them
+    uint32_t minX = frame.width, maxX = 0, minY = frame.height, maxY = 0;
+    for (uint32_t y = 0; y < frame.height; ++y) {
+        for (uint32_t x = 0; x < frame.width; ++x) {
+            if (frame.color[4 * (static_cast<size_t>(y) * frame.width + x) + 3] != 1.0f) { continue; }
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+        }
+    }
+    ASSERT_LE(minX, maxX);
+    EXPECT_NEAR((minX + maxX) / 2.0, frame.width / 2.0, 1.0);
+    EXPECT_NEAR((minY + maxY) / 2.0, frame.height / 2.0, 1.0);
+    EXPECT_NEAR(maxX - minX, maxY - minY, 2.0);
+
+    // a zero sized camera has nothing to rasterize into
+    freeCamera.activeProperties.width = 0.0f;
+    XPSWCamera<float> emptyCamera;
+    EXPECT_FALSE(XPSWRenderer::importFreeCamera("empty", freeCamera.activeProperties, emptyCamera));
+}
+
+TEST(SWShadowMapTests, CascadesUseTheClipSpaceDepthOfTheClipStage)
+{
+    XPSWScene<float> scene;
+    createOverlappingQuads(scene);
+    addCamera(scene, XPVec2<uint32_t>{ 640, 360 });
+    scene.lights[0].type      = XPSWELightType_Directional;
+    scene.lights[0].direction = XPVec3<float>{ 0.3f, -1.0f, 0.5f };
+
+    XPSWShadowMaps<float> shadowMaps;
+    shadowMaps.prepare(scene, 0);
+    ASSERT_EQ(shadowMaps.lights[0].views.size(), XPSWShadowMaps<float>::NumCascades);
+
+    // the clip stage keeps -w <= z <= w, the near and far planes of every cascade have to land on its bounds
+    for (const XPSWShadowView<float>& view : shadowMaps.lights[0].views) {
+        const XPSWCamera<float>& camera  = view.camera;
+        const glm::vec3          forward = glm::normalize(camera.target.glm - camera.location.glm);
+        for (const auto& [distance, expectedDepth] : { std::pair{ camera.zNearPlane, -1.0f },
+                                                       std::pair{ camera.zFarPlane, 1.0f } }) {
+            const glm::vec4 position = glm::vec4(camera.location.glm + forward * distance, 1.0f);
+            const glm::vec4 clip     = view.viewProjectionMatrix.glm * position;
+            EXPECT_NEAR(clip.z / clip.w, expectedDepth, 1e-3f);
+        }
+    }
+}
+
+TEST(SWShadowMapTests, CastersRefilledInPlaceRenderTheViewsAgain)
+{
+    XPSWScene<float> scene;
+    createOverlappingQuads(scene);
+    addCamera(scene, XPVec2<uint32_t>{ 640, 360 });
+    scene.lights[0].type      = XPSWELightType_Directional;
+    scene.lights[0].direction = XPVec3<float>{ 0.3f, -1.0f, 0.5f };
+
+    XPSWShadowMaps<float> shadowMaps;
+    shadowMaps.prepare(scene, 0);
+    EXPECT_EQ(shadowMaps.dirtyViews.size(), XPSWShadowMaps<float>::NumCascades);
+    shadowMaps.prepare(scene, 0);
+    EXPECT_TRUE(shadowMaps.dirtyViews.empty());
+
+    // same stream pointers, transform and index count, only the vertex data behind them changed
+    ++scene.meshes[0].generation;
+    shadowMaps.prepare(scene, 0);
+    EXPECT_EQ(shadowMaps.dirtyViews.size(), XPSWShadowMaps<float>::NumCascades);
+}
+
+TEST(SWLightGridTests, PointLightsStayUnderTheCutoffPastTheirRange)
+{
+    XPSWScene<float> scene;
+    createOverlappingQuads(scene);
+    XPSWLight<float> light = scene.lights[0];
+    // the importer gives lights a constant attenuation of 0.1, they are brighter than their color up close
+    for (const float constant : { 0.1f, 0.5f, 1.0f, 4.0f }) {
+        for (const float quadratic : { 0.0f, 0.01f, 1.0f }) {
+            light.attenuationConstant  = constant;
+            light.attenuationLinear    = 0.05f;
+            light.attenuationQuadratic = quadratic;
+            light.intensity            = 2.0f;
+
+            // the color calculateRadiance receives for the brightest channel, times the intensity / d^2 it applies
+            const auto getContribution = [&light](float distance) {
+                const float attenuation = 1.0f / (light.attenuationConstant + light.attenuationLinear * distance +
+                                                  light.attenuationQuadratic * distance * distance);
+                const float color       = light.ambient.x + (light.diffuse.x + light.specular.x) * attenuation;
+                return color * light.intensity * light.intensity / (distance * distance);
+            };
+            const float range = XPSWLightGrid<float>::getLightRange(light);
+            for (const float scale : { 1.0f, 1.5f, 4.0f }) {
+                EXPECT_LE(getContribution(range * scale), XPSWLightGrid<float>::LightCutoff)
+                  << "constant " << constant << " quadratic " << quadratic;
+            }
+            EXPECT_GT(getContribution(range * 0.9f), XPSWLightGrid<float>::LightCutoff);
+        }
+    }
+}
+
+#endif
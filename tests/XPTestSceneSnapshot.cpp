@@ -0,0 +1,199 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <SceneDescriptor/XPLayer.h>
+#include <SceneDescriptor/XPNode.h>
+#include <SceneDescriptor/XPScene.h>
+#include <SceneDescriptor/XPSceneDescriptorStore.h>
+#include <SceneDescriptor/XPSceneSnapshot.h>
+#include <SceneDescriptor/XPSceneStore.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+class SceneSnapshotTests : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        store = new XPSceneDescriptorStore(nullptr);
+        path  = (std::filesystem::temp_directory_path() /
+                ("XPTestSceneSnapshot_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) +
+                 ".xpsnap"))
+                 .string();
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + XPSceneSnapshotJournalSuffix);
+
+        // two layers, every root has a chain of children with a transform and a mesh renderer on each
+        XPScene* scene = store->createScene("source").value();
+        for (const char* layerName : { "background", "foreground" }) {
+            XPLayer* layer = scene->createLayer(layerName).value();
+            for (int r = 0; r < 10; ++r) {
+                XPNode* node = layer->createNode("root " + std::to_string(r)).value();
+                for (int c = 0; c < 5; ++c) {
+                    node->attachTransform();
+                    node->attachMeshRenderer();
+                    node->getTransform()->location = XPVec3<float>(float(r), float(c), 1.0f);
+                    node->getMeshRenderer()->info.resize(1);
+                    node->getMeshRenderer()->info[0].mesh.text     = "mesh " + std::to_string(c);
+                    node->getMeshRenderer()->info[0].material.text = "material";
+                    node->setHidden(c == 3);
+                    node = node->createNode("child " + std::to_string(c)).value();
+                }
+            }
+        }
+    }
+    void TearDown() override
+    {
+        delete store;
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + XPSceneSnapshotJournalSuffix);
+    }
+
+    // compares names, hierarchy, hidden state and the saved attachment fields of two layers
+    static void expectSameNodes(const std::list<XPNode*>& expected, const std::list<XPNode*>& actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        auto actualIt = actual.begin();
+        for (XPNode* expectedNode : expected) {
+            XPNode* actualNode = *actualIt++;
+            EXPECT_EQ(expectedNode->getName(), actualNode->getName());
+            EXPECT_EQ(expectedNode->getId(), actualNode->getId());
+            EXPECT_EQ(expectedNode->isHidden(), actualNode->isHidden());
+            EXPECT_EQ(expectedNode->getAttachmentDescriptor(), actualNode->getAttachmentDescriptor());
+            if (expectedNode->hasTransformAttachment() && actualNode->hasTransformAttachment()) {
+                EXPECT_EQ(expectedNode->getTransform()->location.glm, actualNode->getTransform()->location.glm);
+                EXPECT_EQ(expectedNode->getTransform()->scale.glm, actualNode->getTransform()->scale.glm);
+            }
+            if (expectedNode->hasMeshRendererAttachment() && actualNode->hasMeshRendererAttachment()) {
+                ASSERT_EQ(expectedNode->getMeshRenderer()->info.size(), actualNode->getMeshRenderer()->info.size());
+                for (size_t i = 0; i < expectedNode->getMeshRenderer()->info.size(); ++i) {
+                    EXPECT_EQ(expectedNode->getMeshRenderer()->info[i].mesh.text,
+                              actualNode->getMeshRenderer()->info[i].mesh.text);
+                    EXPECT_EQ(expectedNode->getMeshRenderer()->info[i].material.text,
+                              actualNode->getMeshRenderer()->info[i].material.text);
+                }
+            }
+            expectSameNodes(expectedNode->getNodes(), actualNode->getNodes());
+        }
+    }
+
+    static void expectSameScenes(XPScene* expected, XPScene* actual)
+    {
+        ASSERT_EQ(expected->getLayers().size(), actual->getLayers().size());
+        auto actualIt = actual->getLayers().begin();
+        for (XPLayer* expectedLayer : expected->getLayers()) {
+            XPLayer* actualLayer = *actualIt++;
+            EXPECT_EQ(expectedLayer->getName(), actualLayer->getName());
+            expectSameNodes(expectedLayer->getNodes(), actualLayer->getNodes());
+        }
+    }
+
+    XPSceneDescriptorStore* store = nullptr;
+    std::string             path;
+};
+
+TEST_F(SceneSnapshotTests, SaveAndLoad)
+{
+    XPScene* source = store->getScene("source").value();
+    ASSERT_TRUE(source->getSceneStore()->saveSnapshot(path));
+
+    XPScene* loaded = store->createScene("loaded").value();
+    ASSERT_TRUE(loaded->getSceneStore()->loadSnapshot(path));
+    expectSameScenes(source, loaded);
+    EXPECT_EQ(loaded->getSceneStore()->getNextNodeId(), source->getSceneStore()->getNextNodeId());
+
+    // loading only fills empty scenes
+    EXPECT_FALSE(loaded->getSceneStore()->loadSnapshot(path));
+}
+
+TEST_F(SceneSnapshotTests, JournalOnlyHoldsChangedNodes)
+{
+    XPScene* source = store->getScene("source").value();
+    ASSERT_TRUE(source->getSceneStore()->saveSnapshot(path));
+    const auto snapshotSize = std::filesystem::file_size(path);
+    const auto emptySize    = std::filesystem::file_size(path + XPSceneSnapshotJournalSuffix);
+
+    // nothing changed, nothing is appended
+    ASSERT_TRUE(source->getSceneStore()->appendSnapshotJournal(path));
+    EXPECT_EQ(std::filesystem::file_size(path + XPSceneSnapshotJournalSuffix), emptySize);
+
+    XPLayer* layer = source->getLayer("foreground").value();
+    XPNode*  moved = layer->getNode("root 4").value();
+    moved->getTransform()->location = XPVec3<float>(7.0f, 8.0f, 9.0f);
+    moved->addAttachmentChanges(XPEInteractionHasTransformChanges, false, false);
+    moved->createNode("added");
+    layer->destroyNode("root 6");
+    ASSERT_TRUE(source->getSceneStore()->appendSnapshotJournal(path));
+    EXPECT_LT(std::filesystem::file_size(path + XPSceneSnapshotJournalSuffix) - emptySize, snapshotSize / 4);
+
+    // a second round on top of the first
+    layer->getNode("root 2").value()->getTransform()->scale = XPVec3<float>(2.0f, 2.0f, 2.0f);
+    layer->getNode("root 2").value()->addAttachmentChanges(XPEInteractionHasTransformChanges, false, false);
+    ASSERT_TRUE(source->getSceneStore()->appendSnapshotJournal(path));
+
+    XPScene* loaded = store->createScene("loaded").value();
+    ASSERT_TRUE(loaded->getSceneStore()->loadSnapshot(path));
+    expectSameScenes(source, loaded);
+}
+
+TEST_F(SceneSnapshotTests, EmptyLayersAreKept)
+{
+    XPScene* source = store->getScene("source").value();
+    source->createLayer("empty");
+    ASSERT_TRUE(source->getSceneStore()->saveSnapshot(path));
+
+    // layers created and destroyed after the save only reach the file through the journal
+    source->createLayer("added later");
+    source->createLayer("added and destroyed");
+    source->destroyLayer("added and destroyed");
+    source->destroyLayer("background");
+    ASSERT_TRUE(source->getSceneStore()->appendSnapshotJournal(path));
+
+    // a layer destroyed and created again under the same name comes back empty
+    source->destroyLayer("foreground");
+    source->createLayer("foreground");
+    ASSERT_TRUE(source->getSceneStore()->appendSnapshotJournal(path));
+    ASSERT_EQ(source->getLayers().size(), 3u);
+
+    XPScene* loaded = store->createScene("loaded").value();
+    ASSERT_TRUE(loaded->getSceneStore()->loadSnapshot(path));
+    expectSameScenes(source, loaded);
+}
+
+TEST_F(SceneSnapshotTests, TornJournalIsDropped)
+{
+    XPScene* source = store->getScene("source").value();
+    ASSERT_TRUE(source->getSceneStore()->saveSnapshot(path));
+    XPNode* node = source->getLayer("background").value()->getNode("root 0").value();
+    node->getTransform()->location = XPVec3<float>(-1.0f, -1.0f, -1.0f);
+    node->addAttachmentChanges(XPEInteractionHasTransformChanges, false, false);
+    ASSERT_TRUE(source->getSceneStore()->appendSnapshotJournal(path));
+
+    // a crash in the middle of an append
+    const std::string journalPath = path + XPSceneSnapshotJournalSuffix;
+    std::filesystem::resize_file(journalPath, std::filesystem::file_size(journalPath) - 3);
+
+    XPScene* loaded = store->createScene("loaded").value();
+    ASSERT_TRUE(loaded->getSceneStore()->loadSnapshot(path));
+    XPNode* loadedNode = loaded->getLayer("background").value()->getNode("root 0").value();
+    EXPECT_EQ(loadedNode->getTransform()->location.glm, XPVec3<float>(0.0f, 0.0f, 1.0f).glm);
+
+    // the loaded state was written back as a new snapshot, the next append is readable again
+    XPSceneSnapshotFile file;
+    ASSERT_TRUE(file.open(path));
+    EXPECT_FALSE(file.isJournalTorn());
+    EXPECT_EQ(file.getBodies().size(), 1u);
+}
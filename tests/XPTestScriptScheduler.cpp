@@ -0,0 +1,131 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Emulator/XPEmulatorCommon.h>
+#include <Emulator/XPEmulatorProcessor.h>
+#include <Engine/XPScriptScheduler.h>
+
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// encodings below were produced by assembling the commented instruction for rv32i
+struct ScriptProcessor
+{
+    explicit ScriptProcessor(std::initializer_list<uint32_t> program)
+      : processor(std::make_unique<XPEmulatorProcessor>())
+    {
+        xp_emulator_processor_initialize(processor.get());
+        uint32_t address = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+        for (uint32_t word : program) {
+            xp_emulator_bus_store(&processor->bus, address, 32, word);
+            address += 4;
+        }
+        processor->pc = XP_EMULATOR_CONFIG_MEMORY_FLASH_BASE;
+    }
+    ~ScriptProcessor() { xp_emulator_processor_finalize(processor.get()); }
+
+    std::unique_ptr<XPEmulatorProcessor> processor;
+};
+
+const std::initializer_list<uint32_t> CountingLoop = {
+    0x00150513, // loop: addi a0, a0, 1
+    0xffdff06f, //       j    loop
+};
+
+} // namespace
+
+TEST(ScriptSchedulerTests, BudgetedSlicesAreIdenticalForAnyWorkerCount)
+{
+    constexpr uint32_t NumScripts = 8;
+    constexpr uint32_t NumTicks   = 5;
+    constexpr uint32_t Budget     = 1001;
+
+    std::vector<std::vector<uint32_t>> results;
+    for (uint32_t numWorkers : { 0u, 3u }) {
+        std::vector<std::unique_ptr<ScriptProcessor>> scripts;
+        XPScriptScheduler                             scheduler(numWorkers);
+        scheduler.setInstructionBudget(Budget);
+        for (uint32_t i = 0; i < NumScripts; ++i) {
+            scripts.push_back(std::make_unique<ScriptProcessor>(CountingLoop));
+            // registration order doesn't matter, slices are dispatched in node id order
+            scheduler.add((i * 5) % NumScripts, scripts.back()->processor.get());
+        }
+        for (uint32_t tick = 0; tick < NumTicks; ++tick) { scheduler.tick(); }
+
+        std::vector<uint32_t> counters;
+        for (uint32_t i = 0; i < NumScripts; ++i) {
+            const XPScriptStats* stats = scheduler.getStats(i);
+            ASSERT_NE(stats, nullptr);
+            EXPECT_EQ(stats->totalInstructions, Budget * NumTicks);
+            EXPECT_EQ(stats->lastFrameInstructions, Budget);
+            EXPECT_EQ(stats->frames, NumTicks);
+            EXPECT_FALSE(stats->finished);
+            counters.push_back(scripts[i]->processor->regs[XPEmulatorEReg10]);
+        }
+        results.push_back(counters);
+    }
+    EXPECT_EQ(results[0], results[1]);
+    EXPECT_EQ(results[0][0], (Budget * NumTicks + 1) / 2);
+}
+
+TEST(ScriptSchedulerTests, EcallEndsTheSliceEarly)
+{
+    ScriptProcessor script({
+      0x0d600893, //       li   a7, 214 (brk)
+      0x00000513, //       li   a0, 0
+      0x00140413, // loop: addi s0, s0, 1
+      0x00000073, //       ecall
+      0xff9ff06f, //       j    loop
+    });
+    XPScriptScheduler scheduler(1);
+    scheduler.add(7, script.processor.get());
+
+    scheduler.tick();
+    const XPScriptStats* stats = scheduler.getStats(7);
+    EXPECT_EQ(stats->lastFrameInstructions, 4u);
+    EXPECT_EQ(stats->yields, 1u);
+
+    scheduler.tick();
+    EXPECT_EQ(stats->lastFrameInstructions, 3u);
+    EXPECT_EQ(stats->yields, 2u);
+    EXPECT_EQ(script.processor->regs[XPEmulatorEReg8], 2u);
+}
+
+TEST(ScriptSchedulerTests, StoppedScriptsKeepTheirExitCode)
+{
+    ScriptProcessor script({
+      0x00150513, // addi a0, a0, 1
+      0x00150513, // addi a0, a0, 1
+      0x00100073, // ebreak
+    });
+    XPScriptScheduler scheduler(2);
+    scheduler.add(1, script.processor.get());
+    scheduler.tick();
+    scheduler.tick();
+
+    const XPScriptStats* stats = scheduler.getStats(1);
+    EXPECT_TRUE(stats->finished);
+    EXPECT_EQ(stats->exitCode, XP_EMULATOR_PROGRAM_EXIT_CODE_EBREAK);
+    EXPECT_EQ(stats->totalInstructions, 2u);
+    EXPECT_EQ(stats->frames, 1u);
+
+    EXPECT_TRUE(scheduler.remove(1));
+    EXPECT_FALSE(scheduler.remove(1));
+    EXPECT_EQ(scheduler.getStats(1), nullptr);
+    EXPECT_EQ(scheduler.getNumScripts(), 0u);
+}
@@ -0,0 +1,65 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <DataPipeline/XPTextureBuffer.h>
+#include <Utilities/XPHash.h>
+#include <gtest/gtest.h>
+
+TEST(TextureBufferTests, LinearLevelByteSize)
+{
+    EXPECT_EQ(XPTextureBuffer::getMipLevelByteSize(XPETextureBufferFormat::R8, XPVec2<uint32_t>(7, 3)), 21u);
+    EXPECT_EQ(XPTextureBuffer::getMipLevelByteSize(XPETextureBufferFormat::R8_G8_B8_A8, XPVec2<uint32_t>(16, 8)), 512u);
+    EXPECT_EQ(XPTextureBuffer::getMipLevelRowPitch(XPETextureBufferFormat::R8_G8, 5), 10u);
+}
+
+TEST(TextureBufferTests, BlockLevelByteSize)
+{
+    // partial blocks at the edges still take a full block
+    EXPECT_EQ(XPTextureBuffer::getMipLevelByteSize(XPETextureBufferFormat::BC1_RGBA, XPVec2<uint32_t>(1, 1)), 8u);
+    EXPECT_EQ(XPTextureBuffer::getMipLevelByteSize(XPETextureBufferFormat::BC1_RGBA, XPVec2<uint32_t>(5, 4)), 16u);
+    EXPECT_EQ(XPTextureBuffer::getMipLevelByteSize(XPETextureBufferFormat::BC7_RGBA, XPVec2<uint32_t>(8, 9)), 96u);
+    EXPECT_EQ(XPTextureBuffer::getMipLevelRowPitch(XPETextureBufferFormat::BC5_RG, 13), 64u);
+    EXPECT_TRUE(XPTextureBuffer::isBlockCompressedFormat(XPETextureBufferFormat::BC3_RGBA));
+    EXPECT_FALSE(XPTextureBuffer::isBlockCompressedFormat(XPETextureBufferFormat::R8_G8_B8_A8));
+}
+
+TEST(TextureBufferTests, MipChain)
+{
+    XPTextureBuffer buffer(nullptr, 0);
+    buffer.setFormat(XPETextureBufferFormat::R8);
+    buffer.setDimensions(XPVec2<uint32_t>(4, 2));
+    buffer.setPixels(std::vector<unsigned char>(8, 1));
+    EXPECT_EQ(buffer.getMipLevelCount(), 1u);
+    EXPECT_EQ(buffer.getMipPixels(0).size(), 8u);
+
+    std::vector<XPTextureBufferMipLevel> levels = {
+        { XPVec2<uint32_t>(4, 2), 0, 8 },
+        { XPVec2<uint32_t>(2, 1), 16, 2 },
+        { XPVec2<uint32_t>(1, 1), 32, 1 },
+    };
+    std::vector<unsigned char> pixels(33, 0);
+    pixels[16] = 7;
+    pixels[32] = 9;
+    buffer.setMipChain(std::move(pixels), std::move(levels));
+    EXPECT_EQ(buffer.getMipLevelCount(), 3u);
+    EXPECT_EQ(buffer.getMipPixels(1)[0], 7);
+    EXPECT_EQ(buffer.getMipPixels(2)[0], 9);
+    EXPECT_TRUE(buffer.getMipPixels(3).empty());
+}
+
+TEST(HashTests, XXH64)
+{
+    EXPECT_EQ(XPHash::xxh64("", 0), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(XPHash::xxh64("abc"), 0x44BC2CF5AD770999ULL);
+}
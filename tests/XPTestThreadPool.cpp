@@ -0,0 +1,147 @@
+/// --------------------------------------------------------------------------------------
+/// Copyright 2025 Omar Sherif Fathy
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+/// --------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Utilities/XPThreadPool.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <latch>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(ThreadPoolTests, ParallelForCoversTheRangeExactlyOnce)
+{
+    for (uint32_t numWorkers : { 0u, 1u, 7u }) {
+        XPThreadPool          pool(numWorkers);
+        std::vector<uint32_t> hits(100003, 0);
+        pool.parallelFor(0, hits.size(), 64, [&](size_t first, size_t last, uint32_t contextIndex) {
+            EXPECT_LT(contextIndex, pool.getMaxContexts());
+            EXPECT_LE(last - first, 64u);
+            for (size_t i = first; i < last; ++i) { ++hits[i]; }
+        });
+        for (size_t i = 0; i < hits.size(); ++i) { ASSERT_EQ(hits[i], 1u) << "index " << i; }
+    }
+}
+
+TEST(ThreadPoolTests, ParentsFinishAfterTheirChildren)
+{
+    XPThreadPool          pool(3);
+    std::atomic<uint32_t> children = 0;
+    XPJob*                root     = pool.createJob([](uint32_t) {});
+    // more children than a context has job slots, the ring has to wrap while the root is still pending
+    for (uint32_t i = 0; i < 3 * XPThreadPool::JobsPerContext; ++i) {
+        pool.run(pool.createJob([&children](uint32_t) { children.fetch_add(1); }, root));
+    }
+    pool.run(root);
+    pool.wait(root);
+    EXPECT_EQ(children.load(), 3 * XPThreadPool::JobsPerContext);
+}
+
+TEST(ThreadPoolTests, NestedParallelForsHelpInsteadOfBlocking)
+{
+    // with one worker, waiting inside a job only finishes when the waiting thread runs queued jobs itself
+    XPThreadPool          pool(1);
+    std::atomic<uint64_t> sum = 0;
+    pool.parallelFor(0, 16, 1, [&](size_t first, size_t last, uint32_t) {
+        for (size_t outer = first; outer < last; ++outer) {
+            pool.parallelFor(0, 1000, 10, [&](size_t innerFirst, size_t innerLast, uint32_t) {
+                for (size_t inner = innerFirst; inner < innerLast; ++inner) { sum.fetch_add(inner); }
+            });
+        }
+    });
+    EXPECT_EQ(sum.load(), 16u * (999u * 1000u / 2u));
+}
+
+TEST(ThreadPoolTests, SubmittedJobsAreDoneAfterWaitForWork)
+{
+    XPThreadPool          pool(2);
+    std::atomic<uint32_t> counter = 0;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        pool.submit([&counter](uint32_t) { counter.fetch_add(1); });
+    }
+    pool.waitForWork();
+    EXPECT_EQ(counter.load(), 10000u);
+}
+
+TEST(ThreadPoolTests, WaitUntilOnlyWaitsForItsOwnJobs)
+{
+    for (uint32_t numWorkers : { 0u, 1u }) {
+        XPThreadPool      pool(numWorkers);
+        std::atomic<bool> started = false;
+        std::atomic<bool> release = false;
+        // a worker stays busy with someone else's job for as long as the test wants
+        if (numWorkers > 0) {
+            pool.submit([&](uint32_t) {
+                started.store(true);
+                while (!release.load()) { std::this_thread::yield(); }
+            });
+            while (!started.load()) { std::this_thread::yield(); }
+        }
+        std::atomic<uint32_t> counter = 0;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            pool.submit([&counter](uint32_t) { counter.fetch_add(1); });
+        }
+        pool.waitUntil([&counter] { return counter.load() == 1000; });
+        EXPECT_EQ(counter.load(), 1000u);
+        release.store(true);
+        pool.waitForWork();
+    }
+}
+
+TEST(ThreadPoolTests, OutsideThreadsGiveTheirContextBack)
+{
+    XPThreadPool       pool(2);
+    std::set<uint32_t> indices;
+    // many short lived threads in a row, more than there are contexts for outside threads
+    for (uint32_t i = 0; i < 4 * XPThreadPool::MaxExternalContexts; ++i) {
+        uint32_t index = 0;
+        std::thread([&] {
+            pool.parallelFor(0, 100, 1, [](size_t, size_t, uint32_t) {});
+            index = pool.getContextIndex();
+        }).join();
+        indices.insert(index);
+    }
+    EXPECT_EQ(indices.size(), 1u);
+    EXPECT_GE(*indices.begin(), pool.getNumWorkers());
+}
+
+TEST(ThreadPoolTests, LongLivedOutsideThreadsShareTheContexts)
+{
+    XPThreadPool             pool(2);
+    std::atomic<uint32_t>    sum = 0;
+    std::vector<std::thread> threads;
+    std::vector<uint32_t>    indices(2 * XPThreadPool::MaxExternalContexts, 0);
+    // twice as many threads as there are contexts for them, all of them stay alive until every one used the pool
+    std::latch allUsedThePool(static_cast<std::ptrdiff_t>(indices.size()));
+    for (uint32_t i = 0; i < indices.size(); ++i) {
+        threads.emplace_back([&, i] {
+            const auto add = [&](size_t first, size_t last, uint32_t) {
+                sum.fetch_add(static_cast<uint32_t>(last - first));
+            };
+            pool.parallelFor(0, 100, 1, add);
+            allUsedThePool.arrive_and_wait();
+            pool.parallelFor(0, 100, 1, add);
+            indices[i] = pool.getContextIndex();
+        });
+    }
+    for (std::thread& thread : threads) { thread.join(); }
+    EXPECT_EQ(sum.load(), 200u * indices.size());
+    for (uint32_t index : indices) {
+        EXPECT_GE(index, pool.getNumWorkers());
+        EXPECT_LT(index, pool.getMaxContexts());
+    }
+}